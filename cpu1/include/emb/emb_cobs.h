@@ -0,0 +1,114 @@
+/**
+ * @file emb_cobs.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+namespace emb {
+/// @addtogroup emb
+/// @{
+
+
+/**
+ * @brief Returns max COBS-encoded length of len octets, without frame delimiter.
+ */
+inline size_t cobs_max_encoded_len(size_t len)
+{
+	return len + len / 254 + 1;
+}
+
+
+/**
+ * @brief Encodes octets with Consistent Overhead Byte Stuffing: encoded data contain no zero octets,
+ * so zero octet is used as frame delimiter. Delimiter is not appended.
+ * @param src - octets
+ * @param len - number of octets
+ * @param dst - encoded octets, at least cobs_max_encoded_len(len) octets
+ * @return Encoded length.
+ */
+inline size_t cobs_encode(const unsigned char* src, size_t len, unsigned char* dst)
+{
+	size_t codePos = 0;
+	size_t out = 1;
+	unsigned char code = 1;
+
+	for (size_t i = 0; i < len; ++i)
+	{
+		if ((src[i] & 0xFF) == 0)
+		{
+			dst[codePos] = code;
+			codePos = out++;
+			code = 1;
+			continue;
+		}
+
+		dst[out++] = src[i] & 0xFF;
+		if ((++code == 0xFF) && (i + 1 < len))	// full block, next block starts if data remain
+		{
+			dst[codePos] = code;
+			codePos = out++;
+			code = 1;
+		}
+	}
+	dst[codePos] = code;
+	return out;
+}
+
+
+/**
+ * @brief Decodes COBS-encoded octets without frame delimiter. Decoding in place (dst == src) is allowed.
+ * @param src - encoded octets
+ * @param len - number of encoded octets
+ * @param dst - decoded octets, at least len octets
+ * @param decodedLen - decoded length
+ * @return \c true on success, \c false if data are not valid COBS encoding.
+ */
+inline bool cobs_decode(const unsigned char* src, size_t len, unsigned char* dst, size_t& decodedLen)
+{
+	size_t in = 0;
+	size_t out = 0;
+
+	while (in < len)
+	{
+		unsigned char code = src[in++] & 0xFF;
+		if ((code == 0) || (in + code - 1 > len))
+		{
+			return false;
+		}
+
+		for (unsigned char i = 1; i < code; ++i)
+		{
+			unsigned char octet = src[in++] & 0xFF;
+			if (octet == 0) return false;
+			dst[out++] = octet;
+		}
+
+		if ((code != 0xFF) && (in < len))
+		{
+			dst[out++] = 0;
+		}
+	}
+
+	decodedLen = out;
+	return true;
+}
+
+
+/// @}
+} // namespace emb
+
+
@@ -46,7 +46,22 @@
  */
 #define EMB_CAT_(a, b) a ## b
 #define EMB_CAT(a, b) EMB_CAT_(a, b)
+#ifdef HOST_SIMULATION	// gcc warns about unused local typedefs
+#define EMB_STATIC_ASSERT(cond) typedef int EMB_CAT(assert, __LINE__)[(cond) ? 1 : -1] __attribute__((unused))
+#else
 #define EMB_STATIC_ASSERT(cond) typedef int EMB_CAT(assert, __LINE__)[(cond) ? 1 : -1]
+#endif
+
+
+/**
+ * @brief Compiler memory barrier: compiler does not move memory accesses across it.
+ * Lock-free queues use it to order plain slot accesses against volatile index accesses.
+ */
+#ifdef HOST_SIMULATION
+#define EMB_COMPILER_BARRIER() __asm__ __volatile__("" : : : "memory")
+#else
+#define EMB_COMPILER_BARRIER() __asm(" NOP")	// TI compiler does not schedule memory accesses across asm statement
+#endif
 
 
 /// @}
@@ -17,6 +17,12 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <assert.h>
+#include <string.h>
+#include <limits.h>
+
+
+/// Object size in C28x 16-bit bytes, same as sizeof on target. Host simulation build has 8-bit bytes.
+#define EMB_C28X_SIZEOF(x) ((sizeof(x) * CHAR_BIT + 15) / 16)
 
 
 namespace emb {
@@ -71,12 +77,21 @@ bool interrupt_invoker<T>::_initialized = false;
 template <typename T>
 void from_bytes(T& dest, const uint16_t* src)
 {
+#if CHAR_BIT == 8	// host simulation build
+	uint8_t byte8[sizeof(T)];
+	for (size_t i = 0; i < sizeof(T); ++i)
+	{
+		byte8[i] = src[i] & 0x00FF;
+	}
+	memcpy(static_cast<void*>(&dest), &byte8, sizeof(T));
+#else
 	uint16_t c28_byte[sizeof(T)];
 	for (size_t i = 0; i < sizeof(T); ++i)
 	{
 		c28_byte[i] = src[2*i] | src[2*i+1] << 8;
 	}
 	memcpy (&dest, &c28_byte, sizeof(T));
+#endif
 }
 
 
@@ -86,6 +101,14 @@ void from_bytes(T& dest, const uint16_t* src)
 template <typename T>
 void to_bytes(uint16_t* dest, const T& src)
 {
+#if CHAR_BIT == 8	// host simulation build
+	uint8_t byte8[sizeof(T)];
+	memcpy(&byte8, &src, sizeof(T));
+	for (size_t i = 0; i < sizeof(T); ++i)
+	{
+		dest[i] = byte8[i];
+	}
+#else
 	uint16_t c28_byte[sizeof(T)];
 	memcpy(&c28_byte, &src, sizeof(T));
 	for (size_t i = 0; i < sizeof(T); ++i)
@@ -93,6 +116,7 @@ void to_bytes(uint16_t* dest, const T& src)
 		dest[2*i] = c28_byte[i] & 0x00FF;
 		dest[2*i+1] = c28_byte[i] >> 8;
 	}
+#endif
 }
 
 
@@ -102,13 +126,13 @@ void to_bytes(uint16_t* dest, const T& src)
 template <typename T>
 bool is_equal(const T& obj1, const T& obj2)
 {
-	uint16_t obj1_byte8[sizeof(T)*2];
-	uint16_t obj2_byte8[sizeof(T)*2];
+	uint16_t obj1_byte8[sizeof(T)*CHAR_BIT/8];
+	uint16_t obj2_byte8[sizeof(T)*CHAR_BIT/8];
 
 	to_bytes<T>(obj1_byte8, obj1);
 	to_bytes<T>(obj2_byte8, obj2);
 
-	for(size_t i = 0; i < sizeof(T)*2; ++i)
+	for(size_t i = 0; i < sizeof(T)*CHAR_BIT/8; ++i)
 	{
 		if (obj1_byte8[i] != obj2_byte8[i])
 		{
@@ -0,0 +1,114 @@
+/**
+ * @file emb_cpuload.cpp
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "emb_cpuload.h"
+
+
+namespace emb {
+
+
+namespace cpuload {
+
+
+uint32_t timestampFuncNone()
+{
+	return 0;
+}
+
+
+volatile Meter::Accumulator Meter::_accumulators[Probe::Count];
+volatile uint32_t Meter::_preempted = 0;
+Stats Meter::_stats[Probe::Count];
+
+uint32_t (*Meter::_timestampFunc)() = timestampFuncNone;
+uint32_t Meter::_timestampModulo = 0;
+uint32_t Meter::_timestampFreq = 1;
+uint64_t Meter::_windowStart_ms = 0;
+uint32_t Meter::_window_ms = 0;
+
+
+///
+///
+///
+void Meter::init(uint32_t (*timestampFunc)(void), uint32_t timestampPeriod, uint32_t timestampFreq,
+		uint64_t timeNow_ms)
+{
+	uint16_t intStatus = __disable_interrupts();
+	_timestampFunc = timestampFunc;
+	_timestampModulo = timestampPeriod + 1;		// 0 if period is 0xFFFFFFFF - natural uint32 wraparound
+	_timestampFreq = timestampFreq;
+	_windowStart_ms = timeNow_ms;
+	_window_ms = 0;
+	_preempted = 0;
+	for (size_t i = 0; i < Probe::Count; ++i)
+	{
+		_accumulators[i].busy = 0;
+		_accumulators[i].calls = 0;
+		_accumulators[i].wcet = 0;
+		_stats[i].load = 0;
+		_stats[i].wcet = 0;
+		_stats[i].rate = 0;
+	}
+	__restore_interrupts(intStatus);
+}
+
+
+///
+///
+///
+void Meter::update(uint64_t timeNow_ms)
+{
+	if (timeNow_ms <= _windowStart_ms) return;
+
+	_window_ms = timeNow_ms - _windowStart_ms;
+	_windowStart_ms = timeNow_ms;
+	uint64_t windowClk = static_cast<uint64_t>(_window_ms) * (_timestampFreq / 1000);
+	if (windowClk == 0) return;
+
+	for (size_t i = 0; i < Probe::Count; ++i)
+	{
+		uint16_t intStatus = __disable_interrupts();
+		uint32_t busy = _accumulators[i].busy;
+		uint32_t calls = _accumulators[i].calls;
+		_accumulators[i].busy = 0;
+		_accumulators[i].calls = 0;
+		_stats[i].wcet = _accumulators[i].wcet;
+		__restore_interrupts(intStatus);
+
+		_stats[i].load = static_cast<uint64_t>(busy) * 10000 / windowClk;
+		_stats[i].rate = static_cast<uint64_t>(calls) * 1000 / _window_ms;
+	}
+}
+
+
+///
+///
+///
+void Meter::resetWcet()
+{
+	for (size_t i = 0; i < Probe::Count; ++i)
+	{
+		uint16_t intStatus = __disable_interrupts();
+		_accumulators[i].wcet = 0;
+		_stats[i].wcet = 0;
+		__restore_interrupts(intStatus);
+	}
+}
+
+
+} // namespace cpuload
+
+
+} // namespace emb
+
+
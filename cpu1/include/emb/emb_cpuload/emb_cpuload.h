@@ -0,0 +1,183 @@
+/**
+ * @file emb_cpuload.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../emb_core.h"
+#include "../emb_profiler/emb_probes.h"
+
+
+namespace emb {
+
+
+namespace cpuload {
+/// @addtogroup emb
+/// @{
+
+
+/**
+ * @brief Accounting region context: returned by Meter::enter(), passed to Meter::exit().
+ * Region of probe disabled at enter() is inactive: it is not accounted.
+ */
+struct Region
+{
+	uint32_t start;
+	uint32_t preempted;
+	bool active;
+};
+
+
+/**
+ * @brief Per-probe statistics of the last completed window.
+ */
+struct Stats
+{
+	uint32_t load;		// CPU load in hundredths of percent
+	uint32_t wcet;		// worst-case execution time in timestamp clocks
+	uint32_t rate;		// calls per second
+};
+
+
+/**
+ * @brief CPU load meter. Accumulates execution time of instrumented regions (ISRs and superloop stages)
+ * and converts it into load, worst-case execution time and call rate once per window.
+ * Time spent in nested regions (e.g. ISRs preempting superloop stage) is excluded from enclosing region.
+ * Disabled probes are not accounted, their time is attributed to enclosing region.
+ * Timestamp source must be a down-counter, e.g. HighResolutionClock::counter.
+ */
+class Meter
+{
+private:
+	struct Accumulator
+	{
+		uint32_t busy;
+		uint32_t calls;
+		uint32_t wcet;
+	};
+	static volatile Accumulator _accumulators[Probe::Count];
+	static volatile uint32_t _preempted;
+	static Stats _stats[Probe::Count];
+
+	static uint32_t (*_timestampFunc)();
+	static uint32_t _timestampModulo;
+	static uint32_t _timestampFreq;
+	static uint64_t _windowStart_ms;
+	static uint32_t _window_ms;
+
+private:
+	Meter();				// no constructor
+	Meter(const Meter& other);		// no copy constructor
+	Meter& operator=(const Meter& other);	// no copy assignment operator
+
+	static uint32_t _elapsed(uint32_t start, uint32_t finish)
+	{
+		uint32_t elapsed = start - finish;
+		if (start < finish)
+		{
+			elapsed += _timestampModulo;	// counter has been reloaded
+		}
+		return elapsed;
+	}
+
+public:
+	/**
+	 * @brief Initializes meter.
+	 * @param timestampFunc - timestamp source (down-counter)
+	 * @param timestampPeriod - timestamp counter reload value
+	 * @param timestampFreq - timestamp counter frequency in Hz
+	 * @param timeNow_ms - current time in milliseconds, start of the first window
+	 * @return (none)
+	 */
+	static void init(uint32_t (*timestampFunc)(void), uint32_t timestampPeriod, uint32_t timestampFreq,
+			uint64_t timeNow_ms);
+
+	/**
+	 * @brief Starts accounting region. Should be called at the beginning of ISR or superloop stage.
+	 * Disabled probe costs one bit test: timestamp is not read.
+	 * @param probe - region probe id
+	 * @return Region context.
+	 */
+	static Region enter(Probe probe)
+	{
+		if (!ProbeRegistry::enabled(probe))
+		{
+			Region inactive = {0, 0, false};
+			return inactive;
+		}
+
+		uint16_t intStatus = __disable_interrupts();
+		Region region = {_timestampFunc(), _preempted, true};
+		__restore_interrupts(intStatus);
+		return region;
+	}
+
+	/**
+	 * @brief Finishes accounting region.
+	 * @param probe - region probe id
+	 * @param region - region context returned by enter()
+	 * @return (none)
+	 */
+	static void exit(Probe probe, const Region& region)
+	{
+		if (!region.active) return;
+
+		uint16_t intStatus = __disable_interrupts();
+		uint32_t duration = _elapsed(region.start, _timestampFunc()) - (_preempted - region.preempted);
+		_preempted += duration;
+		volatile Accumulator& acc = _accumulators[probe.underlying_value()];
+		acc.busy += duration;
+		++acc.calls;
+		if (duration > acc.wcet)
+		{
+			acc.wcet = duration;
+		}
+		__restore_interrupts(intStatus);
+	}
+
+	/**
+	 * @brief Completes current window and updates statistics. Should be called periodically (e.g. once per second).
+	 * @param timeNow_ms - current time in milliseconds
+	 * @return (none)
+	 */
+	static void update(uint64_t timeNow_ms);
+
+	/**
+	 * @brief Resets worst-case execution times.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void resetWcet();
+
+	static const Stats& stats(Probe probe) { return _stats[probe.underlying_value()]; }
+	static uint32_t window_ms() { return _window_ms; }
+	static uint32_t timestampFreq() { return _timestampFreq; }
+};
+
+
+/// @}
+} // namespace cpuload
+
+
+} // namespace emb
+
+
+#define EMB_CPULOAD_ENTER(probe) \
+		const emb::cpuload::Region _cpuload_region_##probe = emb::cpuload::Meter::enter(emb::Probe::probe);
+#define EMB_CPULOAD_EXIT(probe) \
+		emb::cpuload::Meter::exit(emb::Probe::probe, _cpuload_region_##probe);
+
+
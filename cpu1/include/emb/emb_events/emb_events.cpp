@@ -0,0 +1,26 @@
+/**
+ * @file emb_events.cpp
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "emb_events.h"
+
+
+namespace emb {
+
+
+volatile uint32_t PendingEvents::_mask = 0;
+
+
+} // namespace emb
+
+
+
@@ -0,0 +1,100 @@
+/**
+ * @file emb_events.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../emb_core.h"
+
+
+namespace emb {
+/// @addtogroup emb
+/// @{
+
+
+/// Superloop events (application-specific), raised by ISRs
+SCOPED_ENUM_DECLARE_BEGIN(Event)
+{
+	ClockTick = 0,	// SystemClock tick
+	UartRx = 1,	// CLI UART Rx FIFO level reached
+	CanRx = 2,	// RPDO, RSDO, SYNC or TPDO remote request received, TSDO sent
+	Count
+}
+SCOPED_ENUM_DECLARE_END(Event)
+
+
+/**
+ * @brief Pending-events bitmask. ISRs set events, superloop takes all pending events at once.
+ * Events of the same type are coalesced: event handler must process all available work.
+ */
+class PendingEvents
+{
+private:
+	static volatile uint32_t _mask;
+	EMB_STATIC_ASSERT(Event::Count <= 32);
+
+private:
+	PendingEvents();						// no constructor
+	PendingEvents(const PendingEvents& other);			// no copy constructor
+	PendingEvents& operator=(const PendingEvents& other);	// no copy assignment operator
+
+public:
+	/**
+	 * @brief Returns event bitmask.
+	 * @param event - event
+	 * @return Event bit.
+	 */
+	static uint32_t bit(Event event)
+	{
+		return 1UL << event.underlying_value();
+	}
+
+	/**
+	 * @brief Sets event pending. ISR-safe.
+	 * @param event - event
+	 * @return (none)
+	 */
+	static void set(Event event)
+	{
+		uint16_t intStatus = __disable_interrupts();
+		_mask |= bit(event);
+		__restore_interrupts(intStatus);
+	}
+
+	/**
+	 * @brief Takes all pending events: events are cleared.
+	 * @param (none)
+	 * @return Pending events bitmask.
+	 */
+	static uint32_t take()
+	{
+		uint16_t intStatus = __disable_interrupts();
+		uint32_t mask = _mask;
+		_mask = 0;
+		__restore_interrupts(intStatus);
+		return mask;
+	}
+
+	static bool any() { return _mask != 0; }
+	static bool pending(Event event) { return (_mask & bit(event)) != 0; }
+};
+
+
+/// @}
+} // namespace emb
+
+
+
@@ -0,0 +1,325 @@
+/**
+ * @file emb_executor.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "emb_core.h"
+
+
+namespace emb {
+/// @addtogroup emb
+/// @{
+
+
+/// Protothread statuses
+SCOPED_ENUM_DECLARE_BEGIN(PtStatus)
+{
+	Waiting = 0,	// thread is idle, it is resumed when it becomes ready
+	Yielded = 1	// thread has more work, it stays ready
+}
+SCOPED_ENUM_DECLARE_END(PtStatus)
+
+
+/**
+ * @brief Stackless protothread state. Local variables are not preserved across yield points.
+ */
+class ProtoThread
+{
+public:
+	uint16_t lc;		// local continuation: source line of last yield point
+	void* arg;		// task argument
+	uint64_t (*timeFunc)();
+	uint64_t sliceDeadline;
+
+	ProtoThread()
+		: lc(0)
+		, arg(NULL)
+		, timeFunc(NULL)
+		, sliceDeadline(0)
+	{}
+
+	/**
+	 * @brief Checks if time slice given by executor is over.
+	 * @param (none)
+	 * @return \c true if thread should yield, \c false otherwise.
+	 */
+	bool sliceExpired() const
+	{
+		return timeFunc() >= sliceDeadline;
+	}
+};
+
+
+#define EMB_PT_BEGIN(pt) switch ((pt).lc) { case 0:
+#define EMB_PT_YIELD(pt) \
+		do { (pt).lc = __LINE__; return emb::PtStatus::Yielded; case __LINE__:; } while (0)
+#define EMB_PT_WAIT_UNTIL(pt, cond) \
+		do { (pt).lc = __LINE__; case __LINE__: if (!(cond)) return emb::PtStatus::Waiting; } while (0)
+#define EMB_PT_END(pt) } (pt).lc = 0; return emb::PtStatus::Waiting;
+
+
+/**
+ * @brief Cooperative executor of protothreads with priorities and readiness flags.
+ * The highest-priority ready task is resumed, tasks of equal priority are resumed round-robin.
+ * Task becomes ready when setReady() is called (may be called from ISR) or when event
+ * it is subscribed to is passed to notify(). Polled tasks
+ * (services without events) are additionally made ready when nothing is ready and after every yield,
+ * so a task that yields after its time slice gives polled tasks a chance to run.
+ * Dispatch latency (time from becoming ready to resume) is collected per priority class.
+ */
+template <size_t Capacity, size_t PriorityCount>
+class Executor : private emb::noncopyable
+{
+	EMB_STATIC_ASSERT(Capacity <= 32);
+public:
+	typedef PtStatus (*TaskFunc)(ProtoThread& pt);
+	static const size_t invalidId = Capacity;
+
+	struct LatencyStats
+	{
+		uint32_t dispatches;
+		uint64_t total;
+		uint64_t max;
+	};
+private:
+	struct Task
+	{
+		TaskFunc func;
+		ProtoThread pt;
+		size_t priority;
+		uint64_t readySince;
+	};
+
+	Task _tasks[Capacity];
+	size_t _size;
+	volatile uint32_t _readyMask;
+	uint32_t _polledMask;
+	uint32_t _subscriptions[Capacity];	// event bitmask per task
+	uint32_t _priorityMask[PriorityCount];
+	size_t _nextInPriority[PriorityCount];	// round-robin position
+	LatencyStats _stats[PriorityCount];
+
+	uint64_t (*_timeFunc)();
+	uint64_t _slice;
+
+public:
+	/**
+	 * @brief Constructs executor.
+	 * @param timeFunc - monotonic time source, e.g. HighResolutionClock::ticks
+	 * @param slice - time slice in time source units
+	 */
+	Executor(uint64_t (*timeFunc)(), uint64_t slice)
+		: _size(0)
+		, _readyMask(0)
+		, _polledMask(0)
+		, _timeFunc(timeFunc)
+		, _slice(slice)
+	{
+		for (size_t i = 0; i < PriorityCount; ++i)
+		{
+			_priorityMask[i] = 0;
+			_nextInPriority[i] = 0;
+		}
+		resetStats();
+	}
+
+	/**
+	 * @brief Adds task.
+	 * @param func - protothread function
+	 * @param arg - task argument, available as pt.arg
+	 * @param priority - task priority, 0 is the highest
+	 * @param polled - task is made ready without events (see class description)
+	 * @return Task id, invalidId if executor is full or priority is invalid.
+	 */
+	size_t add(TaskFunc func, void* arg, size_t priority, bool polled)
+	{
+		if (_size >= Capacity || priority >= PriorityCount) return invalidId;
+
+		size_t id = _size++;
+		_tasks[id].func = func;
+		_tasks[id].pt = ProtoThread();
+		_tasks[id].pt.arg = arg;
+		_tasks[id].pt.timeFunc = _timeFunc;
+		_tasks[id].priority = priority;
+		_tasks[id].readySince = _timeFunc();
+		_subscriptions[id] = 0;
+		_priorityMask[priority] |= (1UL << id);
+		if (polled)
+		{
+			_polledMask |= (1UL << id);
+		}
+		_readyMask |= (1UL << id);	// every task is started once
+		return id;
+	}
+
+	/**
+	 * @brief Makes task ready. ISR-safe.
+	 * @param id - task id
+	 * @return (none)
+	 */
+	void setReady(size_t id)
+	{
+		uint16_t intStatus = __disable_interrupts();
+		_setReady(1UL << id, _timeFunc());
+		__restore_interrupts(intStatus);
+	}
+
+	/**
+	 * @brief Subscribes task to events.
+	 * @param id - task id
+	 * @param events - event bitmask
+	 * @return (none)
+	 */
+	void subscribe(size_t id, uint32_t events)
+	{
+		_subscriptions[id] |= events;
+	}
+
+	/**
+	 * @brief Makes ready all tasks subscribed to any of specified events.
+	 * @param events - event bitmask, e.g. taken from PendingEvents
+	 * @return (none)
+	 */
+	void notify(uint32_t events)
+	{
+		if (events == 0) return;
+
+		uint32_t tasks = 0;
+		for (size_t i = 0; i < _size; ++i)
+		{
+			if ((_subscriptions[i] & events) != 0)
+			{
+				tasks |= (1UL << i);
+			}
+		}
+
+		uint16_t intStatus = __disable_interrupts();
+		_setReady(tasks, _timeFunc());
+		__restore_interrupts(intStatus);
+	}
+
+	bool ready(size_t id) const { return (_readyMask & (1UL << id)) != 0; }
+	size_t size() const { return _size; }
+
+	/**
+	 * @brief Resumes the highest-priority ready task.
+	 * @param (none)
+	 * @return \c true if task was resumed, \c false if nothing was ready (polled tasks are made ready).
+	 */
+	bool runOnce()
+	{
+		uint32_t readyMask = _readyMask;
+		if (readyMask == 0)
+		{
+			_pollRound();
+			return false;
+		}
+
+		size_t priority = 0;
+		uint32_t candidates = 0;
+		for (; priority < PriorityCount; ++priority)
+		{
+			candidates = readyMask & _priorityMask[priority];
+			if (candidates != 0) break;
+		}
+
+		// round-robin: the first candidate starting from position after previously resumed task
+		uint32_t rest = (_nextInPriority[priority] < 32) ? candidates & ~((1UL << _nextInPriority[priority]) - 1) : 0;
+		size_t id = _lowestBit((rest != 0) ? rest : candidates);
+		_nextInPriority[priority] = id + 1;
+
+		uint32_t bit = 1UL << id;
+		uint16_t intStatus = __disable_interrupts();
+		_readyMask &= ~bit;		// consumed before resume: event set during execution is not lost
+		__restore_interrupts(intStatus);
+
+		Task& task = _tasks[id];
+		uint64_t now = _timeFunc();
+		uint64_t latency = now - task.readySince;
+		LatencyStats& stats = _stats[priority];
+		++stats.dispatches;
+		stats.total += latency;
+		if (latency > stats.max)
+		{
+			stats.max = latency;
+		}
+
+		task.pt.sliceDeadline = now + _slice;
+		if (task.func(task.pt) == PtStatus::Yielded)
+		{
+			intStatus = __disable_interrupts();
+			now = _timeFunc();
+			_setReady(bit, now);
+			_setReady(_polledMask, now);
+			__restore_interrupts(intStatus);
+		}
+		return true;
+	}
+
+	const LatencyStats& stats(size_t priority) const { return _stats[priority]; }
+
+	void resetStats()
+	{
+		for (size_t i = 0; i < PriorityCount; ++i)
+		{
+			_stats[i].dispatches = 0;
+			_stats[i].total = 0;
+			_stats[i].max = 0;
+		}
+	}
+
+private:
+	void _setReady(uint32_t mask, uint64_t now)
+	{
+		uint32_t newlyReady = mask & ~_readyMask;
+		_readyMask |= mask;
+		while (newlyReady != 0)
+		{
+			size_t id = _lowestBit(newlyReady);
+			_tasks[id].readySince = now;
+			newlyReady &= newlyReady - 1;
+		}
+	}
+
+	void _pollRound()
+	{
+		uint16_t intStatus = __disable_interrupts();
+		_setReady(_polledMask, _timeFunc());
+		__restore_interrupts(intStatus);
+	}
+
+	static size_t _lowestBit(uint32_t mask)
+	{
+		size_t pos = 0;
+		while ((mask & 1) == 0)
+		{
+			mask >>= 1;
+			++pos;
+		}
+		return pos;
+	}
+};
+
+
+template <size_t Capacity, size_t PriorityCount>
+const size_t Executor<Capacity, PriorityCount>::invalidId;
+
+
+/// @}
+} // namespace emb
+
+
@@ -0,0 +1,99 @@
+/**
+ * @file emb_extendedclock.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+namespace emb {
+/// @addtogroup emb
+/// @{
+
+
+/**
+ * @brief Extends hardware down-counter to monotonic 64-bit tick count. Counter reloads are counted in software.
+ * Timer backend must provide static methods:
+ * uint32_t counter() - current counter value, counts down from period() to 0 and reloads;
+ * uint32_t period() - counter reload value;
+ * bool reloadPending() - reload has occurred but has not been serviced by onReload() yet.
+ */
+template <class Timer>
+class ExtendedClock
+{
+private:
+	static volatile uint64_t _reloads;
+
+private:
+	ExtendedClock();					// no constructor
+	ExtendedClock(const ExtendedClock& other);		// no copy constructor
+	ExtendedClock& operator=(const ExtendedClock& other);	// no copy assignment operator
+
+public:
+	/**
+	 * @brief Resets reload count.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void reset()
+	{
+		uint16_t intStatus = __disable_interrupts();
+		_reloads = 0;
+		__restore_interrupts(intStatus);
+	}
+
+	/**
+	 * @brief Counts reload. Should be called from timer reload ISR after reload flag is cleared.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void onReload()
+	{
+		_reloads = _reloads + 1;
+	}
+
+	/**
+	 * @brief Returns number of ticks since reset. Safe to call from any context:
+	 * if reload is pending (happened during this read or ISR has not been serviced yet),
+	 * counter is re-read after reload and pending reload is taken into account.
+	 * @param (none)
+	 * @return Monotonic tick count.
+	 */
+	static uint64_t ticks()
+	{
+		uint16_t intStatus = __disable_interrupts();
+		uint64_t reloads = _reloads;
+		uint32_t count = Timer::counter();
+		if (Timer::reloadPending())
+		{
+			count = Timer::counter();
+			++reloads;
+		}
+		__restore_interrupts(intStatus);
+
+		const uint32_t period = Timer::period();
+		return reloads * (static_cast<uint64_t>(period) + 1) + (period - count);
+	}
+};
+
+
+template <class Timer>
+volatile uint64_t ExtendedClock<Timer>::_reloads = 0;
+
+
+/// @}
+} // namespace emb
+
+
@@ -42,6 +42,7 @@ public:
 
 	virtual int send(char ch) = 0;
 	virtual int send(const char* buf, uint16_t len) = 0;
+	virtual int sendNonBlocking(const char* buf, uint16_t len) = 0;
 
 	virtual void registerRxInterruptHandler(void (*handler)(void)) = 0;
 	virtual void enableRxInterrupts() = 0;
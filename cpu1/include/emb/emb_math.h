@@ -151,9 +151,9 @@ public:
 	Range<T> range;
 
 	Integrator(const Range<T>& range_, const Time& dt_, const T& init_)
-		: range(range_)
-		, _dt(dt_)
+		: _dt(dt_)
 		, _init(init_)
+		, range(range_)
 	{
 		reset();
 	}
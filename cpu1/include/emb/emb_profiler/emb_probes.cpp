@@ -0,0 +1,37 @@
+/**
+ * @file emb_probes.cpp
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "emb_probes.h"
+
+
+namespace emb {
+
+
+#define EMB_PROBE_NAME_ENTRY(id, name) name,
+
+
+const char* const ProbeRegistry::_names[Probe::Count] =
+{
+	EMB_PROBE_LIST(EMB_PROBE_NAME_ENTRY)
+};
+
+
+#undef EMB_PROBE_NAME_ENTRY
+
+
+volatile uint16_t ProbeRegistry::_disabledMask[ProbeRegistry::_maskSize];
+
+
+} // namespace emb
+
+
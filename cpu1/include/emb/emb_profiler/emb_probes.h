@@ -0,0 +1,128 @@
+/**
+ * @file emb_probes.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cstring>
+
+#include "../emb_core.h"
+#include "probes/emb_probelist.h"
+
+
+namespace emb {
+/// @addtogroup emb
+/// @{
+
+
+#define EMB_PROBE_ENUM_ENTRY(id, name) id,
+
+
+/// Profiler probes, generated from EMB_PROBE_LIST
+SCOPED_ENUM_DECLARE_BEGIN(Probe)
+{
+	EMB_PROBE_LIST(EMB_PROBE_ENUM_ENTRY)
+	Count
+}
+SCOPED_ENUM_DECLARE_END(Probe)
+
+
+#undef EMB_PROBE_ENUM_ENTRY
+
+
+/**
+ * @brief Probe registry: probe names and runtime enable/disable switches. All probes are enabled by default.
+ */
+class ProbeRegistry
+{
+private:
+	static const char* const _names[Probe::Count];
+	static const size_t _maskSize = (Probe::Count + 15) / 16;
+	static volatile uint16_t _disabledMask[_maskSize];
+
+private:
+	ProbeRegistry();						// no constructor
+	ProbeRegistry(const ProbeRegistry& other);			// no copy constructor
+	ProbeRegistry& operator=(const ProbeRegistry& other);	// no copy assignment operator
+
+public:
+	static size_t count() { return Probe::Count; }
+	static const char* name(Probe probe) { return _names[probe.underlying_value()]; }
+
+	/**
+	 * @brief Looks up probe by name.
+	 * @param name - probe name
+	 * @param probe - found probe
+	 * @return \c true if probe is found, \c false otherwise.
+	 */
+	static bool find(const char* name, Probe& probe)
+	{
+		for (size_t i = 0; i < Probe::Count; ++i)
+		{
+			if (strcmp(_names[i], name) == 0)
+			{
+				probe = static_cast<Probe::enum_type>(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Checks if probe is enabled. Single load and mask test.
+	 * @param probe - probe id
+	 * @return \c true if probe is enabled, \c false otherwise.
+	 */
+	static bool enabled(Probe probe)
+	{
+		return (_disabledMask[probe.underlying_value() >> 4] & (1U << (probe.underlying_value() & 0xF))) == 0;
+	}
+
+	static void enable(Probe probe)
+	{
+		uint16_t intStatus = __disable_interrupts();
+		_disabledMask[probe.underlying_value() >> 4] &= ~(1U << (probe.underlying_value() & 0xF));
+		__restore_interrupts(intStatus);
+	}
+
+	static void disable(Probe probe)
+	{
+		uint16_t intStatus = __disable_interrupts();
+		_disabledMask[probe.underlying_value() >> 4] |= (1U << (probe.underlying_value() & 0xF));
+		__restore_interrupts(intStatus);
+	}
+
+	static void enableAll()
+	{
+		for (size_t i = 0; i < _maskSize; ++i)
+		{
+			_disabledMask[i] = 0;
+		}
+	}
+
+	static void disableAll()
+	{
+		for (size_t i = 0; i < _maskSize; ++i)
+		{
+			_disabledMask[i] = 0xFFFF;
+		}
+	}
+};
+
+
+/// @}
+} // namespace emb
+
+
@@ -34,7 +34,7 @@ uint32_t (*DurationLogger_clk::_timeNowFunc)() = timeNowFuncNone_clk;
 
 
 uint64_t (*DurationLoggerAsync_us::_timeNowFunc)() = timeNowFuncNone_us;
-DurationLoggerAsync_us::DurationData DurationLoggerAsync_us::_durations_us[_capacity];
+volatile float DurationLoggerAsync_us::_durations_us[Probe::Count];
 
 
 /// @}
@@ -20,6 +20,7 @@
 #include <cstring>
 
 #include "../emb_core.h"
+#include "emb_probes.h"
 
 
 namespace emb {
@@ -114,43 +115,41 @@ public:
 
 
 /**
- * @brief All calculations in ns
+ * @brief All calculations in ns. Last duration is stored per probe, see EMB_PROBE_LIST.
+ * Probe disabled at construction is inactive: time is not read.
  */
 class DurationLoggerAsync_us
 {
 private:
 	static uint64_t (*_timeNowFunc)();
-	static const size_t _capacity = 10;
-
-	struct DurationData
-	{
-		const char* message;
-		volatile float value;
-		DurationData() : value(0) {}
-	};
+	static volatile float _durations_us[Probe::Count];
 
-	static DurationData _durations_us[_capacity];
-
-	const size_t _channel;
+	const Probe _probe;
+	const bool _active;
 	volatile uint64_t _start;
 public:
-	DurationLoggerAsync_us(const char* message, size_t channel)
-		: _channel(channel)
+	explicit DurationLoggerAsync_us(Probe probe)
+		: _probe(probe)
+		, _active(ProbeRegistry::enabled(probe))
 	{
-		_durations_us[_channel].message = message;
-		_start = _timeNowFunc();
+		if (_active)
+		{
+			_start = _timeNowFunc();
+		}
 	}
 
 	~DurationLoggerAsync_us()
 	{
+		if (!_active) return;
+
 		volatile uint64_t finish = _timeNowFunc();
 		if (finish < _start)
 		{
-			_durations_us[_channel].value = 0;
+			_durations_us[_probe.underlying_value()] = 0;
 		}
 		else
 		{
-			_durations_us[_channel].value = float(finish - _start) / 1000.f;
+			_durations_us[_probe.underlying_value()] = float(finish - _start) / 1000.f;
 		}
 	}
 
@@ -159,21 +158,26 @@ public:
 		_timeNowFunc = timeNowFunc;
 	}
 
+	static float duration_us(Probe probe)
+	{
+		return _durations_us[probe.underlying_value()];
+	}
+
 	static void print()
 	{
-		for (size_t i = 0; i < _capacity; ++i)
+		for (size_t i = 0; i < Probe::Count; ++i)
 		{
-			if (_durations_us[i].value != 0)
+			if (_durations_us[i] != 0)
 			{
-				printf("%s: %.3f us\n", _durations_us[i].message, _durations_us[i].value);
+				printf("%s: %.3f us\n", ProbeRegistry::name(static_cast<Probe::enum_type>(i)), _durations_us[i]);
 			}
 		}
 	}
 };
 
 
-#define EMB_LOG_DURATION_ASYNC_us(message, channel) \
-		volatile emb::DurationLoggerAsync_us EMB_UNIQ_ID(__LINE__)(message, channel);
+#define EMB_LOG_DURATION_ASYNC_us(probe) \
+		volatile emb::DurationLoggerAsync_us EMB_UNIQ_ID(__LINE__)(emb::Probe::probe);
 
 
 /// @}
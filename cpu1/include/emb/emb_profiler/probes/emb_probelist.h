@@ -0,0 +1,40 @@
+/**
+ * @file emb_probelist.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+/// @addtogroup emb
+/// @{
+
+
+/**
+ * @brief Profiler probes (application-specific): X(id, name).
+ * Each probe is declared here once and gets unique compile-time id: duplicate ids do not compile.
+ */
+#define EMB_PROBE_LIST(X) \
+	X(Superloop,		"superloop") \
+	X(SysLogIpc,		"syslog_ipc") \
+	X(ClockTasks,		"clock_tasks") \
+	X(CliServer,		"cli_server") \
+	X(CanServer,		"can_server") \
+	\
+	X(SystemClockIsr,	"systemclock_isr") \
+	X(CanIsr,		"can_isr") \
+	\
+	X(Idle,			"idle")
+
+
+/// @}
+
+
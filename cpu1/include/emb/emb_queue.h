@@ -87,6 +87,30 @@ public:
 		_front = (_front + 1) % Capacity;
 		--_size;
 	}
+
+	/**
+	 * @brief Returns contiguous span of elements starting from front: the whole queue or its part before storage wrap.
+	 * Span is valid until the next modification of queue, consumed elements are removed with pop(count).
+	 * @param len - span length, 0 if queue is empty
+	 * @return Pointer to front element.
+	 */
+	const T* frontSpan(size_t& len) const
+	{
+		len = (_front + _size <= Capacity) ? _size : Capacity - _front;
+		return &_data[_front];
+	}
+
+	/**
+	 * @brief Removes several elements from front.
+	 * @param count - number of elements
+	 * @return (none)
+	 */
+	void pop(size_t count)
+	{
+		assert(count <= _size);
+		_front = (_front + count) % Capacity;
+		_size -= count;
+	}
 };
 
 
@@ -0,0 +1,98 @@
+/**
+ * @file emb_ringbuffer.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "emb_core.h"
+
+
+namespace emb {
+/// @addtogroup emb
+/// @{
+
+
+/**
+ * @brief Lock-free single-producer single-consumer ring buffer, e.g. ISR-to-task or task-to-ISR channel.
+ * Producer modifies only head, consumer modifies only tail: push() and pop() may be called from different
+ * contexts without disabling interrupts. Counters are free-running, capacity must be power of 2.
+ */
+template <typename T, size_t Capacity>
+class RingBuffer : private emb::noncopyable
+{
+	EMB_STATIC_ASSERT((Capacity & (Capacity - 1)) == 0);
+private:
+	T _data[Capacity];
+	volatile size_t _head;	// written by producer
+	volatile size_t _tail;	// written by consumer
+public:
+	RingBuffer()
+		: _head(0)
+		, _tail(0)
+	{}
+
+	size_t capacity() const { return Capacity; }
+	size_t size() const { return _head - _tail; }
+	bool empty() const { return _head == _tail; }
+	bool full() const { return size() == Capacity; }
+
+	/**
+	 * @brief Puts element to buffer. Producer side.
+	 * @param value - element
+	 * @return \c true if element is put, \c false if buffer is full.
+	 */
+	bool push(const T& value)
+	{
+		size_t head = _head;
+		if (head - _tail == Capacity) return false;
+		_data[head & (Capacity - 1)] = value;
+		EMB_COMPILER_BARRIER();
+		_head = head + 1;	// element is published after it is written
+		return true;
+	}
+
+	/**
+	 * @brief Takes element from buffer. Consumer side.
+	 * @param value - element
+	 * @return \c true if element is taken, \c false if buffer is empty.
+	 */
+	bool pop(T& value)
+	{
+		size_t tail = _tail;
+		if (tail == _head) return false;
+		EMB_COMPILER_BARRIER();
+		value = _data[tail & (Capacity - 1)];
+		EMB_COMPILER_BARRIER();
+		_tail = tail + 1;	// slot is released after it is read
+		return true;
+	}
+
+	/**
+	 * @brief Removes all elements. Consumer side.
+	 * @param (none)
+	 * @return (none)
+	 */
+	void clear()
+	{
+		_tail = _head;
+	}
+};
+
+
+/// @}
+} // namespace emb
+
+
@@ -0,0 +1,533 @@
+/**
+ * @file emb_scheduler.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "emb_core.h"
+
+
+namespace emb {
+/// @addtogroup emb
+/// @{
+
+
+/// Scheduler task statuses
+SCOPED_ENUM_DECLARE_BEGIN(TaskStatus)
+{
+	Success = 0,
+	Fail = 1
+}
+SCOPED_ENUM_DECLARE_END(TaskStatus)
+
+
+/// Periodic task catch-up policies: next release time after late start
+SCOPED_ENUM_DECLARE_BEGIN(CatchUpPolicy)
+{
+	Skip = 0,	// release += period, missed releases are skipped: task keeps its phase
+	CatchUp = 1,	// release += period, missed releases are executed one per run() call
+	Restart = 2	// release = start time + period: late start shifts task phase
+}
+SCOPED_ENUM_DECLARE_END(CatchUpPolicy)
+
+
+/**
+ * @brief Periodic task statistics. Lateness is start time minus release time.
+ */
+struct TaskStats
+{
+	uint32_t activations;	// number of task executions
+	uint32_t overruns;	// executions started at or after the next release
+	uint32_t skipped;	// releases skipped by CatchUpPolicy::Skip
+	uint32_t latenessMin;
+	uint32_t latenessMax;
+	uint64_t latenessTotal;
+	uint32_t execMax;	// execution time in exec time source units
+	uint64_t execTotal;
+};
+
+
+/**
+ * @brief Task scheduler. Tasks are kept in binary min-heap keyed by next deadline,
+ * so due check is O(1) and task (re)scheduling is O(log N).
+ * Periodic task semantics:
+ * - task is due when now >= release time, first release is registration time + period;
+ * - after successful run next release time is set according to task catch-up policy;
+ * - if task returns Fail, it stays due and is retried on the next run() call;
+ * - every task is executed at most once per run() call;
+ * - due tasks are executed in release time order, tasks with equal release times - in rate-monotonic order
+ *   (shorter period first), then in registration order.
+ * One-shot task is removed after successful run.
+ * Optional per-task statistics (lateness, execution time, overruns) are collected into external storage.
+ * Tasks may register, cancel tasks and change periods (including their own) from inside task function.
+ */
+template <size_t Capacity>
+class Scheduler : private emb::noncopyable
+{
+	EMB_STATIC_ASSERT(Capacity < 0xFFFF);
+public:
+	typedef TaskStatus (*TaskFunc)(size_t);
+	static const size_t invalidId = Capacity;
+private:
+	static const uint16_t _notInHeap = 0xFFFF;
+
+	struct Task
+	{
+		TaskFunc func;
+		uint64_t period;
+		uint64_t deadline;
+		uint32_t seq;		// tie-breaker for equal deadlines
+		uint16_t heapPos;
+		bool oneShot;
+		CatchUpPolicy policy;
+	};
+
+	Task _tasks[Capacity];
+	uint16_t _heap[Capacity];
+	size_t _heapSize;
+	uint16_t _freeIds[Capacity];
+	size_t _freeCount;
+	uint16_t _deferred[Capacity];	// tasks that are still due after execution in current run() call
+	size_t _deferredCount;
+	uint32_t _seq;
+
+	size_t _running;
+	bool _runningCancelled;
+
+	TaskStats* _stats;
+	uint64_t (*_execTimeFunc)();
+
+public:
+	Scheduler()
+		: _stats(NULL)
+		, _execTimeFunc(NULL)
+	{
+		clear();
+	}
+
+	/**
+	 * @brief Enables task statistics.
+	 * @param storage - statistics storage of Capacity entries
+	 * @param execTimeFunc - execution time source, e.g. HighResolutionClock::ticks, may be NULL
+	 * @return (none)
+	 */
+	void enableStats(TaskStats* storage, uint64_t (*execTimeFunc)())
+	{
+		_stats = storage;
+		_execTimeFunc = execTimeFunc;
+		resetStats();
+	}
+
+	/**
+	 * @brief Resets statistics of all tasks.
+	 * @param (none)
+	 * @return (none)
+	 */
+	void resetStats()
+	{
+		if (_stats == NULL) return;
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			_resetStats(i);
+		}
+	}
+
+	/**
+	 * @brief Removes all tasks.
+	 * @param (none)
+	 * @return (none)
+	 */
+	void clear()
+	{
+		_heapSize = 0;
+		_freeCount = Capacity;
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			_freeIds[i] = Capacity - 1 - i;	// lower ids are allocated first
+			_tasks[i].heapPos = _notInHeap;
+			_tasks[i].func = NULL;
+		}
+		_deferredCount = 0;
+		_seq = 0;
+		_running = invalidId;
+		_runningCancelled = false;
+	}
+
+	/**
+	 * @brief Adds periodic task.
+	 * @param func - task function, receives task id
+	 * @param period - task period
+	 * @param now - current time
+	 * @param policy - catch-up policy
+	 * @return Task id, invalidId if scheduler is full.
+	 */
+	size_t addPeriodic(TaskFunc func, uint64_t period, uint64_t now, CatchUpPolicy policy = CatchUpPolicy::Skip)
+	{
+		return _add(func, period, now, false, policy);
+	}
+
+	/**
+	 * @brief Adds one-shot task.
+	 * @param func - task function, receives task id
+	 * @param delay - delay before task execution
+	 * @param now - current time
+	 * @return Task id, invalidId if scheduler is full.
+	 */
+	size_t addOneShot(TaskFunc func, uint64_t delay, uint64_t now)
+	{
+		return _add(func, delay, now, true, CatchUpPolicy::Restart);
+	}
+
+	/**
+	 * @brief Cancels task. Task may cancel itself.
+	 * @param id - task id
+	 * @return \c true if task is cancelled, \c false if there is no such task.
+	 */
+	bool cancel(size_t id)
+	{
+		if (id >= Capacity || _tasks[id].func == NULL) return false;
+
+		if (id == _running)
+		{
+			_runningCancelled = true;
+			return true;
+		}
+
+		if (_tasks[id].heapPos != _notInHeap)
+		{
+			_remove(_tasks[id].heapPos);
+		}
+		else
+		{
+			for (size_t i = 0; i < _deferredCount; ++i)	// task is deferred in current run() call
+			{
+				if (_deferred[i] == id)
+				{
+					_deferred[i] = _deferred[--_deferredCount];
+					break;
+				}
+			}
+		}
+		_release(id);
+		return true;
+	}
+
+	/**
+	 * @brief Sets task period. New period is counted from the last release time,
+	 * for the running task (period change from inside task function) - from its current release.
+	 * @param id - task id
+	 * @param period - new period
+	 * @return (none)
+	 */
+	void setPeriod(size_t id, uint64_t period)
+	{
+		if (id >= Capacity || _tasks[id].func == NULL) return;
+
+		Task& task = _tasks[id];
+		if (id != _running)	// next release of running task is computed in run() from its current release
+		{
+			task.deadline = task.deadline - task.period + period;
+		}
+		task.period = period;
+		if (task.heapPos != _notInHeap)
+		{
+			_siftUp(task.heapPos);
+			_siftDown(task.heapPos);
+		}
+	}
+
+	/**
+	 * @brief Restarts all tasks: next release of every task is set to specified time + period.
+	 * @param now - current time
+	 * @return (none)
+	 */
+	void restart(uint64_t now)
+	{
+		for (size_t i = 0; i < _heapSize; ++i)
+		{
+			_tasks[_heap[i]].deadline = now + _tasks[_heap[i]].period;
+		}
+		for (size_t i = 1; i < _heapSize; ++i)	// timepoints are equal - deadline order is period order
+		{
+			_siftUp(i);
+		}
+	}
+
+	/**
+	 * @brief Checks if any task is due. O(1).
+	 * @param now - current time
+	 * @return \c true if there is due task, \c false otherwise.
+	 */
+	bool due(uint64_t now) const
+	{
+		return (_heapSize != 0) && (_tasks[_heap[0]].deadline <= now);
+	}
+
+	/**
+	 * @brief Returns the earliest deadline.
+	 * @param (none)
+	 * @return Earliest deadline, max uint64_t value if there are no tasks.
+	 */
+	uint64_t nextDeadline() const
+	{
+		return (_heapSize != 0) ? _tasks[_heap[0]].deadline : ~static_cast<uint64_t>(0);
+	}
+
+	size_t size() const { return Capacity - _freeCount; }
+	size_t capacity() const { return Capacity; }
+	bool contains(size_t id) const { return (id < Capacity) && (_tasks[id].func != NULL); }
+	uint64_t period(size_t id) const { return _tasks[id].period; }
+	uint64_t deadline(size_t id) const { return _tasks[id].deadline; }
+	CatchUpPolicy policy(size_t id) const { return _tasks[id].policy; }
+	const TaskStats& stats(size_t id) const { return _stats[id]; }
+	bool statsEnabled() const { return _stats != NULL; }
+
+	/**
+	 * @brief Runs due tasks.
+	 * @param now - current time
+	 * @return Number of executed tasks.
+	 */
+	size_t run(uint64_t now)
+	{
+		size_t executed = 0;
+		_deferredCount = 0;
+
+		while (due(now))
+		{
+			size_t id = _heap[0];
+			_remove(0);
+
+			uint64_t period = _tasks[id].period;
+			uint64_t execStart = (_execTimeFunc != NULL) ? _execTimeFunc() : 0;
+			_running = id;
+			_runningCancelled = false;
+			TaskStatus status = _tasks[id].func(id);
+			_running = invalidId;
+			++executed;
+
+			Task& task = _tasks[id];
+			if (_stats != NULL)
+			{
+				uint64_t execEnd = (_execTimeFunc != NULL) ? _execTimeFunc() : 0;
+				_updateStats(id, now - task.deadline, execEnd - execStart);
+			}
+
+			if (_runningCancelled || (task.oneShot && status == TaskStatus::Success))
+			{
+				_release(id);
+				continue;
+			}
+
+			if (status == TaskStatus::Success)
+			{
+				task.deadline = _nextRelease(id, now);
+			}
+			else if (task.period != period)
+			{
+				task.deadline = task.deadline - period + task.period;	// period changed by failed run, retry is counted from last release
+			}
+
+			if (task.deadline <= now)
+			{
+				_deferred[_deferredCount++] = id;	// task is still due - it is executed on the next call
+			}
+			else
+			{
+				_push(id);
+			}
+		}
+
+		for (size_t i = 0; i < _deferredCount; ++i)
+		{
+			_push(_deferred[i]);
+		}
+		_deferredCount = 0;
+
+		return executed;
+	}
+
+private:
+	size_t _add(TaskFunc func, uint64_t period, uint64_t now, bool oneShot, CatchUpPolicy policy)
+	{
+		if (_freeCount == 0 || func == NULL) return invalidId;
+
+		size_t id = _freeIds[--_freeCount];
+		Task& task = _tasks[id];
+		task.func = func;
+		task.period = period;
+		task.deadline = now + period;
+		task.oneShot = oneShot;
+		task.policy = policy;
+		if (_stats != NULL)
+		{
+			_resetStats(id);
+		}
+		_push(id);
+		return id;
+	}
+
+	uint64_t _nextRelease(size_t id, uint64_t now)
+	{
+		Task& task = _tasks[id];
+		if ((task.period == 0) || (task.policy == CatchUpPolicy::Restart))
+		{
+			return now + task.period;
+		}
+
+		uint64_t next = task.deadline + task.period;
+		if ((task.policy == CatchUpPolicy::Skip) && (next <= now))
+		{
+			uint64_t missed = (now - next) / task.period + 1;
+			next += missed * task.period;
+			if (_stats != NULL)
+			{
+				_stats[id].skipped += missed;
+			}
+		}
+		return next;
+	}
+
+	void _updateStats(size_t id, uint64_t lateness, uint64_t execTime)
+	{
+		TaskStats& stats = _stats[id];
+		uint32_t lateness32 = (lateness < 0xFFFFFFFF) ? static_cast<uint32_t>(lateness) : 0xFFFFFFFF;
+		uint32_t execTime32 = (execTime < 0xFFFFFFFF) ? static_cast<uint32_t>(execTime) : 0xFFFFFFFF;
+
+		++stats.activations;
+		if (!_tasks[id].oneShot && (_tasks[id].period != 0) && (lateness >= _tasks[id].period))
+		{
+			++stats.overruns;
+		}
+		stats.latenessTotal += lateness32;
+		if (lateness32 < stats.latenessMin)
+		{
+			stats.latenessMin = lateness32;
+		}
+		if (lateness32 > stats.latenessMax)
+		{
+			stats.latenessMax = lateness32;
+		}
+		stats.execTotal += execTime32;
+		if (execTime32 > stats.execMax)
+		{
+			stats.execMax = execTime32;
+		}
+	}
+
+	void _resetStats(size_t id)
+	{
+		TaskStats& stats = _stats[id];
+		stats.activations = 0;
+		stats.overruns = 0;
+		stats.skipped = 0;
+		stats.latenessMin = 0xFFFFFFFF;
+		stats.latenessMax = 0;
+		stats.latenessTotal = 0;
+		stats.execMax = 0;
+		stats.execTotal = 0;
+	}
+
+	void _release(size_t id)
+	{
+		_tasks[id].func = NULL;
+		_tasks[id].heapPos = _notInHeap;
+		_freeIds[_freeCount++] = id;
+	}
+
+	bool _less(size_t lhsId, size_t rhsId) const
+	{
+		const Task& lhs = _tasks[lhsId];
+		const Task& rhs = _tasks[rhsId];
+		if (lhs.deadline != rhs.deadline)
+		{
+			return lhs.deadline < rhs.deadline;
+		}
+		if (lhs.period != rhs.period)
+		{
+			return lhs.period < rhs.period;	// rate-monotonic
+		}
+		return static_cast<int32_t>(lhs.seq - rhs.seq) < 0;	// wrap-aware
+	}
+
+	void _place(size_t pos, size_t id)
+	{
+		_heap[pos] = id;
+		_tasks[id].heapPos = pos;
+	}
+
+	void _push(size_t id)
+	{
+		_tasks[id].seq = _seq++;
+		_place(_heapSize, id);
+		_siftUp(_heapSize++);
+	}
+
+	void _remove(size_t pos)
+	{
+		_tasks[_heap[pos]].heapPos = _notInHeap;
+		--_heapSize;
+		if (pos == _heapSize) return;
+
+		size_t id = _heap[_heapSize];
+		_place(pos, id);
+		_siftUp(pos);
+		if (_heap[pos] == id)
+		{
+			_siftDown(pos);
+		}
+	}
+
+	void _siftUp(size_t pos)
+	{
+		size_t id = _heap[pos];
+		while (pos > 0)
+		{
+			size_t parent = (pos - 1) / 2;
+			if (!_less(id, _heap[parent])) break;
+			_place(pos, _heap[parent]);
+			pos = parent;
+		}
+		_place(pos, id);
+	}
+
+	void _siftDown(size_t pos)
+	{
+		size_t id = _heap[pos];
+		while (true)
+		{
+			size_t child = 2 * pos + 1;
+			if (child >= _heapSize) break;
+			if ((child + 1 < _heapSize) && _less(_heap[child + 1], _heap[child]))
+			{
+				++child;
+			}
+			if (!_less(_heap[child], id)) break;
+			_place(pos, _heap[child]);
+			pos = child;
+		}
+		_place(pos, id);
+	}
+};
+
+
+template <size_t Capacity>
+const size_t Scheduler<Capacity>::invalidId;
+
+
+/// @}
+} // namespace emb
+
+
@@ -0,0 +1,40 @@
+/**
+ * @file emb_trace.cpp
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "emb_trace.h"
+
+
+namespace emb {
+
+
+namespace trace {
+
+
+uint32_t timestampFuncNone()
+{
+	return 0;
+}
+
+
+Event Recorder::_events[Recorder::_capacity];
+volatile uint32_t Recorder::_head = 0;
+volatile bool Recorder::_enabled = false;
+uint32_t (*Recorder::_timestampFunc)() = timestampFuncNone;
+
+
+} // namespace trace
+
+
+} // namespace emb
+
+
@@ -0,0 +1,207 @@
+/**
+ * @file emb_trace.h
+ * @ingroup emb
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../emb_core.h"
+#include "../emb_profiler/emb_probes.h"
+
+
+namespace emb {
+
+
+namespace trace {
+/// @addtogroup emb
+/// @{
+
+
+/// Trace ring buffer capacity in events (application-specific), must be power of 2.
+const size_t bufferCapacity = 256;
+
+
+/// Trace event types
+SCOPED_ENUM_DECLARE_BEGIN(EventType)
+{
+	Begin = 0,
+	End = 1,
+	Instant = 2
+}
+SCOPED_ENUM_DECLARE_END(EventType)
+
+
+/**
+ * @brief Trace event: probe id with event type and raw timestamp. No strings are stored.
+ */
+struct Event
+{
+	uint16_t tag;		// [15:14] - event type, [13:0] - probe id
+	uint32_t timestamp;
+
+	EventType type() const { return static_cast<EventType::enum_type>(tag >> 14); }
+	uint16_t probe() const { return tag & 0x3FFF; }
+};
+
+
+/**
+ * @brief Event-trace recorder. Events are written to a ring buffer, the oldest ones are overwritten.
+ * Writers never wait: slot reservation is a single increment with interrupts masked,
+ * so recording is allowed from superloop and ISRs.
+ */
+class Recorder
+{
+private:
+	static const size_t _capacity = bufferCapacity;
+	EMB_STATIC_ASSERT((_capacity & (_capacity - 1)) == 0);	// capacity must be power of 2
+
+	static Event _events[_capacity];
+	static volatile uint32_t _head;
+	static volatile bool _enabled;
+	static uint32_t (*_timestampFunc)();
+
+private:
+	Recorder();					// no constructor
+	Recorder(const Recorder& other);		// no copy constructor
+	Recorder& operator=(const Recorder& other);	// no copy assignment operator
+
+	static uint32_t _reserve()
+	{
+		uint16_t intStatus = __disable_interrupts();
+		uint32_t slot = _head++;
+		__restore_interrupts(intStatus);
+		return slot;
+	}
+
+public:
+	/**
+	 * @brief Initializes recorder. Recording stays disabled until start().
+	 * @param timestampFunc - timestamp source, e.g. HighResolutionClock::counter
+	 * @return (none)
+	 */
+	static void init(uint32_t (*timestampFunc)(void))
+	{
+		_timestampFunc = timestampFunc;
+		clear();
+	}
+
+	/**
+	 * @brief Records event. Nothing is recorded if recorder or probe is disabled.
+	 * @param type - event type
+	 * @param probe - probe id
+	 * @return (none)
+	 */
+	static void record(EventType type, Probe probe)
+	{
+		if (!_enabled || !ProbeRegistry::enabled(probe)) return;
+
+		uint32_t timestamp = _timestampFunc();
+		Event& event = _events[_reserve() & (_capacity - 1)];
+		event.tag = (type.underlying_value() << 14) | (probe.underlying_value() & 0x3FFF);
+		event.timestamp = timestamp;
+	}
+
+	static void begin(Probe probe) { record(EventType::Begin, probe); }
+	static void end(Probe probe) { record(EventType::End, probe); }
+	static void instant(Probe probe) { record(EventType::Instant, probe); }
+
+	static void start() { _enabled = true; }
+	static void stop() { _enabled = false; }
+	static bool enabled() { return _enabled; }
+
+	/**
+	 * @brief Discards all recorded events.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void clear()
+	{
+		uint16_t intStatus = __disable_interrupts();
+		_head = 0;
+		__restore_interrupts(intStatus);
+	}
+
+	static size_t capacity() { return _capacity; }
+
+	/**
+	 * @brief Returns number of events available for reading.
+	 * @param (none)
+	 * @return Number of stored events.
+	 */
+	static size_t size()
+	{
+		uint32_t head = _head;
+		return (head < _capacity) ? head : _capacity;
+	}
+
+	/**
+	 * @brief Returns number of events lost due to buffer wraparound.
+	 * @param (none)
+	 * @return Number of overwritten events.
+	 */
+	static uint32_t overwritten()
+	{
+		uint32_t head = _head;
+		return (head < _capacity) ? 0 : head - _capacity;
+	}
+
+	/**
+	 * @brief Returns stored event. Recorder should be stopped while events are being read.
+	 * @param pos - event position, 0 - the oldest event
+	 * @return Stored event.
+	 */
+	static const Event& at(size_t pos)
+	{
+		assert(pos < size());
+		return _events[(overwritten() + pos) & (_capacity - 1)];
+	}
+};
+
+
+/**
+ * @brief Records begin event on construction and end event on destruction.
+ */
+class ScopedEvent
+{
+private:
+	const Probe _probe;
+public:
+	explicit ScopedEvent(Probe probe)
+		: _probe(probe)
+	{
+		Recorder::begin(_probe);
+	}
+
+	~ScopedEvent()
+	{
+		Recorder::end(_probe);
+	}
+};
+
+
+/// @}
+} // namespace trace
+
+
+} // namespace emb
+
+
+#define EMB_TRACE_BEGIN(probe) emb::trace::Recorder::begin(emb::Probe::probe)
+#define EMB_TRACE_END(probe) emb::trace::Recorder::end(emb::Probe::probe)
+#define EMB_TRACE_INSTANT(probe) emb::trace::Recorder::instant(emb::Probe::probe)
+#define EMB_TRACE_SCOPE(probe) \
+		emb::trace::ScopedEvent EMB_UNIQ_ID(__LINE__)(emb::Probe::probe);
+
+
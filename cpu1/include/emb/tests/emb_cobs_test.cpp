@@ -0,0 +1,87 @@
+///
+#include "emb_test.h"
+
+
+namespace {
+
+
+bool encodesTo(const unsigned char* src, size_t len, const unsigned char* expected, size_t expectedLen)
+{
+	unsigned char encoded[300];
+	if (emb::cobs_encode(src, len, encoded) != expectedLen) return false;
+	for (size_t i = 0; i < expectedLen; ++i)
+	{
+		if (encoded[i] != expected[i]) return false;
+	}
+
+	unsigned char decoded[300];
+	size_t decodedLen = 0;
+	if (!emb::cobs_decode(encoded, expectedLen, decoded, decodedLen)) return false;
+	if (decodedLen != len) return false;
+	for (size_t i = 0; i < len; ++i)
+	{
+		if (decoded[i] != src[i]) return false;
+	}
+	return true;
+}
+
+
+} // namespace
+
+
+void EmbTest::CobsTest()
+{
+	{
+		const unsigned char src[1] = {0x00};
+		const unsigned char expected[2] = {0x01, 0x01};
+		EMB_ASSERT_TRUE(encodesTo(src, 1, expected, 2));
+	}
+	{
+		const unsigned char src[2] = {0x00, 0x00};
+		const unsigned char expected[3] = {0x01, 0x01, 0x01};
+		EMB_ASSERT_TRUE(encodesTo(src, 2, expected, 3));
+	}
+	{
+		const unsigned char src[4] = {0x11, 0x22, 0x00, 0x33};
+		const unsigned char expected[5] = {0x03, 0x11, 0x22, 0x02, 0x33};
+		EMB_ASSERT_TRUE(encodesTo(src, 4, expected, 5));
+	}
+	{
+		const unsigned char expected[1] = {0x01};
+		EMB_ASSERT_TRUE(encodesTo(expected, 0, expected, 1));
+	}
+
+	// 254 and 255 non-zero octets: block length limit
+	unsigned char src[255];
+	unsigned char expected[258];
+	for (size_t i = 0; i < 255; ++i)
+	{
+		src[i] = i + 1;
+	}
+	expected[0] = 0xFF;
+	for (size_t i = 0; i < 254; ++i)
+	{
+		expected[i + 1] = i + 1;
+	}
+	EMB_ASSERT_TRUE(encodesTo(src, 254, expected, 255));
+	expected[255] = 0x02;
+	expected[256] = 0xFF;
+	EMB_ASSERT_TRUE(encodesTo(src, 255, expected, 257));
+	EMB_ASSERT_TRUE(emb::cobs_max_encoded_len(255) >= 257);
+
+	// invalid encodings: zero octet, block beyond end
+	const unsigned char invalid1[3] = {0x02, 0x00, 0x01};
+	const unsigned char invalid2[2] = {0x05, 0x11};
+	unsigned char decoded[8];
+	size_t decodedLen = 0;
+	EMB_ASSERT_TRUE(!emb::cobs_decode(invalid1, 3, decoded, decodedLen));
+	EMB_ASSERT_TRUE(!emb::cobs_decode(invalid2, 2, decoded, decodedLen));
+
+	// in-place decoding
+	unsigned char buf[5] = {0x03, 0x11, 0x22, 0x02, 0x33};
+	EMB_ASSERT_TRUE(emb::cobs_decode(buf, 5, buf, decodedLen));
+	EMB_ASSERT_EQUAL(decodedLen, 4);
+	EMB_ASSERT_TRUE(buf[0] == 0x11 && buf[1] == 0x22 && buf[2] == 0x00 && buf[3] == 0x33);
+}
+
+
@@ -0,0 +1,79 @@
+///
+#include "emb_test.h"
+
+
+uint32_t cpuloadTestCounter = 0;
+uint32_t cpuloadTestReads = 0;
+
+
+uint32_t cpuloadTestCounterFunc()
+{
+	++cpuloadTestReads;
+	return cpuloadTestCounter;
+}
+
+
+void EmbTest::CpuLoadTest()
+{
+	using emb::cpuload::Meter;
+	using emb::cpuload::Region;
+	using emb::Probe;
+
+	// down-counter: period 999 (1000 clk), 1 clk = 1 us
+	Meter::init(cpuloadTestCounterFunc, 999, 1000000, 0);
+
+	// ISR preempts superloop stage: ISR time is excluded from stage time
+	cpuloadTestCounter = 500;
+	Region stage = Meter::enter(Probe::CliServer);
+	cpuloadTestCounter = 400;
+	Region isr = Meter::enter(Probe::SystemClockIsr);
+	cpuloadTestCounter = 370;
+	Meter::exit(Probe::SystemClockIsr, isr);
+	cpuloadTestCounter = 300;
+	Meter::exit(Probe::CliServer, stage);
+
+	// counter reload inside region
+	cpuloadTestCounter = 10;
+	stage = Meter::enter(Probe::CanServer);
+	cpuloadTestCounter = 990;
+	Meter::exit(Probe::CanServer, stage);
+
+	// window 10 ms = 10000 clk
+	Meter::update(10);
+	EMB_ASSERT_EQUAL(Meter::window_ms(), 10);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::CliServer).wcet, 170);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::CliServer).load, 170);	// 1.70%
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::CliServer).rate, 100);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::SystemClockIsr).wcet, 30);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::SystemClockIsr).load, 30);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::CanServer).wcet, 20);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::CanIsr).rate, 0);
+
+	// next window: load and rate are recalculated, WCET is kept
+	cpuloadTestCounter = 900;
+	stage = Meter::enter(Probe::CliServer);
+	cpuloadTestCounter = 850;
+	Meter::exit(Probe::CliServer, stage);
+
+	// disabled probe: timestamp is not read, region is not accounted even if probe is enabled before exit
+	emb::ProbeRegistry::disable(Probe::CanIsr);
+	uint32_t reads = cpuloadTestReads;
+	Region disabled = Meter::enter(Probe::CanIsr);
+	EMB_ASSERT_TRUE(!disabled.active);
+	emb::ProbeRegistry::enable(Probe::CanIsr);
+	Meter::exit(Probe::CanIsr, disabled);
+	EMB_ASSERT_EQUAL(cpuloadTestReads, reads);
+	Meter::update(20);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::CliServer).load, 50);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::CliServer).wcet, 170);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::SystemClockIsr).load, 0);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::SystemClockIsr).wcet, 30);
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::CanIsr).rate, 0);
+
+	Meter::resetWcet();
+	EMB_ASSERT_EQUAL(Meter::stats(Probe::CliServer).wcet, 0);
+
+	Meter::init(cpuloadTestCounterFunc, 999, 1000000, 0);
+}
+
+
@@ -0,0 +1,32 @@
+///
+#include "emb_test.h"
+
+
+void EmbTest::CrcTest()
+{
+	const char* check = "123456789";
+	unsigned char data[9];
+	for (size_t i = 0; i < 9; ++i)
+	{
+		data[i] = check[i];
+	}
+	EMB_ASSERT_EQUAL(emb::crc16_ccitt(data, 9), 0x29B1);
+
+	// chunked calculation
+	uint16_t crc = emb::crc16_ccitt(data, 4);
+	EMB_ASSERT_EQUAL(emb::crc16_ccitt(data + 4, 5, crc), 0x29B1);
+
+	EMB_ASSERT_EQUAL(emb::crc16_ccitt(data, 0), 0xFFFF);
+
+	// message followed by its CRC (big-endian) gives zero remainder
+	unsigned char frame[11];
+	for (size_t i = 0; i < 9; ++i)
+	{
+		frame[i] = data[i];
+	}
+	frame[9] = 0x29;
+	frame[10] = 0xB1;
+	EMB_ASSERT_EQUAL(emb::crc16_ccitt(frame, 11), 0);
+}
+
+
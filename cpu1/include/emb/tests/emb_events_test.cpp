@@ -0,0 +1,117 @@
+///
+#include "emb_test.h"
+
+
+namespace {
+
+
+uint64_t eventsTestTime;
+uint64_t eventsTestTimeFunc() { return eventsTestTime; }
+
+
+uint32_t eventsTestLog[16];
+size_t eventsTestLogSize;
+uint32_t eventsTestWork[4];	// units of work available for service, consumed at once
+
+
+/// Service drains all available work: coalesced events are not lost.
+emb::PtStatus eventsTestService(emb::ProtoThread& pt)
+{
+	uint32_t id = *static_cast<uint32_t*>(pt.arg);
+	eventsTestLog[eventsTestLogSize++] = id;
+	eventsTestWork[id] = 0;
+	eventsTestTime += 5;
+	return emb::PtStatus::Waiting;
+}
+
+
+uint32_t eventsTestIds[4] = {0, 1, 2, 3};
+
+
+/// Superloop pass as in main(): takes pending events, dispatches one service or idles.
+bool eventsTestPass(emb::Executor<4, 3>& executor)
+{
+	executor.notify(emb::PendingEvents::take());
+	return executor.runOnce();
+}
+
+
+} // namespace
+
+
+void EmbTest::EventsTest()
+{
+	using emb::PendingEvents;
+	using emb::Event;
+
+	eventsTestTime = 0;
+	eventsTestLogSize = 0;
+	PendingEvents::take();
+
+	// services as in main(): CAN (0), clock tasks (1), CLI (2)
+	emb::Executor<4, 3> executor(eventsTestTimeFunc, 100);
+	size_t can = executor.add(eventsTestService, &eventsTestIds[0], 0, false);
+	executor.subscribe(can, PendingEvents::bit(Event::CanRx) | PendingEvents::bit(Event::ClockTick));
+	size_t clock = executor.add(eventsTestService, &eventsTestIds[1], 1, false);
+	executor.subscribe(clock, PendingEvents::bit(Event::ClockTick));
+	size_t cli = executor.add(eventsTestService, &eventsTestIds[2], 2, false);
+	executor.subscribe(cli, PendingEvents::bit(Event::UartRx) | PendingEvents::bit(Event::ClockTick));
+
+	while (eventsTestPass(executor)) {}	// initial run of all services
+	eventsTestLogSize = 0;
+
+	// nothing pending - superloop idles
+	EMB_ASSERT_TRUE(!PendingEvents::any());
+	EMB_ASSERT_TRUE(!eventsTestPass(executor));
+	EMB_ASSERT_EQUAL(eventsTestLogSize, 0);
+
+	// only subscribed services are dispatched
+	PendingEvents::set(Event::UartRx);
+	EMB_ASSERT_TRUE(PendingEvents::pending(Event::UartRx));
+	EMB_ASSERT_TRUE(eventsTestPass(executor));
+	EMB_ASSERT_TRUE(!eventsTestPass(executor));
+	EMB_ASSERT_EQUAL(eventsTestLogSize, 1);
+	EMB_ASSERT_EQUAL(eventsTestLog[0], cli);
+
+	// coalesced events: three Rx interrupts before superloop pass - one dispatch, all work is done
+	eventsTestLogSize = 0;
+	for (size_t i = 0; i < 3; ++i)
+	{
+		++eventsTestWork[can];
+		PendingEvents::set(Event::CanRx);
+	}
+	while (eventsTestPass(executor)) {}
+	EMB_ASSERT_EQUAL(eventsTestLogSize, 1);
+	EMB_ASSERT_EQUAL(eventsTestLog[0], can);
+	EMB_ASSERT_EQUAL(eventsTestWork[can], 0);
+
+	// dispatch order is priority order regardless of event order, latency is measured from notify
+	eventsTestLogSize = 0;
+	executor.resetStats();
+	eventsTestTime = 1000;
+	PendingEvents::set(Event::UartRx);
+	PendingEvents::set(Event::ClockTick);
+	while (eventsTestPass(executor)) {}
+	EMB_ASSERT_EQUAL(eventsTestLogSize, 3);
+	EMB_ASSERT_EQUAL(eventsTestLog[0], can);
+	EMB_ASSERT_EQUAL(eventsTestLog[1], clock);
+	EMB_ASSERT_EQUAL(eventsTestLog[2], cli);
+	EMB_ASSERT_EQUAL(executor.stats(0).max, 0);
+	EMB_ASSERT_EQUAL(executor.stats(1).max, 5);
+	EMB_ASSERT_EQUAL(executor.stats(2).max, 10);
+
+	// event raised while service is running (e.g. by ISR) is dispatched on the next pass
+	eventsTestLogSize = 0;
+	PendingEvents::set(Event::ClockTick);
+	EMB_ASSERT_TRUE(eventsTestPass(executor));	// can
+	PendingEvents::set(Event::CanRx);
+	EMB_ASSERT_TRUE(eventsTestPass(executor));	// can again: higher priority than pending clock and cli
+	EMB_ASSERT_EQUAL(eventsTestLog[0], can);
+	EMB_ASSERT_EQUAL(eventsTestLog[1], can);
+	while (eventsTestPass(executor)) {}
+	EMB_ASSERT_EQUAL(eventsTestLogSize, 4);
+	EMB_ASSERT_TRUE(!PendingEvents::any());
+}
+
+
+
@@ -0,0 +1,188 @@
+///
+#include "emb_test.h"
+
+
+namespace {
+
+
+uint64_t executorTime;
+uint64_t executorTestTime() { return executorTime; }
+
+
+uint32_t executorLog[32];
+size_t executorLogSize;
+
+
+void logTask(void* arg)
+{
+	executorLog[executorLogSize++] = *static_cast<uint32_t*>(arg);
+}
+
+
+/// Runs once per readiness and waits for next event.
+emb::PtStatus eventTask(emb::ProtoThread& pt)
+{
+	logTask(pt.arg);
+	executorTime += 1;
+	return emb::PtStatus::Waiting;
+}
+
+
+/// Yields three times, then waits for event.
+emb::PtStatus yieldingTask(emb::ProtoThread& pt)
+{
+	static uint32_t step;
+	EMB_PT_BEGIN(pt);
+	for (step = 0; step < 3; ++step)
+	{
+		logTask(pt.arg);
+		EMB_PT_YIELD(pt);
+	}
+	EMB_PT_END(pt);
+}
+
+
+bool waitCondition;
+
+
+/// Is resumed at wait point until condition is met.
+emb::PtStatus waitingTask(emb::ProtoThread& pt)
+{
+	EMB_PT_BEGIN(pt);
+	EMB_PT_WAIT_UNTIL(pt, waitCondition);
+	logTask(pt.arg);
+	EMB_PT_END(pt);
+}
+
+
+/// Works until time slice is over.
+emb::PtStatus slicedTask(emb::ProtoThread& pt)
+{
+	EMB_PT_BEGIN(pt);
+	while (true)
+	{
+		logTask(pt.arg);
+		executorTime += 10;
+		if (pt.sliceExpired())
+		{
+			EMB_PT_YIELD(pt);
+		}
+	}
+	EMB_PT_END(pt);
+}
+
+
+uint32_t ids[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+
+} // namespace
+
+
+void EmbTest::ExecutorTest()
+{
+	// every task is started once: priority order, equal priority - round-robin
+	executorTime = 0;
+	executorLogSize = 0;
+	emb::Executor<8, 3> executor(executorTestTime, 100);
+	size_t low = executor.add(eventTask, &ids[0], 2, false);
+	size_t highA = executor.add(eventTask, &ids[1], 0, false);
+	size_t mid = executor.add(eventTask, &ids[2], 1, false);
+	size_t highB = executor.add(eventTask, &ids[3], 0, false);
+	EMB_ASSERT_EQUAL(executor.size(), 4);
+	EMB_ASSERT_EQUAL(executor.add(eventTask, &ids[4], 3, false), executor.invalidId);
+
+	while (executor.runOnce()) {}
+	EMB_ASSERT_EQUAL(executorLogSize, 4);
+	EMB_ASSERT_EQUAL(executorLog[0], highA);
+	EMB_ASSERT_EQUAL(executorLog[1], highB);
+	EMB_ASSERT_EQUAL(executorLog[2], mid);
+	EMB_ASSERT_EQUAL(executorLog[3], low);
+
+	// non-polled tasks wait for events
+	executorLogSize = 0;
+	EMB_ASSERT_TRUE(!executor.runOnce());
+	EMB_ASSERT_TRUE(!executor.runOnce());
+	EMB_ASSERT_EQUAL(executorLogSize, 0);
+
+	executor.setReady(low);
+	executor.setReady(highB);
+	executor.setReady(highA);
+	EMB_ASSERT_TRUE(executor.ready(low));
+	while (executor.runOnce()) {}
+	EMB_ASSERT_EQUAL(executorLogSize, 3);
+	EMB_ASSERT_EQUAL(executorLog[0], highA);	// round-robin continues after highB
+	EMB_ASSERT_EQUAL(executorLog[1], highB);
+	EMB_ASSERT_EQUAL(executorLog[2], low);
+	EMB_ASSERT_TRUE(!executor.ready(low));
+
+	// round-robin: task that ran last gives way to other ready task of equal priority
+	executorLogSize = 0;
+	executor.setReady(highA);
+	executor.runOnce();
+	executor.setReady(highA);
+	executor.setReady(highB);
+	executor.runOnce();
+	executor.runOnce();
+	EMB_ASSERT_EQUAL(executorLog[0], highA);
+	EMB_ASSERT_EQUAL(executorLog[1], highB);
+	EMB_ASSERT_EQUAL(executorLog[2], highA);
+
+	// latency stats: time from becoming ready to resume per priority class
+	executor.resetStats();
+	executorTime = 1000;
+	executor.setReady(low);
+	executor.setReady(highA);
+	executor.setReady(mid);
+	while (executor.runOnce()) {}	// each task takes 1 time unit
+	EMB_ASSERT_EQUAL(executor.stats(0).dispatches, 1);
+	EMB_ASSERT_EQUAL(executor.stats(0).max, 0);
+	EMB_ASSERT_EQUAL(executor.stats(1).max, 1);
+	EMB_ASSERT_EQUAL(executor.stats(2).max, 2);
+	EMB_ASSERT_EQUAL(executor.stats(2).total, 2);
+
+	// protothreads: yield keeps task ready and lets other tasks run, wait resumes at wait point
+	executorTime = 0;
+	executorLogSize = 0;
+	waitCondition = false;
+	emb::Executor<4, 1> ptExecutor(executorTestTime, 100);
+	size_t yielding = ptExecutor.add(yieldingTask, &ids[0], 0, false);
+	size_t polled = ptExecutor.add(eventTask, &ids[1], 0, true);
+	size_t waiting = ptExecutor.add(waitingTask, &ids[2], 0, true);
+
+	while (ptExecutor.runOnce()) {}
+	// waiting task stays at wait point, nothing is logged
+	EMB_ASSERT_EQUAL(executorLogSize, 6);
+	for (size_t i = 0; i < 6; i += 2)
+	{
+		EMB_ASSERT_EQUAL(executorLog[i], yielding);
+		EMB_ASSERT_EQUAL(executorLog[i + 1], polled);
+	}
+
+	// polled tasks are made ready by the last runOnce() call that found nothing ready
+	executorLogSize = 0;
+	waitCondition = true;
+	EMB_ASSERT_TRUE(ptExecutor.ready(polled) && ptExecutor.ready(waiting));
+	while (ptExecutor.runOnce()) {}
+	EMB_ASSERT_EQUAL(executorLogSize, 2);
+	EMB_ASSERT_EQUAL(executorLog[0], polled);
+	EMB_ASSERT_EQUAL(executorLog[1], waiting);
+
+	// yielding task restarts from the beginning on next event
+	executorLogSize = 0;
+	ptExecutor.setReady(yielding);
+	ptExecutor.runOnce();
+	EMB_ASSERT_EQUAL(executorLogSize, 1);
+	EMB_ASSERT_EQUAL(executorLog[0], yielding);
+
+	// time slice
+	executorTime = 0;
+	executorLogSize = 0;
+	emb::Executor<2, 1> slicedExecutor(executorTestTime, 35);
+	slicedExecutor.add(slicedTask, &ids[0], 0, false);
+	slicedExecutor.runOnce();
+	EMB_ASSERT_EQUAL(executorLogSize, 4);	// 0, 10, 20, 30 - slice is over at 40
+	slicedExecutor.runOnce();
+	EMB_ASSERT_EQUAL(executorLogSize, 8);
+}
+
+
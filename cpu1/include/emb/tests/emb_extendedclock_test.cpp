@@ -0,0 +1,107 @@
+///
+#include "emb_test.h"
+
+
+/**
+ * @brief Simulated down-counter timer: each counter read takes some ticks, reload sets pending flag.
+ */
+struct ExtendedClockTestTimer
+{
+	static uint32_t value;
+	static bool pending;
+	static uint64_t elapsed;
+	static uint32_t readCost;
+
+	static uint32_t period() { return 99; }
+	static bool reloadPending() { return pending; }
+
+	static uint32_t counter()
+	{
+		advance(readCost);
+		return value;
+	}
+
+	static void advance(uint32_t ticks)
+	{
+		for (uint32_t i = 0; i < ticks; ++i)
+		{
+			if (value == 0)
+			{
+				value = period();
+				pending = true;
+			}
+			else
+			{
+				--value;
+			}
+			++elapsed;
+		}
+	}
+
+	static void reset()
+	{
+		value = period();
+		pending = false;
+		elapsed = 0;
+		readCost = 0;
+	}
+};
+
+
+uint32_t ExtendedClockTestTimer::value;
+bool ExtendedClockTestTimer::pending;
+uint64_t ExtendedClockTestTimer::elapsed;
+uint32_t ExtendedClockTestTimer::readCost;
+
+
+void EmbTest::ExtendedClockTest()
+{
+	typedef ExtendedClockTestTimer Timer;
+	typedef emb::ExtendedClock<ExtendedClockTestTimer> Clock;
+
+	Timer::reset();
+	Clock::reset();
+	EMB_ASSERT_EQUAL(Clock::ticks(), 0);
+
+	Timer::advance(99);
+	EMB_ASSERT_EQUAL(Clock::ticks(), 99);
+
+	// reload is pending, ISR is not serviced yet
+	Timer::advance(1);
+	EMB_ASSERT_TRUE(Timer::pending);
+	EMB_ASSERT_EQUAL(Clock::ticks(), 100);
+	Timer::advance(50);
+	EMB_ASSERT_EQUAL(Clock::ticks(), 150);
+
+	// ISR
+	Timer::pending = false;
+	Clock::onReload();
+	EMB_ASSERT_EQUAL(Clock::ticks(), 150);
+
+	// reload occurs between reload count and counter reads: result must be within read interval and monotonic
+	uint64_t prev = Clock::ticks();
+	for (uint32_t i = 0; i < 5000; ++i)
+	{
+		Timer::readCost = (i % 13) + 1;
+		uint64_t before = Timer::elapsed;
+		uint64_t t = Clock::ticks();
+		uint64_t after = Timer::elapsed;
+
+		EMB_ASSERT_TRUE(t >= before);
+		EMB_ASSERT_TRUE(t <= after);
+		EMB_ASSERT_TRUE(t >= prev);
+		prev = t;
+
+		if (Timer::pending && (i % 3 == 0))	// ISR latency
+		{
+			Timer::pending = false;
+			Clock::onReload();
+		}
+	}
+	EMB_ASSERT_TRUE(Timer::elapsed > 10 * (Timer::period() + 1));	// many reloads were covered
+
+	Timer::reset();
+	Clock::reset();
+}
+
+
@@ -0,0 +1,64 @@
+///
+#include "emb_test.h"
+
+
+uint32_t probesTestTimestamp = 0;
+
+
+uint32_t probesTestTimestampFunc()
+{
+	return probesTestTimestamp++;
+}
+
+
+void EmbTest::ProbeRegistryTest()
+{
+	using emb::Probe;
+	using emb::ProbeRegistry;
+
+	EMB_ASSERT_EQUAL(ProbeRegistry::count(), Probe::Count);
+	EMB_ASSERT_EQUAL(strcmp(ProbeRegistry::name(Probe::Superloop), "superloop"), 0);
+	EMB_ASSERT_EQUAL(strcmp(ProbeRegistry::name(Probe::CanIsr), "can_isr"), 0);
+
+	Probe probe = Probe::Superloop;
+	EMB_ASSERT_TRUE(ProbeRegistry::find("cli_server", probe));
+	EMB_ASSERT_EQUAL(probe, Probe::CliServer);
+	EMB_ASSERT_TRUE(!ProbeRegistry::find("unknown", probe));
+	EMB_ASSERT_EQUAL(probe, Probe::CliServer);
+
+	for (size_t i = 0; i < Probe::Count; ++i)
+	{
+		EMB_ASSERT_TRUE(ProbeRegistry::enabled(static_cast<Probe::enum_type>(i)));	// enabled by default
+	}
+
+	ProbeRegistry::disable(Probe::CliServer);
+	EMB_ASSERT_TRUE(!ProbeRegistry::enabled(Probe::CliServer));
+	EMB_ASSERT_TRUE(ProbeRegistry::enabled(Probe::ClockTasks));
+	EMB_ASSERT_TRUE(ProbeRegistry::enabled(Probe::CanServer));
+
+	// disabled probe is not traced
+	emb::trace::Recorder::init(probesTestTimestampFunc);
+	emb::trace::Recorder::start();
+	EMB_TRACE_INSTANT(CliServer);
+	EMB_TRACE_INSTANT(CanServer);
+	emb::trace::Recorder::stop();
+	EMB_ASSERT_EQUAL(emb::trace::Recorder::size(), 1);
+	EMB_ASSERT_EQUAL(emb::trace::Recorder::at(0).probe(), Probe::CanServer);
+	emb::trace::Recorder::clear();
+
+	ProbeRegistry::enable(Probe::CliServer);
+	EMB_ASSERT_TRUE(ProbeRegistry::enabled(Probe::CliServer));
+
+	ProbeRegistry::disableAll();
+	for (size_t i = 0; i < Probe::Count; ++i)
+	{
+		EMB_ASSERT_TRUE(!ProbeRegistry::enabled(static_cast<Probe::enum_type>(i)));
+	}
+	ProbeRegistry::enableAll();
+	for (size_t i = 0; i < Probe::Count; ++i)
+	{
+		EMB_ASSERT_TRUE(ProbeRegistry::enabled(static_cast<Probe::enum_type>(i)));
+	}
+}
+
+
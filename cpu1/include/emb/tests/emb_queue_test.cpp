@@ -83,6 +83,40 @@ void EmbTest::QueueTest()
 		queue.pop();
 	}
 	EMB_ASSERT_TRUE(queue.empty());
+
+	// span: contiguous part before storage wrap
+	size_t len = 1;
+	queue.clear();
+	queue.frontSpan(len);
+	EMB_ASSERT_EQUAL(len, 0);
+	for (size_t i = 1; i <= 7; ++i)
+	{
+		queue.push(i);
+	}
+	const int* span = queue.frontSpan(len);
+	EMB_ASSERT_EQUAL(len, 7);
+	EMB_ASSERT_EQUAL(span[0], 1);
+	EMB_ASSERT_EQUAL(span[6], 7);
+	queue.pop(5);
+	EMB_ASSERT_EQUAL(queue.size(), 2);
+	EMB_ASSERT_EQUAL(queue.front(), 6);
+	for (size_t i = 8; i <= 13; ++i)
+	{
+		queue.push(i);	// 11, 12, 13 are wrapped
+	}
+	span = queue.frontSpan(len);
+	EMB_ASSERT_EQUAL(len, 5);
+	EMB_ASSERT_EQUAL(span[0], 6);
+	EMB_ASSERT_EQUAL(span[4], 10);
+	queue.pop(len);
+	span = queue.frontSpan(len);
+	EMB_ASSERT_EQUAL(len, 3);
+	EMB_ASSERT_EQUAL(span[0], 11);
+	EMB_ASSERT_EQUAL(queue.back(), 13);
+	queue.pop(len);
+	EMB_ASSERT_TRUE(queue.empty());
+	queue.push(14);
+	EMB_ASSERT_EQUAL(queue.front(), 14);
 }
 
 
@@ -0,0 +1,56 @@
+///
+#include "emb_test.h"
+
+
+void EmbTest::RingBufferTest()
+{
+	emb::RingBuffer<int, 8> ring;
+	EMB_ASSERT_TRUE(ring.empty());
+	EMB_ASSERT_TRUE(!ring.full());
+	EMB_ASSERT_EQUAL(ring.capacity(), 8);
+
+	int value = 0;
+	EMB_ASSERT_TRUE(!ring.pop(value));
+
+	for (int i = 1; i <= 8; ++i)
+	{
+		EMB_ASSERT_TRUE(ring.push(i));
+	}
+	EMB_ASSERT_TRUE(ring.full());
+	EMB_ASSERT_TRUE(!ring.push(9));
+	EMB_ASSERT_EQUAL(ring.size(), 8);
+
+	EMB_ASSERT_TRUE(ring.pop(value));
+	EMB_ASSERT_EQUAL(value, 1);
+	EMB_ASSERT_TRUE(ring.push(9));
+	for (int i = 2; i <= 9; ++i)
+	{
+		EMB_ASSERT_TRUE(ring.pop(value));
+		EMB_ASSERT_EQUAL(value, i);
+	}
+	EMB_ASSERT_TRUE(ring.empty());
+
+	// free-running counters: order is kept after many wraps
+	int expected = 0;
+	int next = 0;
+	for (size_t i = 0; i < 100; ++i)
+	{
+		for (size_t j = 0; j < i % 8; ++j)
+		{
+			ring.push(next++);
+		}
+		while (ring.pop(value))
+		{
+			EMB_ASSERT_EQUAL(value, expected++);
+		}
+	}
+	EMB_ASSERT_EQUAL(expected, next);
+
+	ring.push(1);
+	ring.push(2);
+	ring.clear();
+	EMB_ASSERT_TRUE(ring.empty());
+	EMB_ASSERT_EQUAL(ring.size(), 0);
+}
+
+
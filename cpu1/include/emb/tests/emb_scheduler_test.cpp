@@ -0,0 +1,399 @@
+///
+#include "emb_test.h"
+
+
+namespace {
+
+
+/**
+ * @brief Reference scheduler: previous SystemClock task store and runTasks() loop.
+ */
+class LinearScheduler
+{
+public:
+	struct Task
+	{
+		uint64_t period;
+		uint64_t timepoint;
+		emb::TaskStatus (*func)(size_t);
+	};
+	emb::StaticVector<Task, 8> tasks;
+
+	void addPeriodic(emb::TaskStatus (*func)(size_t), uint64_t period, uint64_t now)
+	{
+		Task task = {period, now, func};
+		tasks.push_back(task);
+	}
+
+	void setPeriod(size_t index, uint64_t period)
+	{
+		tasks[index].period = period;
+	}
+
+	void run(uint64_t now)
+	{
+		for (size_t i = 0; i < tasks.size(); ++i)
+		{
+			if (now >= (tasks[i].timepoint + tasks[i].period))
+			{
+				if (tasks[i].func(i) == emb::TaskStatus::Success)
+				{
+					tasks[i].timepoint = now;
+				}
+			}
+		}
+	}
+};
+
+
+LinearScheduler referenceScheduler;
+emb::Scheduler<8> testScheduler;
+bool useReference;
+
+
+const size_t logCapacity = 512;
+struct LogEntry
+{
+	uint32_t time;
+	uint32_t id;
+};
+LogEntry schedulerLog[2][logCapacity];
+size_t schedulerLogSize[2];
+uint32_t schedulerTime;
+uint32_t runCounts[8];
+
+
+void setPeriod(size_t id, uint64_t period)
+{
+	if (useReference)
+	{
+		referenceScheduler.setPeriod(id, period);
+	}
+	else
+	{
+		testScheduler.setPeriod(id, period);
+	}
+}
+
+
+/// Task behaviour depends on task id: fixed period, self period change (as taskToggleLed does), occasional fail.
+emb::TaskStatus schedulerTestTask(size_t id)
+{
+	size_t log = useReference ? 0 : 1;
+	if (schedulerLogSize[log] < logCapacity)
+	{
+		LogEntry entry = {schedulerTime, static_cast<uint32_t>(id)};
+		schedulerLog[log][schedulerLogSize[log]++] = entry;
+	}
+
+	uint32_t count = runCounts[id]++;
+	if (id % 3 == 0)
+	{
+		const uint64_t periods[4] = {3, 3, 3, 17};
+		setPeriod(id, periods[count % 4]);
+	}
+	if ((id % 4 == 1) && (count % 5 == 4))
+	{
+		return emb::TaskStatus::Fail;
+	}
+	return emb::TaskStatus::Success;
+}
+
+
+void runSchedulerScenario(bool reference)
+{
+	useReference = reference;
+	schedulerLogSize[reference ? 0 : 1] = 0;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		runCounts[i] = 0;
+	}
+
+	const uint64_t periods[8] = {5, 7, 10, 1, 0, 13, 4, 25};
+	for (size_t i = 0; i < 8; ++i)
+	{
+		if (reference)
+		{
+			referenceScheduler.addPeriodic(schedulerTestTask, periods[i], 0);
+		}
+		else
+		{
+			testScheduler.addPeriodic(schedulerTestTask, periods[i], 0, emb::CatchUpPolicy::Restart);
+		}
+	}
+
+	// superloop passes with jitter
+	for (schedulerTime = 0; schedulerTime < 300; schedulerTime += (schedulerTime % 3) + 1)
+	{
+		if (reference)
+		{
+			referenceScheduler.run(schedulerTime);
+		}
+		else
+		{
+			testScheduler.run(schedulerTime);
+		}
+	}
+}
+
+
+/// Sorts log entries with equal time by id: reference runs due tasks in index order, scheduler - in deadline order.
+void normalizeSchedulerLog(LogEntry* log, size_t size)
+{
+	for (size_t i = 1; i < size; ++i)
+	{
+		for (size_t j = i; (j > 0) && (log[j - 1].time == log[j].time) && (log[j - 1].id > log[j].id); --j)
+		{
+			std::swap(log[j - 1], log[j]);
+		}
+	}
+}
+
+
+uint32_t schedulerTestOrder[8];
+size_t schedulerTestOrderSize;
+size_t schedulerTestCancelId;
+emb::Scheduler<8> schedulerTestCancel;
+
+
+emb::TaskStatus orderTestTask(size_t id)
+{
+	schedulerTestOrder[schedulerTestOrderSize++] = id;
+	return emb::TaskStatus::Success;
+}
+
+
+emb::TaskStatus selfCancelTask(size_t id)
+{
+	schedulerTestOrder[schedulerTestOrderSize++] = id;
+	schedulerTestCancel.cancel(id);
+	return emb::TaskStatus::Success;
+}
+
+
+emb::TaskStatus selfPeriodTask(size_t id)
+{
+	schedulerTestOrder[schedulerTestOrderSize++] = id;
+	schedulerTestCancel.setPeriod(id, 20);
+	return emb::TaskStatus::Success;
+}
+
+
+emb::TaskStatus selfPeriodFailTask(size_t id)
+{
+	schedulerTestOrder[schedulerTestOrderSize++] = id;
+	schedulerTestCancel.setPeriod(id, 20);
+	return emb::TaskStatus::Fail;
+}
+
+
+emb::TaskStatus cancelOtherTask(size_t id)
+{
+	schedulerTestOrder[schedulerTestOrderSize++] = id;
+	schedulerTestCancel.cancel(schedulerTestCancelId);
+	return emb::TaskStatus::Success;
+}
+
+
+uint64_t monitorExecClock;
+uint64_t monitorExecTime() { return monitorExecClock; }
+
+
+/// Task execution time depends on task id: 3 * (id + 1) exec clock units.
+emb::TaskStatus monitorTestTask(size_t id)
+{
+	schedulerTestOrder[schedulerTestOrderSize++] = id;
+	monitorExecClock += 3 * (id + 1);
+	return emb::TaskStatus::Success;
+}
+
+
+emb::TaskStats monitorStats[8];
+
+
+} // namespace
+
+
+void EmbTest::SchedulerTest()
+{
+	// restart policy semantics match previous linear scan
+	runSchedulerScenario(true);
+	runSchedulerScenario(false);
+	normalizeSchedulerLog(schedulerLog[0], schedulerLogSize[0]);
+	normalizeSchedulerLog(schedulerLog[1], schedulerLogSize[1]);
+	EMB_ASSERT_TRUE(schedulerLogSize[0] > 100);
+	EMB_ASSERT_EQUAL(schedulerLogSize[0], schedulerLogSize[1]);
+	for (size_t i = 0; i < schedulerLogSize[0]; ++i)
+	{
+		EMB_ASSERT_EQUAL(schedulerLog[0][i].time, schedulerLog[1][i].time);
+		EMB_ASSERT_EQUAL(schedulerLog[0][i].id, schedulerLog[1][i].id);
+	}
+
+	// equal deadlines - registration order, different deadlines - deadline order
+	emb::Scheduler<8> scheduler;
+	schedulerTestOrderSize = 0;
+	size_t a = scheduler.addPeriodic(orderTestTask, 10, 0, emb::CatchUpPolicy::Restart);
+	size_t b = scheduler.addPeriodic(orderTestTask, 10, 0, emb::CatchUpPolicy::Restart);
+	size_t c = scheduler.addPeriodic(orderTestTask, 5, 0, emb::CatchUpPolicy::Restart);
+	EMB_ASSERT_EQUAL(scheduler.size(), 3);
+	EMB_ASSERT_TRUE(!scheduler.due(4));
+	EMB_ASSERT_EQUAL(scheduler.nextDeadline(), 5);
+	EMB_ASSERT_EQUAL(scheduler.run(4), 0);
+	EMB_ASSERT_EQUAL(scheduler.run(12), 3);
+	EMB_ASSERT_EQUAL(schedulerTestOrderSize, 3);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[0], c);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[1], a);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[2], b);
+
+	// late run with restart policy: next deadline is counted from actual run time
+	EMB_ASSERT_EQUAL(scheduler.deadline(a), 22);
+	EMB_ASSERT_EQUAL(scheduler.deadline(c), 17);
+
+	// period change is counted from last run
+	scheduler.setPeriod(a, 3);
+	EMB_ASSERT_EQUAL(scheduler.deadline(a), 15);
+	EMB_ASSERT_EQUAL(scheduler.nextDeadline(), 15);
+
+	// one-shot task
+	schedulerTestOrderSize = 0;
+	size_t d = scheduler.addOneShot(orderTestTask, 2, 12);
+	EMB_ASSERT_EQUAL(scheduler.run(14), 1);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[0], d);
+	EMB_ASSERT_TRUE(!scheduler.contains(d));
+	EMB_ASSERT_EQUAL(scheduler.size(), 3);
+
+	// cancel
+	EMB_ASSERT_TRUE(scheduler.cancel(a));
+	EMB_ASSERT_TRUE(!scheduler.cancel(a));
+	EMB_ASSERT_EQUAL(scheduler.size(), 2);
+	schedulerTestOrderSize = 0;
+	EMB_ASSERT_EQUAL(scheduler.run(100), 2);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[0], c);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[1], b);
+
+	// capacity
+	scheduler.clear();
+	for (size_t i = 0; i < scheduler.capacity(); ++i)
+	{
+		EMB_ASSERT_EQUAL(scheduler.addPeriodic(orderTestTask, i, 0), i);
+	}
+	EMB_ASSERT_EQUAL(scheduler.addPeriodic(orderTestTask, 1, 0), scheduler.invalidId);
+
+	// restart
+	scheduler.restart(50);
+	EMB_ASSERT_EQUAL(scheduler.nextDeadline(), 50);
+	EMB_ASSERT_EQUAL(scheduler.deadline(7), 57);
+
+	// zero period task is executed once per run() call
+	scheduler.clear();
+	schedulerTestOrderSize = 0;
+	scheduler.addPeriodic(orderTestTask, 0, 0);
+	EMB_ASSERT_EQUAL(scheduler.run(0), 1);
+	EMB_ASSERT_EQUAL(scheduler.run(0), 1);
+
+	// cancellation from inside task function
+	schedulerTestOrderSize = 0;
+	size_t self = schedulerTestCancel.addPeriodic(selfCancelTask, 1, 0);
+	size_t other = schedulerTestCancel.addPeriodic(cancelOtherTask, 1, 0);
+	schedulerTestCancelId = schedulerTestCancel.addPeriodic(orderTestTask, 1, 0);
+	EMB_ASSERT_EQUAL(schedulerTestCancel.run(1), 2);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[0], self);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[1], other);
+	EMB_ASSERT_EQUAL(schedulerTestCancel.size(), 1);
+	EMB_ASSERT_EQUAL(schedulerTestCancel.run(2), 1);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[2], other);
+	schedulerTestCancel.clear();
+
+	// period change from inside task function is counted from current release
+	size_t selfPeriod = schedulerTestCancel.addPeriodic(selfPeriodTask, 10, 0, emb::CatchUpPolicy::Skip);
+	EMB_ASSERT_EQUAL(schedulerTestCancel.run(10), 1);
+	EMB_ASSERT_EQUAL(schedulerTestCancel.deadline(selfPeriod), 30);
+	schedulerTestCancel.clear();
+
+	// failed run after period change is retried when new period from last release expires, as in linear scan
+	selfPeriod = schedulerTestCancel.addPeriodic(selfPeriodFailTask, 10, 0, emb::CatchUpPolicy::Restart);
+	EMB_ASSERT_EQUAL(schedulerTestCancel.run(10), 1);
+	EMB_ASSERT_EQUAL(schedulerTestCancel.deadline(selfPeriod), 20);
+	EMB_ASSERT_EQUAL(schedulerTestCancel.run(15), 0);
+	EMB_ASSERT_EQUAL(schedulerTestCancel.run(20), 1);
+	schedulerTestCancel.clear();
+}
+
+
+void EmbTest::DeadlineMonitorTest()
+{
+	// virtual clock: run() is called with explicit time
+	emb::Scheduler<8> scheduler;
+	scheduler.enableStats(monitorStats, monitorExecTime);
+	monitorExecClock = 0;
+	schedulerTestOrderSize = 0;
+
+	// drift-free scheduling: late start does not shift next release
+	size_t skip = scheduler.addPeriodic(monitorTestTask, 10, 0);
+	size_t restart = scheduler.addPeriodic(monitorTestTask, 10, 0, emb::CatchUpPolicy::Restart);
+	EMB_ASSERT_TRUE(scheduler.policy(skip) == emb::CatchUpPolicy::Skip);
+	EMB_ASSERT_EQUAL(scheduler.run(13), 2);
+	EMB_ASSERT_EQUAL(scheduler.deadline(skip), 20);
+	EMB_ASSERT_EQUAL(scheduler.deadline(restart), 23);
+	EMB_ASSERT_EQUAL(scheduler.run(21), 1);
+	EMB_ASSERT_EQUAL(scheduler.deadline(skip), 30);
+
+	// skip policy: missed releases are skipped, phase is kept
+	EMB_ASSERT_EQUAL(scheduler.run(55), 2);	// skip: released at 30, releases 40 and 50 are missed
+	EMB_ASSERT_EQUAL(scheduler.deadline(skip), 60);
+	EMB_ASSERT_EQUAL(scheduler.deadline(restart), 65);
+	EMB_ASSERT_EQUAL(scheduler.stats(skip).skipped, 2);
+	EMB_ASSERT_EQUAL(scheduler.stats(skip).overruns, 1);
+	EMB_ASSERT_EQUAL(scheduler.stats(restart).skipped, 0);
+	EMB_ASSERT_EQUAL(scheduler.stats(restart).overruns, 1);	// lateness 32
+
+	// statistics: lateness 3, 1, 25 (skip), 3, 32 (restart)
+	const emb::TaskStats& skipStats = scheduler.stats(skip);
+	EMB_ASSERT_EQUAL(skipStats.activations, 3);
+	EMB_ASSERT_EQUAL(skipStats.latenessMin, 1);
+	EMB_ASSERT_EQUAL(skipStats.latenessMax, 25);
+	EMB_ASSERT_EQUAL(skipStats.latenessTotal, 29);
+	EMB_ASSERT_EQUAL(skipStats.execMax, 3 * (skip + 1));
+	EMB_ASSERT_EQUAL(skipStats.execTotal, 3 * 3 * (skip + 1));
+	const emb::TaskStats& restartStats = scheduler.stats(restart);
+	EMB_ASSERT_EQUAL(restartStats.activations, 2);
+	EMB_ASSERT_EQUAL(restartStats.latenessMin, 3);
+	EMB_ASSERT_EQUAL(restartStats.latenessMax, 32);
+	EMB_ASSERT_EQUAL(restartStats.execMax, 3 * (restart + 1));
+
+	scheduler.resetStats();
+	EMB_ASSERT_EQUAL(scheduler.stats(skip).activations, 0);
+	EMB_ASSERT_EQUAL(scheduler.stats(skip).overruns, 0);
+
+	// catch-up policy: missed releases are executed one per run() call
+	scheduler.clear();
+	schedulerTestOrderSize = 0;
+	size_t catchUp = scheduler.addPeriodic(monitorTestTask, 10, 0, emb::CatchUpPolicy::CatchUp);
+	EMB_ASSERT_TRUE(scheduler.stats(catchUp).activations == 0);
+	EMB_ASSERT_EQUAL(scheduler.run(35), 1);	// released at 10
+	EMB_ASSERT_EQUAL(scheduler.run(35), 1);	// released at 20
+	EMB_ASSERT_EQUAL(scheduler.run(35), 1);	// released at 30
+	EMB_ASSERT_EQUAL(scheduler.run(35), 0);
+	EMB_ASSERT_EQUAL(scheduler.deadline(catchUp), 40);
+	EMB_ASSERT_EQUAL(scheduler.stats(catchUp).activations, 3);
+	EMB_ASSERT_EQUAL(scheduler.stats(catchUp).overruns, 2);
+	EMB_ASSERT_EQUAL(scheduler.stats(catchUp).latenessMax, 25);
+	EMB_ASSERT_EQUAL(scheduler.stats(catchUp).latenessMin, 5);
+	EMB_ASSERT_EQUAL(scheduler.stats(catchUp).skipped, 0);
+
+	// rate-monotonic order of tasks with equal release time
+	scheduler.clear();
+	schedulerTestOrderSize = 0;
+	size_t slow = scheduler.addPeriodic(monitorTestTask, 20, 0);
+	size_t fast = scheduler.addPeriodic(monitorTestTask, 10, 10);
+	EMB_ASSERT_EQUAL(scheduler.run(20), 2);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[0], fast);
+	EMB_ASSERT_EQUAL(schedulerTestOrder[1], slow);
+
+	// drift-free period change
+	scheduler.setPeriod(fast, 5);
+	EMB_ASSERT_EQUAL(scheduler.deadline(fast), 25);
+}
+
+
+
@@ -10,12 +10,22 @@
 #include "emb/emb_array.h"
 #include "emb/emb_queue.h"
 #include "emb/emb_circularbuffer.h"
+#include "emb/emb_ringbuffer.h"
+#include "emb/emb_crc.h"
+#include "emb/emb_cobs.h"
 #include "emb/emb_math.h"
 #include "emb/emb_filter.h"
 #include "emb/emb_stack.h"
 #include "emb/emb_bitset.h"
 #include "emb/emb_staticvector.h"
 #include "emb/emb_string.h"
+#include "emb/emb_extendedclock.h"
+#include "emb/emb_scheduler.h"
+#include "emb/emb_executor.h"
+#include "emb/emb_events/emb_events.h"
+#include "emb/emb_profiler/emb_probes.h"
+#include "emb/emb_trace/emb_trace.h"
+#include "emb/emb_cpuload/emb_cpuload.h"
 
 
 class EmbTest
@@ -27,11 +37,22 @@ public:
 	static void ArrayTest();
 	static void QueueTest();
 	static void CircularBufferTest();
+	static void RingBufferTest();
+	static void CrcTest();
+	static void CobsTest();
 	static void FilterTest();
 	static void StackTest();
 	static void BitsetTest();
 	static void StaticVectorTest();
 	static void StringTest();
+	static void ExtendedClockTest();
+	static void ProbeRegistryTest();
+	static void SchedulerTest();
+	static void DeadlineMonitorTest();
+	static void ExecutorTest();
+	static void EventsTest();
+	static void TraceTest();
+	static void CpuLoadTest();
 };
 
 
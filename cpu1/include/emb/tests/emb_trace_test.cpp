@@ -0,0 +1,72 @@
+///
+#include "emb_test.h"
+
+
+uint32_t traceTestTimestamp = 0;
+
+
+uint32_t traceTestTimestampFunc()
+{
+	return traceTestTimestamp++;
+}
+
+
+void EmbTest::TraceTest()
+{
+	using emb::trace::Recorder;
+	using emb::trace::EventType;
+	using emb::Probe;
+
+	Recorder::init(traceTestTimestampFunc);
+	EMB_ASSERT_EQUAL(Recorder::size(), 0);
+
+	Recorder::instant(Probe::Superloop);
+	EMB_ASSERT_EQUAL(Recorder::size(), 0);		// recording is disabled until start()
+
+	Recorder::start();
+	Recorder::begin(Probe::CliServer);
+	Recorder::end(Probe::CliServer);
+	Recorder::instant(Probe::CanIsr);
+	Recorder::stop();
+	Recorder::instant(Probe::CanIsr);
+
+	EMB_ASSERT_EQUAL(Recorder::size(), 3);
+	EMB_ASSERT_EQUAL(Recorder::overwritten(), 0);
+	EMB_ASSERT_EQUAL(Recorder::at(0).type(), EventType::Begin);
+	EMB_ASSERT_EQUAL(Recorder::at(0).probe(), Probe::CliServer);
+	EMB_ASSERT_EQUAL(Recorder::at(1).type(), EventType::End);
+	EMB_ASSERT_EQUAL(Recorder::at(1).probe(), Probe::CliServer);
+	EMB_ASSERT_EQUAL(Recorder::at(2).type(), EventType::Instant);
+	EMB_ASSERT_EQUAL(Recorder::at(2).probe(), Probe::CanIsr);
+	EMB_ASSERT_EQUAL(Recorder::at(1).timestamp - Recorder::at(0).timestamp, 1);
+	EMB_ASSERT_EQUAL(Recorder::at(2).timestamp - Recorder::at(0).timestamp, 2);
+
+	{
+		Recorder::start();
+		EMB_TRACE_SCOPE(SysLogIpc);
+		Recorder::stop();
+	}
+	EMB_ASSERT_EQUAL(Recorder::size(), 4);
+	EMB_ASSERT_EQUAL(Recorder::at(3).type(), EventType::Begin);
+	EMB_ASSERT_EQUAL(Recorder::at(3).probe(), Probe::SysLogIpc);
+
+	// wraparound: the oldest events are overwritten
+	Recorder::clear();
+	EMB_ASSERT_EQUAL(Recorder::size(), 0);
+	Recorder::start();
+	for (size_t i = 0; i < Recorder::capacity() + 5; ++i)
+	{
+		Recorder::record(EventType::Instant, static_cast<Probe::enum_type>(i % Probe::Count));
+	}
+	Recorder::stop();
+	EMB_ASSERT_EQUAL(Recorder::size(), Recorder::capacity());
+	EMB_ASSERT_EQUAL(Recorder::overwritten(), 5);
+	EMB_ASSERT_EQUAL(Recorder::at(0).probe(), 5 % Probe::Count);
+	EMB_ASSERT_EQUAL(Recorder::at(Recorder::capacity() - 1).probe(), (Recorder::capacity() + 4) % Probe::Count);
+	EMB_ASSERT_EQUAL(Recorder::at(Recorder::capacity() - 1).timestamp - Recorder::at(0).timestamp,
+			Recorder::capacity() - 1);
+
+	Recorder::clear();
+}
+
+
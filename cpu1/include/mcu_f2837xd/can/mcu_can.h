@@ -22,6 +22,8 @@
 #include "../system/mcu_system.h"
 #include "../gpio/mcu_gpio.h"
 #include "emb/emb_core.h"
+#include "emb/emb_trace/emb_trace.h"
+#include "emb/emb_cpuload/emb_cpuload.h"
 
 
 namespace mcu {
@@ -198,6 +200,16 @@ public:
 		CAN_sendMessage(_module.base, objId, dataLen, dataBuf);
 	}
 
+	/**
+	 * @brief Checks if frame of message object waits for bus.
+	 * @param objId - message object ID
+	 * @return \c true if transmission is requested and not completed, \c false otherwise.
+	 */
+	bool txPending(uint32_t objId) const
+	{
+		return ((CAN_getTxRequests(_module.base) >> (objId - 1)) & 1) != 0;
+	}
+
 	/**
 	 * @brief Setups message object.
 	 * @param msgObj - message object
@@ -271,12 +283,16 @@ protected:
 
 	static interrupt void onInterrupt()
 	{
+		EMB_CPULOAD_ENTER(CanIsr);
+		EMB_TRACE_BEGIN(CanIsr);
 		uint32_t interruptCause = CAN_getInterruptCause(Module<Instance>::instance()->base());
 		uint16_t status = CAN_getStatus(Module<Instance>::instance()->base());
 
 		_onInterruptCallback(Module<Instance>::instance(), interruptCause, status);
 
 		Module<Instance>::instance()->acknowledgeInterrupt(interruptCause);
+		EMB_TRACE_END(CanIsr);
+		EMB_CPULOAD_EXIT(CanIsr);
 	}
 };
 
@@ -12,6 +12,9 @@
 
 
 #include "mcu_chrono.h"
+#include "emb/emb_trace/emb_trace.h"
+#include "emb/emb_cpuload/emb_cpuload.h"
+#include "emb/emb_events/emb_events.h"
 
 
 namespace mcu {
@@ -22,7 +25,9 @@ namespace chrono {
 
 volatile uint64_t SystemClock::_time;
 
-emb::StaticVector<SystemClock::Task, SystemClock::_taskCountMax> SystemClock::_tasks;
+emb::Scheduler<SystemClock::_taskCountMax> SystemClock::_scheduler;
+emb::TaskStats SystemClock::_taskStats[SystemClock::_taskCountMax];
+const char* SystemClock::_taskNames[SystemClock::_taskCountMax];
 
 bool SystemClock::_watchdogEnabled;
 uint64_t SystemClock::_watchdogTimer;
@@ -30,8 +35,7 @@ uint64_t SystemClock::_watchdogBound;
 bool SystemClock::_watchdogTimeoutDetected;
 TaskStatus (*SystemClock::_watchdogTask)();
 
-uint64_t SystemClock::_delayedTaskStart;
-uint64_t SystemClock::_delayedTaskDelay;
+size_t SystemClock::_delayedTaskIndex = SystemClock::invalidTask;
 void (*SystemClock::_delayedTask)();
 
 
@@ -49,9 +53,6 @@ void SystemClock::init()
 	_watchdogBound = 0;
 	_watchdogTimeoutDetected = false;
 
-	_delayedTaskStart = 0;
-	_delayedTaskDelay = 0;
-
 	Interrupt_register(INT_TIMER0, SystemClock::onInterrupt);
 
 	CPUTimer_stopTimer(CPUTIMER0_BASE);		// Make sure timer is stopped
@@ -64,7 +65,6 @@ void SystemClock::init()
 	CPUTimer_setEmulationMode(CPUTIMER0_BASE, CPUTIMER_EMULATIONMODE_STOPAFTERNEXTDECREMENT);
 
 	_watchdogTask = empty_task;
-	_delayedTask = empty_delayed_task;
 
 	CPUTimer_enableInterrupt(CPUTIMER0_BASE);
 	Interrupt_enable(INT_TIMER0);
@@ -74,40 +74,15 @@ void SystemClock::init()
 }
 
 
-///
-///
-///
-void SystemClock::runTasks()
-{
-	for (size_t i = 0; i < _tasks.size(); ++i)
-	{
-		if (now() >= (_tasks[i].timepoint + _tasks[i].period))
-		{
-			if (_tasks[i].func(i) == TaskStatus::Success)
-			{
-				_tasks[i].timepoint = now();
-			}
-		}
-
-	}
-
-	if (_delayedTaskDelay != 0)
-	{
-		if (now() >= (_delayedTaskStart + _delayedTaskDelay))
-		{
-			_delayedTask();
-			_delayedTaskDelay = 0;
-		}
-	}
-}
-
-
 ///
 ///
 ///
 __interrupt void SystemClock::onInterrupt()
 {
+	EMB_CPULOAD_ENTER(SystemClockIsr);
+	EMB_TRACE_BEGIN(SystemClockIsr);
 	_time += _timeStep;
+	emb::PendingEvents::set(emb::Event::ClockTick);
 
 	if (_watchdogEnabled == true)
 	{
@@ -123,6 +98,8 @@ __interrupt void SystemClock::onInterrupt()
 	}
 
 	Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP1);
+	EMB_TRACE_END(SystemClockIsr);
+	EMB_CPULOAD_EXIT(SystemClockIsr);
 }
 
 
@@ -130,6 +107,8 @@ __interrupt void SystemClock::onInterrupt()
 
 
 uint32_t HighResolutionClock::_period;
+void (*HighResolutionClock::_interruptHandler)() = HighResolutionClock::empty_handler;
+bool HighResolutionClock::_extendedTicks = false;
 
 
 ///
@@ -147,11 +126,46 @@ void HighResolutionClock::init(uint32_t period_us)
 	_period = (uint32_t)(mcu::sysclkFreq() / 1000000) * period_us - 1;
 	CPUTimer_setPeriod(CPUTIMER1_BASE, _period);
 	CPUTimer_setEmulationMode(CPUTIMER1_BASE, CPUTIMER_EMULATIONMODE_STOPAFTERNEXTDECREMENT);
+	CPUTimer_reloadTimerCounter(CPUTIMER1_BASE);
+	CPUTimer_clearOverflowFlag(CPUTIMER1_BASE);
+	ExtendedClock::reset();
 
 	_set_initialized();
 }
 
 
+///
+///
+///
+void HighResolutionClock::enableExtendedTicks()
+{
+	_extendedTicks = true;
+	_enableInterrupt();
+}
+
+
+///
+///
+///
+void HighResolutionClock::_enableInterrupt()
+{
+	Interrupt_register(INT_TIMER1, HighResolutionClock::onInterrupt);
+	CPUTimer_enableInterrupt(CPUTIMER1_BASE);
+	Interrupt_enable(INT_TIMER1);
+}
+
+
+///
+///
+///
+__interrupt void HighResolutionClock::onInterrupt()
+{
+	CPUTimer_clearOverflowFlag(CPUTIMER1_BASE);
+	ExtendedClock::onReload();
+	_interruptHandler();
+}
+
+
 } // namespace chrono
 
 
@@ -21,7 +21,8 @@
 #include "device.h"
 #include "../system/mcu_system.h"
 #include "emb/emb_core.h"
-#include "emb/emb_staticvector.h"
+#include "emb/emb_scheduler.h"
+#include "emb/emb_extendedclock.h"
 
 
 namespace mcu {
@@ -33,12 +34,7 @@ namespace chrono {
 
 
 /// Clock task statuses
-SCOPED_ENUM_DECLARE_BEGIN(TaskStatus)
-{
-	Success = 0,
-	Fail = 1
-}
-SCOPED_ENUM_DECLARE_END(TaskStatus)
+typedef emb::TaskStatus TaskStatus;
 
 
 /**
@@ -49,31 +45,63 @@ class SystemClock : public emb::monostate<SystemClock>
 private:
 	static volatile uint64_t _time;
 	static const uint32_t _timeStep = 1;
-	static const size_t _taskCountMax = 4;
+	static const size_t _taskCountMax = 32;
 
 /* ========================================================================== */
 /* = Periodic Tasks = */
 /* ========================================================================== */
 private:
-	struct Task
-	{
-		uint64_t period;
-		uint64_t timepoint;
-		TaskStatus (*func)(size_t);
-	};
 	static TaskStatus empty_task() { return TaskStatus::Success; }
-	static emb::StaticVector<Task, _taskCountMax> _tasks;
+	static emb::Scheduler<_taskCountMax> _scheduler;
+	static emb::TaskStats _taskStats[_taskCountMax];
+	static const char* _taskNames[_taskCountMax];
 public:
+	/// Invalid task index, returned if task can't be registered.
+	static const size_t invalidTask = _taskCountMax;
+
 	/**
 	 * @brief Registers periodic task.
 	 * @param task - pointer to task function
 	 * @param period - task period
+	 * @param name - task name shown by CLI
+	 * @param policy - catch-up policy
+	 * @return Task index.
+	 */
+	static size_t registerTask(TaskStatus (*func)(size_t), uint64_t period, const char* name = "task",
+			emb::CatchUpPolicy policy = emb::CatchUpPolicy::Skip)
+	{
+		size_t index = _scheduler.addPeriodic(func, period, now(), policy);
+		if (index != invalidTask)
+		{
+			_taskNames[index] = name;
+		}
+		return index;
+	}
+
+	/**
+	 * @brief Registers one-shot task.
+	 * @param task - pointer to task function
+	 * @param delay - task delay in milliseconds
+	 * @return Task index.
+	 */
+	static size_t registerOneShotTask(TaskStatus (*func)(size_t), uint64_t delay, const char* name = "oneshot")
+	{
+		size_t index = _scheduler.addOneShot(func, delay, now());
+		if (index != invalidTask)
+		{
+			_taskNames[index] = name;
+		}
+		return index;
+	}
+
+	/**
+	 * @brief Cancels task. Task can be cancelled from inside task function.
+	 * @param index - task index
 	 * @return (none)
 	 */
-	static void registerTask(TaskStatus (*func)(size_t), uint64_t period)
+	static void cancelTask(size_t index)
 	{
-		Task task = {period, now(), func};
-		_tasks.push_back(task);
+		_scheduler.cancel(index);
 	}
 
 	/**
@@ -84,12 +112,28 @@ public:
 	 */
 	static void setTaskPeriod(size_t index, uint64_t period)
 	{
-		if (index < _tasks.size())
-		{
-			_tasks[index].period = period;
-		}
+		_scheduler.setPeriod(index, period);
+	}
+
+	/**
+	 * @brief Enables task statistics: lateness, execution time and overruns.
+	 * @param execTimeFunc - execution time source, e.g. HighResolutionClock::ticks
+	 * @return (none)
+	 */
+	static void enableTaskStats(uint64_t (*execTimeFunc)())
+	{
+		_scheduler.enableStats(_taskStats, execTimeFunc);
 	}
 
+	static void resetTaskStats() { _scheduler.resetStats(); }
+	static size_t taskCountMax() { return _taskCountMax; }
+	static bool taskRegistered(size_t index) { return _scheduler.contains(index); }
+	static const char* taskName(size_t index) { return _taskNames[index]; }
+	static uint64_t taskPeriod(size_t index) { return _scheduler.period(index); }
+	static emb::CatchUpPolicy taskPolicy(size_t index) { return _scheduler.policy(index); }
+	static const emb::TaskStats& taskStats(size_t index) { return _scheduler.stats(index); }
+	static bool taskStatsEnabled() { return _scheduler.statsEnabled(); }
+
 /* ========================================================================== */
 /* = Watchdog = */
 /* ========================================================================== */
@@ -176,21 +220,28 @@ public:
 /* = Delayed Task = */
 /* ========================================================================== */
 private:
-	static uint64_t _delayedTaskStart;
-	static uint64_t _delayedTaskDelay;
+	static size_t _delayedTaskIndex;
 	static void (*_delayedTask)();
-	static void empty_delayed_task() {}
+	static TaskStatus runDelayedTask(size_t taskIndex)
+	{
+		_delayedTaskIndex = invalidTask;
+		_delayedTask();
+		return TaskStatus::Success;
+	}
 public:
 	/**
-	 * @brief Registers delayed task.
+	 * @brief Registers delayed task. Previously registered delayed task is cancelled if not executed yet.
 	 * @param task - pointer to delayed task function
 	 * @return (none)
 	 */
 	static void registerDelayedTask(void (*task)(), uint64_t delay)
 	{
+		if (_delayedTaskIndex != invalidTask)
+		{
+			_scheduler.cancel(_delayedTaskIndex);
+		}
 		_delayedTask = task;
-		_delayedTaskDelay = delay;
-		_delayedTaskStart = now();
+		_delayedTaskIndex = registerOneShotTask(runDelayedTask, delay, "delayed");
 	}
 
 private:
@@ -233,18 +284,22 @@ public:
 	static void reset()
 	{
 		_time = 0;
-		for (size_t i = 0; i < _tasks.size(); ++i)
-		{
-			_tasks[i].timepoint = now();
-		}
+		_scheduler.restart(now());
 	}
 
 	/**
-	 * @brief Checks and runs periodic and delayed tasks.
+	 * @brief Runs due periodic, one-shot and delayed tasks. Due check is O(1).
 	 * @param (none)
 	 * @return (none)
 	 */
-	static void runTasks();
+	static void runTasks()
+	{
+		uint64_t timeNow = now();
+		if (_scheduler.due(timeNow))
+		{
+			_scheduler.run(timeNow);
+		}
+	}
 
 protected:
 	/**
@@ -259,20 +314,33 @@ protected:
 /*####################################################################################################################*/
 /**
  * @brief High resolution clock class. Based on CPU-Timer1.
+ * Timer counter can be extended to monotonic 64-bit tick count in timer reload ISR, see enableExtendedTicks().
  */
 class HighResolutionClock : public emb::monostate<HighResolutionClock>
 {
 private:
 	static uint32_t _period;
 	static const uint32_t deviceSysclkPeriod_ns = 1000000000 / DEVICE_SYSCLK_FREQ;
+	static void (*_interruptHandler)();
+	static void empty_handler() {}
+	static bool _extendedTicks;
+	typedef emb::ExtendedClock<HighResolutionClock> ExtendedClock;
 public:
 	/**
 	 * @brief Initializes systick timer.
-	 * @param (none)
+	 * @param period_us - timer period in microseconds
 	 * @return (none)
 	 */
 	static void init(uint32_t period_us);
 
+	/**
+	 * @brief Enables timer reload interrupt that extends timer counter to monotonic 64-bit tick count.
+	 * Should be called after init() before timer is started. Interrupt is taken once per timer period.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void enableExtendedTicks();
+
 	/**
 	 * @brief Returns systick timer counter value.
 	 * @param (none)
@@ -283,14 +351,48 @@ public:
 		return CPUTimer_getTimerCount(CPUTIMER1_BASE);
 	}
 
+	/**
+	 * @brief Returns systick timer period.
+	 * @param (none)
+	 * @return Systick timer period in clock cycles (counter reload value).
+	 */
+	static uint32_t period()
+	{
+		return _period;
+	}
+
+	/**
+	 * @brief Checks if timer reload has occurred and has not been serviced yet.
+	 * @param (none)
+	 * @return \c true if reload is pending, \c false otherwise.
+	 */
+	static bool reloadPending()
+	{
+		return CPUTimer_getTimerOverflowStatus(CPUTIMER1_BASE);
+	}
+
+	/**
+	 * @brief Returns tick count: monotonic if extended ticks are enabled, otherwise it wraps on timer reload.
+	 * @param (none)
+	 * @return Number of clock cycles since init (since last timer reload if extended ticks are not enabled).
+	 */
+	static uint64_t ticks()
+	{
+		if (!_extendedTicks)
+		{
+			return _period - counter();
+		}
+		return ExtendedClock::ticks();
+	}
+
 	/**
 	 * @brief Returns a time point representing the current point in time.
 	 * @param (none)
-	 * @return A time point representing the current time in ns.
+	 * @return A time point representing the current time in ns, monotonic if extended ticks are enabled.
 	 */
 	static uint64_t now()
 	{
-		return static_cast<uint64_t>(_period - counter()) * deviceSysclkPeriod_ns;
+		return ticks() * deviceSysclkPeriod_ns;
 	}
 
 	/**
@@ -304,28 +406,33 @@ public:
 	}
 
 	/**
-	 * @brief Stops systick timer.
+	 * @brief Stops systick timer. Counter is reloaded on restart,
+	 * so current period is counted as completed to keep time monotonic.
 	 * @param (none)
 	 * @return (none)
 	 */
 	static void stop()
 	{
+		uint16_t intStatus = __disable_interrupts();
 		CPUTimer_stopTimer(CPUTIMER1_BASE);
+		ExtendedClock::onReload();
+		__restore_interrupts(intStatus);
 	}
 
 	/**
-	 * @brief Registers systick timer interrupt handler.
+	 * @brief Registers systick timer interrupt handler and enables timer reload interrupt.
+	 * Handler is called from timer reload ISR.
 	 * @param handler - pointer to handler
 	 * @return (none)
 	 */
 	static void registerInterruptHandler(void (*handler)(void))
 	{
-		Interrupt_register(INT_TIMER1, handler);
-		CPUTimer_enableInterrupt(CPUTIMER1_BASE);
-		Interrupt_enable(INT_TIMER1);
+		_interruptHandler = handler;
+		_enableInterrupt();
 	}
 
 private:
+	static void _enableInterrupt();
 	static __interrupt void onInterrupt();
 };
 
@@ -228,7 +228,7 @@ public:
 		}
 
 #ifdef CPU1
-		initPins(config);
+		_initPins(config);
 #else
 		EMB_UNUSED(impl::pwmPinOutAConfigs);
 		EMB_UNUSED(impl::pwmPinOutBConfigs);
@@ -366,7 +366,7 @@ public:
 			/* ========================================================================== */
 			// CMPA actions
 				// PWMxA configuration for typical waveforms
-			switch (config.operatingMode.native_value())
+			switch (config.counterMode.native_value())
 			{
 			case CounterMode::Up:
 				EPWM_setActionQualifierAction(_module.base[i],	EPWM_AQ_OUTPUT_A,
@@ -492,10 +492,10 @@ public:
 
 		switch (pin.config().activeState)
 		{
-		case emb::ActiveLow:
+		case emb::gpio::ActiveState::Low:
 			GPIO_setPadConfig(pin.config().no, GPIO_PIN_TYPE_PULLUP);
 			break;
-		case emb::ActiveHigh:
+		case emb::gpio::ActiveState::High:
 			GPIO_setPadConfig(pin.config().no, GPIO_PIN_TYPE_INVERT);
 			break;
 		}
@@ -523,7 +523,7 @@ public:
 			break;
 		}
 
-		for (size_t i = 0; i < PhaseCount; ++i)
+		for (size_t i = 0; i < Phases; ++i)
 		{
 			// Enable tzSignal as one shot trip source
 			EPWM_enableTripZoneSignals(_module.base[i], tzSignal);
@@ -541,13 +541,13 @@ public:
 	{
 		SysCtl_disablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);	// Disable sync(Freeze clock to PWM as well)
 
-		for (size_t i = 0; i < PhaseCount; ++i)
+		for (size_t i = 0; i < Phases; ++i)
 		{
 			GPIO_setMasterCore(_module.instance[i] * 2, GPIO_CORE_CPU2);
 			GPIO_setMasterCore(_module.instance[i] * 2 + 1, GPIO_CORE_CPU2);
 		}
 
-		for (size_t i = 0; i < PhaseCount; ++i)
+		for (size_t i = 0; i < Phases; ++i)
 		{
 			SysCtl_selectCPUForPeripheral(SYSCTL_CPUSEL0_EPWM,
 					static_cast<uint16_t>(_module.instance[i])+1, SYSCTL_CPUSEL_CPU2);
@@ -588,16 +588,16 @@ public:
 		_switchingFreq = freq;
 		switch (_counterMode)
 		{
-		case PWM_COUNTER_MODE_UP:
-		case PWM_COUNTER_MODE_DOWN:
+		case CounterMode::Up:
+		case CounterMode::Down:
 			_period = (_timebaseClkFreq / _switchingFreq) - 1;
 			break;
-		case PWM_COUNTER_MODE_UP_DOWN:
+		case CounterMode::UpDown:
 			_period = (_timebaseClkFreq / _switchingFreq) / 2;
 			break;
 		}
 
-		for (size_t i = 0; i < PhaseCount; ++i)
+		for (size_t i = 0; i < Phases; ++i)
 		{
 			EPWM_setTimeBasePeriod(_module.base[i], _period);
 		}
@@ -610,7 +610,7 @@ public:
 	 */
 	void setCompareValues(const uint16_t cmpValues[])
 	{
-		for (size_t i = 0; i < PhaseCount; ++i)
+		for (size_t i = 0; i < Phases; ++i)
 		{
 			EPWM_setCounterCompareValue(_module.base[i],
 			                            EPWM_COUNTER_COMPARE_A,
@@ -623,7 +623,7 @@ public:
 	 */
 	void setCompareValues(const emb::Array<uint16_t, Phases>& cmpValues)
 	{
-		for (size_t i = 0; i < PhaseCount; ++i)
+		for (size_t i = 0; i < Phases; ++i)
 		{
 			EPWM_setCounterCompareValue(_module.base[i],
 			                            EPWM_COUNTER_COMPARE_A,
@@ -638,7 +638,7 @@ public:
 	 */
 	void setCompareValue(uint16_t cmpValue)
 	{
-		for (size_t i = 0; i < PhaseCount; ++i)
+		for (size_t i = 0; i < Phases; ++i)
 		{
 			EPWM_setCounterCompareValue(_module.base[i],
 			                            EPWM_COUNTER_COMPARE_A,
@@ -653,7 +653,7 @@ public:
 	 */
 	void setDutyCycles(const emb::Array<float, Phases>& dutyCycles)
 	{
-		for (size_t i = 0; i < PhaseCount; ++i)
+		for (size_t i = 0; i < Phases; ++i)
 		{
 			EPWM_setCounterCompareValue(_module.base[i],
 			                            EPWM_COUNTER_COMPARE_A,
@@ -668,7 +668,7 @@ public:
 	 */
 	void setDutyCycle(float dutyCycle)
 	{
-		for (size_t i = 0; i < PhaseCount; ++i)
+		for (size_t i = 0; i < Phases; ++i)
 		{
 			EPWM_setCounterCompareValue(_module.base[i],
 			                            EPWM_COUNTER_COMPARE_A,
@@ -22,6 +22,7 @@ namespace sci {
 
 const uint32_t impl::sciBases[4] = {SCIA_BASE, SCIB_BASE, SCIC_BASE, SCID_BASE};
 const uint32_t impl::sciRxPieIntNums[4] = {INT_SCIA_RX, INT_SCIB_RX, INT_SCIC_RX, INT_SCID_RX};
+const uint32_t impl::sciTxPieIntNums[4] = {INT_SCIA_TX, INT_SCIB_TX, INT_SCIC_TX, INT_SCID_TX};
 const uint16_t impl::sciPieIntGroups[4] = {INTERRUPT_ACK_GROUP9, INTERRUPT_ACK_GROUP9,
 						INTERRUPT_ACK_GROUP8, INTERRUPT_ACK_GROUP8};
 
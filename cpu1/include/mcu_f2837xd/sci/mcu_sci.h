@@ -22,6 +22,7 @@
 #include "../gpio/mcu_gpio.h"
 #include "emb/emb_core.h"
 #include "emb/emb_interfaces/emb_uart.h"
+#include "emb/emb_ringbuffer.h"
 
 
 namespace mcu {
@@ -119,14 +120,16 @@ struct Module
 {
 	uint32_t base;
 	uint32_t pieRxIntNum;
+	uint32_t pieTxIntNum;
 	uint16_t pieIntGroup;
-	Module(uint32_t base_, uint32_t pieRxIntNum_, uint16_t pieIntGroup_)
-		: base(base_), pieRxIntNum(pieRxIntNum_), pieIntGroup(pieIntGroup_) {}
+	Module(uint32_t base_, uint32_t pieRxIntNum_, uint32_t pieTxIntNum_, uint16_t pieIntGroup_)
+		: base(base_), pieRxIntNum(pieRxIntNum_), pieTxIntNum(pieTxIntNum_), pieIntGroup(pieIntGroup_) {}
 };
 
 
 extern const uint32_t sciBases[4];
 extern const uint32_t sciRxPieIntNums[4];
+extern const uint32_t sciTxPieIntNums[4];
 extern const uint16_t sciPieIntGroups[4];
 
 
@@ -134,13 +137,27 @@ extern const uint16_t sciPieIntGroups[4];
 
 
 /**
- * @brief SCI unit class.
+ * @brief SCI unit class. Polled mode is used by default: IUart methods access SCI FIFOs directly.
+ * In interrupt-driven mode (see enableInterruptDrivenMode()) IUart methods access RX and TX ring buffers,
+ * which are filled and drained by SCI FIFO-level ISRs.
  */
 template <Peripheral::enum_type Instance>
 class Module : public emb::c28x::interrupt_invoker<Module<Instance> >, public emb::IUart, private emb::noncopyable
 {
+public:
+	static const size_t rxRingSize = 64;
+	static const size_t txRingSize = 256;
 private:
 	impl::Module _module;
+
+	bool _interruptDriven;
+	emb::RingBuffer<char, rxRingSize> _rxRing;
+	emb::RingBuffer<char, txRingSize> _txRing;
+	void (*_rxHandler)(void);
+	volatile bool _rxHandlerEnabled;
+	volatile bool _rxRingOverrun;
+	volatile uint32_t _rxRingOverruns;	// chars lost because RX ring is full
+	volatile uint32_t _rxFifoOverruns;	// RX FIFO overflows: ISR was not served in time
 public:
 	/**
 	 * @brief Initializes MCU SCI module.
@@ -153,7 +170,14 @@ public:
 		: emb::c28x::interrupt_invoker<Module<Instance> >(this)
 		, _module(impl::sciBases[Instance],
 				impl::sciRxPieIntNums[Instance],
+				impl::sciTxPieIntNums[Instance],
 				impl::sciPieIntGroups[Instance])
+		, _interruptDriven(false)
+		, _rxHandler(NULL)
+		, _rxHandlerEnabled(false)
+		, _rxRingOverrun(false)
+		, _rxRingOverruns(0)
+		, _rxFifoOverruns(0)
 	{
 #ifdef CPU1
 		_initPins(rxPin, txPin);
@@ -217,6 +241,7 @@ public:
 	 */
 	virtual void reset()
 	{
+		_rxRingOverrun = false;
 		SCI_performSoftwareReset(_module.base);
 	}
 
@@ -227,6 +252,10 @@ public:
 	 */
 	virtual bool hasRxError() const
 	{
+		if (_interruptDriven && _rxRingOverrun)
+		{
+			return true;
+		}
 		return SCI_getRxStatus(_module.base) & SCI_RXSTATUS_ERROR;
 	}
 
@@ -237,6 +266,10 @@ public:
 	 */
 	virtual int recv(char& ch)
 	{
+		if (_interruptDriven)
+		{
+			return _rxRing.pop(ch) ? 1 : 0;
+		}
 		if (SCI_getRxFIFOStatus(_module.base) != SCI_FIFO_RX0)
 		{
 			ch = SCI_readCharNonBlocking(_module.base);
@@ -275,6 +308,12 @@ public:
 	 */
 	virtual int send(char ch)
 	{
+		if (_interruptDriven)
+		{
+			if (!_txRing.push(ch)) return 0;
+			SCI_enableInterrupt(_module.base, SCI_INT_TXFF);
+			return 1;
+		}
 		if (SCI_getTxFIFOStatus(_module.base) != SCI_FIFO_TX15)
 		{
 			SCI_writeCharBlockingFIFO(_module.base, ch);
@@ -291,10 +330,57 @@ public:
 	 */
 	virtual int send(const char* buf, uint16_t len)
 	{
+		if (_interruptDriven)
+		{
+			// may be called with interrupts disabled (e.g. during boot), so TX ring is flushed here, not by TX ISR;
+			// TX ISR is disabled in PIE to keep this the only consumer of TX ring
+			Interrupt_disable(_module.pieTxIntNum);
+			char ch;
+			while (_txRing.pop(ch))
+			{
+				SCI_writeCharBlockingFIFO(_module.base, ch);
+			}
+			SCI_writeCharArray(_module.base, reinterpret_cast<const uint16_t*>(buf), len);
+			Interrupt_enable(_module.pieTxIntNum);
+			return len;
+		}
 		SCI_writeCharArray(_module.base, reinterpret_cast<const uint16_t*>(buf), len);
 		return len;
 	}
 
+	/**
+	 * @brief Sends chars from buffer in non-blocking mode: as many chars as TX FIFO has free slots.
+	 * @param buf - pointer to buffer to be send
+	 * @param len - length of buffer
+	 * @return Number of sent characters.
+	 */
+	virtual int sendNonBlocking(const char* buf, uint16_t len)
+	{
+		if (_interruptDriven)
+		{
+			uint16_t i = 0;
+			while ((i < len) && _txRing.push(buf[i]))
+			{
+				++i;
+			}
+			if (i != 0)
+			{
+				SCI_enableInterrupt(_module.base, SCI_INT_TXFF);
+			}
+			return i;
+		}
+		uint16_t count = SCI_FIFO_TX16 - SCI_getTxFIFOStatus(_module.base);
+		if (count > len)
+		{
+			count = len;
+		}
+		for (uint16_t i = 0; i < count; ++i)
+		{
+			SCI_writeCharNonBlocking(_module.base, buf[i]);
+		}
+		return count;
+	}
+
 	/**
 	 * @brief Registers Rx-interrupt handler.
 	 * @param handler - pointer to interrupt handler
@@ -302,6 +388,11 @@ public:
 	 */
 	virtual void registerRxInterruptHandler(void (*handler)(void))
 	{
+		if (_interruptDriven)
+		{
+			_rxHandler = handler;
+			return;
+		}
 		SCI_disableModule(_module.base);
 		Interrupt_register(_module.pieRxIntNum, handler);
 		SCI_enableInterrupt(_module.base, SCI_INT_RXFF);
@@ -309,37 +400,142 @@ public:
 	}
 
 	/**
-	 * @brief Enables Rx-interrupts.
+	 * @brief Enables Rx-interrupts. In interrupt-driven mode enables RX notification handler,
+	 * handler is called immediately if RX ring is not empty.
 	 * @param (none)
 	 * @return (none)
 	 */
 	virtual void enableRxInterrupts()
 	{
+		if (_interruptDriven)
+		{
+			_rxHandlerEnabled = true;
+			if (!_rxRing.empty() && (_rxHandler != NULL))
+			{
+				uint16_t intStatus = __disable_interrupts();
+				if (_rxHandlerEnabled)	// handler may be called and disabled by ISR
+				{
+					_rxHandler();
+				}
+				__restore_interrupts(intStatus);
+			}
+			return;
+		}
 		Interrupt_enable(_module.pieRxIntNum);
 	}
 
 	/**
-	 * @brief Disables Rx-interrupts.
+	 * @brief Disables Rx-interrupts. In interrupt-driven mode disables RX notification handler only,
+	 * RX ring is still filled by ISR.
 	 * @param (none)
 	 * @return (none)
 	 */
 	virtual void disableRxInterrupts()
 	{
+		if (_interruptDriven)
+		{
+			_rxHandlerEnabled = false;
+			return;
+		}
 		Interrupt_disable(_module.pieRxIntNum);
 	}
 
 	/**
-	 * @brief Acknowledges interrupt.
+	 * @brief Acknowledges interrupt. In interrupt-driven mode interrupt is acknowledged by ISR.
 	 * @param (none)
 	 * @return (none)
 	 */
 	virtual void acknowledgeRxInterrupt()
 	{
-		SCI_clearInterruptStatus(_module.base, SPI_INT_RXFF);
+		if (_interruptDriven) return;
+		SCI_clearInterruptStatus(_module.base, SCI_INT_RXFF);
 		Interrupt_clearACKGroup(_module.pieIntGroup);
 	}
 
+	/**
+	 * @brief Switches module to interrupt-driven mode: RX FIFO is drained to RX ring by RXFF ISR,
+	 * TX ring is drained to TX FIFO by TXFF ISR. Handler passed to registerRxInterruptHandler() becomes
+	 * RX notification handler, which is called by RX ISR with interrupts disabled and must not be
+	 * declared as __interrupt.
+	 * @param (none)
+	 * @return (none)
+	 */
+	void enableInterruptDrivenMode()
+	{
+		SCI_disableModule(_module.base);
+		_interruptDriven = true;
+		SCI_setFIFOInterruptLevel(_module.base, SCI_FIFO_TX8, SCI_FIFO_RX1);	// RX ISR drains FIFO on every char
+		Interrupt_register(_module.pieRxIntNum, _onRxInterrupt);
+		Interrupt_register(_module.pieTxIntNum, _onTxInterrupt);
+		SCI_clearOverflowStatus(_module.base);
+		SCI_clearInterruptStatus(_module.base, SCI_INT_TXFF | SCI_INT_RXFF);
+		SCI_enableInterrupt(_module.base, SCI_INT_RXFF);
+		SCI_enableModule(_module.base);
+		Interrupt_enable(_module.pieRxIntNum);
+		Interrupt_enable(_module.pieTxIntNum);
+	}
+
+	bool interruptDriven() const { return _interruptDriven; }
+	uint32_t rxRingOverruns() const { return _rxRingOverruns; }
+	uint32_t rxFifoOverruns() const { return _rxFifoOverruns; }
+	size_t txPending() const { return _txRing.size(); }
+
+	/**
+	 * @brief Clears RX overrun flag (counters are not reset).
+	 * @param (none)
+	 * @return (none)
+	 */
+	void clearRxError()
+	{
+		_rxRingOverrun = false;
+	}
+
 protected:
+	static __interrupt void _onRxInterrupt()
+	{
+		Module* self = Module::instance();
+		uint32_t base = self->_module.base;
+		while (SCI_getRxFIFOStatus(base) != SCI_FIFO_RX0)
+		{
+			char ch = SCI_readCharNonBlocking(base);
+			if (!self->_rxRing.push(ch))
+			{
+				++self->_rxRingOverruns;
+				self->_rxRingOverrun = true;
+			}
+		}
+		if (SCI_getOverflowStatus(base))
+		{
+			++self->_rxFifoOverruns;
+			SCI_clearOverflowStatus(base);
+		}
+		SCI_clearInterruptStatus(base, SCI_INT_RXFF);
+		Interrupt_clearACKGroup(self->_module.pieIntGroup);
+
+		if (self->_rxHandlerEnabled && (self->_rxHandler != NULL))
+		{
+			self->_rxHandler();
+		}
+	}
+
+	static __interrupt void _onTxInterrupt()
+	{
+		Module* self = Module::instance();
+		uint32_t base = self->_module.base;
+		uint16_t count = SCI_FIFO_TX16 - SCI_getTxFIFOStatus(base);
+		char ch;
+		while ((count-- != 0) && self->_txRing.pop(ch))
+		{
+			SCI_writeCharNonBlocking(base, ch);
+		}
+		if (self->_txRing.empty())
+		{
+			SCI_disableInterrupt(base, SCI_INT_TXFF);	// enabled again by send
+		}
+		SCI_clearInterruptStatus(base, SCI_INT_TXFF);
+		Interrupt_clearACKGroup(self->_module.pieIntGroup);
+	}
+
 	static void _initPins(const gpio::Config& rxPin, const gpio::Config& txPin)
 	{
 		GPIO_setPinConfig(rxPin.mux);
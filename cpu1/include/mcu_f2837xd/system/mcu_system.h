@@ -131,6 +131,20 @@ inline void enableDebugEvents() { ERTM; }
 inline void disableDebugEvents() { DRTM; }
 
 
+/**
+ * @brief Body of idle wait loop. Does nothing on target,
+ * host simulation fast-forwards virtual time to the next peripheral event.
+ * @param (none)
+ * @return (none)
+ */
+inline void idle()
+{
+#ifdef HOST_SIMULATION
+	sim::VirtualTime::advanceToNextEvent();
+#endif
+}
+
+
 /**
  * @brief Resets device.
  * @return (none)
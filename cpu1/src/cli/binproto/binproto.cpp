@@ -0,0 +1,465 @@
+/**
+ * @file binproto.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "binproto.h"
+#include "cli/cli_server.h"
+
+
+namespace cli {
+
+
+uint64_t (*BinaryProtocol::_now)() = NULL;
+
+unsigned char BinaryProtocol::_rxFrame[BinaryProtocol::ENCODED_FRAME_MAX_LENGTH];
+size_t BinaryProtocol::_rxLength = 0;
+bool BinaryProtocol::_rxOverflow = false;
+
+unsigned char BinaryProtocol::_txFrame[CLI_BINPROTO_FRAME_MAX_LENGTH];
+unsigned char BinaryProtocol::_txEncoded[BinaryProtocol::ENCODED_FRAME_MAX_LENGTH + 1];
+
+uint16_t BinaryProtocol::_subscription[CLI_BINPROTO_SUBSCRIPTION_MAX_COUNT];
+size_t BinaryProtocol::_subscriptionCount = 0;
+uint16_t BinaryProtocol::_period_ms = 0;
+uint64_t BinaryProtocol::_nextSample_ms = 0;
+uint16_t BinaryProtocol::_sequence = 0;
+
+BinaryProtocol::Stats BinaryProtocol::_stats;
+
+
+namespace {
+
+
+const size_t PAYLOAD_MAX_LENGTH = CLI_BINPROTO_FRAME_MAX_LENGTH - binproto::RESPONSE_HEADER_LENGTH - binproto::CRC_LENGTH;
+
+
+union FloatBits
+{
+	float f;
+	uint32_t u;
+};
+
+
+inline uint16_t get16(const unsigned char* p)
+{
+	return static_cast<uint16_t>(p[0] & 0xFF) | (static_cast<uint16_t>(p[1] & 0xFF) << 8);
+}
+
+
+inline uint32_t get32(const unsigned char* p)
+{
+	return static_cast<uint32_t>(get16(p)) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+}
+
+
+inline unsigned char* put16(unsigned char* p, uint16_t value)
+{
+	p[0] = value & 0xFF;
+	p[1] = (value >> 8) & 0xFF;
+	return p + 2;
+}
+
+
+inline unsigned char* put32(unsigned char* p, uint32_t value)
+{
+	put16(p, value & 0xFFFF);
+	return put16(p + 2, (value >> 16) & 0xFFFF);
+}
+
+
+} // namespace
+
+
+///
+///
+///
+void BinaryProtocol::enter()
+{
+	_rxLength = 0;
+	_rxOverflow = false;
+	_subscriptionCount = 0;
+	memset(&_stats, 0, sizeof(_stats));
+	Server::_binaryMode = true;
+
+	// leading delimiter terminates text output for host frame decoder
+	Server::_print(CLI_ENDL);
+	Server::_outputBuf.push(0);
+	_txFrame[0] = binproto::UNSOLICITED_ID;
+	_txFrame[1] = binproto::Opcode::Info;
+	_txFrame[2] = binproto::Status::Ok;
+	_send(binproto::RESPONSE_HEADER_LENGTH + _info(_txFrame + binproto::RESPONSE_HEADER_LENGTH));
+}
+
+
+///
+///
+///
+bool BinaryProtocol::_ready()
+{
+	return Server::_outputBuf.capacity() - Server::_outputBuf.size() >= ENCODED_FRAME_MAX_LENGTH + 1;
+}
+
+
+///
+///
+///
+void BinaryProtocol::_processOctet(unsigned char octet)
+{
+	if (octet != 0)
+	{
+		if (_rxLength == ENCODED_FRAME_MAX_LENGTH)
+		{
+			_rxOverflow = true;
+		}
+		else
+		{
+			_rxFrame[_rxLength++] = octet;
+		}
+		return;
+	}
+
+	// delimiter: empty frames are used by host to resync
+	if (_rxOverflow)
+	{
+		++_stats.framingErrors;
+	}
+	else if (_rxLength != 0)
+	{
+		size_t len = 0;
+		if (!emb::cobs_decode(_rxFrame, _rxLength, _rxFrame, len)
+				|| (len < binproto::REQUEST_HEADER_LENGTH + binproto::CRC_LENGTH))
+		{
+			++_stats.framingErrors;
+		}
+		else if (emb::crc16_ccitt(_rxFrame, len) != 0)
+		{
+			++_stats.crcErrors;
+		}
+		else
+		{
+			++_stats.received;
+			_processFrame(_rxFrame, len - binproto::CRC_LENGTH);
+		}
+	}
+	_rxLength = 0;
+	_rxOverflow = false;
+}
+
+
+///
+///
+///
+void BinaryProtocol::_processFrame(const unsigned char* frame, size_t len)
+{
+	const unsigned char* request = frame + binproto::REQUEST_HEADER_LENGTH;
+	size_t requestLen = len - binproto::REQUEST_HEADER_LENGTH;
+	unsigned char* payload = _txFrame + binproto::RESPONSE_HEADER_LENGTH;
+
+	switch (frame[1])
+	{
+	case binproto::Opcode::Ping:
+		if (requestLen > PAYLOAD_MAX_LENGTH)
+		{
+			_sendResponse(frame, binproto::Status::BadLength, 0);
+			return;
+		}
+		for (size_t i = 0; i < requestLen; ++i)
+		{
+			payload[i] = request[i];
+		}
+		_sendResponse(frame, binproto::Status::Ok, requestLen);
+		return;
+
+	case binproto::Opcode::Info:
+		_sendResponse(frame, binproto::Status::Ok, _info(payload));
+		return;
+
+	case binproto::Opcode::VarInfo:
+	{
+		if (requestLen != 2)
+		{
+			_sendResponse(frame, binproto::Status::BadLength, 0);
+			return;
+		}
+		const sys::Var* var = sys::VarRegistry::var(get16(request));
+		if (var == NULL)
+		{
+			_sendResponse(frame, binproto::Status::BadId, 0);
+			return;
+		}
+		payload[0] = var->type.underlying_value();
+		payload[1] = var->writable ? 1 : 0;
+		FloatBits scale;
+		scale.f = var->scale;
+		unsigned char* name = put32(payload + 2, scale.u);
+		size_t nameLen = 0;
+		for (; (var->name[nameLen] != '\0') && (nameLen < PAYLOAD_MAX_LENGTH - 6); ++nameLen)
+		{
+			name[nameLen] = var->name[nameLen];
+		}
+		_sendResponse(frame, binproto::Status::Ok, 6 + nameLen);
+		return;
+	}
+
+	case binproto::Opcode::Stats:
+	{
+		unsigned char* p = put32(payload, _stats.received);
+		p = put32(p, _stats.crcErrors);
+		p = put32(p, _stats.framingErrors);
+		p = put32(p, _stats.telemetrySent);
+		p = put32(p, _stats.telemetryDropped);
+		_sendResponse(frame, binproto::Status::Ok, p - payload);
+		return;
+	}
+
+	case binproto::Opcode::Read:
+	{
+		size_t count = requestLen / 2;
+		if ((count == 0) || (requestLen % 2 != 0) || (count > binproto::READ_MAX_COUNT))
+		{
+			_sendResponse(frame, binproto::Status::BadLength, 0);
+			return;
+		}
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (sys::VarRegistry::var(get16(request + 2 * i)) == NULL)
+			{
+				payload[0] = i;
+				_sendResponse(frame, binproto::Status::BadId, 1);
+				return;
+			}
+		}
+		unsigned char* p = payload;
+		for (size_t i = 0; i < count; ++i)
+		{
+			uint16_t id = get16(request + 2 * i);
+			*p++ = sys::VarRegistry::var(id)->type.underlying_value();
+			p = put32(p, sys::VarRegistry::read(id));
+		}
+		_sendResponse(frame, binproto::Status::Ok, p - payload);
+		return;
+	}
+
+	case binproto::Opcode::Write:
+	{
+		const size_t entryLen = 7;
+		if ((requestLen == 0) || (requestLen % entryLen != 0))
+		{
+			_sendResponse(frame, binproto::Status::BadLength, 0);
+			return;
+		}
+		// writes are applied in order up to the first failed one
+		for (size_t i = 0; i < requestLen / entryLen; ++i)
+		{
+			const unsigned char* entry = request + i * entryLen;
+			uint16_t id = get16(entry);
+			const sys::Var* var = sys::VarRegistry::var(id);
+			binproto::Status status = binproto::Status::Ok;
+			if (var == NULL)
+			{
+				status = binproto::Status::BadId;
+			}
+			else if (var->type.underlying_value() != (entry[2] & 0xFF))
+			{
+				status = binproto::Status::TypeMismatch;
+			}
+			else if (!sys::VarRegistry::write(id, get32(entry + 3)))
+			{
+				status = binproto::Status::ReadOnly;
+			}
+
+			if (status != binproto::Status::Ok)
+			{
+				payload[0] = i;
+				_sendResponse(frame, status, 1);
+				return;
+			}
+		}
+		_sendResponse(frame, binproto::Status::Ok, 0);
+		return;
+	}
+
+	case binproto::Opcode::Subscribe:
+	{
+		size_t count = (requestLen - 2) / 2;
+		if ((requestLen < 2) || (requestLen % 2 != 0) || (count > CLI_BINPROTO_SUBSCRIPTION_MAX_COUNT))
+		{
+			_sendResponse(frame, binproto::Status::BadLength, 0);
+			return;
+		}
+		if (count == 0)
+		{
+			_subscriptionCount = 0;
+			_sendResponse(frame, binproto::Status::Ok, 0);
+			return;
+		}
+		uint16_t period_ms = get16(request);
+		if (period_ms == 0)
+		{
+			_sendResponse(frame, binproto::Status::BadPeriod, 0);
+			return;
+		}
+		if (_now == NULL)
+		{
+			_sendResponse(frame, binproto::Status::NoTimeSource, 0);
+			return;
+		}
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (sys::VarRegistry::var(get16(request + 2 + 2 * i)) == NULL)
+			{
+				payload[0] = i;
+				_sendResponse(frame, binproto::Status::BadId, 1);
+				return;
+			}
+		}
+		for (size_t i = 0; i < count; ++i)
+		{
+			_subscription[i] = get16(request + 2 + 2 * i);
+		}
+		_subscriptionCount = count;
+		_period_ms = period_ms;
+		_nextSample_ms = _now();
+		_sequence = 0;
+		_sendResponse(frame, binproto::Status::Ok, 0);
+		return;
+	}
+
+	case binproto::Opcode::Exit:
+		_sendResponse(frame, binproto::Status::Ok, 0);
+		_subscriptionCount = 0;
+		Server::_binaryMode = false;
+		Server::_printPrompt();
+		return;
+
+	default:
+		_sendResponse(frame, binproto::Status::UnknownOpcode, 0);
+		return;
+	}
+}
+
+
+///
+///
+///
+bool BinaryProtocol::_runTelemetry()
+{
+	if (_subscriptionCount == 0) return false;
+
+	uint64_t now = _now();
+	if (now < _nextSample_ms) return false;
+
+	// samples missed by late call are accounted as dropped
+	uint64_t missed = (now - _nextSample_ms) / _period_ms;
+	_sequence += missed;
+	_stats.telemetryDropped += missed;
+	_nextSample_ms += (missed + 1) * _period_ms;
+
+	size_t len = binproto::RESPONSE_HEADER_LENGTH + binproto::TELEMETRY_HEADER_LENGTH;
+	for (size_t i = 0; i < _subscriptionCount; ++i)
+	{
+		len += _valueSize(sys::VarRegistry::var(_subscription[i])->type);
+	}
+	if (Server::_outputBuf.capacity() - Server::_outputBuf.size() < ENCODED_FRAME_MAX_LENGTH + 1)
+	{
+		++_sequence;
+		++_stats.telemetryDropped;
+		return false;
+	}
+
+	_txFrame[0] = binproto::UNSOLICITED_ID;
+	_txFrame[1] = binproto::Opcode::Telemetry;
+	_txFrame[2] = binproto::Status::Ok;
+	unsigned char* p = put16(_txFrame + binproto::RESPONSE_HEADER_LENGTH, _sequence++);
+	p = put32(p, now & 0xFFFFFFFF);
+	for (size_t i = 0; i < _subscriptionCount; ++i)
+	{
+		uint32_t value = sys::VarRegistry::read(_subscription[i]);
+		if (_valueSize(sys::VarRegistry::var(_subscription[i])->type) == 2)
+		{
+			p = put16(p, value & 0xFFFF);
+		}
+		else
+		{
+			p = put32(p, value);
+		}
+	}
+	_send(len);
+	++_stats.telemetrySent;
+	return true;
+}
+
+
+///
+///
+///
+size_t BinaryProtocol::_valueSize(sys::VarType type)
+{
+	switch (type.native_value())
+	{
+	case sys::VarType::Uint16:
+	case sys::VarType::Int16:
+		return 2;
+	default:
+		return 4;
+	}
+}
+
+
+///
+///
+///
+void BinaryProtocol::_send(size_t len)
+{
+	uint16_t crc = emb::crc16_ccitt(_txFrame, len);
+	_txFrame[len] = (crc >> 8) & 0xFF;
+	_txFrame[len + 1] = crc & 0xFF;
+	size_t encodedLen = emb::cobs_encode(_txFrame, len + binproto::CRC_LENGTH, _txEncoded);
+	_txEncoded[encodedLen++] = 0;
+
+	if (Server::_outputBuf.capacity() - Server::_outputBuf.size() < encodedLen) return;
+	for (size_t i = 0; i < encodedLen; ++i)
+	{
+		Server::_outputBuf.push(_txEncoded[i]);
+	}
+}
+
+
+///
+///
+///
+void BinaryProtocol::_sendResponse(const unsigned char* request, binproto::Status status, size_t payloadLen)
+{
+	_txFrame[0] = request[0];
+	_txFrame[1] = request[1];
+	_txFrame[2] = status.underlying_value();
+	_send(binproto::RESPONSE_HEADER_LENGTH + payloadLen);
+}
+
+
+///
+///
+///
+size_t BinaryProtocol::_info(unsigned char* payload)
+{
+	unsigned char* p = payload;
+	*p++ = CLI_BINPROTO_VERSION;
+	p = put16(p, sys::VarRegistry::count());
+	p = put16(p, CLI_BINPROTO_FRAME_MAX_LENGTH);
+	*p++ = CLI_BINPROTO_SUBSCRIPTION_MAX_COUNT;
+	return p - payload;
+}
+
+
+} // namespace cli
+
+
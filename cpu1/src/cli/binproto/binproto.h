@@ -0,0 +1,113 @@
+/**
+ * @file binproto.h
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include "emb/emb_cobs.h"
+#include "emb/emb_crc.h"
+#include "sys/vars/vars.h"
+
+#include "binproto_def.h"
+
+
+namespace cli {
+/// @addtogroup cli
+/// @{
+
+
+/**
+ * @brief Framed binary protocol on CLI UART: variable read/write by ID and telemetry streaming
+ * for host tools (see binproto_def.h). Server switches to protocol by "binmode" command and returns to shell
+ * on Exit request. Responses and telemetry are queued to server output buffer, request is taken from UART
+ * only when output buffer can hold the largest response: host may pipeline requests without overflowing it.
+ */
+class BinaryProtocol
+{
+	friend class Server;
+public:
+	struct Stats
+	{
+		uint32_t received;
+		uint32_t crcErrors;
+		uint32_t framingErrors;		// invalid COBS encoding or oversized frame
+		uint32_t telemetrySent;
+		uint32_t telemetryDropped;
+	};
+
+	static const size_t ENCODED_FRAME_MAX_LENGTH = CLI_BINPROTO_FRAME_MAX_LENGTH + CLI_BINPROTO_FRAME_MAX_LENGTH / 254 + 1;
+
+private:
+	BinaryProtocol();					// no constructor
+	BinaryProtocol(const BinaryProtocol& other);		// no copy constructor
+	BinaryProtocol& operator=(const BinaryProtocol& other);	// no copy assignment operator
+
+private:
+	static uint64_t (*_now)();
+
+	static unsigned char _rxFrame[ENCODED_FRAME_MAX_LENGTH];
+	static size_t _rxLength;
+	static bool _rxOverflow;		// oversized frame is discarded up to delimiter
+
+	static unsigned char _txFrame[CLI_BINPROTO_FRAME_MAX_LENGTH];
+	static unsigned char _txEncoded[ENCODED_FRAME_MAX_LENGTH + 1];
+
+	static uint16_t _subscription[CLI_BINPROTO_SUBSCRIPTION_MAX_COUNT];
+	static size_t _subscriptionCount;
+	static uint16_t _period_ms;
+	static uint64_t _nextSample_ms;
+	static uint16_t _sequence;
+
+	static Stats _stats;
+
+public:
+	/**
+	 * @brief Registers time source of telemetry, e.g. mcu::chrono::SystemClock::now.
+	 * Telemetry is not available until time source is registered.
+	 * @param now_ms - function that returns time in ms
+	 * @return (none)
+	 */
+	static void init(uint64_t (*now_ms)())
+	{
+		_now = now_ms;
+	}
+
+	/**
+	 * @brief Switches CLI server to binary protocol and sends hello frame. Called by shell command,
+	 * server does not print prompt after it.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void enter();
+
+	static const Stats& stats() { return _stats; }
+
+private:
+	static bool _ready();
+	static void _processOctet(unsigned char octet);
+	static void _processFrame(const unsigned char* frame, size_t len);
+	static bool _runTelemetry();
+
+	static size_t _valueSize(sys::VarType type);
+	static void _send(size_t len);
+	static void _sendResponse(const unsigned char* request, binproto::Status status, size_t payloadLen);
+	static size_t _info(unsigned char* payload);
+};
+
+
+/// @}
+} // namespace cli
+
+
@@ -0,0 +1,103 @@
+/**
+ * @file binproto_def.h
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Binary protocol wire definitions, shared by firmware and host client.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include "emb/emb_core/emb_scopedenum.h"
+
+
+/*
+ * Frame: COBS-encoded octets terminated by 0x00 delimiter. Decoded frame:
+ *   request:  [request ID][opcode][payload...][CRC-16 MSB][CRC-16 LSB]
+ *   response: [request ID][opcode][status][payload...][CRC-16 MSB][CRC-16 LSB]
+ * CRC-16/CCITT-FALSE covers all preceding octets. Multi-octet payload fields are little-endian.
+ * Response echoes request ID and opcode, requests may be pipelined: they are processed in order.
+ * Request ID 0 is reserved for unsolicited frames: hello (Info response) and telemetry.
+ * Frames with invalid encoding or CRC are dropped without response.
+ *
+ * Payloads (request -> response):
+ *   Ping       [any]                              -> [same octets]
+ *   Info       []                                 -> [version u8][var count u16][frame max length u16][subscription max u8]
+ *   VarInfo    [id u16]                           -> [type u8][writable u8][scale f32][name...]
+ *   Stats      []                                 -> [received u32][CRC errors u32][framing errors u32]
+ *                                                    [telemetry sent u32][telemetry dropped u32]
+ *   Read       [id u16]...                        -> [type u8][value u32]...
+ *   Write      [id u16][type u8][value u32]...    -> [] or [index of failed write u8]
+ *   Subscribe  [period ms u16][id u16]...         -> [], no IDs - unsubscribe
+ *   Exit       []                                 -> [], server returns to text shell
+ * Types are sys::VarType values: 0 - uint16, 1 - int16, 2 - uint32, 3 - int32, 4 - float32.
+ * Telemetry (unsolicited): [sequence u16][timestamp ms u32][value]... - values are packed by type size
+ * (16-bit types - 2 octets, 32-bit types - 4 octets) in subscription order. Sample that does not fit
+ * into output buffer is dropped, sequence number still advances.
+ */
+
+
+#define CLI_BINPROTO_VERSION 1
+#define CLI_BINPROTO_FRAME_MAX_LENGTH 128		// decoded frame including header and CRC
+#define CLI_BINPROTO_SUBSCRIPTION_MAX_COUNT 16
+
+
+namespace cli {
+
+namespace binproto {
+/// @addtogroup cli
+/// @{
+
+
+SCOPED_ENUM_DECLARE_BEGIN(Opcode)
+{
+	Ping = 0x01,
+	Info = 0x02,
+	VarInfo = 0x03,
+	Stats = 0x04,
+	Read = 0x10,
+	Write = 0x11,
+	Subscribe = 0x20,
+	Telemetry = 0x21,
+	Exit = 0x7F
+}
+SCOPED_ENUM_DECLARE_END(Opcode)
+
+
+SCOPED_ENUM_DECLARE_BEGIN(Status)
+{
+	Ok = 0x00,
+	UnknownOpcode = 0x01,
+	BadLength = 0x02,
+	BadId = 0x03,
+	ReadOnly = 0x04,
+	TypeMismatch = 0x05,
+	BadPeriod = 0x06,
+	NoTimeSource = 0x07,
+	Timeout = 0xFF		// not sent by device: host client got no response
+}
+SCOPED_ENUM_DECLARE_END(Status)
+
+
+const unsigned char UNSOLICITED_ID = 0x00;
+const size_t REQUEST_HEADER_LENGTH = 2;
+const size_t RESPONSE_HEADER_LENGTH = 3;
+const size_t CRC_LENGTH = 2;
+const size_t TELEMETRY_HEADER_LENGTH = 6;
+const size_t READ_MAX_COUNT = (CLI_BINPROTO_FRAME_MAX_LENGTH - RESPONSE_HEADER_LENGTH - CRC_LENGTH) / 5;
+
+
+/// @}
+} // namespace binproto
+
+} // namespace cli
+
+
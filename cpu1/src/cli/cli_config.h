@@ -19,7 +19,8 @@
 #define CLI_SERVER_VERSION 0.1
 
 #define CLI_USE_HISTORY
-#define CLI_HISTORY_LENGTH 8
+#define CLI_HISTORY_LENGTH 32		// max number of entries
+#define CLI_HISTORY_BUFFER_SIZE 256	// chars of all entries, entries are packed without terminators
 
 #define CLI_PROMPT_MAX_LENGTH 32
 
@@ -28,8 +29,11 @@
 #define CLI_CMDLINE_MAX_LENGTH 64
 
 #define CLI_ESCSEQ_MAX_LENGTH 16
+#define CLI_ESCSEQ_MAX_STATES 64	// escape sequence DFA: trie nodes of core and application bindings
+#define CLI_ESCSEQ_MAX_CLASSES 32	// escape sequence DFA: distinct chars used in bindings + 1
 
 #define CLI_OUTBUT_BUFFER_LENGTH 256
+#define CLI_TYPEAHEAD_BUFFER_LENGTH 32	// input read while command is suspended
 
 #define CLI_TOKEN_MAX_COUNT 8
 #define CLI_TOKEN_MAX_LENGHT 16
@@ -37,6 +41,8 @@
 
 #define CLI_ESC		"\x1B"
 #define CLI_ENDL	"\r\n"
+#define CLI_INTERRUPT_CHAR	'\x03'	// Ctrl-C: interrupts suspended command
+#define CLI_SEARCH_CANCEL_CHAR	'\x07'	// Ctrl-G: cancels history search
 
 #define CLI_COLOR_OFF		"\033[0m"
 #define CLI_COLOR_RED		"\033[1;31m"
@@ -47,8 +53,8 @@
 #define CLI_COLOR_CYAN		"\033[1;36m"
 #define CLI_COLOR_WHITE		"\033[1;37m"
 
-#define CLI_PROMPT_BEGIN CLI_COLOR_MAGENTA"[root@"
-#define CLI_PROMPT_END "]> "CLI_COLOR_OFF
+#define CLI_PROMPT_BEGIN CLI_COLOR_MAGENTA "[root@"
+#define CLI_PROMPT_END "]> " CLI_COLOR_OFF
 
 #define CLI_WELCOME_STRING CLI_COLOR_GREEN "Welcome to uShell!" CLI_COLOR_OFF
 
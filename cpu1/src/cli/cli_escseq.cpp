@@ -23,21 +23,13 @@ namespace cli {
 void Server::_escReturn()
 {
 #ifdef CLI_USE_HISTORY
-	if (!_cmdline.empty())
+	if (!_cmdline.empty()
+			&& (_history.empty() || !_history.equals(0, _cmdline.data(), _cmdline.size())))
 	{
-		if (_history.empty())
-		{
-			_history.push(_cmdline);
-			_lastCmdHistoryPos = 0;
-		}
-		else if (_cmdline != _history.back())
-		{
-			_history.push(_cmdline);
-			_lastCmdHistoryPos = (_lastCmdHistoryPos + 1) % _history.capacity();
-		}
+		_history.push(_cmdline.data(), _cmdline.size());
 	}
 	_newCmdSaved = true;
-	_historyPosition = _lastCmdHistoryPos;
+	_historyPosition = 0;
 #endif
 
 	const char* argv[CLI_TOKEN_MAX_COUNT];
@@ -52,7 +44,15 @@ void Server::_escReturn()
 	case 0:
 		break;
 	default:
-		_exec(argc, argv);
+		out.restart();
+		if (_exec(argc, argv) == EXEC_PENDING)
+		{
+			// tokens stay in command line until command is completed
+			memcpy(_pendingArgv, argv, argc * sizeof(argv[0]));
+			_pendingArgc = argc;
+			return;
+		}
+		if (_binaryMode) return;	// prompt is printed when host exits binary protocol
 		break;
 	}
 
@@ -125,7 +125,7 @@ void Server::_escBack()
 		_cmdline.pop_back();
 		--_cursorPos;
 
-		print(CLI_ESC"[D"" "CLI_ESC"[D");	// delete symbol
+		print(CLI_ESC "[D" " " CLI_ESC "[D");	// delete symbol
 		_saveCursorPos();
 		print(_cmdline.begin() + _cursorPos);
 		print(" ");				// hide last symbol
@@ -182,6 +182,153 @@ void Server::_escDown()
 }
 
 
+///
+///
+///
+void Server::_escWordLeft()
+{
+	size_t pos = _cursorPos;
+	while ((pos > 0) && (_cmdline[pos - 1] == ' ')) --pos;
+	while ((pos > 0) && (_cmdline[pos - 1] != ' ')) --pos;
+	if (pos != _cursorPos)
+	{
+		_moveCursor(int(pos) - int(_cursorPos));
+		_cursorPos = pos;
+	}
+}
+
+
+///
+///
+///
+void Server::_escWordRight()
+{
+	size_t pos = _cursorPos;
+	while ((pos < _cmdline.lenght()) && (_cmdline[pos] == ' ')) ++pos;
+	while ((pos < _cmdline.lenght()) && (_cmdline[pos] != ' ')) ++pos;
+	if (pos != _cursorPos)
+	{
+		_moveCursor(int(pos) - int(_cursorPos));
+		_cursorPos = pos;
+	}
+}
+
+
+///
+///
+///
+void Server::_escKillToEnd()
+{
+	if (_cursorPos < _cmdline.lenght())
+	{
+		_cmdline.resize(_cursorPos);
+		print(CLI_ESC"[K");
+	}
+}
+
+
+///
+///
+///
+void Server::_escKillToHome()
+{
+	_eraseBeforeCursor(_cursorPos);
+}
+
+
+///
+///
+///
+void Server::_escKillWord()
+{
+	size_t pos = _cursorPos;
+	while ((pos > 0) && (_cmdline[pos - 1] == ' ')) --pos;
+	while ((pos > 0) && (_cmdline[pos - 1] != ' ')) --pos;
+	_eraseBeforeCursor(_cursorPos - pos);
+}
+
+
+///
+///
+///
+void Server::_escTab()
+{
+	if (_complete == NULL)
+	{
+		return;
+	}
+
+	emb::String<CLI_CMDLINE_MAX_LENGTH> line;
+	for (size_t i = 0; i < _cursorPos; ++i)
+	{
+		line.push_back(_cmdline[i]);
+	}
+
+	const char* argv[CLI_TOKEN_MAX_COUNT + 1];
+	int argc = _tokenize(argv, line);
+	if (argc < 0)
+	{
+		return;
+	}
+	if ((_cursorPos == 0) || (_cmdline[_cursorPos - 1] == ' '))
+	{
+		argv[argc++] = "";	// new token is started
+	}
+
+	char suffix[CLI_CMDLINE_MAX_LENGTH] = {0};
+	int candidates = _complete(argc, argv, suffix, CLI_CMDLINE_MAX_LENGTH);
+	if ((candidates > 1) && (suffix[0] == '\0'))
+	{
+		_redrawLine();	// candidates are printed by callback
+		return;
+	}
+
+	for (const char* ch = suffix; *ch != '\0'; ++ch)
+	{
+		_insertChar(*ch);
+	}
+}
+
+
+///
+///
+///
+void Server::_escSearch()
+{
+#ifdef CLI_USE_HISTORY
+	_searchActive = true;
+	_searchFailed = false;
+	_searchPrefix.clear();
+	_searchMatch = -1;
+	_redrawSearch();
+#endif
+}
+
+
+///
+///
+///
+void Server::_eraseBeforeCursor(size_t count)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	memmove(_cmdline.begin() + _cursorPos - count,
+			_cmdline.begin() + _cursorPos,
+			_cmdline.lenght() - _cursorPos);
+	_cmdline.resize(_cmdline.lenght() - count);
+	_moveCursor(-int(count));
+	_cursorPos -= count;
+
+	_saveCursorPos();
+	print(_cmdline.begin() + _cursorPos);
+	print(CLI_ESC"[K");
+	_loadCursorPos();
+}
+
+
 } // namespace cli
 
 
@@ -0,0 +1,141 @@
+/**
+ * @file cli_escseqdfa.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "cli_escseqdfa.h"
+
+#include <cstring>
+
+
+namespace cli {
+
+
+///
+///
+///
+void EscSeqDfa::clear()
+{
+	memset(_classOf, 0, sizeof(_classOf));
+	memset(_next, 0, sizeof(_next));
+	for (size_t i = 0; i < CLI_ESCSEQ_MAX_STATES; ++i)
+	{
+		_handlers[i] = NULL;
+		_csi[i] = false;
+	}
+	_classCount = 1;
+	_stateCount = 1;
+	_matched = NULL;
+	reset();
+}
+
+
+///
+///
+///
+bool EscSeqDfa::add(const EscSeq* bindings, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (!_add(bindings[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+///
+///
+///
+bool EscSeqDfa::_add(const EscSeq& binding)
+{
+	if ((binding.len == 0) || (binding.len > CLI_ESCSEQ_MAX_LENGTH) || !isControl(binding.str[0])
+			|| (binding.handler == NULL))
+	{
+		return false;
+	}
+
+	size_t state = 0;
+	for (size_t i = 0; i < binding.len; ++i)
+	{
+		unsigned int code = static_cast<unsigned char>(binding.str[i]) & 0xFF;
+		if (code >= 128) return false;
+		if (_handlers[state] != NULL) return false;	// shorter sequence is prefix of this one
+
+		if (_classOf[code] == 0)
+		{
+			if (_classCount >= CLI_ESCSEQ_MAX_CLASSES) return false;
+			_classOf[code] = _classCount++;
+		}
+
+		unsigned char& next = _next[state][_classOf[code]];
+		if (next == 0)
+		{
+			if (_stateCount >= CLI_ESCSEQ_MAX_STATES) return false;
+			next = _stateCount++;
+			_csi[next] = _csi[state] || ((i == 1) && (binding.str[0] == '\x1B') && (binding.str[1] == '['));
+		}
+		state = next;
+	}
+
+	for (size_t c = 0; c < _classCount; ++c)
+	{
+		if (_next[state][c] != 0) return false;	// this sequence is prefix of longer one
+	}
+	_handlers[state] = binding.handler;
+	return true;
+}
+
+
+///
+///
+///
+EscSeqDfa::Status EscSeqDfa::step(char ch)
+{
+	unsigned int code = static_cast<unsigned char>(ch) & 0xFF;
+
+	if (_skipping)
+	{
+		if (code >= 0x20 && code <= 0x3F) return Pending;	// CSI parameter and intermediate bytes
+		_skipping = false;
+		return Rejected;	// final byte or unexpected char
+	}
+
+	size_t next = (code < 128) ? _next[_state][_classOf[code]] : 0;
+	if (next == 0)
+	{
+		bool csi = _csi[_state];
+		_state = 0;
+		if (csi && code >= 0x20 && code <= 0x3F)
+		{
+			_skipping = true;
+			return Pending;
+		}
+		return Rejected;
+	}
+
+	if (_handlers[next] != NULL)
+	{
+		_matched = _handlers[next];
+		_state = 0;
+		return Matched;
+	}
+
+	_state = next;
+	return Pending;
+}
+
+
+} // namespace cli
+
+
@@ -0,0 +1,105 @@
+/**
+ * @file cli_escseqdfa.h
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "cli_config.h"
+
+
+namespace cli {
+/// @addtogroup cli
+/// @{
+
+
+/**
+ * @brief Escape sequence (control char or sequence starting with control char) binding.
+ */
+struct EscSeq
+{
+	const char* str;
+	size_t len;
+	void (*handler)();
+};
+
+
+/**
+ * @brief Escape sequence recognizer: binding tables are compiled into DFA (trie over char classes),
+ * every received char is one table transition. Bytes of unknown CSI sequence (ESC [ params final)
+ * are consumed up to final byte, so they are not inserted into command line.
+ */
+class EscSeqDfa
+{
+public:
+	enum Status
+	{
+		Pending,	// char is consumed, sequence is not complete
+		Matched,	// sequence is complete, handler() returns its handler
+		Rejected	// char does not continue any sequence, DFA is reset
+	};
+private:
+	unsigned char _classOf[128];	// char -> class, 0 - char is not used in any sequence
+	unsigned char _next[CLI_ESCSEQ_MAX_STATES][CLI_ESCSEQ_MAX_CLASSES];	// 0 - no transition (start state is never target)
+	void (*_handlers[CLI_ESCSEQ_MAX_STATES])();
+	bool _csi[CLI_ESCSEQ_MAX_STATES];	// state is inside CSI sequence
+	size_t _classCount;
+	size_t _stateCount;
+
+	size_t _state;
+	bool _skipping;
+	void (*_matched)();
+public:
+	EscSeqDfa() { clear(); }
+
+	/**
+	 * @brief Removes all bindings.
+	 * @param (none)
+	 * @return (none)
+	 */
+	void clear();
+
+	/**
+	 * @brief Adds bindings. Binding with the same sequence as existing one overrides it.
+	 * @param bindings - binding table
+	 * @param count - number of bindings
+	 * @return \c true on success, \c false if table is invalid (sequence does not start with control char,
+	 * is prefix of other sequence) or DFA capacity is exceeded.
+	 */
+	bool add(const EscSeq* bindings, size_t count);
+
+	/**
+	 * @brief Makes transition on received char.
+	 * @param ch - received char
+	 * @return Transition status.
+	 */
+	Status step(char ch);
+
+	void (*handler() const)() { return _matched; }
+	bool idle() const { return (_state == 0) && !_skipping; }
+	void reset() { _state = 0; _skipping = false; }
+	size_t stateCount() const { return _stateCount; }
+	size_t classCount() const { return _classCount; }
+
+	static bool isControl(char ch) { return (ch >= 0 && ch <= 0x1F) || ch == 0x7F; }
+private:
+	bool _add(const EscSeq& binding);
+};
+
+
+/// @}
+} // namespace cli
+
+
@@ -0,0 +1,234 @@
+/**
+ * @file cli_history.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include <algorithm>
+#include "cli_history.h"
+#include "emb/emb_crc.h"
+
+
+namespace cli {
+
+
+namespace {
+
+
+const char HISTORY_IMAGE_MAGIC = 'H';
+const char HISTORY_IMAGE_VERSION = 1;
+const size_t HISTORY_IMAGE_HEADER_SIZE = 5;	// magic, version, entry count, used chars (2 octets, LE)
+
+
+/**
+ * @brief Sequential access to EEPROM image: operations are split at page boundaries,
+ * written octets are collected into chunks, CRC is updated with every octet.
+ */
+class EepromImage
+{
+private:
+	emb::IEeprom& _eeprom;
+	emb::EepromAddr _addr;
+	const unsigned int _pageSize;
+	const uint64_t _timeout_ms;
+	char _chunk[16];
+	size_t _chunkLen;
+public:
+	uint16_t crc;
+	emb::EepromStatus status;
+
+	EepromImage(emb::IEeprom& eeprom, emb::EepromAddr addr, unsigned int pageSize, uint64_t timeout_ms)
+		: _eeprom(eeprom)
+		, _addr(addr)
+		, _pageSize(pageSize)
+		, _timeout_ms(timeout_ms)
+		, _chunkLen(0)
+		, crc(0xFFFF)
+		, status(emb::EEPROM_SUCCESS)
+	{}
+
+	void put(char ch)
+	{
+		unsigned char octet = ch & 0xFF;
+		crc = emb::crc16_ccitt(&octet, 1, crc);
+		_chunk[_chunkLen++] = octet;
+		if ((_chunkLen == sizeof(_chunk)) || (_addr.offset + _chunkLen == _pageSize))
+		{
+			flush();
+		}
+	}
+
+	void flush()
+	{
+		if ((_chunkLen != 0) && (status == emb::EEPROM_SUCCESS))
+		{
+			status = _eeprom.write(_addr, _chunk, _chunkLen, _timeout_ms);
+		}
+		_advance(_chunkLen);
+		_chunkLen = 0;
+	}
+
+	void get(char* data, size_t len)
+	{
+		while ((len != 0) && (status == emb::EEPROM_SUCCESS))
+		{
+			size_t part = std::min(len, static_cast<size_t>(_pageSize - _addr.offset));
+			status = _eeprom.read(_addr, data, part, _timeout_ms);
+			for (size_t i = 0; i < part; ++i)
+			{
+				data[i] &= 0xFF;
+				unsigned char octet = data[i];
+				crc = emb::crc16_ccitt(&octet, 1, crc);
+			}
+			_advance(part);
+			data += part;
+			len -= part;
+		}
+	}
+private:
+	void _advance(size_t len)
+	{
+		_addr.offset += len;
+		_addr.page += _addr.offset / _pageSize;
+		_addr.offset %= _pageSize;
+	}
+};
+
+
+} // namespace
+
+
+///
+///
+///
+bool History::push(const char* str, size_t len)
+{
+	if ((len == 0) || (len >= CLI_HISTORY_BUFFER_SIZE))
+	{
+		return false;
+	}
+
+	while ((_count == CLI_HISTORY_LENGTH) || (CLI_HISTORY_BUFFER_SIZE - _used < len))
+	{
+		_dropOldest();
+	}
+
+	size_t firstPart = std::min(len, CLI_HISTORY_BUFFER_SIZE - _head);
+	memcpy(_buf + _head, str, firstPart);
+	memcpy(_buf, str + firstPart, len - firstPart);
+
+	_offsets[(_first + _count) % CLI_HISTORY_LENGTH] = _head;
+	++_count;
+	_used += len;
+	_head = (_head + len) % CLI_HISTORY_BUFFER_SIZE;
+	return true;
+}
+
+
+///
+///
+///
+size_t History::copy(size_t age, char* dest, size_t size) const
+{
+	size_t len = std::min(length(age), size);
+	size_t start = _offsets[_slot(age)];
+	size_t firstPart = std::min(len, CLI_HISTORY_BUFFER_SIZE - start);
+	memcpy(dest, _buf + start, firstPart);
+	memcpy(dest + firstPart, _buf, len - firstPart);
+	return len;
+}
+
+
+///
+///
+///
+emb::EepromStatus History::save(emb::IEeprom& eeprom, emb::EepromAddr addr, unsigned int pageSize, uint64_t timeout_ms) const
+{
+	EepromImage image(eeprom, addr, pageSize, timeout_ms);
+	image.put(HISTORY_IMAGE_MAGIC);
+	image.put(HISTORY_IMAGE_VERSION);
+	image.put(_count);
+	image.put(_used & 0xFF);
+	image.put(_used >> 8);
+
+	for (size_t age = _count; age > 0; --age)
+	{
+		size_t len = length(age - 1);
+		size_t pos = _offsets[_slot(age - 1)];
+		image.put(len);
+		for (size_t i = 0; i < len; ++i)
+		{
+			image.put(_buf[pos]);
+			if (++pos == CLI_HISTORY_BUFFER_SIZE) pos = 0;
+		}
+	}
+
+	uint16_t crc = image.crc;
+	image.put(crc >> 8);
+	image.put(crc & 0xFF);
+	image.flush();
+	return image.status;
+}
+
+
+///
+///
+///
+emb::EepromStatus History::load(emb::IEeprom& eeprom, emb::EepromAddr addr, unsigned int pageSize, uint64_t timeout_ms)
+{
+	clear();
+	EepromImage image(eeprom, addr, pageSize, timeout_ms);
+
+	char header[HISTORY_IMAGE_HEADER_SIZE];
+	image.get(header, HISTORY_IMAGE_HEADER_SIZE);
+	if (image.status != emb::EEPROM_SUCCESS) return image.status;
+
+	size_t count = header[2] & 0xFF;
+	size_t used = (header[3] & 0xFF) | ((header[4] & 0xFF) << 8);
+	if ((header[0] != HISTORY_IMAGE_MAGIC) || (header[1] != HISTORY_IMAGE_VERSION)
+			|| (count > CLI_HISTORY_LENGTH) || (used > CLI_HISTORY_BUFFER_SIZE))
+	{
+		return emb::EEPROM_READ_FAIL;
+	}
+
+	char entry[CLI_CMDLINE_MAX_LENGTH];
+	size_t loaded = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		char octet = 0;
+		image.get(&octet, 1);
+		size_t len = octet & 0xFF;
+		if ((len == 0) || (len > CLI_CMDLINE_MAX_LENGTH) || (loaded + len > used)) break;
+		image.get(entry, len);
+		if (image.status != emb::EEPROM_SUCCESS) break;
+		push(entry, len);
+		loaded += len;
+	}
+
+	uint16_t expectedCrc = image.crc;
+	char crc[2] = {0, 0};
+	image.get(crc, 2);
+	if (image.status != emb::EEPROM_SUCCESS)
+	{
+		clear();
+		return image.status;
+	}
+	if ((_count != count) || (loaded != used) || ((((crc[0] & 0xFF) << 8) | (crc[1] & 0xFF)) != expectedCrc))
+	{
+		clear();
+		return emb::EEPROM_READ_FAIL;
+	}
+	return emb::EEPROM_SUCCESS;
+}
+
+
+} // namespace cli
+
+
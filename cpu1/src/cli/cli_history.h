@@ -0,0 +1,172 @@
+/**
+ * @file cli_history.h
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cstring>
+#include "emb/emb_core.h"
+#include "emb/emb_eeprom.h"
+
+#include "cli_config.h"
+
+
+namespace cli {
+/// @addtogroup cli
+/// @{
+
+
+/**
+ * @brief Command history: entries are packed into char ring without terminators, index holds entry start offsets,
+ * entry length is distance to next entry start. Oldest entries are dropped when ring or index is full.
+ * Entries are addressed by age: 0 - newest. Access cost is proportional to entry length.
+ */
+class History
+{
+	EMB_STATIC_ASSERT(CLI_HISTORY_BUFFER_SIZE > CLI_CMDLINE_MAX_LENGTH);
+	EMB_STATIC_ASSERT(CLI_HISTORY_BUFFER_SIZE <= 0xFFFF);
+	EMB_STATIC_ASSERT(CLI_HISTORY_LENGTH <= 0xFF);
+private:
+	char _buf[CLI_HISTORY_BUFFER_SIZE];
+	uint16_t _offsets[CLI_HISTORY_LENGTH];
+	size_t _first;	// index slot of oldest entry
+	size_t _count;
+	size_t _head;	// start of next entry in ring
+	size_t _used;
+public:
+	History() { clear(); }
+
+	void clear()
+	{
+		_first = 0;
+		_count = 0;
+		_head = 0;
+		_used = 0;
+	}
+
+	size_t size() const { return _count; }
+	bool empty() const { return _count == 0; }
+	size_t used() const { return _used; }
+	static size_t capacity() { return CLI_HISTORY_LENGTH; }
+	static size_t bufferSize() { return CLI_HISTORY_BUFFER_SIZE; }
+
+	/**
+	 * @brief Adds newest entry, oldest entries are dropped to free space.
+	 * @param str - entry chars
+	 * @param len - number of chars
+	 * @return \c true on success, \c false if entry is empty or too long.
+	 */
+	bool push(const char* str, size_t len);
+
+	/**
+	 * @brief Returns entry length.
+	 * @param age - entry age, must be less than size()
+	 * @return Number of chars.
+	 */
+	size_t length(size_t age) const
+	{
+		size_t end = (age == 0) ? _head : _offsets[_slot(age - 1)];
+		return (end + CLI_HISTORY_BUFFER_SIZE - _offsets[_slot(age)]) % CLI_HISTORY_BUFFER_SIZE;
+	}
+
+	/**
+	 * @brief Copies entry chars, no terminator is added.
+	 * @param age - entry age, must be less than size()
+	 * @param dest - destination
+	 * @param size - destination size
+	 * @return Number of copied chars.
+	 */
+	size_t copy(size_t age, char* dest, size_t size) const;
+
+	/**
+	 * @brief Compares entry with string.
+	 * @param age - entry age, must be less than size()
+	 * @param str - string chars
+	 * @param len - number of chars
+	 * @return \c true if entry is equal to string.
+	 */
+	bool equals(size_t age, const char* str, size_t len) const
+	{
+		return (length(age) == len) && _startsWith(age, str, len);
+	}
+
+	/**
+	 * @brief Finds newest entry starting with prefix.
+	 * @param prefix - prefix chars, empty prefix matches any entry
+	 * @param len - number of chars
+	 * @param fromAge - age of first checked entry
+	 * @return Entry age, -1 if no entry is found.
+	 */
+	int find(const char* prefix, size_t len, size_t fromAge = 0) const
+	{
+		for (size_t age = fromAge; age < _count; ++age)
+		{
+			if ((length(age) >= len) && _startsWith(age, prefix, len))
+			{
+				return age;
+			}
+		}
+		return -1;
+	}
+
+	/**
+	 * @brief Saves history to EEPROM: header, entries from oldest to newest with length prefix, CRC-16.
+	 * Image takes up to imageMaxSize() octets from start address, pages are filled sequentially.
+	 * @param eeprom - EEPROM
+	 * @param addr - start address
+	 * @param pageSize - EEPROM page size
+	 * @param timeout_ms - timeout of one EEPROM operation
+	 * @return EEPROM status.
+	 */
+	emb::EepromStatus save(emb::IEeprom& eeprom, emb::EepromAddr addr, unsigned int pageSize, uint64_t timeout_ms) const;
+
+	/**
+	 * @brief Loads history saved by save(). Current entries are replaced.
+	 * @param eeprom - EEPROM
+	 * @param addr - start address
+	 * @param pageSize - EEPROM page size
+	 * @param timeout_ms - timeout of one EEPROM operation
+	 * @return EEPROM status, EEPROM_READ_FAIL if image is invalid: history is empty in this case.
+	 */
+	emb::EepromStatus load(emb::IEeprom& eeprom, emb::EepromAddr addr, unsigned int pageSize, uint64_t timeout_ms);
+
+	static size_t imageMaxSize() { return 5 + CLI_HISTORY_BUFFER_SIZE + CLI_HISTORY_LENGTH + 2; }
+private:
+	size_t _slot(size_t age) const { return (_first + _count - 1 - age) % CLI_HISTORY_LENGTH; }
+
+	bool _startsWith(size_t age, const char* str, size_t len) const
+	{
+		size_t pos = _offsets[_slot(age)];
+		for (size_t i = 0; i < len; ++i)
+		{
+			if (_buf[pos] != str[i]) return false;
+			if (++pos == CLI_HISTORY_BUFFER_SIZE) pos = 0;
+		}
+		return true;
+	}
+
+	void _dropOldest()
+	{
+		_used -= length(_count - 1);
+		_first = (_first + 1) % CLI_HISTORY_LENGTH;
+		--_count;
+	}
+};
+
+
+/// @}
+} // namespace cli
+
+
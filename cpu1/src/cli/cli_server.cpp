@@ -27,23 +27,33 @@ emb::gpio::IInput* Server::_pinCTS = static_cast<emb::gpio::IInput*>(NULL);
 
 char Server::_prompt[CLI_PROMPT_MAX_LENGTH] = {0};
 emb::String<CLI_CMDLINE_MAX_LENGTH> Server::_cmdline;
-emb::String<CLI_ESCSEQ_MAX_LENGTH> Server::_escseq;
+EscSeqDfa Server::_escDfa;
+const EscSeq* Server::_appEscSeqList = static_cast<const EscSeq*>(NULL);
+size_t Server::_appEscSeqCount = 0;
 
 size_t Server::_cursorPos = 0;
 
 emb::Queue<char, CLI_OUTBUT_BUFFER_LENGTH> Server::_outputBuf;
+emb::Queue<char, CLI_TYPEAHEAD_BUFFER_LENGTH> Server::_typeAhead;
+bool Server::_binaryMode = false;
 
 #ifdef CLI_USE_HISTORY
-emb::CircularBuffer<emb::String<CLI_CMDLINE_MAX_LENGTH>, CLI_HISTORY_LENGTH> Server::_history;
-size_t Server::_lastCmdHistoryPos = 0;
+History Server::_history;
 size_t Server::_historyPosition = 0;
-bool Server::_newCmdSaved = false;
+bool Server::_newCmdSaved = true;
+bool Server::_searchActive = false;
+bool Server::_searchFailed = false;
+emb::String<CLI_CMDLINE_MAX_LENGTH> Server::_searchPrefix;
+int Server::_searchMatch = -1;
 #endif
 
 int (*Server::_exec)(int argc, const char** argv) = Server::_execNull;
+const char* Server::_pendingArgv[CLI_TOKEN_MAX_COUNT];
+int Server::_pendingArgc = 0;
+int (*Server::_complete)(int argc, const char** argv, char* suffix, size_t suffixSize) = NULL;
 
 
-const Server::EscSeq Server::escSeqList[] = {
+const EscSeq Server::escSeqList[] = {
 {.str = "\x0D",		.len = 1,	.handler = Server::_escReturn},
 {.str = "\x0A",		.len = 1,	.handler = Server::_escReturn},
 {.str = CLI_ESC"[D",	.len = 3,	.handler = Server::_escMoveCursorLeft},
@@ -55,6 +65,29 @@ const Server::EscSeq Server::escSeqList[] = {
 {.str = CLI_ESC"[3~",	.len = 4,	.handler = Server::_escDel},
 {.str = CLI_ESC"[A",	.len = 3,	.handler = Server::_escUp},
 {.str = CLI_ESC"[B",	.len = 3,	.handler = Server::_escDown},
+// application cursor keys mode and vt220 home/end keys
+{.str = CLI_ESC"OD",	.len = 3,	.handler = Server::_escMoveCursorLeft},
+{.str = CLI_ESC"OC",	.len = 3,	.handler = Server::_escMoveCursorRight},
+{.str = CLI_ESC"OH",	.len = 3,	.handler = Server::_escHome},
+{.str = CLI_ESC"OF",	.len = 3,	.handler = Server::_escEnd},
+{.str = CLI_ESC"OA",	.len = 3,	.handler = Server::_escUp},
+{.str = CLI_ESC"OB",	.len = 3,	.handler = Server::_escDown},
+{.str = CLI_ESC"[1~",	.len = 4,	.handler = Server::_escHome},
+{.str = CLI_ESC"[4~",	.len = 4,	.handler = Server::_escEnd},
+// word motion: Ctrl-Left/Right, Alt-b/f
+{.str = CLI_ESC"[1;5D",	.len = 6,	.handler = Server::_escWordLeft},
+{.str = CLI_ESC"[1;5C",	.len = 6,	.handler = Server::_escWordRight},
+{.str = CLI_ESC"b",	.len = 2,	.handler = Server::_escWordLeft},
+{.str = CLI_ESC"f",	.len = 2,	.handler = Server::_escWordRight},
+// emacs-style line editing: Ctrl-A, Ctrl-E, Ctrl-K, Ctrl-U, Ctrl-W
+{.str = "\x01",		.len = 1,	.handler = Server::_escHome},
+{.str = "\x05",		.len = 1,	.handler = Server::_escEnd},
+{.str = "\x0B",		.len = 1,	.handler = Server::_escKillToEnd},
+{.str = "\x15",		.len = 1,	.handler = Server::_escKillToHome},
+{.str = "\x17",		.len = 1,	.handler = Server::_escKillWord},
+{.str = "\x09",		.len = 1,	.handler = Server::_escTab},
+// Ctrl-R: history search by prefix
+{.str = "\x12",		.len = 1,	.handler = Server::_escSearch},
 };
 
 const size_t ESCSEQ_LIST_SIZE = sizeof(Server::escSeqList) / sizeof(Server::escSeqList[0]);
@@ -74,6 +107,10 @@ Server::Server(const char* deviceName, emb::IUart* uart, emb::gpio::IOutput* pin
 	strncat(_prompt, deviceName, CLI_DEVICE_NAME_MAX_LENGTH);
 	strcat(_prompt, promptEnd);
 
+	bool compiled = _compileEscSeqBindings();
+	assert(compiled);	// core table fits CLI_ESCSEQ_MAX_STATES/CLASSES
+	(void)compiled;
+
 	_printPrompt();
 }
 
@@ -81,23 +118,107 @@ Server::Server(const char* deviceName, emb::IUart* uart, emb::gpio::IOutput* pin
 ///
 ///
 ///
-void Server::run()
+bool Server::registerEscSeqBindings(const EscSeq* bindings, size_t count)
+{
+	_appEscSeqList = bindings;
+	_appEscSeqCount = count;
+	if (_compileEscSeqBindings())
+	{
+		return true;
+	}
+
+	_appEscSeqList = static_cast<const EscSeq*>(NULL);
+	_appEscSeqCount = 0;
+	_compileEscSeqBindings();
+	return false;
+}
+
+
+///
+///
+///
+bool Server::_compileEscSeqBindings()
+{
+	_escDfa.clear();
+	return _escDfa.add(escSeqList, ESCSEQ_LIST_SIZE)
+			&& _escDfa.add(_appEscSeqList, _appEscSeqCount);
+}
+
+
+///
+///
+///
+bool Server::run()
 {
-	if (!_outputBuf.empty())
+	bool active = false;
+
+	// input is not blocked by pending output, suspended command is resumed when it can make progress
+	char ch;
+	if (_pendingArgc != 0)
 	{
-		if (_uart->send(_outputBuf.front()))
+		if (!_typeAhead.full() && _uart->recv(ch))
+		{
+			if (ch == CLI_INTERRUPT_CHAR)
+			{
+				_interruptExec();
+			}
+			else
+			{
+				_typeAhead.push(ch);
+			}
+			active = true;
+		}
+		if ((_pendingArgc != 0) && (_outputBuf.size() <= _outputBuf.capacity() / 2))
 		{
-			_outputBuf.pop();
+			// command waiting for data suspends without output: such call is not activity
+			size_t queued = _outputBuf.size();
+			_resumeExec();
+			active = active || (_outputBuf.size() != queued) || (_pendingArgc == 0);
 		}
 	}
-	else
+	else if (!_typeAhead.empty() && !_binaryMode)
+	{
+		_processChar(_typeAhead.front());
+		_typeAhead.pop();
+		active = true;
+	}
+	else if (!_typeAhead.empty() && BinaryProtocol::_ready())
+	{
+		BinaryProtocol::_processOctet(_typeAhead.front() & 0xFF);
+		_typeAhead.pop();
+		active = true;
+	}
+	else if (_binaryMode)
 	{
-		char ch;
-		if (_uart->recv(ch))
+		// request is taken only if its response fits into output buffer: host can pipeline requests
+		if (BinaryProtocol::_ready() && _uart->recv(ch))
 		{
-			_processChar(ch);
+			BinaryProtocol::_processOctet(ch & 0xFF);
+			active = true;
 		}
+		if (_binaryMode && BinaryProtocol::_runTelemetry())
+		{
+			active = true;
+		}
+	}
+	else if (_uart->recv(ch))
+	{
+		_processChar(ch);
+		active = true;
 	}
+
+	// output burst: pending chars up to free space in UART TX FIFO, the second span is sent if buffer is wrapped
+	for (size_t i = 0; (i < 2) && !_outputBuf.empty(); ++i)
+	{
+		size_t len = 0;
+		const char* span = _outputBuf.frontSpan(len);
+		int sent = _uart->sendNonBlocking(span, len);
+		if (sent <= 0) break;
+		_outputBuf.pop(sent);
+		active = true;
+		if (static_cast<size_t>(sent) < len) break;
+	}
+	return active;
 }
 
 
@@ -139,82 +260,103 @@ void Server::_printBlocking(const char* str)
 ///
 void Server::_processChar(char ch)
 {
-	if (_cmdline.full())
+#ifdef CLI_USE_HISTORY
+	if (_searchActive)
+	{
+		_processSearchChar(ch);
 		return;
+	}
+#endif
 
-	if (_escseq.empty())
+	if (_escDfa.idle() && !EscSeqDfa::isControl(ch))
 	{
-		// Check escape signature
-		if (ch <= 0x1F || ch == 0x7F)
-		{
-			_escseq.push_back(ch);
-		}
-		// Print symbol if escape sequence signature is not found
-		if (_escseq.empty())
+		_insertChar(ch);
+		return;
+	}
+
+	// Process escape sequence: one DFA transition per char
+	bool continued = !_escDfa.idle();
+	switch (_escDfa.step(ch))
+	{
+	case EscSeqDfa::Pending:
+		break;
+	case EscSeqDfa::Matched:
+		_escDfa.handler()();
+		break;
+	case EscSeqDfa::Rejected:
+		// unknown sequence is discarded, control char that breaks it starts new sequence
+		if (continued && EscSeqDfa::isControl(ch) && (_escDfa.step(ch) == EscSeqDfa::Matched))
 		{
-			if (_cursorPos < _cmdline.lenght())
-			{
-				_cmdline.insert(_cursorPos, ch);
-				_saveCursorPos();
-				print(_cmdline.begin() + _cursorPos);
-				_loadCursorPos();
-			}
-			else
-			{
-				_cmdline.push_back(ch);
-			}
-			_print(ch);
-			++_cursorPos;
+			_escDfa.handler()();
 		}
+		break;
 	}
-	else
+}
+
+
+///
+///
+///
+void Server::_resumeExec()
+{
+	out.resume();
+	if (_exec(_pendingArgc, _pendingArgv) != EXEC_PENDING)
 	{
-		_escseq.push_back(ch);
+		_pendingArgc = 0;
+		out.restart();
+		_printPrompt();
 	}
+}
 
-	// Process escape sequence
-	if (!_escseq.empty())
-	{
-		int possibleEscseqCount = 0;
-		size_t escseqIdx = 0;
-		for (size_t i = 0; i < ESCSEQ_LIST_SIZE; ++i)
-		{
-			if ((_escseq.lenght() <= escSeqList[i].len)
-					&& (strncmp(_escseq.data(), escSeqList[i].str, _escseq.lenght()) == 0))
-			{
-				++possibleEscseqCount;
-				escseqIdx = i;
-			}
-		}
 
-		switch (possibleEscseqCount)
-		{
-		case 0: // no sequence - display all symbols
-			/*for (size_t i = 0; (i < m_escseq.lenght()) && (!m_cmdline.full()); ++i)
-			{
-				if (m_escseq[i] <= 0x1F || m_escseq[i] == 0x7F)
-				{
-					m_escseq[i] = '?';
-				}
-				m_cmdline.insert(m_cursorPos + i, m_escseq[i]);
-			}
-			print(m_cmdline.begin() + m_cursorPos);
-			m_cursorPos += m_escseq.lenght();*/
-			_escseq.clear();
-			break;
+///
+///
+///
+void Server::_interruptExec()
+{
+	out.cancel();
+	_exec(_pendingArgc, _pendingArgv);
+	_pendingArgc = 0;
+	_typeAhead.clear();
+	out.restart();
+	print("^C");
+	_printPrompt();
+}
 
-		case 1: // one possible sequence found - check size and call handler
-			if (_escseq.lenght() == escSeqList[escseqIdx].len)
-			{
-				_escseq.clear();
-				escSeqList[escseqIdx].handler();
-			}
-			break;
 
-		default: // few possible sequences found
-			break;
-		}
+///
+///
+///
+void Server::_insertChar(char ch)
+{
+	if (_cmdline.full())
+		return;		// control chars are still processed, so full command line can be executed or edited
+
+	if (_cursorPos < _cmdline.lenght())
+	{
+		_cmdline.insert(_cursorPos, ch);
+		_saveCursorPos();
+		print(_cmdline.begin() + _cursorPos);
+		_loadCursorPos();
+	}
+	else
+	{
+		_cmdline.push_back(ch);
 	}
+	_print(ch);
+	++_cursorPos;
+}
+
+
+///
+///
+///
+void Server::_redrawLine()
+{
+	print(CLI_ENDL);
+	print(_prompt);
+	print(_cmdline.data());
+	_moveCursor(int(_cursorPos) - int(_cmdline.lenght()));
 }
 
 
@@ -297,24 +439,14 @@ int Server::_tokenize(const char** argv, emb::String<CLI_CMDLINE_MAX_LENGTH>& cm
 ///
 void Server::_searchHistory(HistorySearchDirection dir)
 {
-	static size_t pos;
-
+	size_t count = _history.size();
 	switch (dir)
 	{
 	case CLI_HISTORY_SEARCH_UP:
-		if (_newCmdSaved)
-		{
-			pos = _historyPosition;
-		}
-		else
-		{
-			_historyPosition = (_historyPosition + (_history.size() - 1)) % _history.size();
-			pos = _historyPosition;
-		}
+		_historyPosition = _newCmdSaved ? 0 : (_historyPosition + 1) % count;
 		break;
 	case CLI_HISTORY_SEARCH_DOWN:
-		_historyPosition = (_historyPosition + 1) % _history.size();
-		pos = _historyPosition;
+		_historyPosition = _newCmdSaved ? count - 1 : (_historyPosition + count - 1) % count;
 		break;
 	}
 
@@ -327,10 +459,9 @@ void Server::_searchHistory(HistorySearchDirection dir)
 		_cursorPos = 0;
 	}
 
-	int remainder = _cmdline.size() - _history.data()[pos].size();
-	_cmdline = _history.data()[pos];
+	int remainder = _cmdline.size() - _history.length(_historyPosition);
+	_recallHistory(_historyPosition);
 	print(_cmdline.data());
-	_cursorPos = _cmdline.size();
 
 	// clear remaining symbols
 	_saveCursorPos();
@@ -340,6 +471,101 @@ void Server::_searchHistory(HistorySearchDirection dir)
 	}
 	_loadCursorPos();
 }
+
+
+///
+///
+///
+void Server::_recallHistory(size_t age)
+{
+	size_t len = _history.length(age);
+	_cmdline.resize(len);	// chars after entry are zeroed, command line stays terminated
+	_history.copy(age, _cmdline.begin(), len);
+	_cursorPos = len;
+}
+
+
+///
+///
+///
+void Server::_processSearchChar(char ch)
+{
+	switch (ch)
+	{
+	case '\x12':		// Ctrl-R: next older match
+		{
+			int match = _history.find(_searchPrefix.data(), _searchPrefix.size(), (_searchMatch >= 0) ? _searchMatch + 1 : 0);
+			if (match >= 0) _searchMatch = match;
+		}
+		break;
+	case '\x08':
+	case '\x7F':
+		if (_searchPrefix.empty()) return;
+		_searchPrefix.pop_back();
+		_searchMatch = _history.find(_searchPrefix.data(), _searchPrefix.size());
+		break;
+	case CLI_SEARCH_CANCEL_CHAR:
+	case CLI_INTERRUPT_CHAR:
+		_exitSearch(false);
+		return;
+	default:
+		if (EscSeqDfa::isControl(ch))
+		{
+			// any other key accepts match and is processed as usual, e.g. Return executes it
+			_exitSearch(true);
+			_processChar(ch);
+			return;
+		}
+		if (_searchPrefix.full()) return;
+		_searchPrefix.push_back(ch);
+		{
+			int match = _history.find(_searchPrefix.data(), _searchPrefix.size(), (_searchMatch >= 0) ? _searchMatch : 0);
+			if (match >= 0) _searchMatch = match;
+			_searchFailed = (match < 0);
+		}
+		_redrawSearch();
+		return;
+	}
+	_searchFailed = (_searchMatch < 0) && !_searchPrefix.empty();
+	_redrawSearch();
+}
+
+
+///
+///
+///
+void Server::_redrawSearch()
+{
+	print("\r" CLI_ESC"[K");
+	print(_searchFailed ? "(failed reverse-i-search)`" : "(reverse-i-search)`");
+	print(_searchPrefix.data());
+	print("': ");
+	if (_searchMatch >= 0)
+	{
+		char entry[CLI_CMDLINE_MAX_LENGTH + 1];
+		entry[_history.copy(_searchMatch, entry, CLI_CMDLINE_MAX_LENGTH)] = '\0';
+		print(entry);
+	}
+}
+
+
+///
+///
+///
+void Server::_exitSearch(bool accept)
+{
+	_searchActive = false;
+	if (accept && (_searchMatch >= 0))
+	{
+		_recallHistory(_searchMatch);
+		_historyPosition = _searchMatch;
+		_newCmdSaved = false;
+	}
+	_cursorPos = _cmdline.size();
+	print("\r" CLI_ESC"[K");
+	print(_prompt);
+	print(_cmdline.data());
+}
 #endif
 
 
@@ -20,9 +20,12 @@
 #include "emb/emb_interfaces/emb_gpio.h"
 #include "emb/emb_queue.h"
 #include "emb/emb_string.h"
-#include "emb/emb_circularbuffer.h"
 
 #include "cli_config.h"
+#include "cli_escseqdfa.h"
+#include "cli_stream.h"
+#include "cli_history.h"
+#include "binproto/binproto.h"
 
 
 namespace cli {
@@ -37,6 +40,8 @@ class Server
 {
 	friend void print(const char* str);
 	friend void print_blocking(const char* str);
+	friend class Stream;
+	friend class BinaryProtocol;
 private:
 	static emb::IUart* _uart;
 	static emb::gpio::IOutput* _pinRTS;
@@ -44,17 +49,24 @@ private:
 
 	static char _prompt[CLI_PROMPT_MAX_LENGTH];
 	static emb::String<CLI_CMDLINE_MAX_LENGTH> _cmdline;
-	static emb::String<CLI_ESCSEQ_MAX_LENGTH> _escseq;
+	static EscSeqDfa _escDfa;
+	static const EscSeq* _appEscSeqList;
+	static size_t _appEscSeqCount;
 
 	static size_t _cursorPos;
 
 	static emb::Queue<char, CLI_OUTBUT_BUFFER_LENGTH> _outputBuf;
+	static emb::Queue<char, CLI_TYPEAHEAD_BUFFER_LENGTH> _typeAhead;
+	static bool _binaryMode;	// input is processed by BinaryProtocol
 
 #ifdef CLI_USE_HISTORY
-	static emb::CircularBuffer<emb::String<CLI_CMDLINE_MAX_LENGTH>, CLI_HISTORY_LENGTH> _history;
-	static size_t _lastCmdHistoryPos;
-	static size_t _historyPosition;
+	static History _history;
+	static size_t _historyPosition;	// age of recalled entry
 	static bool _newCmdSaved;
+	static bool _searchActive;	// Ctrl-R search: input edits search prefix
+	static bool _searchFailed;
+	static emb::String<CLI_CMDLINE_MAX_LENGTH> _searchPrefix;
+	static int _searchMatch;	// age of matched entry, -1 - no match
 #endif
 
 private:
@@ -63,12 +75,51 @@ private:
 public:
 	Server(const char* deviceName, emb::IUart* uart, emb::gpio::IOutput* pinRTS, emb::gpio::IInput* pinCTS);
 
-	void run();
+	/**
+	 * @brief Processes one received char and sends pending output up to free space in UART TX FIFO.
+	 * Suspended command is resumed when output buffer is half drained, input is read ahead until command
+	 * is completed (the rest is kept in UART), Ctrl-C interrupts command. In binary mode input is passed to BinaryProtocol
+	 * and telemetry is sampled.
+	 * @param (none)
+	 * @return \c true if chars were sent or received, \c false if server is idle or UART is busy.
+	 */
+	bool run();
 	void registerExecCallback(int (*exec_)(int argc, const char** argv))
 	{
 		_exec = exec_;
 	}
 
+	/**
+	 * @brief Registers Tab completion callback. Callback gets tokens before cursor, last token is incomplete
+	 * (empty if cursor is after whitespace), writes chars to be inserted at cursor to suffix and returns number
+	 * of candidates. If there are several candidates and suffix is empty, callback prints them
+	 * and server redraws command line.
+	 * @param complete_ - completion callback
+	 * @return (none)
+	 */
+	void registerCompletionCallback(int (*complete_)(int argc, const char** argv, char* suffix, size_t suffixSize))
+	{
+		_complete = complete_;
+	}
+
+	/**
+	 * @brief Adds application escape sequence bindings to core ones, application binding overrides core binding
+	 * with the same sequence. Bindings are compiled into DFA, table must outlive server.
+	 * @param bindings - binding table
+	 * @param count - number of bindings
+	 * @return \c true on success, \c false if table is invalid: core bindings remain active in this case.
+	 */
+	static bool registerEscSeqBindings(const EscSeq* bindings, size_t count);
+
+#ifdef CLI_USE_HISTORY
+	/**
+	 * @brief Returns command history, e.g. to save it to EEPROM or to load it at startup.
+	 * @param (none)
+	 * @return Command history.
+	 */
+	static History& history() { return _history; }
+#endif
+
 private:
 	static void _print(char ch);
 	static void _print(const char* str);
@@ -77,17 +128,25 @@ private:
 	static void _processChar(char ch);
 	static void _saveCursorPos() { _print(CLI_ESC"[s"); }
 	static void _loadCursorPos() { _print(CLI_ESC"[u"); }
+	static void _insertChar(char ch);
+	static void _redrawLine();
 	static void _moveCursor(int offset);
+	static void _eraseBeforeCursor(size_t count);
 	static void _printWelcome();
 	static void _printPrompt();
 	static int _tokenize(const char** argv, emb::String<CLI_CMDLINE_MAX_LENGTH>& cmdline);
 
 	static int (*_exec)(int argc, const char** argv);
+	static const char* _pendingArgv[CLI_TOKEN_MAX_COUNT];
+	static int _pendingArgc;	// arguments of suspended command, 0 - no suspended command
+	static void _resumeExec();
+	static void _interruptExec();
+	static int (*_complete)(int argc, const char** argv, char* suffix, size_t suffixSize);
 	static int _execNull(int argc, const char** argv)
 	{
 		_print(CLI_ENDL"error: exec-callback not registered");
 		_print(CLI_ENDL"tokens:");
-		for (size_t i= 0; i < argc; ++i)
+		for (int i = 0; i < argc; ++i)
 		{
 			_print(CLI_ENDL);
 			_print(argv[i]);
@@ -96,17 +155,9 @@ private:
 	}
 
 public:
-	/**
-	 * @brief
-	 */
-	struct EscSeq
-	{
-		const char* str;
-		size_t len;
-		void (*handler)();
-	};
 	static const EscSeq escSeqList[];
 private:
+	static bool _compileEscSeqBindings();
 	static void _escReturn();
 	static void _escMoveCursorLeft();
 	static void _escMoveCursorRight();
@@ -116,6 +167,13 @@ private:
 	static void _escDel();
 	static void _escUp();
 	static void _escDown();
+	static void _escWordLeft();
+	static void _escWordRight();
+	static void _escKillToEnd();
+	static void _escKillToHome();
+	static void _escKillWord();
+	static void _escTab();
+	static void _escSearch();
 
 private:
 #ifdef CLI_USE_HISTORY
@@ -125,6 +183,10 @@ private:
 		CLI_HISTORY_SEARCH_DOWN,
 	};
 	static void _searchHistory(HistorySearchDirection dir);
+	static void _recallHistory(size_t age);
+	static void _processSearchChar(char ch);
+	static void _redrawSearch();
+	static void _exitSearch(bool accept);
 #endif
 };
 
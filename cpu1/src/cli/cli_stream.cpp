@@ -0,0 +1,285 @@
+/**
+ * @file cli_stream.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "cli_stream.h"
+#include "cli_server.h"
+#include <float.h>
+
+
+namespace cli {
+
+
+Stream out;
+
+
+namespace {
+
+
+/// Scale of fixed-point field by number of decimals
+const uint32_t fixedScales[7] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+
+} // namespace
+
+
+///
+///
+///
+void Stream::_put(char ch)
+{
+	if (_interrupted) return;
+	if (Server::_outputBuf.full())
+	{
+		++_dropped;
+		return;
+	}
+	Server::_outputBuf.push(ch);
+}
+
+
+///
+///
+///
+bool Stream::fits(size_t len) const
+{
+	return !_interrupted && available() >= len;
+}
+
+
+///
+///
+///
+size_t Stream::available() const
+{
+	return Server::_outputBuf.capacity() - Server::_outputBuf.size();
+}
+
+
+///
+///
+///
+Stream& Stream::operator<<(const char* str)
+{
+	while (*str != '\0')
+	{
+		_put(*str++);
+	}
+	return *this;
+}
+
+
+///
+///
+///
+void Stream::_putDigits(uint32_t value, bool negative, uint16_t width, char fill, uint16_t minDigits)
+{
+	char digits[10];
+	size_t len = 0;
+	do
+	{
+		digits[len++] = '0' + (value % 10);
+		value /= 10;
+	} while (value != 0);
+	while (len < minDigits)
+	{
+		digits[len++] = '0';
+	}
+
+	size_t fieldLen = len + (negative ? 1 : 0);
+	if (fill == '0')
+	{
+		if (negative) _put('-');
+		if (width > fieldLen) _pad('0', width - fieldLen);
+	}
+	else
+	{
+		if (width > fieldLen) _pad(fill, width - fieldLen);
+		if (negative) _put('-');
+	}
+
+	while (len != 0)
+	{
+		_put(digits[--len]);
+	}
+}
+
+
+///
+///
+///
+Stream& Stream::operator<<(const Dec& field)
+{
+	_putDigits(field.value, field.negative, field.width, field.fill);
+	return *this;
+}
+
+
+///
+///
+///
+Stream& Stream::operator<<(unsigned long long value)
+{
+	// 9-digit groups: one 64-bit division per group instead of per digit
+	const uint32_t group = 1000000000;
+	if (value < group)
+	{
+		return *this << dec(static_cast<uint32_t>(value));
+	}
+
+	uint32_t low = static_cast<uint32_t>(value % group);
+	*this << static_cast<unsigned long long>(value / group);
+	_putDigits(low, false, 0, ' ', 9);
+	return *this;
+}
+
+
+///
+///
+///
+Stream& Stream::operator<<(const Hex& field)
+{
+	static const char symbols[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+	for (int i = field.digits - 1; i >= 0; --i)
+	{
+		_put(symbols[(field.value >> (4 * i)) & 0xF]);
+	}
+	return *this;
+}
+
+
+///
+///
+///
+Stream& Stream::operator<<(const Fixed& field)
+{
+	uint16_t decimals = (field.decimals < 7) ? field.decimals : 6;
+	float value = field.value;
+
+	if (value != value)
+	{
+		return *this << right("nan", field.width);
+	}
+
+	bool negative = (value < 0);
+	if (negative) value = -value;
+
+	if (value > FLT_MAX)
+	{
+		return *this << right(negative ? "-inf" : "inf", field.width);
+	}
+
+	uint16_t fracLen = (decimals != 0) ? (decimals + 1) : 0;
+	uint16_t intWidth = (field.width > fracLen) ? (field.width - fracLen) : 0;
+
+	float scaled = value * fixedScales[decimals] + 0.5f;
+	if (scaled >= 4294967040.f)	// largest float below 2^32: scaled value does not fit 32 bits
+	{
+		_putLargeFixed(value, negative, decimals, intWidth);
+		return *this;
+	}
+
+	uint32_t units = static_cast<uint32_t>(scaled);
+	uint32_t intPart = units / fixedScales[decimals];
+	uint32_t fracPart = units % fixedScales[decimals];
+	negative = negative && (units != 0);
+
+	_putDigits(intPart, negative, intWidth, ' ');
+	if (decimals != 0)
+	{
+		_put('.');
+		_putDigits(fracPart, false, 0, ' ', decimals);
+	}
+	return *this;
+}
+
+
+///
+///
+///
+void Stream::_putLargeFixed(float value, bool negative, uint16_t decimals, uint16_t intWidth)
+{
+	const uint32_t group = 1000000000;
+
+	// integer part beyond two 9-digit groups - exponent notation, mantissa in [1, 10)
+	uint32_t exponent = 0;
+	if (value >= 1e18f)
+	{
+		while (value >= 10.f)
+		{
+			value /= 10.f;
+			++exponent;
+		}
+		if (value * fixedScales[decimals] + 0.5f >= 10.f * fixedScales[decimals])	// mantissa is rounded up to 10
+		{
+			value /= 10.f;
+			++exponent;
+		}
+		intWidth = (intWidth > 4) ? (intWidth - 4) : 0;
+		uint32_t units = static_cast<uint32_t>(value * fixedScales[decimals] + 0.5f);
+		_putDigits(units / fixedScales[decimals], negative, intWidth, ' ');
+		if (decimals != 0)
+		{
+			_put('.');
+			_putDigits(units % fixedScales[decimals], false, 0, ' ', decimals);
+		}
+		_put('e');
+		_put('+');
+		_putDigits(exponent, false, 0, ' ', 2);
+		return;
+	}
+
+	// integer and fractional parts separately: fraction is exact, float above 2^24 has no fraction
+	uint64_t intPart = static_cast<uint64_t>(value);
+	uint32_t fracPart = static_cast<uint32_t>((value - static_cast<float>(intPart)) * fixedScales[decimals] + 0.5f);
+	if (fracPart >= fixedScales[decimals])
+	{
+		fracPart -= fixedScales[decimals];
+		++intPart;
+	}
+
+	uint32_t high = static_cast<uint32_t>(intPart / group);
+	uint32_t low = static_cast<uint32_t>(intPart % group);
+	if (high != 0)
+	{
+		_putDigits(high, negative, (intWidth > 9) ? (intWidth - 9) : 0, ' ');
+		_putDigits(low, false, 0, ' ', 9);
+	}
+	else
+	{
+		_putDigits(low, negative, intWidth, ' ');
+	}
+	if (decimals != 0)
+	{
+		_put('.');
+		_putDigits(fracPart, false, 0, ' ', decimals);
+	}
+}
+
+
+///
+///
+///
+Stream& Stream::operator<<(const Field& field)
+{
+	size_t len = strlen(field.str);
+	size_t width = (field.width < 0) ? -field.width : field.width;
+	if ((field.width > 0) && (width > len)) _pad(' ', width - len);
+	*this << field.str;
+	if ((field.width < 0) && (width > len)) _pad(' ', width - len);
+	return *this;
+}
+
+
+} // namespace cli
+
+
@@ -0,0 +1,185 @@
+/**
+ * @file cli_stream.h
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "cli_config.h"
+
+
+namespace cli {
+/// @addtogroup cli
+/// @{
+
+
+/// Exec-callback result: command is suspended by Stream::suspend() and is called again with the same arguments
+/// when output buffer is drained. Ctrl-C interrupts suspended command: it is called last time with muted stream
+/// and Stream::interrupted() set, so it can release resources.
+const int EXEC_PENDING = 1;
+
+
+/// Decimal integer field.
+struct Dec
+{
+	uint32_t value;
+	bool negative;
+	uint16_t width;
+	char fill;
+};
+
+
+/// Hexadecimal integer field, uppercase, zero padded.
+struct Hex
+{
+	uint32_t value;
+	uint16_t digits;
+};
+
+
+/// Fixed-point field of float value.
+struct Fixed
+{
+	float value;
+	uint16_t decimals;
+	uint16_t width;
+};
+
+
+/// String field, negative width - left-justified.
+struct Field
+{
+	const char* str;
+	int16_t width;
+};
+
+
+template <typename T>
+inline Dec dec(T value, uint16_t width = 0, char fill = ' ')
+{
+	Dec field;
+	field.negative = (value < static_cast<T>(0));
+	field.value = field.negative ? (0u - static_cast<uint32_t>(value)) : static_cast<uint32_t>(value);
+	field.width = width;
+	field.fill = fill;
+	return field;
+}
+
+
+inline Hex hex(uint32_t value, uint16_t digits) { Hex field = {value, digits}; return field; }
+inline Hex hex8(uint32_t value) { return hex(value, 2); }
+inline Hex hex16(uint32_t value) { return hex(value, 4); }
+inline Hex hex32(uint32_t value) { return hex(value, 8); }
+inline Fixed fixed(float value, uint16_t decimals, uint16_t width = 0) { Fixed field = {value, decimals, width}; return field; }
+inline Field left(const char* str, uint16_t width) { Field field = {str, static_cast<int16_t>(-width)}; return field; }
+inline Field right(const char* str, uint16_t width) { Field field = {str, static_cast<int16_t>(width)}; return field; }
+
+
+/**
+ * @brief CLI output stream: formats values straight into server output buffer without printf runtime.
+ * Commands with unbounded output check fits() before each line and return suspend() if line does not fit:
+ * server calls command again with the same arguments when output buffer is drained, resumed() and resumePoint()
+ * tell where to continue. Command that waits for data (e.g. periodic sampler) suspends without output:
+ * server does not count such call as activity.
+ */
+class Stream
+{
+private:
+	uint32_t _resumePoint;
+	bool _resumed;
+	bool _interrupted;
+	uint32_t _dropped;
+public:
+	Stream()
+		: _resumePoint(0)
+		, _resumed(false)
+		, _interrupted(false)
+		, _dropped(0)
+	{}
+
+	Stream& operator<<(char ch) { _put(ch); return *this; }
+	Stream& operator<<(const char* str);
+	Stream& operator<<(int value) { return *this << dec(value); }
+	Stream& operator<<(unsigned int value) { return *this << dec(value); }
+	Stream& operator<<(long value) { return *this << dec(value); }
+	Stream& operator<<(unsigned long value) { return *this << dec(value); }
+	Stream& operator<<(unsigned long long value);
+	Stream& operator<<(const Dec& field);
+	Stream& operator<<(const Hex& field);
+	Stream& operator<<(const Fixed& field);
+	Stream& operator<<(const Field& field);
+
+	/**
+	 * @brief Checks free space in output buffer.
+	 * @param len - number of chars
+	 * @return \c true if len chars can be written without loss.
+	 */
+	bool fits(size_t len) const;
+	size_t available() const;
+
+	/**
+	 * @brief Suspends command until output buffer is drained.
+	 * @param resumePoint - command-defined point to continue from, e.g. table row
+	 * @return EXEC_PENDING, to be returned from command.
+	 */
+	int suspend(uint32_t resumePoint)
+	{
+		_resumePoint = resumePoint;
+		return EXEC_PENDING;
+	}
+
+	/// \c false on first call of command, \c true on resumed call.
+	bool resumed() const { return _resumed; }
+	/// 0 on first call of command, value passed to suspend() on resumed call.
+	uint32_t resumePoint() const { return _resumePoint; }
+	/// \c true on the last call of interrupted command: output is discarded, fits() is \c false.
+	bool interrupted() const { return _interrupted; }
+
+	/// Called by server before first call of command.
+	void restart()
+	{
+		_resumePoint = 0;
+		_resumed = false;
+		_interrupted = false;
+	}
+	/// Called by server before resumed call of command.
+	void resume() { _resumed = true; }
+	/// Called by server before the last call of interrupted command.
+	void cancel()
+	{
+		_resumed = true;
+		_interrupted = true;
+	}
+
+	/// Number of chars lost because output buffer was full.
+	uint32_t dropped() const { return _dropped; }
+private:
+	void _put(char ch);
+	void _pad(char fill, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i) _put(fill);
+	}
+	void _putDigits(uint32_t value, bool negative, uint16_t width, char fill, uint16_t minDigits = 1);
+	void _putLargeFixed(float value, bool negative, uint16_t decimals, uint16_t intWidth);
+};
+
+
+extern Stream out;
+
+
+/// @}
+} // namespace cli
+
+
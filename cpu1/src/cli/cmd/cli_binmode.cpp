@@ -0,0 +1,34 @@
+/**
+ * @file cli_binmode.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "cli/shell/cli_shell.h"
+#include "cli/binproto/binproto.h"
+
+
+int cli_binmode(int argc, const char** argv)
+{
+	if (argc != 0)
+	{
+		cli::nextline();
+		cli::out << "binmode: invalid option - \"" << argv[0] << "\"";
+		return -1;
+	}
+
+	cli::nextline();
+	cli::out << "binmode: binary protocol v" << CLI_BINPROTO_VERSION << ", " << sys::VarRegistry::count()
+			<< " variables, Exit request returns to shell";
+	cli::BinaryProtocol::enter();
+	return 0;
+}
+
+
@@ -0,0 +1,85 @@
+/**
+ * @file cli_history.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "cli/shell/cli_shell.h"
+
+
+/// Max length of history line with line break, command is suspended if line does not fit CLI output buffer.
+const size_t CLI_HISTORY_LINE_LENGTH = CLI_CMDLINE_MAX_LENGTH + 8;
+
+
+namespace {
+
+
+/*===== CLEAR =====*/
+int clear(int argc, const char** argv)
+{
+	if (argc != 0)
+	{
+		cli::out << CLI_ENDL << "history-clear: invalid options";
+		return -1;
+	}
+#ifdef CLI_USE_HISTORY
+	cli::Server::history().clear();
+	cli::out << CLI_ENDL << "History cleared.";
+#else
+	cli::out << CLI_ENDL << "History disabled.";
+#endif
+	return 0;
+}
+
+
+} // namespace
+
+
+extern const cli::Cmd cli_history_subcommands[] =
+{
+{"clear",		clear,		"Clears command history."},
+};
+
+extern const size_t cli_history_subcommandCount = sizeof(cli_history_subcommands) / sizeof(cli_history_subcommands[0]);
+
+
+/// Prints history, called if subcommand is not specified or not found.
+int cli_history(int argc, const char** argv)
+{
+	if (argc > 0)
+	{
+		cli::out << CLI_ENDL << "history: invalid option - \"" << argv[0] << "\"";
+		return -1;
+	}
+
+#ifdef CLI_USE_HISTORY
+	cli::History& history = cli::Server::history();
+
+	// oldest entry first, entry number is stable while command is suspended: current command is already saved
+	for (uint32_t i = cli::out.resumePoint(); i < history.size(); ++i)
+	{
+		if (!cli::out.fits(CLI_HISTORY_LINE_LENGTH)) return cli::out.suspend(i);
+
+		char entry[CLI_CMDLINE_MAX_LENGTH + 1];
+		entry[history.copy(history.size() - 1 - i, entry, CLI_CMDLINE_MAX_LENGTH)] = '\0';
+		cli::out << CLI_ENDL << cli::dec(i + 1, 4) << "  " << entry;
+	}
+
+	if (!cli::out.fits(CLI_HISTORY_LINE_LENGTH)) return cli::out.suspend(history.size());
+	cli::out << CLI_ENDL << history.size() << '/' << history.capacity() << " entries, "
+			<< history.used() << '/' << history.bufferSize() << " chars";
+	return 0;
+#else
+	cli::out << CLI_ENDL << "History disabled.";
+	return 0;
+#endif
+}
+
+
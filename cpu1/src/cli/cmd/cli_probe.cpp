@@ -0,0 +1,113 @@
+/**
+ * @file cli_probe.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "cli/shell/cli_shell.h"
+
+#include "emb/emb_profiler/emb_probes.h"
+
+
+/// Max length of probe list line with line break, command is suspended if line does not fit CLI output buffer.
+const size_t CLI_PROBE_LINE_LENGTH = 40;
+
+
+namespace {
+
+
+/*===== ENABLE/DISABLE =====*/
+int setProbes(const char* subcmd, bool enable, int argc, const char** argv)
+{
+	if (argc != 1)
+	{
+		cli::out << CLI_ENDL << "probe-" << subcmd << ": invalid options";
+		return -1;
+	}
+
+	if (strcmp(argv[0], "all") == 0)
+	{
+		if (enable)
+		{
+			emb::ProbeRegistry::enableAll();
+		}
+		else
+		{
+			emb::ProbeRegistry::disableAll();
+		}
+		cli::out << CLI_ENDL << "All probes " << (enable ? "enabled" : "disabled") << '.';
+		return 0;
+	}
+
+	emb::Probe probe;
+	if (!emb::ProbeRegistry::find(argv[0], probe))
+	{
+		cli::out << CLI_ENDL << "probe-" << subcmd << ": unknown probe - \"" << argv[0] << "\"";
+		return -1;
+	}
+
+	if (enable)
+	{
+		emb::ProbeRegistry::enable(probe);
+	}
+	else
+	{
+		emb::ProbeRegistry::disable(probe);
+	}
+	cli::out << CLI_ENDL << "Probe " << argv[0] << ' ' << (enable ? "enabled" : "disabled") << '.';
+	return 0;
+}
+
+
+int enable(int argc, const char** argv)
+{
+	return setProbes("enable", true, argc, argv);
+}
+
+
+int disable(int argc, const char** argv)
+{
+	return setProbes("disable", false, argc, argv);
+}
+
+
+} // namespace
+
+
+extern const cli::Cmd cli_probe_subcommands[] =
+{
+{"disable",		disable,		"Disables probe: disable <name|all>."},
+{"enable",		enable,		"Enables probe: enable <name|all>."},
+};
+
+extern const size_t cli_probe_subcommandCount = sizeof(cli_probe_subcommands) / sizeof(cli_probe_subcommands[0]);
+
+
+/// Prints probe list, called if subcommand is not specified or not found.
+int cli_probe(int argc, const char** argv)
+{
+	if (argc > 0)
+	{
+		cli::out << CLI_ENDL << "probe: invalid option - \"" << argv[0] << "\"";
+		return -1;
+	}
+
+	/*===== LIST =====*/
+	for (uint32_t i = cli::out.resumePoint(); i < emb::ProbeRegistry::count(); ++i)
+	{
+		if (!cli::out.fits(CLI_PROBE_LINE_LENGTH)) return cli::out.suspend(i);
+		emb::Probe probe = static_cast<emb::Probe::enum_type>(i);
+		cli::out << CLI_ENDL << "probe " << i << ' ' << emb::ProbeRegistry::name(probe) << ' '
+				<< (emb::ProbeRegistry::enabled(probe) ? "on" : "off");
+	}
+	return 0;
+}
+
+
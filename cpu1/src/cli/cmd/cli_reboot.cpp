@@ -11,9 +11,6 @@
  */
 
 
-#pragma once
-
-
 #include "cli/shell/cli_shell.h"
 
 #include "mcu_f2837xd/chrono/mcu_chrono.h"
@@ -39,8 +36,7 @@ int cli_reboot(int argc, const char** argv)
 
 	uint64_t msec = 1000 * atoll(argv[0]);
 	mcu::chrono::SystemClock::registerDelayedTask(mcu::resetDevice, msec);
-	snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "Device will reboot in %llu seconds...", msec / 1000);
-	cli::print(CLI_CMD_OUTPUT);
+	cli::out << "Device will reboot in " << static_cast<unsigned long long>(msec / 1000) << " seconds...";
 	return 0;
 }
 
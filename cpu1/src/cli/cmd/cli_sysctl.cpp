@@ -11,44 +11,48 @@
  */
 
 
-#pragma once
-
-
 #include "cli/shell/cli_shell.h"
 
 
 //#include ""
 
 
-int cli_sysctl(int argc, const char** argv)
+namespace {
+
+
+int startup(int argc, const char** argv)
+{
+	//fuelcell::Converter::instance()->startup();
+	//cli::out << CLI_ENDL << "Charger startup...";
+	return 0;
+}
+
+
+int shutdown(int argc, const char** argv)
 {
-	if (argc == 0)
-	{
-		strncpy(CLI_CMD_OUTPUT, "Options not specified.", CLI_CMD_OUTPUT_LENGTH);
-		goto cli_syslog_print;
-	}
-
-	if (strcmp(argv[0], "startup") == 0)
-	{
-		//fuelcell::Converter::instance()->startup();
-		//strncpy(CLI_CMD_OUTPUT, "Charger startup...", CLI_CMD_OUTPUT_LENGTH);
-		goto cli_syslog_print;
-	}
-
-	if (strcmp(argv[0], "shutdown") == 0)
-	{
-		//fuelcell::Converter::instance()->shutdown();
-		//strncpy(CLI_CMD_OUTPUT, "Charger shutdown...", CLI_CMD_OUTPUT_LENGTH);
-		goto cli_syslog_print;
-	}
-
-	strncpy(CLI_CMD_OUTPUT, "Invalid options.", CLI_CMD_OUTPUT_LENGTH);
-
-cli_syslog_print:
-	cli::nextline();
-	cli::print(CLI_CMD_OUTPUT);
+	//fuelcell::Converter::instance()->shutdown();
+	//cli::out << CLI_ENDL << "Charger shutdown...";
 	return 0;
+}
+
+
+} // namespace
+
+
+extern const cli::Cmd cli_sysctl_subcommands[] =
+{
+{"shutdown",		shutdown,		"Shuts system down."},
+{"startup",		startup,		"Starts system up."},
+};
+
+extern const size_t cli_sysctl_subcommandCount = sizeof(cli_sysctl_subcommands) / sizeof(cli_sysctl_subcommands[0]);
+
 
+/// Called if subcommand is not specified or not found.
+int cli_sysctl(int argc, const char** argv)
+{
+	cli::out << CLI_ENDL << ((argc == 0) ? "Options not specified." : "Invalid options.");
+	return -1;
 }
 
 
@@ -11,9 +11,6 @@
  */
 
 
-#pragma once
-
-
 #include "cli/shell/cli_shell.h"
 
 #include "sys/sysinfo/sysinfo.h"
@@ -11,170 +11,190 @@
  */
 
 
-#pragma once
-
-
 #include "cli/shell/cli_shell.h"
 
 #include "sys/syslog/syslog.h"
 
 
-int cli_syslog(int argc, const char** argv)
+namespace {
+
+
+int printErrorsWarnings()
 {
-	if (argc == 0)
-	{
-		strncpy(CLI_CMD_OUTPUT, "Options not specified.", CLI_CMD_OUTPUT_LENGTH);
-		goto cli_syslog_print;
-	}
+	cli::out << CLI_ENDL << "errors: 0x" << cli::hex32(SysLog::errors())
+			<< CLI_ENDL << "warnings: 0x" << cli::hex32(SysLog::warnings());
+	return 0;
+}
 
-	/*===== SHOW =====*/
-	if (strcmp(argv[0], "show") == 0)
-	{
-		if (argc == 1)
-		{
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "errors: 0x%08lX"CLI_ENDL"warnings: 0x%08lX",
-					SysLog::errors(),
-					SysLog::warnings());
-			goto cli_syslog_print;
-		}
-
-		if (strcmp(argv[1], "errors") == 0)
-		{
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "errors: 0x%08lX", SysLog::errors());
-			goto cli_syslog_print;
-		}
-
-		if (strcmp(argv[1], "warnings") == 0)
-		{
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "warnings: 0x%08lX", SysLog::warnings());
-			goto cli_syslog_print;
-		}
-
-		strncpy(CLI_CMD_OUTPUT, "syslog-show: invalid options", CLI_CMD_OUTPUT_LENGTH);
-		goto cli_syslog_print;
-	}
 
-	/*===== SET =====*/
-	if (strcmp(argv[0], "set") == 0)
-	{
-		if (argc != 3)
-		{
-			strncpy(CLI_CMD_OUTPUT, "syslog-set: invalid options", CLI_CMD_OUTPUT_LENGTH);
-			goto cli_syslog_print;
-		}
-
-		if (strcmp(argv[1], "error") == 0)
-		{
-			SysLog::setError(static_cast<sys::Error::Error>(atoll(argv[2])));
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "errors: 0x%08lX", SysLog::errors());
-			goto cli_syslog_print;
-		}
-
-		if (strcmp(argv[1], "warning") == 0)
-		{
-			SysLog::setWarning(static_cast<sys::Warning::Warning>(atoll(argv[2])));
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "warnings: 0x%08lX", SysLog::warnings());
-			goto cli_syslog_print;
-		}
-
-		strncpy(CLI_CMD_OUTPUT, "syslog-set: invalid options", CLI_CMD_OUTPUT_LENGTH);
-		goto cli_syslog_print;
-	}
+int printErrors()
+{
+	cli::out << CLI_ENDL << "errors: 0x" << cli::hex32(SysLog::errors());
+	return 0;
+}
+
+
+int printWarnings()
+{
+	cli::out << CLI_ENDL << "warnings: 0x" << cli::hex32(SysLog::warnings());
+	return 0;
+}
+
+
+int invalidOptions(const char* subcmd)
+{
+	cli::out << CLI_ENDL << "syslog-" << subcmd << ": invalid options";
+	return -1;
+}
+
+
+/*===== SHOW =====*/
+int show(int argc, const char** argv)
+{
+	if (argc != 0) return invalidOptions("show");
+	return printErrorsWarnings();
+}
+
+
+int showErrors(int argc, const char** argv)
+{
+	if (argc != 0) return invalidOptions("show");
+	return printErrors();
+}
+
+
+int showWarnings(int argc, const char** argv)
+{
+	if (argc != 0) return invalidOptions("show");
+	return printWarnings();
+}
+
+
+/*===== SET =====*/
+int setError(int argc, const char** argv)
+{
+	if (argc != 1) return invalidOptions("set");
+	SysLog::setError(static_cast<sys::Error>(atoll(argv[0])));
+	return printErrors();
+}
+
+
+int setWarning(int argc, const char** argv)
+{
+	if (argc != 1) return invalidOptions("set");
+	SysLog::setWarning(static_cast<sys::Warning>(atoll(argv[0])));
+	return printWarnings();
+}
+
+
+/*===== RESET =====*/
+int reset(int argc, const char** argv)
+{
+	if (argc != 0) return invalidOptions("reset");
+	SysLog::resetErrorsWarnings();
+	return printErrorsWarnings();
+}
 
-	/*===== RESET =====*/
-	if (strcmp(argv[0], "reset") == 0)
-	{
-		if (argc == 1)
-		{
-			SysLog::resetErrorsWarnings();
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "errors: 0x%08lX"CLI_ENDL"warnings: 0x%08lX",
-					SysLog::errors(),
-					SysLog::warnings());
-			goto cli_syslog_print;
-		}
-
-		if (argc > 3)
-		{
-			strncpy(CLI_CMD_OUTPUT, "syslog-reset: invalid options", CLI_CMD_OUTPUT_LENGTH);
-			goto cli_syslog_print;
-		}
-
-		if (strcmp(argv[1], "error") == 0)
-		{
-			SysLog::resetError(static_cast<sys::Error::Error>(atoll(argv[2])));
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "errors: 0x%08lX", SysLog::errors());
-			goto cli_syslog_print;
-		}
-
-		if (strcmp(argv[1], "warning") == 0)
-		{
-			SysLog::resetWarning(static_cast<sys::Warning::Warning>(atoll(argv[2])));
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "warnings: 0x%08lX", SysLog::warnings());
-			goto cli_syslog_print;
-		}
-
-		strncpy(CLI_CMD_OUTPUT, "syslog-reset: invalid options", CLI_CMD_OUTPUT_LENGTH);
-		goto cli_syslog_print;
-	}
 
-	/*===== ENABLE =====*/
-	if (strcmp(argv[0], "enable") == 0)
+int resetError(int argc, const char** argv)
+{
+	if (argc != 1) return invalidOptions("reset");
+	SysLog::resetError(static_cast<sys::Error>(atoll(argv[0])));
+	return printErrors();
+}
+
+
+int resetWarning(int argc, const char** argv)
+{
+	if (argc != 1) return invalidOptions("reset");
+	SysLog::resetWarning(static_cast<sys::Warning>(atoll(argv[0])));
+	return printWarnings();
+}
+
+
+/*===== ENABLE/DISABLE =====*/
+int enableError(int argc, const char** argv)
+{
+	if (argc != 1) return invalidOptions("enable");
+	if (strcmp(argv[0], "all") == 0)
 	{
-		if (argc != 3)
-		{
-			strncpy(CLI_CMD_OUTPUT, "syslog-enable: invalid options", CLI_CMD_OUTPUT_LENGTH);
-			goto cli_syslog_print;
-		}
-
-		if (strcmp(argv[1], "error") == 0)
-		{
-			if (strcmp(argv[2], "all") == 0)
-			{
-				SysLog::enableAllErrors();
-				strncpy(CLI_CMD_OUTPUT, "All errors are enabled.", CLI_CMD_OUTPUT_LENGTH);
-				goto cli_syslog_print;
-			}
-
-			SysLog::enableError(static_cast<sys::Error::Error>(atoll(argv[2])));
-			return 0;
-		}
-
-		strncpy(CLI_CMD_OUTPUT, "syslog-enable: invalid options", CLI_CMD_OUTPUT_LENGTH);
-		goto cli_syslog_print;
+		SysLog::enableAllErrors();
+		cli::out << CLI_ENDL << "All errors are enabled.";
+		return 0;
 	}
+	SysLog::enableError(static_cast<sys::Error>(atoll(argv[0])));
+	return 0;
+}
+
 
-	/*===== DISABLE =====*/
-	if (strcmp(argv[0], "disable") == 0)
+int disableError(int argc, const char** argv)
+{
+	if (argc != 1) return invalidOptions("disable");
+	if (strcmp(argv[0], "all") == 0)
 	{
-		if (argc != 3)
-		{
-			strncpy(CLI_CMD_OUTPUT, "syslog-disable: invalid options", CLI_CMD_OUTPUT_LENGTH);
-			goto cli_syslog_print;
-		}
-
-		if (strcmp(argv[1], "error") == 0)
-		{
-			if (strcmp(argv[2], "all") == 0)
-			{
-				SysLog::disableAllErrors();
-				strncpy(CLI_CMD_OUTPUT, "All errors are disabled.", CLI_CMD_OUTPUT_LENGTH);
-				goto cli_syslog_print;
-			}
-
-			SysLog::disableError(static_cast<sys::Error::Error>(atoll(argv[2])));
-			return 0;
-		}
-
-		strncpy(CLI_CMD_OUTPUT, "syslog-disable: invalid options", CLI_CMD_OUTPUT_LENGTH);
-		goto cli_syslog_print;
+		SysLog::disableAllErrors();
+		cli::out << CLI_ENDL << "All errors are disabled.";
+		return 0;
 	}
+	SysLog::disableError(static_cast<sys::Error>(atoll(argv[0])));
+	return 0;
+}
 
-	strncpy(CLI_CMD_OUTPUT, "Invalid options.", CLI_CMD_OUTPUT_LENGTH);
 
-cli_syslog_print:
-	cli::nextline();
-	cli::print(CLI_CMD_OUTPUT);
-	return 0;
+// subcommand tables are sorted by name
+const cli::Cmd showSubcommands[] =
+{
+{"errors",		showErrors,		"Prints errors."},
+{"warnings",		showWarnings,		"Prints warnings."},
+};
+
+
+const cli::Cmd setSubcommands[] =
+{
+{"error",		setError,		"Sets error: set error <code>."},
+{"warning",		setWarning,		"Sets warning: set warning <code>."},
+};
+
+
+const cli::Cmd resetSubcommands[] =
+{
+{"error",		resetError,		"Resets error: reset error <code>."},
+{"warning",		resetWarning,		"Resets warning: reset warning <code>."},
+};
+
+
+const cli::Cmd enableSubcommands[] =
+{
+{"error",		enableError,		"Enables error: enable error <code|all>."},
+};
+
+
+const cli::Cmd disableSubcommands[] =
+{
+{"error",		disableError,		"Disables error: disable error <code|all>."},
+};
+
+
+} // namespace
+
+
+extern const cli::Cmd cli_syslog_subcommands[] =
+{
+{"disable",		NULL,		"Disables error.",		CLI_SUBCOMMANDS(disableSubcommands)},
+{"enable",		NULL,		"Enables error.",		CLI_SUBCOMMANDS(enableSubcommands)},
+{"reset",		reset,		"Resets all or one error/warning.",	CLI_SUBCOMMANDS(resetSubcommands)},
+{"set",		NULL,		"Sets error/warning.",		CLI_SUBCOMMANDS(setSubcommands)},
+{"show",		show,		"Prints errors and warnings.",	CLI_SUBCOMMANDS(showSubcommands)},
+};
+
+extern const size_t cli_syslog_subcommandCount = sizeof(cli_syslog_subcommands) / sizeof(cli_syslog_subcommands[0]);
+
+
+/// Called if subcommand is not specified or not found.
+int cli_syslog(int argc, const char** argv)
+{
+	cli::out << CLI_ENDL << ((argc == 0) ? "Options not specified." : "Invalid options.");
+	return -1;
 }
 
 
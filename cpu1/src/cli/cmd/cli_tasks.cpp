@@ -0,0 +1,110 @@
+/**
+ * @file cli_tasks.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "cli/shell/cli_shell.h"
+
+#include "mcu_f2837xd/system/mcu_system.h"
+#include "mcu_f2837xd/chrono/mcu_chrono.h"
+
+
+/// Max length of table line with line break, command is suspended if line does not fit CLI output buffer.
+const size_t CLI_TASKS_LINE_LENGTH = 96;
+
+
+namespace {
+
+
+/*===== RESET =====*/
+int reset(int argc, const char** argv)
+{
+	if (argc != 0)
+	{
+		cli::out << CLI_ENDL << "tasks-reset: invalid options";
+		return -1;
+	}
+	mcu::chrono::SystemClock::resetTaskStats();
+	cli::out << CLI_ENDL << "Task statistics reset.";
+	return 0;
+}
+
+
+} // namespace
+
+
+extern const cli::Cmd cli_tasks_subcommands[] =
+{
+{"reset",		reset,		"Resets task statistics."},
+};
+
+extern const size_t cli_tasks_subcommandCount = sizeof(cli_tasks_subcommands) / sizeof(cli_tasks_subcommands[0]);
+
+
+/// Prints task table, called if subcommand is not specified or not found.
+int cli_tasks(int argc, const char** argv)
+{
+	using mcu::chrono::SystemClock;
+	using cli::dec;
+	using cli::left;
+	using cli::right;
+
+	if (argc > 0)
+	{
+		cli::out << CLI_ENDL << "tasks: invalid option - \"" << argv[0] << "\"";
+		return -1;
+	}
+
+	if (!SystemClock::taskStatsEnabled())
+	{
+		cli::nextline();
+		cli::out << "Task statistics disabled.";
+		return 0;
+	}
+
+	if (!cli::out.resumed())
+	{
+		cli::out << CLI_ENDL << left("id", 2) << ' ' << left("name", 12) << ' ' << right("period", 7) << ' '
+				<< left("policy", 7) << ' ' << right("runs", 8) << ' ' << right("late min/avg/max", 17) << ' '
+				<< right("exec avg/max", 15) << ' ' << right("ovr", 6) << ' ' << right("skip", 6);
+		cli::out << CLI_ENDL << left("", 2) << ' ' << left("", 12) << ' ' << right("[ms]", 7) << ' '
+				<< left("", 7) << ' ' << right("", 8) << ' ' << right("[ms]", 17) << ' ' << right("[us]", 15);
+	}
+
+	const char* policyNames[3] = {"skip", "catchup", "restart"};
+	const uint32_t clkPerUs = mcu::sysclkFreq() / 1000000;
+	for (uint32_t i = cli::out.resumePoint(); i < SystemClock::taskCountMax(); ++i)
+	{
+		if (!SystemClock::taskRegistered(i)) continue;
+		if (!cli::out.fits(CLI_TASKS_LINE_LENGTH)) return cli::out.suspend(i);
+
+		const emb::TaskStats& stats = SystemClock::taskStats(i);
+		uint32_t latenessAvg = 0;
+		uint32_t execAvg = 0;
+		if (stats.activations != 0)
+		{
+			latenessAvg = static_cast<uint32_t>(stats.latenessTotal / stats.activations);
+			execAvg = static_cast<uint32_t>(stats.execTotal / stats.activations);
+		}
+
+		cli::out << CLI_ENDL << dec(i, 2) << ' ' << left(SystemClock::taskName(i), 12) << ' '
+				<< dec(static_cast<uint32_t>(SystemClock::taskPeriod(i)), 7) << ' '
+				<< left(policyNames[SystemClock::taskPolicy(i).underlying_value()], 7) << ' '
+				<< dec(stats.activations, 8) << ' '
+				<< dec((stats.activations != 0) ? stats.latenessMin : 0, 5) << '/' << dec(latenessAvg, 5) << '/'
+				<< dec(stats.latenessMax, 5) << ' '
+				<< dec(execAvg / clkPerUs, 7) << '/' << dec(stats.execMax / clkPerUs, 7) << ' '
+				<< dec(stats.overruns, 6) << ' ' << dec(stats.skipped, 6);
+	}
+	return 0;
+}
+
+
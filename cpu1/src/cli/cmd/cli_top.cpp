@@ -0,0 +1,100 @@
+/**
+ * @file cli_top.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "cli/shell/cli_shell.h"
+
+#include "emb/emb_cpuload/emb_cpuload.h"
+
+
+/// Max length of table line with line break, command is suspended if line does not fit CLI output buffer.
+const size_t CLI_TOP_LINE_LENGTH = 64;
+
+
+namespace {
+
+
+/*===== RESET =====*/
+int reset(int argc, const char** argv)
+{
+	if (argc != 0)
+	{
+		cli::out << CLI_ENDL << "top-reset: invalid options";
+		return -1;
+	}
+	emb::cpuload::Meter::resetWcet();
+	cli::out << CLI_ENDL << "WCET reset.";
+	return 0;
+}
+
+
+} // namespace
+
+
+extern const cli::Cmd cli_top_subcommands[] =
+{
+{"reset",		reset,		"Resets WCET of all probes."},
+};
+
+extern const size_t cli_top_subcommandCount = sizeof(cli_top_subcommands) / sizeof(cli_top_subcommands[0]);
+
+
+/// Prints load table, called if subcommand is not specified or not found.
+int cli_top(int argc, const char** argv)
+{
+	using cli::dec;
+	using cli::left;
+	using cli::right;
+
+	if (argc > 0)
+	{
+		cli::out << CLI_ENDL << "top: invalid option - \"" << argv[0] << "\"";
+		return -1;
+	}
+
+	if (!cli::out.resumed())
+	{
+		cli::out << CLI_ENDL << "window: " << emb::cpuload::Meter::window_ms() << "ms";
+		cli::out << CLI_ENDL << left("probe", 16) << ' ' << right("load[%]", 8) << ' ' << right("wcet[clk]", 10) << ' '
+				<< right("wcet[us]", 9) << ' ' << right("rate[Hz]", 8);
+	}
+
+	// total load row follows probe rows
+	const uint32_t clkPerUs = emb::cpuload::Meter::timestampFreq() / 1000000;
+	for (uint32_t i = cli::out.resumePoint(); i <= emb::Probe::Count; ++i)
+	{
+		if (!cli::out.fits(CLI_TOP_LINE_LENGTH)) return cli::out.suspend(i);
+
+		if (i == emb::Probe::Count)
+		{
+			uint32_t totalLoad = 0;
+			for (uint32_t j = 0; j < emb::Probe::Count; ++j)
+			{
+				if (j != emb::Probe::Idle)
+				{
+					totalLoad += emb::cpuload::Meter::stats(static_cast<emb::Probe::enum_type>(j)).load;
+				}
+			}
+			cli::out << CLI_ENDL << left("total", 16) << ' ' << dec(totalLoad / 100, 5) << '.' << dec(totalLoad % 100, 2, '0');
+			break;
+		}
+
+		const emb::cpuload::Stats& stats = emb::cpuload::Meter::stats(static_cast<emb::Probe::enum_type>(i));
+		cli::out << CLI_ENDL << left(emb::ProbeRegistry::name(static_cast<emb::Probe::enum_type>(i)), 16) << ' '
+				<< dec(stats.load / 100, 5) << '.' << dec(stats.load % 100, 2, '0') << ' '
+				<< dec(stats.wcet, 10) << ' ' << dec((clkPerUs != 0) ? stats.wcet / clkPerUs : 0, 9) << ' '
+				<< dec(stats.rate, 8);
+	}
+	return 0;
+}
+
+
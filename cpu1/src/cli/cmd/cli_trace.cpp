@@ -0,0 +1,130 @@
+/**
+ * @file cli_trace.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "cli/shell/cli_shell.h"
+
+#include "mcu_f2837xd/system/mcu_system.h"
+#include "mcu_f2837xd/chrono/mcu_chrono.h"
+#include "emb/emb_trace/emb_trace.h"
+
+
+/// Max length of dump line with line break, command is suspended if line does not fit CLI output buffer.
+const size_t CLI_TRACE_LINE_LENGTH = 32;
+
+
+namespace {
+
+
+/*===== START/STOP/CLEAR =====*/
+int start(int argc, const char** argv)
+{
+	emb::trace::Recorder::start();
+	cli::out << CLI_ENDL << "Tracing started.";
+	return 0;
+}
+
+
+int stop(int argc, const char** argv)
+{
+	emb::trace::Recorder::stop();
+	cli::out << CLI_ENDL << "Tracing stopped.";
+	return 0;
+}
+
+
+int clear(int argc, const char** argv)
+{
+	emb::trace::Recorder::clear();
+	cli::out << CLI_ENDL << "Trace buffer cleared.";
+	return 0;
+}
+
+
+/*===== INFO =====*/
+int info(int argc, const char** argv)
+{
+	cli::out << CLI_ENDL << "events: " << static_cast<uint32_t>(emb::trace::Recorder::size())
+			<< '/' << static_cast<uint32_t>(emb::trace::Recorder::capacity())
+			<< CLI_ENDL << "overwritten: " << emb::trace::Recorder::overwritten()
+			<< CLI_ENDL << "clock: period=" << mcu::chrono::HighResolutionClock::period()
+			<< " freq=" << mcu::sysclkFreq();
+	return 0;
+}
+
+
+/*===== PROBES =====*/
+int probes(int argc, const char** argv)
+{
+	for (uint32_t i = cli::out.resumePoint(); i < emb::Probe::Count; ++i)
+	{
+		if (!cli::out.fits(CLI_TRACE_LINE_LENGTH)) return cli::out.suspend(i);
+		cli::out << CLI_ENDL << "probe " << i << ' ' << emb::ProbeRegistry::name(static_cast<emb::Probe::enum_type>(i));
+	}
+	return 0;
+}
+
+
+/*===== DUMP =====*/
+int dump(int argc, const char** argv)
+{
+	if (argc > 1)
+	{
+		cli::out << CLI_ENDL << "trace-dump: invalid options";
+		return -1;
+	}
+
+	uint32_t first = cli::out.resumePoint();
+	if (!cli::out.resumed())
+	{
+		emb::trace::Recorder::stop();	// freeze buffer while it is being read
+		first = (argc == 1) ? atol(argv[0]) : 0;
+	}
+
+	const char typeSymbols[3] = {'B', 'E', 'I'};
+	for (uint32_t i = first; i < emb::trace::Recorder::size(); ++i)
+	{
+		if (!cli::out.fits(CLI_TRACE_LINE_LENGTH)) return cli::out.suspend(i);
+		const emb::trace::Event& event = emb::trace::Recorder::at(i);
+		cli::out << CLI_ENDL << "evt " << i << ' ' << typeSymbols[event.type().underlying_value()] << ' '
+				<< event.probe() << ' ' << cli::hex32(event.timestamp);
+	}
+
+	cli::out << CLI_ENDL << "end";
+	return 0;
+}
+
+
+} // namespace
+
+
+extern const cli::Cmd cli_trace_subcommands[] =
+{
+{"clear",		clear,		"Clears trace buffer."},
+{"dump",		dump,		"Prints events: dump [first]."},
+{"info",		info,		"Prints buffer usage and timestamp clock."},
+{"probes",		probes,		"Prints probe ids."},
+{"start",		start,		"Starts tracing."},
+{"stop",		stop,		"Stops tracing."},
+};
+
+extern const size_t cli_trace_subcommandCount = sizeof(cli_trace_subcommands) / sizeof(cli_trace_subcommands[0]);
+
+
+/// Called if subcommand is not specified or not found.
+int cli_trace(int argc, const char** argv)
+{
+	cli::out << CLI_ENDL << ((argc == 0) ? "Options not specified." : "Invalid options.");
+	return -1;
+}
+
+
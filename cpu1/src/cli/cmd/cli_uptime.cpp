@@ -11,9 +11,6 @@
  */
 
 
-#pragma once
-
-
 #include "cli/shell/cli_shell.h"
 
 #include "mcu_f2837xd/chrono/mcu_chrono.h"
@@ -21,9 +18,10 @@
 
 int cli_uptime(int argc, const char** argv)
 {
+	cli::nextline();
 	if (argc == 0)
 	{
-		snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "uptime: %llums", mcu::chrono::SystemClock::now());
+		cli::out << "uptime: " << static_cast<unsigned long long>(mcu::chrono::SystemClock::now()) << "ms";
 	}
 	else
 	{
@@ -34,17 +32,15 @@ int cli_uptime(int argc, const char** argv)
 			uint64_t min = sec / 60;
 			sec -= 60 * min;
 
-			float uptime = mcu::chrono::SystemClock::now() / 1000.f;
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "uptime: %llum %llus %llums", min, sec, msec);
+			cli::out << "uptime: " << static_cast<unsigned long long>(min) << "m "
+					<< static_cast<unsigned long long>(sec) << "s "
+					<< static_cast<unsigned long long>(msec) << "ms";
 		}
 		else
 		{
-			snprintf(CLI_CMD_OUTPUT, CLI_CMD_OUTPUT_LENGTH, "uptime: invalid option - \"%s\"", argv[0]);
+			cli::out << "uptime: invalid option - \"" << argv[0] << "\"";
 		}
 	}
-
-	cli::nextline();
-	cli::print(CLI_CMD_OUTPUT);
 	return 0;
 }
 
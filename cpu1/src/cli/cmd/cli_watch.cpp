@@ -0,0 +1,140 @@
+/**
+ * @file cli_watch.cpp
+ * @ingroup cli
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include <cstdlib>
+#include "cli/shell/cli_shell.h"
+
+#include "sys/vars/varsampler.h"
+
+
+/// Max length of variable line with line break, redraw is suspended if line does not fit CLI output buffer.
+const size_t CLI_WATCH_LINE_LENGTH = 56;
+const unsigned long CLI_WATCH_INTERVAL_MAX_ms = 60000;
+
+
+namespace {
+
+
+uint32_t watchValues[sys::VarSampler::capacity];
+uint32_t watchSequence;		// sequence of shown sample
+uint32_t watchSkipped;		// samples not shown because output was slower than sampling
+
+
+} // namespace
+
+
+/**
+ * @brief Redraws variable lines and status line in place. Latest sample is taken when previous one
+ * is completely drawn, samples taken meanwhile are skipped: watch never queues output.
+ */
+int cli_watch(int argc, const char** argv)
+{
+	using cli::left;
+
+	if (cli::out.interrupted())
+	{
+		sys::VarSampler::stop();
+		return 0;
+	}
+
+	if (!cli::out.resumed())
+	{
+		cli::nextline();
+		if ((argc < 2) || (static_cast<size_t>(argc - 1) > sys::VarSampler::capacity))
+		{
+			cli::out << "usage: watch <interval_ms> <var...>, up to " << sys::VarSampler::capacity << " variables";
+			return -1;
+		}
+
+		char* end;
+		unsigned long interval_ms = strtoul(argv[0], &end, 10);
+		if ((*end != '\0') || (interval_ms == 0) || (interval_ms > CLI_WATCH_INTERVAL_MAX_ms))
+		{
+			cli::out << "watch: invalid interval - \"" << argv[0] << "\"";
+			return -1;
+		}
+
+		uint16_t ids[sys::VarSampler::capacity];
+		for (int i = 1; i < argc; ++i)
+		{
+			if (!sys::VarRegistry::find(argv[i], ids[i - 1]))
+			{
+				cli::out << "watch: unknown variable - \"" << argv[i] << "\"";
+				return -1;
+			}
+		}
+		if (!sys::VarSampler::start(ids, argc - 1, interval_ms))
+		{
+			cli::out << "watch: sampler task can't be registered";
+			return -1;
+		}
+
+		watchSequence = 0;
+		watchSkipped = 0;
+		cli::out << "Every " << interval_ms << "ms, Ctrl-C to stop.";
+		return cli::out.suspend(0);
+	}
+
+	const size_t count = sys::VarSampler::count();
+	uint32_t row = cli::out.resumePoint();
+	if (row == 0)
+	{
+		uint32_t sequence = watchSequence;
+		if (!sys::VarSampler::take(watchValues, sequence))
+		{
+			return cli::out.suspend(0);	// no output: server does not count call as activity
+		}
+		if (watchSequence != 0)
+		{
+			watchSkipped += sequence - watchSequence - 1;
+			cli::out << '\r' << CLI_ESC"[" << count + 1 << 'A';	// back to header line
+		}
+		watchSequence = sequence;
+		row = 1;
+	}
+
+	// variable lines 1..count, status line count + 1
+	for (; row <= count + 1; ++row)
+	{
+		if (!cli::out.fits(CLI_WATCH_LINE_LENGTH)) return cli::out.suspend(row);
+
+		cli::out << CLI_ENDL;
+		if (row <= count)
+		{
+			uint16_t id = sys::VarSampler::id(row - 1);
+			const sys::Var* var = sys::VarRegistry::var(id);
+			uint32_t raw = watchValues[row - 1];
+			cli::out << left(var->name, 20) << ' ';
+			if ((var->scale != 1.0f) || (var->type == sys::VarType::Float32))
+			{
+				cli::out << cli::fixed(sys::VarRegistry::scaled(id, raw), 3, 14);
+			}
+			else if ((var->type == sys::VarType::Int16) || (var->type == sys::VarType::Int32))
+			{
+				cli::out << cli::dec(static_cast<int32_t>(raw), 14);
+			}
+			else
+			{
+				cli::out << cli::dec(raw, 14);
+			}
+		}
+		else
+		{
+			cli::out << "sample " << watchSequence << ", skipped " << watchSkipped;
+		}
+		cli::out << CLI_ESC"[K";	// erase rest of previous value
+	}
+	return cli::out.suspend(0);
+}
+
+
@@ -22,9 +22,28 @@ int cli_reboot(int argc, const char** argv);
 int cli_uptime(int argc, const char** argv);
 int cli_syslog(int argc, const char** argv);
 int cli_sysctl(int argc, const char** argv);
-
-
-extern char CLI_CMD_OUTPUT[CLI_CMD_OUTPUT_LENGTH] = {0};
+int cli_trace(int argc, const char** argv);
+int cli_top(int argc, const char** argv);
+int cli_probe(int argc, const char** argv);
+int cli_tasks(int argc, const char** argv);
+int cli_binmode(int argc, const char** argv);
+int cli_watch(int argc, const char** argv);
+int cli_history(int argc, const char** argv);
+
+extern const cli::Cmd cli_syslog_subcommands[];
+extern const size_t cli_syslog_subcommandCount;
+extern const cli::Cmd cli_sysctl_subcommands[];
+extern const size_t cli_sysctl_subcommandCount;
+extern const cli::Cmd cli_trace_subcommands[];
+extern const size_t cli_trace_subcommandCount;
+extern const cli::Cmd cli_top_subcommands[];
+extern const size_t cli_top_subcommandCount;
+extern const cli::Cmd cli_probe_subcommands[];
+extern const size_t cli_probe_subcommandCount;
+extern const cli::Cmd cli_tasks_subcommands[];
+extern const size_t cli_tasks_subcommandCount;
+extern const cli::Cmd cli_history_subcommands[];
+extern const size_t cli_history_subcommandCount;
 
 
 namespace cli {
@@ -36,8 +55,15 @@ Cmd Shell::_commands[] =
 {"sysinfo",		cli_sysinfo,		"Prints basic information about system."},
 {"reboot",		cli_reboot,		"Reboots device."},
 {"uptime",		cli_uptime,		"Shows system uptime."},
-{"syslog",		cli_syslog,		"SysLog control utility."},
-{"sysctl",		cli_sysctl,		"System control utility."},
+{"syslog",		cli_syslog,		"SysLog control utility.",	cli_syslog_subcommands,	cli_syslog_subcommandCount},
+{"sysctl",		cli_sysctl,		"System control utility.",	cli_sysctl_subcommands,	cli_sysctl_subcommandCount},
+{"trace",		cli_trace,		"Event trace control and dump utility.",	cli_trace_subcommands,	cli_trace_subcommandCount},
+{"top",		cli_top,		"Prints CPU load, WCET and call rate of ISRs and superloop stages.",	cli_top_subcommands,	cli_top_subcommandCount},
+{"probe",		cli_probe,		"Profiler probe list and enable/disable utility.",	cli_probe_subcommands,	cli_probe_subcommandCount},
+{"tasks",		cli_tasks,		"Prints clock task lateness, execution time and overrun statistics.",	cli_tasks_subcommands,	cli_tasks_subcommandCount},
+{"binmode",		cli_binmode,		"Switches to framed binary protocol for host tools."},
+{"watch",		cli_watch,		"Periodically redraws variables: watch <interval_ms> <var...>."},
+{"history",		cli_history,		"Prints command history, Ctrl-R searches it by prefix.",	cli_history_subcommands,	cli_history_subcommandCount},
 };
 
 const size_t Shell::_commandsCount = sizeof(Shell::_commands) / sizeof(Shell::_commands[0]);
@@ -47,9 +73,10 @@ Cmd* Shell::_commandsEnd = Shell::_commands + Shell::_commandsCount;
 ///
 ///
 ///
-void Shell::init()
+bool Shell::init()
 {
 	std::sort(_commands, _commandsEnd);
+	return validate(_commands, _commandsCount);
 }
 
 
@@ -60,29 +87,174 @@ int Shell::exec(int argc, const char** argv)
 {
 	if (argc == 0) return 0;
 
-	const Cmd* cmd = emb::binary_find(_commands, _commandsEnd, argv[0]);
-	if (cmd == _commandsEnd)
+	const Cmd* cmd = find(_commands, _commandsCount, argv[0]);
+	if (cmd == NULL)
 	{
 		cli::nextline();
 		cli::print(argv[0]);
 		cli::print(": command not found");
 		return -1;
 	}
+	--argc;
+	++argv;
 
-	if (argc == 1)
+	// descend into subcommand tables, "--help" is dispatched at any depth
+	while (argc > 0)
 	{
-		return cmd->exec(--argc, ++argv);
+		if (strcmp(argv[0], "--help") == 0)
+		{
+			_printHelp(*cmd);
+			return 0;
+		}
+
+		const Cmd* subcmd = find(cmd->subcommands, cmd->subcommandCount, argv[0]);
+		if (subcmd == NULL) break;
+		cmd = subcmd;
+		--argc;
+		++argv;
 	}
-	else if (strcmp(argv[1], "--help") == 0)
+
+	if (cmd->exec == NULL)
 	{
-		cli::nextline();
-		cli::print(cmd->help);
-		return 0;
+		_printHelp(*cmd);
+		return -1;
+	}
+	return cmd->exec(argc, argv);
+}
+
+
+///
+///
+///
+int Shell::complete(int argc, const char** argv, char* suffix, size_t suffixSize)
+{
+	suffix[0] = '\0';
+	if (argc == 0) return 0;
+
+	const Cmd* cmds = _commands;
+	size_t count = _commandsCount;
+	for (int i = 0; i < argc - 1; ++i)
+	{
+		const Cmd* cmd = find(cmds, count, argv[i]);
+		if (cmd == NULL) return 0;
+		cmds = cmd->subcommands;
+		count = cmd->subcommandCount;
+	}
+
+	const char* prefix = argv[argc - 1];
+	const char* helpOption = "--help";
+	size_t candidates = 0;
+	if ((argc > 1) && (prefix[0] == '-'))
+	{
+		if (strncmp(helpOption, prefix, strlen(prefix)) != 0) return 0;
+		strncpy(suffix, helpOption + strlen(prefix), suffixSize - 1);
+		suffix[suffixSize - 1] = '\0';
+		candidates = 1;
 	}
 	else
 	{
-		return cmd->exec(--argc, ++argv);
+		candidates = completePrefix(cmds, count, prefix, suffix, suffixSize);
 	}
+
+	if ((candidates == 1) && (strlen(suffix) + 1 < suffixSize))
+	{
+		strcat(suffix, " ");
+	}
+	else if ((candidates > 1) && (suffix[0] == '\0'))
+	{
+		const Cmd* first = NULL;
+		findPrefix(cmds, count, prefix, first);
+		cli::nextline();
+		for (size_t i = 0; i < candidates; ++i)
+		{
+			cli::print(first[i].name);
+			cli::print("  ");
+		}
+	}
+	return candidates;
+}
+
+
+///
+///
+///
+bool Shell::validate(const Cmd* cmds, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Cmd& cmd = cmds[i];
+		if ((cmd.name == NULL) || (cmd.name[0] == '\0') || (strchr(cmd.name, ' ') != NULL)) return false;
+		if ((i > 0) && (strcmp(cmds[i-1].name, cmd.name) >= 0)) return false;	// unsorted or duplicate
+		if ((cmd.subcommands == NULL) != (cmd.subcommandCount == 0)) return false;
+		if ((cmd.exec == NULL) && (cmd.subcommandCount == 0)) return false;
+		if (!validate(cmd.subcommands, cmd.subcommandCount)) return false;
+	}
+	return true;
+}
+
+
+///
+///
+///
+const Cmd* Shell::find(const Cmd* cmds, size_t count, const char* name)
+{
+	const Cmd* end = cmds + count;
+	const Cmd* cmd = emb::binary_find(cmds, end, name);
+	return (cmd != end) ? cmd : static_cast<const Cmd*>(NULL);
+}
+
+
+///
+///
+///
+size_t Shell::findPrefix(const Cmd* cmds, size_t count, const char* prefix, const Cmd*& first)
+{
+	size_t len = strlen(prefix);
+
+	// names truncated to prefix length are sorted too: range is found by two binary searches
+	size_t lo = 0;
+	size_t hi = count;
+	while (lo < hi)
+	{
+		size_t mid = lo + (hi - lo) / 2;
+		if (strncmp(cmds[mid].name, prefix, len) < 0) { lo = mid + 1; } else { hi = mid; }
+	}
+	size_t begin = lo;
+
+	hi = count;
+	while (lo < hi)
+	{
+		size_t mid = lo + (hi - lo) / 2;
+		if (strncmp(cmds[mid].name, prefix, len) <= 0) { lo = mid + 1; } else { hi = mid; }
+	}
+
+	first = cmds + begin;
+	return lo - begin;
+}
+
+
+///
+///
+///
+size_t Shell::completePrefix(const Cmd* cmds, size_t count, const char* prefix, char* suffix, size_t suffixSize)
+{
+	suffix[0] = '\0';
+	const Cmd* first = NULL;
+	size_t candidates = findPrefix(cmds, count, prefix, first);
+	if (candidates == 0) return 0;
+
+	// common prefix of sorted range is common prefix of its first and last names
+	size_t len = strlen(prefix);
+	const char* a = first[0].name + len;
+	const char* b = first[candidates - 1].name + len;
+	size_t i = 0;
+	while ((a[i] != '\0') && (a[i] == b[i]) && (i + 1 < suffixSize))
+	{
+		suffix[i] = a[i];
+		++i;
+	}
+	suffix[i] = '\0';
+	return candidates;
 }
 
 
@@ -90,15 +262,35 @@ int Shell::exec(int argc, const char** argv)
 ///
 ///
 int Shell::_list(int argc, const char** argv)
+{
+	if (!cli::out.resumed())
+	{
+		cli::out << CLI_ENDL << "Available commands are:";
+	}
+	for (size_t i = cli::out.resumePoint(); i < _commandsCount; ++i)
+	{
+		if (!cli::out.fits(strlen(_commands[i].name) + 2)) return cli::out.suspend(i);
+		cli::out << CLI_ENDL << _commands[i].name;
+	}
+	return 0;
+}
+
+
+///
+///
+///
+void Shell::_printHelp(const Cmd& cmd)
 {
 	cli::nextline();
-	cli::print("Available commands are:");
-	for (size_t i = 0; i < _commandsCount; ++i)
+	cli::print(cmd.help);
+	for (size_t i = 0; i < cmd.subcommandCount; ++i)
 	{
 		cli::nextline();
-		cli::print(_commands[i].name);
+		cli::print("  ");
+		cli::print(cmd.subcommands[i].name);
+		cli::print(" - ");
+		cli::print(cmd.subcommands[i].help);
 	}
-	return 0;
 }
 
 
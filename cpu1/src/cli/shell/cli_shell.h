@@ -19,26 +19,29 @@
 #include "emb/emb_algorithm.h"
 
 
-#define CLI_CMD_OUTPUT_LENGTH CLI_OUTBUT_BUFFER_LENGTH
-extern char CLI_CMD_OUTPUT[CLI_CMD_OUTPUT_LENGTH];
-
-
 namespace cli {
 /// @addtogroup cli
 /// @{
 
 
 /**
- * @brief Shell command specification.
+ * @brief Shell command specification. Subcommand table is dispatched by shell: matched subcommand is executed
+ * with arguments that follow its name, otherwise command exec is called with all its arguments.
  */
 struct Cmd
 {
 	const char* name;
-	int (*exec)(int argc, const char** argv);
+	int (*exec)(int argc, const char** argv);	// NULL - command requires subcommand
 	const char* help;
+	const Cmd* subcommands;				// sorted by name, NULL - no subcommands
+	size_t subcommandCount;
 };
 
 
+/// Subcommand table fields of Cmd initializer.
+#define CLI_SUBCOMMANDS(table) table, sizeof(table) / sizeof(table[0])
+
+
 inline bool operator<(const Cmd& lhs, const Cmd& rhs)
 {
 	return strcmp(lhs.name, rhs.name) < 0;
@@ -68,10 +71,56 @@ private:
 	static const size_t _commandsCount;
 	static Cmd* _commandsEnd;
 public:
-	static void init();
+	/**
+	 * @brief Sorts command table and validates command tree.
+	 * @param (none)
+	 * @return \c true if command tree is valid, see validate().
+	 */
+	static bool init();
 	static int exec(int argc, const char** argv);
+
+	/**
+	 * @brief Completes last argument: command name or subcommand name at any depth, "--help" option.
+	 * Suffix is empty and candidates are printed if there are several candidates without common suffix.
+	 * @param argc - number of arguments, last one is incomplete (may be empty)
+	 * @param argv - arguments
+	 * @param suffix - chars to be appended to last argument, ' ' is appended for single candidate
+	 * @param suffixSize - size of suffix buffer
+	 * @return Number of candidates.
+	 */
+	static int complete(int argc, const char** argv, char* suffix, size_t suffixSize);
+
+	/**
+	 * @brief Checks that command table and all subcommand tables are sorted, have no duplicates
+	 * and empty or whitespace-containing names, each command is executable or has subcommands.
+	 * @param cmds - command table
+	 * @param count - number of commands
+	 * @return \c true if command tree is valid.
+	 */
+	static bool validate(const Cmd* cmds, size_t count);
+
+	/**
+	 * @brief Finds command in sorted table, O(log N).
+	 * @return Pointer to command, \c NULL if command is not found.
+	 */
+	static const Cmd* find(const Cmd* cmds, size_t count, const char* name);
+
+	/**
+	 * @brief Finds range of commands starting with prefix in sorted table, O(log N).
+	 * @param first - first command in range
+	 * @return Number of commands in range.
+	 */
+	static size_t findPrefix(const Cmd* cmds, size_t count, const char* prefix, const Cmd*& first);
+
+	/**
+	 * @brief Completes prefix with sorted table.
+	 * @param suffix - common suffix of commands starting with prefix
+	 * @return Number of commands starting with prefix.
+	 */
+	static size_t completePrefix(const Cmd* cmds, size_t count, const char* prefix, char* suffix, size_t suffixSize);
 private:
 	static int _list(int argc, const char** argv);
+	static void _printHelp(const Cmd& cmd);
 };
 
 
@@ -45,6 +45,16 @@ mcu::chrono::TaskStatus taskToggleLed(size_t taskIndex)
 }
 
 
+///
+///
+///
+mcu::chrono::TaskStatus taskUpdateCpuLoad(size_t taskIndex)
+{
+	emb::cpuload::Meter::update(mcu::chrono::SystemClock::now());
+	return mcu::chrono::TaskStatus::Success;
+}
+
+
 ///
 ///
 ///
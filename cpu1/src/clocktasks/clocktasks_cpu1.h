@@ -19,6 +19,7 @@
 #include "mcu_f2837xd/chrono/mcu_chrono.h"
 #include "bsp_launchxl_f28379d/leds/leds.h"
 #include "sys/syslog/syslog.h"
+#include "emb/emb_cpuload/emb_cpuload.h"
 
 
 /**
@@ -37,6 +38,14 @@ mcu::chrono::TaskStatus taskWatchdogTimeout();
 mcu::chrono::TaskStatus taskToggleLed(size_t taskIndex);
 
 
+/**
+ * @brief CPU load meter window update task.
+ * @param (none)
+ * @return Task execution status.
+ */
+mcu::chrono::TaskStatus taskUpdateCpuLoad(size_t taskIndex);
+
+
 /**
  * @brief Start temperature sensors task.
  * @param (none)
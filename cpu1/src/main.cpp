@@ -25,6 +25,7 @@
 
 #include "sys/syslog/syslog.h"
 #include "sys/sysinfo/sysinfo.h"
+#include "sys/vars/vars.h"
 #include "clocktasks/clocktasks_cpu1.h"
 
 #include "mcu_f2837xd/sci/mcu_sci.h"
@@ -37,6 +38,10 @@
 
 #include "bsp_launchxl_f28379d/bsp_launchxl_f28379d.h"
 #include "emb/emb_profiler/emb_profiler.h"
+#include "emb/emb_trace/emb_trace.h"
+#include "emb/emb_cpuload/emb_cpuload.h"
+#include "emb/emb_executor.h"
+#include "emb/emb_events/emb_events.h"
 #include "tests/tests.h"
 
 
@@ -60,6 +65,164 @@ const char* SysInfo::buildConfigurationShort = "RLS";
 #endif
 
 
+/* ========================================================================== */
+/* ============================== VARIABLES ================================= */
+/* ========================================================================== */
+#define APP_VAR_CPULOAD_ENTRY(id, name) \
+	{"load_" name, sys::VarType::Uint32, const_cast<uint32_t*>(&emb::cpuload::Meter::stats(emb::Probe::id).load), 0.01f, false},
+
+/// Copies of values that are not stored in plain variables, updated by clock task
+struct AppVarsMirror
+{
+	uint32_t uptime_ms;
+	uint32_t syslogErrors;
+	uint32_t syslogWarnings;
+};
+
+AppVarsMirror appVarsMirror;
+
+/// Variables of binary protocol, ID is table index
+const sys::Var appVars[] =
+{
+	{"uptime", sys::VarType::Uint32, &appVarsMirror.uptime_ms, 0.001f, false},
+	{"syslog_errors", sys::VarType::Uint32, &appVarsMirror.syslogErrors, 1.0f, false},
+	{"syslog_warnings", sys::VarType::Uint32, &appVarsMirror.syslogWarnings, 1.0f, false},
+	EMB_PROBE_LIST(APP_VAR_CPULOAD_ENTRY)
+};
+
+#undef APP_VAR_CPULOAD_ENTRY
+
+
+///
+/// Updates copies of registry variables, runs every SystemClock tick
+///
+mcu::chrono::TaskStatus taskUpdateAppVars(size_t taskIndex)
+{
+	appVarsMirror.uptime_ms = static_cast<uint32_t>(mcu::chrono::SystemClock::now());
+	appVarsMirror.syslogErrors = SysLog::errors();
+	appVarsMirror.syslogWarnings = SysLog::warnings();
+	return mcu::chrono::TaskStatus::Success;
+}
+
+
+/* ========================================================================== */
+/* =========================== SUPERLOOP TASKS ============================== */
+/* ========================================================================== */
+/// Superloop task priorities, 0 is the highest
+const size_t SUPERLOOP_PRIORITY_CAN = 0;
+const size_t SUPERLOOP_PRIORITY_SYSTEM = 1;
+const size_t SUPERLOOP_PRIORITY_CLI = 2;
+const size_t SUPERLOOP_PRIORITY_COUNT = 3;
+
+/// Time slice of superloop task, after it task yields to other tasks
+const uint64_t SUPERLOOP_TIME_SLICE_us = 50;
+
+/// CLI UART
+typedef mcu::sci::Module<mcu::sci::Peripheral::SciB> CliUart;
+
+
+///
+/// RX notification, called by CLI UART RX ISR after received chars are put to RX ring
+///
+void onCliUartRx()
+{
+	CliUart::instance()->disableRxInterrupts();	// re-enabled by CLI task when RX ring is drained
+	emb::PendingEvents::set(emb::Event::UartRx);
+}
+
+
+///
+///
+///
+void superloopIdle()
+{
+	EMB_CPULOAD_ENTER(Idle);
+	EMB_TRACE_BEGIN(Idle);
+	while (!emb::PendingEvents::any())
+	{
+		mcu::idle();
+	}
+	EMB_TRACE_END(Idle);
+	EMB_CPULOAD_EXIT(Idle);
+}
+
+
+///
+///
+///
+emb::PtStatus taskSysLogIpc(emb::ProtoThread& pt)
+{
+	EMB_CPULOAD_ENTER(SysLogIpc);
+	EMB_TRACE_BEGIN(SysLogIpc);
+	SysLog::processIpcSignals();
+	EMB_TRACE_END(SysLogIpc);
+	EMB_CPULOAD_EXIT(SysLogIpc);
+	return emb::PtStatus::Waiting;
+}
+
+
+///
+///
+///
+emb::PtStatus taskClockTasks(emb::ProtoThread& pt)
+{
+	EMB_CPULOAD_ENTER(ClockTasks);
+	EMB_TRACE_BEGIN(ClockTasks);
+	mcu::chrono::SystemClock::runTasks();
+	EMB_TRACE_END(ClockTasks);
+	EMB_CPULOAD_EXIT(ClockTasks);
+	return emb::PtStatus::Waiting;
+}
+
+
+///
+///
+///
+emb::PtStatus threadCliServer(emb::ProtoThread& pt)
+{
+	cli::Server* server = static_cast<cli::Server*>(pt.arg);
+	EMB_PT_BEGIN(pt);
+	while (server->run())	// output bursts are served until time slice is over
+	{
+		if (pt.sliceExpired())
+		{
+			EMB_PT_YIELD(pt);
+		}
+	}
+	CliUart::instance()->enableRxInterrupts();
+	EMB_PT_END(pt);
+}
+
+
+///
+///
+///
+emb::PtStatus taskCliServer(emb::ProtoThread& pt)
+{
+	EMB_CPULOAD_ENTER(CliServer);
+	EMB_TRACE_BEGIN(CliServer);
+	emb::PtStatus status = threadCliServer(pt);
+	EMB_TRACE_END(CliServer);
+	EMB_CPULOAD_EXIT(CliServer);
+	return status;
+}
+
+
+///
+///
+///
+template <class CanServer>
+emb::PtStatus taskCanServer(emb::ProtoThread& pt)
+{
+	EMB_CPULOAD_ENTER(CanServer);
+	EMB_TRACE_BEGIN(CanServer);
+	static_cast<CanServer*>(pt.arg)->run();
+	EMB_TRACE_END(CanServer);
+	EMB_CPULOAD_EXIT(CanServer);
+	return emb::PtStatus::Waiting;
+}
+
+
 /* ========================================================================== */
 /* ================================ MAIN ==================================== */
 /* ========================================================================== */
@@ -89,14 +252,20 @@ void main()
 		.parityMode = mcu::sci::ParityMode::None,
 		.autoBaudMode = mcu::sci::AutoBaudMode::Disabled,
 	};
-	mcu::sci::Module<mcu::sci::Peripheral::SciB> sciB(
+	CliUart sciB(
 			mcu::gpio::Config(bsp::j1_sciB_rxPin, bsp::j1_sciB_rxPinMux),
 			mcu::gpio::Config(bsp::j1_sciB_txPin, bsp::j1_sciB_txPinMux),
 			sciBConf);
+	sciB.enableInterruptDrivenMode();	// RX does not overrun while superloop is busy, TX does not wait for CLI task
 
 	cli::Server cliServer("launchpad", &sciB, NULL, NULL);
-	cli::Shell::init();
+	bool shellValid = cli::Shell::init();	// subcommand tables are sorted, names are unique
+	assert(shellValid);
+	(void)shellValid;
 	cliServer.registerExecCallback(cli::Shell::exec);
+	cliServer.registerCompletionCallback(cli::Shell::complete);
+	sys::VarRegistry::init(appVars, sizeof(appVars) / sizeof(appVars[0]));
+	cli::BinaryProtocol::init(mcu::chrono::SystemClock::now);
 	cli::nextline_blocking();
 	cli::nextline_blocking();
 	cli::nextline_blocking();
@@ -172,9 +341,14 @@ void main()
 
 	mcu::chrono::SystemClock::init();
 	mcu::chrono::HighResolutionClock::init(1000000);
+	mcu::chrono::HighResolutionClock::enableExtendedTicks();
 	mcu::chrono::HighResolutionClock::start();
+	mcu::chrono::SystemClock::enableTaskStats(mcu::chrono::HighResolutionClock::ticks);
 	emb::DurationLogger_us::init(mcu::chrono::HighResolutionClock::now);
 	emb::DurationLogger_clk::init(mcu::chrono::HighResolutionClock::counter);
+	emb::trace::Recorder::init(mcu::chrono::HighResolutionClock::counter);
+	emb::cpuload::Meter::init(mcu::chrono::HighResolutionClock::counter, mcu::chrono::HighResolutionClock::period(),
+			mcu::sysclkFreq(), mcu::chrono::SystemClock::now());
 
 	cli::print_blocking("done.");
 
@@ -280,14 +454,10 @@ void main()
 #ifdef DUALCORE
 	ucanopen::IpcFlags canIpcFlags =
 	{
-		.rpdo1Received = mcu::ipc::Flag(4, mcu::ipc::Mode::Dualcore),
-		.rpdo2Received = mcu::ipc::Flag(5, mcu::ipc::Mode::Dualcore),
-		.rpdo3Received = mcu::ipc::Flag(6, mcu::ipc::Mode::Dualcore),
-		.rpdo4Received = mcu::ipc::Flag(7, mcu::ipc::Mode::Dualcore),
-		.rsdoReceived = mcu::ipc::Flag(8, mcu::ipc::Mode::Dualcore),
 		.tsdoReady = mcu::ipc::Flag(9, mcu::ipc::Mode::Dualcore)
 	};
-	ucanopen::tests::Server<mcu::can::Peripheral::CanB, mcu::ipc::Mode::Dualcore, mcu::ipc::Role::Secondary> canServer(canIpcFlags);
+	typedef ucanopen::tests::Server<mcu::can::Peripheral::CanB, mcu::ipc::Mode::Dualcore, mcu::ipc::Role::Secondary> CanServer;
+	CanServer canServer(canIpcFlags);
 #else
 	mcu::can::Module<mcu::can::Peripheral::CanB> canB(
 			mcu::gpio::Config(17, GPIO_17_CANRXB),
@@ -297,15 +467,10 @@ void main()
 
 	ucanopen::IpcFlags canIpcFlags =
 	{
-		.rpdo1Received = mcu::ipc::Flag(4, mcu::ipc::Mode::Singlecore),
-		.rpdo2Received = mcu::ipc::Flag(5, mcu::ipc::Mode::Singlecore),
-		.rpdo3Received = mcu::ipc::Flag(6, mcu::ipc::Mode::Singlecore),
-		.rpdo4Received = mcu::ipc::Flag(7, mcu::ipc::Mode::Singlecore),
-		.rsdoReceived = mcu::ipc::Flag(8, mcu::ipc::Mode::Singlecore),
 		.tsdoReady = mcu::ipc::Flag(9, mcu::ipc::Mode::Singlecore)
 	};
-	ucanopen::tests::Server<mcu::can::Peripheral::CanB, mcu::ipc::Mode::Singlecore, mcu::ipc::Role::Primary> canServer(
-			ucanopen::NodeId(0x1), &canB, canIpcFlags);
+	typedef ucanopen::tests::Server<mcu::can::Peripheral::CanB, mcu::ipc::Mode::Singlecore, mcu::ipc::Role::Primary> CanServer;
+	CanServer canServer(ucanopen::NodeId(0x1), &canB, canIpcFlags);
 #endif
 
 	cli::print_blocking("done.");
@@ -317,7 +482,9 @@ void main()
 	cli::nextline_blocking();
 	cli::print_blocking("Registering periodic tasks... ");
 
-	mcu::chrono::SystemClock::registerTask(taskToggleLed, 1000);
+	mcu::chrono::SystemClock::registerTask(taskToggleLed, 1000, "toggle_led");
+	mcu::chrono::SystemClock::registerTask(taskUpdateCpuLoad, 1000, "cpuload");
+	mcu::chrono::SystemClock::registerTask(taskUpdateAppVars, 1, "app_vars");
 
 	mcu::chrono::SystemClock::registerWatchdogTask(taskWatchdogTimeout, 1000);
 
@@ -358,14 +525,36 @@ void main()
 	cli::nextline_blocking();
 	cli::print_blocking("Device ready!");
 
+/*####################################################################################################################*/
+	/*###################*/
+	/*# SUPERLOOP TASKS #*/
+	/*###################*/
+	emb::Executor<4, SUPERLOOP_PRIORITY_COUNT> superloop(mcu::chrono::HighResolutionClock::ticks,
+			SUPERLOOP_TIME_SLICE_us * (mcu::sysclkFreq() / 1000000));
+	size_t taskId = superloop.add(taskCanServer<CanServer>, &canServer, SUPERLOOP_PRIORITY_CAN, false);
+	superloop.subscribe(taskId, emb::PendingEvents::bit(emb::Event::CanRx) | emb::PendingEvents::bit(emb::Event::ClockTick));
+	taskId = superloop.add(taskSysLogIpc, NULL, SUPERLOOP_PRIORITY_SYSTEM, false);
+	superloop.subscribe(taskId, emb::PendingEvents::bit(emb::Event::ClockTick));	// IPC flags in use do not raise interrupts
+	taskId = superloop.add(taskClockTasks, NULL, SUPERLOOP_PRIORITY_SYSTEM, false);
+	superloop.subscribe(taskId, emb::PendingEvents::bit(emb::Event::ClockTick));
+	taskId = superloop.add(taskCliServer, &cliServer, SUPERLOOP_PRIORITY_CLI, false);
+	superloop.subscribe(taskId, emb::PendingEvents::bit(emb::Event::UartRx) | emb::PendingEvents::bit(emb::Event::ClockTick));
+	sciB.registerRxInterruptHandler(onCliUartRx);
+	sciB.enableRxInterrupts();
+
 	canServer.enable();
+	emb::trace::Recorder::start();
 
 	while (true)
 	{
-		SysLog::processIpcSignals();
-		mcu::chrono::SystemClock::runTasks();
-		cliServer.run();
-		canServer.run();
+		EMB_CPULOAD_ENTER(Superloop);
+		EMB_TRACE_INSTANT(Superloop);
+		superloop.notify(emb::PendingEvents::take());
+		if (!superloop.runOnce())
+		{
+			superloopIdle();
+		}
+		EMB_CPULOAD_EXIT(Superloop);	// executor own overhead, tasks, idle and ISRs are excluded
 	}
 }
 
@@ -15,14 +15,14 @@
 
 
 #ifdef DUALCORE
-emb::Queue<sys::Message::Message, 32> SysLog::_messages __attribute__((section("shared_syslog_messages"), retain));
+emb::Queue<sys::Message, 32> SysLog::_messages __attribute__((section("shared_syslog_messages"), retain));
 #else
-emb::Queue<sys::Message::Message, 32> SysLog::_messages;
+emb::Queue<sys::Message, 32> SysLog::_messages;
 #endif
 
 
 #ifdef DUALCORE
-sys::Message::Message SysLog::_cpu2Message __attribute__((section("shared_syslog_message_cpu2"), retain)) = sys::Message::NoMessage;
+sys::Message SysLog::_cpu2Message __attribute__((section("shared_syslog_message_cpu2"), retain)) = sys::Message::NoMessage;
 #endif
 
 
@@ -58,9 +58,9 @@ private:
 	SysLog& operator=(const SysLog& other);	// no copy assignment operator
 
 private:
-	static emb::Queue<sys::Message::Message, 32> _messages;
+	static emb::Queue<sys::Message, 32> _messages;
 #ifdef DUALCORE
-	static sys::Message::Message _cpu2Message;
+	static sys::Message _cpu2Message;
 #endif
 
 	static Data _cpu1Data;
@@ -109,7 +109,7 @@ public:
 	 * @param msg - message to be added
 	 * @return (none)
 	 */
-	static void addMessage(sys::Message::Message msg)
+	static void addMessage(sys::Message msg)
 	{
 		mcu::CriticalSection cs;
 #ifdef CPU1
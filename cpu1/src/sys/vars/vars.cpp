@@ -0,0 +1,123 @@
+/**
+ * @file vars.cpp
+ * @ingroup vars
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "vars.h"
+
+
+namespace sys {
+
+
+const Var* VarRegistry::_vars = static_cast<const Var*>(NULL);
+size_t VarRegistry::_count = 0;
+
+
+namespace {
+
+
+union FloatBits
+{
+	float f;
+	uint32_t u;
+};
+
+
+} // namespace
+
+
+///
+///
+///
+uint32_t VarRegistry::read(uint16_t id)
+{
+	const Var& v = _vars[id];
+	switch (v.type.native_value())
+	{
+	case VarType::Uint16:
+		return *static_cast<volatile uint16_t*>(v.ptr);
+	case VarType::Int16:
+		return static_cast<uint32_t>(static_cast<int32_t>(*static_cast<volatile int16_t*>(v.ptr)));
+	case VarType::Uint32:
+		return *static_cast<volatile uint32_t*>(v.ptr);
+	case VarType::Int32:
+		return static_cast<uint32_t>(*static_cast<volatile int32_t*>(v.ptr));
+	case VarType::Float32:
+	{
+		FloatBits bits;
+		bits.f = *static_cast<volatile float*>(v.ptr);
+		return bits.u;
+	}
+	}
+	return 0;
+}
+
+
+///
+///
+///
+float VarRegistry::scaled(uint16_t id, uint32_t raw)
+{
+	const Var& v = _vars[id];
+	switch (v.type.native_value())
+	{
+	case VarType::Int16:
+	case VarType::Int32:
+		return static_cast<float>(static_cast<int32_t>(raw)) * v.scale;
+	case VarType::Float32:
+	{
+		FloatBits bits;
+		bits.u = raw;
+		return bits.f * v.scale;
+	}
+	default:
+		return static_cast<float>(raw) * v.scale;
+	}
+}
+
+
+///
+///
+///
+bool VarRegistry::write(uint16_t id, uint32_t raw)
+{
+	const Var& v = _vars[id];
+	if (!v.writable) return false;
+
+	switch (v.type.native_value())
+	{
+	case VarType::Uint16:
+		*static_cast<volatile uint16_t*>(v.ptr) = raw & 0xFFFF;
+		break;
+	case VarType::Int16:
+		*static_cast<volatile int16_t*>(v.ptr) = static_cast<int16_t>(raw & 0xFFFF);
+		break;
+	case VarType::Uint32:
+		*static_cast<volatile uint32_t*>(v.ptr) = raw;
+		break;
+	case VarType::Int32:
+		*static_cast<volatile int32_t*>(v.ptr) = static_cast<int32_t>(raw);
+		break;
+	case VarType::Float32:
+	{
+		FloatBits bits;
+		bits.u = raw;
+		*static_cast<volatile float*>(v.ptr) = bits.f;
+		break;
+	}
+	}
+	return true;
+}
+
+
+} // namespace sys
+
+
@@ -0,0 +1,143 @@
+/**
+ * @defgroup vars Vars
+ *
+ * @file vars.h
+ * @ingroup vars
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Named variable registry: typed access to application variables by ID or by name.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cstring>
+#include "emb/emb_core.h"
+
+
+namespace sys {
+/// @addtogroup vars
+/// @{
+
+
+SCOPED_ENUM_DECLARE_BEGIN(VarType)
+{
+	Uint16,
+	Int16,
+	Uint32,
+	Int32,
+	Float32
+}
+SCOPED_ENUM_DECLARE_END(VarType)
+
+
+/**
+ * @brief Registry entry. Variable ID is entry index in registry table.
+ * Scale converts raw value to physical one for display, e.g. 0.01 for value in hundredths of percent.
+ */
+struct Var
+{
+	const char* name;
+	VarType type;
+	volatile void* ptr;
+	float scale;
+	bool writable;
+};
+
+
+/**
+ * @brief Variable registry. Values are accessed as raw 32-bit words: 16-bit values are zero- or sign-extended,
+ * float values are passed as IEEE 754 bits. Table is provided by application and must outlive registry.
+ */
+class VarRegistry
+{
+private:
+	VarRegistry();					// no constructor
+	VarRegistry(const VarRegistry& other);		// no copy constructor
+	VarRegistry& operator=(const VarRegistry& other);	// no copy assignment operator
+
+private:
+	static const Var* _vars;
+	static size_t _count;
+
+public:
+	/**
+	 * @brief Sets variable table. Re-initialization replaces previous table.
+	 * @param vars - variable table
+	 * @param count - number of variables
+	 * @return (none)
+	 */
+	static void init(const Var* vars, size_t count)
+	{
+		_vars = vars;
+		_count = count;
+	}
+
+	static size_t count() { return _count; }
+
+	/**
+	 * @brief Returns registry entry.
+	 * @param id - variable ID
+	 * @return Pointer to entry, NULL if ID is invalid.
+	 */
+	static const Var* var(uint16_t id)
+	{
+		if (id >= _count) return static_cast<const Var*>(NULL);
+		return &_vars[id];
+	}
+
+	/**
+	 * @brief Finds variable by name.
+	 * @param name - variable name
+	 * @param id - variable ID
+	 * @return \c true if variable is found, \c false otherwise.
+	 */
+	static bool find(const char* name, uint16_t& id)
+	{
+		for (size_t i = 0; i < _count; ++i)
+		{
+			if (strcmp(_vars[i].name, name) == 0)
+			{
+				id = i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Reads variable.
+	 * @param id - variable ID, must be valid
+	 * @return Raw value.
+	 */
+	static uint32_t read(uint16_t id);
+
+	/**
+	 * @brief Writes variable.
+	 * @param id - variable ID, must be valid
+	 * @param raw - raw value, 16-bit values are truncated
+	 * @return \c true on success, \c false if variable is read-only.
+	 */
+	static bool write(uint16_t id, uint32_t raw);
+
+	/**
+	 * @brief Converts raw value to physical one with variable scale.
+	 * @param id - variable ID, must be valid
+	 * @param raw - raw value returned by read()
+	 * @return Scaled value.
+	 */
+	static float scaled(uint16_t id, uint32_t raw);
+};
+
+
+/// @}
+} // namespace sys
+
+
@@ -0,0 +1,100 @@
+/**
+ * @file varsampler.cpp
+ * @ingroup vars
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "varsampler.h"
+
+
+namespace sys {
+
+
+uint16_t VarSampler::_ids[VarSampler::capacity];
+uint32_t VarSampler::_values[VarSampler::capacity];
+size_t VarSampler::_count = 0;
+uint32_t VarSampler::_sequence = 0;
+size_t VarSampler::_taskIndex = mcu::chrono::SystemClock::invalidTask;
+
+
+///
+///
+///
+bool VarSampler::start(const uint16_t* ids, size_t count, uint64_t period_ms)
+{
+	stop();
+	if ((count == 0) || (count > capacity)) return false;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		_ids[i] = ids[i];
+	}
+	_count = count;
+	_sequence = 0;
+	_taskIndex = mcu::chrono::SystemClock::registerTask(_task, period_ms, "var_sampler");
+	return running();
+}
+
+
+///
+///
+///
+void VarSampler::stop()
+{
+	if (running())
+	{
+		mcu::chrono::SystemClock::cancelTask(_taskIndex);
+		_taskIndex = mcu::chrono::SystemClock::invalidTask;
+	}
+}
+
+
+///
+///
+///
+void VarSampler::sample()
+{
+	for (size_t i = 0; i < _count; ++i)
+	{
+		_values[i] = VarRegistry::read(_ids[i]);
+	}
+	++_sequence;
+}
+
+
+///
+///
+///
+bool VarSampler::take(uint32_t* values, uint32_t& sequence)
+{
+	if (sequence == _sequence) return false;
+
+	for (size_t i = 0; i < _count; ++i)
+	{
+		values[i] = _values[i];
+	}
+	sequence = _sequence;
+	return true;
+}
+
+
+///
+///
+///
+mcu::chrono::TaskStatus VarSampler::_task(size_t taskIndex)
+{
+	sample();
+	return mcu::chrono::TaskStatus::Success;
+}
+
+
+} // namespace sys
+
+
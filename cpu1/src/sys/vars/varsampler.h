@@ -0,0 +1,88 @@
+/**
+ * @file varsampler.h
+ * @ingroup vars
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include "mcu_f2837xd/chrono/mcu_chrono.h"
+
+#include "vars.h"
+
+
+namespace sys {
+/// @addtogroup vars
+/// @{
+
+
+/**
+ * @brief Periodic sampler of registry variables, e.g. for CLI watch command. Samples are taken by
+ * SystemClock task into static snapshot, consumer takes the latest one: if consumer is slower than
+ * sample rate (e.g. UART), intermediate samples are overwritten and never queued.
+ * Task and consumer run in superloop, so snapshot is consistent without locking.
+ */
+class VarSampler
+{
+public:
+	static const size_t capacity = 8;
+private:
+	VarSampler();					// no constructor
+	VarSampler(const VarSampler& other);		// no copy constructor
+	VarSampler& operator=(const VarSampler& other);	// no copy assignment operator
+
+private:
+	static uint16_t _ids[capacity];
+	static uint32_t _values[capacity];
+	static size_t _count;
+	static uint32_t _sequence;	// number of taken samples
+	static size_t _taskIndex;
+
+public:
+	/**
+	 * @brief Starts sampling, previous sampling is stopped.
+	 * @param ids - variable IDs, must be valid
+	 * @param count - number of variables, up to capacity
+	 * @param period_ms - sample period
+	 * @return \c true on success, \c false if count is invalid or task can't be registered.
+	 */
+	static bool start(const uint16_t* ids, size_t count, uint64_t period_ms);
+	static void stop();
+	static bool running() { return _taskIndex != mcu::chrono::SystemClock::invalidTask; }
+
+	static size_t count() { return _count; }
+	static uint16_t id(size_t index) { return _ids[index]; }
+
+	/**
+	 * @brief Takes one sample of all variables. Called by sampling task.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void sample();
+
+	/**
+	 * @brief Copies the latest sample if it is newer than consumer's one.
+	 * @param values - raw values, count() elements
+	 * @param sequence - sequence number of consumer's sample (0 - none), updated
+	 * @return \c true if new sample is copied, \c false otherwise.
+	 */
+	static bool take(uint32_t* values, uint32_t& sequence);
+private:
+	static mcu::chrono::TaskStatus _task(size_t taskIndex);
+};
+
+
+/// @}
+} // namespace sys
+
+
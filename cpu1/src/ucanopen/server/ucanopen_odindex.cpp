@@ -0,0 +1,150 @@
+/**
+ * @file ucanopen_odindex.cpp
+ * @ingroup ucanopen
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include <algorithm>
+#include "ucanopen_odindex.h"
+
+
+namespace ucanopen {
+
+
+namespace {
+
+
+int compareNames(const ODEntry* lhs, const ODEntry* rhs)
+{
+	int result = strcmp(lhs->value.category, rhs->value.category);
+	if (result != 0) return result;
+	result = strcmp(lhs->value.subcategory, rhs->value.subcategory);
+	if (result != 0) return result;
+	return strcmp(lhs->value.name, rhs->value.name);
+}
+
+
+/// Orders entry positions by entry names.
+struct NameLess
+{
+	const ODEntry* dictionary;
+	explicit NameLess(const ODEntry* dictionary_) : dictionary(dictionary_) {}
+	bool operator()(uint32_t lhs, uint32_t rhs) const { return compareNames(&dictionary[lhs], &dictionary[rhs]) < 0; }
+};
+
+
+bool accessValid(const ODEntry& entry)
+{
+	if (entry.hasReadAccess())
+	{
+		if ((entry.value.readAccessFunc == OD_NO_INDIRECT_READ_ACCESS)
+				&& (entry.value.dataPtr == OD_NO_DIRECT_ACCESS)) return false;
+	}
+	else
+	{
+		if ((entry.value.readAccessFunc != OD_NO_INDIRECT_READ_ACCESS)
+				|| (entry.value.dataPtr != OD_NO_DIRECT_ACCESS)) return false;
+	}
+
+	if (entry.hasWriteAccess())
+	{
+		if ((entry.value.writeAccessFunc == OD_NO_INDIRECT_WRITE_ACCESS)
+				&& (entry.value.dataPtr == OD_NO_DIRECT_ACCESS)) return false;
+	}
+	else
+	{
+		if ((entry.value.writeAccessFunc != OD_NO_INDIRECT_WRITE_ACCESS)
+				|| (entry.value.dataPtr != OD_NO_DIRECT_ACCESS)) return false;
+	}
+	return true;
+}
+
+
+} // namespace
+
+
+///
+///
+///
+bool ODIndex::init(ODEntry* dictionary, uint32_t* keyBuffer, size_t len)
+{
+	std::sort(dictionary, dictionary + len);
+
+#ifndef NDEBUG
+	bool valid = validate(dictionary, len, keyBuffer);	// before keys are built: buffer is scratch of name check
+#endif
+	for (size_t i = 0; i < len; ++i)
+	{
+		keyBuffer[i] = key(dictionary[i].key.index, dictionary[i].key.subindex);
+	}
+	_dictionary = dictionary;
+	_keys = keyBuffer;
+	_len = len;
+
+#ifdef NDEBUG
+	return true;
+#else
+	return valid;
+#endif
+}
+
+
+///
+///
+///
+bool ODIndex::init(const ODEntry* dictionary, const uint32_t* keys, size_t len)
+{
+	_dictionary = dictionary;
+	_keys = keys;
+	_len = len;
+
+#ifdef NDEBUG
+	return true;
+#else
+	for (size_t i = 0; i < len; ++i)
+	{
+		if (keys[i] != key(dictionary[i].key.index, dictionary[i].key.subindex)) return false;
+	}
+	return validate(dictionary, len, static_cast<uint32_t*>(NULL));
+#endif
+}
+
+
+///
+///
+///
+bool ODIndex::validate(const ODEntry* dictionary, size_t len, uint32_t* scratch)
+{
+	// key pass: dictionary is sorted, so equal keys are adjacent
+	for (size_t i = 0; i < len; ++i)
+	{
+		if ((dictionary[i].key.index > 0xFFFF) || (dictionary[i].key.subindex > 0xFF)) return false;
+		if ((i != 0) && !(dictionary[i-1] < dictionary[i])) return false;
+		if (!accessValid(dictionary[i])) return false;
+	}
+
+	// name pass: entry positions sorted by {category, subcategory, name}, equal names are adjacent
+	if (scratch == NULL) return true;
+	for (size_t i = 0; i < len; ++i)
+	{
+		scratch[i] = static_cast<uint32_t>(i);
+	}
+	std::sort(scratch, scratch + len, NameLess(dictionary));
+	for (size_t i = 1; i < len; ++i)
+	{
+		if (compareNames(&dictionary[scratch[i-1]], &dictionary[scratch[i]]) == 0) return false;
+	}
+	return true;
+}
+
+
+} // namespace ucanopen
+
+
@@ -0,0 +1,144 @@
+/**
+ * @file ucanopen_odindex.h
+ * @ingroup ucanopen
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include "../ucanopen_def.h"
+
+
+namespace ucanopen {
+/// @addtogroup ucanopen_server
+/// @{
+
+
+/**
+ * @brief Object dictionary passed to server. Hand-written table is sorted and indexed at init, key index is built
+ * in buffer provided with table (static array of table length), nothing is allocated.
+ * Table generated by scripts/odgen/odgen.py is const (placed in flash), sorted and validated by generator
+ * and comes with key index. Both tables are checked in debug build only.
+ */
+struct ODTable
+{
+	ODEntry* sortableEntries;	// hand-written table, NULL for generated one
+	uint32_t* keyBuffer;		// key index of hand-written table is built here, NULL for generated table
+	const ODEntry* entries;
+	const uint32_t* keys;		// generated key index, NULL for hand-written table
+	size_t len;
+
+	ODTable(ODEntry* entries_, uint32_t* keyBuffer_, size_t len_)
+		: sortableEntries(entries_), keyBuffer(keyBuffer_), entries(entries_), keys(static_cast<const uint32_t*>(NULL))
+		, len(len_) {}
+	ODTable(const ODEntry* entries_, const uint32_t* keys_, size_t len_)
+		: sortableEntries(static_cast<ODEntry*>(NULL)), keyBuffer(static_cast<uint32_t*>(NULL)), entries(entries_)
+		, keys(keys_), len(len_) {}
+};
+
+
+/**
+ * @brief Object dictionary index: sorted array of packed keys (index << 8 | subindex) parallel to sorted entry table.
+ * Lookup is branchless binary search over keys only, entry table is touched once when key is found.
+ */
+class ODIndex
+{
+private:
+	const ODEntry* _dictionary;
+	const uint32_t* _keys;
+	size_t _len;
+private:
+	ODIndex(const ODIndex& other);			// no copy constructor
+	ODIndex& operator=(const ODIndex& other);	// no copy assignment operator
+public:
+	ODIndex()
+		: _dictionary(static_cast<const ODEntry*>(NULL))
+		, _keys(static_cast<const uint32_t*>(NULL))
+		, _len(0)
+	{}
+
+	static uint32_t key(uint32_t index, uint32_t subindex) { return (index << 8) | subindex; }
+
+	/**
+	 * @brief Sorts object dictionary and builds key array. Dictionary is validated in debug build only,
+	 * key buffer is used as scratch of name check before keys are built.
+	 * @param dictionary - object dictionary, must outlive index
+	 * @param keyBuffer - key array of len elements, must outlive index
+	 * @param len - number of entries
+	 * @return \c true if dictionary is valid or check is disabled, \c false otherwise.
+	 */
+	bool init(ODEntry* dictionary, uint32_t* keyBuffer, size_t len);
+
+	/**
+	 * @brief Uses generated dictionary and key index, nothing is sorted or allocated.
+	 * Dictionary and keys are validated in debug build only, names are checked by generator.
+	 * @param dictionary - generated object dictionary, sorted by key
+	 * @param keys - generated key index
+	 * @param len - number of entries
+	 * @return \c true if dictionary is valid or check is disabled, \c false otherwise.
+	 */
+	bool init(const ODEntry* dictionary, const uint32_t* keys, size_t len);
+
+	/**
+	 * @brief Initializes index with hand-written or generated dictionary.
+	 * @param table - object dictionary
+	 * @return \c true if dictionary is valid, \c false otherwise.
+	 */
+	bool init(const ODTable& table)
+	{
+		if (table.keys == NULL)
+		{
+			return init(table.sortableEntries, table.keyBuffer, table.len);
+		}
+		return init(table.entries, table.keys, table.len);
+	}
+
+	/**
+	 * @brief Checks sorted object dictionary: keys are unique and fit 16-bit index and 8-bit subindex,
+	 * access functions and pointers match access rights - in O(N);
+	 * {category, subcategory, name} are unique - in O(N log N), if scratch is provided.
+	 * @param dictionary - object dictionary sorted by key
+	 * @param len - number of entries
+	 * @param scratch - array of len elements for entry order by name, NULL - names are not checked
+	 * @return \c true if dictionary is valid, \c false otherwise.
+	 */
+	static bool validate(const ODEntry* dictionary, size_t len, uint32_t* scratch);
+
+	/**
+	 * @brief Finds entry.
+	 * @param index - object index
+	 * @param subindex - object subindex
+	 * @return Pointer to entry, NULL if entry is not found.
+	 */
+	const ODEntry* find(uint32_t index, uint32_t subindex) const
+	{
+		if (_len == 0) return static_cast<const ODEntry*>(NULL);
+
+		const uint32_t k = key(index, subindex);
+		const uint32_t* base = _keys;
+		size_t n = _len;
+		while (n > 1)
+		{
+			size_t half = n / 2;
+			base = (base[half] <= k) ? base + half : base;	// conditional move, no branch on data
+			n -= half;
+		}
+		return (*base == k) ? _dictionary + (base - _keys) : static_cast<const ODEntry*>(NULL);
+	}
+
+	size_t size() const { return _len; }
+};
+
+
+/// @}
+} // namespace ucanopen
+
+
@@ -0,0 +1,142 @@
+/**
+ * @file ucanopen_pdomapping.cpp
+ * @ingroup ucanopen
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "ucanopen_pdomapping.h"
+
+
+namespace ucanopen {
+
+
+namespace {
+
+
+/// Number of value bits of OD entry data types, 0 - type can not be mapped
+const unsigned int odEntryDataBits[10] = {1, 16, 32, 16, 32, 32, 16, 0, 0, 0};
+
+
+/// Dummy entries (CiA 301 data type indices) fill gaps of RPDO
+bool isDummy(uint32_t index) { return (index >= 0x0001) && (index <= 0x0007); }
+
+
+} // namespace
+
+
+///
+///
+///
+bool PdoMapping::map(const ODIndex& odIndex, PdoDirection direction, const uint32_t* parameters, unsigned int count)
+{
+	_count = 0;
+	_bitLength = 0;
+	if (count > maxEntries) return false;
+
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		_parameters[i] = parameters[i];
+	}
+	return (count == 0) || _compile(odIndex, direction, count);
+}
+
+
+///
+///
+///
+ODAccessStatus PdoMapping::read(uint32_t subindex, CobSdoData& dest) const
+{
+	if (subindex == 0)
+	{
+		dest.u32 = _count;
+		return ODAccessStatus::Success;
+	}
+	if (subindex > maxEntries) return ODAccessStatus::NoAccess;
+
+	dest.u32 = _parameters[subindex - 1];
+	return ODAccessStatus::Success;
+}
+
+
+///
+///
+///
+ODAccessStatus PdoMapping::write(const ODIndex& odIndex, PdoDirection direction, uint32_t subindex, CobSdoData val)
+{
+	if (subindex > maxEntries) return ODAccessStatus::NoAccess;
+
+	if (subindex == 0)
+	{
+		if (val.u32 == 0)
+		{
+			_count = 0;
+			_bitLength = 0;
+			return ODAccessStatus::Success;
+		}
+		if ((_count != 0) || (val.u32 > maxEntries)) return ODAccessStatus::Fail;
+		return _compile(odIndex, direction, val.u32) ? ODAccessStatus::Success : ODAccessStatus::Fail;
+	}
+
+	if (_count != 0) return ODAccessStatus::Fail;	// mapping must be disabled first
+	_parameters[subindex - 1] = val.u32;
+	return ODAccessStatus::Success;
+}
+
+
+///
+///
+///
+bool PdoMapping::_compile(const ODIndex& odIndex, PdoDirection direction, unsigned int count)
+{
+	unsigned int offset = 0;
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		uint32_t index = _parameters[i] >> 16;
+		uint32_t subindex = (_parameters[i] >> 8) & 0xFF;
+		unsigned int length = _parameters[i] & 0xFF;
+		if ((length == 0) || (length > 32) || (offset + length > maxBitLength)) return false;
+
+		PdoCopyOp& op = _program[i];
+		op.shift = offset;
+		op.mask = static_cast<uint32_t>(0xFFFFFFFF) >> (32 - length);
+		offset += length;
+
+		if (isDummy(index))
+		{
+			if (direction == PdoDirection::Transmit) return false;
+			op.data = &_scratch;
+			op.size = 0;
+			op.extend = 0;
+			continue;
+		}
+
+		const ODEntry* entry = odIndex.find(index, subindex);
+		if (entry == NULL) return false;
+
+		const ODEntryDataType type = entry->value.dataType;
+		if ((entry->value.dataPtr == OD_NO_DIRECT_ACCESS) || (odEntryDataBits[type] == 0)) return false;
+		if ((direction == PdoDirection::Transmit) ? !entry->hasReadAccess() : !entry->hasWriteAccess()) return false;
+		if (length > odEntryDataBits[type]) return false;
+		if ((type == OD_FLOAT32) && (length != 32)) return false;
+
+		op.data = entry->value.dataPtr;
+		op.size = odEntryDataSizes[type];
+		op.extend = ((type == OD_INT16) || (type == OD_INT32)) ? 32 - length : 0;
+	}
+
+	_count = count;
+	_bitLength = offset;
+	return true;
+}
+
+
+} // namespace ucanopen
+
+
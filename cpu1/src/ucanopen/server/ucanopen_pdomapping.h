@@ -0,0 +1,189 @@
+/**
+ * @file ucanopen_pdomapping.h
+ * @ingroup ucanopen
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include "../ucanopen_def.h"
+#include "ucanopen_odindex.h"
+
+
+namespace ucanopen {
+/// @addtogroup ucanopen_server
+/// @{
+
+
+/// PDO direction: mapped objects of TPDO must be readable, of RPDO - writable
+SCOPED_ENUM_DECLARE_BEGIN(PdoDirection)
+{
+	Transmit,
+	Receive
+}
+SCOPED_ENUM_DECLARE_END(PdoDirection)
+
+
+// PDO transmission types (CiA 301 communication parameter, subindex 2)
+namespace pdo_transmission {
+const unsigned int syncAcyclic = 0x00;	// on SYNC if mapped data are changed
+const unsigned int syncMax = 0xF0;	// 1..240 - on every n-th SYNC
+const unsigned int rtrSync = 0xFC;	// data are sampled on SYNC and sent on RTR
+const unsigned int rtrEvent = 0xFD;	// data are sampled and sent on RTR
+const unsigned int cyclic = 0xFE;	// on event timer
+const unsigned int onChange = 0xFF;	// on change of mapped data not faster than inhibit time, on event timer if it is set
+}
+
+
+/// Invalid bit of PDO COB-ID (communication parameter, subindex 1)
+const uint32_t pdoCobIdInvalid = 0x80000000;
+
+
+/**
+ * @brief Makes CiA-301 mapping parameter.
+ * @param index - mapped object index, 0x0001..0x0007 - dummy entry (RPDO gap)
+ * @param subindex - mapped object subindex
+ * @param bitLength - mapped length, bits
+ * @return Mapping parameter.
+ */
+inline uint32_t pdoMappingParameter(uint32_t index, uint32_t subindex, uint32_t bitLength)
+{
+	return (index << 16) | ((subindex & 0xFF) << 8) | (bitLength & 0xFF);
+}
+
+
+/**
+ * @brief Copy operation of compiled mapping: object value <-> bit field of PDO.
+ */
+struct PdoCopyOp
+{
+	void* data;		// object data, scratch word for dummy entry
+	size_t size;		// object size (sizeof units), 0 for dummy entry
+	unsigned int shift;	// bit offset in PDO
+	uint32_t mask;		// bit length mask
+	unsigned int extend;	// sign extension shift of received value, 0 for unsigned objects
+};
+
+
+/**
+ * @brief PDO mapping: up to 8 mapping parameters (index, subindex, bit length) and copy program compiled from them.
+ * Mapped fields are consecutive bit fields from bit 0 of PDO, multi-octet values are little-endian.
+ * Program is compiled when mapping is enabled (number of entries is set), so pack and unpack are
+ * a fixed sequence of copy-mask-shift operations without lookup or branching on data type.
+ * Only objects with direct access (data pointer) can be mapped.
+ */
+class PdoMapping
+{
+public:
+	static const unsigned int maxEntries = 8;
+	static const unsigned int maxBitLength = 64;
+private:
+	emb::Array<uint32_t, maxEntries> _parameters;
+	emb::Array<PdoCopyOp, maxEntries> _program;
+	unsigned int _count;
+	unsigned int _bitLength;
+	uint32_t _scratch;
+private:
+	PdoMapping(const PdoMapping& other);			// no copy constructor
+	PdoMapping& operator=(const PdoMapping& other);	// no copy assignment operator
+public:
+	PdoMapping()
+		: _count(0)
+		, _bitLength(0)
+		, _scratch(0)
+	{
+		_parameters.fill(0);
+	}
+
+	/**
+	 * @brief Maps objects, replaces current mapping.
+	 * @param odIndex - object dictionary
+	 * @param direction - PDO direction
+	 * @param parameters - mapping parameters, see pdoMappingParameter()
+	 * @param count - number of parameters, 0 disables mapping
+	 * @return \c true if mapping is valid and enabled, \c false otherwise (mapping is disabled).
+	 */
+	bool map(const ODIndex& odIndex, PdoDirection direction, const uint32_t* parameters, unsigned int count);
+
+	/**
+	 * @brief Reads mapping object (CiA 301: 0x1600+n for RPDO, 0x1A00+n for TPDO).
+	 * @param subindex - 0 - number of entries, 1..8 - mapping parameters
+	 * @param dest - value
+	 * @return Access status.
+	 */
+	ODAccessStatus read(uint32_t subindex, CobSdoData& dest) const;
+
+	/**
+	 * @brief Writes mapping object. Parameters can be changed while mapping is disabled (number of entries is 0),
+	 * writing non-zero number of entries validates parameters and compiles program.
+	 * @param odIndex - object dictionary
+	 * @param direction - PDO direction
+	 * @param subindex - 0 - number of entries, 1..8 - mapping parameters
+	 * @param val - value
+	 * @return Access status.
+	 */
+	ODAccessStatus write(const ODIndex& odIndex, PdoDirection direction, uint32_t subindex, CobSdoData val);
+
+	bool enabled() const { return _count != 0; }
+	unsigned int count() const { return _count; }
+	unsigned int bitLength() const { return _bitLength; }
+	unsigned int length() const { return (_bitLength + 7) / 8; }	// PDO data length, octets
+
+	/**
+	 * @brief Packs mapped objects into PDO data, unused octets are zeroed.
+	 * @param payload - PDO data
+	 * @return (none)
+	 */
+	void pack(can_payload& payload) const
+	{
+		uint64_t frame = 0;
+		for (unsigned int i = 0; i < _count; ++i)
+		{
+			const PdoCopyOp& op = _program[i];
+			uint32_t value = 0;
+			memcpy(&value, op.data, op.size);
+			frame |= static_cast<uint64_t>(value & op.mask) << op.shift;
+		}
+		for (size_t i = 0; i < payload.size(); ++i)
+		{
+			payload[i] = (frame >> (8 * i)) & 0xFF;
+		}
+	}
+
+	/**
+	 * @brief Unpacks PDO data into mapped objects, dummy entries are skipped.
+	 * @param payload - PDO data
+	 * @return (none)
+	 */
+	void unpack(const can_payload& payload)
+	{
+		uint64_t frame = 0;
+		for (size_t i = 0; i < payload.size(); ++i)
+		{
+			frame |= static_cast<uint64_t>(payload[i] & 0xFF) << (8 * i);
+		}
+		for (unsigned int i = 0; i < _count; ++i)
+		{
+			const PdoCopyOp& op = _program[i];
+			uint32_t value = static_cast<uint32_t>(frame >> op.shift) & op.mask;
+			value = static_cast<uint32_t>(static_cast<int32_t>(value << op.extend) >> op.extend);
+			memcpy(op.data, &value, op.size);
+		}
+	}
+private:
+	bool _compile(const ODIndex& odIndex, PdoDirection direction, unsigned int count);
+};
+
+
+/// @}
+} // namespace ucanopen
+
+
@@ -0,0 +1,221 @@
+/**
+ * @file ucanopen_rxqueue.h
+ * @ingroup ucanopen
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include "../ucanopen_def.h"
+
+
+namespace ucanopen {
+/// @addtogroup ucanopen_server
+/// @{
+
+
+/// Receive queue policy
+SCOPED_ENUM_DECLARE_BEGIN(RxQueuePolicy)
+{
+	Fifo,		// frames are handled in order, frame is dropped if queue is full
+	LatestValue	// only the newest frame is handled, older ones are superseded
+}
+SCOPED_ENUM_DECLARE_END(RxQueuePolicy)
+
+
+/// Receive queue statistics
+struct RxQueueStats
+{
+	uint32_t received;
+	uint32_t highWater;	// max number of frames waiting in queue
+	uint32_t dropped;	// frames lost on full queue or superseded by newer ones
+};
+
+
+namespace impl {
+
+
+/**
+ * @brief Producer side of receive queue: frames and counters written by CAN ISR only.
+ * In dual-core mode it is placed in shared RAM owned by primary core.
+ */
+template <size_t Depth>
+struct RxQueueBuffer
+{
+	can_payload frames[Depth];
+	volatile uint32_t head;		// frames received, free-running
+	volatile uint32_t highWater;
+	volatile uint32_t dropped;
+	volatile uint32_t policy;
+};
+
+
+/**
+ * @brief Consumer side of receive queue: counters written by server run() only.
+ * In dual-core mode it is placed in shared RAM owned by secondary core.
+ */
+struct RxQueueCursor
+{
+	volatile uint32_t tail;		// frames taken, free-running
+	volatile uint32_t superseded;
+};
+
+
+} // namespace impl
+
+
+/**
+ * @brief Lock-free single-producer single-consumer queue of received frames. Producer (CAN ISR) and consumer
+ * (server run() on the same or the other core) write separate structures, so queue works across cores
+ * with shared RAM where each block is writable by one core only. ISR receives frame directly into queue slot.
+ * FIFO queue drops new frame when it is full. Latest-value queue is never full: producer overwrites the oldest slot,
+ * consumer copies the newest frame and repeats copy if producer could reach the slot meanwhile.
+ */
+template <size_t Depth>
+class RxQueue
+{
+	EMB_STATIC_ASSERT((Depth & (Depth - 1)) == 0);
+private:
+	impl::RxQueueBuffer<Depth>* _buffer;
+	impl::RxQueueCursor* _cursor;
+private:
+	RxQueue(const RxQueue& other);			// no copy constructor
+	RxQueue& operator=(const RxQueue& other);	// no copy assignment operator
+public:
+	RxQueue()
+		: _buffer(static_cast<impl::RxQueueBuffer<Depth>*>(NULL))
+		, _cursor(static_cast<impl::RxQueueCursor*>(NULL))
+	{}
+
+	void attach(impl::RxQueueBuffer<Depth>* buffer, impl::RxQueueCursor* cursor)
+	{
+		_buffer = buffer;
+		_cursor = cursor;
+	}
+
+	/**
+	 * @brief Resets producer side. Must be called by core that owns buffer.
+	 * @param (none)
+	 * @return (none)
+	 */
+	void initProducer()
+	{
+		_buffer->head = 0;
+		_buffer->highWater = 0;
+		_buffer->dropped = 0;
+		_buffer->policy = RxQueuePolicy::Fifo;
+	}
+
+	/**
+	 * @brief Resets consumer side. Must be called by core that owns cursor.
+	 * @param (none)
+	 * @return (none)
+	 */
+	void initConsumer()
+	{
+		_cursor->tail = 0;
+		_cursor->superseded = 0;
+	}
+
+	void setPolicy(RxQueuePolicy policy)
+	{
+		EMB_STATIC_ASSERT(Depth >= 2);
+		_buffer->policy = policy.underlying_value();
+	}
+
+	RxQueuePolicy policy() const { return static_cast<RxQueuePolicy::enum_type>(_buffer->policy); }
+	size_t depth() const { return Depth; }
+
+	/**
+	 * @brief Returns slot for received frame. Producer side, must be followed by commit() if slot is returned.
+	 * @param (none)
+	 * @return Pointer to slot, NULL if FIFO queue is full (frame is counted as dropped).
+	 */
+	can_payload* reserve()
+	{
+		uint32_t head = _buffer->head;
+		if ((_buffer->policy == RxQueuePolicy::Fifo) && (head - _cursor->tail == Depth))
+		{
+			_buffer->dropped = _buffer->dropped + 1;
+			return static_cast<can_payload*>(NULL);
+		}
+		return &_buffer->frames[head & (Depth - 1)];
+	}
+
+	/**
+	 * @brief Publishes frame written to reserved slot. Producer side.
+	 * @param (none)
+	 * @return (none)
+	 */
+	void commit()
+	{
+		uint32_t head = _buffer->head + 1;
+		EMB_COMPILER_BARRIER();
+		_buffer->head = head;		// frame is published after it is written
+		uint32_t size = head - _cursor->tail;
+		size = (size < Depth) ? size : Depth;
+		if (size > _buffer->highWater)
+		{
+			_buffer->highWater = size;
+		}
+	}
+
+	/**
+	 * @brief Takes frame from queue: the oldest one for FIFO queue, the newest one for latest-value queue.
+	 * Consumer side.
+	 * @param frame - frame
+	 * @return \c true if frame is taken, \c false if queue is empty.
+	 */
+	bool pop(can_payload& frame)
+	{
+		uint32_t tail = _cursor->tail;
+		uint32_t head = _buffer->head;
+		if (head == tail) return false;
+		EMB_COMPILER_BARRIER();
+
+		if (_buffer->policy == RxQueuePolicy::Fifo)
+		{
+			frame = _buffer->frames[tail & (Depth - 1)];
+			EMB_COMPILER_BARRIER();
+			_cursor->tail = tail + 1;	// slot is released after it is read
+			return true;
+		}
+
+		while (true)
+		{
+			frame = _buffer->frames[(head - 1) & (Depth - 1)];
+			EMB_COMPILER_BARRIER();
+			uint32_t current = _buffer->head;
+			if (current - head < Depth - 1) break;	// slot could not be overwritten during copy
+			head = current;
+		}
+		_cursor->superseded = _cursor->superseded + (head - tail - 1);
+		_cursor->tail = head;
+		return true;
+	}
+
+	bool empty() const { return _buffer->head == _cursor->tail; }
+
+	RxQueueStats stats() const
+	{
+		RxQueueStats stats;
+		stats.received = _buffer->head;
+		stats.highWater = _buffer->highWater;
+		stats.dropped = _buffer->dropped + _cursor->superseded;
+		return stats;
+	}
+};
+
+
+/// @}
+} // namespace ucanopen
+
+
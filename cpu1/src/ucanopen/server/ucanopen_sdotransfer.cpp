@@ -0,0 +1,473 @@
+/**
+ * @file ucanopen_sdotransfer.cpp
+ * @ingroup ucanopen
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "ucanopen_sdotransfer.h"
+#include "emb/emb_crc.h"
+
+
+namespace ucanopen {
+
+
+namespace {
+
+
+const size_t segmentSize = 7;	// data octets in segment
+
+
+uint32_t getU32(const can_payload& payload, size_t pos)
+{
+	return (payload[pos] & 0xFF)
+			| (static_cast<uint32_t>(payload[pos+1] & 0xFF) << 8)
+			| (static_cast<uint32_t>(payload[pos+2] & 0xFF) << 16)
+			| (static_cast<uint32_t>(payload[pos+3] & 0xFF) << 24);
+}
+
+
+void putU32(can_payload& payload, size_t pos, uint32_t value)
+{
+	payload[pos] = value & 0xFF;
+	payload[pos+1] = (value >> 8) & 0xFF;
+	payload[pos+2] = (value >> 16) & 0xFF;
+	payload[pos+3] = (value >> 24) & 0xFF;
+}
+
+
+size_t minSize(size_t a, size_t b) { return (a < b) ? a : b; }
+
+
+} // namespace
+
+
+///
+///
+///
+SdoResult SdoTransfer::handleRequest(const can_payload& rsdo, const ODIndex& odIndex, can_payload& tsdo, uint64_t now)
+{
+	unsigned int command = rsdo[0] & 0xFF;
+	_timepoint = now;
+
+	// block download segments have no command specifier: last-segment flag and sequence number only
+	if ((_state == SdoTransferState::BlockDownload) && (command != (cs_codes::sdoCsAbort << 5)))
+	{
+		return _blockDownloadSegment(command, rsdo, tsdo);
+	}
+
+	unsigned int ccs = command >> 5;
+	bool initiate = (ccs == cs_codes::sdoCcsWrite)
+			|| (ccs == cs_codes::sdoCcsRead)
+			|| ((ccs == cs_codes::sdoCcsBlockUpload) && ((command & 0x03) == 0))
+			|| ((ccs == cs_codes::sdoCcsBlockDownload) && ((command & 0x01) == 0));
+
+	const ODEntry* entry = static_cast<const ODEntry*>(NULL);
+	if (initiate)
+	{
+		_state = SdoTransferState::Idle;	// new transfer cancels active one
+		_index = (rsdo[1] & 0xFF) | ((rsdo[2] & 0xFF) << 8);
+		_subindex = rsdo[3] & 0xFF;
+		entry = odIndex.find(_index, _subindex);
+
+		if ((ccs == cs_codes::sdoCcsWrite) || (ccs == cs_codes::sdoCcsRead))
+		{
+			if ((entry == NULL) || (entry->value.dataType != OD_DOMAIN)) return SdoResult::Expedited;
+		}
+		else if (entry == NULL)
+		{
+			return _abort(sdo_abort_codes::objectNotFound, tsdo);
+		}
+		else if (entry->value.dataType != OD_DOMAIN)
+		{
+			return _abort(sdo_abort_codes::unsupportedAccess, tsdo);
+		}
+	}
+
+	switch (ccs)
+	{
+	case cs_codes::sdoCcsRead:
+		return _initiateUpload(entry, tsdo);
+	case cs_codes::sdoCcsWrite:
+		return _initiateDownload(command, rsdo, entry, tsdo);
+	case cs_codes::sdoCcsUploadSegment:
+		return _uploadSegment(command, tsdo);
+	case cs_codes::sdoCcsDownloadSegment:
+		return _downloadSegment(command, rsdo, tsdo);
+	case cs_codes::sdoCcsBlockUpload:
+		return _blockUpload(command, rsdo, entry, tsdo);
+	case cs_codes::sdoCcsBlockDownload:
+		return _blockDownload(command, rsdo, entry, tsdo);
+	case cs_codes::sdoCsAbort:
+		_state = SdoTransferState::Idle;
+		return SdoResult::NoResponse;
+	default:
+		return _abort(sdo_abort_codes::invalidCommand, tsdo);
+	}
+}
+
+
+///
+///
+///
+bool SdoTransfer::poll(can_payload& tsdo, uint64_t now)
+{
+	if (_state == SdoTransferState::Idle) return false;
+
+	if (now - _timepoint >= timeout_ms)
+	{
+		_abort(sdo_abort_codes::timeout, tsdo);
+		return true;
+	}
+
+	if (_state != SdoTransferState::BlockUpload) return false;
+
+	// next segment of sub-block, segments after last acknowledged one are sent again after short acknowledgment
+	++_seqno;
+	size_t pos = _blockStart + (_seqno - 1) * segmentSize;
+	size_t len = minSize(segmentSize, _size - pos);
+	bool last = (pos + len == _size);
+
+	tsdo.fill(0);
+	tsdo[0] = (last ? 0x80 : 0x00) | _seqno;
+	for (size_t i = 0; i < len; ++i)
+	{
+		tsdo[1+i] = _domain->octet(pos + i);
+	}
+
+	if (last || (_seqno == _blockSize))
+	{
+		_state = SdoTransferState::BlockUploadAck;
+	}
+	_timepoint = now;
+	return true;
+}
+
+
+///
+///
+///
+SdoResult SdoTransfer::_initiateUpload(const ODEntry* entry, can_payload& tsdo)
+{
+	if (!entry->hasReadAccess()) return _abort(sdo_abort_codes::writeOnly, tsdo);
+
+	_start(SdoTransferState::SegmentedUpload, entry);
+	_size = minSize(_domain->size, _domain->capacity);
+	_writeHeader((cs_codes::sdoScsRead << 5) | 0x01, tsdo);	// size indicated
+	putU32(tsdo, 4, _size);
+	return SdoResult::Response;
+}
+
+
+///
+///
+///
+SdoResult SdoTransfer::_initiateDownload(unsigned int command, const can_payload& rsdo, const ODEntry* entry, can_payload& tsdo)
+{
+	if (!entry->hasWriteAccess()) return _abort(sdo_abort_codes::readOnly, tsdo);
+
+	_start(SdoTransferState::SegmentedDownload, entry);
+	if ((command & 0x02) != 0)
+	{
+		// expedited download of up to 4 octets
+		size_t len = ((command & 0x01) != 0) ? 4 - ((command >> 2) & 0x03) : 4;
+		if (len > _domain->capacity) return _abort(sdo_abort_codes::lengthTooHigh, tsdo);
+		for (size_t i = 0; i < len; ++i)
+		{
+			_domain->setOctet(i, rsdo[4+i]);
+		}
+		_domain->size = len;
+		_state = SdoTransferState::Idle;
+	}
+	else
+	{
+		_sizeIndicated = ((command & 0x01) != 0);
+		_size = _sizeIndicated ? getU32(rsdo, 4) : _domain->capacity;
+		if (_size > _domain->capacity) return _abort(sdo_abort_codes::lengthTooHigh, tsdo);
+	}
+
+	_writeHeader(cs_codes::sdoScsWrite << 5, tsdo);
+	return SdoResult::Response;
+}
+
+
+///
+///
+///
+SdoResult SdoTransfer::_uploadSegment(unsigned int command, can_payload& tsdo)
+{
+	if (_state != SdoTransferState::SegmentedUpload) return _abort(sdo_abort_codes::invalidCommand, tsdo);
+
+	bool toggle = ((command >> 4) & 0x01) != 0;
+	if (toggle != _toggle) return _abort(sdo_abort_codes::toggleBit, tsdo);
+
+	size_t len = minSize(segmentSize, _size - _offset);
+	bool last = (_offset + len == _size);
+
+	tsdo.fill(0);
+	tsdo[0] = (cs_codes::sdoScsUploadSegment << 5) | (toggle << 4) | ((segmentSize - len) << 1) | (last ? 0x01 : 0x00);
+	for (size_t i = 0; i < len; ++i)
+	{
+		tsdo[1+i] = _domain->octet(_offset + i);
+	}
+
+	_offset += len;
+	_toggle = !_toggle;
+	if (last)
+	{
+		_state = SdoTransferState::Idle;
+	}
+	return SdoResult::Response;
+}
+
+
+///
+///
+///
+SdoResult SdoTransfer::_downloadSegment(unsigned int command, const can_payload& rsdo, can_payload& tsdo)
+{
+	if (_state != SdoTransferState::SegmentedDownload) return _abort(sdo_abort_codes::invalidCommand, tsdo);
+
+	bool toggle = ((command >> 4) & 0x01) != 0;
+	if (toggle != _toggle) return _abort(sdo_abort_codes::toggleBit, tsdo);
+
+	size_t len = segmentSize - ((command >> 1) & 0x07);
+	bool last = (command & 0x01) != 0;
+	if (_offset + len > _size)
+	{
+		return _abort(_sizeIndicated ? sdo_abort_codes::lengthMismatch : sdo_abort_codes::lengthTooHigh, tsdo);
+	}
+	if (last && _sizeIndicated && (_offset + len != _size)) return _abort(sdo_abort_codes::lengthMismatch, tsdo);
+
+	for (size_t i = 0; i < len; ++i)
+	{
+		_domain->setOctet(_offset + i, rsdo[1+i]);
+	}
+	_offset += len;
+	_toggle = !_toggle;
+	if (last)
+	{
+		_domain->size = _offset;
+		_state = SdoTransferState::Idle;
+	}
+
+	tsdo.fill(0);
+	tsdo[0] = (cs_codes::sdoScsDownloadSegment << 5) | (toggle << 4);
+	return SdoResult::Response;
+}
+
+
+///
+///
+///
+SdoResult SdoTransfer::_blockUpload(unsigned int command, const can_payload& rsdo, const ODEntry* entry, can_payload& tsdo)
+{
+	switch (command & 0x03)
+	{
+	case 0:	// initiate
+	{
+		if (!entry->hasReadAccess()) return _abort(sdo_abort_codes::writeOnly, tsdo);
+		unsigned int blockSize = rsdo[4] & 0xFF;
+		if ((blockSize == 0) || (blockSize > SdoTransfer::blockSize)) return _abort(sdo_abort_codes::invalidBlockSize, tsdo);
+
+		_start(SdoTransferState::BlockUploadInitiated, entry);
+		_size = minSize(_domain->size, _domain->capacity);
+		_crcEnabled = ((command >> 2) & 0x01) != 0;
+		_blockSize = blockSize;
+		_writeHeader((cs_codes::sdoScsBlockUpload << 5) | 0x04 | 0x02, tsdo);	// server CRC support, size indicated
+		putU32(tsdo, 4, _size);
+		return SdoResult::Response;
+	}
+
+	case 3:	// start upload
+		if (_state != SdoTransferState::BlockUploadInitiated) return _abort(sdo_abort_codes::invalidCommand, tsdo);
+		_state = SdoTransferState::BlockUpload;
+		return SdoResult::NoResponse;
+
+	case 2:	// sub-block acknowledgment
+	{
+		if ((_state != SdoTransferState::BlockUpload) && (_state != SdoTransferState::BlockUploadAck))
+		{
+			return _abort(sdo_abort_codes::invalidCommand, tsdo);
+		}
+		unsigned int ackseq = rsdo[1] & 0xFF;
+		unsigned int blockSize = rsdo[2] & 0xFF;
+		if (ackseq > _seqno) return _abort(sdo_abort_codes::invalidSequenceNumber, tsdo);
+		if ((blockSize == 0) || (blockSize > SdoTransfer::blockSize)) return _abort(sdo_abort_codes::invalidBlockSize, tsdo);
+
+		size_t remaining = _size - _blockStart;
+		size_t acked = minSize(ackseq * segmentSize, remaining);
+		bool complete = (ackseq != 0) && (ackseq * segmentSize >= remaining);
+		_updateCrc(_blockStart, _blockStart + acked);
+		_offset = _blockStart + acked;
+		_blockStart = _offset;
+		_blockSize = blockSize;
+		_seqno = 0;
+
+		if (!complete)
+		{
+			_state = SdoTransferState::BlockUpload;
+			return SdoResult::NoResponse;
+		}
+
+		size_t lastLen = (_size == 0) ? 0 : ((_size - 1) % segmentSize) + 1;
+		tsdo.fill(0);
+		tsdo[0] = (cs_codes::sdoScsBlockUpload << 5) | ((segmentSize - lastLen) << 2) | 0x01;
+		tsdo[1] = _crc & 0xFF;
+		tsdo[2] = _crc >> 8;
+		_state = SdoTransferState::BlockUploadEnd;
+		return SdoResult::Response;
+	}
+
+	default:	// end response
+		if (_state != SdoTransferState::BlockUploadEnd) return _abort(sdo_abort_codes::invalidCommand, tsdo);
+		_state = SdoTransferState::Idle;
+		return SdoResult::NoResponse;
+	}
+}
+
+
+///
+///
+///
+SdoResult SdoTransfer::_blockDownload(unsigned int command, const can_payload& rsdo, const ODEntry* entry, can_payload& tsdo)
+{
+	if ((command & 0x01) == 0)	// initiate
+	{
+		if (!entry->hasWriteAccess()) return _abort(sdo_abort_codes::readOnly, tsdo);
+
+		_start(SdoTransferState::BlockDownload, entry);
+		_crcEnabled = ((command >> 2) & 0x01) != 0;
+		_sizeIndicated = ((command >> 1) & 0x01) != 0;
+		_size = _sizeIndicated ? getU32(rsdo, 4) : _domain->capacity;
+		if (_size > _domain->capacity) return _abort(sdo_abort_codes::lengthTooHigh, tsdo);
+		_blockSize = blockSize;
+
+		_writeHeader((cs_codes::sdoScsBlockDownload << 5) | 0x04, tsdo);	// server CRC support
+		tsdo[4] = _blockSize;
+		return SdoResult::Response;
+	}
+
+	// end: octets of last segment that do not contain data are known only now
+	if (_state != SdoTransferState::BlockDownloadEnd) return _abort(sdo_abort_codes::invalidCommand, tsdo);
+	size_t unused = (command >> 2) & 0x07;
+	size_t len = _offset - unused;
+	if (len > _domain->capacity) return _abort(sdo_abort_codes::lengthTooHigh, tsdo);
+	if (_sizeIndicated && (len != _size)) return _abort(sdo_abort_codes::lengthMismatch, tsdo);
+	_updateCrc(_offset - segmentSize, len);
+	if (_crcEnabled && (_crc != ((rsdo[1] & 0xFF) | ((rsdo[2] & 0xFF) << 8)))) return _abort(sdo_abort_codes::crcError, tsdo);
+
+	_domain->size = len;
+	_state = SdoTransferState::Idle;
+	tsdo.fill(0);
+	tsdo[0] = (cs_codes::sdoScsBlockDownload << 5) | 0x01;
+	return SdoResult::Response;
+}
+
+
+///
+///
+///
+SdoResult SdoTransfer::_blockDownloadSegment(unsigned int command, const can_payload& rsdo, can_payload& tsdo)
+{
+	unsigned int seqno = command & 0x7F;
+	bool last = (command & 0x80) != 0;
+	bool inOrder = (seqno == _seqno + 1);
+
+	// segment out of order is dropped, client repeats sub-block from the first segment after acknowledged one
+	if (inOrder)
+	{
+		if (!last && (_offset + segmentSize > _domain->capacity)) return _abort(sdo_abort_codes::lengthTooHigh, tsdo);
+
+		// CRC of previous segment: padding of the last segment is known only at the end of transfer
+		if (_offset != 0)
+		{
+			_updateCrc(_offset - segmentSize, _offset);
+		}
+		size_t len = minSize(segmentSize, _domain->capacity - _offset);
+		for (size_t i = 0; i < len; ++i)
+		{
+			_domain->setOctet(_offset + i, rsdo[1+i]);
+		}
+		_offset += segmentSize;
+		_seqno = seqno;
+	}
+
+	if (!last && (seqno != _blockSize)) return SdoResult::NoResponse;
+
+	tsdo.fill(0);
+	tsdo[0] = (cs_codes::sdoScsBlockDownload << 5) | 0x02;
+	tsdo[1] = _seqno;
+	tsdo[2] = _blockSize;
+	_state = (last && inOrder) ? SdoTransferState::BlockDownloadEnd : SdoTransferState::BlockDownload;
+	_seqno = 0;
+	return SdoResult::Response;
+}
+
+
+///
+///
+///
+SdoResult SdoTransfer::_abort(uint32_t code, can_payload& tsdo)
+{
+	_writeHeader(cs_codes::sdoCsAbort << 5, tsdo);
+	putU32(tsdo, 4, code);
+	_state = SdoTransferState::Idle;
+	return SdoResult::Response;
+}
+
+
+///
+///
+///
+void SdoTransfer::_start(SdoTransferState state, const ODEntry* entry)
+{
+	_state = state;
+	_domain = reinterpret_cast<ODDomain*>(entry->value.dataPtr);
+	_size = 0;
+	_sizeIndicated = false;
+	_offset = 0;
+	_blockStart = 0;
+	_seqno = 0;
+	_toggle = false;
+	_crcEnabled = false;
+	_crc = 0;
+}
+
+
+///
+///
+///
+void SdoTransfer::_updateCrc(size_t begin, size_t end)
+{
+	if (!_crcEnabled) return;
+	for (size_t pos = begin; pos < end; ++pos)
+	{
+		unsigned char octet = _domain->octet(pos);
+		_crc = emb::crc16_ccitt(&octet, 1, _crc);
+	}
+}
+
+
+///
+///
+///
+void SdoTransfer::_writeHeader(unsigned int command, can_payload& tsdo) const
+{
+	tsdo.fill(0);
+	tsdo[0] = command;
+	tsdo[1] = _index & 0xFF;
+	tsdo[2] = (_index >> 8) & 0xFF;
+	tsdo[3] = _subindex;
+}
+
+
+} // namespace ucanopen
+
+
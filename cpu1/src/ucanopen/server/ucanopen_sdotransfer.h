@@ -0,0 +1,137 @@
+/**
+ * @file ucanopen_sdotransfer.h
+ * @ingroup ucanopen
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include "../ucanopen_def.h"
+#include "ucanopen_odindex.h"
+
+
+namespace ucanopen {
+/// @addtogroup ucanopen_server
+/// @{
+
+
+/// Result of SDO request handling by SdoTransfer
+SCOPED_ENUM_DECLARE_BEGIN(SdoResult)
+{
+	Expedited,	// request is expedited access to basic object, it is handled by server
+	NoResponse,
+	Response
+}
+SCOPED_ENUM_DECLARE_END(SdoResult)
+
+
+/// SDO transfer state
+SCOPED_ENUM_DECLARE_BEGIN(SdoTransferState)
+{
+	Idle,
+	SegmentedUpload,
+	SegmentedDownload,
+	BlockUploadInitiated,	// waiting for start command
+	BlockUpload,		// sending sub-block
+	BlockUploadAck,		// sub-block is sent, waiting for acknowledgment
+	BlockUploadEnd,		// waiting for end response
+	BlockDownload,		// receiving sub-block
+	BlockDownloadEnd	// last segment is received, waiting for end command
+}
+SCOPED_ENUM_DECLARE_END(SdoTransferState)
+
+
+/**
+ * @brief CiA-301 segmented and block SDO transfer of OD_DOMAIN entries (one transfer at a time).
+ * Data are read from and written to domain buffer in place, no intermediate copy is made.
+ * Every call handles at most one request and produces at most one response or block segment (7 octets),
+ * CRC is updated per acknowledged sub-block.
+ */
+class SdoTransfer
+{
+public:
+	static const unsigned int blockSize = 127;	// segments per block download sub-block
+	static const uint64_t timeout_ms = 1000;
+private:
+	SdoTransferState _state;
+	uint32_t _index;
+	uint32_t _subindex;
+	ODDomain* _domain;
+	size_t _size;		// transfer size, octets
+	bool _sizeIndicated;
+	size_t _offset;		// octets sent or received
+	size_t _blockStart;	// offset of current sub-block
+	unsigned int _blockSize;
+	unsigned int _seqno;	// last segment number of current sub-block
+	bool _toggle;
+	bool _crcEnabled;
+	uint16_t _crc;
+	uint64_t _timepoint;
+private:
+	SdoTransfer(const SdoTransfer& other);			// no copy constructor
+	SdoTransfer& operator=(const SdoTransfer& other);	// no copy assignment operator
+public:
+	SdoTransfer()
+		: _state(SdoTransferState::Idle)
+		, _index(0)
+		, _subindex(0)
+		, _domain(static_cast<ODDomain*>(NULL))
+		, _size(0)
+		, _sizeIndicated(false)
+		, _offset(0)
+		, _blockStart(0)
+		, _blockSize(0)
+		, _seqno(0)
+		, _toggle(false)
+		, _crcEnabled(false)
+		, _crc(0)
+		, _timepoint(0)
+	{}
+
+	/**
+	 * @brief Handles SDO request. New initiate request cancels active transfer.
+	 * @param rsdo - request
+	 * @param odIndex - object dictionary
+	 * @param tsdo - response, it is written if result is SdoResult::Response
+	 * @param now - current time, ms
+	 * @return Result of handling.
+	 */
+	SdoResult handleRequest(const can_payload& rsdo, const ODIndex& odIndex, can_payload& tsdo, uint64_t now);
+
+	/**
+	 * @brief Produces next block upload segment or aborts timed out transfer. Must be called when TSDO buffer is free.
+	 * @param tsdo - segment or abort
+	 * @param now - current time, ms
+	 * @return \c true if TSDO is produced, \c false otherwise.
+	 */
+	bool poll(can_payload& tsdo, uint64_t now);
+
+	SdoTransferState state() const { return _state; }
+	bool active() const { return _state != SdoTransferState::Idle; }
+private:
+	SdoResult _initiateUpload(const ODEntry* entry, can_payload& tsdo);
+	SdoResult _initiateDownload(unsigned int command, const can_payload& rsdo, const ODEntry* entry, can_payload& tsdo);
+	SdoResult _uploadSegment(unsigned int command, can_payload& tsdo);
+	SdoResult _downloadSegment(unsigned int command, const can_payload& rsdo, can_payload& tsdo);
+	SdoResult _blockUpload(unsigned int command, const can_payload& rsdo, const ODEntry* entry, can_payload& tsdo);
+	SdoResult _blockDownload(unsigned int command, const can_payload& rsdo, const ODEntry* entry, can_payload& tsdo);
+	SdoResult _blockDownloadSegment(unsigned int command, const can_payload& rsdo, can_payload& tsdo);
+	SdoResult _abort(uint32_t code, can_payload& tsdo);
+	void _start(SdoTransferState state, const ODEntry* entry);
+	void _updateCrc(size_t begin, size_t end);
+	void _writeHeader(unsigned int command, can_payload& tsdo) const;
+};
+
+
+/// @}
+} // namespace ucanopen
+
+
@@ -22,9 +22,9 @@ unsigned char impl::cana_rpdoinfo_dualcore_alloc[sizeof(emb::Array<impl::RpdoInf
 unsigned char impl::canb_rpdoinfo_dualcore_alloc[sizeof(emb::Array<impl::RpdoInfo, 4>)]
 						 __attribute__((section("shared_ucanopen_canb_rpdo_data"), retain));
 
-unsigned char impl::cana_rsdo_dualcore_alloc[sizeof(can_payload)]
+unsigned char impl::cana_rsdo_dualcore_alloc[sizeof(impl::RsdoQueueBuffer)]
 					     __attribute__((section("shared_ucanopen_cana_rsdo_data"), retain));
-unsigned char impl::canb_rsdo_dualcore_alloc[sizeof(can_payload)]
+unsigned char impl::canb_rsdo_dualcore_alloc[sizeof(impl::RsdoQueueBuffer)]
 					     __attribute__((section("shared_ucanopen_canb_rsdo_data"), retain));
 
 unsigned char impl::cana_tsdo_dualcore_alloc[sizeof(can_payload)]
@@ -32,6 +32,11 @@ unsigned char impl::cana_tsdo_dualcore_alloc[sizeof(can_payload)]
 unsigned char impl::canb_tsdo_dualcore_alloc[sizeof(can_payload)]
 					     __attribute__((section("shared_ucanopen_canb_tsdo_data"), retain));
 
+unsigned char impl::cana_rxcursor_dualcore_alloc[sizeof(impl::RxQueueCursors)]
+					     __attribute__((section("shared_ucanopen_cana_rxcursor_data"), retain));
+unsigned char impl::canb_rxcursor_dualcore_alloc[sizeof(impl::RxQueueCursors)]
+					     __attribute__((section("shared_ucanopen_canb_rxcursor_data"), retain));
+
 } // namespace ucanopen
 
 
@@ -17,10 +17,17 @@
 #include <new>
 #include <algorithm>
 #include "../ucanopen_def.h"
+#include "../ucanopen_config.h"
+#include "ucanopen_odindex.h"
+#include "ucanopen_sdotransfer.h"
+#include "ucanopen_pdomapping.h"
+#include "ucanopen_rxqueue.h"
 #include "mcu_f2837xd/ipc/mcu_ipc.h"
 #include "mcu_f2837xd/can/mcu_can.h"
 #include "mcu_f2837xd/chrono/mcu_chrono.h"
 #include "sys/syslog/syslog.h"
+#include "emb/emb_events/emb_events.h"
+#include "emb/emb_algorithm.h"
 
 
 namespace ucanopen {
@@ -34,11 +41,6 @@ namespace ucanopen {
  */
 struct IpcFlags
 {
-	mcu::ipc::Flag rpdo1Received;
-	mcu::ipc::Flag rpdo2Received;
-	mcu::ipc::Flag rpdo3Received;
-	mcu::ipc::Flag rpdo4Received;
-	mcu::ipc::Flag rsdoReceived;
 	mcu::ipc::Flag tsdoReady;
 };
 
@@ -55,25 +57,38 @@ struct HeartbeatInfo
 
 struct TpdoInfo
 {
-	uint64_t period;
-	uint64_t timepoint;
+	uint64_t period;		// event timer, ms
+	uint64_t timepoint;		// last transmission
+	uint32_t cobId;
+	unsigned int transmissionType;
+	uint32_t inhibitTime;		// 100 us
+	unsigned int syncCounter;
+	can_payload data;		// last sent data, data sampled on SYNC for RTR
+	volatile bool rtrReceived;
 };
 
 
 struct RpdoInfo
 {
-	unsigned int id;
+	uint32_t id;
 	uint64_t timeout;
 	uint64_t timepoint;
-	can_payload data;
+	RxQueueBuffer<UCANOPEN_RPDO_QUEUE_DEPTH> queue;
 };
 
 
+typedef RxQueueBuffer<UCANOPEN_RSDO_QUEUE_DEPTH> RsdoQueueBuffer;
+typedef emb::Array<RxQueueCursor, 5> RxQueueCursors;	// RPDO1..4, RSDO
+
+
 extern unsigned char cana_rpdoinfo_dualcore_alloc[sizeof(emb::Array<impl::RpdoInfo, 4>)];
 extern unsigned char canb_rpdoinfo_dualcore_alloc[sizeof(emb::Array<impl::RpdoInfo, 4>)];
 
-extern unsigned char cana_rsdo_dualcore_alloc[sizeof(can_payload)];
-extern unsigned char canb_rsdo_dualcore_alloc[sizeof(can_payload)];
+extern unsigned char cana_rsdo_dualcore_alloc[sizeof(impl::RsdoQueueBuffer)];
+extern unsigned char canb_rsdo_dualcore_alloc[sizeof(impl::RsdoQueueBuffer)];
+
+extern unsigned char cana_rxcursor_dualcore_alloc[sizeof(impl::RxQueueCursors)];
+extern unsigned char canb_rxcursor_dualcore_alloc[sizeof(impl::RxQueueCursors)];
 
 extern unsigned char cana_tsdo_dualcore_alloc[sizeof(can_payload)];
 extern unsigned char canb_tsdo_dualcore_alloc[sizeof(can_payload)];
@@ -102,11 +117,40 @@ private:
 	/* TPDO */
 private:
 	emb::Array<impl::TpdoInfo, 4> _tpdoList;
+	emb::Array<PdoMapping, 4> _tpdoMappings;
 protected:
-	void _registerTpdo(TpdoType type, uint64_t period)
+	/**
+	 * @brief Registers TPDO.
+	 * @param type - TPDO
+	 * @param period - event timer, ms, 0 - disabled
+	 * @param transmissionType - see pdo_transmission
+	 * @param inhibitTime - minimal interval between transmissions on change, 100 us
+	 * @return (none)
+	 */
+	void _registerTpdo(TpdoType type, uint64_t period,
+			unsigned int transmissionType = pdo_transmission::cyclic, uint32_t inhibitTime = 0)
 	{
 		EMB_STATIC_ASSERT(IpcRole == mcu::ipc::Role::Primary);
-		_tpdoList[type.underlying_value()].period = period;
+		impl::TpdoInfo& tpdo = _tpdoList[type.underlying_value()];
+		tpdo.period = period;
+		tpdo.transmissionType = transmissionType;
+		tpdo.inhibitTime = inhibitTime;
+		tpdo.syncCounter = 0;
+		_setupTpdoObject(type.underlying_value());
+	}
+
+	/**
+	 * @brief Maps objects to TPDO, mapped TPDO is packed by mapping instead of _createTpdoN().
+	 * Available in single-core mode: mapped objects must belong to the same core as TPDO.
+	 * @param type - TPDO
+	 * @param parameters - mapping parameters, see pdoMappingParameter()
+	 * @param count - number of parameters, 0 - unmap
+	 * @return \c true if mapping is valid, \c false otherwise.
+	 */
+	bool _mapTpdo(TpdoType type, const uint32_t* parameters, unsigned int count)
+	{
+		EMB_STATIC_ASSERT(IpcMode == mcu::ipc::Mode::Singlecore);
+		return _tpdoMappings[type.underlying_value()].map(_odIndex, PdoDirection::Transmit, parameters, count);
 	}
 
 	virtual can_payload _createTpdo1() = 0;
@@ -117,32 +161,66 @@ protected:
 	/* RPDO */
 private:
 	emb::Array<impl::RpdoInfo, 4>* _rpdoList;
-	emb::Array<mcu::ipc::Flag, 4> _rpdoReceived;
+	emb::Array<RxQueue<UCANOPEN_RPDO_QUEUE_DEPTH>, 4> _rpdoQueues;
+	emb::Array<PdoMapping, 4> _rpdoMappings;
+	impl::RxQueueCursors* _rxQueueCursors;
 protected:
 	void _registerRpdo(RpdoType type, uint64_t timeout, unsigned int id = 0)
 	{
 		EMB_STATIC_ASSERT(IpcRole == mcu::ipc::Role::Primary);
-		_rpdoList[type.underlying_value()].timeout = timeout;
+		(*_rpdoList)[type.underlying_value()].timeout = timeout;
 		if (id != 0)
 		{
 			CobType cob = toCobType(type);
+			(*_rpdoList)[type.underlying_value()].id = id;
 			_messageObjects[cob.underlying_value()].frameId = id;
 			_canModule->setupMessageObject(_messageObjects[cob.underlying_value()]);
 		}
 	}
 
+	/**
+	 * @brief Maps objects to RPDO, mapped RPDO is unpacked by mapping instead of _handleRpdoN().
+	 * Must be called on the core that owns object dictionary.
+	 * @param type - RPDO
+	 * @param parameters - mapping parameters, see pdoMappingParameter(), dummy entries are allowed
+	 * @param count - number of parameters, 0 - unmap
+	 * @return \c true if mapping is valid, \c false otherwise.
+	 */
+	bool _mapRpdo(RpdoType type, const uint32_t* parameters, unsigned int count)
+	{
+		return _rpdoMappings[type.underlying_value()].map(_odIndex, PdoDirection::Receive, parameters, count);
+	}
+
+	/**
+	 * @brief Sets RPDO receive queue policy: all frames in order (default) or the newest frame only.
+	 * @param type - RPDO
+	 * @param policy - queue policy
+	 * @return (none)
+	 */
+	void _setRpdoQueuePolicy(RpdoType type, RxQueuePolicy policy)
+	{
+		EMB_STATIC_ASSERT(IpcRole == mcu::ipc::Role::Primary);
+		_rpdoQueues[type.underlying_value()].setPolicy(policy);
+	}
+
 	virtual void _handleRpdo1(const can_payload& data) = 0;
 	virtual void _handleRpdo2(const can_payload& data) = 0;
 	virtual void _handleRpdo3(const can_payload& data) = 0;
 	virtual void _handleRpdo4(const can_payload& data) = 0;
 
+	/* SYNC */
+private:
+	volatile unsigned int _syncCount;	// incremented by ISR
+	unsigned int _syncHandled;
+
 	/* SDO */
 private:
-	ODEntry* _dictionary;
-	size_t _dictionaryLen;
-	mcu::ipc::Flag _rsdoReceived;
+	ODTable _dictionary;
+	ODIndex _odIndex;
+	SdoTransfer _sdoTransfer;
+	RxQueue<UCANOPEN_RSDO_QUEUE_DEPTH> _rsdoQueue;
+	can_payload _rsdoData;
 	mcu::ipc::Flag _tsdoReady;
-	can_payload* _rsdoData;
 	can_payload* _tsdoData;
 
 public:
@@ -152,16 +230,14 @@ public:
 	 * @param nodeId
 	 * @param canModule
 	 * @param ipcFlags
-	 * @param objectDictionary
-	 * @param objectDictionaryLen
+	 * @param objectDictionary - hand-written or generated object dictionary
 	 */
 	IServer(NodeId nodeId, mcu::can::Module<CanPeripheral>* canModule, const IpcFlags& ipcFlags,
-			ODEntry* objectDictionary, size_t objectDictionaryLen)
+			const ODTable& objectDictionary)
 		: emb::c28x::interrupt_invoker<IServer<CanPeripheral, IpcMode, IpcRole> >(this)
 		, _nodeId(nodeId)
 		, _canModule(canModule)
 		, _dictionary(objectDictionary)
-		, _dictionaryLen(objectDictionaryLen)
 	{
 		EMB_STATIC_ASSERT(IpcRole == mcu::ipc::Role::Primary);
 		_nmtState = NmtState::Initializing;
@@ -183,7 +259,15 @@ public:
 		{
 			_tpdoList[i].period = 0;
 			_tpdoList[i].timepoint = mcu::chrono::SystemClock::now();
+			_tpdoList[i].cobId = calculateCobId(toCobType(TpdoType(i)), _nodeId);
+			_tpdoList[i].transmissionType = pdo_transmission::cyclic;
+			_tpdoList[i].inhibitTime = 0;
+			_tpdoList[i].syncCounter = 0;
+			_tpdoList[i].data.fill(0);
+			_tpdoList[i].rtrReceived = false;
 		}
+		_syncCount = 0;
+		_syncHandled = 0;
 
 		// rpdo setup
 		for (size_t i = 0; i < _rpdoList->size(); ++i)
@@ -193,22 +277,27 @@ public:
 			(*_rpdoList)[i].timepoint = mcu::chrono::SystemClock::now();
 		}
 
-		_rpdoReceived[RpdoType::Rpdo1] = ipcFlags.rpdo1Received;
-		_rpdoReceived[RpdoType::Rpdo2] = ipcFlags.rpdo2Received;
-		_rpdoReceived[RpdoType::Rpdo3] = ipcFlags.rpdo3Received;
-		_rpdoReceived[RpdoType::Rpdo4] = ipcFlags.rpdo4Received;
+		// receive queues: ISR side is owned by primary, server side - by core that runs server
+		for (size_t i = 0; i < _rpdoQueues.size(); ++i)
+		{
+			_rpdoQueues[i].initProducer();
+		}
+		_rsdoQueue.initProducer();
+		if (IpcMode == mcu::ipc::Mode::Singlecore)
+		{
+			_initQueueConsumers();
+		}
 
 		// sdo setup
 		if (IpcMode == mcu::ipc::Mode::Dualcore
 				&& IpcRole == mcu::ipc::Role::Primary)
 		{
-			assert(_dictionary == NULL);
+			assert(_dictionary.entries == NULL);
 		}
 		else
 		{
 			_initObjectDictionary();
 		}
-		_rsdoReceived = ipcFlags.rsdoReceived;
 		_tsdoReady = ipcFlags.tsdoReady;
 
 		_canModule->registerInterruptCallback(onFrameReceived);
@@ -220,28 +309,21 @@ public:
 	 * @brief
 	 *
 	 * @param ipcFlags
-	 * @param objectDictionary
-	 * @param objectDictionaryLen
+	 * @param objectDictionary - hand-written or generated object dictionary
 	 */
-	IServer(const IpcFlags& ipcFlags, ODEntry* objectDictionary, size_t objectDictionaryLen)
+	IServer(const IpcFlags& ipcFlags, const ODTable& objectDictionary)
 		: emb::c28x::interrupt_invoker<IServer<CanPeripheral, IpcMode, IpcRole> >(this)
 		, _nodeId(NodeId(0))
 		, _canModule(NULL)
 		, _dictionary(objectDictionary)
-		, _dictionaryLen(objectDictionaryLen)
 	{
 		EMB_STATIC_ASSERT(IpcMode == mcu::ipc::Mode::Dualcore);
 		EMB_STATIC_ASSERT(IpcRole == mcu::ipc::Role::Secondary);
 
 		_initAllocation();
-
-		_rpdoReceived[RpdoType::Rpdo1] = ipcFlags.rpdo1Received;
-		_rpdoReceived[RpdoType::Rpdo2] = ipcFlags.rpdo2Received;
-		_rpdoReceived[RpdoType::Rpdo3] = ipcFlags.rpdo3Received;
-		_rpdoReceived[RpdoType::Rpdo4] = ipcFlags.rpdo4Received;
+		_initQueueConsumers();
 
 		_initObjectDictionary();
-		_rsdoReceived = ipcFlags.rsdoReceived;
 		_tsdoReady = ipcFlags.tsdoReady;
 	}
 
@@ -269,6 +351,20 @@ public:
 		_nmtState = NmtState::Stopped;
 	}
 
+	/**
+	 * @brief Returns RPDO receive queue statistics.
+	 * @param type - RPDO
+	 * @return Queue statistics.
+	 */
+	RxQueueStats rpdoQueueStats(RpdoType type) const { return _rpdoQueues[type.underlying_value()].stats(); }
+
+	/**
+	 * @brief Returns RSDO receive queue statistics.
+	 * @param (none)
+	 * @return Queue statistics.
+	 */
+	RxQueueStats rsdoQueueStats() const { return _rsdoQueue.stats(); }
+
 	/**
 	 * @brief Runs all server operations.
 	 *
@@ -280,6 +376,7 @@ public:
 		switch (IpcMode)
 		{
 		case mcu::ipc::Mode::Singlecore:
+			_handleSync();
 			_sendPeriodic();
 			_handleRpdo();
 			_handleRsdo();
@@ -289,6 +386,7 @@ public:
 			switch (IpcRole)
 			{
 			case mcu::ipc::Role::Primary:
+				_handleSync();
 				_sendPeriodic();
 				_sendTsdo();
 				break;
@@ -321,86 +419,262 @@ private:
 
 		for (size_t i = 0; i < _tpdoList.size(); ++i)
 		{
-			if (_tpdoList[i].period == 0) continue;
-			if (mcu::chrono::SystemClock::now() < _tpdoList[i].timepoint + _tpdoList[i].period) continue;
+			impl::TpdoInfo& tpdo = _tpdoList[i];
+			if ((tpdo.cobId & pdoCobIdInvalid) != 0) continue;
 
+			const uint64_t now = mcu::chrono::SystemClock::now();
+			const bool timerExpired = (tpdo.period != 0) && (now >= tpdo.timepoint + tpdo.period);
 			can_payload payload;
-			switch (i)
+
+			switch (tpdo.transmissionType)
 			{
-			case 0:
-				payload = _createTpdo1();
+			case pdo_transmission::cyclic:
+				if (!timerExpired) continue;
+				_createTpdo(i, payload);
 				break;
-			case 1:
-				payload = _createTpdo2();
+			case pdo_transmission::onChange:
+				if (!timerExpired && (10 * now < 10 * tpdo.timepoint + tpdo.inhibitTime)) continue;
+				_createTpdo(i, payload);
+				if (!timerExpired && std::equal(payload.begin(), payload.end(), tpdo.data.begin())) continue;
 				break;
-			case 2:
-				payload = _createTpdo3();
-				break;
-			case 3:
-				payload = _createTpdo4();
+			case pdo_transmission::rtrSync:
+			case pdo_transmission::rtrEvent:
+				if (!tpdo.rtrReceived) continue;
+				tpdo.rtrReceived = false;
+				if (tpdo.transmissionType == pdo_transmission::rtrSync)
+				{
+					payload = tpdo.data;	// sampled on SYNC
+				}
+				else
+				{
+					_createTpdo(i, payload);
+				}
 				break;
+			default:
+				continue;		// synchronous TPDOs are sent by _handleSync()
 			}
 
-			CobType cob = toCobType(TpdoType(i));
-			_canModule->send(cob.underlying_value(), payload.data, cobDataLen[cob.underlying_value()]);
-			_tpdoList[i].timepoint = mcu::chrono::SystemClock::now();
+			_transmitTpdo(i, payload);
 		}
 	}
 
 	/**
-	 * @brief
+	 * @brief Handles received SYNCs: sends synchronous TPDOs, samples data of RTR-sync TPDOs.
 	 *
 	 */
-	void _handleRpdo()
+	void _handleSync()
+	{
+		while (_syncHandled != _syncCount)
+		{
+			++_syncHandled;
+			for (size_t i = 0; i < _tpdoList.size(); ++i)
+			{
+				impl::TpdoInfo& tpdo = _tpdoList[i];
+				if ((tpdo.cobId & pdoCobIdInvalid) != 0) continue;
+
+				can_payload payload;
+				if (tpdo.transmissionType == pdo_transmission::syncAcyclic)
+				{
+					_createTpdo(i, payload);
+					if (std::equal(payload.begin(), payload.end(), tpdo.data.begin())) continue;
+				}
+				else if (tpdo.transmissionType <= pdo_transmission::syncMax)
+				{
+					if (++tpdo.syncCounter < tpdo.transmissionType) continue;
+					tpdo.syncCounter = 0;
+					_createTpdo(i, payload);
+				}
+				else
+				{
+					if (tpdo.transmissionType == pdo_transmission::rtrSync)
+					{
+						_createTpdo(i, tpdo.data);
+					}
+					continue;
+				}
+
+				_transmitTpdo(i, payload);
+			}
+		}
+	}
+
+	/**
+	 * @brief Packs mapped TPDO or creates it by derived server.
+	 *
+	 */
+	void _createTpdo(size_t i, can_payload& payload)
 	{
-		if (_rpdoReceived[RpdoType::Rpdo1].isSet())
+		if (_tpdoMappings[i].enabled())
 		{
-			_handleRpdo1((*_rpdoList)[RpdoType::Rpdo1].data);
-			_rpdoReceived[RpdoType::Rpdo1].reset();
+			_tpdoMappings[i].pack(payload);
+			return;
 		}
 
-		if (_rpdoReceived[RpdoType::Rpdo2].isSet())
+		switch (i)
 		{
-			_handleRpdo2((*_rpdoList)[RpdoType::Rpdo2].data);
-			_rpdoReceived[RpdoType::Rpdo2].reset();
+		case 0:
+			payload = _createTpdo1();
+			break;
+		case 1:
+			payload = _createTpdo2();
+			break;
+		case 2:
+			payload = _createTpdo3();
+			break;
+		case 3:
+			payload = _createTpdo4();
+			break;
 		}
+	}
+
+	/**
+	 * @brief
+	 *
+	 */
+	void _transmitTpdo(size_t i, const can_payload& payload)
+	{
+		CobType cob = toCobType(TpdoType(i));
+		unsigned int len = _tpdoMappings[i].enabled() ? _tpdoMappings[i].length() : cobDataLen[cob.underlying_value()];
+		_canModule->send(cob.underlying_value(), payload.data, len);
+		_tpdoList[i].timepoint = mcu::chrono::SystemClock::now();
+		_tpdoList[i].data = payload;
+	}
+
+	/**
+	 * @brief Setups TPDO message object by communication parameters. RTR TPDO object receives remote frames
+	 * (no automatic response), response is sent by server.
+	 *
+	 */
+	void _setupTpdoObject(size_t i)
+	{
+		const impl::TpdoInfo& tpdo = _tpdoList[i];
+		mcu::can::MessageObject& object = _messageObjects[toCobType(TpdoType(i)).underlying_value()];
+		bool rtr = (tpdo.transmissionType == pdo_transmission::rtrSync)
+				|| (tpdo.transmissionType == pdo_transmission::rtrEvent);
+
+		object.frameId = tpdo.cobId & 0x7FF;
+		object.frameIdMask = rtr ? 0x7FF : 0;
+		object.flags = rtr ? (CAN_MSG_OBJ_USE_ID_FILTER | CAN_MSG_OBJ_RX_INT_ENABLE) : CAN_MSG_OBJ_NO_FLAGS;
+		_canModule->setupMessageObject(object);
+	}
 
-		if (_rpdoReceived[RpdoType::Rpdo3].isSet())
+	/**
+	 * @brief
+	 *
+	 */
+	void _handleRpdo()
+	{
+		can_payload data;
+		for (size_t i = 0; i < _rpdoQueues.size(); ++i)
 		{
-			_handleRpdo3((*_rpdoList)[RpdoType::Rpdo3].data);
-			_rpdoReceived[RpdoType::Rpdo3].reset();
+			// queued frames are handled in order, work per call is bounded by queue depth
+			for (size_t n = 0; (n < UCANOPEN_RPDO_QUEUE_DEPTH) && _rpdoQueues[i].pop(data); ++n)
+			{
+				_handleRpdo(i, data);
+			}
 		}
+	}
 
-		if (_rpdoReceived[RpdoType::Rpdo4].isSet())
+	/**
+	 * @brief Unpacks mapped RPDO or passes it to derived server.
+	 *
+	 */
+	void _handleRpdo(size_t i, const can_payload& data)
+	{
+		if (_rpdoMappings[i].enabled())
 		{
-			_handleRpdo4((*_rpdoList)[RpdoType::Rpdo4].data);
-			_rpdoReceived[RpdoType::Rpdo4].reset();
+			_rpdoMappings[i].unpack(data);
+		}
+		else
+		{
+			switch (i)
+			{
+			case 0:
+				_handleRpdo1(data);
+				break;
+			case 1:
+				_handleRpdo2(data);
+				break;
+			case 2:
+				_handleRpdo3(data);
+				break;
+			case 3:
+				_handleRpdo4(data);
+				break;
+			}
 		}
 	}
 
 	/**
-	 * @brief
+	 * @brief Handles queued SDO requests until response is to be sent: request stays in queue
+	 * while previous response waits for CAN module.
 	 *
-	 * @param data
 	 */
 	void _handleRsdo()
 	{
-		if (!_rsdoReceived.isSet()) return;
+		for (size_t n = 0; n < UCANOPEN_RSDO_QUEUE_DEPTH; ++n)
+		{
+			if (_tsdoReady.local.isSet()) return;
 
+			if (!_rsdoQueue.pop(_rsdoData))
+			{
+				// next block upload segment when previous one is passed to CAN module, transfer timeout
+				if (_sdoTransfer.poll(*_tsdoData, mcu::chrono::SystemClock::now()))
+				{
+					_tsdoReady.local.set();
+				}
+				return;
+			}
+			_handleRsdo(_rsdoData);
+		}
+	}
+
+	/**
+	 * @brief Handles SDO request.
+	 *
+	 * @param data
+	 */
+	void _handleRsdo(const can_payload& data)
+	{
 		ODAccessStatus status = ODAccessStatus::NoAccess;
-		ODEntry* dictionaryEnd = _dictionary + _dictionaryLen;
 
-		CobSdo rsdo = fromPayload<CobSdo>(*_rsdoData);
+		CobSdo rsdo = fromPayload<CobSdo>(data);
 		CobSdo tsdo;
 
-		_rsdoReceived.reset();
-
-		const ODEntry* odEntry = emb::binary_find(_dictionary, dictionaryEnd,
-				ODEntryKeyAux(rsdo.index, rsdo.subindex));
+		// segmented and block transfers of domains, expedited access to other objects is handled below
+		switch (_sdoTransfer.handleRequest(data, _odIndex, *_tsdoData, mcu::chrono::SystemClock::now()).underlying_value())
+		{
+		case SdoResult::Response:
+			_tsdoReady.local.set();
+			return;
+		case SdoResult::NoResponse:
+			return;
+		case SdoResult::Expedited:
+			break;
+		}
 
-		if (odEntry == dictionaryEnd) return;	// OD-entry not found
+		const ODEntry* odEntry = _odIndex.find(rsdo.index, rsdo.subindex);
 
-		if (rsdo.cs == cs_codes::sdoCcsRead)
+		if (_isPdoParameter(rsdo.index))
+		{
+			if (rsdo.cs == cs_codes::sdoCcsRead)
+			{
+				status = _readPdoParameter(rsdo.index, rsdo.subindex, tsdo.data);
+			}
+			else if (rsdo.cs == cs_codes::sdoCcsWrite)
+			{
+				status = _writePdoParameter(rsdo.index, rsdo.subindex, rsdo.data);
+			}
+			else
+			{
+				return;
+			}
+		}
+		else if (odEntry == NULL)
+		{
+			return;	// OD-entry not found
+		}
+		else if (rsdo.cs == cs_codes::sdoCcsRead)
 		{
 			if ((odEntry->value.dataPtr != OD_NO_DIRECT_ACCESS) && odEntry->hasReadAccess())
 			{
@@ -462,6 +736,128 @@ private:
 		}
 	}
 
+	/**
+	 * @brief Checks if object is PDO communication or mapping parameter (CiA 301: 0x1400, 0x1600, 0x1800, 0x1A00 + PDO number).
+	 * These objects are served by server, they are not in object dictionary table.
+	 *
+	 */
+	static bool _isPdoParameter(uint32_t index)
+	{
+		uint32_t base = index & 0xFF00;
+		return ((index & 0xFF) < 4) && ((base == 0x1400) || (base == 0x1600) || (base == 0x1800) || (base == 0x1A00));
+	}
+
+	/**
+	 * @brief
+	 *
+	 */
+	ODAccessStatus _readPdoParameter(uint32_t index, uint32_t subindex, CobSdoData& dest) const
+	{
+		const size_t i = index & 0xFF;
+		switch (index & 0xFF00)
+		{
+		case 0x1400:	// RPDO communication parameter
+			switch (subindex)
+			{
+			case 0:
+				dest.u32 = 5;
+				return ODAccessStatus::Success;
+			case 1:
+				dest.u32 = (*_rpdoList)[i].id;
+				return ODAccessStatus::Success;
+			case 2:
+				dest.u32 = pdo_transmission::onChange;	// received RPDO is handled at once
+				return ODAccessStatus::Success;
+			case 5:
+				dest.u32 = (*_rpdoList)[i].timeout;
+				return ODAccessStatus::Success;
+			}
+			return ODAccessStatus::NoAccess;
+		case 0x1600:	// RPDO mapping parameter
+			return _rpdoMappings[i].read(subindex, dest);
+		case 0x1800:	// TPDO communication parameter
+			switch (subindex)
+			{
+			case 0:
+				dest.u32 = 5;
+				return ODAccessStatus::Success;
+			case 1:
+				dest.u32 = _tpdoList[i].cobId;
+				return ODAccessStatus::Success;
+			case 2:
+				dest.u32 = _tpdoList[i].transmissionType;
+				return ODAccessStatus::Success;
+			case 3:
+				dest.u32 = _tpdoList[i].inhibitTime;
+				return ODAccessStatus::Success;
+			case 5:
+				dest.u32 = _tpdoList[i].period;
+				return ODAccessStatus::Success;
+			}
+			return ODAccessStatus::NoAccess;
+		case 0x1A00:	// TPDO mapping parameter
+			return _tpdoMappings[i].read(subindex, dest);
+		}
+		return ODAccessStatus::NoAccess;
+	}
+
+	/**
+	 * @brief Writes PDO parameter. PDO communication parameters and TPDO mapping can be changed in single-core mode only:
+	 * in dual-core mode they are owned by primary core.
+	 *
+	 */
+	ODAccessStatus _writePdoParameter(uint32_t index, uint32_t subindex, CobSdoData val)
+	{
+		const size_t i = index & 0xFF;
+		switch (index & 0xFF00)
+		{
+		case 0x1400:	// RPDO communication parameter
+			if (IpcMode != mcu::ipc::Mode::Singlecore) return ODAccessStatus::NoAccess;
+			switch (subindex)
+			{
+			case 1:
+				(*_rpdoList)[i].id = val.u32;
+				_messageObjects[toCobType(RpdoType(i)).underlying_value()].frameId = val.u32 & 0x7FF;
+				_canModule->setupMessageObject(_messageObjects[toCobType(RpdoType(i)).underlying_value()]);
+				return ODAccessStatus::Success;
+			case 5:
+				(*_rpdoList)[i].timeout = val.u32 & 0xFFFF;
+				return ODAccessStatus::Success;
+			}
+			return ODAccessStatus::NoAccess;
+		case 0x1600:	// RPDO mapping parameter
+			return _rpdoMappings[i].write(_odIndex, PdoDirection::Receive, subindex, val);
+		case 0x1800:	// TPDO communication parameter
+			if (IpcMode != mcu::ipc::Mode::Singlecore) return ODAccessStatus::NoAccess;
+			switch (subindex)
+			{
+			case 1:
+				_tpdoList[i].cobId = val.u32;
+				break;
+			case 2:
+				if ((val.u32 > pdo_transmission::syncMax) && (val.u32 < pdo_transmission::rtrSync)) return ODAccessStatus::Fail;
+				if (val.u32 > pdo_transmission::onChange) return ODAccessStatus::Fail;
+				_tpdoList[i].transmissionType = val.u32;
+				_tpdoList[i].syncCounter = 0;
+				break;
+			case 3:
+				_tpdoList[i].inhibitTime = val.u32 & 0xFFFF;
+				return ODAccessStatus::Success;
+			case 5:
+				_tpdoList[i].period = val.u32 & 0xFFFF;
+				return ODAccessStatus::Success;
+			default:
+				return ODAccessStatus::NoAccess;
+			}
+			_setupTpdoObject(i);
+			return ODAccessStatus::Success;
+		case 0x1A00:	// TPDO mapping parameter
+			if (IpcMode != mcu::ipc::Mode::Singlecore) return ODAccessStatus::NoAccess;
+			return _tpdoMappings[i].write(_odIndex, PdoDirection::Transmit, subindex, val);
+		}
+		return ODAccessStatus::NoAccess;
+	}
+
 	/**
 	 * @brief
 	 *
@@ -469,6 +865,7 @@ private:
 	void _sendTsdo()
 	{
 		if (!_tsdoReady.isSet()) return;
+		if (_canModule->txPending(CobType::Tsdo)) return;	// previous response or segment waits for bus
 		_canModule->send(CobType::Tsdo, _tsdoData->data, cobDataLen[CobType::Tsdo]);
 		_tsdoReady.reset();
 	}
@@ -479,6 +876,7 @@ private:
 	 */
 	void _initAllocation()
 	{
+		impl::RsdoQueueBuffer* rsdoQueueBuffer = static_cast<impl::RsdoQueueBuffer*>(NULL);
 		switch (CanPeripheral)
 		{
 		case mcu::can::Peripheral::CanA:
@@ -486,12 +884,14 @@ private:
 			{
 			case mcu::ipc::Mode::Singlecore:
 				_rpdoList = new emb::Array<impl::RpdoInfo, 4>;
-				_rsdoData = new can_payload;
+				rsdoQueueBuffer = new impl::RsdoQueueBuffer;
+				_rxQueueCursors = new impl::RxQueueCursors;
 				_tsdoData = new can_payload;
 				break;
 			case mcu::ipc::Mode::Dualcore:
 				_rpdoList = new(impl::cana_rpdoinfo_dualcore_alloc) emb::Array<impl::RpdoInfo, 4>;
-				_rsdoData = new(impl::cana_rsdo_dualcore_alloc) can_payload;
+				rsdoQueueBuffer = new(impl::cana_rsdo_dualcore_alloc) impl::RsdoQueueBuffer;
+				_rxQueueCursors = new(impl::cana_rxcursor_dualcore_alloc) impl::RxQueueCursors;
 				_tsdoData = new(impl::cana_tsdo_dualcore_alloc) can_payload;
 				break;
 			}
@@ -501,17 +901,39 @@ private:
 			{
 			case mcu::ipc::Mode::Singlecore:
 				_rpdoList = new emb::Array<impl::RpdoInfo, 4>;
-				_rsdoData = new can_payload;
+				rsdoQueueBuffer = new impl::RsdoQueueBuffer;
+				_rxQueueCursors = new impl::RxQueueCursors;
 				_tsdoData = new can_payload;
 				break;
 			case mcu::ipc::Mode::Dualcore:
 				_rpdoList = new(impl::canb_rpdoinfo_dualcore_alloc) emb::Array<impl::RpdoInfo, 4>;
-				_rsdoData = new(impl::canb_rsdo_dualcore_alloc) can_payload;
+				rsdoQueueBuffer = new(impl::canb_rsdo_dualcore_alloc) impl::RsdoQueueBuffer;
+				_rxQueueCursors = new(impl::canb_rxcursor_dualcore_alloc) impl::RxQueueCursors;
 				_tsdoData = new(impl::canb_tsdo_dualcore_alloc) can_payload;
 				break;
 			}
 			break;
 		}
+
+		// RPDO1..4 use cursors 0..3, RSDO uses cursor 4
+		for (size_t i = 0; i < _rpdoQueues.size(); ++i)
+		{
+			_rpdoQueues[i].attach(&(*_rpdoList)[i].queue, &(*_rxQueueCursors)[i]);
+		}
+		_rsdoQueue.attach(rsdoQueueBuffer, &(*_rxQueueCursors)[4]);
+	}
+
+	/**
+	 * @brief Resets consumer side of receive queues. Is called by core that runs server.
+	 *
+	 */
+	void _initQueueConsumers()
+	{
+		for (size_t i = 0; i < _rpdoQueues.size(); ++i)
+		{
+			_rpdoQueues[i].initConsumer();
+		}
+		_rsdoQueue.initConsumer();
 	}
 
 	/**
@@ -555,10 +977,11 @@ private:
 				= _messageObjects[CobType::Tpdo2].flags
 				= _messageObjects[CobType::Tpdo3].flags
 				= _messageObjects[CobType::Tpdo4].flags
-				= _messageObjects[CobType::Tsdo].flags
 				= _messageObjects[CobType::Heartbeat].flags
 				= CAN_MSG_OBJ_NO_FLAGS;
 
+		_messageObjects[CobType::Tsdo].flags = CAN_MSG_OBJ_TX_INT_ENABLE;	// sent TSDO wakes server for next block segment
+
 		_messageObjects[CobType::Nmt].flags
 				= _messageObjects[CobType::Sync].flags
 				= _messageObjects[CobType::Time].flags
@@ -571,59 +994,18 @@ private:
 	}
 
 	/**
-	 * @brief
+	 * @brief Builds key index for SDO lookup. Hand-written dictionary is sorted and validated,
+	 * generated one is checked in debug build only.
 	 *
 	 */
 	void _initObjectDictionary()
 	{
-		assert(_dictionary != NULL);
-
-		std::sort(_dictionary, _dictionary + _dictionaryLen);
+		assert(_dictionary.entries != NULL);
 
-		// Check OBJECT DICTIONARY correctness
-		for (size_t i = 0; i < _dictionaryLen; ++i)
-		{
-			// OD is sorted
-			if (i < (_dictionaryLen - 1))
-			{
-				assert(_dictionary[i] < _dictionary[i+1]);
-			}
-
-			for (size_t j = i+1; j < _dictionaryLen; ++j)
-			{
-				// no od-entries with equal {index, subinex}
-				assert((_dictionary[i].key.index != _dictionary[j].key.index)
-					|| (_dictionary[i].key.subindex != _dictionary[j].key.subindex));
-
-				// no od-entries with equal {category, subcategory, name}
-				bool categoryEqual = ((strcmp(_dictionary[i].value.category, _dictionary[j].value.category) == 0) ? true : false);
-				bool subcategoryEqual = ((strcmp(_dictionary[i].value.subcategory, _dictionary[j].value.subcategory) == 0) ? true : false);
-				bool nameEqual = ((strcmp(_dictionary[i].value.name, _dictionary[j].value.name) == 0) ? true : false);
-				assert(!categoryEqual || !subcategoryEqual || !nameEqual);
-			}
-
-			if (_dictionary[i].hasReadAccess())
-			{
-				assert((_dictionary[i].value.readAccessFunc != OD_NO_INDIRECT_READ_ACCESS)
-						|| (_dictionary[i].value.dataPtr != OD_NO_DIRECT_ACCESS));
-			}
-			else
-			{
-				assert(_dictionary[i].value.readAccessFunc == OD_NO_INDIRECT_READ_ACCESS
-						&& (_dictionary[i].value.dataPtr == OD_NO_DIRECT_ACCESS));
-			}
-
-			if (_dictionary[i].hasWriteAccess())
-			{
-				assert(_dictionary[i].value.writeAccessFunc != OD_NO_INDIRECT_WRITE_ACCESS
-						|| (_dictionary[i].value.dataPtr != OD_NO_DIRECT_ACCESS));
-			}
-			else
-			{
-				assert(_dictionary[i].value.writeAccessFunc == OD_NO_INDIRECT_WRITE_ACCESS
-						&& (_dictionary[i].value.dataPtr == OD_NO_DIRECT_ACCESS));
-			}
-		}
+		// Check OBJECT DICTIONARY correctness: unique keys and names, access rights
+		bool valid = _odIndex.init(_dictionary);
+		assert(valid);
+		(void)valid;
 	}
 
 
@@ -663,35 +1045,76 @@ private:
 			size_t rpdoIdx = (interruptCause - static_cast<size_t>(CobType::Rpdo1)) / 2;
 			(*server->_rpdoList)[rpdoIdx].timepoint = mcu::chrono::SystemClock::now();
 
-			if (server->_rpdoReceived[rpdoIdx].local.isSet())
+			can_payload* slot = static_cast<can_payload*>(NULL);
+			if (((*server->_rpdoList)[rpdoIdx].id & pdoCobIdInvalid) == 0)
 			{
-				SysLog::setWarning(sys::Warning::CanBusOverrun);
+				slot = server->_rpdoQueues[rpdoIdx].reserve();
+				if (slot == NULL)
+				{
+					SysLog::setWarning(sys::Warning::CanBusOverrun);
+				}
+			}
+
+			if (slot == NULL)
+			{
+				can_payload discarded;
+				canModule->recv(interruptCause, discarded.data);
 			}
 			else
 			{
-				// there is no unprocessed RPDO of this type
-				canModule->recv(interruptCause, (*server->_rpdoList)[rpdoIdx].data.data);
-				server->_rpdoReceived[rpdoIdx].local.set();
+				canModule->recv(interruptCause, slot->data);
+				server->_rpdoQueues[rpdoIdx].commit();
+				emb::PendingEvents::set(emb::Event::CanRx);
 			}
+			break;
 		}
 
 		case CobType::Rsdo:
 		{
 			SysLog::resetWarning(sys::Warning::CanBusError);
-			if (server->_rsdoReceived.local.isSet()
-					|| server->_tsdoReady.isSet())
+			can_payload* slot = server->_rsdoQueue.reserve();
+			if (slot == NULL)
 			{
+				can_payload discarded;
+				canModule->recv(interruptCause, discarded.data);
 				SysLog::setWarning(sys::Warning::CanBusOverrun);
 				SysLog::addMessage(sys::Message::CanSdoRequestLost);
 			}
 			else
 			{
-				canModule->recv(interruptCause, server->_rsdoData->data);
-				server->_rsdoReceived.local.set();
+				canModule->recv(interruptCause, slot->data);
+				server->_rsdoQueue.commit();
+				emb::PendingEvents::set(emb::Event::CanRx);
 			}
 			break;
 		}
 
+		case CobType::Tsdo:
+			emb::PendingEvents::set(emb::Event::CanRx);
+			break;
+
+		case CobType::Sync:
+		{
+			can_payload discarded;
+			canModule->recv(interruptCause, discarded.data);
+			++server->_syncCount;
+			emb::PendingEvents::set(emb::Event::CanRx);
+			break;
+		}
+
+		case CobType::Tpdo1:	// remote frame for RTR TPDO
+		case CobType::Tpdo2:
+		case CobType::Tpdo3:
+		case CobType::Tpdo4:
+		{
+			size_t tpdoIdx = (interruptCause - static_cast<size_t>(CobType::Tpdo1)) / 2;
+			can_payload discarded;
+			canModule->recv(interruptCause, discarded.data);
+			server->_tpdoList[tpdoIdx].rtrReceived = true;
+			emb::PendingEvents::set(emb::Event::CanRx);
+			break;
+		}
+
 		default:
 			break;
 		}
@@ -12,6 +12,7 @@
 
 
 #include "ucanopen_tests.h"
+#include "ucanopen_tests_od.h"
 
 
 namespace ucanopen {
@@ -20,75 +21,24 @@ namespace ucanopen {
 namespace tests {
 
 
-namespace od {
-
-
-inline ODAccessStatus getDeviceName(CobSdoData& dest)
-{
-	char name[4] = {0};
-	strncpy(name, SysInfo::deviceNameShort, 4);
-	uint32_t nameRaw = 0;
-	emb::c28x::from_bytes<uint32_t>(nameRaw, reinterpret_cast<uint16_t*>(name));
-	memcpy(&dest, &nameRaw, sizeof(uint32_t));
-	return ODAccessStatus::Success;
-}
+/// Index of trace event read through OD
+uint32_t traceCursor = 0;
 
 
-inline ODAccessStatus getFirmwareVersion(CobSdoData& dest)
-{
-	char name[4] = {0};
-	strncpy(name, GIT_HASH, 4);
-	uint32_t nameRaw = 0;
-	emb::c28x::from_bytes<uint32_t>(nameRaw, reinterpret_cast<uint16_t*>(name));
-	memcpy(&dest, &nameRaw, sizeof(uint32_t));
-	return ODAccessStatus::Success;
-}
-
+namespace od {
 
-inline ODAccessStatus getBuildConfiguration(CobSdoData& dest)
-{
-	char name[4] = {0};
-	strncpy(name, SysInfo::buildConfigurationShort, 4);
-	uint32_t nameRaw = 0;
-	emb::c28x::from_bytes<uint32_t>(nameRaw, reinterpret_cast<uint16_t*>(name));
-	memcpy(&dest, &nameRaw, sizeof(uint32_t));
-	return ODAccessStatus::Success;
-}
 
+const size_t CONFIG_BLOB_SIZE = 1024;	// octets
+uint16_t configBlobData[CONFIG_BLOB_SIZE / 2];
+ODDomain configBlob = {configBlobData, CONFIG_BLOB_SIZE, 0};
 
-inline ODAccessStatus getSyslogMessage(CobSdoData& dest)
-{
-	uint32_t message = SysLog::readMessage().underlying_value();
-	SysLog::popMessage();
-	memcpy(&dest, &message, sizeof(uint32_t));
-	return ODAccessStatus::Success;
-}
 
-inline ODAccessStatus getUptime(CobSdoData& dest)
-{
-	float time = mcu::chrono::SystemClock::now() / 1000.f;
-	memcpy(&dest, &time, sizeof(uint32_t));
-	return ODAccessStatus::Success;
-}
+PdoDemo pdoDemo = {false, 0, 0, 0, 0, 0.f};
 
 
 } // namespace od
 
 
-ODEntry objectDictionary[] = {
-{{0x1008, 0x00}, {"system", "info", "device_name", "", OD_STRING_4CHARS, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getDeviceName, OD_NO_INDIRECT_WRITE_ACCESS}},
-{{0x5FFF, 0x00}, {"system", "info", "firmware_version", "", OD_STRING_4CHARS, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getFirmwareVersion, OD_NO_INDIRECT_WRITE_ACCESS}},
-{{0x5FFF, 0x01}, {"system", "info", "build_configuration", "", OD_STRING_4CHARS, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getBuildConfiguration, OD_NO_INDIRECT_WRITE_ACCESS}},
-
-{{0x5000, 0x00}, {"watch", "watch", "uptime", "s", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getUptime, OD_NO_INDIRECT_WRITE_ACCESS}},
-{{0x5000, 0x01}, {"watch", "watch", "syslog_message", "", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getSyslogMessage, OD_NO_INDIRECT_WRITE_ACCESS}},
-
-};
-
-
-const size_t objectDictionaryLen = sizeof(objectDictionary) / sizeof(objectDictionary[0]);
-
-
 }
 
 
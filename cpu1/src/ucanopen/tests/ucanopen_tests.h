@@ -32,7 +32,7 @@ struct CobTpdo1
 	uint64_t clock;
 	CobTpdo1()
 	{
-		EMB_STATIC_ASSERT(sizeof(CobTpdo1) == 4);
+		EMB_STATIC_ASSERT(EMB_C28X_SIZEOF(CobTpdo1) == 4);
 		memset(this, 0, sizeof(CobTpdo1));
 	}
 };
@@ -44,7 +44,7 @@ struct CobTpdo2
 	uint32_t seconds;
 	CobTpdo2()
 	{
-		EMB_STATIC_ASSERT(sizeof(CobTpdo2) == 4);
+		EMB_STATIC_ASSERT(EMB_C28X_SIZEOF(CobTpdo2) == 4);
 		memset(this, 0, sizeof(CobTpdo2));
 	}
 };
@@ -57,7 +57,7 @@ struct CobTpdo3
 	uint32_t _reserved2 : 32;
 	CobTpdo3()
 	{
-		EMB_STATIC_ASSERT(sizeof(CobTpdo3) == 4);
+		EMB_STATIC_ASSERT(EMB_C28X_SIZEOF(CobTpdo3) == 4);
 		memset(this, 0, sizeof(CobTpdo3));
 	}
 };
@@ -69,13 +69,15 @@ struct CobTpdo4
 	uint32_t warnings : 32;
 	CobTpdo4()
 	{
-		EMB_STATIC_ASSERT(sizeof(CobTpdo4) == 4);
+		EMB_STATIC_ASSERT(EMB_C28X_SIZEOF(CobTpdo4) == 4);
 		memset(this, 0, sizeof(CobTpdo4));
 	}
 };
 
 
-extern ODEntry objectDictionary[];
+/// Generated from ucanopen_tests_od.csv by scripts/odgen/odgen.py, see ucanopen_tests_od.h
+extern const ODEntry objectDictionary[];
+extern const uint32_t objectDictionaryKeys[];
 extern const size_t objectDictionaryLen;
 
 
@@ -85,8 +87,9 @@ class Server : public IServer<CanPeripheral, IpcMode, IpcRole>
 public:
 	Server(NodeId nodeId, mcu::can::Module<CanPeripheral>* canModule, const IpcFlags& ipcFlags)
 		: IServer<CanPeripheral, IpcMode, IpcRole>(nodeId, canModule, ipcFlags,
-				IpcMode == mcu::ipc::Mode::Singlecore ? objectDictionary : NULL,
-				IpcMode == mcu::ipc::Mode::Singlecore ? objectDictionaryLen : 0)
+				IpcMode == mcu::ipc::Mode::Singlecore
+						? ODTable(objectDictionary, objectDictionaryKeys, objectDictionaryLen)
+						: ODTable(static_cast<ODEntry*>(NULL), static_cast<uint32_t*>(NULL), 0))
 	{
 		EMB_STATIC_ASSERT(IpcRole == mcu::ipc::Role::Primary);
 
@@ -97,7 +100,8 @@ public:
 	}
 
 	Server(const IpcFlags& ipcFlags)
-		: IServer<CanPeripheral, IpcMode, IpcRole>(ipcFlags, objectDictionary, objectDictionaryLen)
+		: IServer<CanPeripheral, IpcMode, IpcRole>(ipcFlags,
+				ODTable(objectDictionary, objectDictionaryKeys, objectDictionaryLen))
 	{
 		EMB_STATIC_ASSERT(IpcMode == mcu::ipc::Mode::Dualcore);
 		EMB_STATIC_ASSERT(IpcRole == mcu::ipc::Role::Secondary);
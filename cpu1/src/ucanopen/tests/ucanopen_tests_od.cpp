@@ -0,0 +1,78 @@
+// Generated by scripts/odgen/odgen.py from ucanopen_tests_od.csv, do not edit.
+// Table is sorted by key and validated by generator, server uses it without sorting.
+
+
+#include "ucanopen_tests_od.h"
+
+
+namespace ucanopen {
+
+
+namespace tests {
+
+
+extern const ODEntry objectDictionary[] = {
+{{0x1008, 0x00}, {"system", "info", "device_name", "", OD_STRING_4CHARS, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getDeviceName, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5000, 0x00}, {"watch", "watch", "uptime", "s", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getUptime, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5000, 0x01}, {"watch", "watch", "syslog_message", "", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getSyslogMessage, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5010, 0x00}, {"trace", "info", "event_count", "", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getTraceEventCount, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5010, 0x01}, {"trace", "dump", "cursor", "", OD_UINT32, OD_ACCESS_RW, OD_NO_DIRECT_ACCESS, od::getTraceCursor, od::setTraceCursor}},
+{{0x5010, 0x02}, {"trace", "dump", "event_tag", "", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getTraceEventTag, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5010, 0x03}, {"trace", "dump", "event_timestamp", "", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getTraceEventTimestamp, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5010, 0x04}, {"trace", "control", "recording", "", OD_BOOL, OD_ACCESS_RW, OD_NO_DIRECT_ACCESS, od::getTraceRecording, od::setTraceRecording}},
+{{0x5011, 0x00}, {"cpu", "load", "superloop", "%", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuLoad<emb::Probe::Superloop>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5011, 0x01}, {"cpu", "load", "syslog_ipc", "%", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuLoad<emb::Probe::SysLogIpc>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5011, 0x02}, {"cpu", "load", "clock_tasks", "%", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuLoad<emb::Probe::ClockTasks>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5011, 0x03}, {"cpu", "load", "cli_server", "%", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuLoad<emb::Probe::CliServer>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5011, 0x04}, {"cpu", "load", "can_server", "%", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuLoad<emb::Probe::CanServer>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5011, 0x05}, {"cpu", "load", "systemclock_isr", "%", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuLoad<emb::Probe::SystemClockIsr>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5011, 0x06}, {"cpu", "load", "can_isr", "%", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuLoad<emb::Probe::CanIsr>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5011, 0x07}, {"cpu", "load", "idle", "%", OD_FLOAT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuLoad<emb::Probe::Idle>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5012, 0x00}, {"cpu", "wcet", "superloop", "clk", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuWcet<emb::Probe::Superloop>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5012, 0x01}, {"cpu", "wcet", "syslog_ipc", "clk", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuWcet<emb::Probe::SysLogIpc>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5012, 0x02}, {"cpu", "wcet", "clock_tasks", "clk", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuWcet<emb::Probe::ClockTasks>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5012, 0x03}, {"cpu", "wcet", "cli_server", "clk", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuWcet<emb::Probe::CliServer>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5012, 0x04}, {"cpu", "wcet", "can_server", "clk", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuWcet<emb::Probe::CanServer>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5012, 0x05}, {"cpu", "wcet", "systemclock_isr", "clk", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuWcet<emb::Probe::SystemClockIsr>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5012, 0x06}, {"cpu", "wcet", "can_isr", "clk", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuWcet<emb::Probe::CanIsr>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5012, 0x07}, {"cpu", "wcet", "idle", "clk", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuWcet<emb::Probe::Idle>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5013, 0x00}, {"cpu", "rate", "superloop", "Hz", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuRate<emb::Probe::Superloop>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5013, 0x01}, {"cpu", "rate", "syslog_ipc", "Hz", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuRate<emb::Probe::SysLogIpc>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5013, 0x02}, {"cpu", "rate", "clock_tasks", "Hz", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuRate<emb::Probe::ClockTasks>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5013, 0x03}, {"cpu", "rate", "cli_server", "Hz", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuRate<emb::Probe::CliServer>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5013, 0x04}, {"cpu", "rate", "can_server", "Hz", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuRate<emb::Probe::CanServer>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5013, 0x05}, {"cpu", "rate", "systemclock_isr", "Hz", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuRate<emb::Probe::SystemClockIsr>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5013, 0x06}, {"cpu", "rate", "can_isr", "Hz", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuRate<emb::Probe::CanIsr>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5013, 0x07}, {"cpu", "rate", "idle", "Hz", OD_UINT32, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getCpuRate<emb::Probe::Idle>, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5020, 0x00}, {"system", "config", "blob", "", OD_DOMAIN, OD_ACCESS_RW, OD_PTR(&od::configBlob), OD_NO_INDIRECT_READ_ACCESS, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5030, 0x00}, {"pdo", "demo", "flag", "", OD_BOOL, OD_ACCESS_RW, OD_PTR(&od::pdoDemo.flag), OD_NO_INDIRECT_READ_ACCESS, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5030, 0x01}, {"pdo", "demo", "counter", "", OD_UINT16, OD_ACCESS_RW, OD_PTR(&od::pdoDemo.counter), OD_NO_INDIRECT_READ_ACCESS, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5030, 0x02}, {"pdo", "demo", "offset", "", OD_INT16, OD_ACCESS_RW, OD_PTR(&od::pdoDemo.offset), OD_NO_INDIRECT_READ_ACCESS, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5030, 0x03}, {"pdo", "demo", "position", "", OD_INT32, OD_ACCESS_RW, OD_PTR(&od::pdoDemo.position), OD_NO_INDIRECT_READ_ACCESS, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5030, 0x04}, {"pdo", "demo", "status", "", OD_UINT32, OD_ACCESS_RW, OD_PTR(&od::pdoDemo.status), OD_NO_INDIRECT_READ_ACCESS, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5030, 0x05}, {"pdo", "demo", "speed", "rpm", OD_FLOAT32, OD_ACCESS_RW, OD_PTR(&od::pdoDemo.speed), OD_NO_INDIRECT_READ_ACCESS, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5FFF, 0x00}, {"system", "info", "firmware_version", "", OD_STRING_4CHARS, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getFirmwareVersion, OD_NO_INDIRECT_WRITE_ACCESS}},
+{{0x5FFF, 0x01}, {"system", "info", "build_configuration", "", OD_STRING_4CHARS, OD_ACCESS_RO, OD_NO_DIRECT_ACCESS, od::getBuildConfiguration, OD_NO_INDIRECT_WRITE_ACCESS}},
+};
+
+
+/// Key index: index << 8 | subindex, parallel to objectDictionary.
+extern const uint32_t objectDictionaryKeys[] = {
+	0x100800, 0x500000, 0x500001, 0x501000, 0x501001, 0x501002, 0x501003, 0x501004,
+	0x501100, 0x501101, 0x501102, 0x501103, 0x501104, 0x501105, 0x501106, 0x501107,
+	0x501200, 0x501201, 0x501202, 0x501203, 0x501204, 0x501205, 0x501206, 0x501207,
+	0x501300, 0x501301, 0x501302, 0x501303, 0x501304, 0x501305, 0x501306, 0x501307,
+	0x502000, 0x503000, 0x503001, 0x503002, 0x503003, 0x503004, 0x503005, 0x5FFF00,
+	0x5FFF01,
+};
+
+
+extern const size_t objectDictionaryLen = 41;
+
+
+} // namespace tests
+
+
+} // namespace ucanopen
+
+
@@ -0,0 +1,208 @@
+/**
+ * @file ucanopen_tests_od.h
+ * @ingroup ucanopen
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Access functions of test object dictionary. Dictionary table is generated from ucanopen_tests_od.csv:
+ * python3 scripts/odgen/odgen.py cpu1/src/ucanopen/tests/ucanopen_tests_od.csv
+ *		--cpp cpu1/src/ucanopen/tests/ucanopen_tests_od.cpp --eds cpu1/src/ucanopen/tests/ucanopen_tests.eds
+ *		--include ucanopen_tests_od.h --namespace ucanopen::tests --product ucanopen_tests
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include "ucanopen_tests.h"
+#include "emb/emb_trace/emb_trace.h"
+#include "emb/emb_cpuload/emb_cpuload.h"
+
+
+namespace ucanopen {
+
+
+namespace tests {
+
+
+/// Index of trace event read through OD, defined in ucanopen_tests.cpp
+extern uint32_t traceCursor;
+
+
+namespace od {
+
+
+/// Configuration blob: bulk data transferred by segmented or block SDO, defined in ucanopen_tests.cpp
+extern ODDomain configBlob;
+
+
+/// Variables with direct access, they can be mapped to PDOs. Defined in ucanopen_tests.cpp
+struct PdoDemo
+{
+	bool flag;
+	uint16_t counter;
+	int16_t offset;
+	int32_t position;
+	uint32_t status;
+	float speed;
+};
+extern PdoDemo pdoDemo;
+
+
+/// Packs first 4 characters of string (one character per byte, zero-padded) into SDO data.
+inline ODAccessStatus getShortString(CobSdoData& dest, const char* str)
+{
+	uint16_t bytes[4] = {0};	// character per word as char on C28x
+	for (size_t i = 0; (i < 4) && (str[i] != '\0'); ++i)
+	{
+		bytes[i] = str[i];
+	}
+	uint32_t nameRaw = 0;
+	emb::c28x::from_bytes<uint32_t>(nameRaw, bytes);
+	memcpy(&dest, &nameRaw, sizeof(uint32_t));
+	return ODAccessStatus::Success;
+}
+
+
+inline ODAccessStatus getDeviceName(CobSdoData& dest)
+{
+	return getShortString(dest, SysInfo::deviceNameShort);
+}
+
+
+inline ODAccessStatus getFirmwareVersion(CobSdoData& dest)
+{
+	return getShortString(dest, GIT_HASH);
+}
+
+
+inline ODAccessStatus getBuildConfiguration(CobSdoData& dest)
+{
+	return getShortString(dest, SysInfo::buildConfigurationShort);
+}
+
+
+inline ODAccessStatus getSyslogMessage(CobSdoData& dest)
+{
+	uint32_t message = SysLog::readMessage().underlying_value();
+	SysLog::popMessage();
+	memcpy(&dest, &message, sizeof(uint32_t));
+	return ODAccessStatus::Success;
+}
+
+inline ODAccessStatus getUptime(CobSdoData& dest)
+{
+	float time = mcu::chrono::SystemClock::now() / 1000.f;
+	memcpy(&dest, &time, sizeof(uint32_t));
+	return ODAccessStatus::Success;
+}
+
+
+inline ODAccessStatus getTraceEventCount(CobSdoData& dest)
+{
+	dest.u32 = emb::trace::Recorder::size();
+	return ODAccessStatus::Success;
+}
+
+
+inline ODAccessStatus getTraceCursor(CobSdoData& dest)
+{
+	dest.u32 = traceCursor;
+	return ODAccessStatus::Success;
+}
+
+
+/// Side effect: trace recording is stopped to freeze buffer while it is being read, it is restarted by trace recording
+/// entry (0x5010:04) as by "trace start" CLI command.
+inline ODAccessStatus setTraceCursor(CobSdoData val)
+{
+	emb::trace::Recorder::stop();	// freeze buffer while it is being read
+	if (val.u32 >= emb::trace::Recorder::size())
+	{
+		return ODAccessStatus::Fail;
+	}
+	traceCursor = val.u32;
+	return ODAccessStatus::Success;
+}
+
+
+inline ODAccessStatus getTraceEventTag(CobSdoData& dest)
+{
+	if (traceCursor >= emb::trace::Recorder::size())
+	{
+		return ODAccessStatus::Fail;
+	}
+	dest.u32 = emb::trace::Recorder::at(traceCursor).tag;
+	return ODAccessStatus::Success;
+}
+
+
+inline ODAccessStatus getTraceEventTimestamp(CobSdoData& dest)
+{
+	if (traceCursor >= emb::trace::Recorder::size())
+	{
+		return ODAccessStatus::Fail;
+	}
+	dest.u32 = emb::trace::Recorder::at(traceCursor++).timestamp;	// event is read - go to the next one
+	return ODAccessStatus::Success;
+}
+
+
+inline ODAccessStatus getTraceRecording(CobSdoData& dest)
+{
+	dest.u32 = emb::trace::Recorder::enabled() ? 1 : 0;
+	return ODAccessStatus::Success;
+}
+
+
+inline ODAccessStatus setTraceRecording(CobSdoData val)
+{
+	if (val.u32 != 0)
+	{
+		emb::trace::Recorder::start();
+	}
+	else
+	{
+		emb::trace::Recorder::stop();
+	}
+	return ODAccessStatus::Success;
+}
+
+
+template <emb::Probe::enum_type ProbeId>
+inline ODAccessStatus getCpuLoad(CobSdoData& dest)
+{
+	float load = emb::cpuload::Meter::stats(ProbeId).load / 100.f;
+	memcpy(&dest, &load, sizeof(uint32_t));
+	return ODAccessStatus::Success;
+}
+
+
+template <emb::Probe::enum_type ProbeId>
+inline ODAccessStatus getCpuWcet(CobSdoData& dest)
+{
+	dest.u32 = emb::cpuload::Meter::stats(ProbeId).wcet;
+	return ODAccessStatus::Success;
+}
+
+
+template <emb::Probe::enum_type ProbeId>
+inline ODAccessStatus getCpuRate(CobSdoData& dest)
+{
+	dest.u32 = emb::cpuload::Meter::stats(ProbeId).rate;
+	return ODAccessStatus::Success;
+}
+
+
+} // namespace od
+
+
+} // namespace tests
+
+
+} // namespace ucanopen
+
+
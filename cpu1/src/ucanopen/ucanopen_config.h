@@ -0,0 +1,20 @@
+/**
+ * @file ucanopen_config.h
+ * @ingroup ucanopen
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#define UCANOPEN_RPDO_QUEUE_DEPTH 4	// received frames per RPDO, power of 2, at least 2
+#define UCANOPEN_RSDO_QUEUE_DEPTH 8	// received SDO requests, power of 2
+
+
@@ -40,7 +40,7 @@ typedef emb::Array<uint16_t, 8> can_payload;
 template <typename T>
 inline can_payload toPayload(T message)
 {
-	EMB_STATIC_ASSERT(sizeof(T) <= 4);
+	EMB_STATIC_ASSERT(EMB_C28X_SIZEOF(T) <= 4);
 	can_payload payload;
 	payload.fill(0);
 	emb::c28x::to_bytes(payload.data, message);
@@ -59,7 +59,7 @@ inline can_payload toPayload(T message)
 template <typename T>
 inline void toPayload(can_payload& payload, T message)
 {
-	EMB_STATIC_ASSERT(sizeof(T) <= 4);
+	EMB_STATIC_ASSERT(EMB_C28X_SIZEOF(T) <= 4);
 	payload.fill(0);
 	emb::c28x::to_bytes(payload.data, message);
 }
@@ -75,7 +75,7 @@ inline void toPayload(can_payload& payload, T message)
 template <typename T>
 inline T fromPayload(const can_payload& payload)
 {
-	EMB_STATIC_ASSERT(sizeof(T) <= 4);
+	EMB_STATIC_ASSERT(EMB_C28X_SIZEOF(T) <= 4);
 	T message;
 	emb::c28x::from_bytes(message, payload.data);
 	return message;
@@ -273,6 +273,32 @@ const uint32_t sdoCcsWrite = 1;
 const uint32_t sdoScsWrite = 3;
 const uint32_t sdoCcsRead = 2;
 const uint32_t sdoScsRead = 2;
+const uint32_t sdoCcsDownloadSegment = 0;
+const uint32_t sdoScsDownloadSegment = 1;
+const uint32_t sdoCcsUploadSegment = 3;
+const uint32_t sdoScsUploadSegment = 0;
+const uint32_t sdoCsAbort = 4;
+const uint32_t sdoCcsBlockUpload = 5;
+const uint32_t sdoScsBlockUpload = 6;
+const uint32_t sdoCcsBlockDownload = 6;
+const uint32_t sdoScsBlockDownload = 5;
+}
+
+
+// SDO abort codes (CiA 301)
+namespace sdo_abort_codes {
+const uint32_t toggleBit = 0x05030000;
+const uint32_t timeout = 0x05040000;
+const uint32_t invalidCommand = 0x05040001;
+const uint32_t invalidBlockSize = 0x05040002;
+const uint32_t invalidSequenceNumber = 0x05040003;
+const uint32_t crcError = 0x05040004;
+const uint32_t unsupportedAccess = 0x06010000;
+const uint32_t writeOnly = 0x06010001;
+const uint32_t readOnly = 0x06010002;
+const uint32_t objectNotFound = 0x06020000;
+const uint32_t lengthMismatch = 0x06070010;
+const uint32_t lengthTooHigh = 0x06070012;
 }
 
 
@@ -297,7 +323,8 @@ enum ODEntryDataType
 	OD_FLOAT32,
 	OD_ENUM16,
 	OD_TASK,
-	OD_STRING_4CHARS
+	OD_STRING_4CHARS,
+	OD_DOMAIN		// bulk data, dataPtr points to ODDomain, transferred by segmented or block SDO only
 };
 
 
@@ -311,8 +338,8 @@ enum ODEntryAccessRight
 
 
 /// OD entry data types sizes
-const size_t odEntryDataSizes[9] = {sizeof(bool), sizeof(int16_t), sizeof(int32_t),
-		sizeof(uint16_t), sizeof(uint32_t), sizeof(float), sizeof(uint16_t), 0, 0};
+const size_t odEntryDataSizes[10] = {sizeof(bool), sizeof(int16_t), sizeof(int32_t),
+		sizeof(uint16_t), sizeof(uint32_t), sizeof(float), sizeof(uint16_t), 0, 0, 0};
 
 
 /**
@@ -426,6 +453,28 @@ inline ODAccessStatus OD_NO_INDIRECT_READ_ACCESS(CobSdoData& dest) { return ODAc
 inline ODAccessStatus OD_NO_INDIRECT_WRITE_ACCESS(CobSdoData val) { return ODAccessStatus::NoAccess; }
 
 
+/**
+ * @brief OD_DOMAIN entry data. Octets are packed two per 16-bit word, low octet first, so that the same buffer
+ * holds the same octet stream on C28x and host. SDO transfers read and write the buffer in place:
+ * data must not be changed during upload, buffer contents are undefined after aborted download.
+ *
+ */
+struct ODDomain
+{
+	uint16_t* data;
+	size_t capacity;	// buffer size, octets
+	size_t size;		// size of valid data, octets: uploaded size, set by completed download
+
+	unsigned int octet(size_t pos) const { return (data[pos >> 1] >> ((pos & 1) * 8)) & 0xFF; }
+
+	void setOctet(size_t pos, unsigned int octet)
+	{
+		uint16_t& word = data[pos >> 1];
+		word = (pos & 1) ? ((word & 0x00FF) | ((octet & 0xFF) << 8)) : ((word & 0xFF00) | (octet & 0xFF));
+	}
+};
+
+
 /// OD_TASK execution status
 SCOPED_ENUM_DECLARE_BEGIN(TaskStatus)
 {
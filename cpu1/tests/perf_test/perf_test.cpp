@@ -0,0 +1,104 @@
+///
+#include "perf_test.h"
+#include "emb/emb_trace/emb_trace.h"
+#include "emb/emb_cpuload/emb_cpuload.h"
+
+
+///
+///
+///
+void printBenchmarkResult(const char* name, uint32_t cycles, uint32_t iterations)
+{
+	char str[64] = {0};
+	snprintf(str, 63, "[ BENCH  ] %s: %lu clk/iter", name, cycles / iterations);
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+///
+///
+///
+void PerfTest::HighResolutionClockTest()
+{
+	using mcu::chrono::HighResolutionClock;
+	const uint32_t iterations = 100;
+
+	uint64_t prev = HighResolutionClock::ticks();
+	uint32_t start = HighResolutionClock::counter();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		uint64_t ticks = HighResolutionClock::ticks();
+		EMB_ASSERT_TRUE(ticks >= prev);
+		prev = ticks;
+	}
+	uint32_t finish = HighResolutionClock::counter();
+	EMB_ASSERT_TRUE(start > finish);
+	printBenchmarkResult("extended clock read + check", start - finish, iterations);
+}
+
+
+///
+///
+///
+void PerfTest::TraceTest()
+{
+	using mcu::chrono::HighResolutionClock;
+	const uint32_t iterations = 100;
+
+	emb::trace::Recorder::init(HighResolutionClock::counter);
+
+	// disabled probe cost
+	uint32_t start = HighResolutionClock::counter();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		EMB_TRACE_INSTANT(Superloop);
+	}
+	uint32_t finish = HighResolutionClock::counter();
+	EMB_ASSERT_TRUE(start > finish);	// high resolution clock counts down, timer must not be reloaded
+	printBenchmarkResult("trace event, disabled", start - finish, iterations);
+
+	// enabled probe cost
+	emb::trace::Recorder::start();
+	start = HighResolutionClock::counter();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		EMB_TRACE_INSTANT(Superloop);
+	}
+	finish = HighResolutionClock::counter();
+	emb::trace::Recorder::stop();
+	EMB_ASSERT_TRUE(start > finish);
+	EMB_ASSERT_EQUAL(emb::trace::Recorder::size(), iterations);
+	printBenchmarkResult("trace event, enabled", start - finish, iterations);
+
+	emb::trace::Recorder::clear();
+}
+
+
+///
+///
+///
+void PerfTest::CpuLoadTest()
+{
+	using mcu::chrono::HighResolutionClock;
+	const uint32_t iterations = 100;
+
+	emb::cpuload::Meter::init(HighResolutionClock::counter, HighResolutionClock::period(),
+			mcu::sysclkFreq(), mcu::chrono::SystemClock::now());
+
+	// enter/exit hook pair cost
+	uint32_t start = HighResolutionClock::counter();
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		EMB_CPULOAD_ENTER(CliServer);
+		EMB_CPULOAD_EXIT(CliServer);
+	}
+	uint32_t finish = HighResolutionClock::counter();
+	EMB_ASSERT_TRUE(start > finish);
+	printBenchmarkResult("cpuload enter/exit", start - finish, iterations);
+
+	emb::cpuload::Meter::update(mcu::chrono::SystemClock::now() + 1);
+	EMB_ASSERT_TRUE(emb::cpuload::Meter::stats(emb::Probe::CliServer).wcet > 0);
+}
+
+
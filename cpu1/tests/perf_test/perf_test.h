@@ -0,0 +1,30 @@
+///
+///
+///
+#pragma once
+
+
+#include "emb/emb_testrunner/emb_testrunner.h"
+#include "mcu_f2837xd/system/mcu_system.h"
+#include "mcu_f2837xd/chrono/mcu_chrono.h"
+
+
+class PerfTest
+{
+public:
+	static void HighResolutionClockTest();
+	static void TraceTest();
+	static void CpuLoadTest();
+};
+
+
+/**
+ * @brief Prints benchmark result line through test runner output.
+ * @param name - benchmark name
+ * @param cycles - total clock cycles spent
+ * @param iterations - number of iterations
+ * @return (none)
+ */
+void printBenchmarkResult(const char* name, uint32_t cycles, uint32_t iterations);
+
+
@@ -7,12 +7,16 @@
 
 #include "sys/syslog/syslog.h"
 #include "mcu_test/mcu_test.h"
+#include "perf_test/perf_test.h"
 
 
 void emb::run_tests()
 {
 	SysLog::init(SysLog::IpcFlags());
 	mcu::chrono::SystemClock::init();
+	mcu::chrono::HighResolutionClock::init(1000000);
+	mcu::chrono::HighResolutionClock::enableExtendedTicks();
+	mcu::chrono::HighResolutionClock::start();
 
 	mcu::adc::Config adcConfig =
 	{
@@ -40,15 +44,30 @@ void emb::run_tests()
 	EMB_RUN_TEST(EmbTest::ArrayTest);
 	EMB_RUN_TEST(EmbTest::QueueTest);
 	EMB_RUN_TEST(EmbTest::CircularBufferTest);
+	EMB_RUN_TEST(EmbTest::RingBufferTest);
+	EMB_RUN_TEST(EmbTest::CrcTest);
+	EMB_RUN_TEST(EmbTest::CobsTest);
 	EMB_RUN_TEST(EmbTest::FilterTest);
 	EMB_RUN_TEST(EmbTest::StackTest);
 	EMB_RUN_TEST(EmbTest::BitsetTest);
 	EMB_RUN_TEST(EmbTest::StaticVectorTest);
 	EMB_RUN_TEST(EmbTest::StringTest);
+	EMB_RUN_TEST(EmbTest::ExtendedClockTest);
+	EMB_RUN_TEST(EmbTest::ProbeRegistryTest);
+	EMB_RUN_TEST(EmbTest::SchedulerTest);
+	EMB_RUN_TEST(EmbTest::DeadlineMonitorTest);
+	EMB_RUN_TEST(EmbTest::ExecutorTest);
+	EMB_RUN_TEST(EmbTest::EventsTest);
+	EMB_RUN_TEST(EmbTest::TraceTest);
+	EMB_RUN_TEST(EmbTest::CpuLoadTest);
 
 	EMB_RUN_TEST(McuTest::GpioTest);
 	EMB_RUN_TEST(McuTest::ChronoTest);
 
+	EMB_RUN_TEST(PerfTest::HighResolutionClockTest);
+	EMB_RUN_TEST(PerfTest::TraceTest);
+	EMB_RUN_TEST(PerfTest::CpuLoadTest);
+
 	emb::TestRunner::printResult();
 
 	while (true)
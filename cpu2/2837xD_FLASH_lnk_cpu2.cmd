@@ -105,6 +105,8 @@ SECTIONS
       shared_ucanopen_canb_tpdo_data
       shared_ucanopen_cana_tsdo_data
       shared_ucanopen_canb_tsdo_data
+      shared_ucanopen_cana_rxcursor_data
+      shared_ucanopen_canb_rxcursor_data
       shared_syslog_data_cpu1
       shared_syslog_messages
    }
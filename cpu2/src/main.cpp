@@ -113,11 +113,6 @@ void main()
 
 	ucanopen::IpcFlags canIpcFlags =
 	{
-		.rpdo1Received = mcu::ipc::Flag(4, mcu::ipc::Mode::Dualcore),
-		.rpdo2Received = mcu::ipc::Flag(5, mcu::ipc::Mode::Dualcore),
-		.rpdo3Received = mcu::ipc::Flag(6, mcu::ipc::Mode::Dualcore),
-		.rpdo4Received = mcu::ipc::Flag(7, mcu::ipc::Mode::Dualcore),
-		.rsdoReceived = mcu::ipc::Flag(8, mcu::ipc::Mode::Dualcore),
 		.tsdoReady = mcu::ipc::Flag(9, mcu::ipc::Mode::Dualcore)
 	};
 	ucanopen::tests::Server<mcu::can::Peripheral::CanB, mcu::ipc::Mode::Dualcore, mcu::ipc::Role::Primary> canServer(
@@ -0,0 +1,434 @@
+#!/usr/bin/env python3
+#
+# Generates uCANopen object dictionary from declarative description:
+#	- C++ source with const ODEntry table sorted by key and key index (index << 8 | subindex),
+#	  server uses them as is (see ucanopen::ODTable), nothing is sorted or validated at boot;
+#	- EDS file for CANopen PC tools. Objects with direct access and data type of up to 32 bits are PDO-mappable,
+#	  PDO communication and mapping parameters (0x1400, 0x1600, 0x1800, 0x1A00 + PDO number) are added to EDS:
+#	  server serves them itself, they are not in description and not in generated table.
+#
+# Description is CSV, JSON or YAML (YAML requires PyYAML). CSV has header line, JSON/YAML is a list of objects
+# (or {"objects": [...]}) with the same fields:
+#	index, subindex	- integers, hex with 0x prefix is allowed
+#	category, subcategory, name, unit
+#	type		- bool, int16, int32, uint16, uint32, float32, enum16, task, string4, domain (data is ODDomain)
+#	access		- rw, ro, wo
+#	data		- C++ expression of data pointer (wrapped in OD_PTR), empty - no direct access
+#	read, write	- C++ names of access functions, empty - no indirect access
+#
+# Usage: odgen.py <description> [--cpp <out.cpp>] [--eds <out.eds>] [--include <header>]
+#		[--namespace <ns>] [--symbol <name>] [--product <name>]
+#	odgen.py <description> --verify-eds <file.eds>	(checks that EDS describes the same objects)
+#	odgen.py <description> --check --cpp <file.cpp> --eds <file.eds> ...	(checks that files are up to date)
+#
+import argparse
+import configparser
+import csv
+import json
+import os
+import sys
+
+
+TYPES = {
+	# description type: (C++ enumerator, EDS data type, PDO-mappable) - mappable as odEntryDataBits in ucanopen_pdomapping.cpp
+	"bool": ("OD_BOOL", 0x0001, True),
+	"int16": ("OD_INT16", 0x0003, True),
+	"int32": ("OD_INT32", 0x0004, True),
+	"uint16": ("OD_UINT16", 0x0006, True),
+	"uint32": ("OD_UINT32", 0x0007, True),
+	"float32": ("OD_FLOAT32", 0x0008, True),
+	"enum16": ("OD_ENUM16", 0x0006, True),
+	"task": ("OD_TASK", 0x0007, False),
+	"string4": ("OD_STRING_4CHARS", 0x0009, False),
+	"domain": ("OD_DOMAIN", 0x000F, False),
+}
+
+ACCESS = {
+	"rw": "OD_ACCESS_RW",
+	"ro": "OD_ACCESS_RO",
+	"wo": "OD_ACCESS_WO",
+}
+
+# PDO parameters served by server (see Server::_readPdoParameter()), as in DeviceInfo NrOfRXPDO/NrOfTXPDO
+PDO_COUNT = 4
+UNSIGNED8 = 0x0005
+UNSIGNED16 = 0x0006
+UNSIGNED32 = 0x0007
+MAPPING_ENTRIES = 8	# PdoMapping::maxEntries
+
+FIELDS = ["index", "subindex", "category", "subcategory", "name", "unit", "type", "access", "data", "read", "write"]
+
+
+class DescriptionError(Exception):
+	pass
+
+
+def load(path):
+	ext = os.path.splitext(path)[1].lower()
+	with open(path, newline="") as f:
+		if ext == ".csv":
+			rows = list(csv.DictReader(f))
+		elif ext == ".json":
+			rows = json.load(f)
+		elif ext in (".yaml", ".yml"):
+			try:
+				import yaml
+			except ImportError:
+				raise DescriptionError("PyYAML is required for YAML description")
+			rows = yaml.safe_load(f)
+		else:
+			raise DescriptionError("unknown description format: %s" % ext)
+	if isinstance(rows, dict):
+		rows = rows.get("objects", [])
+	return [normalize(row, n + 1) for n, row in enumerate(rows)]
+
+
+def normalize(row, n):
+	entry = {}
+	for field in FIELDS:
+		value = row.get(field, "")
+		entry[field] = "" if value is None else str(value).strip()
+	try:
+		entry["index"] = int(entry["index"], 0)
+		entry["subindex"] = int(entry["subindex"], 0)
+	except ValueError:
+		raise DescriptionError("object %d: invalid index or subindex" % n)
+	if entry["type"] not in TYPES:
+		raise DescriptionError("object %d: unknown type \"%s\"" % (n, entry["type"]))
+	if entry["access"] not in ACCESS:
+		raise DescriptionError("object %d: unknown access \"%s\"" % (n, entry["access"]))
+	return entry
+
+
+def key(entry):
+	return (entry["index"] << 8) | entry["subindex"]
+
+
+def is_pdo_parameter(index):
+	"""Same as Server::_isPdoParameter()."""
+	return (index & 0xFF) < PDO_COUNT and (index & 0xFF00) in (0x1400, 0x1600, 0x1800, 0x1A00)
+
+
+def pdo_mappable(entry):
+	"""Same rules as PdoMapping: direct access and data type of up to 32 bits (access direction is checked at mapping)."""
+	return bool(entry["data"]) and TYPES[entry["type"]][2]
+
+
+def qualified_name(entry):
+	return "%s.%s.%s" % (entry["category"], entry["subcategory"], entry["name"])
+
+
+def validate(entries):
+	"""Same rules as ucanopen::ODIndex::validate(), so generated table passes debug-build check."""
+	keys = {}
+	names = {}
+	for entry in entries:
+		where = "object 0x%04X:%02X" % (entry["index"], entry["subindex"])
+		if not (0 <= entry["index"] <= 0xFFFF and 0 <= entry["subindex"] <= 0xFF):
+			raise DescriptionError("%s: index or subindex out of range" % where)
+		if is_pdo_parameter(entry["index"]):
+			raise DescriptionError("%s: index is reserved for PDO parameters served by server" % where)
+		if key(entry) in keys:
+			raise DescriptionError("%s: duplicate key" % where)
+		keys[key(entry)] = entry
+		name = (entry["category"], entry["subcategory"], entry["name"])
+		if name in names:
+			raise DescriptionError("%s: duplicate name %s" % (where, qualified_name(entry)))
+		names[name] = entry
+
+		readable = entry["access"] in ("rw", "ro")
+		writable = entry["access"] in ("rw", "wo")
+		if readable and not (entry["read"] or entry["data"]):
+			raise DescriptionError("%s: readable object has neither data nor read function" % where)
+		if not readable and (entry["read"] or entry["data"]):
+			raise DescriptionError("%s: object is not readable, but has data or read function" % where)
+		if writable and not (entry["write"] or entry["data"]):
+			raise DescriptionError("%s: writable object has neither data nor write function" % where)
+		if not writable and (entry["write"] or entry["data"]):
+			raise DescriptionError("%s: object is not writable, but has data or write function" % where)
+	return sorted(entries, key=key)
+
+
+def c_string(value):
+	return "\"%s\"" % value.replace("\\", "\\\\").replace("\"", "\\\"")
+
+
+def generate_cpp(entries, source, include, namespaces, symbol):
+	lines = []
+	lines.append("// Generated by scripts/odgen/odgen.py from %s, do not edit." % source)
+	lines.append("// Table is sorted by key and validated by generator, server uses it without sorting.")
+	lines.append("")
+	lines.append("")
+	lines.append("#include \"%s\"" % include)
+	lines.append("")
+	lines.append("")
+	for ns in namespaces:
+		lines.append("namespace %s {" % ns)
+		lines.append("")
+		lines.append("")
+	lines.append("extern const ODEntry %s[] = {" % symbol)
+	for entry in entries:
+		lines.append("{{0x%04X, 0x%02X}, {%s, %s, %s, %s, %s, %s, %s, %s, %s}}," % (
+				entry["index"], entry["subindex"],
+				c_string(entry["category"]), c_string(entry["subcategory"]), c_string(entry["name"]), c_string(entry["unit"]),
+				TYPES[entry["type"]][0], ACCESS[entry["access"]],
+				("OD_PTR(%s)" % entry["data"]) if entry["data"] else "OD_NO_DIRECT_ACCESS",
+				entry["read"] or "OD_NO_INDIRECT_READ_ACCESS",
+				entry["write"] or "OD_NO_INDIRECT_WRITE_ACCESS"))
+	lines.append("};")
+	lines.append("")
+	lines.append("")
+	lines.append("/// Key index: index << 8 | subindex, parallel to %s." % symbol)
+	lines.append("extern const uint32_t %sKeys[] = {" % symbol)
+	for i in range(0, len(entries), 8):
+		lines.append("\t" + " ".join("0x%06X," % key(entry) for entry in entries[i:i + 8]))
+	lines.append("};")
+	lines.append("")
+	lines.append("")
+	lines.append("extern const size_t %sLen = %d;" % (symbol, len(entries)))
+	lines.append("")
+	lines.append("")
+	for ns in reversed(namespaces):
+		lines.append("} // namespace %s" % ns)
+		lines.append("")
+		lines.append("")
+	return "\n".join(lines) + "\n"
+
+
+def group_by_index(entries):
+	groups = []
+	for entry in entries:
+		if groups and groups[-1][0] == entry["index"]:
+			groups[-1][1].append(entry)
+		else:
+			groups.append((entry["index"], [entry]))
+	return groups
+
+
+def eds_object(lines, section, name, entry):
+	lines.append("[%s]" % section)
+	lines.append("ParameterName=%s" % name)
+	lines.append("ObjectType=0x7")
+	lines.append("DataType=0x%04X" % TYPES[entry["type"]][1])
+	lines.append("AccessType=%s" % entry["access"])
+	lines.append("PDOMapping=%d" % (1 if pdo_mappable(entry) else 0))
+	lines.append("")
+
+
+def pdo_parameters():
+	"""PDO communication and mapping parameters: (index, name, [(subindex, name, EDS data type, access)])."""
+	mapping = [(0, "Number of mapped objects", UNSIGNED8, "rw")]
+	mapping += [(n, "Mapped object %d" % n, UNSIGNED32, "rw") for n in range(1, MAPPING_ENTRIES + 1)]
+	objects = []
+	for n in range(PDO_COUNT):
+		objects.append((0x1400 + n, "RPDO %d communication parameter" % (n + 1), [
+				(0, "Highest sub-index supported", UNSIGNED8, "ro"),
+				(1, "COB-ID", UNSIGNED32, "rw"),
+				(2, "Transmission type", UNSIGNED8, "ro"),
+				(5, "Event timer", UNSIGNED16, "rw")]))
+	for n in range(PDO_COUNT):
+		objects.append((0x1600 + n, "RPDO %d mapping parameter" % (n + 1), mapping))
+	for n in range(PDO_COUNT):
+		objects.append((0x1800 + n, "TPDO %d communication parameter" % (n + 1), [
+				(0, "Highest sub-index supported", UNSIGNED8, "ro"),
+				(1, "COB-ID", UNSIGNED32, "rw"),
+				(2, "Transmission type", UNSIGNED8, "rw"),
+				(3, "Inhibit time", UNSIGNED16, "rw"),
+				(5, "Event timer", UNSIGNED16, "rw")]))
+	for n in range(PDO_COUNT):
+		objects.append((0x1A00 + n, "TPDO %d mapping parameter" % (n + 1), mapping))
+	return objects
+
+
+def pdo_record(lines, index, name, subobjects):
+	lines.append("[%04X]" % index)
+	lines.append("SubNumber=%d" % len(subobjects))
+	lines.append("ParameterName=%s" % name)
+	lines.append("ObjectType=0x9")
+	lines.append("")
+	for subindex, subname, data_type, access in subobjects:
+		lines.append("[%04Xsub%X]" % (index, subindex))
+		lines.append("ParameterName=%s" % subname)
+		lines.append("ObjectType=0x7")
+		lines.append("DataType=0x%04X" % data_type)
+		lines.append("AccessType=%s" % access)
+		lines.append("PDOMapping=0")
+		lines.append("")
+
+
+def generate_eds(entries, source, product):
+	"""Object with one subindex 0 is VAR, other objects are RECORD. Subindex 0 of RECORD is a data object
+	as in uCANopen dictionary, not number of entries. PDO parameters are standard RECORDs: communication parameters
+	are writable in single-core mode only (in dual-core mode they are owned by primary core), so are TPDO mappings."""
+	groups = group_by_index(entries)
+	pdos = pdo_parameters()
+	lines = []
+	lines.append("; Generated by scripts/odgen/odgen.py from %s, do not edit." % source)
+	lines.append("")
+	lines.append("[FileInfo]")
+	lines.append("FileName=%s.eds" % product)
+	lines.append("FileVersion=1")
+	lines.append("FileRevision=0")
+	lines.append("EDSVersion=4.0")
+	lines.append("Description=%s object dictionary" % product)
+	lines.append("")
+	lines.append("[DeviceInfo]")
+	lines.append("VendorName=")
+	lines.append("ProductName=%s" % product)
+	for baudrate in (10, 20, 50, 125, 250, 500, 800, 1000):
+		lines.append("BaudRate_%d=1" % baudrate)
+	lines.append("SimpleBootUpMaster=0")
+	lines.append("SimpleBootUpSlave=1")
+	lines.append("Granularity=0")
+	lines.append("DynamicChannelsSupported=0")
+	lines.append("GroupMessaging=0")
+	lines.append("NrOfRXPDO=4")
+	lines.append("NrOfTXPDO=4")
+	lines.append("LSS_Supported=0")
+	lines.append("")
+
+	sections = {"MandatoryObjects": [], "OptionalObjects": [], "ManufacturerObjects": []}
+	for index in sorted([index for index, _ in groups] + [index for index, _, _ in pdos]):
+		if index in (0x1000, 0x1001, 0x1018):
+			sections["MandatoryObjects"].append(index)
+		elif 0x2000 <= index <= 0x5FFF:
+			sections["ManufacturerObjects"].append(index)
+		else:
+			sections["OptionalObjects"].append(index)
+	for name in ("MandatoryObjects", "OptionalObjects", "ManufacturerObjects"):
+		lines.append("[%s]" % name)
+		lines.append("SupportedObjects=%d" % len(sections[name]))
+		for n, index in enumerate(sections[name]):
+			lines.append("%d=0x%04X" % (n + 1, index))
+		lines.append("")
+
+	records = [(pdo[0], pdo, None) for pdo in pdos] + [(index, None, group) for index, group in groups]
+	for index, pdo, group in sorted(records, key=lambda record: record[0]):
+		if pdo:
+			pdo_record(lines, *pdo)
+			continue
+		if len(group) == 1 and group[0]["subindex"] == 0:
+			eds_object(lines, "%04X" % index, qualified_name(group[0]), group[0])
+			continue
+		categories = sorted(set(entry["category"] for entry in group))
+		lines.append("[%04X]" % index)
+		lines.append("SubNumber=%d" % len(group))
+		lines.append("ParameterName=%s" % "/".join(categories))
+		lines.append("ObjectType=0x9")
+		lines.append("")
+		for entry in group:
+			eds_object(lines, "%04Xsub%X" % (index, entry["subindex"]), qualified_name(entry), entry)
+	return "\n".join(lines) + "\n"
+
+
+def verify_eds(entries, path):
+	"""Reads EDS back and checks that every object matches description and there are no other objects
+	besides PDO parameters, which must be present."""
+	eds = configparser.ConfigParser(interpolation=None)
+	eds.optionxform = str
+	eds.read(path)
+	found = {}
+	pdo_indices = set()
+	for section in eds.sections():
+		if section.upper().startswith("0X") or not all(c in "0123456789ABCDEFabcdefsub" for c in section):
+			continue
+		if "sub" in section:
+			index, subindex = section.split("sub")
+			index, subindex = int(index, 16), int(subindex, 16)
+		else:
+			index, subindex = int(section, 16), 0
+		if is_pdo_parameter(index):
+			if "sub" not in section:
+				pdo_indices.add(index)
+			continue
+		if eds[section].get("ObjectType") != "0x7":
+			continue
+		found[(index << 8) | subindex] = eds[section]
+	errors = []
+	for entry in entries:
+		where = "object 0x%04X:%02X" % (entry["index"], entry["subindex"])
+		obj = found.pop(key(entry), None)
+		if obj is None:
+			errors.append("%s: not found in EDS" % where)
+			continue
+		if obj.get("ParameterName") != qualified_name(entry):
+			errors.append("%s: name %s" % (where, obj.get("ParameterName")))
+		if int(obj.get("DataType", "0"), 0) != TYPES[entry["type"]][1]:
+			errors.append("%s: data type %s" % (where, obj.get("DataType")))
+		if obj.get("AccessType") != entry["access"]:
+			errors.append("%s: access %s" % (where, obj.get("AccessType")))
+		if obj.get("PDOMapping") != ("1" if pdo_mappable(entry) else "0"):
+			errors.append("%s: PDO mapping %s" % (where, obj.get("PDOMapping")))
+	for index, _, _ in pdo_parameters():
+		if index not in pdo_indices:
+			errors.append("object 0x%04X: PDO parameter not found in EDS" % index)
+	for k in sorted(found):
+		errors.append("object 0x%04X:%02X: not in description" % (k >> 8, k & 0xFF))
+	return errors
+
+
+def read_file(path):
+	try:
+		with open(path, newline="") as f:
+			return f.read()
+	except OSError:
+		return None
+
+
+def write_file(path, text):
+	with open(path, "w", newline="\n") as f:
+		f.write(text)
+
+
+def main(argv):
+	parser = argparse.ArgumentParser(description="uCANopen object dictionary generator")
+	parser.add_argument("description")
+	parser.add_argument("--cpp", help="output C++ source")
+	parser.add_argument("--eds", help="output EDS file")
+	parser.add_argument("--include", default="ucanopen/ucanopen_def.h", help="header with ODEntry and access functions")
+	parser.add_argument("--namespace", default="ucanopen", help="namespace of table, e.g. ucanopen::tests")
+	parser.add_argument("--symbol", default="objectDictionary", help="table name")
+	parser.add_argument("--product", default="device", help="product name in EDS")
+	parser.add_argument("--verify-eds", help="check EDS against description")
+	parser.add_argument("--check", action="store_true", help="compare outputs with existing files instead of writing")
+	args = parser.parse_args(argv[1:])
+
+	source = os.path.basename(args.description)
+	try:
+		entries = validate(load(args.description))
+	except DescriptionError as e:
+		print("odgen: %s: %s" % (source, e))
+		return 1
+
+	if args.verify_eds:
+		errors = verify_eds(entries, args.verify_eds)
+		for error in errors:
+			print("odgen: %s: %s" % (os.path.basename(args.verify_eds), error))
+		if errors:
+			return 1
+		print("odgen: %s matches %s, %d objects." % (os.path.basename(args.verify_eds), source, len(entries)))
+		return 0
+
+	outputs = []
+	if args.cpp:
+		outputs.append((args.cpp, generate_cpp(entries, source, args.include, args.namespace.split("::"), args.symbol)))
+	if args.eds:
+		outputs.append((args.eds, generate_eds(entries, source, args.product)))
+
+	if args.check:
+		stale = [path for path, text in outputs if read_file(path) != text]
+		for path in stale:
+			print("odgen: %s is out of date, regenerate it from %s." % (path, source))
+		if stale:
+			return 1
+		print("odgen: %d files are up to date with %s." % (len(outputs), source))
+		return 0
+
+	for path, text in outputs:
+		write_file(path, text)
+	print("odgen: %d objects generated from %s." % (len(entries), source))
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv))
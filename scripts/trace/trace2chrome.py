@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+#
+# Converts event-trace dump captured from CLI into Chrome trace_event JSON
+# (open with chrome://tracing or https://ui.perfetto.dev).
+#
+# Capture terminal output of the following commands into one log file:
+#	trace info
+#	trace probes
+#	trace dump (prints all events until "end", "trace dump N" starts from event N)
+#
+# Usage: trace2chrome.py <dump.log> [<out.json>]
+#
+import json
+import re
+import sys
+
+
+ANSI_ESCAPE = re.compile(r"\x1B\[[0-9;]*[A-Za-z]")
+CLOCK_LINE = re.compile(r"clock: period=(\d+) freq=(\d+)")
+PROBE_LINE = re.compile(r"probe (\d+) (\S+)")
+EVENT_LINE = re.compile(r"evt (\d+) ([BEI]) (\d+) ([0-9A-Fa-f]{8})")
+
+
+def parse(lines):
+	period = None
+	freq = None
+	probes = {}
+	events = {}
+	for line in lines:
+		line = ANSI_ESCAPE.sub("", line)
+		m = CLOCK_LINE.search(line)
+		if m:
+			period = int(m.group(1))
+			freq = int(m.group(2))
+			continue
+		m = PROBE_LINE.search(line)
+		if m:
+			probes[int(m.group(1))] = m.group(2)
+			continue
+		m = EVENT_LINE.search(line)
+		if m:
+			events[int(m.group(1))] = (m.group(2), int(m.group(3)), int(m.group(4), 16))
+	if period is None or freq is None:
+		raise ValueError("clock line not found, capture \"trace info\" output")
+	return period, freq, probes, [events[i] for i in sorted(events)]
+
+
+def convert(period, freq, probes, events):
+	# High resolution clock counts down from period to 0 and reloads.
+	# Gap between two consecutive events is assumed to be less than one clock period.
+	modulo = period + 1
+	trace_events = []
+	ticks = 0
+	prev = None
+	for (phase, probe, timestamp) in events:
+		if prev is not None:
+			ticks += (prev - timestamp) % modulo
+		prev = timestamp
+		event = {
+			"name": probes.get(probe, "probe_%d" % probe),
+			"ph": "i" if phase == "I" else phase,
+			"ts": ticks * 1e6 / freq,
+			"pid": 1,
+			"tid": 1,
+		}
+		if phase == "I":
+			event["s"] = "t"
+		trace_events.append(event)
+	return {"traceEvents": trace_events, "displayTimeUnit": "ns"}
+
+
+def main(argv):
+	if len(argv) < 2:
+		print("Usage: trace2chrome.py <dump.log> [<out.json>]")
+		return 1
+	with open(argv[1], errors="replace") as f:
+		period, freq, probes, events = parse(f.readlines())
+	trace = convert(period, freq, probes, events)
+	out = open(argv[2], "w") if len(argv) > 2 else sys.stdout
+	json.dump(trace, out, indent=1)
+	if out is not sys.stdout:
+		out.close()
+		print("%d events converted." % len(events))
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv))
@@ -0,0 +1,351 @@
+/**
+ * @file sim_cli.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Host CLI session over pipe UART: interactive (stdio or pseudo-terminal) and random-input fuzzing.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "driverlib.h"
+#include "device.h"
+#include "sim_uart.h"
+#include "mcu_f2837xd/system/mcu_system.h"
+#include "mcu_f2837xd/chrono/mcu_chrono.h"
+#include "emb/emb_events/emb_events.h"
+#include "sys/syslog/syslog.h"
+#include "cli/cli_server.h"
+#include "cli/shell/cli_shell.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+
+namespace {
+
+
+const uint32_t CLI_PIPE_INT = INT_SCIC_RX;	// SCIC is not used by firmware
+const uint64_t RESPONSE_TIMEOUT_ms = 5000;
+
+
+SCOPED_ENUM_DECLARE_BEGIN(Mode)
+{
+	Stdio,
+	Pty,
+	Fuzz
+}
+SCOPED_ENUM_DECLARE_END(Mode)
+
+
+struct Options
+{
+	Mode mode;
+	uint32_t baudrate;
+	uint64_t fuzz_ms;
+	uint32_t seed;
+};
+
+
+sim::PipeUart* pipeUart = NULL;
+__interrupt void onPipeUartRx()
+{
+	pipeUart->disableRxInterrupts();	// re-enabled by CLI task when Rx FIFO is drained, as in firmware
+	pipeUart->acknowledgeRxInterrupt();
+	emb::PendingEvents::set(emb::Event::UartRx);
+}
+
+
+/// One pass of firmware CLI task.
+void serve(cli::Server& server, sim::PipeUart& uart)
+{
+	emb::PendingEvents::take();
+	while (server.run()) {}
+	uart.enableRxInterrupts();
+}
+
+
+bool idle(cli::Server& server, sim::PipeUart& uart)
+{
+	return uart.rxLineSize() == 0 && uart.rxFifoLevel() == 0 && uart.txIdle() && !server.run();
+}
+
+
+/**
+ * @brief Stdio mode: commands are read from stdin, output is written to stdout, virtual time runs at full speed.
+ */
+int runStdio(cli::Server& server, sim::PipeUart& uart)
+{
+	uart.attachFd(STDIN_FILENO, STDOUT_FILENO);
+	bool input = true;
+	while (true)
+	{
+		if (input)
+		{
+			input = uart.pump();
+		}
+		serve(server, uart);
+		if (!input && idle(server, uart)) break;
+		if (uart.rxLineSize() == 0 && uart.txIdle() && input)
+		{
+			usleep(1000);	// waiting for input
+			sim::VirtualTime::advance_us(1000);
+		}
+		else
+		{
+			sim::VirtualTime::advanceToNextEvent();
+		}
+	}
+	printf("\n");
+	return 0;
+}
+
+
+/**
+ * @brief Pseudo-terminal mode: terminal emulator (e.g. "picocom /dev/pts/N") is connected to printed device,
+ * virtual time runs in real time.
+ */
+int runPty(cli::Server& server, sim::PipeUart& uart)
+{
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+	{
+		perror("posix_openpt");
+		return 1;
+	}
+
+	// slave is kept open in raw mode: no line discipline echo, master reads do not fail when terminal disconnects
+	int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+	termios tio;
+	tcgetattr(slave, &tio);
+	cfmakeraw(&tio);
+	tcsetattr(slave, TCSANOW, &tio);
+
+	printf("sim_cli: %s, %lu baud\n", ptsname(master), static_cast<unsigned long>(uart.baudrate()));
+	fflush(stdout);
+	uart.attachFd(master, master);
+	std::string welcome = uart.takeOutput();	// sent before terminal was created
+	ssize_t written = write(master, welcome.data(), welcome.size());
+	(void)written;
+	while (true)
+	{
+		uart.pump();
+		serve(server, uart);
+		usleep(1000);
+		sim::VirtualTime::advance_us(1000);
+	}
+	return 0;
+}
+
+
+/**
+ * @brief Sends random input: printable chars, returns, backspaces, fragments of escape sequences and arbitrary bytes.
+ * Input is sent in bursts and may overrun RX FIFO while server is busy with output.
+ */
+void sendRandomInput(sim::PipeUart& uart)
+{
+	static const char* fragments[] = {"\x1B", "\x1B[", "\x1B[A", "\x1B[B", "\x1B[C", "\x1B[D",
+			"\x1B[H", "\x1B[F", "\x1B[3~", "\x1B[3", "\x7F", "\x08", "\r", "\n", "\r\n"};
+	static const size_t fragmentCount = sizeof(fragments) / sizeof(fragments[0]);
+
+	std::string burst;
+	size_t len = 1 + rand() % 24;
+	for (size_t i = 0; i < len; ++i)
+	{
+		int kind = rand() % 100;
+		if (kind < 60)
+		{
+			burst.push_back(static_cast<char>(0x20 + rand() % 95));
+		}
+		else if (kind < 85)
+		{
+			burst += fragments[rand() % fragmentCount];
+		}
+		else
+		{
+			burst.push_back(static_cast<char>(rand() % 256));
+		}
+	}
+	uart.write(burst.data(), burst.size());
+}
+
+
+bool waitPrompt(cli::Server& server, sim::PipeUart& uart, std::string& output)
+{
+	uint64_t deadline = sim::VirtualTime::cycles() + RESPONSE_TIMEOUT_ms * (DEVICE_SYSCLK_FREQ / 1000);
+	while (sim::VirtualTime::cycles() < deadline)
+	{
+		serve(server, uart);
+		output += uart.takeOutput();
+		if (idle(server, uart) && output.find(CLI_PROMPT_END) != std::string::npos)
+		{
+			return true;
+		}
+		sim::VirtualTime::advanceToNextEvent();
+	}
+	return false;
+}
+
+
+/**
+ * @brief Fuzz mode: random input for specified virtual time, then CLI must still execute commands.
+ */
+int runFuzz(cli::Server& server, sim::PipeUart& uart, const Options& options)
+{
+	srand(options.seed);
+	uint64_t end = options.fuzz_ms * (DEVICE_SYSCLK_FREQ / 1000);
+	uint64_t bursts = 0;
+	uint64_t outputBytes = 0;
+	while (sim::VirtualTime::cycles() < end)
+	{
+		if (uart.rxLineSize() == 0 && uart.txFifoLevel() < sim::PipeUart::fifoDepth / 2 && rand() % 4 == 0)
+		{
+			sendRandomInput(uart);
+			++bursts;
+		}
+		serve(server, uart);
+		outputBytes += uart.takeOutput().size();
+		sim::VirtualTime::advance(uart.charCycles());
+	}
+
+	printf("fuzz: %llu ms, seed %lu, %lu baud: %llu bursts, rx/tx chars %llu/%llu, overruns %llu\n",
+			static_cast<unsigned long long>(options.fuzz_ms), static_cast<unsigned long>(options.seed),
+			static_cast<unsigned long>(uart.baudrate()), static_cast<unsigned long long>(bursts),
+			static_cast<unsigned long long>(uart.rxCount()), static_cast<unsigned long long>(uart.txCount()),
+			static_cast<unsigned long long>(uart.overruns()));
+
+	// recovery: the first return may only terminate pending escape sequence, the second one executes garbage
+	std::string output;
+	uart.write("\r");
+	waitPrompt(server, uart, output);
+	output.clear();
+	uart.write("\r");
+	bool recovered = waitPrompt(server, uart, output);
+	output.clear();
+	uart.write("uptime\r");
+	recovered = recovered && waitPrompt(server, uart, output) && output.find("uptime: ") != std::string::npos;
+	if (!recovered)
+	{
+		printf("fuzz: failed, CLI does not respond after random input, last output: \"%s\"\n", output.c_str());
+		return 1;
+	}
+	printf("fuzz: passed\n");
+	return 0;
+}
+
+
+void printUsage(const char* name)
+{
+	printf("Usage: %s [--stdio | --pty | --fuzz-ms N [--seed S]] [--baud B]\n"
+			"  --stdio       commands from stdin, output to stdout (default)\n"
+			"  --pty         create pseudo-terminal for terminal emulator, real-time pacing\n"
+			"  --fuzz-ms N   send random input for N ms of simulated time, then check that CLI responds\n"
+			"  --seed S      fuzz random seed (default 1)\n"
+			"  --baud B      UART baudrate (default 115200)\n", name);
+}
+
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+	options.mode = Mode::Stdio;
+	options.baudrate = 115200;
+	options.fuzz_ms = 0;
+	options.seed = 1;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--stdio") == 0)
+		{
+			options.mode = Mode::Stdio;
+		}
+		else if (strcmp(argv[i], "--pty") == 0)
+		{
+			options.mode = Mode::Pty;
+		}
+		else if (strcmp(argv[i], "--fuzz-ms") == 0 && i + 1 < argc)
+		{
+			options.mode = Mode::Fuzz;
+			options.fuzz_ms = strtoull(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			options.seed = strtoul(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "--baud") == 0 && i + 1 < argc)
+		{
+			options.baudrate = strtoul(argv[++i], NULL, 10);
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return options.baudrate != 0;
+}
+
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	mcu::initDevice();
+	mcu::chrono::SystemClock::init();
+	mcu::chrono::HighResolutionClock::init(1000);
+	mcu::chrono::HighResolutionClock::enableExtendedTicks();
+	mcu::chrono::HighResolutionClock::start();
+	mcu::enableMaskableInterrupts();
+
+	SysLog::IpcFlags syslogIpcFlags =
+	{
+		.ipcResetErrorsWarnings = mcu::ipc::Flag(10, mcu::ipc::Mode::Dualcore),
+		.ipcAddMessage = mcu::ipc::Flag(11, mcu::ipc::Mode::Dualcore),
+		.ipcPopMessage = mcu::ipc::Flag(12, mcu::ipc::Mode::Dualcore)
+	};
+	SysLog::init(syslogIpcFlags);
+
+	sim::PipeUart uart(options.baudrate, CLI_PIPE_INT);
+	pipeUart = &uart;
+	uart.registerRxInterruptHandler(onPipeUartRx);
+	uart.enableRxInterrupts();
+	if (options.mode == Mode::Stdio)
+	{
+		uart.attachFd(-1, STDOUT_FILENO);	// welcome message
+	}
+
+	cli::Server server("sim", &uart, NULL, NULL);
+	bool shellValid = cli::Shell::init();	// subcommand tables are sorted, names are unique
+	assert(shellValid);
+	(void)shellValid;
+	server.registerExecCallback(cli::Shell::exec);
+	server.registerCompletionCallback(cli::Shell::complete);
+	cli::BinaryProtocol::init(mcu::chrono::SystemClock::now);	// no application variables: Info, Ping and Exit only
+
+	switch (options.mode.underlying_value())
+	{
+	case Mode::Stdio:
+		return runStdio(server, uart);
+	case Mode::Pty:
+		return runPty(server, uart);
+	case Mode::Fuzz:
+		return runFuzz(server, uart, options);
+	}
+	return 1;
+}
+
+
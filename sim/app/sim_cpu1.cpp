@@ -0,0 +1,213 @@
+/**
+ * @file sim_cpu1.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Host executable running CPU1 firmware main() against simulated HAL.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "driverlib.h"
+#include "device.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+
+void cpu1_main();	// firmware main(), renamed by build
+
+
+namespace {
+
+
+const uint32_t CLI_UART_BASE = SCIB_BASE;
+const uint32_t CAN_BASE = CANB_BASE;
+
+/// Scripted CLI commands are sent after boot is complete
+const uint64_t CLI_SCRIPT_START_ms = 3000;
+const uint64_t CLI_SCRIPT_INTERVAL_ms = 500;
+
+
+struct Options
+{
+	uint64_t time_ms;
+	bool quiet;
+	std::vector<std::string> commands;
+};
+
+
+uint64_t wallclock_ns()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+
+void printToStdout(char ch)
+{
+	putchar(ch);
+}
+
+
+uint64_t canTxFrames = 0;
+void countCanFrame(uint32_t base, const sim::CanFrame& frame)
+{
+	++canTxFrames;
+}
+
+
+/**
+ * @brief Sends scripted CLI commands to CLI UART at fixed virtual time points.
+ */
+class CliScript : public sim::ITimedModel
+{
+private:
+	std::vector<std::string> _commands;
+	size_t _next;
+	uint64_t _nextTime;
+public:
+	CliScript(const std::vector<std::string>& commands)
+		: _commands(commands)
+		, _next(0)
+		, _nextTime(CLI_SCRIPT_START_ms * (DEVICE_SYSCLK_FREQ / 1000))
+	{}
+
+	virtual uint64_t cyclesToNextEvent() const
+	{
+		if (_next >= _commands.size()) return noEvent;
+		return (_nextTime > sim::VirtualTime::cycles()) ? _nextTime - sim::VirtualTime::cycles() : 0;
+	}
+
+	virtual void advance(uint64_t cycles) {}
+
+	virtual void fireEvents()
+	{
+		while (_next < _commands.size() && sim::VirtualTime::cycles() >= _nextTime)
+		{
+			sim::Sci::inject(CLI_UART_BASE, _commands[_next].c_str());
+			sim::Sci::inject(CLI_UART_BASE, "\r");
+			++_next;
+			_nextTime += CLI_SCRIPT_INTERVAL_ms * (DEVICE_SYSCLK_FREQ / 1000);
+		}
+	}
+};
+
+
+/**
+ * @brief Ends simulation at specified virtual time and prints superloop cost report.
+ */
+class Deadline : public sim::ITimedModel
+{
+private:
+	uint64_t _deadline;
+	uint64_t _wallStart;
+public:
+	Deadline(uint64_t time_ms)
+		: _deadline(time_ms * (DEVICE_SYSCLK_FREQ / 1000))
+		, _wallStart(wallclock_ns())
+	{}
+
+	virtual uint64_t cyclesToNextEvent() const
+	{
+		return (_deadline > sim::VirtualTime::cycles()) ? _deadline - sim::VirtualTime::cycles() : 0;
+	}
+
+	virtual void advance(uint64_t cycles) {}
+
+	virtual void fireEvents()
+	{
+		if (sim::VirtualTime::cycles() < _deadline) return;
+
+		uint64_t wall = wallclock_ns() - _wallStart;
+		uint64_t simulated_ms = sim::VirtualTime::now_ns() / 1000000;
+		uint64_t wakeups = sim::VirtualTime::idleAdvances();
+
+		printf("\n\nsim: simulated %llu ms in %.3f ms of wall time\n",
+				static_cast<unsigned long long>(simulated_ms), wall / 1e6);
+		printf("sim: wall time per simulated ms: %.1f ns\n", static_cast<double>(wall) / simulated_ms);
+		printf("sim: idle wakeups: %llu, wall time per wakeup: %.1f ns\n",
+				static_cast<unsigned long long>(wakeups), (wakeups != 0) ? static_cast<double>(wall) / wakeups : 0.0);
+		printf("sim: cli uart rx/tx chars: %llu/%llu, can tx frames: %llu, reset requests: %lu\n",
+				static_cast<unsigned long long>(sim::Sci::rxCount(CLI_UART_BASE)),
+				static_cast<unsigned long long>(sim::Sci::txCount(CLI_UART_BASE)),
+				static_cast<unsigned long long>(canTxFrames),
+				static_cast<unsigned long>(sim::Device::resetRequests()));
+		fflush(stdout);
+		std::exit(0);	// firmware main() never returns
+	}
+};
+
+
+void printUsage(const char* name)
+{
+	printf("Usage: %s [--time-ms N] [--cli \"command\"]... [--quiet]\n"
+			"  --time-ms N   simulated time in ms (default 10000)\n"
+			"  --cli CMD     CLI command sent after boot, may be repeated\n"
+			"  --quiet       do not print CLI output\n", name);
+}
+
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+	options.time_ms = 10000;
+	options.quiet = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--time-ms") == 0 && i + 1 < argc)
+		{
+			options.time_ms = strtoull(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "--cli") == 0 && i + 1 < argc)
+		{
+			options.commands.push_back(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--quiet") == 0)
+		{
+			options.quiet = true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return options.time_ms != 0;
+}
+
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	if (!options.quiet)
+	{
+		sim::Sci::setTxSink(CLI_UART_BASE, printToStdout);
+	}
+	sim::Can::setTxSink(CAN_BASE, countCanFrame);
+
+	CliScript cliScript(options.commands);
+	Deadline deadline(options.time_ms);
+	sim::VirtualTime::registerModel(&cliScript);
+	sim::VirtualTime::registerModel(&deadline);
+
+	cpu1_main();
+	return 1;
+}
+
+
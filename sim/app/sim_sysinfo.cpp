@@ -0,0 +1,25 @@
+/**
+ * @file sim_sysinfo.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief System info of application modules in host test and tool builds (defined by firmware main.cpp in application build).
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "sys/sysinfo/sysinfo.h"
+#include "auto-generated/git_version.h"
+
+
+const char* SysInfo::deviceName = "LaunchPad template project";
+const char* SysInfo::deviceNameShort = "C28x";
+const char* SysInfo::firmwareVersion = GIT_DESCRIBE;
+const uint32_t SysInfo::firmwareVersionNum = GIT_COMMIT_NUM;
+const char* SysInfo::buildConfiguration = "HOST";
+const char* SysInfo::buildConfigurationShort = "HOST";
+
+
@@ -0,0 +1,525 @@
+/**
+ * @file binproto_client.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "binproto_client.h"
+#include "emb/emb_cobs.h"
+#include "emb/emb_crc.h"
+
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+
+
+namespace cli {
+
+namespace binproto {
+
+
+namespace {
+
+
+uint16_t get16(const unsigned char* p)
+{
+	return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+
+uint32_t get32(const unsigned char* p)
+{
+	return static_cast<uint32_t>(get16(p)) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+}
+
+
+void put16(std::vector<unsigned char>& v, uint16_t value)
+{
+	v.push_back(value & 0xFF);
+	v.push_back(value >> 8);
+}
+
+
+void put32(std::vector<unsigned char>& v, uint32_t value)
+{
+	put16(v, value & 0xFFFF);
+	put16(v, value >> 16);
+}
+
+
+size_t valueSize(unsigned char type)
+{
+	return (type <= 1) ? 2 : 4;	// uint16, int16
+}
+
+
+} // namespace
+
+
+///
+///
+///
+void FdChannel::write(const unsigned char* data, size_t len)
+{
+	while (len > 0)
+	{
+		ssize_t written = ::write(_fd, data, len);
+		if (written <= 0) return;
+		data += written;
+		len -= written;
+	}
+}
+
+
+///
+///
+///
+size_t FdChannel::read(unsigned char* buf, size_t size)
+{
+	pollfd pfd = {_fd, POLLIN, 0};
+	if (::poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLIN)) return 0;
+	ssize_t received = ::read(_fd, buf, size);
+	return (received > 0) ? received : 0;
+}
+
+
+///
+///
+///
+bool FdChannel::wait(uint64_t timeout_ms)
+{
+	pollfd pfd = {_fd, POLLIN, 0};
+	return ::poll(&pfd, 1, static_cast<int>(timeout_ms)) > 0 && (pfd.revents & POLLIN);
+}
+
+
+///
+///
+///
+float Value::asFloat() const
+{
+	float value;
+	memcpy(&value, &raw, sizeof(value));
+	return value;
+}
+
+
+///
+///
+///
+uint32_t Value::fromFloat(float value)
+{
+	uint32_t raw;
+	memcpy(&raw, &value, sizeof(raw));
+	return raw;
+}
+
+
+///
+///
+///
+Client::Client(IChannel& channel, uint64_t timeout_ms)
+	: _channel(channel)
+	, _timeout_ms(timeout_ms)
+	, _nextId(1)
+	, _helloReceived(false)
+	, _crcErrors(0)
+	, _framingErrors(0)
+	, _rxOctets(0)
+{
+	memset(&_hello, 0, sizeof(_hello));
+}
+
+
+///
+///
+///
+std::vector<unsigned char> Client::encodeFrame(const std::vector<unsigned char>& frame)
+{
+	std::vector<unsigned char> decoded(frame);
+	uint16_t crc = emb::crc16_ccitt(decoded.data(), decoded.size());
+	decoded.push_back(crc >> 8);
+	decoded.push_back(crc & 0xFF);
+
+	std::vector<unsigned char> encoded(emb::cobs_max_encoded_len(decoded.size()) + 1);
+	size_t len = emb::cobs_encode(decoded.data(), decoded.size(), encoded.data());
+	encoded.resize(len);
+	encoded.push_back(0);
+	return encoded;
+}
+
+
+///
+///
+///
+unsigned char Client::send(Opcode opcode, const std::vector<unsigned char>& payload)
+{
+	unsigned char id = _nextId;
+	_nextId = (_nextId == 0xFF) ? 1 : _nextId + 1;	// 0 is reserved for unsolicited frames
+
+	std::vector<unsigned char> frame;
+	frame.push_back(id);
+	frame.push_back(opcode.underlying_value());
+	frame.insert(frame.end(), payload.begin(), payload.end());
+	sendRaw(encodeFrame(frame));
+	return id;
+}
+
+
+///
+///
+///
+void Client::sendRaw(const std::vector<unsigned char>& octets)
+{
+	_channel.write(octets.data(), octets.size());
+}
+
+
+///
+///
+///
+void Client::poll()
+{
+	unsigned char buf[256];
+	size_t len;
+	while ((len = _channel.read(buf, sizeof(buf))) > 0)
+	{
+		_rxOctets += len;
+		for (size_t i = 0; i < len; ++i)
+		{
+			_processOctet(buf[i]);
+		}
+	}
+}
+
+
+///
+///
+///
+bool Client::waitResponse(unsigned char requestId, Frame& frame)
+{
+	while (true)
+	{
+		poll();
+		// responses come in request order: older ones are left for their waiters
+		for (std::deque<Frame>::iterator it = _responses.begin(); it != _responses.end(); ++it)
+		{
+			if (it->requestId == requestId)
+			{
+				frame = *it;
+				_responses.erase(it);
+				return true;
+			}
+		}
+		if (!_channel.wait(_timeout_ms)) return false;
+	}
+}
+
+
+///
+///
+///
+bool Client::waitHello(DeviceInfo& info)
+{
+	while (true)
+	{
+		poll();
+		if (_helloReceived)
+		{
+			info = _hello;
+			return true;
+		}
+		if (!_channel.wait(_timeout_ms)) return false;
+	}
+}
+
+
+///
+///
+///
+void Client::_processOctet(unsigned char octet)
+{
+	if (octet != 0)
+	{
+		_rxFrame.push_back(octet);
+		return;
+	}
+	if (_rxFrame.empty()) return;
+
+	std::vector<unsigned char> decoded(_rxFrame.size());
+	size_t len = 0;
+	if (!emb::cobs_decode(_rxFrame.data(), _rxFrame.size(), decoded.data(), len)
+			|| len < RESPONSE_HEADER_LENGTH + CRC_LENGTH)
+	{
+		++_framingErrors;
+	}
+	else if (emb::crc16_ccitt(decoded.data(), len) != 0)
+	{
+		++_crcErrors;
+	}
+	else
+	{
+		decoded.resize(len - CRC_LENGTH);
+		_processFrame(decoded);
+	}
+	_rxFrame.clear();
+}
+
+
+///
+///
+///
+void Client::_processFrame(const std::vector<unsigned char>& decoded)
+{
+	Frame frame;
+	frame.requestId = decoded[0];
+	frame.opcode = decoded[1];
+	frame.status = decoded[2];
+	frame.payload.assign(decoded.begin() + RESPONSE_HEADER_LENGTH, decoded.end());
+
+	if (frame.requestId != UNSOLICITED_ID)
+	{
+		_responses.push_back(frame);
+		return;
+	}
+
+	const std::vector<unsigned char>& p = frame.payload;
+	if (frame.opcode == Opcode::Info && p.size() >= 6)
+	{
+		_hello.version = p[0];
+		_hello.varCount = get16(&p[1]);
+		_hello.frameMaxLength = get16(&p[3]);
+		_hello.subscriptionMaxCount = p[5];
+		_helloReceived = true;
+	}
+	else if (frame.opcode == Opcode::Telemetry && p.size() >= TELEMETRY_HEADER_LENGTH && !_subscriptionTypes.empty())
+	{
+		TelemetrySample sample;
+		sample.sequence = get16(&p[0]);
+		sample.timestamp_ms = get32(&p[2]);
+		size_t pos = TELEMETRY_HEADER_LENGTH;
+		for (size_t i = 0; i < _subscriptionTypes.size(); ++i)
+		{
+			Value value;
+			value.type = _subscriptionTypes[i];
+			size_t size = valueSize(value.type);
+			if (pos + size > p.size()) return;	// subscription changed while frame was in flight
+			value.raw = (size == 2) ? get16(&p[pos]) : get32(&p[pos]);
+			if (value.type == 1)
+			{
+				value.raw = static_cast<uint32_t>(static_cast<int32_t>(static_cast<int16_t>(value.raw)));
+			}
+			pos += size;
+			sample.values.push_back(value);
+		}
+		_telemetry.push_back(sample);
+	}
+}
+
+
+///
+///
+///
+Status Client::_request(Opcode opcode, const std::vector<unsigned char>& payload, Frame& response)
+{
+	if (!waitResponse(send(opcode, payload), response))
+	{
+		return Status::Timeout;
+	}
+	return Status(static_cast<Status::enum_type>(response.status));
+}
+
+
+///
+///
+///
+Status Client::ping(const std::vector<unsigned char>& data)
+{
+	Frame response;
+	Status status = _request(Opcode::Ping, data, response);
+	if (status == Status::Ok && response.payload != data)
+	{
+		return Status::BadLength;
+	}
+	return status;
+}
+
+
+///
+///
+///
+Status Client::info(DeviceInfo& info)
+{
+	Frame response;
+	Status status = _request(Opcode::Info, std::vector<unsigned char>(), response);
+	if (status != Status::Ok) return status;
+	if (response.payload.size() < 6) return Status::BadLength;
+	const std::vector<unsigned char>& p = response.payload;
+	info.version = p[0];
+	info.varCount = get16(&p[1]);
+	info.frameMaxLength = get16(&p[3]);
+	info.subscriptionMaxCount = p[5];
+	return status;
+}
+
+
+///
+///
+///
+Status Client::varInfo(uint16_t id, VarInfo& info)
+{
+	std::vector<unsigned char> payload;
+	put16(payload, id);
+	Frame response;
+	Status status = _request(Opcode::VarInfo, payload, response);
+	if (status != Status::Ok) return status;
+	if (response.payload.size() < 6) return Status::BadLength;
+	info.type = response.payload[0];
+	info.writable = response.payload[1] != 0;
+	Value scale = {0, get32(&response.payload[2])};
+	info.scale = scale.asFloat();
+	info.name.assign(response.payload.begin() + 6, response.payload.end());
+	return status;
+}
+
+
+///
+///
+///
+std::vector<unsigned char> Client::readPayload(const std::vector<uint16_t>& ids)
+{
+	std::vector<unsigned char> payload;
+	for (size_t i = 0; i < ids.size(); ++i)
+	{
+		put16(payload, ids[i]);
+	}
+	return payload;
+}
+
+
+///
+///
+///
+bool Client::decodeReadPayload(const std::vector<unsigned char>& payload, std::vector<Value>& values)
+{
+	if (payload.size() % 5 != 0) return false;
+	values.clear();
+	for (size_t pos = 0; pos < payload.size(); pos += 5)
+	{
+		Value value;
+		value.type = payload[pos];
+		value.raw = get32(&payload[pos + 1]);
+		values.push_back(value);
+	}
+	return true;
+}
+
+
+///
+///
+///
+Status Client::read(const std::vector<uint16_t>& ids, std::vector<Value>& values)
+{
+	Frame response;
+	Status status = _request(Opcode::Read, readPayload(ids), response);
+	if (status != Status::Ok) return status;
+	if (!decodeReadPayload(response.payload, values) || values.size() != ids.size()) return Status::BadLength;
+	return status;
+}
+
+
+///
+///
+///
+Status Client::write(uint16_t id, const Value& value)
+{
+	std::vector<unsigned char> payload;
+	put16(payload, id);
+	payload.push_back(value.type);
+	put32(payload, value.raw);
+	Frame response;
+	return _request(Opcode::Write, payload, response);
+}
+
+
+///
+///
+///
+Status Client::subscribe(uint16_t period_ms, const std::vector<uint16_t>& ids)
+{
+	// value types are needed to unpack telemetry
+	std::vector<unsigned char> types;
+	for (size_t i = 0; i < ids.size(); ++i)
+	{
+		VarInfo var;
+		Status status = varInfo(ids[i], var);
+		if (status != Status::Ok) return status;
+		types.push_back(var.type);
+	}
+
+	std::vector<unsigned char> payload;
+	put16(payload, period_ms);
+	std::vector<unsigned char> idPayload = readPayload(ids);
+	payload.insert(payload.end(), idPayload.begin(), idPayload.end());
+	Frame response;
+	Status status = _request(Opcode::Subscribe, payload, response);
+	if (status == Status::Ok)
+	{
+		_subscriptionTypes = types;
+		_telemetry.clear();
+	}
+	return status;
+}
+
+
+///
+///
+///
+Status Client::unsubscribe()
+{
+	std::vector<unsigned char> payload;
+	put16(payload, 0);
+	Frame response;
+	Status status = _request(Opcode::Subscribe, payload, response);
+	if (status == Status::Ok)
+	{
+		_subscriptionTypes.clear();
+	}
+	return status;
+}
+
+
+///
+///
+///
+Status Client::exit()
+{
+	Frame response;
+	return _request(Opcode::Exit, std::vector<unsigned char>(), response);
+}
+
+
+///
+///
+///
+bool Client::takeTelemetry(TelemetrySample& sample)
+{
+	if (_telemetry.empty()) return false;
+	sample = _telemetry.front();
+	_telemetry.pop_front();
+	return true;
+}
+
+
+} // namespace binproto
+
+} // namespace cli
+
+
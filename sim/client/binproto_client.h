@@ -0,0 +1,202 @@
+/**
+ * @file binproto_client.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Host client of CLI binary protocol: request pipelining, typed variable access, telemetry decoding.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "cli/binproto/binproto_def.h"
+
+
+namespace cli {
+
+namespace binproto {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Byte channel to device: serial port, pseudo-terminal or simulated UART.
+ */
+class IChannel
+{
+public:
+	virtual ~IChannel() {}
+	virtual void write(const unsigned char* data, size_t len) = 0;
+
+	/**
+	 * @brief Reads available octets without blocking.
+	 * @return Number of octets read.
+	 */
+	virtual size_t read(unsigned char* buf, size_t size) = 0;
+
+	/**
+	 * @brief Waits for input.
+	 * @param timeout_ms - timeout in channel time (virtual time for simulated UART)
+	 * @return \c false on timeout or if channel is closed.
+	 */
+	virtual bool wait(uint64_t timeout_ms) = 0;
+};
+
+
+/**
+ * @brief Channel over file descriptor, e.g. serial port or pseudo-terminal in raw mode.
+ */
+class FdChannel : public IChannel
+{
+private:
+	int _fd;
+public:
+	explicit FdChannel(int fd) : _fd(fd) {}
+	virtual void write(const unsigned char* data, size_t len);
+	virtual size_t read(unsigned char* buf, size_t size);
+	virtual bool wait(uint64_t timeout_ms);
+};
+
+
+struct Frame
+{
+	unsigned char requestId;
+	unsigned char opcode;
+	unsigned char status;
+	std::vector<unsigned char> payload;
+};
+
+
+struct Value
+{
+	unsigned char type;
+	uint32_t raw;
+
+	int32_t asInt() const { return static_cast<int32_t>(raw); }
+	float asFloat() const;
+	static uint32_t fromFloat(float value);
+};
+
+
+struct DeviceInfo
+{
+	unsigned version;
+	unsigned varCount;
+	unsigned frameMaxLength;
+	unsigned subscriptionMaxCount;
+};
+
+
+struct VarInfo
+{
+	unsigned char type;
+	bool writable;
+	float scale;
+	std::string name;
+};
+
+
+struct TelemetrySample
+{
+	uint16_t sequence;
+	uint32_t timestamp_ms;
+	std::vector<Value> values;
+};
+
+
+/**
+ * @brief Protocol client. Asynchronous API (send/waitResponse) allows to pipeline requests: device processes
+ * them in order and holds input while its output buffer is busy, so window of requests is limited
+ * only by device UART RX buffer. Synchronous helpers send one request and wait for its response.
+ * Telemetry frames are decoded with value types of current subscription and queued.
+ */
+class Client
+{
+private:
+	IChannel& _channel;
+	uint64_t _timeout_ms;
+	unsigned char _nextId;
+
+	std::vector<unsigned char> _rxFrame;
+	std::deque<Frame> _responses;
+	std::deque<TelemetrySample> _telemetry;
+	std::vector<unsigned char> _subscriptionTypes;
+	bool _helloReceived;
+	DeviceInfo _hello;
+
+	uint64_t _crcErrors;
+	uint64_t _framingErrors;	// including text before hello frame
+	uint64_t _rxOctets;
+public:
+	explicit Client(IChannel& channel, uint64_t timeout_ms = 1000);
+
+	/**
+	 * @brief Sends request without waiting for response.
+	 * @return Request ID.
+	 */
+	unsigned char send(Opcode opcode, const std::vector<unsigned char>& payload = std::vector<unsigned char>());
+
+	/**
+	 * @brief Sends raw octets, e.g. corrupted frame in tests.
+	 */
+	void sendRaw(const std::vector<unsigned char>& octets);
+
+	/**
+	 * @brief Waits for response to request.
+	 * @return \c false on timeout.
+	 */
+	bool waitResponse(unsigned char requestId, Frame& frame);
+
+	/**
+	 * @brief Waits for hello frame sent by device when binary mode is entered.
+	 */
+	bool waitHello(DeviceInfo& info);
+
+	/**
+	 * @brief Processes received octets without blocking.
+	 */
+	void poll();
+
+	Status ping(const std::vector<unsigned char>& data);
+	Status info(DeviceInfo& info);
+	Status varInfo(uint16_t id, VarInfo& info);
+	Status read(const std::vector<uint16_t>& ids, std::vector<Value>& values);
+	Status write(uint16_t id, const Value& value);
+	Status subscribe(uint16_t period_ms, const std::vector<uint16_t>& ids);
+	Status unsubscribe();
+	Status exit();
+
+	bool takeTelemetry(TelemetrySample& sample);
+	size_t telemetryPending() const { return _telemetry.size(); }
+
+	uint64_t crcErrors() const { return _crcErrors; }
+	uint64_t framingErrors() const { return _framingErrors; }
+	uint64_t rxOctets() const { return _rxOctets; }
+
+	static std::vector<unsigned char> encodeFrame(const std::vector<unsigned char>& frame);
+	static std::vector<unsigned char> readPayload(const std::vector<uint16_t>& ids);
+	static bool decodeReadPayload(const std::vector<unsigned char>& payload, std::vector<Value>& values);
+private:
+	void _processOctet(unsigned char octet);
+	void _processFrame(const std::vector<unsigned char>& frame);
+	Status _request(Opcode opcode, const std::vector<unsigned char>& payload, Frame& response);
+};
+
+
+/// @}
+} // namespace binproto
+
+} // namespace cli
+
+
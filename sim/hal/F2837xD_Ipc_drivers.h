@@ -0,0 +1,54 @@
+/**
+ * @file F2837xD_Ipc_drivers.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated IPC flags with device support IPC driver API.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+
+
+void IPCLtoRFlagSet(uint32_t ulFlags);
+void IPCLtoRFlagClear(uint32_t ulFlags);
+uint16_t IPCLtoRFlagBusy(uint32_t ulFlags);
+uint16_t IPCRtoLFlagBusy(uint32_t ulFlags);
+void IPCRtoLFlagAcknowledge(uint32_t ulFlags);
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Simulated IPC flag registers. Remote CPU is played by test or simulation app.
+ */
+class Ipc
+{
+private:
+	Ipc();					// no constructor
+	Ipc(const Ipc& other);			// no copy constructor
+	Ipc& operator=(const Ipc& other);	// no copy assignment operator
+public:
+	/// Sets flags as if remote CPU had set them.
+	static void setRemoteFlags(uint32_t flags);
+	/// Returns flags set by local CPU.
+	static uint32_t localFlags();
+	/// Acknowledges local flags as if remote CPU had acknowledged them.
+	static void acknowledgeLocalFlags(uint32_t flags);
+};
+
+
+/// @}
+} // namespace sim
+
+
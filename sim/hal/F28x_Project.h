@@ -0,0 +1,19 @@
+/**
+ * @file F28x_Project.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Host substitute of device support umbrella header.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include "driverlib.h"
+
+
@@ -0,0 +1,36 @@
+/**
+ * @file device.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Host substitute of C2000Ware device support: LaunchPad F28379D clock configuration.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include "driverlib.h"
+
+
+#define DEVICE_OSCSRC_FREQ		10000000U
+#define DEVICE_SYSCLK_FREQ		((DEVICE_OSCSRC_FREQ * 40 * 1) / 2)
+#define DEVICE_LSPCLK_FREQ		(DEVICE_SYSCLK_FREQ / 4)
+
+
+/// Delay advances virtual time, no CPU time is spent.
+#define DEVICE_DELAY_US(x)		sim::VirtualTime::advance_us(x)
+
+
+#define C1C2_BROM_BOOTMODE_BOOT_FROM_FLASH	0x0000000BU
+
+
+inline void Device_init() {}
+inline void Device_initGPIO() {}
+inline uint16_t Device_bootCPU2(uint32_t bootMode) { return 0; }
+
+
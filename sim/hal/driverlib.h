@@ -0,0 +1,36 @@
+/**
+ * @file driverlib.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Host substitute of C2000Ware driverlib: simulated peripherals with driverlib API.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+
+#include "sim_cpu.h"
+#include "sim_interrupt.h"
+#include "sim_cputimer.h"
+#include "sim_sysctl.h"
+#include "sim_virtualtime.h"
+#include "sim_gpio.h"
+#include "sim_sci.h"
+#include "sim_can.h"
+#include "sim_adc.h"
+#include "sim_epwm.h"
+
+#include "pin_map.h"
+
+
@@ -0,0 +1,128 @@
+/**
+ * @file sim_adc.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "driverlib.h"
+
+
+namespace {
+
+
+struct AdcModule
+{
+	uint32_t base;
+	uint32_t resultBase;
+	uint32_t intNums[4];
+	ADC_Channel socChannels[16];
+	uint16_t results[16];
+	uint16_t inputs[16];
+	ADC_SOCNumber intSources[4];
+	bool intEnabled[4];
+	bool intFlags[4];
+	uint32_t conversions;
+};
+
+
+AdcModule adcModules[4] = {
+	{ADCA_BASE, ADCARESULT_BASE, {INT_ADCA1, INT_ADCA2, INT_ADCA3, INT_ADCA4}},
+	{ADCB_BASE, ADCBRESULT_BASE, {INT_ADCB1, INT_ADCB2, INT_ADCB3, INT_ADCB4}},
+	{ADCC_BASE, ADCCRESULT_BASE, {INT_ADCC1, INT_ADCC2, INT_ADCC3, INT_ADCC4}},
+	{ADCD_BASE, ADCDRESULT_BASE, {INT_ADCD1, INT_ADCD2, INT_ADCD3, INT_ADCD4}}
+};
+
+
+AdcModule& adcModule(uint32_t base)
+{
+	for (size_t i = 0; i < 3; ++i)
+	{
+		if (adcModules[i].base == base || adcModules[i].resultBase == base) return adcModules[i];
+	}
+	return adcModules[3];
+}
+
+
+struct DacModule
+{
+	uint32_t base;
+	uint16_t value;
+	bool outputEnabled;
+};
+
+
+DacModule dacModules[3] = {{DACA_BASE}, {DACB_BASE}, {DACC_BASE}};
+
+
+DacModule& dacModule(uint32_t base)
+{
+	return (base == DACA_BASE) ? dacModules[0] : ((base == DACB_BASE) ? dacModules[1] : dacModules[2]);
+}
+
+
+} // namespace
+
+
+void ADC_setPrescaler(uint32_t base, ADC_ClkPrescale clkPrescale) {}
+void ADC_setInterruptPulseMode(uint32_t base, ADC_PulseMode pulseMode) {}
+void ADC_enableConverter(uint32_t base) {}
+void ADC_setSOCPriority(uint32_t base, ADC_PriorityMode priMode) {}
+void ADC_setMode(uint32_t base, ADC_Resolution resolution, ADC_SignalMode signalMode) {}
+bool ADC_getInterruptStatus(uint32_t base, ADC_IntNumber adcIntNum) { return adcModule(base).intFlags[adcIntNum]; }
+void ADC_clearInterruptStatus(uint32_t base, ADC_IntNumber adcIntNum) { adcModule(base).intFlags[adcIntNum] = false; }
+uint16_t ADC_readResult(uint32_t resultBase, ADC_SOCNumber socNumber) { return adcModule(resultBase).results[socNumber]; }
+void ADC_enableInterrupt(uint32_t base, ADC_IntNumber adcIntNum) { adcModule(base).intEnabled[adcIntNum] = true; }
+
+
+void ADC_setupSOC(uint32_t base, ADC_SOCNumber socNumber, ADC_Trigger trigger, ADC_Channel channel, uint32_t sampleWindow)
+{
+	adcModule(base).socChannels[socNumber] = channel;
+}
+
+
+void ADC_setInterruptSource(uint32_t base, ADC_IntNumber adcIntNum, ADC_SOCNumber socNumber)
+{
+	adcModule(base).intSources[adcIntNum] = socNumber;
+}
+
+
+void ADC_forceSOC(uint32_t base, ADC_SOCNumber socNumber)
+{
+	AdcModule& m = adcModule(base);
+	m.results[socNumber] = m.inputs[m.socChannels[socNumber] & 0xF];
+	++m.conversions;
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		if (m.intSources[i] != socNumber || !m.intEnabled[i]) continue;
+		if (m.intFlags[i]) continue;	// interrupt is not generated again until flag is cleared
+		m.intFlags[i] = true;
+		sim::Interrupts::raise(m.intNums[i]);
+	}
+}
+
+
+void DAC_setReferenceVoltage(uint32_t base, DAC_ReferenceVoltage source) {}
+void DAC_setShadowValue(uint32_t base, uint16_t value) { dacModule(base).value = value; }
+void DAC_enableOutput(uint32_t base) { dacModule(base).outputEnabled = true; }
+
+
+namespace sim {
+
+
+void Adc::setInput(uint32_t base, ADC_Channel channel, uint16_t value) { adcModule(base).inputs[channel & 0xF] = value; }
+uint32_t Adc::conversionCount(uint32_t base) { return adcModule(base).conversions; }
+uint16_t Dac::value(uint32_t base) { return dacModule(base).value; }
+bool Dac::outputEnabled(uint32_t base) { return dacModule(base).outputEnabled; }
+
+
+} // namespace sim
+
+
@@ -0,0 +1,243 @@
+/**
+ * @file sim_adc.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated ADC and DAC with driverlib ADC and DAC API.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+typedef enum
+{
+	ADC_CLK_DIV_1_0 = 0U,
+	ADC_CLK_DIV_2_0 = 2U,
+	ADC_CLK_DIV_2_5 = 3U,
+	ADC_CLK_DIV_3_0 = 4U,
+	ADC_CLK_DIV_3_5 = 5U,
+	ADC_CLK_DIV_4_0 = 6U,
+	ADC_CLK_DIV_4_5 = 7U,
+	ADC_CLK_DIV_5_0 = 8U,
+	ADC_CLK_DIV_5_5 = 9U,
+	ADC_CLK_DIV_6_0 = 10U,
+	ADC_CLK_DIV_6_5 = 11U,
+	ADC_CLK_DIV_7_0 = 12U,
+	ADC_CLK_DIV_7_5 = 13U,
+	ADC_CLK_DIV_8_0 = 14U,
+	ADC_CLK_DIV_8_5 = 15U
+} ADC_ClkPrescale;
+
+typedef enum
+{
+	ADC_RESOLUTION_12BIT = 0x00U,
+	ADC_RESOLUTION_16BIT = 0x40U
+} ADC_Resolution;
+
+typedef enum
+{
+	ADC_MODE_SINGLE_ENDED = 0x00U,
+	ADC_MODE_DIFFERENTIAL = 0x80U
+} ADC_SignalMode;
+
+typedef enum
+{
+	ADC_TRIGGER_SW_ONLY     = 0U,
+	ADC_TRIGGER_CPU1_TINT0  = 1U,
+	ADC_TRIGGER_CPU1_TINT1  = 2U,
+	ADC_TRIGGER_CPU1_TINT2  = 3U,
+	ADC_TRIGGER_GPIO        = 4U,
+	ADC_TRIGGER_EPWM1_SOCA  = 5U,
+	ADC_TRIGGER_EPWM1_SOCB  = 6U,
+	ADC_TRIGGER_EPWM2_SOCA  = 7U,
+	ADC_TRIGGER_EPWM2_SOCB  = 8U,
+	ADC_TRIGGER_EPWM3_SOCA  = 9U,
+	ADC_TRIGGER_EPWM3_SOCB  = 10U,
+	ADC_TRIGGER_EPWM4_SOCA  = 11U,
+	ADC_TRIGGER_EPWM4_SOCB  = 12U,
+	ADC_TRIGGER_EPWM5_SOCA  = 13U,
+	ADC_TRIGGER_EPWM5_SOCB  = 14U,
+	ADC_TRIGGER_EPWM6_SOCA  = 15U,
+	ADC_TRIGGER_EPWM6_SOCB  = 16U,
+	ADC_TRIGGER_EPWM7_SOCA  = 17U,
+	ADC_TRIGGER_EPWM7_SOCB  = 18U,
+	ADC_TRIGGER_EPWM8_SOCA  = 19U,
+	ADC_TRIGGER_EPWM8_SOCB  = 20U,
+	ADC_TRIGGER_EPWM9_SOCA  = 21U,
+	ADC_TRIGGER_EPWM9_SOCB  = 22U,
+	ADC_TRIGGER_EPWM10_SOCA = 23U,
+	ADC_TRIGGER_EPWM10_SOCB = 24U,
+	ADC_TRIGGER_EPWM11_SOCA = 25U,
+	ADC_TRIGGER_EPWM11_SOCB = 26U,
+	ADC_TRIGGER_EPWM12_SOCA = 27U,
+	ADC_TRIGGER_EPWM12_SOCB = 28U,
+	ADC_TRIGGER_CPU2_TINT0  = 29U,
+	ADC_TRIGGER_CPU2_TINT1  = 30U,
+	ADC_TRIGGER_CPU2_TINT2  = 31U
+} ADC_Trigger;
+
+typedef enum
+{
+	ADC_CH_ADCIN0  = 0U,
+	ADC_CH_ADCIN1  = 1U,
+	ADC_CH_ADCIN2  = 2U,
+	ADC_CH_ADCIN3  = 3U,
+	ADC_CH_ADCIN4  = 4U,
+	ADC_CH_ADCIN5  = 5U,
+	ADC_CH_ADCIN6  = 6U,
+	ADC_CH_ADCIN7  = 7U,
+	ADC_CH_ADCIN8  = 8U,
+	ADC_CH_ADCIN9  = 9U,
+	ADC_CH_ADCIN10 = 10U,
+	ADC_CH_ADCIN11 = 11U,
+	ADC_CH_ADCIN12 = 12U,
+	ADC_CH_ADCIN13 = 13U,
+	ADC_CH_ADCIN14 = 14U,
+	ADC_CH_ADCIN15 = 15U,
+	ADC_CH_ADCIN0_ADCIN1 = 0U,
+	ADC_CH_ADCIN2_ADCIN3 = 2U,
+	ADC_CH_ADCIN4_ADCIN5 = 4U,
+	ADC_CH_ADCIN6_ADCIN7 = 6U,
+	ADC_CH_ADCIN8_ADCIN9 = 8U,
+	ADC_CH_ADCIN10_ADCIN11 = 10U,
+	ADC_CH_ADCIN12_ADCIN13 = 12U,
+	ADC_CH_ADCIN14_ADCIN15 = 14U
+} ADC_Channel;
+
+typedef enum
+{
+	ADC_PULSE_END_OF_ACQ_WIN = 0x00U,
+	ADC_PULSE_END_OF_CONV    = 0x04U
+} ADC_PulseMode;
+
+typedef enum
+{
+	ADC_INT_NUMBER1 = 0U,
+	ADC_INT_NUMBER2 = 1U,
+	ADC_INT_NUMBER3 = 2U,
+	ADC_INT_NUMBER4 = 3U
+} ADC_IntNumber;
+
+typedef enum
+{
+	ADC_SOC_NUMBER0  = 0U,
+	ADC_SOC_NUMBER1  = 1U,
+	ADC_SOC_NUMBER2  = 2U,
+	ADC_SOC_NUMBER3  = 3U,
+	ADC_SOC_NUMBER4  = 4U,
+	ADC_SOC_NUMBER5  = 5U,
+	ADC_SOC_NUMBER6  = 6U,
+	ADC_SOC_NUMBER7  = 7U,
+	ADC_SOC_NUMBER8  = 8U,
+	ADC_SOC_NUMBER9  = 9U,
+	ADC_SOC_NUMBER10 = 10U,
+	ADC_SOC_NUMBER11 = 11U,
+	ADC_SOC_NUMBER12 = 12U,
+	ADC_SOC_NUMBER13 = 13U,
+	ADC_SOC_NUMBER14 = 14U,
+	ADC_SOC_NUMBER15 = 15U
+} ADC_SOCNumber;
+
+typedef enum
+{
+	ADC_PRI_ALL_ROUND_ROBIN = 0U,
+	ADC_PRI_SOC0_HIPRI      = 1U,
+	ADC_PRI_THRU_SOC1_HIPRI = 2U,
+	ADC_PRI_THRU_SOC2_HIPRI = 3U,
+	ADC_PRI_THRU_SOC3_HIPRI = 4U,
+	ADC_PRI_THRU_SOC4_HIPRI = 5U,
+	ADC_PRI_THRU_SOC5_HIPRI = 6U,
+	ADC_PRI_THRU_SOC6_HIPRI = 7U,
+	ADC_PRI_THRU_SOC7_HIPRI = 8U,
+	ADC_PRI_THRU_SOC8_HIPRI = 9U,
+	ADC_PRI_THRU_SOC9_HIPRI = 10U,
+	ADC_PRI_THRU_SOC10_HIPRI = 11U,
+	ADC_PRI_THRU_SOC11_HIPRI = 12U,
+	ADC_PRI_THRU_SOC12_HIPRI = 13U,
+	ADC_PRI_THRU_SOC13_HIPRI = 14U,
+	ADC_PRI_THRU_SOC14_HIPRI = 15U,
+	ADC_PRI_ALL_HIPRI = 16U
+} ADC_PriorityMode;
+
+typedef enum
+{
+	DAC_REF_VDAC        = 0,
+	DAC_REF_ADC_VREFHI  = 1
+} DAC_ReferenceVoltage;
+
+
+void ADC_setPrescaler(uint32_t base, ADC_ClkPrescale clkPrescale);
+void ADC_setupSOC(uint32_t base, ADC_SOCNumber socNumber, ADC_Trigger trigger, ADC_Channel channel, uint32_t sampleWindow);
+void ADC_setInterruptPulseMode(uint32_t base, ADC_PulseMode pulseMode);
+void ADC_enableConverter(uint32_t base);
+void ADC_forceSOC(uint32_t base, ADC_SOCNumber socNumber);
+bool ADC_getInterruptStatus(uint32_t base, ADC_IntNumber adcIntNum);
+void ADC_clearInterruptStatus(uint32_t base, ADC_IntNumber adcIntNum);
+uint16_t ADC_readResult(uint32_t resultBase, ADC_SOCNumber socNumber);
+void ADC_setSOCPriority(uint32_t base, ADC_PriorityMode priMode);
+void ADC_enableInterrupt(uint32_t base, ADC_IntNumber adcIntNum);
+void ADC_setInterruptSource(uint32_t base, ADC_IntNumber adcIntNum, ADC_SOCNumber socNumber);
+void ADC_setMode(uint32_t base, ADC_Resolution resolution, ADC_SignalMode signalMode);
+
+void DAC_setReferenceVoltage(uint32_t base, DAC_ReferenceVoltage source);
+void DAC_setShadowValue(uint32_t base, uint16_t value);
+void DAC_enableOutput(uint32_t base);
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Simulated ADC modules. Conversion completes at SOC: result is the value of channel input set by test,
+ * interrupt flag of ADCINT sourced by SOC is set and interrupt is raised if enabled.
+ */
+class Adc
+{
+private:
+	Adc();					// no constructor
+	Adc(const Adc& other);			// no copy constructor
+	Adc& operator=(const Adc& other);	// no copy assignment operator
+public:
+	/**
+	 * @brief Sets analog input value.
+	 * @param base - ADC base address
+	 * @param channel - ADC channel
+	 * @param value - raw 12-bit value
+	 * @return (none)
+	 */
+	static void setInput(uint32_t base, ADC_Channel channel, uint16_t value);
+
+	static uint32_t conversionCount(uint32_t base);
+};
+
+
+/**
+ * @brief Simulated buffered DAC modules.
+ */
+class Dac
+{
+private:
+	Dac();					// no constructor
+	Dac(const Dac& other);			// no copy constructor
+	Dac& operator=(const Dac& other);	// no copy assignment operator
+public:
+	static uint16_t value(uint32_t base);
+	static bool outputEnabled(uint32_t base);
+};
+
+
+/// @}
+} // namespace sim
+
+
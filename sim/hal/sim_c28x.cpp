@@ -0,0 +1,173 @@
+/**
+ * @file sim_c28x.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "sim_c28x.h"
+
+#include <string>
+#include <cstring>
+#include <algorithm>
+
+#undef snprintf
+#undef printf
+
+
+namespace {
+
+
+/**
+ * @brief Formats one conversion specification with argument fetched according to C28x data model.
+ */
+void formatConversion(std::string& out, std::string spec, char conversion, va_list& args)
+{
+	char buf[512];
+	int len = 0;
+
+	std::string::size_type l = spec.find('l');
+	bool isLongLong = spec.find("ll") != std::string::npos;
+	if (l != std::string::npos && !isLongLong)
+	{
+		spec.erase(l, 1);	// 32-bit long
+	}
+	spec += conversion;
+
+	switch (conversion)
+	{
+	case 'd':
+	case 'i':
+		len = isLongLong ? snprintf(buf, sizeof(buf), spec.c_str(), va_arg(args, long long))
+				: snprintf(buf, sizeof(buf), spec.c_str(), va_arg(args, int));
+		break;
+	case 'u':
+	case 'x':
+	case 'X':
+	case 'o':
+		len = isLongLong ? snprintf(buf, sizeof(buf), spec.c_str(), va_arg(args, unsigned long long))
+				: snprintf(buf, sizeof(buf), spec.c_str(), va_arg(args, unsigned int));
+		break;
+	case 'c':
+		len = snprintf(buf, sizeof(buf), spec.c_str(), va_arg(args, int));
+		break;
+	case 'f':
+	case 'F':
+	case 'e':
+	case 'E':
+	case 'g':
+	case 'G':
+		len = snprintf(buf, sizeof(buf), spec.c_str(), va_arg(args, double));
+		break;
+	case 's':
+		len = snprintf(buf, sizeof(buf), spec.c_str(), va_arg(args, const char*));
+		break;
+	case 'p':
+		len = snprintf(buf, sizeof(buf), spec.c_str(), va_arg(args, void*));
+		break;
+	default:
+		len = snprintf(buf, sizeof(buf), "%s", spec.c_str());
+		break;
+	}
+
+	if (len > 0)
+	{
+		out.append(buf, std::min<size_t>(len, sizeof(buf) - 1));
+	}
+}
+
+
+std::string format(const char* format, va_list argList)
+{
+	va_list args;
+	va_copy(args, argList);
+	std::string out;
+	const char* p = format;
+	while (*p != '\0')
+	{
+		if (*p != '%')
+		{
+			out += *p++;
+			continue;
+		}
+		if (p[1] == '%')
+		{
+			out += '%';
+			p += 2;
+			continue;
+		}
+
+		std::string spec(1, *p++);
+		while (*p != '\0' && strchr("-+ #0123456789.*hlLzjt", *p) != NULL)
+		{
+			if (*p == '*')
+			{
+				char width[16];
+				snprintf(width, sizeof(width), "%d", va_arg(args, int));
+				spec += width;
+			}
+			else
+			{
+				spec += *p;
+			}
+			++p;
+		}
+		if (*p == '\0') break;
+		formatConversion(out, spec, *p++, args);
+	}
+	va_end(args);
+	return out;
+}
+
+
+} // namespace
+
+
+///
+///
+///
+int c28x_vsnprintf(char* buf, size_t size, const char* format, va_list args)
+{
+	std::string out = ::format(format, args);
+	if (size != 0)
+	{
+		size_t len = std::min(out.size(), size - 1);
+		memcpy(buf, out.data(), len);
+		buf[len] = '\0';
+	}
+	return static_cast<int>(out.size());
+}
+
+
+///
+///
+///
+int c28x_snprintf(char* buf, size_t size, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int len = c28x_vsnprintf(buf, size, format, args);
+	va_end(args);
+	return len;
+}
+
+
+///
+///
+///
+int c28x_printf(const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	std::string out = ::format(format, args);
+	va_end(args);
+	return static_cast<int>(fwrite(out.data(), 1, out.size(), stdout));
+}
+
+
@@ -0,0 +1,69 @@
+/**
+ * @file sim_c28x.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief C28x compiler intrinsics and keywords for host build. Header is force-included in every host translation unit.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <cstdio>
+
+
+/// TI compiler interrupt keywords: ISRs are plain functions called by simulated interrupt controller.
+#define __interrupt
+#define interrupt
+
+
+/// TI compiler stringizing helper used by emb test macros.
+#define __STR(x) #x
+#define _STR(x) __STR(x)
+
+
+/**
+ * @brief Sets INTM (maskable interrupts are disabled).
+ * @param (none)
+ * @return Previous INTM state.
+ */
+uint16_t __disable_interrupts();
+
+
+/**
+ * @brief Clears INTM (maskable interrupts are enabled), pending interrupts are delivered.
+ * @param (none)
+ * @return Previous INTM state.
+ */
+uint16_t __enable_interrupts();
+
+
+/**
+ * @brief Restores INTM state returned by __disable_interrupts() or __enable_interrupts().
+ * @param intStatus - INTM state
+ * @return (none)
+ */
+void __restore_interrupts(uint16_t intStatus);
+
+
+/**
+ * @brief printf-family with C28x data model: long is 32-bit, so "%lu", "%lX", "%ld" conversions
+ * take 32-bit arguments (uint32_t is passed for them throughout firmware). "%ll" conversions take 64-bit arguments.
+ */
+int c28x_vsnprintf(char* buf, size_t size, const char* format, va_list args);
+int c28x_snprintf(char* buf, size_t size, const char* format, ...);
+int c28x_printf(const char* format, ...);
+
+#define snprintf c28x_snprintf
+#define printf c28x_printf
+
+
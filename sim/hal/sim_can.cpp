@@ -0,0 +1,796 @@
+/**
+ * @file sim_can.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "driverlib.h"
+#include "device.h"
+
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+
+namespace {
+
+
+struct MessageObject
+{
+	bool configured;
+	uint32_t id;
+	uint32_t mask;
+	CAN_MsgFrameType frameType;
+	CAN_MsgObjType type;
+	uint32_t flags;
+	uint16_t len;
+	uint16_t data[8];
+	bool newData;
+	bool intPending;
+	bool txRequest;		// frame waits for bus
+};
+
+
+struct Module
+{
+	uint32_t base;
+	uint32_t intNum;
+	bool started;
+	uint32_t bitrate;
+	uint16_t testMode;
+	uint32_t intEnabled;
+	uint16_t globalIntEnabled;
+	bool globalIntFlag;
+	uint16_t status;
+	bool statusPending;
+	MessageObject objects[sim::Can::objectCount];
+	void (*sink)(uint32_t base, const sim::CanFrame& frame);
+	uint64_t txCount;
+	uint64_t rxCount;
+	uint64_t lostCount;
+	bool onBus;
+	size_t busNode;
+};
+
+
+Module modules[2] = {
+	{CANA_BASE, INT_CANA0},
+	{CANB_BASE, INT_CANB0}
+};
+
+
+Module& module(uint32_t base)
+{
+	return (base == CANA_BASE) ? modules[0] : modules[1];
+}
+
+
+MessageObject& object(Module& m, uint32_t objID)
+{
+	return m.objects[(objID - 1) % sim::Can::objectCount];
+}
+
+
+bool anyPending(const Module& m)
+{
+	if (m.statusPending) return true;
+	for (size_t i = 0; i < sim::Can::objectCount; ++i)
+	{
+		if (m.objects[i].intPending) return true;
+	}
+	return false;
+}
+
+
+/// Sets CANINT0 flag and raises interrupt if there are pending interrupt sources.
+void updateInterrupt(Module& m)
+{
+	if (m.globalIntFlag || !anyPending(m)) return;
+	if ((m.intEnabled & CAN_INT_IE0) == 0) return;
+
+	m.globalIntFlag = true;
+	if ((m.globalIntEnabled & CAN_GLOBAL_INT_CANINT0) != 0)
+	{
+		sim::Interrupts::raise(m.intNum);
+	}
+}
+
+
+void setStatus(Module& m, uint16_t status)
+{
+	m.status |= status;
+	if ((m.intEnabled & CAN_INT_STATUS) != 0)
+	{
+		m.statusPending = true;
+	}
+}
+
+
+void setLastError(Module& m, uint16_t lec)
+{
+	m.status = (m.status & ~CAN_STATUS_LEC_MSK) | lec;
+	if ((m.intEnabled & CAN_INT_STATUS) != 0)
+	{
+		m.statusPending = true;
+	}
+	updateInterrupt(m);
+}
+
+
+/// Updates EWARN, EPASS, BUS_OFF status bits from transmit error counter.
+void setErrorState(Module& m, uint16_t tec, bool busOff)
+{
+	uint16_t state = 0;
+	if (tec >= 96) state |= CAN_STATUS_EWARN;
+	if (tec >= 128) state |= CAN_STATUS_EPASS;
+	if (busOff) state |= CAN_STATUS_BUS_OFF;
+
+	const uint16_t stateMask = CAN_STATUS_EWARN | CAN_STATUS_EPASS | CAN_STATUS_BUS_OFF;
+	if ((m.status & stateMask) == state) return;
+	m.status = (m.status & ~stateMask) | state;
+	if ((m.intEnabled & CAN_INT_ERROR) != 0)
+	{
+		m.statusPending = true;
+	}
+	updateInterrupt(m);
+}
+
+
+sim::CanFrame makeFrame(const MessageObject& obj, uint16_t len, const uint16_t* data)
+{
+	sim::CanFrame frame;
+	frame.id = obj.id;
+	frame.len = len;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		frame.data[i] = (i < len) ? (data[i] & 0xFF) : 0;
+	}
+	frame.extended = (obj.frameType == CAN_MSG_FRAME_EXT);
+	frame.remote = false;
+	return frame;
+}
+
+
+/// Completes successful transmission of message object.
+void completeTx(Module& m, MessageObject& obj, const sim::CanFrame& frame)
+{
+	++m.txCount;
+	if ((m.testMode & CAN_TEST_SILENT) == 0 && m.sink != NULL)
+	{
+		m.sink(m.base, frame);
+	}
+	setStatus(m, CAN_STATUS_TXOK);
+	if ((obj.flags & CAN_MSG_OBJ_TX_INT_ENABLE) != 0)
+	{
+		obj.intPending = true;
+	}
+	updateInterrupt(m);
+}
+
+
+/// Remote frame is received by TX object with ID filter, the object is not transmitted automatically.
+bool deliverRemote(Module& m, const sim::CanFrame& frame)
+{
+	for (size_t i = 0; i < sim::Can::objectCount; ++i)
+	{
+		MessageObject& obj = m.objects[i];
+		if (!obj.configured || obj.type != CAN_MSG_OBJ_TYPE_TX) continue;
+		if ((obj.flags & CAN_MSG_OBJ_USE_ID_FILTER) == 0) continue;
+		if ((frame.id & obj.mask) != (obj.id & obj.mask)) continue;
+
+		obj.txRequest = false;
+		obj.newData = true;
+		++m.rxCount;
+		setStatus(m, CAN_STATUS_RXOK);
+		if ((obj.flags & CAN_MSG_OBJ_RX_INT_ENABLE) != 0)
+		{
+			obj.intPending = true;
+		}
+		updateInterrupt(m);
+		return true;
+	}
+	return false;
+}
+
+
+bool deliver(Module& m, const sim::CanFrame& frame)
+{
+	if (!m.started) return false;
+	if (frame.remote) return deliverRemote(m, frame);
+
+	for (size_t i = 0; i < sim::Can::objectCount; ++i)
+	{
+		MessageObject& obj = m.objects[i];
+		if (!obj.configured || obj.type != CAN_MSG_OBJ_TYPE_RX) continue;
+		uint32_t mask = ((obj.flags & CAN_MSG_OBJ_USE_ID_FILTER) != 0) ? obj.mask : 0x1FFFFFFF;
+		if ((frame.id & mask) != (obj.id & mask)) continue;
+
+		if (obj.newData)
+		{
+			++m.lostCount;
+		}
+		obj.len = frame.len;
+		for (size_t j = 0; j < 8; ++j)
+		{
+			obj.data[j] = frame.data[j];
+		}
+		obj.newData = true;
+		++m.rxCount;
+		setStatus(m, CAN_STATUS_RXOK);
+		if ((obj.flags & CAN_MSG_OBJ_RX_INT_ENABLE) != 0)
+		{
+			obj.intPending = true;
+		}
+		updateInterrupt(m);
+		return true;
+	}
+	return false;
+}
+
+
+struct BusNode
+{
+	Module* module;		// NULL for client node
+	void (*rx)(size_t node, const sim::CanFrame& frame);
+	std::deque<sim::CanFrame> queue;	// client node frames
+	uint16_t tec;
+	bool busOff;
+	uint64_t busOffCycles;	// remaining bus-off recovery time
+};
+
+
+const uint32_t errorFrameBits = 17;	// error flag, delimiter and intermission
+const uint32_t busOffRecoveryBits = 128 * 11;
+
+
+/**
+ * @brief Bus model. Bus is idle, waits for arbitration point (SOF or end of error frame), or carries frame.
+ * Requests made within one bit time before arbitration point take part in arbitration.
+ */
+class Bus : public sim::ITimedModel
+{
+public:
+	uint32_t bitrate;
+	std::vector<BusNode> nodes;
+
+	bool active;		// arbitration point is scheduled or frame is on bus
+	bool transmitting;	// frame is on bus
+	bool due;		// arbitration point or end of frame is reached
+	uint64_t remaining;
+	size_t txNode;
+	size_t txObject;
+	sim::CanFrame frame;
+
+	uint32_t errorsToInject;
+	uint16_t injectedLec;
+
+	uint64_t frames;
+	uint64_t errors;
+	uint64_t busy;
+
+	Bus()
+	{
+		reset(500000);
+		sim::VirtualTime::registerModel(this);
+	}
+
+	void reset(uint32_t bitrate_)
+	{
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			if (nodes[i].module != NULL)
+			{
+				nodes[i].module->onBus = false;
+			}
+		}
+		nodes.clear();
+		bitrate = bitrate_;
+		active = false;
+		transmitting = false;
+		due = false;
+		remaining = 0;
+		errorsToInject = 0;
+		injectedLec = CAN_STATUS_LEC_NONE;
+		frames = 0;
+		errors = 0;
+		busy = 0;
+	}
+
+	uint64_t cyclesPerBit() const { return DEVICE_SYSCLK_FREQ / bitrate; }
+
+	void request()
+	{
+		if (active) return;
+		active = true;
+		transmitting = false;
+		remaining = cyclesPerBit();
+	}
+
+	virtual uint64_t cyclesToNextEvent() const
+	{
+		uint64_t cycles = active ? remaining : noEvent;
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			if (nodes[i].busOff) cycles = std::min(cycles, nodes[i].busOffCycles);
+		}
+		return cycles;
+	}
+
+	virtual void advance(uint64_t cycles)
+	{
+		if (active)
+		{
+			uint64_t step = std::min(cycles, remaining);
+			remaining -= step;
+			if (transmitting) busy += step;
+			if (remaining == 0) due = true;
+		}
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			if (nodes[i].busOff) nodes[i].busOffCycles -= std::min(cycles, nodes[i].busOffCycles);
+		}
+	}
+
+	virtual void fireEvents()
+	{
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			BusNode& node = nodes[i];
+			if (!node.busOff || node.busOffCycles != 0) continue;
+			node.busOff = false;
+			node.tec = 0;
+			if (node.module != NULL)
+			{
+				setErrorState(*node.module, 0, false);
+			}
+			if (pending(i) != 0) request();
+		}
+
+		if (!due) return;
+		due = false;
+		if (transmitting)
+		{
+			_complete();
+		}
+		else
+		{
+			_arbitrate();
+		}
+	}
+
+	size_t pending(size_t id) const
+	{
+		const BusNode& node = nodes[id];
+		if (node.module == NULL) return node.queue.size();
+		size_t count = 0;
+		for (size_t i = 0; i < sim::Can::objectCount; ++i)
+		{
+			if (node.module->objects[i].txRequest) ++count;
+		}
+		return count;
+	}
+
+private:
+	bool _listening(const BusNode& node) const
+	{
+		if (node.busOff) return false;
+		if (node.module == NULL) return true;
+		return node.module->started && node.module->bitrate == bitrate;
+	}
+
+	/// Arbitration key: standard frame wins over extended frame with the same base identifier,
+	/// data frame wins over remote frame with the same identifier.
+	static uint64_t _key(const sim::CanFrame& frame)
+	{
+		uint64_t rtr = frame.remote ? 1 : 0;
+		return frame.extended ? (static_cast<uint64_t>(frame.id & 0x1FFFFFFF) << 2) | 2 | rtr
+				: (static_cast<uint64_t>(frame.id & 0x7FF) << 20) | rtr;
+	}
+
+	void _arbitrate()
+	{
+		bool found = false;
+		uint64_t winnerKey = 0;
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			BusNode& node = nodes[i];
+			if (node.busOff) continue;
+
+			sim::CanFrame candidate;
+			size_t objIdx = 0;
+			if (node.module == NULL)
+			{
+				if (node.queue.empty()) continue;
+				candidate = node.queue.front();
+			}
+			else
+			{
+				for (objIdx = 0; objIdx < sim::Can::objectCount; ++objIdx)
+				{
+					if (node.module->objects[objIdx].txRequest) break;
+				}
+				if (objIdx == sim::Can::objectCount) continue;
+				const MessageObject& obj = node.module->objects[objIdx];
+				candidate = makeFrame(obj, obj.len, obj.data);
+			}
+
+			if (!found || _key(candidate) < winnerKey)
+			{
+				found = true;
+				winnerKey = _key(candidate);
+				txNode = i;
+				txObject = objIdx;
+				frame = candidate;
+			}
+		}
+
+		if (!found)
+		{
+			active = false;
+			return;
+		}
+		transmitting = true;
+		remaining = sim::CanBus::frameBits(frame) * cyclesPerBit();
+	}
+
+	void _complete()
+	{
+		BusNode& tx = nodes[txNode];
+		uint16_t lec = CAN_STATUS_LEC_NONE;
+		if (errorsToInject != 0)
+		{
+			--errorsToInject;
+			lec = injectedLec;
+		}
+		else if (tx.module != NULL && tx.module->bitrate != bitrate)
+		{
+			lec = CAN_STATUS_LEC_FORM;
+		}
+		else
+		{
+			bool acknowledged = false;
+			for (size_t i = 0; i < nodes.size() && !acknowledged; ++i)
+			{
+				if (i == txNode || !_listening(nodes[i])) continue;
+				acknowledged = (nodes[i].module == NULL) || ((nodes[i].module->testMode & CAN_TEST_SILENT) == 0);
+			}
+			if (!acknowledged) lec = CAN_STATUS_LEC_ACK;
+		}
+
+		if (lec != CAN_STATUS_LEC_NONE)
+		{
+			_fail(txNode, lec);
+			return;
+		}
+
+		++frames;
+		sim::CanFrame sent = frame;
+		size_t sender = txNode;
+		if (tx.tec != 0) --tx.tec;
+		if (tx.module != NULL)
+		{
+			MessageObject& obj = tx.module->objects[txObject];
+			obj.txRequest = false;
+			setErrorState(*tx.module, tx.tec, false);
+			completeTx(*tx.module, obj, sent);
+		}
+		else
+		{
+			tx.queue.pop_front();
+		}
+
+		// ISRs called on delivery may request bus, arbitration follows delivery
+		transmitting = false;
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			if (i == sender || !_listening(nodes[i])) continue;
+			if (nodes[i].module != NULL)
+			{
+				deliver(*nodes[i].module, sent);
+			}
+			else if (nodes[i].rx != NULL)
+			{
+				nodes[i].rx(i, sent);
+			}
+		}
+		_arbitrate();
+	}
+
+	/// Destroys frame with error frame, frame is retransmitted at next arbitration point.
+	void _fail(size_t id, uint16_t lec)
+	{
+		++errors;
+		BusNode& node = nodes[id];
+		bool errorPassive = node.tec >= 128;
+		if (lec != CAN_STATUS_LEC_ACK || !errorPassive)		// acknowledgment error does not increment counter of error passive node
+		{
+			node.tec = static_cast<uint16_t>(node.tec + 8);
+		}
+		if (node.tec > 255)
+		{
+			node.busOff = true;
+			node.busOffCycles = busOffRecoveryBits * cyclesPerBit();
+		}
+		if (node.module != NULL)
+		{
+			setLastError(*node.module, lec);
+			setErrorState(*node.module, node.tec, node.busOff);
+		}
+
+		transmitting = false;
+		remaining = errorFrameBits * cyclesPerBit();
+	}
+};
+
+
+Bus bus;
+
+
+void requestBus()
+{
+	bus.request();
+}
+
+
+} // namespace
+
+
+void CAN_selectClockSource(uint32_t base, CAN_ClockSource source) {}
+void CAN_enableAutoBusOn(uint32_t base) {}
+void CAN_setAutoBusOnTime(uint32_t base, uint32_t time) {}
+void CAN_startModule(uint32_t base) { module(base).started = true; }
+void CAN_enableTestMode(uint32_t base, uint16_t mode) { module(base).testMode = mode; }
+void CAN_setBitRate(uint32_t base, uint32_t clock, uint32_t bitRate, uint16_t bitTime) { module(base).bitrate = bitRate; }
+
+
+void CAN_initModule(uint32_t base)
+{
+	Module& m = module(base);
+	m.started = false;
+	m.testMode = 0;
+	m.intEnabled = 0;
+	m.globalIntEnabled = 0;
+	m.globalIntFlag = false;
+	m.status = 0;
+	m.statusPending = false;
+	for (size_t i = 0; i < sim::Can::objectCount; ++i)
+	{
+		m.objects[i].configured = false;
+		m.objects[i].newData = false;
+		m.objects[i].intPending = false;
+		m.objects[i].txRequest = false;
+	}
+}
+
+
+void CAN_enableInterrupt(uint32_t base, uint32_t intFlags)
+{
+	module(base).intEnabled |= intFlags;
+	updateInterrupt(module(base));
+}
+
+
+void CAN_enableGlobalInterrupt(uint32_t base, uint16_t intFlags)
+{
+	module(base).globalIntEnabled |= intFlags;
+	updateInterrupt(module(base));
+}
+
+
+uint16_t CAN_getStatus(uint32_t base)
+{
+	Module& m = module(base);
+	uint16_t status = m.status;
+	m.status &= ~(CAN_STATUS_RXOK | CAN_STATUS_TXOK | CAN_STATUS_LEC_MSK);
+	m.statusPending = false;	// reading status clears status interrupt
+	return status;
+}
+
+
+uint32_t CAN_getInterruptCause(uint32_t base)
+{
+	Module& m = module(base);
+	if (m.statusPending) return CAN_INT_INT0ID_STATUS;
+	for (size_t i = 0; i < sim::Can::objectCount; ++i)
+	{
+		if (m.objects[i].intPending) return i + 1;
+	}
+	return 0;
+}
+
+
+void CAN_clearInterruptStatus(uint32_t base, uint32_t intClr)
+{
+	Module& m = module(base);
+	if (intClr == CAN_INT_INT0ID_STATUS)
+	{
+		m.statusPending = false;
+	}
+	else if (intClr >= 1 && intClr <= sim::Can::objectCount)
+	{
+		object(m, intClr).intPending = false;
+	}
+}
+
+
+void CAN_clearGlobalInterruptStatus(uint32_t base, uint16_t intFlags)
+{
+	Module& m = module(base);
+	if ((intFlags & CAN_GLOBAL_INT_CANINT0) != 0)
+	{
+		m.globalIntFlag = false;
+		updateInterrupt(m);	// remaining sources raise interrupt again
+	}
+}
+
+
+void CAN_setupMessageObject(uint32_t base, uint32_t objID, uint32_t msgID, CAN_MsgFrameType frame,
+		CAN_MsgObjType msgType, uint32_t msgIDMask, uint32_t flags, uint16_t msgLen)
+{
+	MessageObject& obj = object(module(base), objID);
+	obj.configured = true;
+	obj.id = msgID;
+	obj.mask = msgIDMask;
+	obj.type = msgType;
+	obj.flags = flags;
+	obj.len = msgLen;
+	obj.frameType = frame;
+	obj.newData = false;
+	obj.intPending = false;
+	obj.txRequest = false;
+}
+
+
+void CAN_sendMessage(uint32_t base, uint32_t objID, uint16_t msgLen, const uint16_t* msgData)
+{
+	Module& m = module(base);
+	MessageObject& obj = object(m, objID);
+	if (!m.started) return;
+
+	if (m.onBus && (m.testMode & (CAN_TEST_SILENT | CAN_TEST_LBACK)) == 0)
+	{
+		// frame is stored in message object and waits for bus, pending frame of object is overwritten
+		obj.len = msgLen;
+		for (size_t i = 0; i < 8; ++i)
+		{
+			obj.data[i] = (i < msgLen) ? (msgData[i] & 0xFF) : 0;
+		}
+		obj.txRequest = true;
+		requestBus();
+		return;
+	}
+
+	sim::CanFrame frame = makeFrame(obj, msgLen, msgData);
+	completeTx(m, obj, frame);
+
+	if ((m.testMode & (CAN_TEST_LBACK | CAN_TEST_EXL)) != 0)
+	{
+		deliver(m, frame);
+	}
+}
+
+
+bool CAN_readMessage(uint32_t base, uint32_t objID, uint16_t* msgData)
+{
+	MessageObject& obj = object(module(base), objID);
+	for (size_t i = 0; i < obj.len && i < 8; ++i)
+	{
+		msgData[i] = obj.data[i];
+	}
+	bool newData = obj.newData;
+	obj.newData = false;
+	return newData;
+}
+
+
+uint32_t CAN_getTxRequests(uint32_t base)
+{
+	const Module& m = module(base);
+	uint32_t requests = 0;
+	for (size_t i = 0; i < sim::Can::objectCount; ++i)
+	{
+		if (m.objects[i].txRequest) requests |= static_cast<uint32_t>(1) << i;
+	}
+	return requests;
+}
+
+
+namespace sim {
+
+
+bool Can::receive(uint32_t base, const CanFrame& frame) { return deliver(module(base), frame); }
+void Can::setTxSink(uint32_t base, void (*sink)(uint32_t base, const CanFrame& frame)) { module(base).sink = sink; }
+bool Can::started(uint32_t base) { return module(base).started; }
+uint32_t Can::bitrate(uint32_t base) { return module(base).bitrate; }
+uint64_t Can::txCount(uint32_t base) { return module(base).txCount; }
+uint64_t Can::rxCount(uint32_t base) { return module(base).rxCount; }
+uint64_t Can::lostCount(uint32_t base) { return module(base).lostCount; }
+
+
+///
+///
+///
+void CanBus::reset(uint32_t bitrate)
+{
+	bus.reset(bitrate);
+}
+
+
+///
+///
+///
+size_t CanBus::attach(uint32_t base)
+{
+	Module& m = module(base);
+	if (m.onBus) return m.busNode;
+
+	BusNode node = {&m, NULL, std::deque<CanFrame>(), 0, false, 0};
+	bus.nodes.push_back(node);
+	m.onBus = true;
+	m.busNode = bus.nodes.size() - 1;
+	return m.busNode;
+}
+
+
+///
+///
+///
+size_t CanBus::attachClient(void (*rx)(size_t node, const CanFrame& frame))
+{
+	BusNode node = {NULL, rx, std::deque<CanFrame>(), 0, false, 0};
+	bus.nodes.push_back(node);
+	return bus.nodes.size() - 1;
+}
+
+
+///
+///
+///
+void CanBus::send(size_t node, const CanFrame& frame)
+{
+	if (node >= bus.nodes.size() || bus.nodes[node].module != NULL) return;
+	bus.nodes[node].queue.push_back(frame);
+	bus.request();
+}
+
+
+///
+///
+///
+void CanBus::injectErrors(uint32_t count, uint16_t lec)
+{
+	bus.errorsToInject = count;
+	bus.injectedLec = lec;
+}
+
+
+///
+///
+///
+uint32_t CanBus::frameBits(const CanFrame& frame)
+{
+	// SOF, arbitration, control, data, CRC, ACK, EOF and intermission fields
+	uint32_t overhead = frame.extended ? 67 : 47;
+	return frame.remote ? overhead : overhead + 8 * std::min<uint32_t>(frame.len, 8);
+}
+
+
+bool CanBus::idle() { return !bus.active; }
+uint32_t CanBus::bitrate() { return bus.bitrate; }
+size_t CanBus::pending(size_t node) { return bus.pending(node); }
+uint16_t CanBus::tec(size_t node) { return bus.nodes[node].tec; }
+uint64_t CanBus::frameCount() { return bus.frames; }
+uint64_t CanBus::errorCount() { return bus.errors; }
+uint64_t CanBus::busyCycles() { return bus.busy; }
+
+
+} // namespace sim
+
+
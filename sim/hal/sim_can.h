@@ -0,0 +1,223 @@
+/**
+ * @file sim_can.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated DCAN with driverlib CAN API.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "inc/hw_can.h"
+
+
+#define CAN_MSG_OBJ_TX_INT_ENABLE CAN_IF1MCTL_TXIE
+#define CAN_MSG_OBJ_RX_INT_ENABLE CAN_IF1MCTL_RXIE
+#define CAN_MSG_OBJ_USE_ID_FILTER (0x00000001U)
+#define CAN_MSG_OBJ_USE_DIR_FILTER CAN_IF1MSK_MDIR
+#define CAN_MSG_OBJ_USE_EXT_FILTER CAN_IF1MSK_MXTD
+#define CAN_MSG_OBJ_FIFO (0x00000002U)
+#define CAN_MSG_OBJ_NO_FLAGS (0x00000000U)
+#define CAN_INT_ERROR (0x00000008UL)
+#define CAN_INT_STATUS (0x00000004UL)
+#define CAN_INT_IE0 (0x00000002UL)
+#define CAN_INT_IE1 (0x00020000UL)
+#define CAN_STATUS_PERR (0x00000100U)
+#define CAN_STATUS_BUS_OFF (0x00000080U)
+#define CAN_STATUS_EWARN (0x00000040U)
+#define CAN_STATUS_EPASS (0x00000020U)
+#define CAN_STATUS_RXOK (0x00000010U)
+#define CAN_STATUS_TXOK (0x00000008U)
+#define CAN_STATUS_LEC_MSK (0x00000007U)
+#define CAN_STATUS_LEC_NONE (0x00000000U)
+#define CAN_STATUS_LEC_STUFF (0x00000001U)
+#define CAN_STATUS_LEC_FORM (0x00000002U)
+#define CAN_STATUS_LEC_ACK (0x00000003U)
+#define CAN_STATUS_LEC_BIT1 (0x00000004U)
+#define CAN_STATUS_LEC_BIT0 (0x00000005U)
+#define CAN_STATUS_LEC_CRC (0x00000006U)
+#define CAN_GLOBAL_INT_CANINT0 (0x00000001U)
+#define CAN_INT_INT0ID_STATUS (0x8000U)
+
+typedef enum
+{
+	CAN_CLOCK_SOURCE_SYS    = 0x0,
+	CAN_CLOCK_SOURCE_XTAL   = 0x1,
+	CAN_CLOCK_SOURCE_AUX    = 0x2
+} CAN_ClockSource;
+
+typedef enum
+{
+	CAN_MSG_FRAME_STD,
+	CAN_MSG_FRAME_EXT
+} CAN_MsgFrameType;
+
+typedef enum
+{
+	CAN_MSG_OBJ_TYPE_TX,
+	CAN_MSG_OBJ_TYPE_TX_REMOTE,
+	CAN_MSG_OBJ_TYPE_RX,
+	CAN_MSG_OBJ_TYPE_RXTX_REMOTE
+} CAN_MsgObjType;
+
+
+void CAN_selectClockSource(uint32_t base, CAN_ClockSource source);
+void CAN_startModule(uint32_t base);
+void CAN_enableTestMode(uint32_t base, uint16_t mode);
+void CAN_enableAutoBusOn(uint32_t base);
+void CAN_setAutoBusOnTime(uint32_t base, uint32_t time);
+void CAN_enableInterrupt(uint32_t base, uint32_t intFlags);
+uint16_t CAN_getStatus(uint32_t base);
+uint32_t CAN_getInterruptCause(uint32_t base);
+void CAN_enableGlobalInterrupt(uint32_t base, uint16_t intFlags);
+void CAN_clearGlobalInterruptStatus(uint32_t base, uint16_t intFlags);
+void CAN_initModule(uint32_t base);
+void CAN_setBitRate(uint32_t base, uint32_t clock, uint32_t bitRate, uint16_t bitTime);
+void CAN_clearInterruptStatus(uint32_t base, uint32_t intClr);
+void CAN_setupMessageObject(uint32_t base, uint32_t objID, uint32_t msgID, CAN_MsgFrameType frame,
+		CAN_MsgObjType msgType, uint32_t msgIDMask, uint32_t flags, uint16_t msgLen);
+void CAN_sendMessage(uint32_t base, uint32_t objID, uint16_t msgLen, const uint16_t* msgData);
+bool CAN_readMessage(uint32_t base, uint32_t objID, uint16_t* msgData);
+uint32_t CAN_getTxRequests(uint32_t base);
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief CAN frame on simulated bus. Data bytes are stored one per 16-bit word as in C28x message buffers.
+ */
+struct CanFrame
+{
+	uint32_t id;
+	uint16_t len;
+	uint16_t data[8];
+	bool extended;		// 29-bit identifier
+	bool remote;		// remote frame: data length code only, no data on bus
+};
+
+
+/**
+ * @brief Simulated DCAN modules with 32 message objects. Module that is not attached to CanBus is instant:
+ * sent frame is passed to TX sink immediately. Received frame is stored in the lowest-numbered
+ * matching RX object. Remote frame is received by matching TX object that uses ID filter: pending transmission
+ * is cancelled and RX interrupt is raised, response is sent by software (DCAN with RmtEn = 0, UMask = 1).
+ * Interrupt cause is status change first, then the lowest pending object, as on target.
+ */
+class Can
+{
+private:
+	Can();					// no constructor
+	Can(const Can& other);			// no copy constructor
+	Can& operator=(const Can& other);	// no copy assignment operator
+public:
+	static const size_t objectCount = 32;
+
+	/**
+	 * @brief Delivers frame from bus to CAN module.
+	 * @param base - CAN base address
+	 * @param frame - frame
+	 * @return \c true if frame is accepted by RX object, \c false otherwise.
+	 */
+	static bool receive(uint32_t base, const CanFrame& frame);
+
+	/**
+	 * @brief Sets callback called for every sent frame.
+	 * @param base - CAN base address
+	 * @param sink - callback, NULL to disable
+	 * @return (none)
+	 */
+	static void setTxSink(uint32_t base, void (*sink)(uint32_t base, const CanFrame& frame));
+
+	static bool started(uint32_t base);
+	static uint32_t bitrate(uint32_t base);
+	static uint64_t txCount(uint32_t base);
+	static uint64_t rxCount(uint32_t base);
+	static uint64_t lostCount(uint32_t base);	// frames overwritten before read
+};
+
+
+/**
+ * @brief Simulated CAN bus: broadcast medium driven by virtual time. Nodes are DCAN modules and client nodes
+ * (e.g. test client playing role of PC CAN adapter). Frame takes its bit length on bus (stuff bits are not modeled),
+ * pending frames of all nodes arbitrate by identifier at start of frame, node's message objects arbitrate by object number.
+ * Frame that is not acknowledged by any other node or that is destroyed by injected error is retransmitted.
+ * Transmit error counter of node is maintained with error warning, error passive and bus-off states,
+ * bus-off node recovers after 128 * 11 recessive bits.
+ */
+class CanBus
+{
+private:
+	CanBus();					// no constructor
+	CanBus(const CanBus& other);			// no copy constructor
+	CanBus& operator=(const CanBus& other);	// no copy assignment operator
+public:
+	static const size_t invalidNode = ~static_cast<size_t>(0);
+
+	/**
+	 * @brief Detaches all nodes, clears bus statistics.
+	 * @param bitrate - bus bitrate, bps
+	 * @return (none)
+	 */
+	static void reset(uint32_t bitrate);
+
+	/**
+	 * @brief Attaches DCAN module to bus. Module that has different bitrate does not receive frames
+	 * and its transmission fails with form error.
+	 * @param base - CAN base address
+	 * @return Node id.
+	 */
+	static size_t attach(uint32_t base);
+
+	/**
+	 * @brief Attaches client node to bus. Client node receives every frame and acknowledges it.
+	 * @param rx - callback called for every frame sent by other node, may be NULL
+	 * @return Node id.
+	 */
+	static size_t attachClient(void (*rx)(size_t node, const CanFrame& frame));
+
+	/**
+	 * @brief Queues frame for transmission by client node. Queued frames are sent in order.
+	 * @param node - client node id
+	 * @param frame - frame
+	 * @return (none)
+	 */
+	static void send(size_t node, const CanFrame& frame);
+
+	/**
+	 * @brief Destroys next frames on bus with error frame.
+	 * @param count - number of frames
+	 * @param lec - last error code reported to transmitter, e.g. CAN_STATUS_LEC_BIT0
+	 * @return (none)
+	 */
+	static void injectErrors(uint32_t count, uint16_t lec);
+
+	/// Frame length on bus including 3-bit intermission, bits.
+	static uint32_t frameBits(const CanFrame& frame);
+
+	static bool idle();
+	static uint32_t bitrate();
+	static size_t pending(size_t node);	// queued client frames or pending TX objects
+	static uint16_t tec(size_t node);	// transmit error counter
+	static uint64_t frameCount();		// successfully transmitted frames
+	static uint64_t errorCount();		// destroyed frames
+	static uint64_t busyCycles();		// SYSCLK cycles with frame or error frame on bus
+};
+
+
+/// @}
+} // namespace sim
+
+
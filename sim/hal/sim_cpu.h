@@ -0,0 +1,27 @@
+/**
+ * @file sim_cpu.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated C28x CPU: INTM and DBGM control macros.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include "sim_c28x.h"
+
+
+#define EINT	__enable_interrupts()
+#define DINT	__disable_interrupts()
+#define ERTM
+#define DRTM
+#define NOP
+#define ESTOP0
+
+
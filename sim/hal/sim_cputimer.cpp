@@ -0,0 +1,139 @@
+/**
+ * @file sim_cputimer.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "driverlib.h"
+
+#include <algorithm>
+
+
+namespace {
+
+
+class CpuTimers : public sim::ITimedModel
+{
+private:
+	struct Timer
+	{
+		uint32_t period;
+		uint32_t counter;
+		bool running;
+		bool interruptEnabled;
+		bool overflow;
+		bool firePending;
+	};
+	static const size_t _timerCount = 3;
+	Timer _timers[_timerCount];
+public:
+	CpuTimers()
+	{
+		for (size_t i = 0; i < _timerCount; ++i)
+		{
+			Timer timer = {0xFFFFFFFF, 0xFFFFFFFF, false, false, false, false};	// stopped after reset on host
+			_timers[i] = timer;
+		}
+		sim::VirtualTime::registerModel(this);
+	}
+
+	Timer& timer(uint32_t base)
+	{
+		switch (base)
+		{
+		case CPUTIMER0_BASE:
+			return _timers[0];
+		case CPUTIMER1_BASE:
+			return _timers[1];
+		default:
+			return _timers[2];
+		}
+	}
+
+	virtual uint64_t cyclesToNextEvent() const
+	{
+		uint64_t cycles = noEvent;
+		for (size_t i = 0; i < _timerCount; ++i)
+		{
+			if (_timers[i].running && _timers[i].interruptEnabled)
+			{
+				cycles = std::min(cycles, static_cast<uint64_t>(_timers[i].counter) + 1);
+			}
+		}
+		return cycles;
+	}
+
+	virtual void advance(uint64_t cycles)
+	{
+		for (size_t i = 0; i < _timerCount; ++i)
+		{
+			Timer& t = _timers[i];
+			if (!t.running) continue;
+
+			uint64_t toOverflow = static_cast<uint64_t>(t.counter) + 1;
+			if (cycles < toOverflow)
+			{
+				t.counter -= static_cast<uint32_t>(cycles);
+				continue;
+			}
+
+			uint64_t afterReload = (cycles - toOverflow) % (static_cast<uint64_t>(t.period) + 1);
+			t.counter = t.period - static_cast<uint32_t>(afterReload);
+			t.overflow = true;
+			if (t.interruptEnabled)
+			{
+				t.firePending = true;
+			}
+		}
+	}
+
+	virtual void fireEvents()
+	{
+		static const uint32_t interruptNumbers[_timerCount] = {INT_TIMER0, INT_TIMER1, INT_TIMER2};
+		for (size_t i = 0; i < _timerCount; ++i)
+		{
+			if (_timers[i].firePending)
+			{
+				_timers[i].firePending = false;
+				sim::Interrupts::raise(interruptNumbers[i]);
+			}
+		}
+	}
+};
+
+
+CpuTimers cpuTimers;
+
+
+} // namespace
+
+
+void CPUTimer_clearOverflowFlag(uint32_t base) { cpuTimers.timer(base).overflow = false; }
+void CPUTimer_disableInterrupt(uint32_t base) { cpuTimers.timer(base).interruptEnabled = false; }
+void CPUTimer_enableInterrupt(uint32_t base) { cpuTimers.timer(base).interruptEnabled = true; }
+void CPUTimer_reloadTimerCounter(uint32_t base) { cpuTimers.timer(base).counter = cpuTimers.timer(base).period; }
+void CPUTimer_stopTimer(uint32_t base) { cpuTimers.timer(base).running = false; }
+void CPUTimer_resumeTimer(uint32_t base) { cpuTimers.timer(base).running = true; }
+void CPUTimer_setPeriod(uint32_t base, uint32_t periodCount) { cpuTimers.timer(base).period = periodCount; }
+uint32_t CPUTimer_getTimerCount(uint32_t base) { return cpuTimers.timer(base).counter; }
+void CPUTimer_setPreScaler(uint32_t base, uint16_t prescaler) {}
+bool CPUTimer_getTimerOverflowStatus(uint32_t base) { return cpuTimers.timer(base).overflow; }
+
+
+///
+///
+///
+void CPUTimer_startTimer(uint32_t base)
+{
+	CPUTimer_reloadTimerCounter(base);
+	cpuTimers.timer(base).running = true;
+}
+
+
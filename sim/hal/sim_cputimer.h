@@ -0,0 +1,47 @@
+/**
+ * @file sim_cputimer.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated CPU-Timer0/1/2 with driverlib CPU timer API.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+typedef enum
+{
+	CPUTIMER_EMULATIONMODE_STOPAFTERNEXTDECREMENT = 0x0000,
+	CPUTIMER_EMULATIONMODE_STOPATZERO = 0x0400,
+	CPUTIMER_EMULATIONMODE_RUNFREE = 0x0800
+} CPUTimer_EmulationMode;
+
+
+/*
+ * Timer model: counter is decremented every SYSCLK cycle (prescaler is not modeled),
+ * on decrement past zero counter is reloaded with period, overflow flag is set
+ * and timer interrupt is raised if enabled.
+ */
+void CPUTimer_clearOverflowFlag(uint32_t base);
+void CPUTimer_disableInterrupt(uint32_t base);
+void CPUTimer_enableInterrupt(uint32_t base);
+void CPUTimer_reloadTimerCounter(uint32_t base);
+void CPUTimer_stopTimer(uint32_t base);
+void CPUTimer_resumeTimer(uint32_t base);
+void CPUTimer_startTimer(uint32_t base);
+void CPUTimer_setPeriod(uint32_t base, uint32_t periodCount);
+uint32_t CPUTimer_getTimerCount(uint32_t base);
+void CPUTimer_setPreScaler(uint32_t base, uint16_t prescaler);
+bool CPUTimer_getTimerOverflowStatus(uint32_t base);
+inline void CPUTimer_setEmulationMode(uint32_t base, CPUTimer_EmulationMode mode) {}
+
+
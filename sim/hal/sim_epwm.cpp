@@ -0,0 +1,292 @@
+/**
+ * @file sim_epwm.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "driverlib.h"
+
+#include <algorithm>
+
+
+namespace {
+
+
+const size_t moduleCount = 12;
+bool tbclkSync = false;
+
+
+struct Module
+{
+	uint16_t period;
+	uint16_t counter;
+	EPWM_TimeBaseCountMode mode;
+	uint32_t clockDivider;		// time-base clock divider relative to SYSCLK
+	uint16_t compare[4];
+	uint16_t intSource;
+	uint16_t intEventCount;
+	bool intEnabled;
+	bool intFlag;
+	uint16_t eventCounter;
+	uint16_t tzIntEnabled;
+	uint16_t tzFlags;
+	uint16_t tzOstFlags;
+	uint64_t position;		// SYSCLK cycles since start of time-base cycle
+	bool firePending;
+	uint32_t interrupts;
+};
+
+
+const uint32_t eventIntNums[moduleCount] = {INT_EPWM1, INT_EPWM2, INT_EPWM3, INT_EPWM4, INT_EPWM5, INT_EPWM6,
+		INT_EPWM7, INT_EPWM8, INT_EPWM9, INT_EPWM10, INT_EPWM11, INT_EPWM12};
+const uint32_t tripIntNums[moduleCount] = {INT_EPWM1_TZ, INT_EPWM2_TZ, INT_EPWM3_TZ, INT_EPWM4_TZ, INT_EPWM5_TZ, INT_EPWM6_TZ,
+		INT_EPWM7_TZ, INT_EPWM8_TZ, INT_EPWM9_TZ, INT_EPWM10_TZ, INT_EPWM11_TZ, INT_EPWM12_TZ};
+
+
+class Epwms : public sim::ITimedModel
+{
+public:
+	Module modules[moduleCount];
+
+	Epwms()
+	{
+		for (size_t i = 0; i < moduleCount; ++i)
+		{
+			Module& m = modules[i];
+			m.period = 0;
+			m.counter = 0;
+			m.mode = EPWM_COUNTER_MODE_STOP_FREEZE;
+			m.clockDivider = 2;	// EPWMCLK = SYSCLK/2
+			m.intSource = EPWM_INT_TBCTR_DISABLED;
+			m.intEventCount = 1;
+			m.intEnabled = false;
+			m.intFlag = false;
+			m.eventCounter = 0;
+			m.tzIntEnabled = 0;
+			m.tzFlags = 0;
+			m.tzOstFlags = 0;
+			m.position = 0;
+			m.firePending = false;
+			m.interrupts = 0;
+		}
+		sim::VirtualTime::registerModel(this);
+	}
+
+	static size_t index(uint32_t base) { return ((base - EPWM1_BASE) / 0x100) % moduleCount; }
+	Module& module(uint32_t base) { return modules[index(base)]; }
+
+	static bool running(const Module& m)
+	{
+		return tbclkSync && m.mode != EPWM_COUNTER_MODE_STOP_FREEZE && m.period != 0;
+	}
+
+	/// Time-base cycle length in SYSCLK cycles.
+	static uint64_t cycleLength(const Module& m)
+	{
+		uint64_t ticks = (m.mode == EPWM_COUNTER_MODE_UP_DOWN) ? 2 * static_cast<uint64_t>(m.period) : m.period + 1;
+		return ticks * m.clockDivider;
+	}
+
+	/// Positions of zero and period events in time-base cycle, in SYSCLK cycles.
+	static uint64_t zeroPosition(const Module& m)
+	{
+		return (m.mode == EPWM_COUNTER_MODE_DOWN) ? static_cast<uint64_t>(m.period) * m.clockDivider : 0;
+	}
+
+	static uint64_t periodPosition(const Module& m)
+	{
+		return (m.mode == EPWM_COUNTER_MODE_DOWN) ? 0 : static_cast<uint64_t>(m.period) * m.clockDivider;
+	}
+
+	static bool zeroEventUsed(const Module& m)
+	{
+		return m.intSource == EPWM_INT_TBCTR_ZERO || m.intSource == EPWM_INT_TBCTR_ZERO_OR_PERIOD;
+	}
+
+	static bool periodEventUsed(const Module& m)
+	{
+		return m.intSource == EPWM_INT_TBCTR_PERIOD || m.intSource == EPWM_INT_TBCTR_ZERO_OR_PERIOD;
+	}
+
+	/// Cycles from current position to event position, full cycle if position is current.
+	static uint64_t distance(const Module& m, uint64_t eventPosition)
+	{
+		uint64_t length = cycleLength(m);
+		uint64_t d = (eventPosition + length - m.position % length) % length;
+		return (d == 0) ? length : d;
+	}
+
+	virtual uint64_t cyclesToNextEvent() const
+	{
+		uint64_t cycles = noEvent;
+		for (size_t i = 0; i < moduleCount; ++i)
+		{
+			const Module& m = modules[i];
+			if (!running(m) || !m.intEnabled) continue;
+			if (zeroEventUsed(m)) cycles = std::min(cycles, distance(m, zeroPosition(m)));
+			if (periodEventUsed(m)) cycles = std::min(cycles, distance(m, periodPosition(m)));
+		}
+		return cycles;
+	}
+
+	virtual void advance(uint64_t cycles)
+	{
+		for (size_t i = 0; i < moduleCount; ++i)
+		{
+			Module& m = modules[i];
+			if (!running(m)) continue;
+
+			uint64_t length = cycleLength(m);
+			uint64_t events = 0;
+			if (zeroEventUsed(m)) events += _count(m, zeroPosition(m), cycles);
+			if (periodEventUsed(m)) events += _count(m, periodPosition(m), cycles);
+			m.position = (m.position + cycles) % length;
+			m.counter = _counter(m);
+
+			if (events == 0 || !m.intEnabled) continue;
+			m.eventCounter = static_cast<uint16_t>(m.eventCounter + events);
+			if (m.eventCounter >= m.intEventCount)
+			{
+				m.eventCounter = 0;
+				if (!m.intFlag)
+				{
+					m.intFlag = true;
+					m.firePending = true;
+				}
+			}
+		}
+	}
+
+	virtual void fireEvents()
+	{
+		for (size_t i = 0; i < moduleCount; ++i)
+		{
+			if (modules[i].firePending)
+			{
+				modules[i].firePending = false;
+				++modules[i].interrupts;
+				sim::Interrupts::raise(eventIntNums[i]);
+			}
+		}
+	}
+
+	void setCounter(Module& m, uint16_t count)
+	{
+		m.counter = count;
+		uint64_t ticks = (m.mode == EPWM_COUNTER_MODE_DOWN) ? static_cast<uint64_t>(m.period - count) : count;
+		m.position = ticks * m.clockDivider;
+	}
+
+private:
+	static uint64_t _count(const Module& m, uint64_t eventPosition, uint64_t cycles)
+	{
+		uint64_t d = distance(m, eventPosition);
+		return (cycles < d) ? 0 : 1 + (cycles - d) / cycleLength(m);
+	}
+
+	static uint16_t _counter(const Module& m)
+	{
+		uint64_t ticks = m.position / m.clockDivider;
+		switch (m.mode)
+		{
+		case EPWM_COUNTER_MODE_UP:
+			return static_cast<uint16_t>(ticks);
+		case EPWM_COUNTER_MODE_DOWN:
+			return static_cast<uint16_t>(m.period - ticks);
+		default:
+			return static_cast<uint16_t>((ticks <= m.period) ? ticks : 2 * m.period - ticks);
+		}
+	}
+};
+
+
+Epwms epwms;
+
+
+void setTripFlags(uint32_t base, uint16_t flags)
+{
+	Module& m = epwms.module(base);
+	bool intFlag = (m.tzFlags & EPWM_TZ_INTERRUPT) != 0;
+	m.tzFlags |= flags;
+	if (!intFlag && (m.tzIntEnabled & flags) != 0)
+	{
+		m.tzFlags |= EPWM_TZ_INTERRUPT;
+		sim::Interrupts::raise(tripIntNums[Epwms::index(base)]);
+	}
+}
+
+
+} // namespace
+
+
+void EPWM_setCountModeAfterSync(uint32_t base, EPWM_SyncCountMode mode) {}
+void EPWM_setSyncOutPulseMode(uint32_t base, EPWM_SyncOutPulseMode mode) {}
+void EPWM_enablePhaseShiftLoad(uint32_t base) {}
+void EPWM_disablePhaseShiftLoad(uint32_t base) {}
+void EPWM_selectPeriodLoadEvent(uint32_t base, EPWM_PeriodShadowLoadMode shadowLoadMode) {}
+void EPWM_setPhaseShift(uint32_t base, uint16_t phaseCount) {}
+void EPWM_setCounterCompareShadowLoadMode(uint32_t base, EPWM_CounterCompareModule compModule, EPWM_CounterCompareLoadMode loadMode) {}
+void EPWM_setActionQualifierAction(uint32_t base, EPWM_ActionQualifierOutputModule epwmOutput, EPWM_ActionQualifierOutput output, EPWM_ActionQualifierOutputEvent event) {}
+void EPWM_setActionQualifierContSWForceShadowMode(uint32_t base, EPWM_ActionQualifierContForce mode) {}
+void EPWM_setDeadBandOutputSwapMode(uint32_t base, EPWM_DeadBandOutput output, bool enableSwapMode) {}
+void EPWM_setDeadBandDelayMode(uint32_t base, EPWM_DeadBandDelayMode delayMode, bool enableDelayMode) {}
+void EPWM_setDeadBandDelayPolarity(uint32_t base, EPWM_DeadBandDelayMode delayMode, EPWM_DeadBandPolarity polarity) {}
+void EPWM_setRisingEdgeDeadBandDelayInput(uint32_t base, uint16_t input) {}
+void EPWM_setFallingEdgeDeadBandDelayInput(uint32_t base, uint16_t input) {}
+void EPWM_setDeadBandControlShadowLoadMode(uint32_t base, EPWM_DeadBandControlLoadMode loadMode) {}
+void EPWM_setDeadBandCounterClock(uint32_t base, EPWM_DeadBandClockMode clockMode) {}
+void EPWM_setRisingEdgeDelayCount(uint32_t base, uint16_t redCount) {}
+void EPWM_setFallingEdgeDelayCount(uint32_t base, uint16_t fedCount) {}
+void EPWM_enableTripZoneSignals(uint32_t base, uint16_t tzSignal) {}
+void EPWM_setTripZoneAction(uint32_t base, EPWM_TripZoneEvent tzEvent, EPWM_TripZoneAction tzAction) {}
+void EPWM_enableADCTrigger(uint32_t base, EPWM_ADCStartOfConversionType adcSOCType) {}
+void EPWM_setADCTriggerSource(uint32_t base, EPWM_ADCStartOfConversionType adcSOCType, EPWM_ADCStartOfConversionSource socSource) {}
+void EPWM_setADCTriggerEventPrescale(uint32_t base, EPWM_ADCStartOfConversionType adcSOCType, uint16_t preScaleCount) {}
+void XBAR_setInputPin(XBAR_InputNum input, uint16_t pin) {}
+
+void EPWM_setTimeBaseCounter(uint32_t base, uint16_t count) { epwms.setCounter(epwms.module(base), count); }
+void EPWM_setTimeBaseCounterMode(uint32_t base, EPWM_TimeBaseCountMode counterMode) { epwms.module(base).mode = counterMode; }
+void EPWM_setTimeBasePeriod(uint32_t base, uint16_t periodCount) { epwms.module(base).period = periodCount; }
+void EPWM_setCounterCompareValue(uint32_t base, EPWM_CounterCompareModule compModule, uint16_t compCount) { epwms.module(base).compare[(compModule / 2) % 4] = compCount; }
+void EPWM_enableTripZoneInterrupt(uint32_t base, uint16_t tzInterrupt) { epwms.module(base).tzIntEnabled |= tzInterrupt; }
+void EPWM_disableTripZoneInterrupt(uint32_t base, uint16_t tzInterrupt) { epwms.module(base).tzIntEnabled &= ~tzInterrupt; }
+void EPWM_clearTripZoneFlag(uint32_t base, uint16_t tzFlags) { epwms.module(base).tzFlags &= ~tzFlags; }
+void EPWM_clearOneShotTripZoneFlag(uint32_t base, uint16_t tzOSTFlags) { epwms.module(base).tzOstFlags &= ~tzOSTFlags; }
+void EPWM_forceTripZoneEvent(uint32_t base, uint16_t tzForceEvent) { setTripFlags(base, tzForceEvent); }
+void EPWM_enableInterrupt(uint32_t base) { epwms.module(base).intEnabled = true; }
+void EPWM_disableInterrupt(uint32_t base) { epwms.module(base).intEnabled = false; }
+void EPWM_setInterruptSource(uint32_t base, uint16_t interruptSource) { epwms.module(base).intSource = interruptSource; }
+void EPWM_setInterruptEventCount(uint32_t base, uint16_t eventCount) { epwms.module(base).intEventCount = (eventCount == 0) ? 1 : eventCount; }
+void EPWM_clearEventTriggerInterruptFlag(uint32_t base) { epwms.module(base).intFlag = false; }
+
+
+void EPWM_setClockPrescaler(uint32_t base, EPWM_ClockDivider prescaler, EPWM_HSClockDivider highSpeedPrescaler)
+{
+	uint32_t hsDivider = (highSpeedPrescaler == EPWM_HSCLOCK_DIVIDER_1) ? 1 : 2 * static_cast<uint32_t>(highSpeedPrescaler);
+	epwms.module(base).clockDivider = 2 * (1UL << prescaler) * hsDivider;
+}
+
+
+namespace sim {
+
+
+void setTbclkSync(bool enabled) { tbclkSync = enabled; }
+
+
+bool Epwm::running(uint32_t base) { return Epwms::running(epwms.module(base)); }
+uint16_t Epwm::period(uint32_t base) { return epwms.module(base).period; }
+uint16_t Epwm::compareValue(uint32_t base, EPWM_CounterCompareModule compModule) { return epwms.module(base).compare[(compModule / 2) % 4]; }
+bool Epwm::tripped(uint32_t base) { return (epwms.module(base).tzFlags & EPWM_TZ_FLAG_OST) != 0; }
+uint32_t Epwm::interruptCount(uint32_t base) { return epwms.module(base).interrupts; }
+
+
+} // namespace sim
+
+
@@ -0,0 +1,352 @@
+/**
+ * @file sim_epwm.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated ePWM time-base, event-trigger and trip-zone submodules with driverlib EPWM API.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+#define EPWM_DB_INPUT_EPWMA 0U
+#define EPWM_DB_INPUT_EPWMB 1U
+#define EPWM_DB_INPUT_DB_RED 2U
+#define EPWM_TZ_SIGNAL_CBC1 0x1U
+#define EPWM_TZ_SIGNAL_CBC2 0x2U
+#define EPWM_TZ_SIGNAL_CBC3 0x4U
+#define EPWM_TZ_SIGNAL_CBC4 0x8U
+#define EPWM_TZ_SIGNAL_CBC5 0x10U
+#define EPWM_TZ_SIGNAL_CBC6 0x20U
+#define EPWM_TZ_SIGNAL_DCAEVT2 0x40U
+#define EPWM_TZ_SIGNAL_DCBEVT2 0x80U
+#define EPWM_TZ_SIGNAL_OSHT1 0x100U
+#define EPWM_TZ_SIGNAL_OSHT2 0x200U
+#define EPWM_TZ_SIGNAL_OSHT3 0x400U
+#define EPWM_TZ_SIGNAL_OSHT4 0x800U
+#define EPWM_TZ_SIGNAL_OSHT5 0x1000U
+#define EPWM_TZ_SIGNAL_OSHT6 0x2000U
+#define EPWM_TZ_SIGNAL_DCAEVT1 0x4000U
+#define EPWM_TZ_SIGNAL_DCBEVT1 0x8000U
+#define EPWM_TZ_INTERRUPT_CBC 0x2U
+#define EPWM_TZ_INTERRUPT_OST 0x4U
+#define EPWM_TZ_INTERRUPT_DCAEVT1 0x8U
+#define EPWM_TZ_INTERRUPT_DCAEVT2 0x10U
+#define EPWM_TZ_INTERRUPT_DCBEVT1 0x20U
+#define EPWM_TZ_INTERRUPT_DCBEVT2 0x40U
+#define EPWM_TZ_FLAG_CBC 0x2U
+#define EPWM_TZ_FLAG_OST 0x4U
+#define EPWM_TZ_FLAG_DCAEVT1 0x8U
+#define EPWM_TZ_FLAG_DCAEVT2 0x10U
+#define EPWM_TZ_FLAG_DCBEVT1 0x20U
+#define EPWM_TZ_FLAG_DCBEVT2 0x40U
+#define EPWM_TZ_INTERRUPT 0x1U
+#define EPWM_TZ_OST_FLAG_OST1 0x1U
+#define EPWM_TZ_OST_FLAG_OST2 0x2U
+#define EPWM_TZ_OST_FLAG_OST3 0x4U
+#define EPWM_TZ_OST_FLAG_OST4 0x8U
+#define EPWM_TZ_OST_FLAG_OST5 0x10U
+#define EPWM_TZ_OST_FLAG_OST6 0x20U
+#define EPWM_TZ_OST_FLAG_DCAEVT1 0x40U
+#define EPWM_TZ_OST_FLAG_DCBEVT1 0x80U
+#define EPWM_TZ_FORCE_EVENT_CBC 0x2U
+#define EPWM_TZ_FORCE_EVENT_OST 0x4U
+#define EPWM_TZ_FORCE_EVENT_DCAEVT1 0x8U
+#define EPWM_TZ_FORCE_EVENT_DCAEVT2 0x10U
+#define EPWM_TZ_FORCE_EVENT_DCBEVT1 0x20U
+#define EPWM_TZ_FORCE_EVENT_DCBEVT2 0x40U
+#define EPWM_INT_TBCTR_DISABLED 0U
+#define EPWM_INT_TBCTR_ZERO 1U
+#define EPWM_INT_TBCTR_PERIOD 2U
+#define EPWM_INT_TBCTR_ZERO_OR_PERIOD 3U
+#define EPWM_INT_TBCTR_U_CMPA 4U
+#define EPWM_INT_TBCTR_U_CMPC 8U
+#define EPWM_INT_TBCTR_D_CMPA 5U
+#define EPWM_INT_TBCTR_D_CMPC 10U
+#define EPWM_INT_TBCTR_U_CMPB 6U
+#define EPWM_INT_TBCTR_U_CMPD 12U
+#define EPWM_INT_TBCTR_D_CMPB 7U
+#define EPWM_INT_TBCTR_D_CMPD 14U
+
+typedef enum
+{
+	EPWM_SOC_DCxEVT1 = 0,
+	EPWM_SOC_TBCTR_ZERO = 1,
+	EPWM_SOC_TBCTR_PERIOD = 2,
+	EPWM_SOC_TBCTR_ZERO_OR_PERIOD = 3,
+	EPWM_SOC_TBCTR_U_CMPA = 4,
+	EPWM_SOC_TBCTR_U_CMPC = 8,
+	EPWM_SOC_TBCTR_D_CMPA = 5,
+	EPWM_SOC_TBCTR_D_CMPC = 10,
+	EPWM_SOC_TBCTR_U_CMPB = 6,
+	EPWM_SOC_TBCTR_U_CMPD = 12,
+	EPWM_SOC_TBCTR_D_CMPB = 7,
+	EPWM_SOC_TBCTR_D_CMPD = 14
+} EPWM_ADCStartOfConversionSource;
+
+typedef enum
+{
+	EPWM_SOC_A = 0,
+	EPWM_SOC_B = 1
+} EPWM_ADCStartOfConversionType;
+
+typedef enum
+{
+	EPWM_AQ_SW_SH_LOAD_ON_CNTR_ZERO        = 0,
+	EPWM_AQ_SW_SH_LOAD_ON_CNTR_PERIOD      = 1,
+	EPWM_AQ_SW_SH_LOAD_ON_CNTR_ZERO_PERIOD = 2,
+	EPWM_AQ_SW_IMMEDIATE_LOAD   = 3
+} EPWM_ActionQualifierContForce;
+
+typedef enum
+{
+	EPWM_AQ_OUTPUT_NO_CHANGE = 0,
+	EPWM_AQ_OUTPUT_LOW       = 1,
+	EPWM_AQ_OUTPUT_HIGH      = 2,
+	EPWM_AQ_OUTPUT_TOGGLE    = 3
+} EPWM_ActionQualifierOutput;
+
+typedef enum
+{
+	EPWM_AQ_OUTPUT_ON_TIMEBASE_ZERO       = 0,
+	EPWM_AQ_OUTPUT_ON_TIMEBASE_PERIOD     = 2,
+	EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPA    = 4,
+	EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPA  = 6,
+	EPWM_AQ_OUTPUT_ON_TIMEBASE_UP_CMPB    = 8,
+	EPWM_AQ_OUTPUT_ON_TIMEBASE_DOWN_CMPB  = 10,
+	EPWM_AQ_OUTPUT_ON_T1_COUNT_UP         = 1,
+	EPWM_AQ_OUTPUT_ON_T1_COUNT_DOWN       = 3,
+	EPWM_AQ_OUTPUT_ON_T2_COUNT_UP         = 5,
+	EPWM_AQ_OUTPUT_ON_T2_COUNT_DOWN       = 7
+} EPWM_ActionQualifierOutputEvent;
+
+typedef enum
+{
+	EPWM_AQ_OUTPUT_A = 0,
+	EPWM_AQ_OUTPUT_B = 2
+} EPWM_ActionQualifierOutputModule;
+
+typedef enum
+{
+	EPWM_CLOCK_DIVIDER_1 = 0,
+	EPWM_CLOCK_DIVIDER_2 = 1,
+	EPWM_CLOCK_DIVIDER_4 = 2,
+	EPWM_CLOCK_DIVIDER_8 = 3,
+	EPWM_CLOCK_DIVIDER_16 = 4,
+	EPWM_CLOCK_DIVIDER_32 = 5,
+	EPWM_CLOCK_DIVIDER_64 = 6,
+	EPWM_CLOCK_DIVIDER_128 = 7
+} EPWM_ClockDivider;
+
+typedef enum
+{
+	EPWM_COMP_LOAD_ON_CNTR_ZERO = 0,
+	EPWM_COMP_LOAD_ON_CNTR_PERIOD = 1,
+	EPWM_COMP_LOAD_ON_CNTR_ZERO_PERIOD = 2,
+	EPWM_COMP_LOAD_FREEZE = 3,
+	EPWM_COMP_LOAD_ON_SYNC_CNTR_ZERO = 4,
+	EPWM_COMP_LOAD_ON_SYNC_CNTR_PERIOD = 5,
+	EPWM_COMP_LOAD_ON_SYNC_CNTR_ZERO_PERIOD = 6,
+	EPWM_COMP_LOAD_ON_SYNC_ONLY = 8
+} EPWM_CounterCompareLoadMode;
+
+typedef enum
+{
+	EPWM_COUNTER_COMPARE_A = 0,
+	EPWM_COUNTER_COMPARE_B = 2,
+	EPWM_COUNTER_COMPARE_C = 5,
+	EPWM_COUNTER_COMPARE_D = 7
+} EPWM_CounterCompareModule;
+
+typedef enum
+{
+	EPWM_DB_COUNTER_CLOCK_FULL_CYCLE = 0,
+	EPWM_DB_COUNTER_CLOCK_HALF_CYCLE = 1
+} EPWM_DeadBandClockMode;
+
+typedef enum
+{
+	EPWM_DB_LOAD_ON_CNTR_ZERO        = 0,
+	EPWM_DB_LOAD_ON_CNTR_PERIOD      = 1,
+	EPWM_DB_LOAD_ON_CNTR_ZERO_PERIOD = 2,
+	EPWM_DB_LOAD_FREEZE = 3
+} EPWM_DeadBandControlLoadMode;
+
+typedef enum
+{
+	EPWM_DB_RED = 1,
+	EPWM_DB_FED = 0
+} EPWM_DeadBandDelayMode;
+
+typedef enum
+{
+	EPWM_DB_OUTPUT_A = 1,
+	EPWM_DB_OUTPUT_B = 0
+} EPWM_DeadBandOutput;
+
+typedef enum
+{
+	EPWM_DB_POLARITY_ACTIVE_HIGH = 0,
+	EPWM_DB_POLARITY_ACTIVE_LOW  = 1
+} EPWM_DeadBandPolarity;
+
+typedef enum
+{
+	EPWM_HSCLOCK_DIVIDER_1 = 0,
+	EPWM_HSCLOCK_DIVIDER_2 = 1,
+	EPWM_HSCLOCK_DIVIDER_4 = 2,
+	EPWM_HSCLOCK_DIVIDER_6 = 3,
+	EPWM_HSCLOCK_DIVIDER_8 = 4,
+	EPWM_HSCLOCK_DIVIDER_10 = 5,
+	EPWM_HSCLOCK_DIVIDER_12 = 6,
+	EPWM_HSCLOCK_DIVIDER_14 = 7
+} EPWM_HSClockDivider;
+
+typedef enum
+{
+	EPWM_SHADOW_LOAD_MODE_COUNTER_ZERO = 0,
+	EPWM_SHADOW_LOAD_MODE_COUNTER_SYNC = 1,
+	EPWM_SHADOW_LOAD_MODE_SYNC         = 2
+} EPWM_PeriodShadowLoadMode;
+
+typedef enum
+{
+	EPWM_COUNT_MODE_DOWN_AFTER_SYNC = 0,
+	EPWM_COUNT_MODE_UP_AFTER_SYNC = 1
+} EPWM_SyncCountMode;
+
+typedef enum
+{
+	EPWM_SYNC_OUT_PULSE_ON_SOFTWARE  = 0,
+	EPWM_SYNC_OUT_PULSE_ON_EPWMxSYNCIN = 0,
+	EPWM_SYNC_OUT_PULSE_ON_COUNTER_ZERO = 1,
+	EPWM_SYNC_OUT_PULSE_ON_COUNTER_COMPARE_B = 2,
+	EPWM_SYNC_OUT_PULSE_DISABLED = 4,
+	EPWM_SYNC_OUT_PULSE_ON_COUNTER_COMPARE_C = 5,
+	EPWM_SYNC_OUT_PULSE_ON_COUNTER_COMPARE_D = 6
+} EPWM_SyncOutPulseMode;
+
+typedef enum
+{
+	EPWM_COUNTER_MODE_UP = 0,
+	EPWM_COUNTER_MODE_DOWN = 1,
+	EPWM_COUNTER_MODE_UP_DOWN = 2,
+	EPWM_COUNTER_MODE_STOP_FREEZE = 3
+} EPWM_TimeBaseCountMode;
+
+typedef enum
+{
+	EPWM_TZ_ACTION_HIGH_Z  = 0,
+	EPWM_TZ_ACTION_HIGH    = 1,
+	EPWM_TZ_ACTION_LOW     = 2,
+	EPWM_TZ_ACTION_DISABLE = 3
+} EPWM_TripZoneAction;
+
+typedef enum
+{
+	EPWM_TZ_ACTION_EVENT_TZA = 0,
+	EPWM_TZ_ACTION_EVENT_TZB = 2,
+	EPWM_TZ_ACTION_EVENT_DCAEVT1 = 4,
+	EPWM_TZ_ACTION_EVENT_DCAEVT2 = 6,
+	EPWM_TZ_ACTION_EVENT_DCBEVT1 = 8,
+	EPWM_TZ_ACTION_EVENT_DCBEVT2 = 10
+} EPWM_TripZoneEvent;
+
+typedef enum
+{
+	XBAR_INPUT1,
+	XBAR_INPUT2,
+	XBAR_INPUT3,
+	XBAR_INPUT4,
+	XBAR_INPUT5,
+	XBAR_INPUT6,
+	XBAR_INPUT7,
+	XBAR_INPUT8,
+	XBAR_INPUT9,
+	XBAR_INPUT10,
+	XBAR_INPUT11,
+	XBAR_INPUT12,
+	XBAR_INPUT13,
+	XBAR_INPUT14
+} XBAR_InputNum;
+
+void EPWM_setTimeBaseCounter(uint32_t base, uint16_t count);
+void EPWM_setCountModeAfterSync(uint32_t base, EPWM_SyncCountMode mode);
+void EPWM_setClockPrescaler(uint32_t base, EPWM_ClockDivider prescaler, EPWM_HSClockDivider highSpeedPrescaler);
+void EPWM_setSyncOutPulseMode(uint32_t base, EPWM_SyncOutPulseMode mode);
+void EPWM_enablePhaseShiftLoad(uint32_t base);
+void EPWM_disablePhaseShiftLoad(uint32_t base);
+void EPWM_setTimeBaseCounterMode(uint32_t base, EPWM_TimeBaseCountMode counterMode);
+void EPWM_selectPeriodLoadEvent(uint32_t base, EPWM_PeriodShadowLoadMode shadowLoadMode);
+void EPWM_setPhaseShift(uint32_t base, uint16_t phaseCount);
+void EPWM_setTimeBasePeriod(uint32_t base, uint16_t periodCount);
+void EPWM_setCounterCompareShadowLoadMode(uint32_t base, EPWM_CounterCompareModule compModule, EPWM_CounterCompareLoadMode loadMode);
+void EPWM_setCounterCompareValue(uint32_t base, EPWM_CounterCompareModule compModule, uint16_t compCount);
+void EPWM_setActionQualifierAction(uint32_t base, EPWM_ActionQualifierOutputModule epwmOutput, EPWM_ActionQualifierOutput output, EPWM_ActionQualifierOutputEvent event);
+void EPWM_setActionQualifierContSWForceShadowMode(uint32_t base, EPWM_ActionQualifierContForce mode);
+void EPWM_setDeadBandOutputSwapMode(uint32_t base, EPWM_DeadBandOutput output, bool enableSwapMode);
+void EPWM_setDeadBandDelayMode(uint32_t base, EPWM_DeadBandDelayMode delayMode, bool enableDelayMode);
+void EPWM_setDeadBandDelayPolarity(uint32_t base, EPWM_DeadBandDelayMode delayMode, EPWM_DeadBandPolarity polarity);
+void EPWM_setRisingEdgeDeadBandDelayInput(uint32_t base, uint16_t input);
+void EPWM_setFallingEdgeDeadBandDelayInput(uint32_t base, uint16_t input);
+void EPWM_setDeadBandControlShadowLoadMode(uint32_t base, EPWM_DeadBandControlLoadMode loadMode);
+void EPWM_setDeadBandCounterClock(uint32_t base, EPWM_DeadBandClockMode clockMode);
+void EPWM_setRisingEdgeDelayCount(uint32_t base, uint16_t redCount);
+void EPWM_setFallingEdgeDelayCount(uint32_t base, uint16_t fedCount);
+void EPWM_enableTripZoneSignals(uint32_t base, uint16_t tzSignal);
+void EPWM_setTripZoneAction(uint32_t base, EPWM_TripZoneEvent tzEvent, EPWM_TripZoneAction tzAction);
+void EPWM_enableTripZoneInterrupt(uint32_t base, uint16_t tzInterrupt);
+void EPWM_disableTripZoneInterrupt(uint32_t base, uint16_t tzInterrupt);
+void EPWM_clearTripZoneFlag(uint32_t base, uint16_t tzFlags);
+void EPWM_clearOneShotTripZoneFlag(uint32_t base, uint16_t tzOSTFlags);
+void EPWM_forceTripZoneEvent(uint32_t base, uint16_t tzForceEvent);
+void EPWM_enableInterrupt(uint32_t base);
+void EPWM_disableInterrupt(uint32_t base);
+void EPWM_setInterruptSource(uint32_t base, uint16_t interruptSource);
+void EPWM_setInterruptEventCount(uint32_t base, uint16_t eventCount);
+void EPWM_clearEventTriggerInterruptFlag(uint32_t base);
+void EPWM_enableADCTrigger(uint32_t base, EPWM_ADCStartOfConversionType adcSOCType);
+void EPWM_setADCTriggerSource(uint32_t base, EPWM_ADCStartOfConversionType adcSOCType, EPWM_ADCStartOfConversionSource socSource);
+void EPWM_setADCTriggerEventPrescale(uint32_t base, EPWM_ADCStartOfConversionType adcSOCType, uint16_t preScaleCount);
+
+void XBAR_setInputPin(XBAR_InputNum input, uint16_t pin);
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Simulated ePWM modules. Time-base counter runs while TBCLKSYNC is enabled,
+ * event-trigger interrupt is raised on counter zero and period events.
+ * Compare-based interrupt sources, action qualifier and dead-band are stored but not modeled.
+ */
+class Epwm
+{
+private:
+	Epwm();					// no constructor
+	Epwm(const Epwm& other);		// no copy constructor
+	Epwm& operator=(const Epwm& other);	// no copy assignment operator
+public:
+	static bool running(uint32_t base);
+	static uint16_t period(uint32_t base);
+	static uint16_t compareValue(uint32_t base, EPWM_CounterCompareModule compModule);
+	static bool tripped(uint32_t base);
+	static uint32_t interruptCount(uint32_t base);
+};
+
+
+/// @}
+} // namespace sim
+
+
@@ -0,0 +1,99 @@
+/**
+ * @file sim_gpio.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "driverlib.h"
+
+
+namespace {
+
+
+struct Pin
+{
+	uint32_t state;
+	bool output;
+	uint32_t toggles;
+	GPIO_CoreSelect core;
+};
+
+
+struct ExternalInterrupt
+{
+	uint32_t pin;
+	GPIO_IntType type;
+	bool enabled;
+};
+
+
+Pin pins[sim::Gpio::pinCount];
+ExternalInterrupt xints[5] = {
+	{0, GPIO_INT_TYPE_FALLING_EDGE, false},
+	{0, GPIO_INT_TYPE_FALLING_EDGE, false},
+	{0, GPIO_INT_TYPE_FALLING_EDGE, false},
+	{0, GPIO_INT_TYPE_FALLING_EDGE, false},
+	{0, GPIO_INT_TYPE_FALLING_EDGE, false}
+};
+const uint32_t xintNums[5] = {INT_XINT1, INT_XINT2, INT_XINT3, INT_XINT4, INT_XINT5};
+
+
+void setState(uint32_t pin, uint32_t state)
+{
+	uint32_t prev = pins[pin].state;
+	pins[pin].state = state & 1;
+	if (prev == pins[pin].state) return;
+
+	++pins[pin].toggles;
+	bool rising = (pins[pin].state == 1);
+	for (size_t i = 0; i < 5; ++i)
+	{
+		if (!xints[i].enabled || xints[i].pin != pin) continue;
+		if ((xints[i].type == GPIO_INT_TYPE_BOTH_EDGES)
+				|| (rising && xints[i].type == GPIO_INT_TYPE_RISING_EDGE)
+				|| (!rising && xints[i].type == GPIO_INT_TYPE_FALLING_EDGE))
+		{
+			sim::Interrupts::raise(xintNums[i]);
+		}
+	}
+}
+
+
+} // namespace
+
+
+void GPIO_setInterruptType(GPIO_ExternalIntNum extIntNum, GPIO_IntType intType) { xints[extIntNum].type = intType; }
+void GPIO_enableInterrupt(GPIO_ExternalIntNum extIntNum) { xints[extIntNum].enabled = true; }
+void GPIO_disableInterrupt(GPIO_ExternalIntNum extIntNum) { xints[extIntNum].enabled = false; }
+uint32_t GPIO_readPin(uint32_t pin) { return pins[pin].state; }
+void GPIO_writePin(uint32_t pin, uint32_t outVal) { setState(pin, outVal); }
+void GPIO_togglePin(uint32_t pin) { setState(pin, pins[pin].state ^ 1); }
+void GPIO_setDirectionMode(uint32_t pin, GPIO_Direction pinIO) { pins[pin].output = (pinIO == GPIO_DIR_MODE_OUT); }
+void GPIO_setInterruptPin(uint32_t pin, GPIO_ExternalIntNum extIntNum) { xints[extIntNum].pin = pin; }
+void GPIO_setPadConfig(uint32_t pin, uint32_t pinType) {}
+void GPIO_setQualificationMode(uint32_t pin, GPIO_QualificationMode qualification) {}
+void GPIO_setQualificationPeriod(uint32_t pin, uint32_t divider) {}
+void GPIO_setMasterCore(uint32_t pin, GPIO_CoreSelect core) { pins[pin].core = core; }
+void GPIO_setPinConfig(uint32_t pinConfig) {}
+
+
+namespace sim {
+
+
+void Gpio::drive(uint32_t pin, uint32_t state) { setState(pin, state); }
+uint32_t Gpio::state(uint32_t pin) { return pins[pin].state; }
+bool Gpio::output(uint32_t pin) { return pins[pin].output; }
+uint32_t Gpio::toggleCount(uint32_t pin) { return pins[pin].toggles; }
+GPIO_CoreSelect Gpio::masterCore(uint32_t pin) { return pins[pin].core; }
+
+
+} // namespace sim
+
+
@@ -0,0 +1,116 @@
+/**
+ * @file sim_gpio.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated GPIO with driverlib GPIO API.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+#define GPIO_PIN_TYPE_STD 0x0000U
+#define GPIO_PIN_TYPE_PULLUP 0x0001U
+#define GPIO_PIN_TYPE_INVERT 0x0002U
+#define GPIO_PIN_TYPE_OD 0x0004U
+
+typedef enum
+{
+	GPIO_DIR_MODE_IN,
+	GPIO_DIR_MODE_OUT
+} GPIO_Direction;
+
+typedef enum
+{
+	GPIO_INT_TYPE_FALLING_EDGE = 0x00,
+	GPIO_INT_TYPE_RISING_EDGE  = 0x04,
+	GPIO_INT_TYPE_BOTH_EDGES   = 0x0C
+} GPIO_IntType;
+
+typedef enum
+{
+	GPIO_QUAL_SYNC,
+	GPIO_QUAL_3SAMPLE,
+	GPIO_QUAL_6SAMPLE,
+	GPIO_QUAL_ASYNC
+} GPIO_QualificationMode;
+
+typedef enum
+{
+	GPIO_CORE_CPU1,
+	GPIO_CORE_CPU1_CLA1,
+	GPIO_CORE_CPU2,
+	GPIO_CORE_CPU2_CLA1
+} GPIO_CoreSelect;
+
+typedef enum
+{
+	GPIO_INT_XINT1,
+	GPIO_INT_XINT2,
+	GPIO_INT_XINT3,
+	GPIO_INT_XINT4,
+	GPIO_INT_XINT5
+} GPIO_ExternalIntNum;
+
+
+void GPIO_setInterruptType(GPIO_ExternalIntNum extIntNum, GPIO_IntType intType);
+void GPIO_enableInterrupt(GPIO_ExternalIntNum extIntNum);
+void GPIO_disableInterrupt(GPIO_ExternalIntNum extIntNum);
+uint32_t GPIO_readPin(uint32_t pin);
+void GPIO_writePin(uint32_t pin, uint32_t outVal);
+void GPIO_togglePin(uint32_t pin);
+void GPIO_setDirectionMode(uint32_t pin, GPIO_Direction pinIO);
+void GPIO_setInterruptPin(uint32_t pin, GPIO_ExternalIntNum extIntNum);
+void GPIO_setPadConfig(uint32_t pin, uint32_t pinType);
+void GPIO_setQualificationMode(uint32_t pin, GPIO_QualificationMode qualification);
+void GPIO_setQualificationPeriod(uint32_t pin, uint32_t divider);
+void GPIO_setMasterCore(uint32_t pin, GPIO_CoreSelect core);
+void GPIO_setPinConfig(uint32_t pinConfig);
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Simulated GPIO pins. Output pins keep written state, input pins are driven by test.
+ * Edge on pin selected by GPIO_setInterruptPin() raises XINT interrupt if enabled.
+ */
+class Gpio
+{
+private:
+	Gpio();					// no constructor
+	Gpio(const Gpio& other);		// no copy constructor
+	Gpio& operator=(const Gpio& other);	// no copy assignment operator
+public:
+	static const uint32_t pinCount = 169;
+
+	/**
+	 * @brief Drives input pin.
+	 * @param pin - pin number
+	 * @param state - pin state
+	 * @return (none)
+	 */
+	static void drive(uint32_t pin, uint32_t state);
+
+	static uint32_t state(uint32_t pin);
+	static bool output(uint32_t pin);
+	static uint32_t toggleCount(uint32_t pin);
+	static GPIO_CoreSelect masterCore(uint32_t pin);
+};
+
+
+/// @}
+} // namespace sim
+
+
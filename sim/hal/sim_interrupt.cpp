@@ -0,0 +1,212 @@
+/**
+ * @file sim_interrupt.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "sim_interrupt.h"
+
+#include <map>
+
+
+namespace sim {
+
+
+namespace {
+
+
+struct Vector
+{
+	void (*handler)();
+	bool enabled;
+	bool pending;
+	uint32_t served;
+
+	Vector() : handler(NULL), enabled(false), pending(false), served(0) {}
+};
+
+
+std::map<uint32_t, Vector> vectors;
+bool intm = true;
+bool serving = false;
+
+
+void serve(Vector& vector)
+{
+	vector.pending = false;
+	++vector.served;
+	if (vector.handler == NULL) return;
+
+	intm = true;			// ISR entry sets INTM
+	serving = true;
+	vector.handler();
+	serving = false;
+	intm = false;
+}
+
+
+} // namespace
+
+
+///
+///
+///
+void Interrupts::raise(uint32_t interruptNumber)
+{
+	Vector& vector = vectors[interruptNumber];
+	vector.pending = true;
+	if (!intm && vector.enabled)
+	{
+		serve(vector);
+		servePending();		// interrupts raised by ISR
+	}
+}
+
+
+///
+///
+///
+void Interrupts::servePending()
+{
+	if (serving) return;
+
+	bool served = true;
+	while (!intm && served)		// ISR may raise other interrupts
+	{
+		served = false;
+		for (std::map<uint32_t, Vector>::iterator it = vectors.begin(); it != vectors.end(); ++it)
+		{
+			if (it->second.pending && it->second.enabled)
+			{
+				serve(it->second);
+				served = true;
+				break;
+			}
+		}
+	}
+}
+
+
+bool Interrupts::masked() { return intm; }
+bool Interrupts::enabled(uint32_t interruptNumber) { return vectors[interruptNumber].enabled; }
+bool Interrupts::pending(uint32_t interruptNumber) { return vectors[interruptNumber].pending; }
+uint32_t Interrupts::servedCount(uint32_t interruptNumber) { return vectors[interruptNumber].served; }
+
+
+///
+///
+///
+void Interrupts::reset()
+{
+	vectors.clear();
+	intm = true;
+	serving = false;
+}
+
+
+} // namespace sim
+
+
+/*####################################################################################################################*/
+
+
+///
+///
+///
+uint16_t __disable_interrupts()
+{
+	uint16_t status = sim::intm ? 1 : 0;
+	sim::intm = true;
+	return status;
+}
+
+
+///
+///
+///
+uint16_t __enable_interrupts()
+{
+	uint16_t status = sim::intm ? 1 : 0;
+	sim::intm = false;
+	sim::Interrupts::servePending();
+	return status;
+}
+
+
+///
+///
+///
+void __restore_interrupts(uint16_t intStatus)
+{
+	sim::intm = (intStatus != 0);
+	sim::Interrupts::servePending();
+}
+
+
+/*####################################################################################################################*/
+
+
+void Interrupt_initModule()
+{
+	for (std::map<uint32_t, sim::Vector>::iterator it = sim::vectors.begin(); it != sim::vectors.end(); ++it)
+	{
+		it->second.enabled = false;
+		it->second.pending = false;
+	}
+	sim::intm = true;
+}
+
+
+void Interrupt_initVectorTable()
+{
+	for (std::map<uint32_t, sim::Vector>::iterator it = sim::vectors.begin(); it != sim::vectors.end(); ++it)
+	{
+		it->second.handler = NULL;
+	}
+}
+
+
+void Interrupt_register(uint32_t interruptNumber, void (*handler)(void))
+{
+	sim::vectors[interruptNumber].handler = handler;
+}
+
+
+void Interrupt_unregister(uint32_t interruptNumber)
+{
+	sim::vectors[interruptNumber].handler = NULL;
+}
+
+
+void Interrupt_enable(uint32_t interruptNumber)
+{
+	sim::vectors[interruptNumber].enabled = true;
+	sim::Interrupts::servePending();
+}
+
+
+void Interrupt_disable(uint32_t interruptNumber)
+{
+	sim::vectors[interruptNumber].enabled = false;
+}
+
+
+bool Interrupt_enableMaster()
+{
+	return __enable_interrupts() != 0;
+}
+
+
+bool Interrupt_disableMaster()
+{
+	return __disable_interrupts() != 0;
+}
+
+
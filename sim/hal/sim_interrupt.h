@@ -0,0 +1,96 @@
+/**
+ * @file sim_interrupt.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated PIE and CPU interrupt control with driverlib interrupt API.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "sim_c28x.h"
+
+
+#define INTERRUPT_ACK_GROUP1	0x1U
+#define INTERRUPT_ACK_GROUP2	0x2U
+#define INTERRUPT_ACK_GROUP3	0x4U
+#define INTERRUPT_ACK_GROUP4	0x8U
+#define INTERRUPT_ACK_GROUP5	0x10U
+#define INTERRUPT_ACK_GROUP6	0x20U
+#define INTERRUPT_ACK_GROUP7	0x40U
+#define INTERRUPT_ACK_GROUP8	0x80U
+#define INTERRUPT_ACK_GROUP9	0x100U
+#define INTERRUPT_ACK_GROUP10	0x200U
+#define INTERRUPT_ACK_GROUP11	0x400U
+#define INTERRUPT_ACK_GROUP12	0x800U
+
+
+void Interrupt_initModule();
+void Interrupt_initVectorTable();
+void Interrupt_register(uint32_t interruptNumber, void (*handler)(void));
+void Interrupt_unregister(uint32_t interruptNumber);
+void Interrupt_enable(uint32_t interruptNumber);
+void Interrupt_disable(uint32_t interruptNumber);
+inline void Interrupt_clearACKGroup(uint16_t group) {}
+bool Interrupt_enableMaster();
+bool Interrupt_disableMaster();
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Simulated interrupt controller. Interrupts are raised by peripheral models in simulation thread:
+ * enabled interrupt is served immediately if INTM is clear, otherwise it stays pending
+ * until interrupts are enabled. ISR runs with INTM set, ISRs do not nest.
+ */
+class Interrupts
+{
+private:
+	Interrupts();					// no constructor
+	Interrupts(const Interrupts& other);		// no copy constructor
+	Interrupts& operator=(const Interrupts& other);	// no copy assignment operator
+public:
+	/**
+	 * @brief Raises interrupt.
+	 * @param interruptNumber - driverlib interrupt number, e.g. INT_TIMER0
+	 * @return (none)
+	 */
+	static void raise(uint32_t interruptNumber);
+
+	/**
+	 * @brief Serves pending enabled interrupts if INTM is clear.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void servePending();
+
+	static bool masked();
+	static bool enabled(uint32_t interruptNumber);
+	static bool pending(uint32_t interruptNumber);
+	static uint32_t servedCount(uint32_t interruptNumber);
+
+	/**
+	 * @brief Resets interrupt controller: vector table is cleared, interrupts are disabled and masked.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void reset();
+};
+
+
+/// @}
+} // namespace sim
+
+
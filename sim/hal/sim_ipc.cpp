@@ -0,0 +1,40 @@
+/**
+ * @file sim_ipc.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "F2837xD_Ipc_drivers.h"
+
+
+namespace {
+uint32_t localToRemote = 0;
+uint32_t remoteToLocal = 0;
+} // namespace
+
+
+void IPCLtoRFlagSet(uint32_t ulFlags) { localToRemote |= ulFlags; }
+void IPCLtoRFlagClear(uint32_t ulFlags) { localToRemote &= ~ulFlags; }
+uint16_t IPCLtoRFlagBusy(uint32_t ulFlags) { return (localToRemote & ulFlags) != 0; }
+uint16_t IPCRtoLFlagBusy(uint32_t ulFlags) { return (remoteToLocal & ulFlags) != 0; }
+void IPCRtoLFlagAcknowledge(uint32_t ulFlags) { remoteToLocal &= ~ulFlags; }
+
+
+namespace sim {
+
+
+void Ipc::setRemoteFlags(uint32_t flags) { remoteToLocal |= flags; }
+uint32_t Ipc::localFlags() { return localToRemote; }
+void Ipc::acknowledgeLocalFlags(uint32_t flags) { localToRemote &= ~flags; }
+
+
+} // namespace sim
+
+
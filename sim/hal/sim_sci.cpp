@@ -0,0 +1,387 @@
+/**
+ * @file sim_sci.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "driverlib.h"
+#include "device.h"
+
+#include <algorithm>
+#include <deque>
+#include <cstring>
+
+
+namespace {
+
+
+struct Module
+{
+	uint32_t base;
+	uint32_t rxIntNum;
+	uint32_t txIntNum;
+	uint32_t baudrate;
+	bool enabled;
+	uint32_t intEnabled;
+	uint32_t intFlags;
+	SCI_RxFIFOLevel rxLevel;
+	SCI_TxFIFOLevel txLevel;
+	std::deque<uint16_t> rxFifo;
+	std::deque<uint16_t> rxBacklog;		// chars on line
+	std::string output;
+	void (*sink)(char ch);
+	uint64_t txCount;
+	uint64_t rxCount;
+
+	bool paced;
+	std::deque<uint16_t> txFifo;
+	uint64_t rxRemaining;		// cycles until the first line char is received
+	uint64_t txRemaining;		// cycles until the first TX FIFO char is transmitted
+	bool overflow;
+	uint64_t rxOverruns;
+};
+
+
+Module modules[4] = {
+	{SCIA_BASE, INT_SCIA_RX, INT_SCIA_TX, 0, false, 0, 0, SCI_FIFO_RX0, SCI_FIFO_TX0},
+	{SCIB_BASE, INT_SCIB_RX, INT_SCIB_TX, 0, false, 0, 0, SCI_FIFO_RX0, SCI_FIFO_TX0},
+	{SCIC_BASE, INT_SCIC_RX, INT_SCIC_TX, 0, false, 0, 0, SCI_FIFO_RX0, SCI_FIFO_TX0},
+	{SCID_BASE, INT_SCID_RX, INT_SCID_TX, 0, false, 0, 0, SCI_FIFO_RX0, SCI_FIFO_TX0}
+};
+
+
+Module& module(uint32_t base)
+{
+	for (size_t i = 0; i < 3; ++i)
+	{
+		if (modules[i].base == base) return modules[i];
+	}
+	return modules[3];
+}
+
+
+/// Character frame: start bit, 8 data bits, stop bit.
+uint64_t charCycles(const Module& m)
+{
+	return static_cast<uint64_t>(DEVICE_SYSCLK_FREQ) * 10 / ((m.baudrate != 0) ? m.baudrate : 9600);
+}
+
+
+/// Sets RXFF flag and raises interrupt when FIFO level reaches interrupt level.
+void updateRxInterrupt(Module& m)
+{
+	if ((m.intFlags & SCI_INT_RXFF) != 0) return;
+	if (m.rxFifo.size() < static_cast<size_t>(m.rxLevel) || m.rxFifo.empty()) return;
+
+	m.intFlags |= SCI_INT_RXFF;
+	if ((m.intEnabled & SCI_INT_RXFF) != 0)
+	{
+		sim::Interrupts::raise(m.rxIntNum);
+	}
+}
+
+
+/// Sets TXFF flag and raises interrupt when FIFO level is at or below interrupt level.
+void updateTxInterrupt(Module& m)
+{
+	if ((m.intFlags & SCI_INT_TXFF) != 0) return;
+	if (m.txFifo.size() > static_cast<size_t>(m.txLevel)) return;
+
+	m.intFlags |= SCI_INT_TXFF;
+	if ((m.intEnabled & SCI_INT_TXFF) != 0)
+	{
+		sim::Interrupts::raise(m.txIntNum);
+	}
+}
+
+
+void fillRxFifo(Module& m)
+{
+	if (!m.enabled || m.paced) return;
+	while (!m.rxBacklog.empty() && m.rxFifo.size() < sim::Sci::fifoDepth)
+	{
+		m.rxFifo.push_back(m.rxBacklog.front());
+		m.rxBacklog.pop_front();
+	}
+	updateRxInterrupt(m);
+}
+
+
+void transmit(Module& m, uint16_t data)
+{
+	char ch = static_cast<char>(data & 0xFF);
+	++m.txCount;
+	m.output.push_back(ch);
+	if (m.sink != NULL)
+	{
+		m.sink(ch);
+	}
+}
+
+
+void write(Module& m, uint16_t data)
+{
+	if (!m.paced)
+	{
+		transmit(m, data);
+		return;
+	}
+	if (m.txFifo.size() >= sim::Sci::fifoDepth) return;	// char is lost as on target
+	if (m.txFifo.empty())
+	{
+		m.txRemaining = charCycles(m);
+	}
+	m.txFifo.push_back(data);
+}
+
+
+void writeBlocking(Module& m, uint16_t data)
+{
+	while (m.paced && m.txFifo.size() >= sim::Sci::fifoDepth)
+	{
+		sim::VirtualTime::advance(m.txRemaining);	// firmware busy-waits until FIFO has room
+	}
+	write(m, data);
+}
+
+
+/**
+ * @brief Line timing of paced modules: one char per frame time in both directions.
+ */
+class Line : public sim::ITimedModel
+{
+public:
+	Line()
+	{
+		sim::VirtualTime::registerModel(this);
+	}
+
+	virtual uint64_t cyclesToNextEvent() const
+	{
+		uint64_t cycles = noEvent;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			const Module& m = modules[i];
+			if (!m.paced) continue;
+			if (m.enabled && !m.rxBacklog.empty()) cycles = std::min(cycles, m.rxRemaining);
+			if (!m.txFifo.empty()) cycles = std::min(cycles, m.txRemaining);
+		}
+		return cycles;
+	}
+
+	virtual void advance(uint64_t cycles)
+	{
+		for (size_t i = 0; i < 4; ++i)
+		{
+			Module& m = modules[i];
+			if (!m.paced) continue;
+			if (m.enabled && !m.rxBacklog.empty()) m.rxRemaining -= std::min(cycles, m.rxRemaining);
+			if (!m.txFifo.empty()) m.txRemaining -= std::min(cycles, m.txRemaining);
+		}
+	}
+
+	virtual void fireEvents()
+	{
+		for (size_t i = 0; i < 4; ++i)
+		{
+			Module& m = modules[i];
+			if (!m.paced) continue;
+			if (!m.txFifo.empty() && m.txRemaining == 0)
+			{
+				transmit(m, m.txFifo.front());
+				m.txFifo.pop_front();
+				m.txRemaining = charCycles(m);
+				updateTxInterrupt(m);
+			}
+			if (m.enabled && !m.rxBacklog.empty() && m.rxRemaining == 0)
+			{
+				uint16_t data = m.rxBacklog.front();
+				m.rxBacklog.pop_front();
+				m.rxRemaining = charCycles(m);
+				if (m.rxFifo.size() >= sim::Sci::fifoDepth)
+				{
+					m.overflow = true;
+					++m.rxOverruns;
+				}
+				else
+				{
+					m.rxFifo.push_back(data);
+					updateRxInterrupt(m);
+				}
+			}
+		}
+	}
+};
+
+
+Line line;
+
+
+} // namespace
+
+
+void SCI_lockAutobaud(uint32_t base) {}
+void SCI_enableFIFO(uint32_t base) {}
+void SCI_resetChannels(uint32_t base) { module(base).rxFifo.clear(); module(base).txFifo.clear(); }
+void SCI_resetRxFIFO(uint32_t base) { module(base).rxFifo.clear(); }
+void SCI_resetTxFIFO(uint32_t base) { module(base).txFifo.clear(); }
+void SCI_performSoftwareReset(uint32_t base) {}
+void SCI_disableModule(uint32_t base) { module(base).enabled = false; }
+SCI_TxFIFOLevel SCI_getTxFIFOStatus(uint32_t base) { return static_cast<SCI_TxFIFOLevel>(module(base).txFifo.size()); }
+SCI_RxFIFOLevel SCI_getRxFIFOStatus(uint32_t base) { return static_cast<SCI_RxFIFOLevel>(module(base).rxFifo.size()); }
+uint16_t SCI_getRxStatus(uint32_t base) { return 0; }
+bool SCI_getOverflowStatus(uint32_t base) { return module(base).overflow; }
+void SCI_clearOverflowStatus(uint32_t base) { module(base).overflow = false; }
+void SCI_disableInterrupt(uint32_t base, uint32_t intFlags) { module(base).intEnabled &= ~intFlags; }
+uint32_t SCI_getInterruptStatus(uint32_t base) { return module(base).intFlags; }
+
+
+void SCI_enableInterrupt(uint32_t base, uint32_t intFlags)
+{
+	Module& m = module(base);
+	uint32_t enabled = intFlags & ~m.intEnabled;
+	m.intEnabled |= intFlags;
+	// interrupt is requested if flag is already set, TXFF flag is set while TX FIFO level is low
+	updateTxInterrupt(m);
+	if ((enabled & m.intFlags & SCI_INT_RXFF) != 0)
+	{
+		sim::Interrupts::raise(m.rxIntNum);
+	}
+	if ((enabled & m.intFlags & SCI_INT_TXFF) != 0)
+	{
+		sim::Interrupts::raise(m.txIntNum);
+	}
+}
+
+
+void SCI_enableModule(uint32_t base)
+{
+	module(base).enabled = true;
+	fillRxFifo(module(base));
+}
+
+
+void SCI_setFIFOInterruptLevel(uint32_t base, SCI_TxFIFOLevel txLevel, SCI_RxFIFOLevel rxLevel)
+{
+	module(base).rxLevel = rxLevel;
+	module(base).txLevel = txLevel;
+}
+
+
+void SCI_setConfig(uint32_t base, uint32_t lspclkHz, uint32_t baud, uint32_t config)
+{
+	module(base).baudrate = baud;
+}
+
+
+void SCI_writeCharBlockingFIFO(uint32_t base, uint16_t data)
+{
+	writeBlocking(module(base), data);
+}
+
+
+void SCI_writeCharNonBlocking(uint32_t base, uint16_t data)
+{
+	write(module(base), data);
+}
+
+
+void SCI_writeCharArray(uint32_t base, const uint16_t* const array, uint16_t length)
+{
+	// firmware passes char buffer as uint16_t array: char is 16-bit on C28x, but 8-bit on host
+	const char* chars = reinterpret_cast<const char*>(array);
+	for (uint16_t i = 0; i < length; ++i)
+	{
+		writeBlocking(module(base), static_cast<uint8_t>(chars[i]));
+	}
+}
+
+
+uint16_t SCI_readCharNonBlocking(uint32_t base)
+{
+	Module& m = module(base);
+	if (m.rxFifo.empty()) return 0;
+	uint16_t data = m.rxFifo.front();
+	m.rxFifo.pop_front();
+	++m.rxCount;
+	fillRxFifo(m);
+	return data;
+}
+
+
+void SCI_clearInterruptStatus(uint32_t base, uint32_t intFlags)
+{
+	Module& m = module(base);
+	m.intFlags &= ~intFlags;
+	// flags are set again if FIFO levels are still at interrupt levels
+	updateRxInterrupt(m);
+	updateTxInterrupt(m);
+}
+
+
+namespace sim {
+
+
+void Sci::inject(uint32_t base, const char* data, size_t len)
+{
+	Module& m = module(base);
+	if (m.rxBacklog.empty())
+	{
+		m.rxRemaining = ::charCycles(m);
+	}
+	for (size_t i = 0; i < len; ++i)
+	{
+		m.rxBacklog.push_back(static_cast<uint16_t>(static_cast<unsigned char>(data[i])));
+	}
+	fillRxFifo(m);
+}
+
+
+void Sci::inject(uint32_t base, const char* str) { inject(base, str, strlen(str)); }
+void Sci::setTxSink(uint32_t base, void (*sink)(char ch)) { module(base).sink = sink; }
+uint32_t Sci::baudrate(uint32_t base) { return module(base).baudrate; }
+bool Sci::enabled(uint32_t base) { return module(base).enabled; }
+size_t Sci::rxFifoLevel(uint32_t base) { return module(base).rxFifo.size(); }
+size_t Sci::rxBacklog(uint32_t base) { return module(base).rxBacklog.size(); }
+uint64_t Sci::txCount(uint32_t base) { return module(base).txCount; }
+uint64_t Sci::rxCount(uint32_t base) { return module(base).rxCount; }
+size_t Sci::txFifoLevel(uint32_t base) { return module(base).txFifo.size(); }
+uint64_t Sci::rxOverruns(uint32_t base) { return module(base).rxOverruns; }
+uint64_t Sci::charCycles(uint32_t base) { return ::charCycles(module(base)); }
+
+
+void Sci::setPaced(uint32_t base, bool paced)
+{
+	Module& m = module(base);
+	m.paced = paced;
+	m.rxRemaining = ::charCycles(m);
+	if (!paced)
+	{
+		while (!m.txFifo.empty())
+		{
+			transmit(m, m.txFifo.front());
+			m.txFifo.pop_front();
+		}
+		fillRxFifo(m);
+	}
+}
+
+
+std::string Sci::takeOutput(uint32_t base)
+{
+	std::string output;
+	output.swap(module(base).output);
+	return output;
+}
+
+
+} // namespace sim
+
+
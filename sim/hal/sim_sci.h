@@ -0,0 +1,197 @@
+/**
+ * @file sim_sci.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated SCI with driverlib SCI API.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string>
+
+
+#define SCI_INT_RXERR 0x01U
+#define SCI_INT_RXRDY_BRKDT 0x02U
+#define SCI_INT_TXRDY 0x04U
+#define SCI_INT_TXFF 0x08U
+#define SCI_INT_RXFF 0x10U
+#define SCI_INT_FE 0x20U
+#define SCI_INT_OE 0x40U
+#define SCI_INT_PE 0x80U
+#define SCI_CONFIG_WLEN_MASK 0x0007U
+#define SCI_CONFIG_WLEN_8 0x0007U
+#define SCI_CONFIG_WLEN_7 0x0006U
+#define SCI_CONFIG_WLEN_6 0x0005U
+#define SCI_CONFIG_WLEN_5 0x0004U
+#define SCI_CONFIG_WLEN_4 0x0003U
+#define SCI_CONFIG_WLEN_3 0x0002U
+#define SCI_CONFIG_WLEN_2 0x0001U
+#define SCI_CONFIG_WLEN_1 0x0000U
+#define SCI_CONFIG_STOP_MASK 0x0080U
+#define SCI_CONFIG_STOP_ONE 0x0000U
+#define SCI_CONFIG_STOP_TWO 0x0080U
+#define SCI_CONFIG_PAR_MASK 0x0060U
+#define SCI_RXSTATUS_WAKE 0x0002U
+#define SCI_RXSTATUS_PARITY 0x0004U
+#define SCI_RXSTATUS_OVERRUN 0x0008U
+#define SCI_RXSTATUS_FRAMING 0x0010U
+#define SCI_RXSTATUS_BREAK 0x0020U
+#define SCI_RXSTATUS_READY 0x0040U
+#define SCI_RXSTATUS_ERROR 0x0080U
+
+typedef enum
+{
+	SCI_CONFIG_PAR_NONE = 0x0000U,
+	SCI_CONFIG_PAR_EVEN = 0x0060U,
+	SCI_CONFIG_PAR_ODD  = 0x0020U
+} SCI_ParityType;
+
+typedef enum
+{
+	SCI_FIFO_TX0  = 0x0000U,
+	SCI_FIFO_TX1  = 0x0001U,
+	SCI_FIFO_TX2  = 0x0002U,
+	SCI_FIFO_TX3  = 0x0003U,
+	SCI_FIFO_TX4  = 0x0004U,
+	SCI_FIFO_TX5  = 0x0005U,
+	SCI_FIFO_TX6  = 0x0006U,
+	SCI_FIFO_TX7  = 0x0007U,
+	SCI_FIFO_TX8  = 0x0008U,
+	SCI_FIFO_TX9  = 0x0009U,
+	SCI_FIFO_TX10 = 0x000AU,
+	SCI_FIFO_TX11 = 0x000BU,
+	SCI_FIFO_TX12 = 0x000CU,
+	SCI_FIFO_TX13 = 0x000DU,
+	SCI_FIFO_TX14 = 0x000EU,
+	SCI_FIFO_TX15 = 0x000FU,
+	SCI_FIFO_TX16 = 0x0010U
+} SCI_TxFIFOLevel;
+
+typedef enum
+{
+	SCI_FIFO_RX0  = 0x0000U,
+	SCI_FIFO_RX1  = 0x0001U,
+	SCI_FIFO_RX2  = 0x0002U,
+	SCI_FIFO_RX3  = 0x0003U,
+	SCI_FIFO_RX4  = 0x0004U,
+	SCI_FIFO_RX5  = 0x0005U,
+	SCI_FIFO_RX6  = 0x0006U,
+	SCI_FIFO_RX7  = 0x0007U,
+	SCI_FIFO_RX8  = 0x0008U,
+	SCI_FIFO_RX9  = 0x0009U,
+	SCI_FIFO_RX10 = 0x000AU,
+	SCI_FIFO_RX11 = 0x000BU,
+	SCI_FIFO_RX12 = 0x000CU,
+	SCI_FIFO_RX13 = 0x000DU,
+	SCI_FIFO_RX14 = 0x000EU,
+	SCI_FIFO_RX15 = 0x000FU,
+	SCI_FIFO_RX16 = 0x0010U
+} SCI_RxFIFOLevel;
+
+
+void SCI_lockAutobaud(uint32_t base);
+void SCI_setFIFOInterruptLevel(uint32_t base, SCI_TxFIFOLevel txLevel, SCI_RxFIFOLevel rxLevel);
+void SCI_enableModule(uint32_t base);
+void SCI_disableModule(uint32_t base);
+void SCI_enableFIFO(uint32_t base);
+void SCI_resetRxFIFO(uint32_t base);
+void SCI_resetTxFIFO(uint32_t base);
+void SCI_resetChannels(uint32_t base);
+SCI_TxFIFOLevel SCI_getTxFIFOStatus(uint32_t base);
+SCI_RxFIFOLevel SCI_getRxFIFOStatus(uint32_t base);
+void SCI_writeCharBlockingFIFO(uint32_t base, uint16_t data);
+void SCI_writeCharNonBlocking(uint32_t base, uint16_t data);
+uint16_t SCI_getRxStatus(uint32_t base);
+bool SCI_getOverflowStatus(uint32_t base);
+void SCI_clearOverflowStatus(uint32_t base);
+uint16_t SCI_readCharNonBlocking(uint32_t base);
+void SCI_performSoftwareReset(uint32_t base);
+void SCI_setConfig(uint32_t base, uint32_t lspclkHz, uint32_t baud, uint32_t config);
+void SCI_writeCharArray(uint32_t base, const uint16_t* const array, uint16_t length);
+void SCI_enableInterrupt(uint32_t base, uint32_t intFlags);
+void SCI_disableInterrupt(uint32_t base, uint32_t intFlags);
+uint32_t SCI_getInterruptStatus(uint32_t base);
+void SCI_clearInterruptStatus(uint32_t base, uint32_t intFlags);
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Simulated SCI modules. By default line side is instant: transmitted characters leave TX FIFO immediately,
+ * received characters are moved from host backlog to 16-level RX FIFO as soon as there is space.
+ * Paced module (see setPaced()) transmits and receives one character per frame time (8N1) in virtual time:
+ * TX FIFO holds 16 characters, character received when RX FIFO is full is lost and sets FIFO overflow flag.
+ * RX FIFO interrupt flag is set when FIFO level reaches configured level, TX FIFO interrupt flag is set
+ * while FIFO level is at or below configured level, as on target.
+ */
+class Sci
+{
+private:
+	Sci();					// no constructor
+	Sci(const Sci& other);			// no copy constructor
+	Sci& operator=(const Sci& other);	// no copy assignment operator
+public:
+	static const size_t fifoDepth = 16;
+
+	/**
+	 * @brief Sends characters to SCI receiver.
+	 * @param base - SCI base address
+	 * @param data - characters
+	 * @param len - number of characters
+	 * @return (none)
+	 */
+	static void inject(uint32_t base, const char* data, size_t len);
+	static void inject(uint32_t base, const char* str);
+
+	/**
+	 * @brief Sets callback called for every transmitted character (e.g. to print it to stdout).
+	 * @param base - SCI base address
+	 * @param sink - callback, NULL to disable
+	 * @return (none)
+	 */
+	static void setTxSink(uint32_t base, void (*sink)(char ch));
+
+	/**
+	 * @brief Enables or disables line timing of SCI module.
+	 * @param base - SCI base address
+	 * @param paced - \c true to transmit and receive at baudrate, \c false for instant line
+	 * @return (none)
+	 */
+	static void setPaced(uint32_t base, bool paced);
+
+	/**
+	 * @brief Returns transmitted characters collected since last call and clears collected output.
+	 * @param base - SCI base address
+	 * @return Transmitted characters.
+	 */
+	static std::string takeOutput(uint32_t base);
+
+	static uint32_t baudrate(uint32_t base);
+	static bool enabled(uint32_t base);
+	static size_t rxFifoLevel(uint32_t base);
+	static size_t rxBacklog(uint32_t base);
+	static uint64_t txCount(uint32_t base);
+	static uint64_t rxCount(uint32_t base);
+	static size_t txFifoLevel(uint32_t base);
+	static uint64_t rxOverruns(uint32_t base);	// chars lost because RX FIFO was full (paced module)
+	static uint64_t charCycles(uint32_t base);	// SYSCLK cycles per character frame
+};
+
+
+/// @}
+} // namespace sim
+
+
@@ -0,0 +1,68 @@
+/**
+ * @file sim_sysctl.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "driverlib.h"
+
+
+namespace sim {
+uint32_t Device::_resetRequests = 0;
+} // namespace sim
+
+
+///
+///
+///
+void SysCtl_delay(uint32_t count)
+{
+	sim::VirtualTime::advance(5 * static_cast<uint64_t>(count) + 9);
+}
+
+
+///
+///
+///
+void SysCtl_resetDevice()
+{
+	sim::Device::requestReset();
+}
+
+
+///
+///
+///
+void SysCtl_enablePeripheral(SysCtl_PeripheralPCLOCKCR peripheral)
+{
+	if (peripheral == SYSCTL_PERIPH_CLK_TBCLKSYNC)
+	{
+		sim::setTbclkSync(true);
+	}
+}
+
+
+///
+///
+///
+void SysCtl_disablePeripheral(SysCtl_PeripheralPCLOCKCR peripheral)
+{
+	if (peripheral == SYSCTL_PERIPH_CLK_TBCLKSYNC)
+	{
+		sim::setTbclkSync(false);
+	}
+}
+
+
+void SysCtl_selectCPUForPeripheral(SysCtl_CPUSelPeripheral peripheral, uint16_t peripheralInst, SysCtl_CPUSel cpuInst) {}
+void SysCtl_setSyncInputConfig(SysCtl_SyncInput syncInput, SysCtl_SyncInputSource syncSrc) {}
+void MemCfg_setGSRAMMasterSel(uint32_t ramSections, MemCfg_GSRAMMasterSel masterSel) {}
+
+
@@ -0,0 +1,223 @@
+/**
+ * @file sim_sysctl.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Simulated system control: delays advance virtual time.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+typedef enum
+{
+	SYSCTL_CPUSEL0_EPWM      = 0x0U,
+	SYSCTL_CPUSEL1_ECAP      = 0x1U,
+	SYSCTL_CPUSEL2_EQEP      = 0x2U,
+	SYSCTL_CPUSEL4_SD        = 0x4U,
+	SYSCTL_CPUSEL5_SCI       = 0x5U,
+	SYSCTL_CPUSEL6_SPI       = 0x6U,
+	SYSCTL_CPUSEL7_I2C       = 0x7U,
+	SYSCTL_CPUSEL8_CAN       = 0x8U,
+	SYSCTL_CPUSEL9_MCBSP     = 0x9U,
+	SYSCTL_CPUSEL11_ADC      = 0xBU,
+	SYSCTL_CPUSEL12_CMPSS    = 0xCU,
+	SYSCTL_CPUSEL14_DAC      = 0xEU
+} SysCtl_CPUSelPeripheral;
+
+typedef enum
+{
+	SYSCTL_CPUSEL_CPU1 = 0x0U,
+	SYSCTL_CPUSEL_CPU2 = 0x1U
+} SysCtl_CPUSel;
+
+typedef enum
+{
+	SYSCTL_PERIPH_CLK_CLA1 = 0x0000,
+	SYSCTL_PERIPH_CLK_DMA = 0x0200,
+	SYSCTL_PERIPH_CLK_TIMER0 = 0x0300,
+	SYSCTL_PERIPH_CLK_TIMER1 = 0x0400,
+	SYSCTL_PERIPH_CLK_TIMER2 = 0x0500,
+	SYSCTL_PERIPH_CLK_HRPWM = 0x1000,
+	SYSCTL_PERIPH_CLK_TBCLKSYNC = 0x1200,
+	SYSCTL_PERIPH_CLK_GTBCLKSYNC = 0x1300,
+	SYSCTL_PERIPH_CLK_EMIF1 = 0x0001,
+	SYSCTL_PERIPH_CLK_EMIF2 = 0x0101,
+	SYSCTL_PERIPH_CLK_EPWM1 = 0x0002,
+	SYSCTL_PERIPH_CLK_EPWM2 = 0x0102,
+	SYSCTL_PERIPH_CLK_EPWM3 = 0x0202,
+	SYSCTL_PERIPH_CLK_EPWM4 = 0x0302,
+	SYSCTL_PERIPH_CLK_EPWM5 = 0x0402,
+	SYSCTL_PERIPH_CLK_EPWM6 = 0x0502,
+	SYSCTL_PERIPH_CLK_EPWM7 = 0x0602,
+	SYSCTL_PERIPH_CLK_EPWM8 = 0x0702,
+	SYSCTL_PERIPH_CLK_EPWM9 = 0x0802,
+	SYSCTL_PERIPH_CLK_EPWM10 = 0x0902,
+	SYSCTL_PERIPH_CLK_EPWM11 = 0x0A02,
+	SYSCTL_PERIPH_CLK_EPWM12 = 0x0B02,
+	SYSCTL_PERIPH_CLK_ECAP1 = 0x0003,
+	SYSCTL_PERIPH_CLK_ECAP2 = 0x0103,
+	SYSCTL_PERIPH_CLK_ECAP3 = 0x0203,
+	SYSCTL_PERIPH_CLK_ECAP4 = 0x0303,
+	SYSCTL_PERIPH_CLK_ECAP5 = 0x0403,
+	SYSCTL_PERIPH_CLK_ECAP6 = 0x0503,
+	SYSCTL_PERIPH_CLK_EQEP1 = 0x0004,
+	SYSCTL_PERIPH_CLK_EQEP2 = 0x0104,
+	SYSCTL_PERIPH_CLK_EQEP3 = 0x0204,
+	SYSCTL_PERIPH_CLK_SD1 = 0x0006,
+	SYSCTL_PERIPH_CLK_SD2 = 0x0106,
+	SYSCTL_PERIPH_CLK_SCIA = 0x0007,
+	SYSCTL_PERIPH_CLK_SCIB = 0x0107,
+	SYSCTL_PERIPH_CLK_SCIC = 0x0207,
+	SYSCTL_PERIPH_CLK_SCID = 0x0307,
+	SYSCTL_PERIPH_CLK_SPIA = 0x0008,
+	SYSCTL_PERIPH_CLK_SPIB = 0x0108,
+	SYSCTL_PERIPH_CLK_SPIC = 0x0208,
+	SYSCTL_PERIPH_CLK_I2CA = 0x0009,
+	SYSCTL_PERIPH_CLK_I2CB = 0x0109,
+	SYSCTL_PERIPH_CLK_CANA = 0x000A,
+	SYSCTL_PERIPH_CLK_CANB = 0x010A,
+	SYSCTL_PERIPH_CLK_MCBSPA = 0x000B,
+	SYSCTL_PERIPH_CLK_MCBSPB = 0x010B,
+	SYSCTL_PERIPH_CLK_USBA = 0x100B,
+	SYSCTL_PERIPH_CLK_UPPA = 0x000C,
+	SYSCTL_PERIPH_CLK_ADCA = 0x000D,
+	SYSCTL_PERIPH_CLK_ADCB = 0x010D,
+	SYSCTL_PERIPH_CLK_ADCC = 0x020D,
+	SYSCTL_PERIPH_CLK_ADCD = 0x030D,
+	SYSCTL_PERIPH_CLK_CMPSS1 = 0x000E,
+	SYSCTL_PERIPH_CLK_CMPSS2 = 0x010E,
+	SYSCTL_PERIPH_CLK_CMPSS3 = 0x020E,
+	SYSCTL_PERIPH_CLK_CMPSS4 = 0x030E,
+	SYSCTL_PERIPH_CLK_CMPSS5 = 0x040E,
+	SYSCTL_PERIPH_CLK_CMPSS6 = 0x050E,
+	SYSCTL_PERIPH_CLK_CMPSS7 = 0x060E,
+	SYSCTL_PERIPH_CLK_CMPSS8 = 0x070E,
+	SYSCTL_PERIPH_CLK_DACA = 0x1010,
+	SYSCTL_PERIPH_CLK_DACB = 0x1110,
+	SYSCTL_PERIPH_CLK_DACC = 0x1210
+} SysCtl_PeripheralPCLOCKCR;
+
+typedef enum
+{
+	SYSCTL_SYNC_IN_EPWM4 = 0,
+	SYSCTL_SYNC_IN_EPWM7 = 3,
+	SYSCTL_SYNC_IN_EPWM10 = 6,
+	SYSCTL_SYNC_IN_ECAP1 = 9,
+	SYSCTL_SYNC_IN_ECAP4 = 12
+} SysCtl_SyncInput;
+
+typedef enum
+{
+	SYSCTL_SYNC_IN_SRC_EPWM1SYNCOUT     = 0,
+	SYSCTL_SYNC_IN_SRC_EPWM4SYNCOUT     = 1,
+	SYSCTL_SYNC_IN_SRC_EPWM7SYNCOUT     = 2,
+	SYSCTL_SYNC_IN_SRC_EPWM10SYNCOUT    = 3,
+	SYSCTL_SYNC_IN_SRC_ECAP1SYNCOUT     = 4,
+	SYSCTL_SYNC_IN_SRC_EXTSYNCIN1       = 5,
+	SYSCTL_SYNC_IN_SRC_EXTSYNCIN2       = 6,
+} SysCtl_SyncInputSource;
+
+
+#define MEMCFG_SECT_GS0 0x02000001U
+#define MEMCFG_SECT_GS1 0x02000002U
+#define MEMCFG_SECT_GS2 0x02000004U
+#define MEMCFG_SECT_GS3 0x02000008U
+#define MEMCFG_SECT_GS4 0x02000010U
+#define MEMCFG_SECT_GS5 0x02000020U
+#define MEMCFG_SECT_GS6 0x02000040U
+#define MEMCFG_SECT_GS7 0x02000080U
+#define MEMCFG_SECT_GS8 0x02000100U
+#define MEMCFG_SECT_GS9 0x02000200U
+#define MEMCFG_SECT_GS10 0x02000400U
+#define MEMCFG_SECT_GS11 0x02000800U
+#define MEMCFG_SECT_GS12 0x02001000U
+#define MEMCFG_SECT_GS13 0x02002000U
+#define MEMCFG_SECT_GS14 0x02004000U
+#define MEMCFG_SECT_GS15 0x02008000U
+#define MEMCFG_SECT_GSX_ALL 0x0200FFFFU
+
+typedef enum
+{
+	MEMCFG_GSRAMMASTER_CPU1,
+	MEMCFG_GSRAMMASTER_CPU2
+} MemCfg_GSRAMMasterSel;
+
+
+/**
+ * @brief Delays for 5 * count + 9 SYSCLK cycles of virtual time (cycle count of driverlib delay loop).
+ * @param count - number of delay loop iterations
+ * @return (none)
+ */
+void SysCtl_delay(uint32_t count);
+
+
+/**
+ * @brief Requests device reset. Host simulation records request, see sim::Device.
+ * @param (none)
+ * @return (none)
+ */
+void SysCtl_resetDevice();
+
+
+void SysCtl_selectCPUForPeripheral(SysCtl_CPUSelPeripheral peripheral, uint16_t peripheralInst, SysCtl_CPUSel cpuInst);
+void SysCtl_setSyncInputConfig(SysCtl_SyncInput syncInput, SysCtl_SyncInputSource syncSrc);
+void MemCfg_setGSRAMMasterSel(uint32_t ramSections, MemCfg_GSRAMMasterSel masterSel);
+
+
+/**
+ * @brief Enables peripheral clock. Enabling TBCLKSYNC starts simulated ePWM time-base counters.
+ * @param peripheral - peripheral clock
+ * @return (none)
+ */
+void SysCtl_enablePeripheral(SysCtl_PeripheralPCLOCKCR peripheral);
+
+
+/**
+ * @brief Disables peripheral clock. Disabling TBCLKSYNC stops simulated ePWM time-base counters.
+ * @param peripheral - peripheral clock
+ * @return (none)
+ */
+void SysCtl_disablePeripheral(SysCtl_PeripheralPCLOCKCR peripheral);
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Simulated device state.
+ */
+class Device
+{
+private:
+	static uint32_t _resetRequests;
+private:
+	Device();					// no constructor
+	Device(const Device& other);			// no copy constructor
+	Device& operator=(const Device& other);	// no copy assignment operator
+public:
+	static void requestReset() { ++_resetRequests; }
+	static uint32_t resetRequests() { return _resetRequests; }
+	static void clearResetRequests() { _resetRequests = 0; }
+};
+
+
+/// Starts/stops simulated ePWM time-base counters, see sim_epwm.cpp.
+void setTbclkSync(bool enabled);
+
+
+/// @}
+} // namespace sim
+
+
@@ -0,0 +1,351 @@
+/**
+ * @file sim_uart.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "sim_uart.h"
+#include "driverlib.h"
+#include "device.h"
+
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+
+namespace sim {
+
+
+///
+///
+///
+PipeUart::PipeUart(uint32_t baudrate, uint32_t intNum)
+	: _baudrate(baudrate)
+	, _intNum(intNum)
+	, _rxIntEnabled(false)
+	, _rxIntFlag(false)
+	, _rxError(false)
+	, _rxRemaining(0)
+	, _rxDone(false)
+	, _txRemaining(0)
+	, _txDone(false)
+	, _rxFd(-1)
+	, _txFd(-1)
+	, _rxCount(0)
+	, _txCount(0)
+	, _overruns(0)
+{
+	VirtualTime::registerModel(this);
+}
+
+
+///
+///
+///
+PipeUart::~PipeUart()
+{
+	VirtualTime::unregisterModel(this);
+}
+
+
+///
+///
+///
+uint64_t PipeUart::charCycles() const
+{
+	return static_cast<uint64_t>(DEVICE_SYSCLK_FREQ) * frameBits / _baudrate;
+}
+
+
+///
+///
+///
+void PipeUart::write(const char* data, size_t len)
+{
+	if (len == 0) return;
+	if (_rxLine.empty())
+	{
+		_rxRemaining = charCycles();
+	}
+	_rxLine.insert(_rxLine.end(), data, data + len);
+}
+
+
+void PipeUart::write(const char* str) { write(str, strlen(str)); }
+
+
+///
+///
+///
+std::string PipeUart::takeOutput()
+{
+	std::string output;
+	output.swap(_output);
+	return output;
+}
+
+
+///
+///
+///
+void PipeUart::attachFd(int rxFd, int txFd)
+{
+	_rxFd = rxFd;
+	_txFd = txFd;
+	if (_rxFd >= 0)
+	{
+		fcntl(_rxFd, F_SETFL, fcntl(_rxFd, F_GETFL) | O_NONBLOCK);
+	}
+}
+
+
+///
+///
+///
+bool PipeUart::pump()
+{
+	if (_rxFd < 0) return true;
+
+	char buf[256];
+	ssize_t len = ::read(_rxFd, buf, sizeof(buf));
+	if (len > 0)
+	{
+		write(buf, static_cast<size_t>(len));
+		return true;
+	}
+	return (len < 0) && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EIO);	// EIO: pty slave is not opened yet
+}
+
+
+///
+///
+///
+void PipeUart::reset()
+{
+	_rxFifo.clear();
+	_txFifo.clear();
+	_rxError = false;
+	_rxIntFlag = false;
+}
+
+
+///
+///
+///
+int PipeUart::recv(char& ch)
+{
+	if (_rxFifo.empty()) return 0;
+	ch = _rxFifo.front();
+	_rxFifo.pop_front();
+	return 1;
+}
+
+
+///
+///
+///
+int PipeUart::recv(char* buf, size_t bufLen)
+{
+	size_t i = 0;
+	char ch = 0;
+	while ((i < bufLen) && (recv(ch) == 1))
+	{
+		buf[i++] = ch;
+	}
+	if (hasRxError())
+	{
+		return -1;
+	}
+	return i;
+}
+
+
+///
+///
+///
+int PipeUart::send(char ch)
+{
+	if (_txFifo.size() >= fifoDepth) return 0;
+	if (_txFifo.empty())
+	{
+		_txRemaining = charCycles();
+	}
+	_txFifo.push_back(ch);
+	return 1;
+}
+
+
+///
+///
+///
+int PipeUart::send(const char* buf, uint16_t len)
+{
+	for (uint16_t i = 0; i < len; ++i)
+	{
+		while (send(buf[i]) == 0)
+		{
+			VirtualTime::advance(_txRemaining);	// blocking: wait until FIFO has room
+		}
+	}
+	return len;
+}
+
+
+///
+///
+///
+int PipeUart::sendNonBlocking(const char* buf, uint16_t len)
+{
+	uint16_t i = 0;
+	while ((i < len) && (send(buf[i]) == 1))
+	{
+		++i;
+	}
+	return i;
+}
+
+
+///
+///
+///
+void PipeUart::registerRxInterruptHandler(void (*handler)(void))
+{
+	Interrupt_register(_intNum, handler);
+	Interrupt_enable(_intNum);
+}
+
+
+///
+///
+///
+void PipeUart::enableRxInterrupts()
+{
+	_rxIntEnabled = true;
+	if (_rxIntFlag)
+	{
+		Interrupts::raise(_intNum);
+	}
+	else
+	{
+		_updateRxInterrupt();
+	}
+}
+
+
+void PipeUart::disableRxInterrupts() { _rxIntEnabled = false; }
+
+
+///
+///
+///
+void PipeUart::acknowledgeRxInterrupt()
+{
+	_rxIntFlag = false;
+	_updateRxInterrupt();
+}
+
+
+///
+///
+///
+uint64_t PipeUart::cyclesToNextEvent() const
+{
+	uint64_t cycles = noEvent;
+	if (!_rxLine.empty()) cycles = _rxRemaining;
+	if (!_txFifo.empty() && _txRemaining < cycles) cycles = _txRemaining;
+	return cycles;
+}
+
+
+///
+///
+///
+void PipeUart::advance(uint64_t cycles)
+{
+	if (!_rxLine.empty())
+	{
+		_rxRemaining -= (cycles < _rxRemaining) ? cycles : _rxRemaining;
+		_rxDone = (_rxRemaining == 0);
+	}
+	if (!_txFifo.empty())
+	{
+		_txRemaining -= (cycles < _txRemaining) ? cycles : _txRemaining;
+		_txDone = (_txRemaining == 0);
+	}
+}
+
+
+///
+///
+///
+void PipeUart::fireEvents()
+{
+	if (_txDone)
+	{
+		_txDone = false;
+		_transmit(_txFifo.front());
+		_txFifo.pop_front();
+		_txRemaining = charCycles();
+	}
+
+	if (_rxDone)
+	{
+		_rxDone = false;
+		char ch = _rxLine.front();
+		_rxLine.pop_front();
+		_rxRemaining = charCycles();
+		if (_rxFifo.size() >= fifoDepth)
+		{
+			++_overruns;
+			_rxError = true;
+		}
+		else
+		{
+			++_rxCount;
+			_rxFifo.push_back(ch);
+			_updateRxInterrupt();
+		}
+	}
+}
+
+
+///
+///
+///
+void PipeUart::_updateRxInterrupt()
+{
+	if (_rxIntFlag || _rxFifo.empty()) return;
+	_rxIntFlag = true;
+	if (_rxIntEnabled)
+	{
+		Interrupts::raise(_intNum);
+	}
+}
+
+
+///
+///
+///
+void PipeUart::_transmit(char ch)
+{
+	++_txCount;
+	_output.push_back(ch);
+	if (_txFd >= 0)
+	{
+		ssize_t written = ::write(_txFd, &ch, 1);
+		(void)written;
+	}
+}
+
+
+} // namespace sim
+
+
@@ -0,0 +1,137 @@
+/**
+ * @file sim_uart.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Host emb::IUart backed by in-memory pipe or file descriptor.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+#include <string>
+
+#include "emb/emb_interfaces/emb_uart.h"
+#include "sim_virtualtime.h"
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Host UART: emb::IUart with SCI FIFOs (16 chars) and 8N1 frames paced by baudrate in virtual time.
+ * Host side writes characters to RX line and takes characters sent by firmware. RX character that finds
+ * RX FIFO full is lost and sets RX error (overrun), as on target. RX interrupt is level-triggered:
+ * it is raised while RX FIFO is not empty and interrupt is enabled.
+ * Pipe may be connected to file descriptor (e.g. stdin/stdout or pseudo-terminal master): pump()
+ * moves input from descriptor to RX line, transmitted characters are written to descriptor.
+ */
+class PipeUart : public emb::IUart, public ITimedModel
+{
+public:
+	static const size_t fifoDepth = 16;
+	static const uint32_t frameBits = 10;	// start bit, 8 data bits, stop bit
+private:
+	uint32_t _baudrate;
+	uint32_t _intNum;
+	bool _rxIntEnabled;
+	bool _rxIntFlag;
+	bool _rxError;
+
+	std::deque<char> _rxLine;	// characters not yet received
+	std::deque<char> _rxFifo;
+	uint64_t _rxRemaining;		// cycles until the first line character is received
+	bool _rxDone;
+
+	std::deque<char> _txFifo;
+	uint64_t _txRemaining;		// cycles until the first FIFO character is transmitted
+	bool _txDone;
+	std::string _output;
+
+	int _rxFd;
+	int _txFd;
+	uint64_t _rxCount;
+	uint64_t _txCount;
+	uint64_t _overruns;
+public:
+	/**
+	 * @brief Constructs UART and registers it as virtual time model.
+	 * @param baudrate - baudrate, bps
+	 * @param intNum - interrupt number used for RX interrupt
+	 */
+	PipeUart(uint32_t baudrate, uint32_t intNum);
+	virtual ~PipeUart();
+
+	/* host side */
+	void write(const char* data, size_t len);
+	void write(const char* str);
+
+	/**
+	 * @brief Returns transmitted characters collected since last call and clears collected output.
+	 * @param (none)
+	 * @return Transmitted characters.
+	 */
+	std::string takeOutput();
+
+	/**
+	 * @brief Connects pipe to file descriptors, input descriptor is made non-blocking.
+	 * @param rxFd - input descriptor, -1 to disconnect
+	 * @param txFd - output descriptor, -1 to disconnect
+	 * @return (none)
+	 */
+	void attachFd(int rxFd, int txFd);
+
+	/**
+	 * @brief Moves input available on file descriptor to RX line.
+	 * @param (none)
+	 * @return \c false if end of input is reached, \c true otherwise.
+	 */
+	bool pump();
+
+	uint32_t baudrate() const { return _baudrate; }
+	uint64_t charCycles() const;		// SYSCLK cycles per character frame
+	size_t rxLineSize() const { return _rxLine.size(); }
+	size_t rxFifoLevel() const { return _rxFifo.size(); }
+	size_t txFifoLevel() const { return _txFifo.size(); }
+	bool txIdle() const { return _txFifo.empty(); }
+	uint64_t rxCount() const { return _rxCount; }
+	uint64_t txCount() const { return _txCount; }
+	uint64_t overruns() const { return _overruns; }
+
+	/* emb::IUart */
+	virtual void reset();
+	virtual bool hasRxError() const { return _rxError; }
+	virtual int recv(char& ch);
+	virtual int recv(char* buf, size_t bufLen);
+	virtual int send(char ch);
+	virtual int send(const char* buf, uint16_t len);
+	virtual int sendNonBlocking(const char* buf, uint16_t len);
+	virtual void registerRxInterruptHandler(void (*handler)(void));
+	virtual void enableRxInterrupts();
+	virtual void disableRxInterrupts();
+	virtual void acknowledgeRxInterrupt();
+
+	/* ITimedModel */
+	virtual uint64_t cyclesToNextEvent() const;
+	virtual void advance(uint64_t cycles);
+	virtual void fireEvents();
+private:
+	void _updateRxInterrupt();
+	void _transmit(char ch);
+};
+
+
+/// @}
+} // namespace sim
+
+
@@ -0,0 +1,127 @@
+/**
+ * @file sim_virtualtime.cpp
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#include "sim_virtualtime.h"
+#include "device.h"
+
+#include <vector>
+#include <algorithm>
+
+
+namespace sim {
+
+
+uint64_t VirtualTime::_cycles = 0;
+uint64_t VirtualTime::_idleAdvances = 0;
+
+
+namespace {
+
+
+std::vector<ITimedModel*>& models()
+{
+	static std::vector<ITimedModel*> instance;	// models register themselves during static initialization
+	return instance;
+}
+
+
+uint64_t cyclesToNextEvent()
+{
+	uint64_t cycles = ITimedModel::noEvent;
+	for (size_t i = 0; i < models().size(); ++i)
+	{
+		cycles = std::min(cycles, models()[i]->cyclesToNextEvent());
+	}
+	return cycles;
+}
+
+
+void step(uint64_t cycles)
+{
+	for (size_t i = 0; i < models().size(); ++i)
+	{
+		models()[i]->advance(cycles);
+	}
+	for (size_t i = 0; i < models().size(); ++i)
+	{
+		models()[i]->fireEvents();
+	}
+}
+
+
+} // namespace
+
+
+///
+///
+///
+void VirtualTime::registerModel(ITimedModel* model)
+{
+	models().push_back(model);
+}
+
+
+///
+///
+///
+void VirtualTime::unregisterModel(ITimedModel* model)
+{
+	models().erase(std::remove(models().begin(), models().end(), model), models().end());
+}
+
+
+///
+///
+///
+uint64_t VirtualTime::now_ns()
+{
+	return _cycles * 1000 / (DEVICE_SYSCLK_FREQ / 1000000);
+}
+
+
+///
+///
+///
+void VirtualTime::advance(uint64_t cycles)
+{
+	uint64_t target = _cycles + cycles;
+	while (_cycles < target)
+	{
+		uint64_t stepCycles = std::min(target - _cycles, std::max<uint64_t>(sim::cyclesToNextEvent(), 1));
+		_cycles += stepCycles;
+		step(stepCycles);
+	}
+}
+
+
+void VirtualTime::advance_ns(uint64_t ns) { advance(ns * (DEVICE_SYSCLK_FREQ / 1000000) / 1000); }
+void VirtualTime::advance_us(uint64_t us) { advance(us * (DEVICE_SYSCLK_FREQ / 1000000)); }
+void VirtualTime::advance_ms(uint64_t ms) { advance(ms * (DEVICE_SYSCLK_FREQ / 1000)); }
+
+
+///
+///
+///
+bool VirtualTime::advanceToNextEvent()
+{
+	uint64_t cycles = sim::cyclesToNextEvent();
+	if (cycles == ITimedModel::noEvent) return false;
+	advance(std::max<uint64_t>(cycles, 1));
+	++_idleAdvances;
+	return true;
+}
+
+
+} // namespace sim
+
+
@@ -0,0 +1,114 @@
+/**
+ * @file sim_virtualtime.h
+ * @ingroup sim
+ * @author Oleg Aushev (aushevom@protonmail.com)
+ * @brief Virtual time of host simulation: time advances only when test or benchmark advances it.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+namespace sim {
+/// @addtogroup sim
+/// @{
+
+
+/**
+ * @brief Interface of peripheral model driven by virtual time.
+ */
+class ITimedModel
+{
+public:
+	ITimedModel() {}
+	virtual ~ITimedModel() {}
+
+	/**
+	 * @brief Returns number of cycles until the next model event (e.g. timer interrupt).
+	 * @param (none)
+	 * @return Cycles until next event, noEvent if model has no scheduled events.
+	 */
+	virtual uint64_t cyclesToNextEvent() const = 0;
+
+	/**
+	 * @brief Advances model state. Advance never steps over model event.
+	 * @param cycles - number of cycles
+	 * @return (none)
+	 */
+	virtual void advance(uint64_t cycles) = 0;
+
+	/**
+	 * @brief Fires events that occurred in the last advance() call, e.g. raises interrupts.
+	 * Called after all models are advanced, so ISRs see consistent state of all models.
+	 * @param (none)
+	 * @return (none)
+	 */
+	virtual void fireEvents() = 0;
+
+	static const uint64_t noEvent = ~static_cast<uint64_t>(0);
+};
+
+
+/**
+ * @brief Virtual time in SYSCLK cycles. Time advances in steps bounded by the nearest model event,
+ * so ISRs are called at exact virtual time of the event.
+ */
+class VirtualTime
+{
+private:
+	static uint64_t _cycles;
+	static uint64_t _idleAdvances;
+private:
+	VirtualTime();					// no constructor
+	VirtualTime(const VirtualTime& other);		// no copy constructor
+	VirtualTime& operator=(const VirtualTime& other);	// no copy assignment operator
+public:
+	static void registerModel(ITimedModel* model);
+	static void unregisterModel(ITimedModel* model);
+
+	static uint64_t cycles() { return _cycles; }
+	static uint64_t now_ns();
+
+	/**
+	 * @brief Advances virtual time. Model events are fired and ISRs are called on the way.
+	 * @param cycles - number of SYSCLK cycles
+	 * @return (none)
+	 */
+	static void advance(uint64_t cycles);
+
+	static void advance_ns(uint64_t ns);
+	static void advance_us(uint64_t us);
+	static void advance_ms(uint64_t ms);
+
+	/**
+	 * @brief Advances virtual time to the nearest model event (idle fast-forward).
+	 * @param (none)
+	 * @return \c true if event was reached, \c false if there are no scheduled events.
+	 */
+	static bool advanceToNextEvent();
+
+	/// Number of advanceToNextEvent() calls that reached event, i.e. idle wakeups.
+	static uint64_t idleAdvances() { return _idleAdvances; }
+
+	/**
+	 * @brief Resets virtual time to zero. Models are kept.
+	 * @param (none)
+	 * @return (none)
+	 */
+	static void reset() { _cycles = 0; _idleAdvances = 0; }
+};
+
+
+/// @}
+} // namespace sim
+
+
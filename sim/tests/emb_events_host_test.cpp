@@ -0,0 +1,236 @@
+///
+#include "emb_host_test.h"
+#include "emb/emb_events/emb_events.h"
+#include "emb/emb_executor.h"
+
+#include <algorithm>
+
+
+namespace {
+
+
+typedef emb::Executor<4, 3> HarnessExecutor;
+
+
+const uint64_t clkPerUs = DEVICE_SYSCLK_FREQ / 1000000;
+const uint64_t dispatchCost = clkPerUs / 4;	// superloop pass overhead
+
+
+/// Services as in main(): CAN (0), clock tasks (1), CLI (2). Service id is its priority.
+const size_t serviceCount = 3;
+const size_t canService = 0;
+const size_t clockService = 1;
+const size_t cliService = 2;
+
+const uint32_t subscriptions[serviceCount] = {
+	emb::PendingEvents::bit(emb::Event::CanRx) | emb::PendingEvents::bit(emb::Event::ClockTick),
+	emb::PendingEvents::bit(emb::Event::ClockTick),
+	emb::PendingEvents::bit(emb::Event::UartRx) | emb::PendingEvents::bit(emb::Event::ClockTick)
+};
+const uint64_t runCost[serviceCount] = {0, 4 * clkPerUs, 1 * clkPerUs};		// per dispatch
+const uint64_t workCost[serviceCount] = {1 * clkPerUs, 0, 2 * clkPerUs};	// per CAN message, per received byte
+
+
+/// Work of service raised by ISRs and not processed yet, latency is measured from the oldest raise.
+struct ServiceState
+{
+	uint32_t work;
+	uint64_t oldestRaise;
+	uint32_t raised;
+	uint32_t processed;
+	uint32_t dispatches;
+	uint64_t totalLatency;
+	uint64_t maxLatency;
+	uint64_t maxRun;
+};
+
+
+ServiceState services[serviceCount];
+size_t serviceIds[serviceCount] = {canService, clockService, cliService};
+uint32_t orderViolations;
+
+
+/// ISR: adds work for subscribed services and raises event.
+void raiseEvent(emb::Event event)
+{
+	for (size_t i = 0; i < serviceCount; ++i)
+	{
+		if ((subscriptions[i] & emb::PendingEvents::bit(event)) == 0) continue;
+		if (services[i].work == 0)
+		{
+			services[i].oldestRaise = sim::VirtualTime::cycles();
+		}
+		++services[i].work;
+		++services[i].raised;
+	}
+	emb::PendingEvents::set(event);
+}
+
+
+/// Service drains all available work. Higher-priority service must not have work taken before this pass.
+emb::PtStatus harnessService(emb::ProtoThread& pt)
+{
+	size_t id = *static_cast<size_t*>(pt.arg);
+	uint64_t start = sim::VirtualTime::cycles();
+	for (size_t i = 0; i < id; ++i)
+	{
+		if (services[i].work != 0)
+		{
+			++orderViolations;
+		}
+	}
+
+	ServiceState& service = services[id];
+	uint32_t work = service.work;
+	if (work != 0)
+	{
+		uint64_t latency = start - service.oldestRaise;
+		service.totalLatency += latency;
+		service.maxLatency = std::max(service.maxLatency, latency);
+		++service.dispatches;
+		service.processed += work;
+		service.work = 0;
+	}
+	sim::VirtualTime::advance(runCost[id] + work * workCost[id]);	// ISRs may add work during run
+	service.maxRun = std::max(service.maxRun, sim::VirtualTime::cycles() - start);
+	return emb::PtStatus::Waiting;
+}
+
+
+/**
+ * @brief Interrupt source with pseudo-random intervals: ISR raises event at exact virtual time.
+ */
+class EventSource : public sim::ITimedModel
+{
+private:
+	emb::Event _event;
+	uint64_t _minInterval;
+	uint64_t _maxInterval;
+	uint64_t _remaining;
+	uint32_t _seed;
+	bool _pending;
+
+	uint64_t _nextInterval()
+	{
+		_seed = _seed * 1664525UL + 1013904223UL;
+		return _minInterval + (_seed >> 8) % (_maxInterval - _minInterval + 1);
+	}
+public:
+	EventSource(emb::Event event, uint64_t minInterval_us, uint64_t maxInterval_us, uint32_t seed)
+		: _event(event)
+		, _minInterval(minInterval_us * clkPerUs)
+		, _maxInterval(maxInterval_us * clkPerUs)
+		, _seed(seed)
+		, _pending(false)
+	{
+		_remaining = _nextInterval();
+		sim::VirtualTime::registerModel(this);
+	}
+
+	virtual ~EventSource() { sim::VirtualTime::unregisterModel(this); }
+
+	virtual uint64_t cyclesToNextEvent() const { return _remaining; }
+
+	virtual void advance(uint64_t cycles)
+	{
+		_remaining -= cycles;
+		if (_remaining == 0)
+		{
+			_pending = true;
+			_remaining = _nextInterval();
+		}
+	}
+
+	virtual void fireEvents()
+	{
+		if (!_pending) return;
+		_pending = false;
+		raiseEvent(_event);
+	}
+};
+
+
+/// Superloop pass as in main(): takes pending events, dispatches one service or idles until the next interrupt.
+bool harnessPass(HarnessExecutor& executor)
+{
+	executor.notify(emb::PendingEvents::take());
+	if (!executor.runOnce())
+	{
+		sim::VirtualTime::advanceToNextEvent();
+		return false;
+	}
+	sim::VirtualTime::advance(dispatchCost);
+	return true;
+}
+
+
+} // namespace
+
+
+void EmbHostTest::EventsHarnessTest()
+{
+	using emb::PendingEvents;
+	using emb::Event;
+
+	for (size_t i = 0; i < serviceCount; ++i)
+	{
+		services[i] = ServiceState();
+	}
+	orderViolations = 0;
+
+	HarnessExecutor executor(sim::VirtualTime::cycles, 20 * clkPerUs);
+	for (size_t i = 0; i < serviceCount; ++i)
+	{
+		size_t id = executor.add(harnessService, &serviceIds[i], i, false);
+		EMB_ASSERT_EQUAL(id, i);
+		executor.subscribe(id, subscriptions[i]);
+	}
+	while (executor.runOnce()) {}	// initial run of all services
+	PendingEvents::take();
+	executor.resetStats();
+
+	{
+		// CAN frames in bursts, CLI bytes at up to 115200 baud, clock tick every 1 ms
+		EventSource canRx(Event::CanRx, 2, 40, 1);
+		EventSource uartRx(Event::UartRx, 87, 300, 2);
+		EventSource clockTick(Event::ClockTick, 1000, 1000, 3);
+		uint64_t end = sim::VirtualTime::cycles() + 200 * 1000 * clkPerUs;	// 200 ms
+		while (sim::VirtualTime::cycles() < end)
+		{
+			harnessPass(executor);
+		}
+	}
+	while (harnessPass(executor)) {}	// sources are stopped, remaining work is drained
+	// (SystemClock ISR keeps raising ClockTick, services dispatched without harness work are harmless)
+
+	uint64_t maxRun = 0;
+	for (size_t i = 0; i < serviceCount; ++i)
+	{
+		// coalesced events are not lost: every raised unit of work is processed
+		EMB_ASSERT_TRUE(services[i].raised > 0);
+		EMB_ASSERT_EQUAL(services[i].processed, services[i].raised);
+		EMB_ASSERT_EQUAL(services[i].work, 0);
+		maxRun = std::max(maxRun, services[i].maxRun);
+	}
+
+	// dispatch order is priority order: service never runs while higher-priority one has pending work
+	EMB_ASSERT_EQUAL(orderViolations, 0);
+
+	// non-preemptive dispatch: CAN event waits at most for one running service and one superloop pass
+	EMB_ASSERT_TRUE(services[canService].maxLatency <= maxRun + dispatchCost);
+	EMB_ASSERT_TRUE(executor.stats(canService).max <= maxRun);
+
+	char str[192];
+	snprintf(str, sizeof(str), "[ BENCH  ] events harness, ISR to dispatch latency: can avg %.2f us max %.2f us, "
+			"clock avg %.2f us max %.2f us, cli avg %.2f us max %.2f us",
+			static_cast<double>(services[canService].totalLatency) / services[canService].dispatches / clkPerUs,
+			static_cast<double>(services[canService].maxLatency) / clkPerUs,
+			static_cast<double>(services[clockService].totalLatency) / services[clockService].dispatches / clkPerUs,
+			static_cast<double>(services[clockService].maxLatency) / clkPerUs,
+			static_cast<double>(services[cliService].totalLatency) / services[cliService].dispatches / clkPerUs,
+			static_cast<double>(services[cliService].maxLatency) / clkPerUs);
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
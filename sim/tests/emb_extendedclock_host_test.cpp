@@ -0,0 +1,162 @@
+///
+#include "emb_host_test.h"
+#include "emb/emb_extendedclock.h"
+
+
+namespace {
+
+
+uint32_t stressSeed;
+
+
+uint32_t stressRandom(uint32_t range)
+{
+	stressSeed = stressSeed * 1664525UL + 1013904223UL;
+	return static_cast<uint32_t>((static_cast<uint64_t>(stressSeed) * range) >> 32);
+}
+
+
+/**
+ * @brief Down-counter timer with constant-time advance, so full 32-bit periods are covered at host speed.
+ * Counter read takes random number of ticks after counter is latched. Reload ISR is serviced between clock reads only
+ * (ticks() runs with interrupts disabled) with random latency, within one period as on target.
+ */
+struct StressTimer
+{
+	static uint32_t reloadValue;
+	static uint32_t value;
+	static bool pending;
+	static uint64_t elapsed;
+	static uint32_t readCost;
+	static uint64_t isrDeadline;	// elapsed value at which pending reload is serviced
+	static uint64_t reloads;
+
+	static uint32_t period() { return reloadValue; }
+	static bool reloadPending() { return pending; }
+
+	static uint32_t counter()
+	{
+		uint32_t latched = value;	// reload may occur after counter is latched, before read completes
+		advance(readCost);
+		return latched;
+	}
+
+	static void advance(uint64_t ticks)
+	{
+		while (ticks > 0)
+		{
+			uint64_t toReload = static_cast<uint64_t>(value) + 1;
+			if (ticks < toReload)
+			{
+				value -= static_cast<uint32_t>(ticks);
+				elapsed += ticks;
+				return;
+			}
+			ticks -= toReload;
+			elapsed += toReload;
+			value = reloadValue;
+			pending = true;
+			isrDeadline = elapsed + stressRandom(reloadValue / 4 + 1);
+			++reloads;
+		}
+	}
+
+	/// Time between clock reads: interrupts are enabled, pending reload is serviced at its deadline.
+	static void advanceEnabled(uint64_t ticks)
+	{
+		if (pending && (elapsed + ticks >= isrDeadline))
+		{
+			uint64_t beforeIsr = (isrDeadline > elapsed) ? isrDeadline - elapsed : 0;
+			advance(beforeIsr);
+			pending = false;
+			emb::ExtendedClock<StressTimer>::onReload();
+			ticks -= beforeIsr;
+		}
+		advance(ticks);
+	}
+
+	static void reset(uint32_t period_)
+	{
+		reloadValue = period_;
+		value = period_;
+		pending = false;
+		elapsed = 0;
+		readCost = 0;
+		reloads = 0;
+	}
+};
+
+
+uint32_t StressTimer::reloadValue;
+uint32_t StressTimer::value;
+bool StressTimer::pending;
+uint64_t StressTimer::elapsed;
+uint32_t StressTimer::readCost;
+uint64_t StressTimer::isrDeadline;
+uint64_t StressTimer::reloads;
+
+
+/// Random reads with random read costs and gaps, every result must lie within its read interval.
+bool stressExtendedClock(uint32_t period, uint32_t iterations)
+{
+	typedef emb::ExtendedClock<StressTimer> Clock;
+	StressTimer::reset(period);
+	Clock::reset();
+
+	// worst case pending time: ISR latency + two reads, is less than one period
+	const uint32_t maxCost = period / 8 + 1;
+	const uint32_t maxGap = period / 4 + 1;
+	uint64_t prev = 0;
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		StressTimer::advanceEnabled(stressRandom(maxGap) + stressRandom(2));
+		StressTimer::readCost = stressRandom(maxCost) + stressRandom(2);
+		uint64_t before = StressTimer::elapsed;
+		uint64_t t = Clock::ticks();
+		uint64_t after = StressTimer::elapsed;
+		if ((t < before) || (t > after) || (t < prev)) return false;
+		prev = t;
+	}
+
+	StressTimer::readCost = 0;
+	return Clock::ticks() == StressTimer::elapsed;
+}
+
+
+} // namespace
+
+
+void EmbHostTest::ExtendedClockStressTest()
+{
+	// reload race and pending-reload re-read at all reload phases, from 8-tick period to full 32-bit counter
+	stressSeed = 1;
+	const uint32_t periods[] = {7, 99, 65535, 0xFFFFFFFF};
+	for (size_t i = 0; i < sizeof(periods) / sizeof(periods[0]); ++i)
+	{
+		EMB_ASSERT_TRUE(stressExtendedClock(periods[i], 1000000));
+		EMB_ASSERT_TRUE(StressTimer::reloads > 1000);
+	}
+	EMB_ASSERT_TRUE(StressTimer::elapsed > (static_cast<uint64_t>(1) << 40));	// tick count is far beyond 32 bits
+
+	// HighResolutionClock over simulated CPU timer 1: exact in virtual time across many reloads and 2^32 cycles
+	using mcu::chrono::HighResolutionClock;
+	uint64_t offset = sim::VirtualTime::cycles() - HighResolutionClock::ticks();
+	const uint64_t period = static_cast<uint64_t>(HighResolutionClock::period()) + 1;
+	while (sim::VirtualTime::cycles() < (static_cast<uint64_t>(1) << 33))
+	{
+		sim::VirtualTime::advance(stressRandom(3 * period));
+		EMB_ASSERT_EQUAL(sim::VirtualTime::cycles() - HighResolutionClock::ticks(), offset);
+	}
+
+	// reload ISR is held pending while interrupts are disabled: pending reload is taken into account
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		uint16_t intStatus = __disable_interrupts();
+		sim::VirtualTime::advance(stressRandom(period));
+		EMB_ASSERT_EQUAL(sim::VirtualTime::cycles() - HighResolutionClock::ticks(), offset);
+		__restore_interrupts(intStatus);
+		EMB_ASSERT_EQUAL(sim::VirtualTime::cycles() - HighResolutionClock::ticks(), offset);
+	}
+}
+
+
@@ -0,0 +1,21 @@
+///
+///
+///
+#pragma once
+
+
+#include "emb/emb_testrunner/emb_testrunner.h"
+#include "mcu_f2837xd/system/mcu_system.h"
+#include "mcu_f2837xd/chrono/mcu_chrono.h"
+#include "sim_virtualtime.h"
+
+
+/// emb library tests that need host simulation: ISRs are injected by virtual time models.
+class EmbHostTest
+{
+public:
+	static void ExtendedClockStressTest();
+	static void EventsHarnessTest();
+};
+
+
@@ -0,0 +1,55 @@
+///
+///
+///
+#include "emb/tests/emb_test.h"
+#include "emb_host_test.h"
+#include "mcu_f2837xd/system/mcu_system.h"
+#include "mcu_f2837xd/chrono/mcu_chrono.h"
+
+
+/// Host runner of emb library tests and their host-only harnesses (EmbHostTest).
+/// BitsetTest checks C28x object sizes and runs on target only.
+void emb::run_tests()
+{
+	mcu::initDevice();
+	mcu::chrono::SystemClock::init();
+	mcu::chrono::HighResolutionClock::init(1000);
+	mcu::chrono::HighResolutionClock::enableExtendedTicks();
+	mcu::chrono::HighResolutionClock::start();
+	mcu::enableMaskableInterrupts();
+
+	EMB_RUN_TEST(EmbTest::CommonTest);
+	EMB_RUN_TEST(EmbTest::MathTest);
+	EMB_RUN_TEST(EmbTest::AlgorithmTest);
+	EMB_RUN_TEST(EmbTest::ArrayTest);
+	EMB_RUN_TEST(EmbTest::QueueTest);
+	EMB_RUN_TEST(EmbTest::CircularBufferTest);
+	EMB_RUN_TEST(EmbTest::RingBufferTest);
+	EMB_RUN_TEST(EmbTest::CrcTest);
+	EMB_RUN_TEST(EmbTest::CobsTest);
+	EMB_RUN_TEST(EmbTest::FilterTest);
+	EMB_RUN_TEST(EmbTest::StackTest);
+	EMB_RUN_TEST(EmbTest::StaticVectorTest);
+	EMB_RUN_TEST(EmbTest::StringTest);
+	EMB_RUN_TEST(EmbTest::ExtendedClockTest);
+	EMB_RUN_TEST(EmbHostTest::ExtendedClockStressTest);
+	EMB_RUN_TEST(EmbTest::ProbeRegistryTest);
+	EMB_RUN_TEST(EmbTest::SchedulerTest);
+	EMB_RUN_TEST(EmbTest::DeadlineMonitorTest);
+	EMB_RUN_TEST(EmbTest::ExecutorTest);
+	EMB_RUN_TEST(EmbTest::EventsTest);
+	EMB_RUN_TEST(EmbHostTest::EventsHarnessTest);
+	EMB_RUN_TEST(EmbTest::TraceTest);
+	EMB_RUN_TEST(EmbTest::CpuLoadTest);
+
+	emb::TestRunner::printResult();
+}
+
+
+int main()
+{
+	emb::run_tests();
+	return emb::TestRunner::passed() ? 0 : 1;
+}
+
+
@@ -0,0 +1,339 @@
+///
+#include "sim_test.h"
+#include "sim_uart.h"
+#include "emb/emb_events/emb_events.h"
+#include "cli/cli_server.h"
+#include "cli/shell/cli_shell.h"
+#include "binproto_client.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+
+namespace {
+
+
+const uint32_t CLI_PIPE_INT = INT_SCIC_RX;	// SCIC is not used by firmware
+const uint64_t RESPONSE_TIMEOUT_ms = 2000;
+const uint32_t BAUDRATE = 115200;
+
+
+sim::PipeUart* pipeUart = NULL;
+__interrupt void onPipeUartRx()
+{
+	pipeUart->disableRxInterrupts();	// re-enabled by CLI task when Rx FIFO is drained, as in firmware
+	pipeUart->acknowledgeRxInterrupt();
+	emb::PendingEvents::set(emb::Event::UartRx);
+}
+
+
+/// One pass of firmware CLI task.
+void serve(cli::Server& server, sim::PipeUart& uart)
+{
+	emb::PendingEvents::take();
+	while (server.run()) {}
+	uart.enableRxInterrupts();
+}
+
+
+/**
+ * @brief Client channel over pipe UART: waiting runs CLI server as firmware CLI task does.
+ */
+class PipeChannel : public cli::binproto::IChannel
+{
+private:
+	cli::Server& _server;
+	sim::PipeUart& _uart;
+	std::string _input;
+public:
+	PipeChannel(cli::Server& server, sim::PipeUart& uart) : _server(server), _uart(uart) {}
+
+	virtual void write(const unsigned char* data, size_t len)
+	{
+		_uart.write(reinterpret_cast<const char*>(data), len);
+	}
+
+	virtual size_t read(unsigned char* buf, size_t size)
+	{
+		_input += _uart.takeOutput();
+		size_t len = std::min(size, _input.size());
+		memcpy(buf, _input.data(), len);
+		_input.erase(0, len);
+		return len;
+	}
+
+	virtual bool wait(uint64_t timeout_ms)
+	{
+		uint64_t deadline = sim::VirtualTime::cycles() + timeout_ms * (DEVICE_SYSCLK_FREQ / 1000);
+		while (sim::VirtualTime::cycles() < deadline)
+		{
+			serve(_server, _uart);
+			_input += _uart.takeOutput();
+			if (!_input.empty()) return true;
+			sim::VirtualTime::advanceToNextEvent();
+		}
+		return false;
+	}
+
+	/// Runs server for given virtual time, e.g. while telemetry is streamed.
+	void run(uint64_t duration_ms)
+	{
+		wait(0);
+		uint64_t deadline = sim::VirtualTime::cycles() + duration_ms * (DEVICE_SYSCLK_FREQ / 1000);
+		while (sim::VirtualTime::cycles() < deadline)
+		{
+			serve(_server, _uart);
+			sim::VirtualTime::advanceToNextEvent();
+		}
+	}
+};
+
+
+const size_t BENCH_VAR_COUNT = 8;
+uint32_t benchVars[BENCH_VAR_COUNT];
+int16_t signedVar = -1234;
+float floatVar = 2.5f;
+uint32_t readOnlyVar = 0xDEADBEEF;
+
+const sys::Var testVars[] =
+{
+	{"bench0", sys::VarType::Uint32, &benchVars[0], 1.0f, true},
+	{"bench1", sys::VarType::Uint32, &benchVars[1], 1.0f, true},
+	{"bench2", sys::VarType::Uint32, &benchVars[2], 1.0f, true},
+	{"bench3", sys::VarType::Uint32, &benchVars[3], 1.0f, true},
+	{"bench4", sys::VarType::Uint32, &benchVars[4], 1.0f, true},
+	{"bench5", sys::VarType::Uint32, &benchVars[5], 1.0f, true},
+	{"bench6", sys::VarType::Uint32, &benchVars[6], 1.0f, true},
+	{"bench7", sys::VarType::Uint32, &benchVars[7], 1.0f, true},
+	{"signed", sys::VarType::Int16, &signedVar, 1.0f, true},
+	{"float", sys::VarType::Float32, &floatVar, 0.5f, true},
+	{"readonly", sys::VarType::Uint32, &readOnlyVar, 1.0f, false},
+};
+const uint16_t SIGNED_ID = 8;
+const uint16_t FLOAT_ID = 9;
+const uint16_t READONLY_ID = 10;
+
+
+uint64_t elapsed_us(uint64_t startCycles)
+{
+	return (sim::VirtualTime::cycles() - startCycles) / (DEVICE_SYSCLK_FREQ / 1000000);
+}
+
+
+void printBench(const char* str)
+{
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+} // namespace
+
+
+void SimTest::BinaryProtocolBenchmark()
+{
+	using namespace cli::binproto;
+
+	sys::VarRegistry::init(testVars, sizeof(testVars) / sizeof(testVars[0]));
+	cli::BinaryProtocol::init(mcu::chrono::SystemClock::now);
+	cli::Shell::init();
+
+	sim::PipeUart uart(BAUDRATE, CLI_PIPE_INT);
+	pipeUart = &uart;
+	uart.registerRxInterruptHandler(onPipeUartRx);
+	uart.enableRxInterrupts();
+	cli::Server server("bench", &uart, NULL, NULL);
+	server.registerExecCallback(cli::Shell::exec);
+	PipeChannel channel(server, uart);
+	channel.run(10);
+	uart.takeOutput();
+
+	// switching from shell: text before hello frame is skipped by client
+	Client client(channel, RESPONSE_TIMEOUT_ms);
+	uart.write("binmode\r");
+	DeviceInfo hello;
+	EMB_ASSERT_TRUE(client.waitHello(hello));
+	EMB_ASSERT_EQUAL(hello.version, CLI_BINPROTO_VERSION);
+	EMB_ASSERT_EQUAL(hello.varCount, sizeof(testVars) / sizeof(testVars[0]));
+	EMB_ASSERT_EQUAL(hello.frameMaxLength, CLI_BINPROTO_FRAME_MAX_LENGTH);
+
+	// requests
+	std::vector<unsigned char> data;
+	for (int i = 0; i < 40; ++i)
+	{
+		data.push_back(i % 3 == 0 ? 0 : i);	// zero octets are stuffed
+	}
+	EMB_ASSERT_TRUE(client.ping(data) == Status::Ok);
+
+	VarInfo var;
+	EMB_ASSERT_TRUE(client.varInfo(SIGNED_ID, var) == Status::Ok);
+	EMB_ASSERT_TRUE(var.name == "signed" && var.type == sys::VarType::Int16 && var.writable);
+	EMB_ASSERT_TRUE(client.varInfo(FLOAT_ID, var) == Status::Ok);
+	EMB_ASSERT_TRUE(var.name == "float" && var.scale == 0.5f);
+	EMB_ASSERT_TRUE(client.varInfo(READONLY_ID, var) == Status::Ok);
+	EMB_ASSERT_TRUE(!var.writable);
+	EMB_ASSERT_TRUE(client.varInfo(100, var) == Status::BadId);
+
+	std::vector<uint16_t> ids;
+	ids.push_back(SIGNED_ID);
+	ids.push_back(FLOAT_ID);
+	ids.push_back(READONLY_ID);
+	std::vector<Value> values;
+	EMB_ASSERT_TRUE(client.read(ids, values) == Status::Ok);
+	EMB_ASSERT_EQUAL(values[0].asInt(), -1234);
+	EMB_ASSERT_TRUE(values[1].asFloat() == 2.5f);
+	EMB_ASSERT_EQUAL(values[2].raw, 0xDEADBEEF);
+
+	Value value;
+	value.type = sys::VarType::Float32;
+	value.raw = Value::fromFloat(-0.125f);
+	EMB_ASSERT_TRUE(client.write(FLOAT_ID, value) == Status::Ok);
+	EMB_ASSERT_TRUE(floatVar == -0.125f);
+	value.type = sys::VarType::Int16;
+	value.raw = static_cast<uint32_t>(-7);
+	EMB_ASSERT_TRUE(client.write(SIGNED_ID, value) == Status::Ok);
+	EMB_ASSERT_EQUAL(signedVar, -7);
+	EMB_ASSERT_TRUE(client.write(FLOAT_ID, value) == Status::TypeMismatch);
+	value.type = sys::VarType::Uint32;
+	EMB_ASSERT_TRUE(client.write(READONLY_ID, value) == Status::ReadOnly);
+	EMB_ASSERT_EQUAL(readOnlyVar, 0xDEADBEEF);
+
+	Frame frame;
+	EMB_ASSERT_TRUE(client.waitResponse(client.send(Opcode(static_cast<Opcode::enum_type>(0x55))), frame));
+	EMB_ASSERT_EQUAL(frame.status, Status::UnknownOpcode);
+	ids.assign(READ_MAX_COUNT + 1, 0);
+	EMB_ASSERT_TRUE(client.read(ids, values) == Status::BadLength);
+
+	// corrupted frame is dropped without response, next request is served
+	std::vector<unsigned char> raw;
+	raw.push_back(0x77);
+	raw.push_back(Opcode::Info);
+	raw = Client::encodeFrame(raw);
+	raw[2] ^= 0x01;
+	client.sendRaw(raw);
+	EMB_ASSERT_TRUE(client.info(hello) == Status::Ok);
+	EMB_ASSERT_TRUE(client.waitResponse(client.send(Opcode::Stats), frame));
+	EMB_ASSERT_EQUAL(frame.payload.size(), 20);
+	EMB_ASSERT_EQUAL(frame.payload[4], 1);	// CRC errors
+	EMB_ASSERT_EQUAL(cli::BinaryProtocol::stats().crcErrors, 1);
+	EMB_ASSERT_EQUAL(client.crcErrors(), 0);
+
+	// sequential vs pipelined reads of 8 variables
+	ids.clear();
+	for (uint16_t i = 0; i < BENCH_VAR_COUNT; ++i)
+	{
+		ids.push_back(i);
+		benchVars[i] = 1000 * i;
+	}
+	const uint32_t readCount = 200;
+	uint64_t start = sim::VirtualTime::cycles();
+	for (uint32_t i = 0; i < readCount; ++i)
+	{
+		EMB_ASSERT_TRUE(client.read(ids, values) == Status::Ok);
+	}
+	uint64_t sequential_us = elapsed_us(start);
+	EMB_ASSERT_EQUAL(values[7].raw, 7000);
+
+	const size_t window = 4;
+	std::vector<unsigned char> request = Client::readPayload(ids);
+	std::deque<unsigned char> inFlight;
+	uint32_t completed = 0;
+	uint32_t mismatches = 0;
+	start = sim::VirtualTime::cycles();
+	for (uint32_t sent = 0; completed < readCount; )
+	{
+		while (inFlight.size() < window && sent < readCount)
+		{
+			inFlight.push_back(client.send(Opcode::Read, request));
+			++sent;
+		}
+		if (!client.waitResponse(inFlight.front(), frame)) break;
+		inFlight.pop_front();
+		++completed;
+		if (!Client::decodeReadPayload(frame.payload, values) || values.size() != BENCH_VAR_COUNT
+				|| values[3].raw != 3000)
+		{
+			++mismatches;
+		}
+	}
+	uint64_t pipelined_us = elapsed_us(start);
+	EMB_ASSERT_EQUAL(completed, readCount);
+	EMB_ASSERT_EQUAL(mismatches, 0);
+	EMB_ASSERT_TRUE(pipelined_us < sequential_us);
+	EMB_ASSERT_EQUAL(uart.overruns(), 0);
+
+	// telemetry: period the line can carry is streamed without drops
+	TelemetrySample sample;
+	EMB_ASSERT_TRUE(client.subscribe(5, ids) == Status::Ok);
+	uint64_t rxOctets = client.rxOctets();
+	channel.run(1000);
+	client.poll();
+	uint64_t telemetryOctets = client.rxOctets() - rxOctets;
+	size_t samples = client.telemetryPending();
+	uint32_t gaps = 0;
+	uint32_t lastTimestamp = 0;
+	uint16_t expectedSeq = 0;
+	while (client.takeTelemetry(sample))
+	{
+		if (sample.sequence != expectedSeq || sample.values.size() != BENCH_VAR_COUNT
+				|| sample.values[5].raw != 5000 || sample.timestamp_ms < lastTimestamp)
+		{
+			++gaps;
+		}
+		expectedSeq = sample.sequence + 1;
+		lastTimestamp = sample.timestamp_ms;
+	}
+	EMB_ASSERT_TRUE(samples >= 195 && samples <= 201);
+	EMB_ASSERT_EQUAL(gaps, 0);
+	EMB_ASSERT_EQUAL(cli::BinaryProtocol::stats().telemetryDropped, 0);
+
+	// period faster than line rate: samples are dropped on device and show up as sequence gaps
+	EMB_ASSERT_TRUE(client.subscribe(1, ids) == Status::Ok);
+	channel.run(1000);
+	client.poll();
+	size_t fastSamples = client.telemetryPending();
+	uint16_t firstSeq = 0;
+	uint16_t lastSeq = 0;
+	for (size_t i = 0; client.takeTelemetry(sample); ++i)
+	{
+		if (i == 0) firstSeq = sample.sequence;
+		lastSeq = sample.sequence;
+	}
+	EMB_ASSERT_TRUE(fastSamples > samples);
+	EMB_ASSERT_TRUE(uint32_t(lastSeq - firstSeq + 1) > fastSamples);
+	EMB_ASSERT_TRUE(cli::BinaryProtocol::stats().telemetryDropped > 0);
+	EMB_ASSERT_TRUE(client.unsubscribe() == Status::Ok);
+	channel.run(10);
+	client.poll();
+	while (client.takeTelemetry(sample)) {}
+
+	// back to shell
+	EMB_ASSERT_TRUE(client.exit() == Status::Ok);
+	uart.takeOutput();
+	uart.write("uptime\r");
+	channel.run(100);
+	EMB_ASSERT_TRUE(uart.takeOutput().find("uptime: ") != std::string::npos);
+	EMB_ASSERT_EQUAL(uart.overruns(), 0);
+	uart.disableRxInterrupts();
+	pipeUart = NULL;
+
+	char str[192];
+	snprintf(str, sizeof(str), "[ BENCH  ] binproto %lu baud, read of %lu vars: sequential %lu req/s, pipelined (window %lu) %lu req/s",
+			static_cast<unsigned long>(BAUDRATE), static_cast<unsigned long>(BENCH_VAR_COUNT),
+			static_cast<unsigned long>(readCount * 1000000ULL / sequential_us), static_cast<unsigned long>(window),
+			static_cast<unsigned long>(readCount * 1000000ULL / pipelined_us));
+	printBench(str);
+	snprintf(str, sizeof(str), "[ BENCH  ] binproto %lu baud, telemetry of %lu u32 vars at 5 ms: %lu samples/s, %lu values/s, %lu bytes/s on line",
+			static_cast<unsigned long>(BAUDRATE), static_cast<unsigned long>(BENCH_VAR_COUNT),
+			static_cast<unsigned long>(samples), static_cast<unsigned long>(samples * BENCH_VAR_COUNT),
+			static_cast<unsigned long>(telemetryOctets));
+	printBench(str);
+	snprintf(str, sizeof(str), "[ BENCH  ] binproto %lu baud, telemetry at 1 ms: %lu samples/s sent, line rate %lu bytes/s",
+			static_cast<unsigned long>(BAUDRATE), static_cast<unsigned long>(fastSamples),
+			static_cast<unsigned long>(BAUDRATE / sim::PipeUart::frameBits));
+	printBench(str);
+}
+
+
@@ -0,0 +1,1648 @@
+///
+#include "sim_test.h"
+#include "emb/emb_events/emb_events.h"
+#include "emb/emb_trace/emb_trace.h"
+#include "ucanopen/tests/ucanopen_tests.h"
+#include "ucanopen/tests/ucanopen_tests_od.h"
+#include "emb/emb_crc.h"
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <map>
+#include <fstream>
+
+
+namespace {
+
+
+struct ReceivedFrame
+{
+	size_t node;
+	uint64_t time_ns;
+	sim::CanFrame frame;
+};
+
+
+std::vector<ReceivedFrame> clientFrames;
+void onClientRx(size_t node, const sim::CanFrame& frame)
+{
+	ReceivedFrame received = {node, sim::VirtualTime::now_ns(), frame};
+	clientFrames.push_back(received);
+}
+
+
+size_t countFrames(uint32_t id)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < clientFrames.size(); ++i)
+	{
+		if (clientFrames[i].frame.id == id) ++count;
+	}
+	return count;
+}
+
+
+const ReceivedFrame* lastFrame(uint32_t id)
+{
+	for (size_t i = clientFrames.size(); i > 0; --i)
+	{
+		if (clientFrames[i-1].frame.id == id) return &clientFrames[i-1];
+	}
+	return NULL;
+}
+
+
+sim::CanFrame makeFrame(uint32_t id, uint16_t len)
+{
+	sim::CanFrame frame = {id, len, {0, 1, 2, 3, 4, 5, 6, 7}, false};
+	return frame;
+}
+
+
+sim::CanFrame makeSdoFrame(uint32_t id, uint32_t cs, uint32_t index, uint32_t subindex, uint32_t value)
+{
+	ucanopen::CobSdo sdo;
+	sdo.cs = cs;
+	sdo.index = index;
+	sdo.subindex = subindex;
+	sdo.data.u32 = value;
+	ucanopen::can_payload payload = ucanopen::toPayload<ucanopen::CobSdo>(sdo);
+
+	sim::CanFrame frame = makeFrame(id, 8);
+	for (size_t i = 0; i < 8; ++i)
+	{
+		frame.data[i] = payload[i];
+	}
+	return frame;
+}
+
+
+uint32_t sdoValue(const sim::CanFrame& frame)
+{
+	ucanopen::can_payload payload;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		payload[i] = frame.data[i];
+	}
+	return ucanopen::fromPayload<ucanopen::CobSdo>(payload).data.u32;
+}
+
+
+typedef mcu::can::Module<mcu::can::Peripheral::CanA> CanA;
+typedef mcu::can::Module<mcu::can::Peripheral::CanB> CanB;
+typedef ucanopen::tests::Server<mcu::can::Peripheral::CanA, mcu::ipc::Mode::Singlecore, mcu::ipc::Role::Primary> ServerA;
+typedef ucanopen::tests::Server<mcu::can::Peripheral::CanB, mcu::ipc::Mode::Singlecore, mcu::ipc::Role::Primary> ServerB;
+
+
+ucanopen::IpcFlags makeIpcFlags(uint32_t firstFlag)
+{
+	ucanopen::IpcFlags flags =
+	{
+		.tsdoReady = mcu::ipc::Flag(firstFlag + 5, mcu::ipc::Mode::Singlecore)
+	};
+	return flags;
+}
+
+
+/// Event-driven superloop with both servers, idle time is skipped to the next model event.
+void runServers(ServerA& serverA, ServerB& serverB, uint64_t duration_ms)
+{
+	uint64_t end = sim::VirtualTime::now_ns() + duration_ms * 1000000;
+	while (sim::VirtualTime::now_ns() < end)
+	{
+		if (emb::PendingEvents::take() != 0)
+		{
+			serverA.run();
+			serverB.run();
+		}
+		else if (!sim::VirtualTime::advanceToNextEvent())
+		{
+			break;
+		}
+	}
+}
+
+
+void printBench(const char* name, uint64_t count, uint64_t ns)
+{
+	char str[128];
+	snprintf(str, sizeof(str), "[ BENCH  ] ucanopen %s: %llu frames/s (%llu ns per frame)", name,
+			static_cast<unsigned long long>(count * 1000000000 / (ns + 1)),
+			static_cast<unsigned long long>(ns / count));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+/// Synthetic object dictionary: unique keys and names, entries are shuffled as in hand-written tables.
+struct SyntheticOd
+{
+	std::vector<std::string> names;
+	std::vector<ucanopen::ODEntry> entries;
+	std::vector<uint32_t> keys;	// key buffer of index
+};
+
+
+uint32_t syntheticOdData;
+
+
+void makeOd(SyntheticOd& od, size_t count)
+{
+	const char* categories[4] = {"control", "motor", "system", "watch"};
+	od.names.resize(count);
+	od.entries.resize(count);
+	od.keys.resize(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "parameter_%04lu", static_cast<uint32_t>(i));
+		od.names[i] = name;
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		ucanopen::ODEntry entry = {{static_cast<uint32_t>(0x2000 + i / 32), static_cast<uint32_t>(i % 32)}, {categories[i % 4], "config", od.names[i].c_str(), "",
+				ucanopen::OD_UINT32, ucanopen::OD_ACCESS_RW, OD_PTR(&syntheticOdData),
+				ucanopen::OD_NO_INDIRECT_READ_ACCESS, ucanopen::OD_NO_INDIRECT_WRITE_ACCESS}};
+		od.entries[i] = entry;
+	}
+	for (size_t i = count; i > 1; --i)
+	{
+		std::swap(od.entries[i - 1], od.entries[(i * 7919) % i]);
+	}
+}
+
+
+/// Debug boot check of hand-written table: sorts table, validates it with key buffer as scratch.
+bool validateOd(SyntheticOd& od)
+{
+	std::sort(od.entries.begin(), od.entries.end());
+	return ucanopen::ODIndex::validate(&od.entries[0], od.entries.size(), &od.keys[0]);
+}
+
+
+/// Boot-time check replaced by ODIndex::validate(): all entry pairs, three strcmp per pair.
+bool validatePairwise(const ucanopen::ODEntry* dictionary, size_t len)
+{
+	bool valid = true;
+	for (size_t i = 0; i < len; ++i)
+	{
+		for (size_t j = i + 1; j < len; ++j)
+		{
+			valid = valid && ((dictionary[i].key.index != dictionary[j].key.index)
+					|| (dictionary[i].key.subindex != dictionary[j].key.subindex));
+			bool categoryEqual = (strcmp(dictionary[i].value.category, dictionary[j].value.category) == 0);
+			bool subcategoryEqual = (strcmp(dictionary[i].value.subcategory, dictionary[j].value.subcategory) == 0);
+			bool nameEqual = (strcmp(dictionary[i].value.name, dictionary[j].value.name) == 0);
+			valid = valid && (!categoryEqual || !subcategoryEqual || !nameEqual);
+		}
+	}
+	return valid;
+}
+
+
+} // namespace
+
+
+void SimTest::CanBusTest()
+{
+	// arbitration: frames requested at the same time are sent in identifier order, frame takes its bit time
+	sim::CanBus::reset(1000000);
+	size_t clientA = sim::CanBus::attachClient(onClientRx);
+	size_t clientB = sim::CanBus::attachClient(onClientRx);
+	clientFrames.clear();
+	uint64_t start = sim::VirtualTime::now_ns();
+	sim::CanBus::send(clientA, makeFrame(0x300, 8));
+	sim::CanBus::send(clientB, makeFrame(0x100, 8));
+	sim::CanBus::send(clientB, makeFrame(0x500, 0));
+	EMB_ASSERT_EQUAL(sim::CanBus::frameBits(makeFrame(0x300, 8)), 111);
+	sim::VirtualTime::advance_us(1000);
+	EMB_ASSERT_TRUE(sim::CanBus::idle());
+	EMB_ASSERT_EQUAL(clientFrames.size(), 3);
+	EMB_ASSERT_EQUAL(clientFrames[0].frame.id, 0x100);
+	EMB_ASSERT_EQUAL(clientFrames[0].node, clientA);
+	EMB_ASSERT_EQUAL(clientFrames[0].time_ns - start, 112000);	// SOF slot + 111 bits
+	EMB_ASSERT_EQUAL(clientFrames[1].frame.id, 0x300);
+	EMB_ASSERT_EQUAL(clientFrames[1].time_ns - start, 223000);
+	EMB_ASSERT_EQUAL(clientFrames[2].frame.id, 0x500);
+	EMB_ASSERT_EQUAL(clientFrames[2].time_ns - start, 270000);
+	EMB_ASSERT_EQUAL(sim::CanBus::frameCount(), 3);
+	EMB_ASSERT_EQUAL(sim::CanBus::busyCycles(), 269 * 200);
+
+	// node alone on bus gets no acknowledgment: retransmission until error passive
+	sim::CanBus::reset(1000000);
+	size_t lonely = sim::CanBus::attachClient(onClientRx);
+	sim::CanBus::send(lonely, makeFrame(0x123, 8));
+	sim::VirtualTime::advance_ms(10);
+	EMB_ASSERT_EQUAL(sim::CanBus::frameCount(), 0);
+	EMB_ASSERT_EQUAL(sim::CanBus::tec(lonely), 128);
+	EMB_ASSERT_EQUAL(sim::CanBus::pending(lonely), 1);
+	clientFrames.clear();
+	sim::CanBus::attachClient(onClientRx);
+	sim::VirtualTime::advance_ms(1);
+	EMB_ASSERT_EQUAL(clientFrames.size(), 1);
+	EMB_ASSERT_EQUAL(sim::CanBus::tec(lonely), 127);
+
+	// two uCANopen servers and test client on one bus
+	sim::CanBus::reset(1000000);
+	CanA canA(mcu::gpio::Config(30, GPIO_30_CANRXA), mcu::gpio::Config(31, GPIO_31_CANTXA),
+			mcu::can::Bitrate::Bitrate1M, mcu::can::Mode::Normal);
+	CanB canB(mcu::gpio::Config(17, GPIO_17_CANRXB), mcu::gpio::Config(12, GPIO_12_CANTXB),
+			mcu::can::Bitrate::Bitrate1M, mcu::can::Mode::Normal);
+	ServerA serverA(ucanopen::NodeId(0x1), &canA, makeIpcFlags(4));
+	ServerB serverB(ucanopen::NodeId(0x2), &canB, makeIpcFlags(16));
+	sim::CanBus::attach(CANA_BASE);
+	sim::CanBus::attach(CANB_BASE);
+	size_t client = sim::CanBus::attachClient(onClientRx);
+	serverA.enable();
+	serverB.enable();
+
+	clientFrames.clear();
+	emb::trace::Recorder::clear();
+	emb::trace::Recorder::start();	// CAN ISR trace events, writable trace cursor is used in SDO test
+	runServers(serverA, serverB, 1100);
+	EMB_ASSERT_EQUAL(countFrames(0x701), 1);	// heartbeat
+	EMB_ASSERT_EQUAL(countFrames(0x702), 1);
+	EMB_ASSERT_TRUE(countFrames(0x181) >= 21);	// TPDO1, 50ms
+	EMB_ASSERT_TRUE(countFrames(0x182) >= 21);
+	EMB_ASSERT_EQUAL(sim::CanBus::errorCount(), 0);
+
+	// SDO write and read of node 1, node 2 does not respond; SDO frames lose arbitration to TPDOs
+	clientFrames.clear();
+	sim::CanBus::send(client, makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsWrite, 0x5010, 0x01, 5));
+	runServers(serverA, serverB, 5);
+	EMB_ASSERT_EQUAL(countFrames(0x581), 1);
+	sim::CanBus::send(client, makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsRead, 0x5010, 0x01, 0));
+	runServers(serverA, serverB, 5);
+	EMB_ASSERT_EQUAL(countFrames(0x581), 2);
+	EMB_ASSERT_EQUAL(sdoValue(lastFrame(0x581)->frame), 5);
+	EMB_ASSERT_EQUAL(countFrames(0x582), 0);
+
+	// trace cursor write stops recording, trace recording entry restarts it
+	EMB_ASSERT_TRUE(!emb::trace::Recorder::enabled());
+	sim::CanBus::send(client, makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsWrite, 0x5010, 0x04, 1));
+	runServers(serverA, serverB, 5);
+	EMB_ASSERT_EQUAL(countFrames(0x581), 3);
+	EMB_ASSERT_TRUE(emb::trace::Recorder::enabled());
+	sim::CanBus::send(client, makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsRead, 0x5010, 0x04, 0));
+	runServers(serverA, serverB, 5);
+	EMB_ASSERT_EQUAL(countFrames(0x581), 4);
+	EMB_ASSERT_EQUAL(sdoValue(lastFrame(0x581)->frame), 1);
+
+	// RPDO is not handled as SDO request
+	sim::CanBus::send(client, makeSdoFrame(0x201, ucanopen::cs_codes::sdoCcsRead, 0x5010, 0x01, 0));
+	runServers(serverA, serverB, 5);
+	EMB_ASSERT_EQUAL(countFrames(0x581), 4);
+
+	// destroyed frame is retransmitted, transmitter error counter is incremented and then decremented
+	sim::CanBus::injectErrors(1, CAN_STATUS_LEC_BIT0);
+	sim::CanBus::send(client, makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsRead, 0x5010, 0x01, 0));
+	runServers(serverA, serverB, 5);
+	EMB_ASSERT_EQUAL(sim::CanBus::errorCount(), 1);
+	EMB_ASSERT_EQUAL(sim::CanBus::tec(client), 7);
+	EMB_ASSERT_EQUAL(countFrames(0x581), 5);
+
+	// node with wrong bitrate does not take part in communication
+	sim::CanBus::reset(500000);
+	clientFrames.clear();
+	sim::CanBus::attach(CANA_BASE);
+	client = sim::CanBus::attachClient(onClientRx);
+	sim::CanBus::send(client, makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsRead, 0x5010, 0x01, 0));
+	runServers(serverA, serverB, 10);
+	EMB_ASSERT_EQUAL(sim::CanBus::tec(client), 128);	// no acknowledgment
+	EMB_ASSERT_EQUAL(countFrames(0x581), 0);
+
+	emb::trace::Recorder::clear();
+	serverA.disable();
+	serverB.disable();
+	sim::CanBus::reset(1000000);
+}
+
+
+void SimTest::UcanopenBenchmark()
+{
+	// server handlers: frames are delivered to CAN module directly, wall-clock time of ISR and run() is measured
+	sim::CanBus::reset(1000000);
+	CanA canA(mcu::gpio::Config(30, GPIO_30_CANRXA), mcu::gpio::Config(31, GPIO_31_CANTXA),
+			mcu::can::Bitrate::Bitrate1M, mcu::can::Mode::Normal);
+	ServerA server(ucanopen::NodeId(0x1), &canA, makeIpcFlags(4));
+	server.enable();
+
+	const uint64_t frameCount = 100000;
+	uint64_t isr_ns = 0;
+	uint64_t run_ns = 0;
+	sim::CanFrame rpdo = makeFrame(0x201, 8);
+	for (uint64_t i = 0; i < frameCount; ++i)
+	{
+		uint64_t t0 = wallclock_ns();
+		sim::Can::receive(CANA_BASE, rpdo);
+		uint64_t t1 = wallclock_ns();
+		server.run();
+		run_ns += wallclock_ns() - t1;
+		isr_ns += t1 - t0;
+	}
+	EMB_ASSERT_EQUAL(sim::Can::lostCount(CANA_BASE), 0);
+	printBench("onFrameReceived(rpdo)", frameCount, isr_ns);
+	printBench("_handleRpdo", frameCount, run_ns);
+
+	isr_ns = 0;
+	run_ns = 0;
+	uint64_t txCount = sim::Can::txCount(CANA_BASE);
+	sim::CanFrame rsdo = makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsRead, 0x5010, 0x01, 0);
+	for (uint64_t i = 0; i < frameCount; ++i)
+	{
+		uint64_t t0 = wallclock_ns();
+		sim::Can::receive(CANA_BASE, rsdo);
+		uint64_t t1 = wallclock_ns();
+		server.run();
+		run_ns += wallclock_ns() - t1;
+		isr_ns += t1 - t0;
+	}
+	EMB_ASSERT_EQUAL(sim::Can::txCount(CANA_BASE) - txCount, frameCount);	// every request is answered
+	printBench("onFrameReceived(rsdo)", frameCount, isr_ns);
+	printBench("_handleRsdo+_sendTsdo", frameCount, run_ns);
+
+	// periodic frames: heartbeat and all TPDOs are due on every call
+	run_ns = 0;
+	txCount = sim::Can::txCount(CANA_BASE);
+	const uint64_t periodicCalls = 20000;
+	for (uint64_t i = 0; i < periodicCalls; ++i)
+	{
+		sim::VirtualTime::advance_ms(1000);
+		uint64_t t0 = wallclock_ns();
+		server.run();
+		run_ns += wallclock_ns() - t0;
+	}
+	printBench("_sendPeriodic", sim::Can::txCount(CANA_BASE) - txCount, run_ns);
+
+	// bus: client floods server with RPDOs and SDO requests, throughput is limited by bus bitrate
+	CanB canB(mcu::gpio::Config(17, GPIO_17_CANRXB), mcu::gpio::Config(12, GPIO_12_CANTXB),
+			mcu::can::Bitrate::Bitrate1M, mcu::can::Mode::Normal);
+	ServerB serverB(ucanopen::NodeId(0x2), &canB, makeIpcFlags(16));
+	serverB.enable();
+	sim::CanBus::attach(CANA_BASE);
+	sim::CanBus::attach(CANB_BASE);
+	size_t client = sim::CanBus::attachClient(onClientRx);
+	clientFrames.clear();
+
+	const uint64_t busFrames = 20000;
+	for (uint64_t i = 0; i < busFrames; ++i)
+	{
+		sim::CanBus::send(client, (i % 4 == 3) ? rsdo : makeFrame(0x201 + 0x100 * (i % 3), 8));
+	}
+	uint64_t frames = sim::CanBus::frameCount();
+	uint64_t busy = sim::CanBus::busyCycles();
+	uint64_t simStart = sim::VirtualTime::now_ns();
+	uint64_t wallStart = wallclock_ns();
+	while (sim::CanBus::pending(client) != 0)
+	{
+		runServers(server, serverB, 1);
+	}
+	uint64_t sim_ns = sim::VirtualTime::now_ns() - simStart;
+	uint64_t wall_ns = wallclock_ns() - wallStart;
+	frames = sim::CanBus::frameCount() - frames;
+	busy = sim::CanBus::busyCycles() - busy;
+	EMB_ASSERT_EQUAL(countFrames(0x581), busFrames / 4);
+	EMB_ASSERT_EQUAL(sim::Can::lostCount(CANA_BASE), 0);
+
+	char str[160];
+	snprintf(str, sizeof(str), "[ BENCH  ] ucanopen bus 1Mbps: %llu frames/s simulated, load %llu%%, %llu wall ns per frame",
+			static_cast<unsigned long long>(frames * 1000000000 / sim_ns),
+			static_cast<unsigned long long>(busy * 100 / (sim_ns * (DEVICE_SYSCLK_FREQ / 1000000) / 1000)),
+			static_cast<unsigned long long>(wall_ns / frames));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+
+	server.disable();
+	serverB.disable();
+	sim::CanBus::reset(1000000);
+}
+
+
+void SimTest::OdIndexBenchmark()
+{
+	using ucanopen::ODIndex;
+	using ucanopen::ODEntry;
+
+	// application dictionary is valid, every entry is found by key
+	{
+		std::vector<ODEntry> dictionary(ucanopen::tests::objectDictionary,
+				ucanopen::tests::objectDictionary + ucanopen::tests::objectDictionaryLen);
+		std::vector<uint32_t> keys(dictionary.size());
+		ODIndex index;
+		EMB_ASSERT_TRUE(index.init(&dictionary[0], &keys[0], dictionary.size()));
+		EMB_ASSERT_TRUE(ODIndex::validate(&dictionary[0], dictionary.size(), &keys[0]));
+		EMB_ASSERT_TRUE(index.init(&dictionary[0], &keys[0], dictionary.size()));	// keys are rebuilt after scratch use
+		for (size_t i = 0; i < dictionary.size(); ++i)
+		{
+			EMB_ASSERT_TRUE(index.find(dictionary[i].key.index, dictionary[i].key.subindex) == &dictionary[i]);
+		}
+		EMB_ASSERT_TRUE(index.find(0x1008, 0x01) == NULL);
+		EMB_ASSERT_TRUE(index.find(0x0000, 0x00) == NULL);
+		EMB_ASSERT_TRUE(index.find(0xFFFF, 0xFF) == NULL);
+	}
+
+	// invalid dictionaries: duplicate key, duplicate name, access mismatch, subindex out of range
+	{
+		SyntheticOd od;
+		makeOd(od, 100);
+		ODIndex index;
+		EMB_ASSERT_TRUE(index.init(&od.entries[0], &od.keys[0], od.entries.size()));
+		EMB_ASSERT_TRUE(index.find(0x2001, 3)->key.subindex == 3);
+		EMB_ASSERT_TRUE(index.find(0x2001, 32) == NULL);
+		EMB_ASSERT_TRUE(validateOd(od));
+
+		od.entries[10].key = od.entries[50].key;
+		EMB_ASSERT_TRUE(!validateOd(od));
+		makeOd(od, 100);
+		od.entries[10].value.name = od.entries[50].value.name;
+		od.entries[10].value.category = od.entries[50].value.category;
+		EMB_ASSERT_TRUE(!validateOd(od));
+		makeOd(od, 100);
+		od.entries[10].value.accessRight = ucanopen::OD_ACCESS_RO;
+		EMB_ASSERT_TRUE(!validateOd(od));
+		makeOd(od, 100);
+		od.entries[10].key.subindex = 0x100;
+		EMB_ASSERT_TRUE(!validateOd(od));
+	}
+
+	// boot validation and SDO lookup latency for growing dictionaries
+	const size_t sizes[4] = {100, 500, 1000, 5000};
+	for (size_t k = 0; k < 4; ++k)
+	{
+		SyntheticOd od;
+		makeOd(od, sizes[k]);
+		ODEntry* dictionary = &od.entries[0];
+		const size_t len = od.entries.size();
+
+		uint64_t start = wallclock_ns();
+		ODIndex index;
+		EMB_ASSERT_TRUE(index.init(dictionary, &od.keys[0], len));
+		std::vector<uint32_t> scratch(len);
+		EMB_ASSERT_TRUE(ODIndex::validate(dictionary, len, &scratch[0]));	// debug boot check on sorted table
+		uint64_t init_ns = wallclock_ns() - start;
+
+		start = wallclock_ns();
+		EMB_ASSERT_TRUE(validatePairwise(dictionary, len));
+		uint64_t pairwise_ns = wallclock_ns() - start;
+
+		std::vector<ucanopen::ODEntryKeyAux> keys;
+		for (size_t i = 0; i < 4096; ++i)
+		{
+			const ODEntry& entry = dictionary[(i * 2654435761u) % len];
+			keys.push_back(ucanopen::ODEntryKeyAux(entry.key.index, entry.key.subindex));
+		}
+		const size_t lookupCount = 1000000;
+		size_t found = 0;
+		start = wallclock_ns();
+		for (size_t i = 0; i < lookupCount; ++i)
+		{
+			const ucanopen::ODEntryKeyAux& key = keys[i % keys.size()];
+			found += (emb::binary_find(dictionary, dictionary + len, key) != dictionary + len);
+		}
+		uint64_t entrySearch_ns = wallclock_ns() - start;
+		start = wallclock_ns();
+		for (size_t i = 0; i < lookupCount; ++i)
+		{
+			const ucanopen::ODEntryKeyAux& key = keys[i % keys.size()];
+			found += (index.find(key.index, key.subindex) != NULL);
+		}
+		uint64_t indexSearch_ns = wallclock_ns() - start;
+		EMB_ASSERT_EQUAL(found, 2 * lookupCount);
+
+		char str[192];
+		snprintf(str, sizeof(str), "[ BENCH  ] ucanopen OD %lu entries: boot validation %llu us (pairwise %llu us), SDO lookup %llu ns (entry table search %llu ns)",
+				static_cast<unsigned long>(len),
+				static_cast<unsigned long long>(init_ns / 1000), static_cast<unsigned long long>(pairwise_ns / 1000),
+				static_cast<unsigned long long>(indexSearch_ns / lookupCount),
+				static_cast<unsigned long long>(entrySearch_ns / lookupCount));
+		emb::TestRunner::print(str);
+		emb::TestRunner::print_nextline();
+	}
+}
+
+
+
+
+namespace {
+
+
+struct EdsObject
+{
+	std::string name;
+	unsigned int dataType;
+	std::string access;
+	std::string pdoMapping;
+};
+
+
+/// Reads VAR objects of EDS file: key (index << 8 | subindex) -> name, data type, access type, PDO mapping.
+std::map<uint32_t, EdsObject> readEds(const char* path)
+{
+	std::map<uint32_t, EdsObject> objects;
+	std::ifstream file(path);
+	std::string line;
+	uint32_t key = 0;
+	bool object = false;
+	while (std::getline(file, line))
+	{
+		if (!line.empty() && (line[line.size()-1] == '\r')) line.erase(line.size() - 1);
+		if (line.empty() || (line[0] == ';')) continue;
+		if (line[0] == '[')
+		{
+			std::string section = line.substr(1, line.find(']') - 1);
+			size_t sub = section.find("sub");
+			std::string indexStr = section.substr(0, sub);
+			char* end = NULL;
+			uint32_t index = strtoul(indexStr.c_str(), &end, 16);
+			object = (section.size() >= 4) && (*end == '\0');
+			key = (sub == std::string::npos) ? (index << 8) : ((index << 8) | strtoul(section.substr(sub + 3).c_str(), NULL, 16));
+			continue;
+		}
+		size_t eq = line.find('=');
+		if (!object || (eq == std::string::npos)) continue;
+		std::string name = line.substr(0, eq);
+		std::string value = line.substr(eq + 1);
+		if (name == "ParameterName") objects[key].name = value;
+		else if (name == "DataType") objects[key].dataType = strtoul(value.c_str(), NULL, 0);
+		else if (name == "AccessType") objects[key].access = value;
+		else if (name == "PDOMapping") objects[key].pdoMapping = value;
+		else if ((name == "ObjectType") && (value != "0x7")) objects.erase(key);	// RECORD header
+	}
+	return objects;
+}
+
+
+} // namespace
+
+
+void SimTest::OdGeneratorTest()
+{
+	using ucanopen::ODIndex;
+	using ucanopen::ODEntry;
+	using ucanopen::tests::objectDictionary;
+	using ucanopen::tests::objectDictionaryKeys;
+	using ucanopen::tests::objectDictionaryLen;
+
+	// generated table is sorted, valid and its key index matches entries
+	std::vector<uint32_t> scratch(objectDictionaryLen);
+	EMB_ASSERT_TRUE(ODIndex::validate(objectDictionary, objectDictionaryLen, &scratch[0]));
+	for (size_t i = 0; i < objectDictionaryLen; ++i)
+	{
+		EMB_ASSERT_EQUAL(objectDictionaryKeys[i], ODIndex::key(objectDictionary[i].key.index, objectDictionary[i].key.subindex));
+	}
+	ODIndex index;
+	EMB_ASSERT_TRUE(index.init(ucanopen::ODTable(objectDictionary, objectDictionaryKeys, objectDictionaryLen)));
+	for (size_t i = 0; i < objectDictionaryLen; ++i)
+	{
+		EMB_ASSERT_TRUE(index.find(objectDictionary[i].key.index, objectDictionary[i].key.subindex) == &objectDictionary[i]);
+	}
+
+	// round trip: EDS generated from the same description describes every compiled entry and nothing else
+	// besides PDO communication and mapping parameters served by server: 4 + 9 + 5 + 9 subobjects per PDO number
+	const unsigned int edsDataTypes[10] = {0x0001, 0x0003, 0x0004, 0x0006, 0x0007, 0x0008, 0x0006, 0x0007, 0x0009, 0x000F};
+	const char* edsAccessTypes[3] = {"rw", "ro", "wo"};
+	const bool pdoMappableTypes[10] = {true, true, true, true, true, true, true, false, false, false};
+	std::map<uint32_t, EdsObject> eds = readEds(SIM_UCANOPEN_TESTS_EDS);
+	size_t pdoParameters = 0;
+	for (std::map<uint32_t, EdsObject>::iterator it = eds.begin(); it != eds.end();)
+	{
+		uint32_t base = (it->first >> 8) & 0xFF00;
+		bool pdoParameter = (((it->first >> 8) & 0xFF) < 4)
+				&& ((base == 0x1400) || (base == 0x1600) || (base == 0x1800) || (base == 0x1A00));
+		if (!pdoParameter)
+		{
+			++it;
+			continue;
+		}
+		EMB_ASSERT_TRUE(it->second.pdoMapping == "0");
+		eds.erase(it++);
+		++pdoParameters;
+	}
+	EMB_ASSERT_EQUAL(pdoParameters, 4 * (4 + 9 + 5 + 9));
+	EMB_ASSERT_EQUAL(eds.size(), objectDictionaryLen);
+	for (size_t i = 0; i < objectDictionaryLen; ++i)
+	{
+		const ODEntry& entry = objectDictionary[i];
+		std::map<uint32_t, EdsObject>::const_iterator object = eds.find(objectDictionaryKeys[i]);
+		EMB_ASSERT_TRUE(object != eds.end());
+		EMB_ASSERT_TRUE(object->second.name == std::string(entry.value.category) + "." + entry.value.subcategory + "." + entry.value.name);
+		EMB_ASSERT_EQUAL(object->second.dataType, edsDataTypes[entry.value.dataType]);
+		EMB_ASSERT_TRUE(object->second.access == edsAccessTypes[entry.value.accessRight]);
+		bool pdoMappable = (entry.value.dataPtr != OD_NO_DIRECT_ACCESS) && pdoMappableTypes[entry.value.dataType];
+		EMB_ASSERT_TRUE(object->second.pdoMapping == (pdoMappable ? "1" : "0"));
+	}
+
+	// boot cost: generated table is used as is, hand-written table is copied to RAM, sorted, indexed and validated
+	const size_t initCount = 10000;
+	uint64_t start = wallclock_ns();
+	for (size_t i = 0; i < initCount; ++i)
+	{
+		ODIndex generated;
+		EMB_ASSERT_TRUE(generated.init(ucanopen::ODTable(objectDictionary, objectDictionaryKeys, objectDictionaryLen)));
+	}
+	uint64_t generated_ns = wallclock_ns() - start;
+
+	std::vector<ODEntry> handWritten(objectDictionary, objectDictionary + objectDictionaryLen);
+	std::reverse(handWritten.begin(), handWritten.end());
+	start = wallclock_ns();
+	for (size_t i = 0; i < initCount; ++i)
+	{
+		std::vector<ODEntry> dictionary(handWritten);
+		ODIndex runtime;
+		EMB_ASSERT_TRUE(runtime.init(ucanopen::ODTable(&dictionary[0], &scratch[0], dictionary.size())));
+		EMB_ASSERT_TRUE(ODIndex::validate(&dictionary[0], dictionary.size(), &scratch[0]));
+	}
+	uint64_t runtime_ns = wallclock_ns() - start;
+
+	char str[160];
+	snprintf(str, sizeof(str), "[ BENCH  ] ucanopen OD %lu entries: generated table init %llu ns, runtime sort and validation %llu ns, RAM %lu bytes saved",
+			static_cast<unsigned long>(objectDictionaryLen),
+			static_cast<unsigned long long>(generated_ns / initCount),
+			static_cast<unsigned long long>(runtime_ns / initCount),
+			static_cast<unsigned long>(objectDictionaryLen * (sizeof(ODEntry) + sizeof(uint32_t))));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+namespace {
+
+
+/// Host SDO client: reacts to server responses in bus RX callback as PC tool does, one transfer at a time.
+struct SdoClient
+{
+	enum Mode
+	{
+		Expedited,
+		Segmented,
+		Block
+	};
+
+	enum Phase
+	{
+		Initiating,
+		Transferring,
+		Ending,
+		Done
+	};
+
+	size_t node;
+	Mode mode;
+	bool upload;
+	bool crc;
+	uint32_t index;
+	uint32_t subindex;
+	std::vector<uint8_t> data;	// download source, upload result
+	Phase phase;
+	size_t size;
+	size_t offset;			// octets acknowledged
+	bool toggle;
+	bool lastSent;
+	unsigned int blockSize;
+	unsigned int seqno;		// block upload: last segment received in order; block download: segments sent
+	size_t requests;		// expedited: reads left
+	size_t dropSegment;		// block upload: sequence number of segment to lose once, 0 - none
+	uint16_t wrongCrc;		// block download: value added to CRC
+	uint32_t abortCode;
+	uint64_t doneTime_ns;
+	uint64_t frames;
+};
+
+
+SdoClient sdoClient;
+
+
+sim::CanFrame makeRawFrame(uint32_t id, const uint8_t* octets)
+{
+	sim::CanFrame frame = makeFrame(id, 8);
+	for (size_t i = 0; i < 8; ++i)
+	{
+		frame.data[i] = octets[i];
+	}
+	return frame;
+}
+
+
+void sdoSend(uint8_t b0, uint32_t b1, uint32_t b2, uint32_t b3, uint32_t value)
+{
+	const uint8_t octets[8] = {b0, static_cast<uint8_t>(b1), static_cast<uint8_t>(b2), static_cast<uint8_t>(b3),
+			static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+			static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)};
+	sim::CanBus::send(sdoClient.node, makeRawFrame(0x601, octets));
+	++sdoClient.frames;
+}
+
+
+void sdoSendRequest(uint8_t command, uint32_t value)
+{
+	sdoSend(command, sdoClient.index & 0xFF, sdoClient.index >> 8, sdoClient.subindex, value);
+}
+
+
+uint16_t sdoCrc(const std::vector<uint8_t>& data, size_t len)
+{
+	return len ? emb::crc16_ccitt(&data[0], len, 0) : 0;
+}
+
+
+void sdoSendSegment(uint8_t command, size_t pos, size_t len)
+{
+	uint8_t octets[8] = {command, 0, 0, 0, 0, 0, 0, 0};
+	for (size_t i = 0; i < len; ++i)
+	{
+		octets[1+i] = sdoClient.data[pos + i];
+	}
+	sim::CanBus::send(sdoClient.node, makeRawFrame(0x601, octets));
+	++sdoClient.frames;
+}
+
+
+void sdoSendSubBlock()
+{
+	for (sdoClient.seqno = 1; sdoClient.seqno <= sdoClient.blockSize; ++sdoClient.seqno)
+	{
+		size_t pos = sdoClient.offset + (sdoClient.seqno - 1) * 7;
+		size_t len = std::min<size_t>(7, sdoClient.data.size() - pos);
+		sdoClient.lastSent = (pos + len == sdoClient.data.size());
+		sdoSendSegment((sdoClient.lastSent ? 0x80 : 0x00) | sdoClient.seqno, pos, len);
+		if (sdoClient.lastSent) break;
+	}
+}
+
+
+void sdoStart(SdoClient::Mode mode, bool upload, uint32_t index, uint32_t subindex, const std::vector<uint8_t>& data,
+		bool crc = true)
+{
+	size_t node = sdoClient.node;
+	sdoClient = SdoClient();
+	sdoClient.node = node;
+	sdoClient.mode = mode;
+	sdoClient.upload = upload;
+	sdoClient.crc = crc;
+	sdoClient.index = index;
+	sdoClient.subindex = subindex;
+	sdoClient.data = data;
+	sdoClient.phase = SdoClient::Initiating;
+	sdoClient.blockSize = 127;
+
+	switch (mode)
+	{
+	case SdoClient::Expedited:
+		sdoClient.requests = data.size() / 4;
+		sdoSendRequest(0x40, 0);
+		break;
+	case SdoClient::Segmented:
+		sdoSendRequest(upload ? 0x40 : 0x21, upload ? 0 : data.size());
+		break;
+	case SdoClient::Block:
+		if (upload)
+		{
+			sdoSend(0xA0 | (crc ? 0x04 : 0x00), index & 0xFF, index >> 8, subindex, sdoClient.blockSize);
+		}
+		else
+		{
+			sdoSendRequest(0xC2 | (crc ? 0x04 : 0x00), data.size());
+		}
+		break;
+	}
+}
+
+
+void sdoFinish()
+{
+	sdoClient.phase = SdoClient::Done;
+	sdoClient.doneTime_ns = sim::VirtualTime::now_ns();
+}
+
+
+void onSdoResponse(const uint8_t* r)
+{
+	uint32_t value = r[4] | (r[5] << 8) | (r[6] << 16) | (static_cast<uint32_t>(r[7]) << 24);
+	bool blockSegment = (sdoClient.mode == SdoClient::Block) && sdoClient.upload && (sdoClient.phase == SdoClient::Transferring);
+	if ((r[0] == 0x80) && !blockSegment)
+	{
+		sdoClient.abortCode = value;
+		sdoFinish();
+		return;
+	}
+
+	switch (sdoClient.mode)
+	{
+	case SdoClient::Expedited:
+		for (size_t i = 0; i < 4; ++i)
+		{
+			sdoClient.data[sdoClient.offset++] = r[4+i];
+		}
+		if (--sdoClient.requests == 0)
+		{
+			sdoFinish();
+			return;
+		}
+		sdoSendRequest(0x40, 0);
+		return;
+
+	case SdoClient::Segmented:
+		if (sdoClient.upload)
+		{
+			if (sdoClient.phase == SdoClient::Initiating)
+			{
+				EMB_ASSERT_EQUAL(r[0], 0x41);
+				sdoClient.size = value;
+				sdoClient.data.clear();
+				sdoClient.phase = SdoClient::Transferring;
+			}
+			else
+			{
+				EMB_ASSERT_EQUAL(r[0] & 0xF0, sdoClient.toggle ? 0x10 : 0x00);
+				sdoClient.data.insert(sdoClient.data.end(), r + 1, r + 8 - ((r[0] >> 1) & 0x07));
+				sdoClient.toggle = !sdoClient.toggle;
+				if ((r[0] & 0x01) != 0)
+				{
+					sdoFinish();
+					return;
+				}
+			}
+			sdoSendRequest(0x60 | (sdoClient.toggle ? 0x10 : 0x00), 0);
+		}
+		else
+		{
+			if (sdoClient.lastSent)
+			{
+				sdoFinish();
+				return;
+			}
+			size_t len = std::min<size_t>(7, sdoClient.data.size() - sdoClient.offset);
+			sdoClient.lastSent = (sdoClient.offset + len == sdoClient.data.size());
+			sdoSendSegment((sdoClient.toggle ? 0x10 : 0x00) | ((7 - len) << 1) | (sdoClient.lastSent ? 0x01 : 0x00),
+					sdoClient.offset, len);
+			sdoClient.offset += len;
+			sdoClient.toggle = !sdoClient.toggle;
+		}
+		return;
+
+	case SdoClient::Block:
+		if (sdoClient.upload)
+		{
+			if (sdoClient.phase == SdoClient::Initiating)
+			{
+				EMB_ASSERT_EQUAL(r[0] & 0xE3, 0xC2);
+				sdoClient.size = value;
+				sdoClient.data.clear();
+				sdoClient.phase = SdoClient::Transferring;
+				sdoSend(0xA3, 0, 0, 0, 0);
+			}
+			else if (sdoClient.phase == SdoClient::Transferring)
+			{
+				unsigned int seqno = r[0] & 0x7F;
+				bool last = (r[0] & 0x80) != 0;
+				if (seqno == sdoClient.dropSegment)
+				{
+					sdoClient.dropSegment = 0;	// frame is lost once
+				}
+				else if (seqno == sdoClient.seqno + 1)
+				{
+					sdoClient.data.insert(sdoClient.data.end(), r + 1, r + 8);
+					sdoClient.seqno = seqno;
+					sdoClient.lastSent = last;
+				}
+				if (last || (seqno == sdoClient.blockSize))
+				{
+					sdoSend(0xA2, sdoClient.seqno, sdoClient.blockSize, 0, 0);
+					sdoClient.phase = sdoClient.lastSent ? SdoClient::Ending : SdoClient::Transferring;
+					sdoClient.seqno = 0;
+				}
+			}
+			else
+			{
+				EMB_ASSERT_EQUAL(r[0] & 0xE3, 0xC1);
+				sdoClient.data.resize(sdoClient.data.size() - ((r[0] >> 2) & 0x07));
+				EMB_ASSERT_EQUAL(sdoClient.data.size(), sdoClient.size);
+				if (sdoClient.crc)
+				{
+					EMB_ASSERT_EQUAL(r[1] | (r[2] << 8), sdoCrc(sdoClient.data, sdoClient.data.size()));
+				}
+				sdoSend(0xA1, 0, 0, 0, 0);
+				sdoFinish();
+			}
+		}
+		else
+		{
+			if (sdoClient.phase == SdoClient::Initiating)
+			{
+				EMB_ASSERT_EQUAL(r[0] & 0xE3, 0xA0);
+				sdoClient.blockSize = r[4];
+				sdoClient.phase = SdoClient::Transferring;
+				sdoSendSubBlock();
+			}
+			else if (sdoClient.phase == SdoClient::Transferring)
+			{
+				EMB_ASSERT_EQUAL(r[0], 0xA2);
+				size_t acked = std::min<size_t>(r[1] * 7, sdoClient.data.size() - sdoClient.offset);
+				bool complete = sdoClient.lastSent && (r[1] == sdoClient.seqno);
+				sdoClient.offset += acked;
+				sdoClient.blockSize = r[2];
+				if (!complete)
+				{
+					sdoSendSubBlock();
+					return;
+				}
+				size_t lastLen = sdoClient.data.empty() ? 0 : (sdoClient.data.size() - 1) % 7 + 1;
+				uint16_t crc = sdoCrc(sdoClient.data, sdoClient.data.size()) + sdoClient.wrongCrc;
+				sdoSend(0xC1 | ((7 - lastLen) << 2), crc & 0xFF, crc >> 8, 0, 0);
+				sdoClient.phase = SdoClient::Ending;
+			}
+			else
+			{
+				EMB_ASSERT_EQUAL(r[0], 0xA1);
+				sdoFinish();
+			}
+		}
+		return;
+	}
+}
+
+
+void onSdoClientRx(size_t node, const sim::CanFrame& frame)
+{
+	if ((frame.id != 0x581) || (sdoClient.phase == SdoClient::Done)) return;
+	++sdoClient.frames;
+	uint8_t octets[8];
+	for (size_t i = 0; i < 8; ++i)
+	{
+		octets[i] = frame.data[i];
+	}
+	onSdoResponse(octets);
+}
+
+
+/// Runs servers until client transfer is done, returns transfer time.
+uint64_t runTransfer(ServerA& serverA, ServerB& serverB, uint64_t start_ns)
+{
+	for (size_t i = 0; (i < 10000) && (sdoClient.phase != SdoClient::Done); ++i)
+	{
+		runServers(serverA, serverB, 1);
+	}
+	EMB_ASSERT_TRUE(sdoClient.phase == SdoClient::Done);
+	return sdoClient.doneTime_ns - start_ns;
+}
+
+
+std::vector<uint8_t> domainContents(const ucanopen::ODDomain& domain)
+{
+	std::vector<uint8_t> data;
+	for (size_t i = 0; i < domain.size; ++i)
+	{
+		data.push_back(domain.octet(i));
+	}
+	return data;
+}
+
+
+} // namespace
+
+
+void SimTest::SdoTransferBenchmark()
+{
+	using ucanopen::tests::od::configBlob;
+	namespace abort_codes = ucanopen::sdo_abort_codes;
+
+	sim::CanBus::reset(1000000);
+	CanA canA(mcu::gpio::Config(30, GPIO_30_CANRXA), mcu::gpio::Config(31, GPIO_31_CANTXA),
+			mcu::can::Bitrate::Bitrate1M, mcu::can::Mode::Normal);
+	CanB canB(mcu::gpio::Config(17, GPIO_17_CANRXB), mcu::gpio::Config(12, GPIO_12_CANTXB),
+			mcu::can::Bitrate::Bitrate1M, mcu::can::Mode::Normal);
+	ServerA serverA(ucanopen::NodeId(0x1), &canA, makeIpcFlags(4));
+	ServerB serverB(ucanopen::NodeId(0x2), &canB, makeIpcFlags(16));
+	sim::CanBus::attach(CANA_BASE);
+	sim::CanBus::attach(CANB_BASE);
+	sdoClient.node = sim::CanBus::attachClient(onSdoClientRx);
+	serverA.enable();
+	serverB.enable();
+
+	std::vector<uint8_t> pattern(configBlob.capacity);
+	for (size_t i = 0; i < pattern.size(); ++i)
+	{
+		pattern[i] = (i * 7 + 3) & 0xFF;
+		configBlob.setOctet(i, pattern[i]);
+	}
+	configBlob.size = configBlob.capacity;
+	std::vector<uint8_t> data(configBlob.capacity);
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = (i * 13 + 1) & 0xFF;
+	}
+
+	// uploads and downloads: data are equal, odd sizes leave unused octets in last segment
+	sdoStart(SdoClient::Segmented, true, 0x5020, 0x00, std::vector<uint8_t>());
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, 0);
+	EMB_ASSERT_TRUE(sdoClient.data == pattern);
+
+	sdoStart(SdoClient::Block, true, 0x5020, 0x00, std::vector<uint8_t>());
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, 0);
+	EMB_ASSERT_TRUE(sdoClient.data == pattern);
+
+	sdoStart(SdoClient::Segmented, false, 0x5020, 0x00, std::vector<uint8_t>(data.begin(), data.begin() + 100));
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, 0);
+	EMB_ASSERT_TRUE(domainContents(configBlob) == std::vector<uint8_t>(data.begin(), data.begin() + 100));
+
+	sdoStart(SdoClient::Block, false, 0x5020, 0x00, std::vector<uint8_t>(data.begin(), data.begin() + 1000));
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, 0);
+	EMB_ASSERT_TRUE(domainContents(configBlob) == std::vector<uint8_t>(data.begin(), data.begin() + 1000));
+
+	sdoStart(SdoClient::Block, true, 0x5020, 0x00, std::vector<uint8_t>());
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_TRUE(sdoClient.data == std::vector<uint8_t>(data.begin(), data.begin() + 1000));
+
+	// lost block upload segment: client acknowledges segments received in order, server repeats the rest
+	sdoStart(SdoClient::Block, true, 0x5020, 0x00, std::vector<uint8_t>());
+	sdoClient.dropSegment = 50;
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, 0);
+	EMB_ASSERT_TRUE(sdoClient.data == std::vector<uint8_t>(data.begin(), data.begin() + 1000));
+
+	// errors: CRC mismatch, size above capacity, block transfer of basic object, unknown object
+	sdoStart(SdoClient::Block, false, 0x5020, 0x00, pattern);
+	sdoClient.wrongCrc = 1;
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, abort_codes::crcError);
+	EMB_ASSERT_EQUAL(configBlob.size, 1000);	// domain size is set by completed download only
+
+	sdoStart(SdoClient::Segmented, false, 0x5020, 0x00, std::vector<uint8_t>(configBlob.capacity + 1));
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, abort_codes::lengthTooHigh);
+
+	sdoStart(SdoClient::Block, true, 0x5010, 0x01, std::vector<uint8_t>());
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, abort_codes::unsupportedAccess);
+
+	sdoStart(SdoClient::Block, true, 0x5040, 0x00, std::vector<uint8_t>());
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, abort_codes::objectNotFound);
+
+	// toggle bit error
+	sdoStart(SdoClient::Segmented, true, 0x5020, 0x00, std::vector<uint8_t>());
+	sdoClient.toggle = true;
+	runTransfer(serverA, serverB, sim::VirtualTime::now_ns());
+	EMB_ASSERT_EQUAL(sdoClient.abortCode, abort_codes::toggleBit);
+
+	// transfer is aborted by server if client does not continue it
+	clientFrames.clear();
+	sim::CanBus::attachClient(onClientRx);
+	sdoStart(SdoClient::Segmented, true, 0x5020, 0x00, std::vector<uint8_t>());
+	sdoClient.phase = SdoClient::Done;	// client disappears
+	runServers(serverA, serverB, 1100);
+	EMB_ASSERT_EQUAL(countFrames(0x581), 2);
+	EMB_ASSERT_EQUAL(sdoValue(lastFrame(0x581)->frame), abort_codes::timeout);
+
+	// throughput at 1 Mbit/s: 1024 octets, expedited transfer reads 4-octet object
+	const char* names[3] = {"expedited", "segmented", "block"};
+	for (size_t mode = SdoClient::Expedited; mode <= SdoClient::Block; ++mode)
+	{
+		uint64_t bytesPerSecond[2] = {0, 0};
+		uint64_t frames[2] = {0, 0};
+		for (size_t upload = 0; upload < 2; ++upload)
+		{
+			if ((mode == SdoClient::Expedited) && !upload) continue;
+			configBlob.size = configBlob.capacity;
+			uint64_t start = sim::VirtualTime::now_ns();
+			sdoStart(static_cast<SdoClient::Mode>(mode), upload, (mode == SdoClient::Expedited) ? 0x5010 : 0x5020,
+					(mode == SdoClient::Expedited) ? 0x01 : 0x00, upload ? pattern : data);
+			uint64_t ns = runTransfer(serverA, serverB, start);
+			EMB_ASSERT_EQUAL(sdoClient.abortCode, 0);
+			bytesPerSecond[upload] = pattern.size() * 1000000000 / ns;
+			frames[upload] = sdoClient.frames;
+		}
+		EMB_ASSERT_TRUE((mode == SdoClient::Expedited) || (domainContents(configBlob) == data));
+
+		char str[160];
+		int len = snprintf(str, sizeof(str), "[ BENCH  ] ucanopen SDO %s 1Mbps: upload %llu B/s (%llu frames)",
+				names[mode], static_cast<unsigned long long>(bytesPerSecond[1]), static_cast<unsigned long long>(frames[1]));
+		if (mode != SdoClient::Expedited)
+		{
+			snprintf(str + len, sizeof(str) - len, ", download %llu B/s (%llu frames)",
+					static_cast<unsigned long long>(bytesPerSecond[0]), static_cast<unsigned long long>(frames[0]));
+		}
+		emb::TestRunner::print(str);
+		emb::TestRunner::print_nextline();
+	}
+
+	serverA.disable();
+	serverB.disable();
+	sim::CanBus::reset(1000000);
+}
+namespace {
+
+
+/// Expedited SDO write by client node, returns true if write is confirmed.
+bool pdoSdoWrite(size_t client, ServerA& serverA, ServerB& serverB, uint32_t index, uint32_t subindex, uint32_t value)
+{
+	size_t responses = countFrames(0x581);
+	sim::CanBus::send(client, makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsWrite, index, subindex, value));
+	runServers(serverA, serverB, 2);
+	return (countFrames(0x581) == responses + 1)
+			&& ((lastFrame(0x581)->frame.data[0] >> 5) == ucanopen::cs_codes::sdoScsWrite);
+}
+
+
+uint32_t pdoSdoRead(size_t client, ServerA& serverA, ServerB& serverB, uint32_t index, uint32_t subindex)
+{
+	size_t responses = countFrames(0x581);
+	sim::CanBus::send(client, makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsRead, index, subindex, 0));
+	runServers(serverA, serverB, 2);
+	EMB_ASSERT_EQUAL(countFrames(0x581), responses + 1);
+	return sdoValue(lastFrame(0x581)->frame);
+}
+
+
+/// Maps objects by SDO as configuration tool does: disable, write parameters, enable.
+bool pdoSdoMap(size_t client, ServerA& serverA, ServerB& serverB, uint32_t index,
+		const uint32_t* parameters, unsigned int count)
+{
+	bool ok = pdoSdoWrite(client, serverA, serverB, index, 0, 0);
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		ok = pdoSdoWrite(client, serverA, serverB, index, i + 1, parameters[i]) && ok;
+	}
+	return pdoSdoWrite(client, serverA, serverB, index, 0, count) && ok;
+}
+
+
+uint64_t frameBits(const sim::CanFrame& frame)
+{
+	uint64_t bits = 0;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		bits |= static_cast<uint64_t>(frame.data[i] & 0xFF) << (8 * i);
+	}
+	return bits;
+}
+
+
+size_t countDataFrames(uint32_t id, size_t from)
+{
+	size_t count = 0;
+	for (size_t i = from; i < clientFrames.size(); ++i)
+	{
+		if ((clientFrames[i].frame.id == id) && !clientFrames[i].frame.remote) ++count;
+	}
+	return count;
+}
+
+
+/// Pack without compiled program: entry lookup and switch on data type for every field.
+void packByLookup(const ucanopen::ODIndex& odIndex, const uint32_t* parameters, unsigned int count,
+		ucanopen::can_payload& payload)
+{
+	uint64_t frame = 0;
+	unsigned int offset = 0;
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const ucanopen::ODEntry* entry = odIndex.find(parameters[i] >> 16, (parameters[i] >> 8) & 0xFF);
+		unsigned int length = parameters[i] & 0xFF;
+		uint32_t value = 0;
+		switch (entry->value.dataType)
+		{
+		case ucanopen::OD_BOOL:
+			value = *reinterpret_cast<bool*>(entry->value.dataPtr);
+			break;
+		case ucanopen::OD_INT16:
+		case ucanopen::OD_UINT16:
+		case ucanopen::OD_ENUM16:
+			value = *reinterpret_cast<uint16_t*>(entry->value.dataPtr);
+			break;
+		default:
+			value = *entry->value.dataPtr;
+			break;
+		}
+		frame |= static_cast<uint64_t>(value & (0xFFFFFFFF >> (32 - length))) << offset;
+		offset += length;
+	}
+	for (size_t i = 0; i < payload.size(); ++i)
+	{
+		payload[i] = (frame >> (8 * i)) & 0xFF;
+	}
+}
+
+
+} // namespace
+
+
+void SimTest::PdoMappingBenchmark()
+{
+	using ucanopen::pdoMappingParameter;
+	using ucanopen::tests::od::pdoDemo;
+	namespace transmission = ucanopen::pdo_transmission;
+
+	sim::CanBus::reset(1000000);
+	CanA canA(mcu::gpio::Config(30, GPIO_30_CANRXA), mcu::gpio::Config(31, GPIO_31_CANTXA),
+			mcu::can::Bitrate::Bitrate1M, mcu::can::Mode::Normal);
+	CanB canB(mcu::gpio::Config(17, GPIO_17_CANRXB), mcu::gpio::Config(12, GPIO_12_CANTXB),
+			mcu::can::Bitrate::Bitrate1M, mcu::can::Mode::Normal);
+	ServerA serverA(ucanopen::NodeId(0x1), &canA, makeIpcFlags(4));
+	ServerB serverB(ucanopen::NodeId(0x2), &canB, makeIpcFlags(16));
+	sim::CanBus::attach(CANA_BASE);
+	sim::CanBus::attach(CANB_BASE);
+	size_t client = sim::CanBus::attachClient(onClientRx);
+	serverA.enable();
+	serverB.enable();
+	clientFrames.clear();
+
+	const uint32_t flag = pdoMappingParameter(0x5030, 0x00, 1);
+	const uint32_t counter = pdoMappingParameter(0x5030, 0x01, 16);
+	const uint32_t offset = pdoMappingParameter(0x5030, 0x02, 16);
+	const uint32_t position24 = pdoMappingParameter(0x5030, 0x03, 24);
+	const uint32_t position = pdoMappingParameter(0x5030, 0x03, 32);
+	const uint32_t status = pdoMappingParameter(0x5030, 0x04, 32);
+	const uint32_t speed = pdoMappingParameter(0x5030, 0x05, 32);
+	const uint32_t uptime = pdoMappingParameter(0x5000, 0x00, 32);
+
+	// invalid mappings are rejected, mapping can not be changed while it is enabled
+	EMB_ASSERT_TRUE(!pdoSdoMap(client, serverA, serverB, 0x1A00, &uptime, 1));			// no direct access
+	const uint32_t tooLong[3] = {position, speed, counter};
+	EMB_ASSERT_TRUE(!pdoSdoMap(client, serverA, serverB, 0x1A00, tooLong, 3));
+	const uint32_t dummy = pdoMappingParameter(0x0005, 0x00, 8);
+	EMB_ASSERT_TRUE(!pdoSdoMap(client, serverA, serverB, 0x1A00, &dummy, 1));			// dummy is RPDO only
+	const uint32_t shortFloat = pdoMappingParameter(0x5030, 0x05, 16);
+	EMB_ASSERT_TRUE(!pdoSdoMap(client, serverA, serverB, 0x1A00, &shortFloat, 1));
+	EMB_ASSERT_EQUAL(pdoSdoRead(client, serverA, serverB, 0x1A00, 0), 0);
+
+	// TPDO1: on change with 10 ms inhibit time
+	const uint32_t tpdo1[4] = {flag, counter, offset, position24};
+	EMB_ASSERT_TRUE(pdoSdoMap(client, serverA, serverB, 0x1A00, tpdo1, 4));
+	EMB_ASSERT_TRUE(!pdoSdoWrite(client, serverA, serverB, 0x1A00, 1, counter));
+	EMB_ASSERT_EQUAL(pdoSdoRead(client, serverA, serverB, 0x1A00, 0), 4);
+	EMB_ASSERT_EQUAL(pdoSdoRead(client, serverA, serverB, 0x1A00, 3), offset);
+	EMB_ASSERT_TRUE(pdoSdoWrite(client, serverA, serverB, 0x1800, 3, 100));
+	EMB_ASSERT_TRUE(pdoSdoWrite(client, serverA, serverB, 0x1800, 5, 0));
+	EMB_ASSERT_TRUE(pdoSdoWrite(client, serverA, serverB, 0x1800, 2, transmission::onChange));
+	EMB_ASSERT_TRUE(!pdoSdoWrite(client, serverA, serverB, 0x1800, 2, 0xF1));
+
+	pdoDemo.flag = true;
+	pdoDemo.counter = 0x1234;
+	pdoDemo.offset = -2;
+	pdoDemo.position = -3;
+	runServers(serverA, serverB, 20);
+	const ReceivedFrame* tpdo = lastFrame(0x181);
+	EMB_ASSERT_TRUE(tpdo != NULL);
+	EMB_ASSERT_EQUAL(tpdo->frame.len, 8);	// 57 bits
+	EMB_ASSERT_EQUAL(frameBits(tpdo->frame), 1 | (0x1234ULL << 1) | (0xFFFEULL << 17) | (0xFFFFFDULL << 33));
+
+	size_t from = clientFrames.size();
+	runServers(serverA, serverB, 100);
+	EMB_ASSERT_EQUAL(countDataFrames(0x181, from), 0);			// no change - no frames
+	from = clientFrames.size();
+	for (size_t i = 0; i < 100; ++i)
+	{
+		++pdoDemo.counter;
+		runServers(serverA, serverB, 1);
+	}
+	EMB_ASSERT_TRUE(countDataFrames(0x181, from) >= 9);
+	EMB_ASSERT_TRUE(countDataFrames(0x181, from) <= 11);
+	from = clientFrames.size();
+	EMB_ASSERT_TRUE(pdoSdoWrite(client, serverA, serverB, 0x1800, 5, 20));	// event timer
+	runServers(serverA, serverB, 100);
+	EMB_ASSERT_TRUE(countDataFrames(0x181, from) >= 4);
+	EMB_ASSERT_TRUE(countDataFrames(0x181, from) <= 6);
+
+	// invalid COB-ID disables TPDO
+	EMB_ASSERT_TRUE(pdoSdoWrite(client, serverA, serverB, 0x1800, 1, ucanopen::pdoCobIdInvalid | 0x181));
+	from = clientFrames.size();
+	for (size_t i = 0; i < 50; ++i)
+	{
+		++pdoDemo.counter;
+		runServers(serverA, serverB, 1);
+	}
+	EMB_ASSERT_EQUAL(countDataFrames(0x181, from), 0);
+	EMB_ASSERT_TRUE(pdoSdoWrite(client, serverA, serverB, 0x1800, 1, 0x181));
+
+	// TPDO2: every 2nd SYNC, TPDO4: sampled on SYNC, sent on RTR; TPDO3: sampled and sent on RTR
+	EMB_ASSERT_TRUE(pdoSdoMap(client, serverA, serverB, 0x1A01, &status, 1));
+	EMB_ASSERT_TRUE(pdoSdoWrite(client, serverA, serverB, 0x1801, 2, 2));
+	EMB_ASSERT_TRUE(pdoSdoMap(client, serverA, serverB, 0x1A02, &speed, 1));
+	EMB_ASSERT_TRUE(pdoSdoWrite(client, serverA, serverB, 0x1802, 2, transmission::rtrEvent));
+	EMB_ASSERT_TRUE(pdoSdoMap(client, serverA, serverB, 0x1A03, &position, 1));
+	EMB_ASSERT_TRUE(pdoSdoWrite(client, serverA, serverB, 0x1803, 2, transmission::rtrSync));
+
+	from = clientFrames.size();
+	runServers(serverA, serverB, 300);
+	EMB_ASSERT_EQUAL(countDataFrames(0x281, from) + countDataFrames(0x381, from) + countDataFrames(0x481, from), 0);
+
+	sim::CanFrame sync = makeFrame(0x080, 0);
+	pdoDemo.status = 0xCAFE0001;
+	pdoDemo.position = 1;
+	for (size_t i = 0; i < 10; ++i)
+	{
+		sim::CanBus::send(client, sync);
+		runServers(serverA, serverB, 1);
+	}
+	EMB_ASSERT_EQUAL(countDataFrames(0x281, from), 5);
+	EMB_ASSERT_EQUAL(lastFrame(0x281)->frame.len, 4);
+	EMB_ASSERT_EQUAL(frameBits(lastFrame(0x281)->frame), 0xCAFE0001);
+
+	pdoDemo.position = 2;
+	pdoDemo.speed = 1500.f;
+	sim::CanFrame rtr = makeFrame(0x481, 4);
+	rtr.remote = true;
+	sim::CanBus::send(client, rtr);
+	rtr.id = 0x381;
+	sim::CanBus::send(client, rtr);
+	runServers(serverA, serverB, 2);
+	EMB_ASSERT_EQUAL(countDataFrames(0x481, from), 1);
+	EMB_ASSERT_EQUAL(frameBits(lastFrame(0x481)->frame), 1);		// value at last SYNC
+	EMB_ASSERT_EQUAL(countDataFrames(0x381, from), 1);
+	uint32_t speedRaw = static_cast<uint32_t>(frameBits(lastFrame(0x381)->frame));
+	float speedValue = 0;
+	memcpy(&speedValue, &speedRaw, sizeof(speedValue));
+	EMB_ASSERT_EQUAL(speedValue, 1500.f);
+
+	// RPDO1: dummy octet, signed fields are sign-extended
+	const uint32_t rpdo1[4] = {dummy, offset, position24, flag};
+	EMB_ASSERT_TRUE(pdoSdoMap(client, serverA, serverB, 0x1600, rpdo1, 4));
+	uint64_t bits = 0xAA | (0xFED4ULL << 8) | (0xFFFFFBULL << 24);	// offset -300, position -5, flag 0
+	sim::CanFrame rpdo = makeFrame(0x201, 7);
+	for (size_t i = 0; i < 8; ++i)
+	{
+		rpdo.data[i] = (bits >> (8 * i)) & 0xFF;
+	}
+	sim::CanBus::send(client, rpdo);
+	runServers(serverA, serverB, 2);
+	EMB_ASSERT_EQUAL(pdoDemo.offset, -300);
+	EMB_ASSERT_EQUAL(pdoDemo.position, -5);
+	EMB_ASSERT_TRUE(!pdoDemo.flag);
+
+	serverA.disable();
+	serverB.disable();
+	sim::CanBus::reset(1000000);
+
+	// pack and unpack cost: compiled program vs entry lookup and switch on data type per field
+	ucanopen::ODIndex odIndex;
+	odIndex.init(ucanopen::ODTable(ucanopen::tests::objectDictionary, ucanopen::tests::objectDictionaryKeys,
+			ucanopen::tests::objectDictionaryLen));
+	const uint32_t fields2[2] = {position, speed};
+	const uint32_t fields4[4] = {pdoMappingParameter(0x5030, 0x01, 16), pdoMappingParameter(0x5030, 0x02, 16),
+			pdoMappingParameter(0x5030, 0x03, 16), pdoMappingParameter(0x5030, 0x04, 16)};
+	const uint32_t fields8[8] = {flag, pdoMappingParameter(0x5030, 0x01, 8), pdoMappingParameter(0x5030, 0x02, 8),
+			pdoMappingParameter(0x5030, 0x03, 8), pdoMappingParameter(0x5030, 0x04, 8),
+			pdoMappingParameter(0x5030, 0x01, 8), pdoMappingParameter(0x5030, 0x02, 8),
+			pdoMappingParameter(0x5030, 0x03, 15)};
+	const uint32_t* sets[3] = {fields2, fields4, fields8};
+	const unsigned int counts[3] = {2, 4, 8};
+
+	const uint64_t iterations = 1000000;
+	for (size_t s = 0; s < 3; ++s)
+	{
+		ucanopen::PdoMapping tx;
+		ucanopen::PdoMapping rx;
+		EMB_ASSERT_TRUE(tx.map(odIndex, ucanopen::PdoDirection::Transmit, sets[s], counts[s]));
+		EMB_ASSERT_TRUE(rx.map(odIndex, ucanopen::PdoDirection::Receive, sets[s], counts[s]));
+
+		ucanopen::can_payload payload;
+		ucanopen::can_payload reference;
+		tx.pack(payload);
+		packByLookup(odIndex, sets[s], counts[s], reference);
+		EMB_ASSERT_TRUE(std::equal(payload.begin(), payload.end(), reference.begin()));
+
+		uint64_t sink = 0;
+		uint64_t t0 = wallclock_ns();
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			++pdoDemo.counter;
+			tx.pack(payload);
+			sink += payload[1];
+		}
+		uint64_t pack_ns = wallclock_ns() - t0;
+
+		t0 = wallclock_ns();
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			payload[1] = i & 0xFF;
+			rx.unpack(payload);
+			sink += pdoDemo.counter;
+		}
+		uint64_t unpack_ns = wallclock_ns() - t0;
+
+		t0 = wallclock_ns();
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			++pdoDemo.counter;
+			packByLookup(odIndex, sets[s], counts[s], payload);
+			sink += payload[1];
+		}
+		uint64_t lookup_ns = wallclock_ns() - t0;
+		EMB_ASSERT_TRUE(sink != 0);
+
+		char str[160];
+		snprintf(str, sizeof(str), "[ BENCH  ] ucanopen PDO %u fields: pack %llu ns, unpack %llu ns (lookup and switch per field: pack %llu ns)",
+				counts[s],
+				static_cast<unsigned long long>(pack_ns / iterations),
+				static_cast<unsigned long long>(unpack_ns / iterations),
+				static_cast<unsigned long long>(lookup_ns / iterations));
+		emb::TestRunner::print(str);
+		emb::TestRunner::print_nextline();
+	}
+}
+
+
+
+
+namespace {
+
+
+/// Test server that records sequence numbers (first two octets) of received RPDOs.
+class QueueServer : public ServerA
+{
+public:
+	emb::Array<std::vector<uint32_t>, 4> received;
+
+	QueueServer(CanA* canModule)
+		: ServerA(ucanopen::NodeId(0x1), canModule, makeIpcFlags(4))
+	{}
+
+	void setPolicy(ucanopen::RpdoType type, ucanopen::RxQueuePolicy policy) { this->_setRpdoQueuePolicy(type, policy); }
+
+	void clear()
+	{
+		for (size_t i = 0; i < received.size(); ++i)
+		{
+			received[i].clear();
+		}
+	}
+protected:
+	void record(size_t i, const ucanopen::can_payload& data) { received[i].push_back((data[0] & 0xFF) | ((data[1] & 0xFF) << 8)); }
+	virtual void _handleRpdo1(const ucanopen::can_payload& data) { record(0, data); }
+	virtual void _handleRpdo2(const ucanopen::can_payload& data) { record(1, data); }
+	virtual void _handleRpdo3(const ucanopen::can_payload& data) { record(2, data); }
+	virtual void _handleRpdo4(const ucanopen::can_payload& data) { record(3, data); }
+};
+
+
+sim::CanFrame makeSeqFrame(uint32_t id, uint32_t seq)
+{
+	sim::CanFrame frame = makeFrame(id, 8);
+	frame.data[0] = seq & 0xFF;
+	frame.data[1] = (seq >> 8) & 0xFF;
+	return frame;
+}
+
+
+/// Slow superloop: server runs once per millisecond, frames received meanwhile wait in queues.
+void runSlow(QueueServer& server, uint64_t duration_ms)
+{
+	for (uint64_t i = 0; i < duration_ms; ++i)
+	{
+		sim::VirtualTime::advance_ms(1);
+		server.run();
+	}
+}
+
+
+bool isSequence(const std::vector<uint32_t>& values, uint32_t first, uint32_t last)
+{
+	if (values.size() != last - first + 1) return false;
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		if (values[i] != first + i) return false;
+	}
+	return true;
+}
+
+
+} // namespace
+
+
+void SimTest::RxQueueBenchmark()
+{
+	using ucanopen::RpdoType;
+	using ucanopen::RxQueuePolicy;
+	using ucanopen::RxQueueStats;
+
+	sim::CanBus::reset(1000000);
+	CanA canA(mcu::gpio::Config(30, GPIO_30_CANRXA), mcu::gpio::Config(31, GPIO_31_CANTXA),
+			mcu::can::Bitrate::Bitrate1M, mcu::can::Mode::Normal);
+	QueueServer server(&canA);
+	sim::CanBus::attach(CANA_BASE);
+	size_t client = sim::CanBus::attachClient(onClientRx);
+	server.enable();
+	clientFrames.clear();
+	const size_t depth = UCANOPEN_RPDO_QUEUE_DEPTH;
+
+	// 100% bus load: back-to-back RPDO1..4 with SDO request every 10th frame, server runs once per millisecond
+	server.setPolicy(RpdoType::Rpdo2, RxQueuePolicy::LatestValue);
+	SysLog::resetWarning(sys::Warning::CanBusOverrun);
+	emb::Array<RxQueueStats, 5> before;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		before[i] = server.rpdoQueueStats(RpdoType(i));
+	}
+	before[4] = server.rsdoQueueStats();
+	size_t responses = countFrames(0x581);
+
+	const uint32_t frames = 20000;
+	uint32_t requests = 0;
+	emb::Array<uint32_t, 4> seq = {0, 0, 0, 0};
+	for (uint32_t i = 0; i < frames; ++i)
+	{
+		if (i % 10 == 9)
+		{
+			sim::CanBus::send(client, makeSdoFrame(0x601, ucanopen::cs_codes::sdoCcsRead, 0x5030, 0x01, 0));
+			++requests;
+		}
+		else
+		{
+			size_t rpdo = i % 4;
+			sim::CanBus::send(client, makeSeqFrame(0x201 + 0x100 * rpdo, ++seq[rpdo]));
+		}
+	}
+
+	uint64_t busy0 = sim::CanBus::busyCycles();
+	uint64_t cycles0 = sim::VirtualTime::cycles();
+	uint64_t ms = 0;
+	while (sim::CanBus::pending(client) != 0)
+	{
+		runSlow(server, 1);
+		++ms;
+	}
+	uint64_t load = 100 * (sim::CanBus::busyCycles() - busy0) / (sim::VirtualTime::cycles() - cycles0);
+	runSlow(server, 10);
+
+	EMB_ASSERT_TRUE(load >= 99);
+	EMB_ASSERT_TRUE(isSequence(server.received[0], 1, seq[0]));
+	EMB_ASSERT_TRUE(isSequence(server.received[2], 1, seq[2]));
+	EMB_ASSERT_TRUE(isSequence(server.received[3], 1, seq[3]));
+	EMB_ASSERT_TRUE(!server.received[1].empty());
+	EMB_ASSERT_EQUAL(server.received[1].back(), seq[1]);
+	EMB_ASSERT_EQUAL(countFrames(0x581), responses + requests);
+	EMB_ASSERT_TRUE(!SysLog::hasWarning(sys::Warning::CanBusOverrun));
+
+	emb::Array<RxQueueStats, 5> after;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		after[i] = server.rpdoQueueStats(RpdoType(i));
+	}
+	after[4] = server.rsdoQueueStats();
+	for (size_t i = 0; i < 5; ++i)
+	{
+		if (i == 1) continue;	// latest-value queue
+		EMB_ASSERT_EQUAL(after[i].dropped, before[i].dropped);
+	}
+	EMB_ASSERT_EQUAL(after[0].received - before[0].received, seq[0]);
+	EMB_ASSERT_EQUAL(after[4].received - before[4].received, requests);
+
+	char str[192];
+	snprintf(str, sizeof(str), "[ BENCH  ] ucanopen RX queues at %llu percent bus load: %u frames in %llu ms, "
+			"high-water RPDO1..4 %u/%u/%u/%u of %u, RSDO %u of %u, dropped 0, superseded RPDO2 %u",
+			static_cast<unsigned long long>(load), frames, static_cast<unsigned long long>(ms),
+			after[0].highWater, after[1].highWater, after[2].highWater, after[3].highWater,
+			static_cast<unsigned int>(UCANOPEN_RPDO_QUEUE_DEPTH),
+			after[4].highWater, static_cast<unsigned int>(UCANOPEN_RSDO_QUEUE_DEPTH),
+			after[1].dropped - before[1].dropped);
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+
+	// burst of RPDOs between two runs of server is handled in order
+	server.clear();
+	for (uint32_t n = 1; n <= depth; ++n)
+	{
+		sim::CanBus::send(client, makeSeqFrame(0x201, n));
+	}
+	runSlow(server, 2);
+	EMB_ASSERT_TRUE(isSequence(server.received[0], 1, depth));
+	RxQueueStats stats = server.rpdoQueueStats(RpdoType::Rpdo1);
+	EMB_ASSERT_EQUAL(stats.received, seq[0] + depth);
+	EMB_ASSERT_EQUAL(stats.highWater, depth);
+	EMB_ASSERT_EQUAL(stats.dropped, 0);
+
+	// FIFO queue overrun: the newest frames are dropped and counted
+	server.clear();
+	SysLog::resetWarning(sys::Warning::CanBusOverrun);
+	for (uint32_t n = 1; n <= depth + 2; ++n)
+	{
+		sim::CanBus::send(client, makeSeqFrame(0x201, n));
+	}
+	runSlow(server, 2);
+	EMB_ASSERT_TRUE(isSequence(server.received[0], 1, depth));
+	EMB_ASSERT_EQUAL(server.rpdoQueueStats(RpdoType::Rpdo1).dropped, 2);
+	EMB_ASSERT_TRUE(SysLog::hasWarning(sys::Warning::CanBusOverrun));
+	SysLog::resetWarning(sys::Warning::CanBusOverrun);
+
+	// latest-value queue: only the newest frame is handled, older ones are superseded
+	stats = server.rpdoQueueStats(RpdoType::Rpdo2);
+	for (uint32_t n = 1; n <= depth + 2; ++n)	// all frames fit in 1 ms at 1 Mbps
+	{
+		sim::CanBus::send(client, makeSeqFrame(0x301, n));
+	}
+	runSlow(server, 4);
+	EMB_ASSERT_EQUAL(server.received[1].size(), 1);
+	EMB_ASSERT_EQUAL(server.received[1][0], depth + 2);
+	EMB_ASSERT_EQUAL(server.rpdoQueueStats(RpdoType::Rpdo2).received - stats.received, depth + 2);
+	EMB_ASSERT_EQUAL(server.rpdoQueueStats(RpdoType::Rpdo2).dropped - stats.dropped, depth + 1);
+	EMB_ASSERT_TRUE(!SysLog::hasWarning(sys::Warning::CanBusOverrun));
+
+	server.disable();
+	sim::CanBus::reset(1000000);
+}
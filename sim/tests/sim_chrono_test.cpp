@@ -0,0 +1,122 @@
+///
+#include "sim_test.h"
+#include "emb/emb_events/emb_events.h"
+
+
+namespace {
+
+
+bool delayedTaskDone;
+void delayedTask() { delayedTaskDone = true; }
+
+
+uint32_t periodicTaskCount;
+mcu::chrono::TaskStatus periodicTask(size_t)
+{
+	++periodicTaskCount;
+	return mcu::chrono::TaskStatus::Success;
+}
+
+
+} // namespace
+
+
+void SimTest::ChronoTest()
+{
+	using mcu::chrono::SystemClock;
+	using mcu::chrono::HighResolutionClock;
+
+	// system clock ticks only when virtual time is advanced
+	uint64_t start = SystemClock::now();
+	sim::VirtualTime::advance_ms(5);
+	EMB_ASSERT_EQUAL(SystemClock::now() - start, 5);
+	sim::VirtualTime::advance_us(999);
+	EMB_ASSERT_EQUAL(SystemClock::now() - start, 5);
+	sim::VirtualTime::advance_us(1);
+	EMB_ASSERT_EQUAL(SystemClock::now() - start, 6);
+
+	// high resolution clock is monotonic and exact in virtual time
+	uint64_t ticks = HighResolutionClock::ticks();
+	sim::VirtualTime::advance_us(2500);
+	EMB_ASSERT_EQUAL(HighResolutionClock::ticks() - ticks, 2500 * (mcu::sysclkFreq() / 1000000));
+	sim::VirtualTime::advance(7);
+	EMB_ASSERT_EQUAL(HighResolutionClock::ticks() - ticks, 2500 * (mcu::sysclkFreq() / 1000000) + 7);
+
+	// interrupts are held pending while masked, tick interrupts are lost as on target
+	start = SystemClock::now();
+	mcu::disableMaskableInterrupts();
+	sim::VirtualTime::advance_ms(3);
+	EMB_ASSERT_EQUAL(SystemClock::now(), start);
+	EMB_ASSERT_TRUE(sim::Interrupts::pending(INT_TIMER0));
+	mcu::enableMaskableInterrupts();
+	EMB_ASSERT_EQUAL(SystemClock::now(), start + 1);
+
+	// delayed task (same scenario as on-target McuTest::ChronoTest)
+	delayedTaskDone = false;
+	SystemClock::registerDelayedTask(delayedTask, 200);
+	DEVICE_DELAY_US(150000);
+	SystemClock::runTasks();
+	EMB_ASSERT_TRUE(!delayedTaskDone);
+	DEVICE_DELAY_US(100000);
+	SystemClock::runTasks();
+	EMB_ASSERT_TRUE(delayedTaskDone);
+
+	// periodic task released every 10 ms without lateness when tasks are run every tick
+	SystemClock::enableTaskStats(HighResolutionClock::ticks);
+	periodicTaskCount = 0;
+	size_t task = SystemClock::registerTask(periodicTask, 10, "sim_periodic");
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		sim::VirtualTime::advance_ms(1);
+		SystemClock::runTasks();
+	}
+	EMB_ASSERT_EQUAL(periodicTaskCount, 100);
+	EMB_ASSERT_EQUAL(SystemClock::taskStats(task).activations, 100);
+	EMB_ASSERT_EQUAL(SystemClock::taskStats(task).latenessMax, 0);
+
+	// task that is run late: lateness is measured in virtual time
+	sim::VirtualTime::advance_ms(25);
+	SystemClock::runTasks();
+	EMB_ASSERT_EQUAL(SystemClock::taskStats(task).latenessMax, 15);
+	SystemClock::cancelTask(task);
+}
+
+
+void SimTest::ChronoBenchmark()
+{
+	using mcu::chrono::SystemClock;
+
+	// idle superloop: hours of uptime are simulated, idle time is skipped to the next timer interrupt
+	const uint64_t simulated_ms = 3600 * 1000;
+	periodicTaskCount = 0;
+	size_t task = SystemClock::registerTask(periodicTask, 1, "sim_bench");
+
+	uint64_t end = SystemClock::now() + simulated_ms;
+	uint64_t wallStart = wallclock_ns();
+	while (SystemClock::now() < end)
+	{
+		if (emb::PendingEvents::take() != 0)
+		{
+			SystemClock::runTasks();
+		}
+		else
+		{
+			sim::VirtualTime::advanceToNextEvent();
+		}
+	}
+	uint64_t wall_ns = wallclock_ns() - wallStart;
+	SystemClock::cancelTask(task);
+
+	EMB_ASSERT_TRUE(periodicTaskCount >= simulated_ms - 1);
+
+	char str[128];
+	snprintf(str, sizeof(str), "[ BENCH  ] superloop: %llu simulated ms in %llu wall ms, %llu ns per simulated ms, x%llu",
+			static_cast<unsigned long long>(simulated_ms),
+			static_cast<unsigned long long>(wall_ns / 1000000),
+			static_cast<unsigned long long>(wall_ns / simulated_ms),
+			static_cast<unsigned long long>(simulated_ms * 1000000 / (wall_ns + 1)));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
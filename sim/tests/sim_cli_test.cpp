@@ -0,0 +1,945 @@
+///
+#include "sim_test.h"
+#include "sim_uart.h"
+#include "emb/emb_events/emb_events.h"
+#include "cli/cli_server.h"
+#include "cli/shell/cli_shell.h"
+#include "sys/vars/varsampler.h"
+#include "emb/emb_circularbuffer.h"
+#include "emb/emb_string.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+namespace {
+
+
+const uint32_t CLI_PIPE_INT = INT_SCIC_RX;	// SCIC is not used by firmware
+const uint64_t RESPONSE_TIMEOUT_ms = 2000;
+
+
+sim::PipeUart* pipeUart = NULL;
+__interrupt void onPipeUartRx()
+{
+	pipeUart->disableRxInterrupts();	// re-enabled by CLI task when Rx FIFO is drained, as in firmware
+	pipeUart->acknowledgeRxInterrupt();
+	emb::PendingEvents::set(emb::Event::UartRx);
+}
+
+
+/**
+ * @brief Runs CLI server as firmware CLI task does until response ends with prompt and is transmitted.
+ * @return Transmitted response, empty string on timeout.
+ */
+std::string waitPrompt(cli::Server& server, sim::PipeUart& uart)
+{
+	std::string output;
+	uint64_t deadline = sim::VirtualTime::cycles() + RESPONSE_TIMEOUT_ms * (DEVICE_SYSCLK_FREQ / 1000);
+	while (sim::VirtualTime::cycles() < deadline)
+	{
+		emb::PendingEvents::take();
+		while (server.run()) {}
+		uart.enableRxInterrupts();
+
+		output += uart.takeOutput();
+		bool promptSent = (output.size() >= strlen(CLI_PROMPT_END))
+				&& (output.compare(output.size() - strlen(CLI_PROMPT_END), std::string::npos, CLI_PROMPT_END) == 0);
+		if (promptSent && uart.rxLineSize() == 0 && uart.rxFifoLevel() == 0 && uart.txIdle())
+		{
+			return output;
+		}
+		sim::VirtualTime::advanceToNextEvent();
+	}
+	return std::string();
+}
+
+
+struct CliBenchResult
+{
+	uint64_t commands;
+	uint64_t bytes;
+	uint64_t sim_ns;
+	uint64_t wall_ns;
+};
+
+
+/// Interactive session: next command is sent when prompt is received.
+CliBenchResult runCommands(cli::Server& server, sim::PipeUart& uart, const char* command, uint64_t count)
+{
+	CliBenchResult result = {0, 0, 0, 0};
+	uint64_t sim_start = sim::VirtualTime::now_ns();
+	uint64_t wall_start = wallclock_ns();
+	for (uint64_t i = 0; i < count; ++i)
+	{
+		uart.write(command);
+		uart.write("\r");
+		std::string response = waitPrompt(server, uart);
+		if (response.empty()) break;
+		++result.commands;
+		result.bytes += response.size();
+	}
+	result.sim_ns = sim::VirtualTime::now_ns() - sim_start;
+	result.wall_ns = wallclock_ns() - wall_start;
+	return result;
+}
+
+
+void printBench(const char* command, uint32_t baudrate, const CliBenchResult& result)
+{
+	char str[160];
+	snprintf(str, sizeof(str), "[ BENCH  ] cli \"%s\" %lu baud: %llu commands/s, %llu output bytes/s simulated, %llu wall ns per command",
+			command, static_cast<unsigned long>(baudrate),
+			static_cast<unsigned long long>(result.commands * 1000000000 / (result.sim_ns + 1)),
+			static_cast<unsigned long long>(result.bytes * 1000000000 / (result.sim_ns + 1)),
+			static_cast<unsigned long long>(result.wall_ns / (result.commands + 1)));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+struct CliBurstResult
+{
+	uint64_t passes;	// passes with output pending
+	uint64_t runCalls;
+	uint64_t bytes;
+	uint64_t completion_ns;
+};
+
+
+/// Superloop passes at fixed period, CLI task serves output burst once per pass as firmware CLI thread does.
+CliBurstResult runOutputBurst(cli::Server& server, sim::PipeUart& uart, const char* command, uint64_t passPeriod)
+{
+	CliBurstResult result = {0, 0, 0, 0};
+	uart.write(command);
+	uart.write("\r");
+	uint64_t start = sim::VirtualTime::now_ns();
+	uint64_t deadline = sim::VirtualTime::cycles() + RESPONSE_TIMEOUT_ms * (DEVICE_SYSCLK_FREQ / 1000);
+	std::string output;
+	while (sim::VirtualTime::cycles() < deadline)
+	{
+		sim::VirtualTime::advance(passPeriod);
+		emb::PendingEvents::take();
+		uint64_t queued = uart.txCount() + uart.txFifoLevel();
+		do
+		{
+			++result.runCalls;
+		} while (server.run());
+		uart.enableRxInterrupts();
+
+		uint64_t bytes = uart.txCount() + uart.txFifoLevel() - queued;
+		if (bytes != 0)
+		{
+			++result.passes;
+			result.bytes += bytes;
+		}
+		output += uart.takeOutput();
+		if (output.find(CLI_PROMPT_END) != std::string::npos && uart.txIdle()) break;
+	}
+	while (!uart.txIdle())
+	{
+		sim::VirtualTime::advanceToNextEvent();
+	}
+	result.completion_ns = sim::VirtualTime::now_ns() - start;
+	return result;
+}
+
+
+/// Instant UART: input is taken from string, output is discarded.
+class FeedUart : public emb::IUart
+{
+public:
+	std::string input;
+	size_t pos;
+	bool capture;
+	std::string output;
+	FeedUart() : pos(0), capture(false) {}
+	virtual void reset() { input.clear(); pos = 0; }
+	virtual bool hasRxError() const { return false; }
+	virtual int recv(char& ch)
+	{
+		if (pos >= input.size()) return 0;
+		ch = input[pos++];
+		return 1;
+	}
+	virtual int recv(char* buf, size_t bufLen)
+	{
+		size_t i = 0;
+		for (; i < bufLen && recv(buf[i]) == 1; ++i) {}
+		return i;
+	}
+	virtual int send(char ch) { return send(&ch, 1); }
+	virtual int send(const char* buf, uint16_t len)
+	{
+		if (capture) output.append(buf, len);
+		return len;
+	}
+	virtual int sendNonBlocking(const char* buf, uint16_t len) { return send(buf, len); }
+	virtual void registerRxInterruptHandler(void (*handler)(void)) {}
+	virtual void enableRxInterrupts() {}
+	virtual void disableRxInterrupts() {}
+	virtual void acknowledgeRxInterrupt() {}
+};
+
+
+std::string executed;
+int execCapture(int argc, const char** argv)
+{
+	executed.clear();
+	for (int i = 0; i < argc; ++i)
+	{
+		if (i != 0) executed += ' ';
+		executed += argv[i];
+	}
+	return 0;
+}
+
+
+int execShell(int argc, const char** argv)
+{
+	execCapture(argc, argv);
+	return cli::Shell::exec(argc, argv);
+}
+
+
+/// Feeds chars to server and returns executed command line.
+std::string feed(cli::Server& server, FeedUart& uart, const std::string& chars)
+{
+	executed = "<none>";
+	uart.output.clear();
+	uart.input = chars;
+	uart.pos = 0;
+	while (server.run()) {}
+	return executed;
+}
+
+
+unsigned appBellCount;
+void onAppBell() { ++appBellCount; }
+
+const cli::EscSeq appEscSeqList[] = {
+{.str = "\x07",		.len = 1,	.handler = onAppBell},
+{.str = CLI_ESC"[A",	.len = 3,	.handler = onAppBell},	// overrides core history binding
+};
+
+const cli::EscSeq invalidEscSeqList[] = {
+{.str = CLI_ESC"[",	.len = 2,	.handler = onAppBell},	// prefix of core bindings
+};
+
+
+/// Drains stream output through server to capturing UART.
+std::string drain(cli::Server& server, FeedUart& uart)
+{
+	uart.output.clear();
+	while (server.run()) {}
+	return uart.output;
+}
+
+
+const uint32_t STREAM_TEST_LINES = 500;
+int execLines(int argc, const char** argv)
+{
+	for (uint32_t i = cli::out.resumePoint(); i < STREAM_TEST_LINES; ++i)
+	{
+		if (!cli::out.fits(16)) return cli::out.suspend(i);
+		cli::out << CLI_ENDL << "line " << cli::dec(i, 4, '0');
+	}
+	return 0;
+}
+
+
+uint32_t watchCounter;
+int16_t watchSigned = -42;
+uint32_t watchPercent = 1234;	// hundredths of percent
+float watchFloat = 0.5f;
+float watchIntegrator = -12345678.0f;	// large value: scaled product of fixed-point field does not fit 32 bits
+
+const sys::Var watchVars[] =
+{
+	{"counter", sys::VarType::Uint32, &watchCounter, 1.0f, false},
+	{"signed", sys::VarType::Int16, &watchSigned, 1.0f, true},
+	{"percent", sys::VarType::Uint32, &watchPercent, 0.01f, false},
+	{"float", sys::VarType::Float32, &watchFloat, 1.0f, true},
+	{"integrator", sys::VarType::Float32, &watchIntegrator, 1.0f, true},
+};
+
+
+struct WatchResult
+{
+	std::string output;
+	uint32_t maxRunCalls;	// max number of run() calls in one pass of CLI task
+};
+
+
+/// Runs firmware superloop: clock tasks and CLI task, counter variable is updated every pass.
+WatchResult runWatch(cli::Server& server, sim::PipeUart& uart, uint64_t duration_ms)
+{
+	WatchResult result;
+	result.maxRunCalls = 0;
+	uint64_t deadline = sim::VirtualTime::cycles() + duration_ms * (DEVICE_SYSCLK_FREQ / 1000);
+	while (sim::VirtualTime::cycles() < deadline)
+	{
+		watchCounter = mcu::chrono::SystemClock::now();
+		mcu::chrono::SystemClock::runTasks();
+		emb::PendingEvents::take();
+		uint32_t runCalls = 1;
+		while (server.run()) { ++runCalls; }
+		result.maxRunCalls = std::max(result.maxRunCalls, runCalls);
+		uart.enableRxInterrupts();
+		result.output += uart.takeOutput();
+		sim::VirtualTime::advanceToNextEvent();
+	}
+	return result;
+}
+
+
+/// EEPROM model: octet per char, page boundary crossing is reported as error as I2C EEPROM would wrap.
+class MemEeprom : public emb::IEeprom
+{
+public:
+	static const unsigned int pageSize = 32;
+	std::vector<char> data;
+	unsigned int writes;
+	MemEeprom() : data(pageSize * 16, 0), writes(0) {}
+	virtual emb::EepromStatus write(emb::EepromAddr addr, const char* buf, unsigned int nBytes, uint64_t timeoutMs)
+	{
+		if ((addr.offset + nBytes > pageSize) || ((addr.page + 1) * pageSize > data.size())) return emb::EEPROM_INVALID_ADDRESS;
+		std::copy(buf, buf + nBytes, data.begin() + addr.page * pageSize + addr.offset);
+		++writes;
+		return emb::EEPROM_SUCCESS;
+	}
+	virtual emb::EepromStatus read(emb::EepromAddr addr, char* buf, unsigned int nBytes, uint64_t timeoutMs)
+	{
+		if ((addr.offset + nBytes > pageSize) || ((addr.page + 1) * pageSize > data.size())) return emb::EEPROM_INVALID_ADDRESS;
+		std::copy(data.begin() + addr.page * pageSize + addr.offset, data.begin() + addr.page * pageSize + addr.offset + nBytes, buf);
+		return emb::EEPROM_SUCCESS;
+	}
+};
+
+
+std::string historyEntry(const cli::History& history, size_t age)
+{
+	char entry[CLI_CMDLINE_MAX_LENGTH];
+	return std::string(entry, history.copy(age, entry, sizeof(entry)));
+}
+
+
+} // namespace
+
+
+void SimTest::CliBenchmark()
+{
+	const uint32_t baudrates[2] = {9600, 115200};
+	const uint64_t commandCount = 100;
+
+	for (size_t i = 0; i < 2; ++i)
+	{
+		sim::PipeUart uart(baudrates[i], CLI_PIPE_INT);
+		pipeUart = &uart;
+		uart.registerRxInterruptHandler(onPipeUartRx);
+		uart.enableRxInterrupts();
+
+		cli::Server server("bench", &uart, NULL, NULL);
+		cli::Shell::init();
+		server.registerExecCallback(cli::Shell::exec);
+		EMB_ASSERT_TRUE(!waitPrompt(server, uart).empty());
+
+		// functional check: command is executed, unknown command is reported
+		std::string response;
+		uart.write("uptime\r");
+		response = waitPrompt(server, uart);
+		EMB_ASSERT_TRUE(response.find("uptime: ") != std::string::npos);
+		uart.write("foo\r");
+		response = waitPrompt(server, uart);
+		EMB_ASSERT_TRUE(response.find("foo") != std::string::npos);
+
+		// line is transmitted at baudrate: "uptime" echo takes 6 char frames
+		uint64_t start = sim::VirtualTime::cycles();
+		uart.write("uptime");
+		response = waitPrompt(server, uart);
+		EMB_ASSERT_EQUAL(response, std::string());	// no prompt until return
+		uart.write("\r");
+		response = waitPrompt(server, uart);
+		EMB_ASSERT_TRUE(response.find("uptime: ") != std::string::npos);
+		EMB_ASSERT_TRUE(sim::VirtualTime::cycles() - start >= (7 + response.size()) * uart.charCycles());
+
+		// full command line: printable chars are dropped, return is still processed
+		uart.write(std::string(CLI_CMDLINE_MAX_LENGTH + 8, 'x').c_str());
+		uart.write("\r");
+		response = waitPrompt(server, uart);
+		EMB_ASSERT_TRUE(!response.empty());
+		uart.write("uptime\r");
+		response = waitPrompt(server, uart);
+		EMB_ASSERT_TRUE(response.find("uptime: ") != std::string::npos);
+
+		CliBenchResult result = runCommands(server, uart, "uptime", commandCount);
+		EMB_ASSERT_EQUAL(result.commands, commandCount);
+		printBench("uptime", baudrates[i], result);
+
+		result = runCommands(server, uart, "list", commandCount / 4);
+		EMB_ASSERT_EQUAL(result.commands, commandCount / 4);
+		printBench("list", baudrates[i], result);
+
+		// output burst: superloop pass takes 8 char frames, TX FIFO is refilled per pass,
+		// so completion time is close to line time
+		const uint64_t passPeriod = 8 * uart.charCycles();
+		CliBurstResult burst = runOutputBurst(server, uart, "list", passPeriod);
+		uint64_t lineTime_ns = burst.bytes * uart.charCycles() * 1000000000 / DEVICE_SYSCLK_FREQ;
+		uint64_t passPeriod_us = passPeriod * 1000000 / DEVICE_SYSCLK_FREQ;
+		EMB_ASSERT_TRUE(burst.bytes / burst.passes >= 8);
+		EMB_ASSERT_TRUE(burst.completion_ns < lineTime_ns + 2 * passPeriod_us * 1000);
+		char str[160];
+		snprintf(str, sizeof(str), "[ BENCH  ] cli \"list\" burst %lu baud, pass %lluus: %llu bytes/pass, %llu run() calls/pass, output %llu bytes in %llu us (line time %llu us)",
+				static_cast<unsigned long>(baudrates[i]), static_cast<unsigned long long>(passPeriod_us),
+				static_cast<unsigned long long>(burst.bytes / burst.passes),
+				static_cast<unsigned long long>(burst.runCalls / burst.passes),
+				static_cast<unsigned long long>(burst.bytes),
+				static_cast<unsigned long long>(burst.completion_ns / 1000),
+				static_cast<unsigned long long>(lineTime_ns / 1000));
+		emb::TestRunner::print(str);
+		emb::TestRunner::print_nextline();
+
+		// input is processed while output is pending
+		uart.write("list\r");
+		uart.write("uptime\r");
+		response = waitPrompt(server, uart);
+		EMB_ASSERT_TRUE(response.find("uptime: ") != std::string::npos);
+
+		EMB_ASSERT_EQUAL(uart.overruns(), 0);
+		uart.disableRxInterrupts();
+		pipeUart = NULL;
+	}
+}
+
+
+void SimTest::CliEscSeqBenchmark()
+{
+	FeedUart uart;
+	cli::Server server("bench", &uart, NULL, NULL);
+	server.registerExecCallback(execCapture);
+	feed(server, uart, "");
+
+	// line editing bindings
+	EMB_ASSERT_TRUE(feed(server, uart, "wrld\x01" "hello \x05\r") == "hello wrld");
+	EMB_ASSERT_TRUE(feed(server, uart, "abc def" CLI_ESC"[1;5D" "x\r") == "abc xdef");
+	EMB_ASSERT_TRUE(feed(server, uart, "abc def" CLI_ESC"b" CLI_ESC"f" "x\r") == "abc defx");
+	EMB_ASSERT_TRUE(feed(server, uart, "abc def ghi\x17\r") == "abc def");
+	EMB_ASSERT_TRUE(feed(server, uart, "abc def" CLI_ESC"b\x0B\r") == "abc");
+	EMB_ASSERT_TRUE(feed(server, uart, "abc def" CLI_ESC"b\x15\r") == "def");
+	EMB_ASSERT_TRUE(feed(server, uart, "abc" CLI_ESC"OH" "x" CLI_ESC"[4~" "y" CLI_ESC"[D" CLI_ESC"[3~\r") == "xabc");
+	EMB_ASSERT_TRUE(feed(server, uart, "ab\x7F\x08" "cd\r") == "cd");
+
+	// unknown sequences: CSI parameters are consumed, control char restarts DFA
+	EMB_ASSERT_TRUE(feed(server, uart, "ab" CLI_ESC"[20~" "c\r") == "abc");
+	EMB_ASSERT_TRUE(feed(server, uart, "ab" CLI_ESC"[1;2Q" "c\r") == "abc");
+	EMB_ASSERT_TRUE(feed(server, uart, "ab\x03" "c\r") == "abc");
+	EMB_ASSERT_TRUE(feed(server, uart, "ab" CLI_ESC"\r") == "ab");
+	EMB_ASSERT_TRUE(feed(server, uart, "ab" CLI_ESC CLI_ESC"[Dx\r") == "axb");
+
+	// application bindings: new and overriding, invalid table is rejected
+	appBellCount = 0;
+	EMB_ASSERT_TRUE(cli::Server::registerEscSeqBindings(appEscSeqList, 2));
+	EMB_ASSERT_TRUE(feed(server, uart, "a\x07" CLI_ESC"[A" "b\r") == "ab");
+	EMB_ASSERT_EQUAL(appBellCount, 2);
+	EMB_ASSERT_TRUE(!cli::Server::registerEscSeqBindings(invalidEscSeqList, 1));
+	EMB_ASSERT_TRUE(feed(server, uart, "a\x07" CLI_ESC"[D" "b\r") == "ba");
+	EMB_ASSERT_EQUAL(appBellCount, 2);
+	EMB_ASSERT_TRUE(cli::Server::registerEscSeqBindings(NULL, 0));
+
+	// throughput: edit-heavy stream without return, command line is cleared by Ctrl-U
+	const std::string pattern = "sysctl set 42" CLI_ESC"[D" CLI_ESC"[D" CLI_ESC"[C" CLI_ESC"[1;5D" CLI_ESC"[3~"
+			"\x01" CLI_ESC"[1;5C" CLI_ESC"[F" "\x7F" CLI_ESC"[20~" "\x15";
+	std::string stream;
+	while (stream.size() < 1000000)
+	{
+		stream += pattern;
+	}
+	uart.input = stream;
+	uart.pos = 0;
+	uint64_t start = wallclock_ns();
+	uint64_t chars = 0;
+	while (server.run())
+	{
+		++chars;
+	}
+	uint64_t wall_ns = wallclock_ns() - start;
+	EMB_ASSERT_TRUE(chars >= stream.size());
+
+	char str[160];
+	snprintf(str, sizeof(str), "[ BENCH  ] cli escape sequence DFA: %llu chars/s through _processChar (%lu of %lu chars in escape sequences)",
+			static_cast<unsigned long long>(stream.size() * 1000000000ULL / (wall_ns + 1)),
+			static_cast<unsigned long>(pattern.size() - strlen("sysctl set 42")),
+			static_cast<unsigned long>(pattern.size()));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+void SimTest::CliCompletionBenchmark()
+{
+	EMB_ASSERT_TRUE(cli::Shell::init());
+
+	FeedUart uart;
+	uart.capture = true;
+	cli::Server server("bench", &uart, NULL, NULL);
+	server.registerExecCallback(execShell);
+	server.registerCompletionCallback(cli::Shell::complete);
+	feed(server, uart, "");
+
+	// command, subcommand and option completion
+	EMB_ASSERT_TRUE(feed(server, uart, "upt\t\r") == "uptime");
+	EMB_ASSERT_TRUE(feed(server, uart, "sysl\tsh\terr\t\r") == "syslog show errors");
+	EMB_ASSERT_TRUE(uart.output.find("errors: 0x") != std::string::npos);
+	EMB_ASSERT_TRUE(feed(server, uart, "syslog show --\t\r") == "syslog show --help");
+	EMB_ASSERT_TRUE(uart.output.find("Prints errors and warnings.") != std::string::npos);
+	EMB_ASSERT_TRUE(uart.output.find("  warnings - Prints warnings.") != std::string::npos);
+	EMB_ASSERT_TRUE(feed(server, uart, "tr\t\tdu\t3\r") == "trace dump 3");
+	EMB_ASSERT_TRUE(feed(server, uart, "hist\tcl\t\r") == "history clear");
+	EMB_ASSERT_TRUE(uart.output.find("History cleared.") != std::string::npos);
+
+	// ambiguous prefix: common part is completed, then candidates are listed and line is redrawn
+	EMB_ASSERT_TRUE(feed(server, uart, "s\t") == "<none>");
+	EMB_ASSERT_TRUE(feed(server, uart, "\t") == "<none>");
+	EMB_ASSERT_TRUE(uart.output.find("sysctl  sysinfo  syslog  ") != std::string::npos);
+	EMB_ASSERT_TRUE(uart.output.find("bench]> " CLI_COLOR_OFF "sys") != std::string::npos);
+	EMB_ASSERT_TRUE(feed(server, uart, "l\t\r") == "syslog");
+
+	// completion at cursor in the middle of line, unknown prefix is not completed
+	EMB_ASSERT_TRUE(feed(server, uart, "syslog 1" CLI_ESC"[D" "re\t\r") == "syslog reset 1");
+	EMB_ASSERT_TRUE(feed(server, uart, "foo\t\r") == "foo");
+
+	// subcommand tables: invalid option and missing subcommand
+	feed(server, uart, "syslog show bogus\r");
+	EMB_ASSERT_TRUE(uart.output.find("syslog-show: invalid options") != std::string::npos);
+	feed(server, uart, "syslog set\r");
+	EMB_ASSERT_TRUE(uart.output.find("Sets error/warning.") != std::string::npos);
+	uart.capture = false;
+
+	// lookup and completion cost vs table size
+	const char* groups[8] = {"adc", "can", "dac", "eeprom", "gpio", "pwm", "sci", "timer"};
+	const size_t sizes[4] = {10, 50, 100, 500};
+	for (size_t k = 0; k < 4; ++k)
+	{
+		std::vector<std::string> names;
+		for (size_t i = 0; i < sizes[k]; ++i)
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "%s_%s%lu", groups[i % 8], (i % 3 == 0) ? "get" : "set",
+					static_cast<unsigned long>(i));
+			names.push_back(name);
+		}
+		std::vector<cli::Cmd> cmds;
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			cli::Cmd cmd = {names[i].c_str(), execCapture, "", NULL, 0};
+			cmds.push_back(cmd);
+		}
+		std::sort(cmds.begin(), cmds.end());
+		EMB_ASSERT_TRUE(cli::Shell::validate(&cmds[0], cmds.size()));
+
+		const size_t rounds = 2000000 / sizes[k];
+		size_t found = 0;
+		uint64_t start = wallclock_ns();
+		for (size_t r = 0; r < rounds; ++r)
+		{
+			for (size_t i = 0; i < names.size(); ++i)
+			{
+				found += (cli::Shell::find(&cmds[0], cmds.size(), names[i].c_str()) != NULL);
+			}
+		}
+		uint64_t find_ns = (wallclock_ns() - start) / (rounds * names.size());
+		EMB_ASSERT_EQUAL(found, rounds * names.size());
+
+		size_t candidates = 0;
+		char suffix[CLI_CMDLINE_MAX_LENGTH];
+		start = wallclock_ns();
+		for (size_t r = 0; r < rounds; ++r)
+		{
+			for (size_t i = 0; i < names.size(); ++i)
+			{
+				std::string prefix = names[i].substr(0, 5);
+				candidates += cli::Shell::completePrefix(&cmds[0], cmds.size(), prefix.c_str(), suffix, sizeof(suffix));
+			}
+		}
+		uint64_t complete_ns = (wallclock_ns() - start) / (rounds * names.size());
+		EMB_ASSERT_TRUE(candidates >= rounds * names.size());
+
+		char str[160];
+		snprintf(str, sizeof(str), "[ BENCH  ] cli command table %lu commands: %llu ns per lookup, %llu ns per prefix completion",
+				static_cast<unsigned long>(sizes[k]),
+				static_cast<unsigned long long>(find_ns),
+				static_cast<unsigned long long>(complete_ns));
+		emb::TestRunner::print(str);
+		emb::TestRunner::print_nextline();
+	}
+}
+
+
+void SimTest::CliStreamBenchmark()
+{
+	FeedUart feedUart;
+	feedUart.capture = true;
+	cli::Server feedServer("bench", &feedUart, NULL, NULL);
+	drain(feedServer, feedUart);
+
+	// formatting
+	cli::out << cli::dec(-42, 5) << '|' << cli::dec(-42, 5, '0') << '|' << 0 << '|' << 4294967295u << '|'
+			<< static_cast<long>(-2147483647L - 1);
+	EMB_ASSERT_TRUE(drain(feedServer, feedUart) == "  -42|-0042|0|4294967295|-2147483648");
+	cli::out << cli::hex32(0xDEADBEEF) << '|' << cli::hex8(5) << '|' << 12345678901234567890ULL << '|' << 1000000000ULL;
+	EMB_ASSERT_TRUE(drain(feedServer, feedUart) == "DEADBEEF|05|12345678901234567890|1000000000");
+	cli::out << cli::fixed(3.14159f, 2) << '|' << cli::fixed(-0.004f, 2) << '|' << cli::fixed(-1.5f, 1, 6) << '|'
+			<< cli::fixed(2.0f, 0) << '|' << cli::fixed(0.0f / 0.0f, 2) << '|' << cli::fixed(1.0f / 0.0f, 2);
+	EMB_ASSERT_TRUE(drain(feedServer, feedUart) == "3.14|0.00|  -1.5|2|nan|inf");
+	cli::out << cli::fixed(1e10f, 2) << '|' << cli::fixed(5e6f, 3) << '|' << cli::fixed(-4500000.5f, 3, 14) << '|'
+			<< cli::fixed(1e18f, 1) << '|' << cli::fixed(-3e38f, 0, 8) << '|' << cli::fixed(-1.0f / 0.0f, 0);
+	EMB_ASSERT_TRUE(drain(feedServer, feedUart) == "10000000000.00|5000000.000|  -4500000.500|1.0e+18|  -3e+38|-inf");
+	cli::out << cli::left("ab", 4) << '|' << cli::right("ab", 4) << '|' << cli::left("abcdef", 4);
+	EMB_ASSERT_TRUE(drain(feedServer, feedUart) == "ab  |  ab|abcdef");
+
+	// conversion matches printf on random values
+	uint32_t seed = 12345;
+	int mismatches = 0;
+	for (int i = 0; i < 10000; ++i)
+	{
+		seed = seed * 1664525 + 1013904223;
+		uint32_t value = seed >> (seed % 32);
+		char expected[64];
+		snprintf(expected, sizeof(expected), "%lu %ld %08lX %10lu", static_cast<unsigned long>(value),
+				static_cast<long>(static_cast<int32_t>(value)), static_cast<unsigned long>(value),
+				static_cast<unsigned long>(value));
+		cli::out << value << ' ' << static_cast<int32_t>(value) << ' ' << cli::hex32(value) << ' ' << cli::dec(value, 10);
+		mismatches += (drain(feedServer, feedUart) != expected);
+	}
+	EMB_ASSERT_EQUAL(mismatches, 0);
+
+	// values whose scaled product does not fit 32 bits match printf too
+	for (int i = 0; i < 10000; ++i)
+	{
+		seed = seed * 1664525 + 1013904223;
+		float value = (4294967296.f / 1000) * (1 + (seed >> 8) % 1000) * (1 << (seed % 24));
+		char expected[64];
+		snprintf(expected, sizeof(expected), "%.3f", static_cast<double>(value));
+		cli::out << cli::fixed(value, 3);
+		mismatches += (drain(feedServer, feedUart) != expected);
+	}
+	EMB_ASSERT_EQUAL(mismatches, 0);
+
+	// cycles per formatted line: top-like row, snprintf path vs stream
+	const uint32_t lines = 200000;
+	char buf[CLI_OUTBUT_BUFFER_LENGTH];
+	feedUart.capture = false;
+	uint64_t start = wallclock_ns();
+	for (uint32_t i = 0; i < lines; ++i)
+	{
+		snprintf(buf, sizeof(buf), "%-16s %5lu.%02lu %10lu %9lu %8lu", "systemclock_isr",
+				static_cast<unsigned long>(i / 100), static_cast<unsigned long>(i % 100), static_cast<unsigned long>(i * 7),
+				static_cast<unsigned long>(i / 200), static_cast<unsigned long>(i));
+		cli::nextline();
+		cli::print(buf);
+		while (feedServer.run()) {}
+	}
+	uint64_t snprintf_ns = wallclock_ns() - start;
+
+	start = wallclock_ns();
+	for (uint32_t i = 0; i < lines; ++i)
+	{
+		cli::out << CLI_ENDL << cli::left("systemclock_isr", 16) << ' ' << cli::dec(i / 100, 5) << '.'
+				<< cli::dec(i % 100, 2, '0') << ' ' << cli::dec(i * 7, 10) << ' ' << cli::dec(i / 200, 9) << ' '
+				<< cli::dec(i, 8);
+		while (feedServer.run()) {}
+	}
+	uint64_t stream_ns = wallclock_ns() - start;
+
+	// backpressure: output larger than buffer is completed, input is held until command is completed
+	sim::PipeUart uart(115200, CLI_PIPE_INT);
+	pipeUart = &uart;
+	uart.registerRxInterruptHandler(onPipeUartRx);
+	uart.enableRxInterrupts();
+	cli::Server server("bench", &uart, NULL, NULL);
+	server.registerExecCallback(execLines);
+	EMB_ASSERT_TRUE(!waitPrompt(server, uart).empty());
+
+	uint32_t dropped = cli::out.dropped();
+	uart.write("lines\rlines\r");
+	std::string response = waitPrompt(server, uart);
+	response += waitPrompt(server, uart);
+	EMB_ASSERT_EQUAL(cli::out.dropped(), dropped);
+	EMB_ASSERT_TRUE(response.size() > 2 * STREAM_TEST_LINES * 11);
+	size_t pos = 0;
+	for (int k = 0; k < 2; ++k)
+	{
+		for (uint32_t i = 0; i < STREAM_TEST_LINES; ++i)
+		{
+			char line[16];
+			snprintf(line, sizeof(line), "line %04lu", static_cast<unsigned long>(i));
+			pos = response.find(line, pos);
+			EMB_ASSERT_TRUE(pos != std::string::npos);
+		}
+	}
+	EMB_ASSERT_EQUAL(uart.overruns(), 0);
+	uart.disableRxInterrupts();
+	pipeUart = NULL;
+
+	char str[160];
+	snprintf(str, sizeof(str), "[ BENCH  ] cli formatted table line (host): snprintf %llu ns, stream %llu ns, speedup x%llu.%llu",
+			static_cast<unsigned long long>(snprintf_ns / lines),
+			static_cast<unsigned long long>(stream_ns / lines),
+			static_cast<unsigned long long>(snprintf_ns / stream_ns),
+			static_cast<unsigned long long>(snprintf_ns * 10 / stream_ns % 10));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+void SimTest::CliWatchBenchmark()
+{
+	sys::VarRegistry::init(watchVars, sizeof(watchVars) / sizeof(watchVars[0]));
+	cli::Shell::init();
+
+	// sampling overhead on host
+	const uint16_t ids[sys::VarSampler::capacity] = {0, 1, 2, 3, 0, 1, 2, 3};
+	EMB_ASSERT_TRUE(sys::VarSampler::start(ids, sys::VarSampler::capacity, 1000));
+	sys::VarSampler::stop();
+	const uint32_t sampleCount = 1000000;
+	uint64_t start = wallclock_ns();
+	for (uint32_t i = 0; i < sampleCount; ++i)
+	{
+		sys::VarSampler::sample();
+	}
+	uint64_t sample_ns = wallclock_ns() - start;
+	uint32_t values[sys::VarSampler::capacity];
+	uint32_t sequence = 0;
+	EMB_ASSERT_TRUE(sys::VarSampler::take(values, sequence));
+	EMB_ASSERT_EQUAL(sequence, sampleCount);
+	EMB_ASSERT_TRUE(!sys::VarSampler::take(values, sequence));
+	EMB_ASSERT_EQUAL(values[6], 1234);
+
+	const uint32_t baudrates[2] = {115200, 9600};
+	uint32_t shown[2] = {0};
+	uint32_t maxRunCalls[2] = {0};
+	for (size_t k = 0; k < 2; ++k)
+	{
+		sim::PipeUart uart(baudrates[k], CLI_PIPE_INT);
+		pipeUart = &uart;
+		uart.registerRxInterruptHandler(onPipeUartRx);
+		uart.enableRxInterrupts();
+		cli::Server server("watch", &uart, NULL, NULL);
+		server.registerExecCallback(cli::Shell::exec);
+		EMB_ASSERT_TRUE(!waitPrompt(server, uart).empty());
+
+		// errors
+		uart.write("watch 10 nosuchvar\r");
+		EMB_ASSERT_TRUE(waitPrompt(server, uart).find("unknown variable") != std::string::npos);
+		uart.write("watch 0 counter\r");
+		EMB_ASSERT_TRUE(waitPrompt(server, uart).find("invalid interval") != std::string::npos);
+		EMB_ASSERT_TRUE(!sys::VarSampler::running());
+
+		uint32_t dropped = cli::out.dropped();
+		uart.write("watch 20 counter signed percent float integrator\r");
+		WatchResult result = runWatch(server, uart, 1000);
+		EMB_ASSERT_TRUE(sys::VarSampler::running());
+		EMB_ASSERT_TRUE(result.output.find("Every 20ms") != std::string::npos);
+		EMB_ASSERT_TRUE(result.output.find("\r" CLI_ESC "[6A") != std::string::npos);	// redrawn in place
+		EMB_ASSERT_TRUE(result.output.find("-42") != std::string::npos);
+		EMB_ASSERT_TRUE(result.output.find("12.340") != std::string::npos);
+		EMB_ASSERT_TRUE(result.output.find("0.500") != std::string::npos);
+		EMB_ASSERT_TRUE(result.output.find("-12345678.000") != std::string::npos);
+		EMB_ASSERT_EQUAL(cli::out.dropped(), dropped);
+		EMB_ASSERT_EQUAL(uart.overruns(), 0);
+		size_t pos = 0;
+		for (; (pos = result.output.find("sample ", pos)) != std::string::npos; ++pos)
+		{
+			++shown[k];
+		}
+		maxRunCalls[k] = result.maxRunCalls;
+
+		// typed-ahead chars are kept, Ctrl-C stops watch and discards them
+		uart.write("up\x03");
+		EMB_ASSERT_TRUE(waitPrompt(server, uart).find("^C") != std::string::npos);
+		EMB_ASSERT_TRUE(!sys::VarSampler::running());
+		uart.write("uptime\r");
+		EMB_ASSERT_TRUE(waitPrompt(server, uart).find("uptime: ") != std::string::npos);
+		uart.disableRxInterrupts();
+		pipeUart = NULL;
+	}
+
+	// 115200 baud keeps up with 50 samples/s, 9600 baud shows fewer frames: samples are skipped, not queued
+	EMB_ASSERT_TRUE(shown[0] >= 48);
+	EMB_ASSERT_TRUE(shown[1] < shown[0]);
+	EMB_ASSERT_TRUE(shown[1] > 0);
+
+	char str[192];
+	snprintf(str, sizeof(str), "[ BENCH  ] var sampler (host): %llu ns per variable",
+			static_cast<unsigned long long>(sample_ns / (static_cast<uint64_t>(sampleCount) * sys::VarSampler::capacity)));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+	for (size_t k = 0; k < 2; ++k)
+	{
+		snprintf(str, sizeof(str), "[ BENCH  ] cli watch 5 vars every 20ms, %lu baud: %lu of 50 samples/s shown, max %lu run() calls per pass",
+				static_cast<unsigned long>(baudrates[k]), static_cast<unsigned long>(shown[k]),
+				static_cast<unsigned long>(maxRunCalls[k]));
+		emb::TestRunner::print(str);
+		emb::TestRunner::print_nextline();
+	}
+}
+
+
+void SimTest::CliHistoryBenchmark()
+{
+	// packed ring: entries wrap around buffer end, oldest entries are dropped
+	cli::History history;
+	EMB_ASSERT_TRUE(!history.push("", 0));
+	EMB_ASSERT_TRUE(history.push("abc", 3));
+	EMB_ASSERT_TRUE(history.push("abd", 3));
+	EMB_ASSERT_TRUE(history.push("xyz", 3));
+	EMB_ASSERT_EQUAL(history.size(), 3);
+	EMB_ASSERT_EQUAL(history.used(), 9);
+	EMB_ASSERT_TRUE(historyEntry(history, 0) == "xyz");
+	EMB_ASSERT_TRUE(historyEntry(history, 2) == "abc");
+	EMB_ASSERT_EQUAL(history.find("ab", 2), 1);
+	EMB_ASSERT_EQUAL(history.find("ab", 2, 2), 2);
+	EMB_ASSERT_EQUAL(history.find("abx", 3), -1);
+	EMB_ASSERT_EQUAL(history.find("", 0), 0);
+	EMB_ASSERT_TRUE(history.equals(0, "xyz", 3) && !history.equals(0, "xy", 2));
+
+	const std::string longEntry(CLI_CMDLINE_MAX_LENGTH, 'L');
+	for (size_t i = 0; i < 100; ++i)
+	{
+		std::string entry = (i % 3 == 0) ? longEntry : std::string("cmd ") + char('a' + i % 26);
+		EMB_ASSERT_TRUE(history.push(entry.data(), entry.size()));
+		EMB_ASSERT_TRUE(historyEntry(history, 0) == entry);
+		EMB_ASSERT_TRUE(history.used() <= cli::History::bufferSize());
+	}
+	size_t used = 0;
+	for (size_t age = 0; age < history.size(); ++age)
+	{
+		used += history.length(age);
+	}
+	EMB_ASSERT_EQUAL(used, history.used());
+	history.clear();
+	for (size_t i = 0; i < 2 * cli::History::capacity(); ++i)
+	{
+		EMB_ASSERT_TRUE(history.push("ab", 2));
+	}
+	EMB_ASSERT_EQUAL(history.size(), cli::History::capacity());
+
+	// EEPROM: round trip across pages, corrupted image is rejected
+	history.clear();
+	const char* saved[4] = {"sysctl set 42", "watch 100 load_idle", longEntry.c_str(), "uptime"};
+	for (size_t i = 0; i < 4; ++i)
+	{
+		history.push(saved[i], strlen(saved[i]));
+	}
+	MemEeprom eeprom;
+	EMB_ASSERT_EQUAL(history.save(eeprom, emb::EepromAddr(1, 20), MemEeprom::pageSize, 10), emb::EEPROM_SUCCESS);
+	cli::History loaded;
+	loaded.push("old", 3);
+	EMB_ASSERT_EQUAL(loaded.load(eeprom, emb::EepromAddr(1, 20), MemEeprom::pageSize, 10), emb::EEPROM_SUCCESS);
+	EMB_ASSERT_EQUAL(loaded.size(), 4);
+	for (size_t i = 0; i < 4; ++i)
+	{
+		EMB_ASSERT_TRUE(historyEntry(loaded, 3 - i) == saved[i]);
+	}
+	eeprom.data[MemEeprom::pageSize + 40] ^= 0x01;
+	EMB_ASSERT_EQUAL(loaded.load(eeprom, emb::EepromAddr(1, 20), MemEeprom::pageSize, 10), emb::EEPROM_READ_FAIL);
+	EMB_ASSERT_TRUE(loaded.empty());
+	EMB_ASSERT_EQUAL(loaded.load(eeprom, emb::EepromAddr(8), MemEeprom::pageSize, 10), emb::EEPROM_READ_FAIL);
+	unsigned int imageWrites = eeprom.writes;
+
+	// server: Up/Down recall, duplicates are not saved, Ctrl-R searches by prefix
+	FeedUart uart;
+	cli::Server server("history", &uart, NULL, NULL);
+	server.registerExecCallback(execCapture);
+	cli::Server::history().clear();
+	feed(server, uart, "\r");
+	feed(server, uart, "abc\r");
+	feed(server, uart, "abd\r");
+	feed(server, uart, "abd\r");
+	feed(server, uart, "xyz 1\r");
+	EMB_ASSERT_EQUAL(cli::Server::history().size(), 3);
+	EMB_ASSERT_TRUE(feed(server, uart, CLI_ESC"[A\r") == "xyz 1");
+	EMB_ASSERT_TRUE(feed(server, uart, CLI_ESC"[A" CLI_ESC"[A" CLI_ESC"[A\r") == "abc");
+	EMB_ASSERT_TRUE(feed(server, uart, "longer line" CLI_ESC"[A" CLI_ESC"[B\r") == "abc");
+	EMB_ASSERT_TRUE(feed(server, uart, CLI_ESC"[B\r") == "abc");	// wraps to oldest
+	EMB_ASSERT_TRUE(feed(server, uart, "\x12" "ab\r") == "abc");
+	EMB_ASSERT_TRUE(feed(server, uart, "\x12" "ab\x12\r") == "abd");
+	EMB_ASSERT_TRUE(feed(server, uart, "\x12" "x\x7F" "ab\r") == "abd");	// newest match after editing prefix
+	EMB_ASSERT_TRUE(feed(server, uart, "\x12" "xy\x01" "Q\r") == "Qxyz 1");
+	EMB_ASSERT_TRUE(feed(server, uart, "\x12" "xyz 1" CLI_ESC"[D" "0\r") == "xyz 01");
+	EMB_ASSERT_TRUE(feed(server, uart, "abc\x12" "x\x07\r") == "abc");
+	EMB_ASSERT_TRUE(feed(server, uart, "\x12" "q\x03\r") == "<none>");
+	uart.capture = true;
+	feed(server, uart, "\x12" "ab" "q");
+	EMB_ASSERT_TRUE(uart.output.find("(failed reverse-i-search)`abq': abc") != std::string::npos);
+	feed(server, uart, "\x07");
+	uart.capture = false;
+
+	// recall cost: Up key on short and long entries, Ctrl-R search through full history
+	const char* shortEntry = "uptime";
+	cli::Server::history().clear();
+	for (size_t i = 0; i < cli::History::capacity(); ++i)
+	{
+		cli::Server::history().push(shortEntry, strlen(shortEntry));
+	}
+	const size_t recallCount = 200000;
+	uint64_t recall_ns[2];
+	for (size_t k = 0; k < 2; ++k)
+	{
+		uart.input = std::string(recallCount * 3, ' ');
+		for (size_t i = 0; i < recallCount; ++i)
+		{
+			uart.input.replace(i * 3, 3, CLI_ESC"[A");
+		}
+		uart.pos = 0;
+		uint64_t start = wallclock_ns();
+		while (server.run()) {}
+		recall_ns[k] = (wallclock_ns() - start) / recallCount;
+		feed(server, uart, "\x15");
+		for (size_t i = 0; i < 3; ++i)
+		{
+			cli::Server::history().push(longEntry.data(), longEntry.size());
+		}
+	}
+	cli::Server::history().clear();
+	for (size_t i = 0; i < cli::History::capacity(); ++i)
+	{
+		char entry[16];
+		snprintf(entry, sizeof(entry), "cmd %02lu", static_cast<unsigned long>(i));
+		cli::Server::history().push(entry, strlen(entry));
+	}
+	const size_t searchCount = 100000;
+	uint64_t start = wallclock_ns();
+	for (size_t i = 0; i < searchCount; ++i)
+	{
+		EMB_ASSERT_EQUAL(cli::Server::history().find("cmd 00", 6), cli::History::capacity() - 1);
+	}
+	uint64_t search_ns = (wallclock_ns() - start) / searchCount;
+
+	// entries held in the same RAM as fixed 8 x emb::String<64> history
+	const char* typical[4] = {"uptime", "sysctl set 42", "watch 100 load_idle load_cli_server", "top"};
+	history.clear();
+	size_t pushed = 0;
+	for (; history.size() == pushed; ++pushed)
+	{
+		history.push(typical[pushed % 4], strlen(typical[pushed % 4]));
+	}
+	size_t fixedSize = sizeof(emb::CircularBuffer<emb::String<CLI_CMDLINE_MAX_LENGTH>, 8>);
+	EMB_ASSERT_TRUE(sizeof(cli::History) < fixedSize);
+	EMB_ASSERT_TRUE(history.size() > 8);
+
+	char str[192];
+	snprintf(str, sizeof(str), "[ BENCH  ] cli history recall (host): %llu ns per Up key (6 chars), %llu ns (64 chars), %llu ns per prefix search through %lu entries",
+			static_cast<unsigned long long>(recall_ns[0]), static_cast<unsigned long long>(recall_ns[1]),
+			static_cast<unsigned long long>(search_ns), static_cast<unsigned long>(cli::History::capacity()));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+	snprintf(str, sizeof(str), "[ BENCH  ] cli history RAM (host): %lu bytes packed vs %lu bytes 8 x String<64>, %lu typical commands held, EEPROM image %lu writes",
+			static_cast<unsigned long>(sizeof(cli::History)), static_cast<unsigned long>(fixedSize),
+			static_cast<unsigned long>(history.size()), static_cast<unsigned long>(imageWrites));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
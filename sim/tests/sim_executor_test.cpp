@@ -0,0 +1,165 @@
+///
+#include "sim_test.h"
+#include "emb/emb_executor.h"
+
+
+namespace {
+
+
+typedef emb::Executor<4, 3> BenchExecutor;
+
+
+const uint64_t clkPerUs = DEVICE_SYSCLK_FREQ / 1000000;
+const uint64_t eventWork = 2 * clkPerUs;	// short event handler, e.g. CAN message processing
+const uint64_t polledWork = 5 * clkPerUs;	// polled service, e.g. clock tasks
+const uint64_t backgroundWork = 2 * clkPerUs;	// step of long background job, e.g. CLI output burst
+const uint64_t dispatchCost = clkPerUs / 4;	// superloop pass overhead
+
+
+/// Synthetic workload: task work is modelled as elapsed virtual time, ISRs fire during it.
+void work(uint64_t cycles)
+{
+	sim::VirtualTime::advance(cycles);
+}
+
+
+uint64_t backgroundSteps;
+
+
+emb::PtStatus eventTask(emb::ProtoThread& pt)
+{
+	work(eventWork);
+	return emb::PtStatus::Waiting;
+}
+
+
+emb::PtStatus polledTask(emb::ProtoThread& pt)
+{
+	work(polledWork);
+	return emb::PtStatus::Waiting;
+}
+
+
+emb::PtStatus backgroundTask(emb::ProtoThread& pt)
+{
+	EMB_PT_BEGIN(pt);
+	while (true)
+	{
+		work(backgroundWork);
+		++backgroundSteps;
+		if (pt.sliceExpired())
+		{
+			EMB_PT_YIELD(pt);
+		}
+	}
+	EMB_PT_END(pt);
+}
+
+
+/**
+ * @brief Periodic interrupt source: ISR makes event task ready at exact virtual time.
+ */
+class EventSource : public sim::ITimedModel
+{
+private:
+	BenchExecutor& _executor;
+	size_t _task;
+	uint64_t _interval;
+	uint64_t _remaining;
+	bool _pending;
+public:
+	uint32_t raised;
+
+	EventSource(BenchExecutor& executor, size_t task, uint64_t interval)
+		: _executor(executor)
+		, _task(task)
+		, _interval(interval)
+		, _remaining(interval)
+		, _pending(false)
+		, raised(0)
+	{
+		sim::VirtualTime::registerModel(this);
+	}
+
+	virtual ~EventSource() { sim::VirtualTime::unregisterModel(this); }
+
+	virtual uint64_t cyclesToNextEvent() const { return _remaining; }
+
+	virtual void advance(uint64_t cycles)
+	{
+		_remaining -= cycles;
+		if (_remaining == 0)
+		{
+			_pending = true;
+			_remaining = _interval;
+		}
+	}
+
+	virtual void fireEvents()
+	{
+		if (!_pending) return;
+		_pending = false;
+		_executor.setReady(_task);
+		++raised;
+	}
+};
+
+
+void runExecutorBenchmark(uint64_t eventInterval_us)
+{
+	const uint64_t duration = 100 * 1000 * clkPerUs;	// 100 ms
+	const uint64_t slice = 20 * clkPerUs;
+
+	BenchExecutor executor(mcu::chrono::HighResolutionClock::ticks, slice);
+	size_t event = executor.add(eventTask, NULL, 0, false);
+	executor.add(polledTask, NULL, 1, true);
+	executor.add(polledTask, NULL, 1, true);
+	executor.add(backgroundTask, NULL, 2, true);
+	executor.resetStats();
+	backgroundSteps = 0;
+
+	EventSource source(executor, event, eventInterval_us * clkPerUs);
+	uint64_t end = sim::VirtualTime::cycles() + duration;
+	while (sim::VirtualTime::cycles() < end)
+	{
+		executor.runOnce();
+		work(dispatchCost);
+	}
+
+	// event task waits at most for one resumed task: background slice or polled service
+	const BenchExecutor::LatencyStats& events = executor.stats(0);
+	EMB_ASSERT_TRUE(events.dispatches > 0);
+	EMB_ASSERT_TRUE(events.dispatches <= source.raised);
+	EMB_ASSERT_TRUE(events.max <= slice + backgroundWork + 2 * dispatchCost);
+	EMB_ASSERT_TRUE(executor.stats(1).dispatches > 0);
+	EMB_ASSERT_TRUE(executor.stats(2).dispatches > 0);
+	EMB_ASSERT_TRUE(backgroundSteps > 0);
+
+	char str[256];
+	snprintf(str, sizeof(str), "[ BENCH  ] executor latency, events every %llu us: events avg %.2f us max %.2f us (%u of %u coalesced), "
+			"polled avg %.2f us max %.2f us, background avg %.2f us max %.2f us, background job runs %llu of %llu ms",
+			static_cast<unsigned long long>(eventInterval_us),
+			static_cast<double>(events.total) / events.dispatches / clkPerUs,
+			static_cast<double>(events.max) / clkPerUs,
+			source.raised - events.dispatches, source.raised,
+			static_cast<double>(executor.stats(1).total) / executor.stats(1).dispatches / clkPerUs,
+			static_cast<double>(executor.stats(1).max) / clkPerUs,
+			static_cast<double>(executor.stats(2).total) / executor.stats(2).dispatches / clkPerUs,
+			static_cast<double>(executor.stats(2).max) / clkPerUs,
+			static_cast<unsigned long long>(backgroundSteps * backgroundWork / (1000 * clkPerUs)),
+			static_cast<unsigned long long>(duration / (1000 * clkPerUs)));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+} // namespace
+
+
+void SimTest::ExecutorBenchmark()
+{
+	runExecutorBenchmark(10);
+	runExecutorBenchmark(100);
+}
+
+
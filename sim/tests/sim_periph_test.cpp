@@ -0,0 +1,162 @@
+///
+#include "sim_test.h"
+#include "mcu_f2837xd/sci/mcu_sci.h"
+#include "mcu_f2837xd/can/mcu_can.h"
+#include "mcu_f2837xd/pwm/mcu_pwm.h"
+#include "mcu_f2837xd/ipc/mcu_ipc.h"
+
+
+namespace {
+
+
+typedef mcu::sci::Module<mcu::sci::Peripheral::SciA> TestUart;
+uint32_t uartRxInterrupts;
+__interrupt void onTestUartRx()
+{
+	++uartRxInterrupts;
+	TestUart::instance()->disableRxInterrupts();	// RX FIFO level interrupt fires until FIFO is drained
+	TestUart::instance()->acknowledgeRxInterrupt();
+}
+
+
+typedef mcu::can::Module<mcu::can::Peripheral::CanA> TestCan;
+uint32_t canRxFrames;
+uint16_t canRxData[8];
+void onTestCanInterrupt(TestCan* can, uint32_t cause, uint16_t status)
+{
+	if (cause == 1 && can->recv(1, canRxData))
+	{
+		++canRxFrames;
+	}
+}
+
+
+typedef mcu::pwm::Module<mcu::pwm::PhaseCount::One> TestPwm;
+TestPwm* testPwm;
+uint32_t pwmEventInterrupts;
+uint32_t pwmTripInterrupts;
+__interrupt void onTestPwmEvent()
+{
+	++pwmEventInterrupts;
+	testPwm->acknowledgeEventInterrupt();
+}
+__interrupt void onTestPwmTrip()
+{
+	++pwmTripInterrupts;
+	testPwm->disableTripInterrupts();
+	testPwm->acknowledgeTripInterrupt();
+}
+
+
+} // namespace
+
+
+void SimTest::PeripheralTest()
+{
+	// SCI: RX FIFO level interrupt, TX goes to host
+	mcu::sci::Config sciConfig =
+	{
+		.baudrate = mcu::sci::Baudrate::Baudrate9600,
+		.wordLen = mcu::sci::WordLen::Word8Bit,
+		.stopBits = mcu::sci::StopBits::One,
+		.parityMode = mcu::sci::ParityMode::None,
+		.autoBaudMode = mcu::sci::AutoBaudMode::Disabled,
+	};
+	TestUart uart(mcu::gpio::Config(28, GPIO_28_SCIRXDA), mcu::gpio::Config(29, GPIO_29_SCITXDA), sciConfig);
+	EMB_ASSERT_EQUAL(sim::Sci::baudrate(SCIA_BASE), 9600);
+	uart.registerRxInterruptHandler(onTestUartRx);
+	uart.enableRxInterrupts();
+
+	uartRxInterrupts = 0;
+	sim::Sci::inject(SCIA_BASE, "abcdefg");
+	EMB_ASSERT_EQUAL(uartRxInterrupts, 0);		// FIFO interrupt level is 8
+	sim::Sci::inject(SCIA_BASE, "h");
+	EMB_ASSERT_EQUAL(uartRxInterrupts, 1);
+	char buf[16] = {0};
+	EMB_ASSERT_EQUAL(uart.recv(buf, 16), 8);
+	EMB_ASSERT_TRUE(buf[0] == 'a' && buf[7] == 'h');
+	uart.enableRxInterrupts();
+	sim::Sci::inject(SCIA_BASE, "01234567");
+	EMB_ASSERT_EQUAL(uartRxInterrupts, 2);
+	EMB_ASSERT_EQUAL(uart.recv(buf, 16), 8);
+
+	// 20 chars: 16 fit into RX FIFO, the rest wait on line
+	sim::Sci::inject(SCIA_BASE, "0123456789abcdefghij");
+	EMB_ASSERT_EQUAL(sim::Sci::rxFifoLevel(SCIA_BASE), 16);
+	EMB_ASSERT_EQUAL(sim::Sci::rxBacklog(SCIA_BASE), 4);
+	char line[32];
+	EMB_ASSERT_EQUAL(uart.recv(line, 32), 20);
+
+	uart.send("hello", 5);
+	uart.send('!');
+	EMB_ASSERT_TRUE(sim::Sci::takeOutput(SCIA_BASE) == "hello!");
+
+	// CAN: loopback frame is received by RX message object, ISR is served
+	TestCan can(mcu::gpio::Config(30, GPIO_30_CANRXA), mcu::gpio::Config(31, GPIO_31_CANTXA),
+			mcu::can::Bitrate::Bitrate125K, mcu::can::Mode::Loopback);
+	EMB_ASSERT_TRUE(sim::Can::started(CANA_BASE));
+	EMB_ASSERT_EQUAL(sim::Can::bitrate(CANA_BASE), 125000);
+	mcu::can::MessageObject rxObject = {1, 0x181, CAN_MSG_FRAME_STD, CAN_MSG_OBJ_TYPE_RX, 0, CAN_MSG_OBJ_RX_INT_ENABLE, 4};
+	mcu::can::MessageObject txObject = {2, 0x181, CAN_MSG_FRAME_STD, CAN_MSG_OBJ_TYPE_TX, 0, CAN_MSG_OBJ_NO_FLAGS, 4};
+	can.setupMessageObject(rxObject);
+	can.setupMessageObject(txObject);
+	can.registerInterruptCallback(onTestCanInterrupt);
+	can.enableInterrupts();
+
+	canRxFrames = 0;
+	const uint16_t txData[4] = {0x11, 0x22, 0x33, 0x44};
+	can.send(2, txData, 4);
+	EMB_ASSERT_EQUAL(canRxFrames, 1);
+	EMB_ASSERT_EQUAL(canRxData[3], 0x44);
+	EMB_ASSERT_EQUAL(sim::Can::txCount(CANA_BASE), 1);
+
+	// PWM: time-base zero event interrupts at switching frequency, forced trip raises trip interrupt
+	mcu::pwm::Config<mcu::pwm::PhaseCount::One> pwmConfig =
+	{
+		.peripheral = {mcu::pwm::Peripheral::Pwm1},
+		.switchingFreq = 10000,
+		.deadtime_ns = 0,
+		.clockPrescaler = 1,
+		.clkDivider = mcu::pwm::ClockDivider::Divider1,
+		.hsclkDivider = mcu::pwm::HsClockDivider::Divider1,
+		.operatingMode = mcu::pwm::OperatingMode::ActiveHighComplementary,
+		.counterMode = mcu::pwm::CounterMode::UpDown,
+		.outputSwap = mcu::pwm::OutputSwap::No,
+		.eventInterruptSource = EPWM_INT_TBCTR_ZERO,
+		.adcTriggerEnable = {false, false},
+		.adcTriggerSource = {EPWM_SOC_TBCTR_ZERO, EPWM_SOC_TBCTR_ZERO}
+	};
+	TestPwm pwm(pwmConfig);
+	testPwm = &pwm;
+	EMB_ASSERT_EQUAL(pwm.period(), 5000);
+	pwm.registerEventInterruptHandler(onTestPwmEvent);
+	pwm.registerTripInterruptHandler(onTestPwmTrip);
+	pwm.enableEventInterrupts();
+	pwm.enableTripInterrupts();
+	EMB_ASSERT_TRUE(sim::Epwm::running(EPWM1_BASE));
+
+	pwmEventInterrupts = 0;
+	pwmTripInterrupts = 0;
+	sim::VirtualTime::advance_ms(1);
+	EMB_ASSERT_EQUAL(pwmEventInterrupts, 10);
+
+	pwm.start();
+	EMB_ASSERT_TRUE(!sim::Epwm::tripped(EPWM1_BASE));
+	pwm.stop();
+	EMB_ASSERT_TRUE(sim::Epwm::tripped(EPWM1_BASE));
+	EMB_ASSERT_EQUAL(pwmTripInterrupts, 1);
+	pwm.disableEventInterrupts();
+
+	// IPC: local flags are visible to remote side and vice versa
+	mcu::ipc::Flag flag(3, mcu::ipc::Mode::Dualcore);
+	flag.local.set();
+	EMB_ASSERT_EQUAL(sim::Ipc::localFlags(), 1UL << 3);
+	sim::Ipc::acknowledgeLocalFlags(1UL << 3);
+	EMB_ASSERT_TRUE(!flag.local.isSet());
+	sim::Ipc::setRemoteFlags(1UL << 3);
+	EMB_ASSERT_TRUE(flag.isSet());
+	flag.reset();
+	EMB_ASSERT_TRUE(!flag.remote.isSet());
+}
+
+
@@ -0,0 +1,252 @@
+///
+#include "sim_test.h"
+#include "emb/emb_scheduler.h"
+
+#include <vector>
+#include <algorithm>
+
+
+namespace {
+
+
+/**
+ * @brief Reference: previous SystemClock task store, every task is checked on every runTasks() call.
+ */
+template <size_t Capacity>
+struct LinearTasks
+{
+	uint64_t period[Capacity];
+	uint64_t timepoint[Capacity];
+	size_t size;
+
+	void add(uint64_t taskPeriod)
+	{
+		period[size] = taskPeriod;
+		timepoint[size] = 0;
+		++size;
+	}
+
+	size_t run(uint64_t now, emb::TaskStatus (*func)(size_t))
+	{
+		size_t executed = 0;
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (now >= (timepoint[i] + period[i]))
+			{
+				if (func(i) == emb::TaskStatus::Success)
+				{
+					timepoint[i] = now;
+				}
+				++executed;
+			}
+		}
+		return executed;
+	}
+};
+
+
+struct LogEntry
+{
+	uint64_t time;
+	size_t id;
+	bool operator<(const LogEntry& other) const
+	{
+		return (time < other.time) || ((time == other.time) && (id < other.id));
+	}
+	bool operator==(const LogEntry& other) const { return (time == other.time) && (id == other.id); }
+};
+
+
+std::vector<LogEntry> schedulerLog;
+uint64_t schedulerTime;
+bool schedulerLogEnabled;
+
+
+/// Period of task with given id: 1..16 ms, as clock tasks with different rates.
+uint64_t taskPeriod(size_t id)
+{
+	return (id % 16) + 1;
+}
+
+
+/// Every 7th task changes its own period as taskToggleLed does, every 5th run of every 9th task fails.
+template <class Scheduler>
+struct SchedulerTask
+{
+	static Scheduler* scheduler;
+	static std::vector<uint32_t> runCounts;
+
+	static emb::TaskStatus func(size_t id)
+	{
+		if (!schedulerLogEnabled) return emb::TaskStatus::Success;
+
+		LogEntry entry = {schedulerTime, id};
+		schedulerLog.push_back(entry);
+		uint32_t count = runCounts[id]++;
+		if (id % 7 == 0)
+		{
+			scheduler->setPeriod(id, (count % 4 == 3) ? 17 : taskPeriod(id));
+		}
+		if ((id % 9 == 4) && (count % 5 == 4))
+		{
+			return emb::TaskStatus::Fail;
+		}
+		return emb::TaskStatus::Success;
+	}
+};
+
+
+template <class Scheduler>
+Scheduler* SchedulerTask<Scheduler>::scheduler = NULL;
+template <class Scheduler>
+std::vector<uint32_t> SchedulerTask<Scheduler>::runCounts;
+
+
+/// Adapter of reference with scheduler interface used by SchedulerTask.
+template <size_t Capacity>
+struct LinearScheduler
+{
+	LinearTasks<Capacity> tasks;
+	void setPeriod(size_t id, uint64_t period) { tasks.period[id] = period; }
+};
+
+
+/// Superloop passes with jitter: the same pass times for scheduler and reference.
+uint64_t nextPassTime(uint64_t time)
+{
+	return time + (time % 3) + 1;
+}
+
+
+template <size_t Capacity>
+bool checkDueOrder(emb::Scheduler<Capacity>& scheduler, uint64_t duration)
+{
+	typedef SchedulerTask<LinearScheduler<Capacity> > ReferenceTask;
+	typedef SchedulerTask<emb::Scheduler<Capacity> > HeapTask;
+	schedulerLogEnabled = true;
+
+	static LinearScheduler<Capacity> reference;
+	reference.tasks.size = 0;
+	ReferenceTask::scheduler = &reference;
+	ReferenceTask::runCounts.assign(Capacity, 0);
+	for (size_t i = 0; i < Capacity; ++i)
+	{
+		reference.tasks.add(taskPeriod(i));
+	}
+	schedulerLog.clear();
+	for (schedulerTime = 0; schedulerTime < duration; schedulerTime = nextPassTime(schedulerTime))
+	{
+		reference.tasks.run(schedulerTime, ReferenceTask::func);
+	}
+	std::vector<LogEntry> referenceLog;
+	referenceLog.swap(schedulerLog);
+
+	scheduler.clear();
+	HeapTask::scheduler = &scheduler;
+	HeapTask::runCounts.assign(Capacity, 0);
+	for (size_t i = 0; i < Capacity; ++i)
+	{
+		scheduler.addPeriodic(HeapTask::func, taskPeriod(i), 0, emb::CatchUpPolicy::Restart);
+	}
+	for (schedulerTime = 0; schedulerTime < duration; schedulerTime = nextPassTime(schedulerTime))
+	{
+		scheduler.run(schedulerTime);
+	}
+	scheduler.clear();
+	schedulerLogEnabled = false;
+
+	// reference runs due tasks in index order, scheduler - in deadline order
+	std::stable_sort(referenceLog.begin(), referenceLog.end());
+	std::stable_sort(schedulerLog.begin(), schedulerLog.end());
+	return (referenceLog.size() > Capacity) && (referenceLog == schedulerLog);
+}
+
+
+emb::TaskStatus benchTask(size_t id)
+{
+	return emb::TaskStatus::Success;
+}
+
+
+template <size_t Capacity>
+void runSchedulerBenchmark(emb::Scheduler<Capacity>& scheduler)
+{
+	const uint64_t ticks = 20000;
+
+	// due-order and period semantics match previous linear scan
+	EMB_ASSERT_TRUE(checkDueOrder(scheduler, 1000));
+
+	// due check and run of due tasks on every SystemClock tick
+	scheduler.clear();
+	for (size_t i = 0; i < Capacity; ++i)
+	{
+		scheduler.addPeriodic(benchTask, taskPeriod(i), 0);
+	}
+	uint64_t executed = 0;
+	uint64_t t0 = wallclock_ns();
+	for (uint64_t t = 1; t <= ticks; ++t)
+	{
+		if (scheduler.due(t))
+		{
+			executed += scheduler.run(t);
+		}
+	}
+	uint64_t heap_ns = wallclock_ns() - t0;
+
+	static LinearTasks<Capacity> linear;
+	linear.size = 0;
+	for (size_t i = 0; i < Capacity; ++i)
+	{
+		linear.add(taskPeriod(i));
+	}
+	uint64_t linearExecuted = 0;
+	t0 = wallclock_ns();
+	for (uint64_t t = 1; t <= ticks; ++t)
+	{
+		linearExecuted += linear.run(t, benchTask);
+	}
+	uint64_t linear_ns = wallclock_ns() - t0;
+	EMB_ASSERT_EQUAL(executed, linearExecuted);
+
+	// due check when nothing is due
+	const uint64_t iterations = 1000000;
+	volatile uint64_t now = 0;	// due check is not hoisted out of loop
+	uint64_t due = 0;
+	t0 = wallclock_ns();
+	for (uint64_t i = 0; i < iterations; ++i)
+	{
+		due += scheduler.due(now) ? 1 : 0;
+	}
+	uint64_t idle_ns = wallclock_ns() - t0;
+	EMB_ASSERT_EQUAL(due, 0);
+	scheduler.clear();
+
+	char str[192];
+	snprintf(str, sizeof(str), "[ BENCH  ] scheduler %u tasks: %llu ns per tick, %llu ns per task run "
+			"(linear scan: %llu ns per tick), idle due check %.1f ns",
+			static_cast<unsigned int>(Capacity),
+			static_cast<unsigned long long>(heap_ns / ticks),
+			static_cast<unsigned long long>(heap_ns / executed),
+			static_cast<unsigned long long>(linear_ns / ticks),
+			static_cast<double>(idle_ns) / iterations);
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+emb::Scheduler<8> scheduler8;
+emb::Scheduler<64> scheduler64;
+emb::Scheduler<512> scheduler512;
+
+
+} // namespace
+
+
+void SimTest::SchedulerBenchmark()
+{
+	runSchedulerBenchmark(scheduler8);
+	runSchedulerBenchmark(scheduler64);
+	runSchedulerBenchmark(scheduler512);
+}
+
+
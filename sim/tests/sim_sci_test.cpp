@@ -0,0 +1,174 @@
+///
+#include "sim_test.h"
+#include "mcu_f2837xd/sci/mcu_sci.h"
+
+#include <string>
+
+
+namespace {
+
+
+typedef mcu::sci::Module<mcu::sci::Peripheral::SciA> TestUart;
+const mcu::gpio::Config rxPin(28, GPIO_28_SCIRXDA);
+const mcu::gpio::Config txPin(29, GPIO_29_SCITXDA);
+const mcu::sci::Config uartConfig =
+{
+	.baudrate = mcu::sci::Baudrate::Baudrate115200,
+	.wordLen = mcu::sci::WordLen::Word8Bit,
+	.stopBits = mcu::sci::StopBits::One,
+	.parityMode = mcu::sci::ParityMode::None,
+	.autoBaudMode = mcu::sci::AutoBaudMode::Disabled,
+};
+
+
+uint32_t rxNotifications;
+void onTestUartRx()
+{
+	++rxNotifications;
+}
+
+
+/// Superloop that is busy for pass period and then drains UART: returns number of received chars.
+size_t receiveBusy(TestUart& uart, uint64_t passPeriod_us, uint64_t duration_ms)
+{
+	size_t received = 0;
+	for (uint64_t t = 0; t < duration_ms * 1000; t += passPeriod_us)
+	{
+		sim::VirtualTime::advance_us(passPeriod_us);
+		char ch;
+		while (uart.recv(ch) == 1)
+		{
+			++received;
+		}
+	}
+	return received;
+}
+
+
+/// Superloop that is busy for pass period and then sends as much as UART accepts: returns time of output in ns.
+uint64_t transmitBusy(TestUart& uart, const std::string& message, uint64_t passPeriod_us)
+{
+	uint64_t start = sim::VirtualTime::now_ns();
+	size_t sent = 0;
+	while (sent < message.size())
+	{
+		sent += uart.sendNonBlocking(message.data() + sent, message.size() - sent);
+		sim::VirtualTime::advance_us(passPeriod_us);
+	}
+	while (sim::Sci::txCount(SCIA_BASE) < message.size() || sim::Sci::txFifoLevel(SCIA_BASE) != 0)
+	{
+		sim::VirtualTime::advanceToNextEvent();
+	}
+	return sim::VirtualTime::now_ns() - start;
+}
+
+
+void printBench(const char* mode, size_t bytes, uint64_t ns, uint64_t passPeriod_us)
+{
+	char str[128];
+	snprintf(str, sizeof(str), "[ BENCH  ] sci 115200 %s TX, pass %lluus: %llu bytes/s (line rate 11520 bytes/s)",
+			mode, static_cast<unsigned long long>(passPeriod_us),
+			static_cast<unsigned long long>(bytes * 1000000000ULL / ns));
+	emb::TestRunner::print(str);
+	emb::TestRunner::print_nextline();
+}
+
+
+} // namespace
+
+
+void SimTest::SciTest()
+{
+	const uint64_t passPeriod_us = 5000;	// ~57 char frames at 115200
+	const std::string input(200, 'x');
+	const std::string output(2000, 'y');
+	uint64_t polledTx_ns = 0;
+	uint64_t interruptTx_ns = 0;
+
+	sim::Sci::setPaced(SCIA_BASE, true);
+	sim::Sci::takeOutput(SCIA_BASE);
+
+	// polled mode: 16-char RX FIFO overflows while superloop is busy, TX FIFO is refilled once per pass
+	{
+		TestUart uart(rxPin, txPin, uartConfig);
+		EMB_ASSERT_TRUE(!uart.interruptDriven());
+		uint64_t overruns = sim::Sci::rxOverruns(SCIA_BASE);
+		sim::Sci::inject(SCIA_BASE, input.c_str());
+		size_t received = receiveBusy(uart, passPeriod_us, 30);
+		EMB_ASSERT_TRUE(received < input.size());
+		EMB_ASSERT_EQUAL(received + sim::Sci::rxOverruns(SCIA_BASE) - overruns, input.size());
+
+		uint64_t txCount = sim::Sci::txCount(SCIA_BASE);
+		polledTx_ns = transmitBusy(uart, output, passPeriod_us);
+		EMB_ASSERT_EQUAL(sim::Sci::txCount(SCIA_BASE) - txCount, output.size());
+		sim::Sci::takeOutput(SCIA_BASE);
+	}
+
+	// interrupt-driven mode: RX ISR drains FIFO to ring on every char, TX ISR refills FIFO from ring
+	{
+		TestUart uart(rxPin, txPin, uartConfig);
+		uart.enableInterruptDrivenMode();
+		uart.registerRxInterruptHandler(onTestUartRx);
+		uart.enableRxInterrupts();
+		EMB_ASSERT_TRUE(uart.interruptDriven());
+
+		uint64_t overruns = sim::Sci::rxOverruns(SCIA_BASE);
+		rxNotifications = 0;
+		sim::Sci::inject(SCIA_BASE, input.c_str());
+		EMB_ASSERT_EQUAL(receiveBusy(uart, passPeriod_us, 30), input.size());
+		EMB_ASSERT_EQUAL(sim::Sci::rxOverruns(SCIA_BASE), overruns);
+		EMB_ASSERT_EQUAL(uart.rxFifoOverruns(), 0);
+		EMB_ASSERT_EQUAL(uart.rxRingOverruns(), 0);
+		EMB_ASSERT_TRUE(!uart.hasRxError());
+		EMB_ASSERT_EQUAL(rxNotifications, input.size());
+
+		// notification handler is disabled until CLI-like task re-enables it, ring is still filled
+		uart.disableRxInterrupts();
+		rxNotifications = 0;
+		sim::Sci::inject(SCIA_BASE, "abc");
+		sim::VirtualTime::advance_ms(1);
+		EMB_ASSERT_EQUAL(rxNotifications, 0);
+		uart.enableRxInterrupts();
+		EMB_ASSERT_EQUAL(rxNotifications, 1);	// ring is not empty
+		char buf[8] = {0};
+		EMB_ASSERT_EQUAL(uart.recv(buf, 8), 3);
+		EMB_ASSERT_TRUE(buf[0] == 'a' && buf[2] == 'c');
+
+		// ring overrun: superloop is busy longer than ring lasts
+		sim::Sci::inject(SCIA_BASE, input.c_str());
+		size_t received = receiveBusy(uart, 4 * passPeriod_us, 40);
+		EMB_ASSERT_TRUE(uart.rxRingOverruns() > 0);
+		EMB_ASSERT_EQUAL(received + uart.rxRingOverruns(), input.size());
+		EMB_ASSERT_TRUE(uart.hasRxError());
+		uart.clearRxError();
+		EMB_ASSERT_TRUE(!uart.hasRxError());
+
+		uint64_t txCount = sim::Sci::txCount(SCIA_BASE);
+		sim::Sci::takeOutput(SCIA_BASE);
+		interruptTx_ns = transmitBusy(uart, output, passPeriod_us);
+		EMB_ASSERT_EQUAL(sim::Sci::txCount(SCIA_BASE) - txCount, output.size());
+		EMB_ASSERT_TRUE(sim::Sci::takeOutput(SCIA_BASE) == output);
+
+		// blocking send flushes TX ring first: order is kept
+		EMB_ASSERT_EQUAL(uart.sendNonBlocking("abc", 3), 3);
+		EMB_ASSERT_EQUAL(uart.txPending() + sim::Sci::txFifoLevel(SCIA_BASE), 3);
+		uart.send("def", 3);
+		while (sim::Sci::txFifoLevel(SCIA_BASE) != 0)
+		{
+			sim::VirtualTime::advanceToNextEvent();
+		}
+		EMB_ASSERT_TRUE(sim::Sci::takeOutput(SCIA_BASE) == "abcdef");
+		EMB_ASSERT_EQUAL(uart.txPending(), 0);
+	}
+
+	sim::Sci::setPaced(SCIA_BASE, false);
+
+	// TX ring keeps line busy between passes
+	uint64_t lineTime_ns = output.size() * sim::Sci::charCycles(SCIA_BASE) * 1000000000ULL / DEVICE_SYSCLK_FREQ;
+	EMB_ASSERT_TRUE(interruptTx_ns < lineTime_ns + lineTime_ns / 10);
+	EMB_ASSERT_TRUE(polledTx_ns > 2 * interruptTx_ns);
+	printBench("polled", output.size(), polledTx_ns, passPeriod_us);
+	printBench("interrupt-driven", output.size(), interruptTx_ns, passPeriod_us);
+}
+
+
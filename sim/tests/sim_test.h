@@ -0,0 +1,46 @@
+///
+///
+///
+#pragma once
+
+
+#include "emb/emb_testrunner/emb_testrunner.h"
+#include "mcu_f2837xd/system/mcu_system.h"
+#include "mcu_f2837xd/chrono/mcu_chrono.h"
+#include "driverlib.h"
+
+
+class SimTest
+{
+public:
+	static void ChronoTest();
+	static void ChronoBenchmark();
+	static void SchedulerBenchmark();
+	static void ExecutorBenchmark();
+	static void PeripheralTest();
+	static void SciTest();
+	static void CanBusTest();
+	static void UcanopenBenchmark();
+	static void OdIndexBenchmark();
+	static void OdGeneratorTest();
+	static void SdoTransferBenchmark();
+	static void PdoMappingBenchmark();
+	static void RxQueueBenchmark();
+	static void CliBenchmark();
+	static void CliEscSeqBenchmark();
+	static void CliCompletionBenchmark();
+	static void CliStreamBenchmark();
+	static void CliWatchBenchmark();
+	static void CliHistoryBenchmark();
+	static void BinaryProtocolBenchmark();
+};
+
+
+/**
+ * @brief Returns host wall-clock time, used by host benchmarks.
+ * @param (none)
+ * @return Monotonic wall-clock time in ns.
+ */
+uint64_t wallclock_ns();
+
+
@@ -0,0 +1,66 @@
+///
+///
+///
+#include "sim_test.h"
+#include "sys/syslog/syslog.h"
+
+#include <time.h>
+
+
+uint64_t wallclock_ns()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+
+void emb::run_tests()
+{
+	mcu::initDevice();
+	mcu::chrono::SystemClock::init();
+	mcu::chrono::HighResolutionClock::init(1000);
+	mcu::chrono::HighResolutionClock::enableExtendedTicks();
+	mcu::chrono::HighResolutionClock::start();
+	mcu::enableMaskableInterrupts();
+
+	SysLog::IpcFlags syslogIpcFlags =
+	{
+		.ipcResetErrorsWarnings = mcu::ipc::Flag(10, mcu::ipc::Mode::Dualcore),
+		.ipcAddMessage = mcu::ipc::Flag(11, mcu::ipc::Mode::Dualcore),
+		.ipcPopMessage = mcu::ipc::Flag(12, mcu::ipc::Mode::Dualcore)
+	};
+	SysLog::init(syslogIpcFlags);
+
+	EMB_RUN_TEST(SimTest::ChronoTest);
+	EMB_RUN_TEST(SimTest::ChronoBenchmark);
+	EMB_RUN_TEST(SimTest::SchedulerBenchmark);
+	EMB_RUN_TEST(SimTest::ExecutorBenchmark);
+	EMB_RUN_TEST(SimTest::PeripheralTest);
+	EMB_RUN_TEST(SimTest::SciTest);
+	EMB_RUN_TEST(SimTest::CanBusTest);
+	EMB_RUN_TEST(SimTest::UcanopenBenchmark);
+	EMB_RUN_TEST(SimTest::OdIndexBenchmark);
+	EMB_RUN_TEST(SimTest::OdGeneratorTest);
+	EMB_RUN_TEST(SimTest::SdoTransferBenchmark);
+	EMB_RUN_TEST(SimTest::PdoMappingBenchmark);
+	EMB_RUN_TEST(SimTest::RxQueueBenchmark);
+	EMB_RUN_TEST(SimTest::CliBenchmark);
+	EMB_RUN_TEST(SimTest::CliEscSeqBenchmark);
+	EMB_RUN_TEST(SimTest::CliCompletionBenchmark);
+	EMB_RUN_TEST(SimTest::CliStreamBenchmark);
+	EMB_RUN_TEST(SimTest::CliWatchBenchmark);
+	EMB_RUN_TEST(SimTest::CliHistoryBenchmark);
+	EMB_RUN_TEST(SimTest::BinaryProtocolBenchmark);
+
+	emb::TestRunner::printResult();
+}
+
+
+int main()
+{
+	emb::run_tests();
+	return emb::TestRunner::passed() ? 0 : 1;
+}
+
+